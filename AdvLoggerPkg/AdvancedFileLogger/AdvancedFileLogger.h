@@ -18,6 +18,7 @@
 #include <Guid/AdvancedFileLoggerPolicy.h>
 
 #include <Protocol/AdvancedLogger.h>
+#include <Protocol/BlockIo.h>
 #include <Protocol/DevicePath.h>
 #include <Protocol/ResetNotification.h>
 #include <Protocol/SimpleFileSystem.h>
@@ -47,6 +48,11 @@ typedef struct {
   EFI_HANDLE                                   Handle;
   UINTN                                        FileIndex;
   UINT64                                       CurrentOffset;         // Current offset to start writing
+  UINT32                                       BlockSize;             // Media block size the log writes are aligned to
+  EFI_SIMPLE_FILE_SYSTEM_PROTOCOL              *FileSystem;           // File system the open files belong to
+  EFI_FILE                                     *Volume;               // Open volume, kept open across flushes
+  EFI_FILE                                     *File;                 // Open log file, kept open across flushes
+  EFI_FILE                                     *IndexFile;            // Open index file, when appending
   ADVANCED_LOGGER_ACCESS_MESSAGE_LINE_ENTRY    AccessEntry;
   BOOLEAN                                      Valid;
 } LOG_DEVICE;
@@ -63,12 +69,26 @@ typedef struct {
 #define INDEX_FILE_VALUE  "0\n"
 #define INDEX_FILE_SIZE   (sizeof(INDEX_FILE_VALUE) - 1)
 
+// When PcdAdvancedFileLoggerAppend is TRUE, the Index file also has the offset in the
+// log file where the next flush continues, in hex.
+
+#define APPEND_INDEX_FILE_VALUE  "0 0000000000000000\n"
+#define APPEND_INDEX_FILE_SIZE   (sizeof(APPEND_INDEX_FILE_VALUE) - 1)
+
+#define LOG_INDEX_FILE_VALUE  (FeaturePcdGet (PcdAdvancedFileLoggerAppend) ? APPEND_INDEX_FILE_VALUE : INDEX_FILE_VALUE)
+#define LOG_INDEX_FILE_SIZE   (FeaturePcdGet (PcdAdvancedFileLoggerAppend) ? APPEND_INDEX_FILE_SIZE : INDEX_FILE_SIZE)
+
 // The code depends on the Chunk size being a multiple of the page size, and
 // the log file size being a multiple of the chunk size.
 
 #define DEBUG_LOG_CHUNK_SIZE  (EFI_PAGE_SIZE * 16)                                                   // # of pages per write to log (64KB)
 #define DEBUG_LOG_FILE_SIZE   (DEBUG_LOG_CHUNK_SIZE * (FixedPcdGet32 (PcdAdvancedLoggerPages) / 16)) // # chunks per log file
 
+// Formatted lines are staged in the write buffer, and written to the log file when the
+// buffer is full.  Writes end on a media block boundary of the log file.
+
+#define DEBUG_LOG_WRITE_BUFFER_SIZE  (DEBUG_LOG_CHUNK_SIZE * 4)                                      // Bytes per staged write (256KB)
+
 #define LOG_DIRECTORY_NAME  L"\\UefiLogs"
 
 //
@@ -23,6 +23,12 @@ STATIC DEBUG_LOG_FILE_INFO  mLogFiles[] = {
 };
 #define DEBUG_LOG_FILE_COUNT  ARRAY_SIZE(mLogFiles)
 
+//
+// Staging buffer for the log file writes.  It is allocated when the first log device is
+// enabled, as memory cannot be allocated when the log is written at ExitBootServices.
+//
+STATIC CHAR8  *mWriteBuffer = NULL;
+
 /**
   VolumeFromFileSystemHandle
 
@@ -86,6 +92,8 @@ VolumeFromFileSystemHandle (
     return NULL;
   }
 
+  LogDevice->FileSystem = FileSystem;
+
   //
   // Open the volume.
   //
@@ -209,16 +217,16 @@ InitializeLogIndexFile (
   //
   // Initialize the contents of the Index file to log 0.
   //
-  DataBufferSize = INDEX_FILE_SIZE;
+  DataBufferSize = LOG_INDEX_FILE_SIZE;
   Status         = File->Write (
                            File,
                            &DataBufferSize,
-                           INDEX_FILE_VALUE
+                           LOG_INDEX_FILE_VALUE
                            );
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: Failed to create index file. Code=%r \n", __FUNCTION__, Status));
   } else {
-    if (DataBufferSize != INDEX_FILE_SIZE) {
+    if (DataBufferSize != LOG_INDEX_FILE_SIZE) {
       Status = EFI_ABORTED;
     }
   }
@@ -464,94 +472,481 @@ DetermineLogFile (
 }
 
 /**
-  WriteALogFIle
+  DetermineAppendLogFile
 
-  Writes the currently unwritten part of the log file.
+  Read the log file index, and the offset where the last flush ended, from the log index
+  file.  The log is appended to the log file from that offset.
 
   @param   LogDevice        Which log device to write the log to
+  @param   Volume           Open Volume
 
-  @retval  EFI_SUCCESS      The log was updated
+  @retval  EFI_SUCCESS      The LogData->FileIndex and LogData->CurrentOffset were updated
   @retval  other            An error occurred.  The log device was disabled
 
   **/
+STATIC
 EFI_STATUS
-WriteALogFile (
-  IN LOG_DEVICE  *LogDevice
+DetermineAppendLogFile (
+  IN LOG_DEVICE  *LogDevice,
+  IN EFI_FILE    *Volume
   )
 {
+  UINTN       BufferSize;
   EFI_FILE    *File;
+  CHAR8       FileIndex;
+  UINT64      FileOffset;
+  CHAR8       IndexValue[APPEND_INDEX_FILE_SIZE + 1];
+  EFI_STATUS  Status;
+
+  //
+  // Open Index File
+  //
+  Status = Volume->Open (
+                     Volume,
+                     &File,
+                     mLogFiles[0].LogFileName,
+                     EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE,
+                     0
+                     );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Unable to open log index file. Code = %r\n", __FUNCTION__, Status));
+    LogDevice->Valid = FALSE;
+    return Status;
+  }
+
+  //
+  // Read the index value and the offset in that log file.
+  //
+  BufferSize = APPEND_INDEX_FILE_SIZE;
+  Status     = File->Read (File, &BufferSize, IndexValue);
+  File->Close (File);
+
+  FileIndex  = '0';
+  FileOffset = 0;
+  if (EFI_ERROR (Status) || (BufferSize != APPEND_INDEX_FILE_SIZE)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to read the log file index. Using log 1. Code=%r\n", __FUNCTION__, Status));
+  } else {
+    IndexValue[APPEND_INDEX_FILE_SIZE] = '\0';
+    FileIndex                          = IndexValue[0];
+    FileOffset                         = AsciiStrHexToUint64 (&IndexValue[2]);
+  }
+
+  if ((FileIndex < '1') || (FileIndex > '9') || (FileOffset > DEBUG_LOG_FILE_SIZE)) {
+    FileIndex  = '1';
+    FileOffset = 0;
+  }
+
+  LogDevice->FileIndex     = FileIndex - '0';
+  LogDevice->CurrentOffset = FileOffset;
+
+  //
+  // The last flush filled the log file exactly.  Continue in the next log file, as
+  // NextAppendLogFile does when a log file fills during a flush.
+  //
+  if (FileOffset == DEBUG_LOG_FILE_SIZE) {
+    LogDevice->FileIndex     = (LogDevice->FileIndex >= DEBUG_LOG_FILE_COUNT - 1) ? 1 : LogDevice->FileIndex + 1;
+    LogDevice->CurrentOffset = 0;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  FlushWriteBuffer
+
+  Writes the staged log lines to the log file.
+
+  @param   LogDevice        Which log device to write the log to
+  @param   File             Open log file, positioned at LogDevice->CurrentOffset
+  @param   BufferLen        On input, the bytes staged in the write buffer.  Set to 0 on output.
+  @param   WriteCount       Incremented when the write buffer is written.
+
+  @retval  EFI_SUCCESS      The staged lines were written
+  @retval  other            An error occurred
+
+  **/
+STATIC
+EFI_STATUS
+FlushWriteBuffer (
+  IN     LOG_DEVICE  *LogDevice,
+  IN     EFI_FILE    *File,
+  IN OUT UINTN       *BufferLen,
+  IN OUT UINTN       *WriteCount
+  )
+{
   UINTN       WriteSize;
-  UINT64      RoomLeft;
   EFI_STATUS  Status;
-  EFI_FILE    *Volume;
 
-  if (!LogDevice->Valid) {
-    return EFI_DEVICE_ERROR;
+  if (*BufferLen == 0) {
+    return EFI_SUCCESS;
   }
 
-  File   = NULL;
-  Volume = VolumeFromFileSystemHandle (LogDevice);
-  if (NULL == Volume) {
-    Status = EFI_INVALID_PARAMETER;
-    goto CloseAndExit;
+  WriteSize = *BufferLen;
+  Status    = File->Write (File, &WriteSize, (VOID *)mWriteBuffer);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to write to log file: %r !\n", __FUNCTION__, Status));
+    return Status;
+  }
+
+  if (WriteSize != *BufferLen) {
+    DEBUG ((DEBUG_ERROR, "%a: Not all bytes written to log.\n", __FUNCTION__));
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  LogDevice->CurrentOffset += WriteSize;
+  *BufferLen                = 0;
+  (*WriteCount)++;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  CloseLogFiles
+
+  Close the log file, the log index file and the volume of a log device.
+
+  @param   LogDevice        Which log device to close
+
+  **/
+STATIC
+VOID
+CloseLogFiles (
+  IN LOG_DEVICE  *LogDevice
+  )
+{
+  if (LogDevice->File != NULL) {
+    LogDevice->File->Close (LogDevice->File);
+    LogDevice->File = NULL;
+  }
+
+  if (LogDevice->IndexFile != NULL) {
+    LogDevice->IndexFile->Close (LogDevice->IndexFile);
+    LogDevice->IndexFile = NULL;
+  }
+
+  if (LogDevice->Volume != NULL) {
+    LogDevice->Volume->Close (LogDevice->Volume);
+    LogDevice->Volume = NULL;
+  }
+}
+
+/**
+  OpenLogFiles
+
+  Open the volume and the current log file of a log device.  The files stay open across
+  flushes, and are only opened again when the file system of the device was reinstalled.
+
+  @param   LogDevice        Which log device to open
+
+  @retval  EFI_SUCCESS      LogDevice->File is open
+  @retval  other            An error occurred
+
+  **/
+STATIC
+EFI_STATUS
+OpenLogFiles (
+  IN LOG_DEVICE  *LogDevice
+  )
+{
+  EFI_SIMPLE_FILE_SYSTEM_PROTOCOL  *FileSystem;
+  EFI_TPL                          OldTpl;
+  EFI_STATUS                       Status;
+
+  if (LogDevice->File != NULL) {
+    //
+    // Check the file system is still installed before using the open files.  See
+    // VolumeFromFileSystemHandle for the RaiseTPL/RestoreTPL.
+    //
+    OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+    gBS->RestoreTPL (OldTpl);
+
+    Status = gBS->OpenProtocol (
+                    LogDevice->Handle,
+                    &gEfiSimpleFileSystemProtocolGuid,
+                    (VOID **)&FileSystem,
+                    gImageHandle,
+                    NULL,
+                    EFI_OPEN_PROTOCOL_BY_HANDLE_PROTOCOL
+                    );
+    if (!EFI_ERROR (Status) && (FileSystem == LogDevice->FileSystem)) {
+      return EFI_SUCCESS;
+    }
+
+    //
+    // Close the files of the old file system, so it can release them, and open the
+    // files again on the new one.
+    //
+    CloseLogFiles (LogDevice);
+  }
+
+  LogDevice->Volume = VolumeFromFileSystemHandle (LogDevice);
+  if (NULL == LogDevice->Volume) {
+    return EFI_INVALID_PARAMETER;
   }
 
   if (LogDevice->FileIndex == 0) {
-    Status = DetermineLogFile (LogDevice, Volume);
+    if (FeaturePcdGet (PcdAdvancedFileLoggerAppend)) {
+      Status = DetermineAppendLogFile (LogDevice, LogDevice->Volume);
+    } else {
+      Status = DetermineLogFile (LogDevice, LogDevice->Volume);
+    }
+
     if (EFI_ERROR (Status)) {
-      goto CloseAndExit;
+      return Status;
     }
   }
 
-  //
-  // Open selected log file
-  //
-  Status = Volume->Open (
-                     Volume,
-                     &File,
-                     mLogFiles[LogDevice->FileIndex].LogFileName,
-                     EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE,
-                     0
-                     );
+  Status = LogDevice->Volume->Open (
+                                LogDevice->Volume,
+                                &LogDevice->File,
+                                mLogFiles[LogDevice->FileIndex].LogFileName,
+                                EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE,
+                                0
+                                );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Unable to open log file. Code = %r\n", __FUNCTION__, Status));
+    LogDevice->File = NULL;
+    return Status;
+  }
+
+  if (FeaturePcdGet (PcdAdvancedFileLoggerAppend) && (LogDevice->IndexFile == NULL)) {
+    Status = LogDevice->Volume->Open (
+                                  LogDevice->Volume,
+                                  &LogDevice->IndexFile,
+                                  mLogFiles[0].LogFileName,
+                                  EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE,
+                                  0
+                                  );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a: Unable to open log index file. Code = %r\n", __FUNCTION__, Status));
+      LogDevice->IndexFile = NULL;
+      return Status;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  NextAppendLogFile
+
+  Continue an append-only log at the start of the next log file, when the current log
+  file is full.
+
+  @param   LogDevice        Which log device to write the log to
+
+  @retval  EFI_SUCCESS      LogDevice->File is the next log file, positioned at its start
+  @retval  other            An error occurred
+
+  **/
+STATIC
+EFI_STATUS
+NextAppendLogFile (
+  IN LOG_DEVICE  *LogDevice
+  )
+{
+  EFI_STATUS  Status;
+
+  LogDevice->File->Close (LogDevice->File);
+  LogDevice->File = NULL;
+
+  LogDevice->FileIndex     = (LogDevice->FileIndex >= DEBUG_LOG_FILE_COUNT - 1) ? 1 : LogDevice->FileIndex + 1;
+  LogDevice->CurrentOffset = 0;
+
+  Status = LogDevice->Volume->Open (
+                                LogDevice->Volume,
+                                &LogDevice->File,
+                                mLogFiles[LogDevice->FileIndex].LogFileName,
+                                EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE,
+                                0
+                                );
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: Unable to open log file. Code = %r\n", __FUNCTION__, Status));
+    LogDevice->File = NULL;
+    return Status;
+  }
+
+  return LogDevice->File->SetPosition (LogDevice->File, 0);
+}
+
+/**
+  WriteLogIndex
+
+  Save the log file index and the offset where the next flush continues in the log index
+  file.
+
+  @param   LogDevice        Which log device to write the log to
+
+  @retval  EFI_SUCCESS      The log index file was updated
+  @retval  other            An error occurred
+
+  **/
+STATIC
+EFI_STATUS
+WriteLogIndex (
+  IN LOG_DEVICE  *LogDevice
+  )
+{
+  UINTN       BufferSize;
+  CHAR8       IndexValue[APPEND_INDEX_FILE_SIZE + 1];
+  EFI_STATUS  Status;
+
+  AsciiSPrint (
+    IndexValue,
+    sizeof (IndexValue),
+    "%d %016lx\n",
+    (UINT32)LogDevice->FileIndex,
+    LogDevice->CurrentOffset
+    );
+
+  Status = LogDevice->IndexFile->SetPosition (LogDevice->IndexFile, 0);
+  if (!EFI_ERROR (Status)) {
+    BufferSize = APPEND_INDEX_FILE_SIZE;
+    Status     = LogDevice->IndexFile->Write (LogDevice->IndexFile, &BufferSize, IndexValue);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = LogDevice->IndexFile->Flush (LogDevice->IndexFile);
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to update debug log index file: %r !\n", __FUNCTION__, Status));
+  }
+
+  return Status;
+}
+
+/**
+  WriteALogFIle
+
+  Writes the currently unwritten part of the log file.
+
+  The formatted lines are staged in the write buffer, so the log file is written in
+  DEBUG_LOG_WRITE_BUFFER_SIZE pieces that end on a media block boundary.
+
+  The log files stay open between flushes.  When PcdAdvancedFileLoggerAppend is TRUE,
+  a full log file continues in the next log file, and each flush is checkpointed in the
+  log index file.
+
+  @param   LogDevice        Which log device to write the log to
+
+  @retval  EFI_SUCCESS      The log was updated
+  @retval  other            An error occurred.  The log device was disabled
+
+  **/
+EFI_STATUS
+WriteALogFile (
+  IN LOG_DEVICE  *LogDevice
+  )
+{
+  UINTN        BufferLen;
+  UINTN        BufferLimit;
+  UINTN        BytesWritten;
+  UINTN        CopySize;
+  EFI_FILE     *File;
+  UINTN        LineCount;
+  CONST CHAR8  *Message;
+  UINTN        WriteCount;
+  UINTN        WriteSize;
+  UINT64       RoomLeft;
+  EFI_STATUS   Status;
+  UINT64       TimeStart;
+
+  if (!LogDevice->Valid || (mWriteBuffer == NULL)) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  TimeStart = GetPerformanceCounter ();
+
+  Status = OpenLogFiles (LogDevice);
+  if (EFI_ERROR (Status)) {
     goto CloseAndExit;
   }
 
   //
-  // Reposition the log file to the current offset.
+  // Reposition the log file to the current offset, as the end of file marker of the
+  // last flush moved it.
   //
+  File   = LogDevice->File;
   Status = File->SetPosition (File, LogDevice->CurrentOffset);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: Failed to seek to current offset: %r !\n", __FUNCTION__, Status));
     goto CloseAndExit;
   }
 
-  RoomLeft = DEBUG_LOG_FILE_SIZE - LogDevice->CurrentOffset;
-  Status   = AdvancedLoggerAccessLibGetNextFormattedLine (&LogDevice->AccessEntry);
+  //
+  // The first write only fills the buffer up to the next block boundary of the file.
+  //
+  BufferLen    = 0;
+  BufferLimit  = DEBUG_LOG_WRITE_BUFFER_SIZE - (UINTN)ModU64x32 (LogDevice->CurrentOffset, LogDevice->BlockSize);
+  BytesWritten = 0;
+  LineCount    = 0;
+  WriteCount   = 0;
+  RoomLeft     = DEBUG_LOG_FILE_SIZE - LogDevice->CurrentOffset;
+  Status       = AdvancedLoggerAccessLibGetNextFormattedLine (&LogDevice->AccessEntry);
 
   while (Status == EFI_SUCCESS) {
     WriteSize = LogDevice->AccessEntry.MessageLen;
     if (WriteSize > RoomLeft) {
-      WriteSize = RoomLeft;
-      DEBUG ((DEBUG_ERROR, "Log file truncated\n"));
+      if (FeaturePcdGet (PcdAdvancedFileLoggerAppend)) {
+        Status = FlushWriteBuffer (LogDevice, File, &BufferLen, &WriteCount);
+        if (!EFI_ERROR (Status)) {
+          Status = NextAppendLogFile (LogDevice);
+        }
+
+        if (EFI_ERROR (Status)) {
+          goto CloseAndExit;
+        }
+
+        File        = LogDevice->File;
+        BufferLimit = DEBUG_LOG_WRITE_BUFFER_SIZE;
+        RoomLeft    = DEBUG_LOG_FILE_SIZE;
+      } else {
+        WriteSize = (UINTN)RoomLeft;
+        DEBUG ((DEBUG_ERROR, "Log file truncated\n"));
+      }
     }
 
-    if (WriteSize > 0) {
-      Status = File->Write (File, &WriteSize, (VOID *)LogDevice->AccessEntry.Message);
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "%a: Failed to write to log file: %r !\n", __FUNCTION__, Status));
-        goto CloseAndExit;
+    LineCount++;
+    BytesWritten += WriteSize;
+    RoomLeft     -= WriteSize;
+    Message       = LogDevice->AccessEntry.Message;
+    while (WriteSize > 0) {
+      CopySize = MIN (WriteSize, BufferLimit - BufferLen);
+      CopyMem (mWriteBuffer + BufferLen, Message, CopySize);
+      BufferLen += CopySize;
+      Message   += CopySize;
+      WriteSize -= CopySize;
+
+      if (BufferLen == BufferLimit) {
+        Status = FlushWriteBuffer (LogDevice, File, &BufferLen, &WriteCount);
+        if (EFI_ERROR (Status)) {
+          goto CloseAndExit;
+        }
+
+        BufferLimit = DEBUG_LOG_WRITE_BUFFER_SIZE;
       }
-
-      LogDevice->CurrentOffset += WriteSize;
-      RoomLeft                 -= WriteSize;
     }
 
     Status = AdvancedLoggerAccessLibGetNextFormattedLine (&LogDevice->AccessEntry);
   }
 
   if (Status == EFI_END_OF_FILE) {
+    Status = FlushWriteBuffer (LogDevice, File, &BufferLen, &WriteCount);
+    if (EFI_ERROR (Status)) {
+      goto CloseAndExit;
+    }
+
+    DEBUG ((
+      DEBUG_INFO,
+      "%a: %u lines, %u bytes in %u writes, %lu us\n",
+      __FUNCTION__,
+      (UINT32)LineCount,
+      (UINT32)BytesWritten,
+      (UINT32)WriteCount,
+      DivU64x32 (GetTimeInNanoSecond (GetPerformanceCounter () - TimeStart), 1000)
+      ));
+
     //
     // Write End Of Buffer file mark.
     //
@@ -561,6 +956,17 @@ WriteALogFile (
     }
   }
 
+  //
+  // The log file is not closed, so flush it to the media.
+  //
+  if (!EFI_ERROR (Status)) {
+    Status = File->Flush (File);
+  }
+
+  if (!EFI_ERROR (Status) && FeaturePcdGet (PcdAdvancedFileLoggerAppend) && (LineCount != 0)) {
+    Status = WriteLogIndex (LogDevice);
+  }
+
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: Failed to write to log file: %r !\n", __FUNCTION__, Status));
     goto CloseAndExit;
@@ -570,14 +976,7 @@ CloseAndExit:
 
   if (EFI_ERROR (Status)) {
     LogDevice->Valid = FALSE;
-  }
-
-  if (File != NULL) {
-    File->Close (File);
-  }
-
-  if (Volume != NULL) {
-    Volume->Close (Volume);
+    CloseLogFiles (LogDevice);
   }
 
   return Status;
@@ -610,11 +1009,29 @@ EnableLoggingOnThisDevice (
   IN LOG_DEVICE  *LogDevice
   )
 {
-  CHAR8       *DataBuffer;
-  EFI_FILE    *File;
-  UINTN       i;
-  EFI_STATUS  Status;
-  EFI_FILE    *Volume;
+  EFI_BLOCK_IO_PROTOCOL  *BlockIo;
+  CHAR8                  *DataBuffer;
+  EFI_FILE               *File;
+  UINTN                  i;
+  EFI_STATUS             Status;
+  EFI_FILE               *Volume;
+
+  if (mWriteBuffer == NULL) {
+    mWriteBuffer = (CHAR8 *)AllocatePages (EFI_SIZE_TO_PAGES (DEBUG_LOG_WRITE_BUFFER_SIZE));
+    if (mWriteBuffer == NULL) {
+      DEBUG ((DEBUG_ERROR, "Unable to allocate write buffer\n"));
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
+
+  //
+  // Align the log writes to the media blocks.  Use the page size when the block size is not known.
+  //
+  LogDevice->BlockSize = EFI_PAGE_SIZE;
+  Status               = gBS->HandleProtocol (LogDevice->Handle, &gEfiBlockIoProtocolGuid, (VOID **)&BlockIo);
+  if (!EFI_ERROR (Status) && (BlockIo->Media->BlockSize != 0) && (BlockIo->Media->BlockSize <= DEBUG_LOG_WRITE_BUFFER_SIZE)) {
+    LogDevice->BlockSize = BlockIo->Media->BlockSize;
+  }
 
   File       = NULL;
   Volume     = NULL;
@@ -655,7 +1072,7 @@ EnableLoggingOnThisDevice (
 
     if (EFI_SUCCESS == Status) {
       if (i == 0) {
-        Status = ValidateLogFile (File, INDEX_FILE_SIZE);
+        Status = ValidateLogFile (File, LOG_INDEX_FILE_SIZE);
       } else {
         Status = ValidateLogFile (File, DEBUG_LOG_FILE_SIZE);
       }
@@ -0,0 +1,165 @@
+/** @file AdvancedFileLoggerGoogleTest.cpp
+
+    This file contains the host tests for the log file access of the Advanced File
+    Logger.  When appending, the log index file records the log file and the offset
+    where the last flush ended, and the next boot continues the log from there.
+
+    Copyright (c) Microsoft Corporation.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Library/GoogleTestLib.h>
+
+extern "C" {
+  #include "../AdvancedFileLogger.h"
+
+  EFI_STATUS
+  DetermineAppendLogFile (
+    IN LOG_DEVICE  *LogDevice,
+    IN EFI_FILE    *Volume
+    );
+}
+
+using namespace testing;
+
+//
+// The last log file, after which the append log wraps back to log file 1.
+//
+#define LAST_LOG_FILE_INDEX  9
+
+//
+// Contents of the log index file read by the fake volume.
+//
+STATIC CHAR8  mIndexFileValue[APPEND_INDEX_FILE_SIZE + 1];
+
+EFI_STATUS
+EFIAPI
+FakeFileOpen (
+  IN EFI_FILE_PROTOCOL   *This,
+  OUT EFI_FILE_PROTOCOL  **NewHandle,
+  IN CHAR16              *FileName,
+  IN UINT64              OpenMode,
+  IN UINT64              Attributes
+  )
+{
+  *NewHandle = This;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+FakeFileClose (
+  IN EFI_FILE_PROTOCOL  *This
+  )
+{
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+FakeFileRead (
+  IN EFI_FILE_PROTOCOL  *This,
+  IN OUT UINTN          *BufferSize,
+  OUT VOID              *Buffer
+  )
+{
+  *BufferSize = MIN (*BufferSize, (UINTN)APPEND_INDEX_FILE_SIZE);
+  CopyMem (Buffer, mIndexFileValue, *BufferSize);
+  return EFI_SUCCESS;
+}
+
+/**
+  Test class for the append log index.
+**/
+class AdvancedFileLoggerAppendTest : public Test {
+protected:
+  EFI_FILE_PROTOCOL  Volume;
+  LOG_DEVICE         LogDevice;
+
+  void
+  SetUp (
+    ) override
+  {
+    ZeroMem (&Volume, sizeof (Volume));
+    Volume.Open  = FakeFileOpen;
+    Volume.Close = FakeFileClose;
+    Volume.Read  = FakeFileRead;
+
+    ZeroMem (&LogDevice, sizeof (LogDevice));
+    LogDevice.Valid = TRUE;
+  }
+
+  //
+  // Write the log index file, as WriteLogIndex does at the end of a flush.
+  //
+  VOID
+  SetLogIndex (
+    UINTN   FileIndex,
+    UINT64  FileOffset
+    )
+  {
+    AsciiSPrint (mIndexFileValue, sizeof (mIndexFileValue), "%d %016lx\n", (UINT32)FileIndex, FileOffset);
+    ASSERT_EQ (AsciiStrLen (mIndexFileValue), (UINTN)APPEND_INDEX_FILE_SIZE);
+  }
+};
+
+//
+// A partly written log file is continued at the offset where the last flush ended.
+//
+TEST_F (AdvancedFileLoggerAppendTest, PartialLogFileIsContinued) {
+  SetLogIndex (3, DEBUG_LOG_FILE_SIZE - DEBUG_LOG_CHUNK_SIZE);
+
+  ASSERT_EQ (DetermineAppendLogFile (&LogDevice, &Volume), EFI_SUCCESS);
+  EXPECT_EQ (LogDevice.FileIndex, (UINTN)3);
+  EXPECT_EQ (LogDevice.CurrentOffset, (UINT64)(DEBUG_LOG_FILE_SIZE - DEBUG_LOG_CHUNK_SIZE));
+  EXPECT_TRUE (LogDevice.Valid);
+}
+
+//
+// A log file filled exactly by the last flush is done, and the log continues at the
+// start of the next log file.
+//
+TEST_F (AdvancedFileLoggerAppendTest, FullLogFileMovesToNextLogFile) {
+  SetLogIndex (3, DEBUG_LOG_FILE_SIZE);
+
+  ASSERT_EQ (DetermineAppendLogFile (&LogDevice, &Volume), EFI_SUCCESS);
+  EXPECT_EQ (LogDevice.FileIndex, (UINTN)4);
+  EXPECT_EQ (LogDevice.CurrentOffset, (UINT64)0);
+}
+
+//
+// A full last log file wraps to log file 1.
+//
+TEST_F (AdvancedFileLoggerAppendTest, FullLastLogFileWrapsToFirstLogFile) {
+  SetLogIndex (LAST_LOG_FILE_INDEX, DEBUG_LOG_FILE_SIZE);
+
+  ASSERT_EQ (DetermineAppendLogFile (&LogDevice, &Volume), EFI_SUCCESS);
+  EXPECT_EQ (LogDevice.FileIndex, (UINTN)1);
+  EXPECT_EQ (LogDevice.CurrentOffset, (UINT64)0);
+}
+
+//
+// An offset past the end of the log file, or a bad log file index, is not valid and
+// the log restarts at the start of log file 1.
+//
+TEST_F (AdvancedFileLoggerAppendTest, InvalidLogIndexRestartsFirstLogFile) {
+  SetLogIndex (3, DEBUG_LOG_FILE_SIZE + 1);
+  ASSERT_EQ (DetermineAppendLogFile (&LogDevice, &Volume), EFI_SUCCESS);
+  EXPECT_EQ (LogDevice.FileIndex, (UINTN)1);
+  EXPECT_EQ (LogDevice.CurrentOffset, (UINT64)0);
+
+  SetLogIndex (0, DEBUG_LOG_CHUNK_SIZE);
+  ASSERT_EQ (DetermineAppendLogFile (&LogDevice, &Volume), EFI_SUCCESS);
+  EXPECT_EQ (LogDevice.FileIndex, (UINTN)1);
+  EXPECT_EQ (LogDevice.CurrentOffset, (UINT64)0);
+}
+
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  InitGoogleTest (&argc, argv);
+  return RUN_ALL_TESTS ();
+}
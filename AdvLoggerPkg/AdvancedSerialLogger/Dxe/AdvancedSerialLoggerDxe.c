@@ -9,8 +9,17 @@
 
 #include "AdvancedSerialLoggerDxe.h"
 
-#define ADV_LOG_REFRESH_INTERVAL    (200 * 10 * 1000) // Refresh interval: 200ms in 100ns units
-#define ADV_LOG_MESSAGES_PER_EVENT  1000
+#define ADV_LOG_REFRESH_INTERVAL  (200 * 10 * 1000)  // Refresh interval: 200ms in 100ns units
+
+//
+// Each timer event writes the bytes the serial port can send in ADV_LOG_DRAIN_TIME_NS, so
+// the drain takes about a tenth of the boot time between events.  The first budget
+// is from the baud rate, with a start, eight data and a stop bit for each byte.  After
+// that, the budget is from the rate measured for the previous event, formatting included.
+//
+#define ADV_LOG_DRAIN_TIME_NS        (20ULL * 1000 * 1000)  // 20ms of each refresh interval
+#define ADV_LOG_UART_BITS_PER_BYTE   10
+#define ADV_LOG_MIN_BYTES_PER_EVENT  256
 
 //
 // Global variables.
@@ -21,25 +30,103 @@ STATIC EFI_EVENT                                  mExitBootServicesEvent       =
 STATIC EFI_EVENT                                  mResetNotificationEvent      = NULL;
 STATIC EFI_RESET_NOTIFICATION_PROTOCOL            *mResetNotificationProtocol  = NULL;
 STATIC ADVANCED_LOGGER_INFO                       *mLoggerInfo;
+STATIC UINTN                                      mBytesPerEvent;
+STATIC UINT32                                     mSerialLag    = 0;
+STATIC UINT32                                     mSerialMaxLag = 0;
+
+/**
+  Get the time between two performance counter values.
+
+  @param  StartTicks       Performance counter value at the start.
+  @param  EndTicks         Performance counter value at the end.
+
+  @retval Time between StartTicks and EndTicks in nanoseconds.
+
+  **/
+STATIC
+UINT64
+GetElapsedNanoSeconds (
+  IN UINT64  StartTicks,
+  IN UINT64  EndTicks
+  )
+{
+  UINT64  CounterStart;
+  UINT64  CounterEnd;
+
+  GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  if (CounterStart > CounterEnd) {
+    return GetTimeInNanoSecond (StartTicks - EndTicks);
+  }
+
+  return GetTimeInNanoSecond (EndTicks - StartTicks);
+}
+
+/**
+  Update the serial lag, the number of bytes of the log that were not yet written
+  to the serial port.  This is the log past the cursor, plus the bytes of the open
+  log chunks that follow the chunk cursors.
+
+  **/
+STATIC
+VOID
+UpdateSerialLag (
+  VOID
+  )
+{
+  ADVANCED_LOGGER_CHUNK_HEADER  *Chunk;
+  UINT32                        ChunkEnd;
+  UINT32                        Cursor;
+  UINTN                         Index;
+
+  Cursor = MAX (mAccessEntry.BlockEntry.NextOffset, mLoggerInfo->LogBufferOffset);
+  if (mLoggerInfo->LogCurrentOffset > Cursor) {
+    mSerialLag = mLoggerInfo->LogCurrentOffset - Cursor;
+  } else {
+    mSerialLag = 0;
+  }
+
+  //
+  // The cursor is already past the chunks that are open, so add the bytes that were
+  // logged to them and not yet written.
+  //
+  for (Index = 0; Index < ADVANCED_LOGGER_ACCESS_MAX_CHUNKS; Index++) {
+    if (mAccessEntry.BlockEntry.ChunkOffset[Index] == 0) {
+      continue;
+    }
+
+    Chunk    = (ADVANCED_LOGGER_CHUNK_HEADER *)((UINT8 *)mLoggerInfo + mAccessEntry.BlockEntry.ChunkOffset[Index]);
+    ChunkEnd = mAccessEntry.BlockEntry.ChunkOffset[Index] + CHUNK_USED_SIZE (Chunk);
+    if (ChunkEnd > mAccessEntry.BlockEntry.ChunkCursor[Index]) {
+      mSerialLag += ChunkEnd - mAccessEntry.BlockEntry.ChunkCursor[Index];
+    }
+  }
+
+  mSerialMaxLag = MAX (mSerialMaxLag, mSerialLag);
+}
 
 /**
   WriteToSerialPort
 
   Writes the currently unwritten part of the log to the serial port.
 
+  Entries that are not selected for the serial port are skipped by the access library
+  from their header, without being formatted.  Lines are written until MaxBytes have been
+  written, and the rest of the log is left for the next call.
 
-  @retval  EFI_SUCCESS      The log was updated
-  @retval  other            An error occurred.  The log device was disabled
+  @param  MaxBytes     Number of bytes to write before returning, MAX_UINTN to write all
+                       of the log.
 
   **/
 VOID
 WriteToSerialPort (
-  IN UINTN  MaxLineCount
+  IN UINTN  MaxBytes
   )
 {
-  UINTN       LineCount;
+  UINTN       Written;
   EFI_STATUS  Status;
   UINTN       WriteSize;
+  UINT64      StartTicks;
+  UINT64      ElapsedNs;
 
  #if 0
 
@@ -63,26 +150,52 @@ WriteToSerialPort (
 
  #endif
 
-  LineCount = 0;
-  Status    = AdvancedLoggerAccessLibGetNextFormattedLine (&mAccessEntry);
-  while ((Status == EFI_SUCCESS) && (LineCount < MaxLineCount)) {
+  if (mLoggerInfo == NULL) {
+    return;
+  }
+
+  //
+  // The access library treats a mask of 0 as all levels, but a HdwPort level of 0
+  // selects no messages for the serial port.
+  //
+  mAccessEntry.BlockEntry.DebugLevelMask = PcdGet32 (PcdAdvancedLoggerHdwPortDebugPrintErrorLevel);
+  if (mAccessEntry.BlockEntry.DebugLevelMask == 0) {
+    return;
+  }
+
+  Written    = 0;
+  StartTicks = GetPerformanceCounter ();
+  while (Written < MaxBytes) {
+    Status = AdvancedLoggerAccessLibGetNextFormattedLine (&mAccessEntry);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
     WriteSize = mAccessEntry.MessageLen;
     if (WriteSize > 0) {
-      // Only selected messages go to the serial port.
-
-      if (mAccessEntry.DebugLevel & PcdGet32 (PcdAdvancedLoggerHdwPortDebugPrintErrorLevel)) {
-        Status = SerialPortWrite ((UINT8 *)mAccessEntry.Message, mAccessEntry.MessageLen);
-        if (EFI_ERROR (Status)) {
-          DEBUG ((DEBUG_ERROR, "%a: Failed to write to serial port: %r\n", __FUNCTION__, Status));
-          break;
-        }
+      // Only selected messages are returned by the access library.
+      if (SerialPortWrite ((UINT8 *)mAccessEntry.Message, WriteSize) == 0) {
+        DEBUG ((DEBUG_ERROR, "%a: Failed to write to serial port\n", __FUNCTION__));
+        break;
       }
+
+      Written += WriteSize;
     }
+  }
 
-    Status = AdvancedLoggerAccessLibGetNextFormattedLine (&mAccessEntry);
-    LineCount++;
+  //
+  // When the budget was used, it is sized again from the rate of this call.
+  //
+  if ((MaxBytes == mBytesPerEvent) && (Written >= MaxBytes)) {
+    ElapsedNs = GetElapsedNanoSeconds (StartTicks, GetPerformanceCounter ());
+    if (ElapsedNs != 0) {
+      mBytesPerEvent = (UINTN)DivU64x64Remainder (MultU64x64 (Written, ADV_LOG_DRAIN_TIME_NS), ElapsedNs, NULL);
+      mBytesPerEvent = MAX (mBytesPerEvent, ADV_LOG_MIN_BYTES_PER_EVENT);
+    }
   }
 
+  UpdateSerialLag ();
+
   return;
 }
 
@@ -177,7 +290,7 @@ OnWriteSerialTimerCallback (
   IN VOID       *Context
   )
 {
-  WriteToSerialPort (ADV_LOG_MESSAGES_PER_EVENT);
+  WriteToSerialPort (mBytesPerEvent);
 }
 
 /**
@@ -198,6 +311,16 @@ OnExitBootServicesNotification (
   IN VOID       *Context
   )
 {
+  UpdateSerialLag ();
+  DEBUG ((
+    DEBUG_INFO,
+    "%a: Serial lag %u bytes, maximum lag %u bytes, %Lu bytes per event\n",
+    __FUNCTION__,
+    mSerialLag,
+    mSerialMaxLag,
+    (UINT64)mBytesPerEvent
+    ));
+
   WriteToSerialPort (MAX_UINTN);
 
   gBS->CloseEvent (Event);
@@ -395,12 +518,18 @@ AdvancedSerialLoggerEntry (
 
   SerialPortInitialize ();
 
-  mLoggerInfo = LOGGER_INFO_FROM_PROTOCOL (LoggerProtocol);
+  mLoggerInfo    = LOGGER_INFO_FROM_PROTOCOL (LoggerProtocol);
+  mBytesPerEvent = (UINTN)DivU64x64Remainder (
+                            MultU64x64 (PcdGet64 (PcdUartDefaultBaudRate), ADV_LOG_DRAIN_TIME_NS),
+                            ADV_LOG_UART_BITS_PER_BYTE * 1000ULL * 1000 * 1000,
+                            NULL
+                            );
+  mBytesPerEvent = MAX (mBytesPerEvent, ADV_LOG_MIN_BYTES_PER_EVENT);
 
   //
   // Step 1 - Start the first group of messages
   //
-  WriteToSerialPort (ADV_LOG_MESSAGES_PER_EVENT);
+  WriteToSerialPort (mBytesPerEvent);
 
   //
   // Step 2 - Register for timer events
@@ -10,6 +10,13 @@ import argparse
 import tempfile
 import traceback
 import copy
+import codecs
+import mmap
+import heapq
+import json
+import hashlib
+import zlib
+import os
 
 from win32com.shell import shell
 from edk2toollib.os.uefivariablesupport import UefiVariable
@@ -247,6 +254,27 @@ class AdvLogParser ():
     #
     #
     MESSAGE_ENTRY_SIZE_V2 = 24
+    # ---------------------------------------------------------------------- #
+    #
+    #
+    # typedef struct {
+    #   UINT32    Signature;                            // Signature 'ALM3'
+    #   UINT8     MajorVersion;                         // Major version of advanced logger message structure
+    #   UINT8     MinorVersion;                         // Minor version of advanced logger message structure
+    #   UINT32    DebugLevel;                           // Debug Level
+    #   UINT64    TimeStamp;                            // Time stamp
+    #   UINT16    Phase;                                // Boot phase that produced this message entry
+    #   UINT16    DataLen;                              // Number of bytes in Data
+    #   UINT16    DataOffset;                           // Offset of Data from start of structure
+    #   UINT16    FormatLen;                            // Number of bytes in the format string
+    #   UINT64    FormatAddress;                        // Address of the format string
+    #   UINT32    FormatHash;                           // CRC32 of the format string
+    #   UINT8     Data[];                               // UINT64 per argument, then the copied
+    #                                                   // string, GUID and time arguments
+    # } ADVANCED_LOGGER_MESSAGE_ENTRY_V3;
+    #
+    #
+    DEFERRED_ARG_NULL = 0xFFFFFFFFFFFFFFFF
     ADVANCED_LOGGER_PHASE_UNSPECIFIED = 0
     ADVANCED_LOGGER_PHASE_SEC = 1
     ADVANCED_LOGGER_PHASE_PEI = 2
@@ -263,6 +291,21 @@ class AdvLogParser ():
                          "[DXE]", "[RUNTIME]", "[MM_CORE]", "[MM]",
                          "[SMM_CORE]", "[SMM]", "[TFA]"]
 
+    # ---------------------------------------------------------------------- #
+    #
+    #
+    # typedef volatile struct {
+    #   UINT32    Signature;                            // Signature 'ALMK'
+    #   UINT32    ChunkSize;                            // Size of the chunk, including this header
+    #   UINT32    UsedSize;                             // Bytes of the chunk reserved, including this header.
+    #                                                   // CHUNK_CLOSED is set when no more entries will be added.
+    #   UINT32    ProcessorIndex;                       // Processor that reserved the chunk
+    # } ADVANCED_LOGGER_CHUNK_HEADER;
+    #
+    #
+    CHUNK_HEADER_SIZE = 16
+    CHUNK_CLOSED = 0x80000000
+
     # Debug levels from MU_BASECORE\MdePkg\Include\Library\DebugLib.h
     # //
     # // Declare bits for PcdDebugPrintErrorLevel and the ErrorLevel parameter of DebugPrint()
@@ -340,6 +383,25 @@ class AdvLogParser ():
     END_OF_FILE = 1
     ABORTED = 2
 
+    EFI_ERROR_STRINGS = ["Success", "Load Error", "Invalid Parameter", "Unsupported",
+                         "Bad Buffer Size", "Buffer Too Small", "Not Ready", "Device Error",
+                         "Write Protected", "Out of Resources", "Volume Corrupt", "Volume Full",
+                         "No Media", "Media changed", "Not Found", "Access Denied",
+                         "No Response", "No mapping", "Time out", "Not started",
+                         "Already started", "Aborted", "ICMP Error", "TFTP Error",
+                         "Protocol Error", "Incompatible Version", "Security Violation",
+                         "CRC Error", "End of Media", "Reserved (29)", "Reserved (30)",
+                         "End of File", "Invalid Language", "Compromised Data"]
+
+    # ---------------------------------------------------------------------- #
+    #
+    #   FormatTable maps the address of a format string to the format string,
+    #   and is used to format deferred ('ALM3') message entries.
+    #
+    # ---------------------------------------------------------------------- #
+    def __init__(self, FormatTable=None):
+        self.FormatTable = FormatTable if FormatTable is not None else {}
+
     # ---------------------------------------------------------------------- #
     #
     # AdvLogParser Class Functions
@@ -518,6 +580,154 @@ class AdvLogParser ():
     #
     # ---------------------------------------------------------------------- #
 
+    # ---------------------------------------------------------------------- #
+    #
+    #   _FormatDeferredArg - Format one argument of a deferred message the
+    #                        way the UEFI PrintLib does.
+    #
+    # ---------------------------------------------------------------------- #
+    def _FormatDeferredArg(self, Type, Flags, Width, Long, Arg, Copies):
+        if Type in "aSsgt":
+            if Arg == self.DEFERRED_ARG_NULL:
+                return "<null guid>" if Type == 'g' else "<null string>"
+
+            Copy = Copies[Arg:]
+            if Type == 'a':
+                Text = Copy.split(b'\0', 1)[0].decode('utf-8', 'replace')
+            elif Type in "sS":
+                Text = Copy.decode('utf-16-le', 'replace').split('\0', 1)[0]
+            elif Type == 'g':
+                (Data1, Data2, Data3) = struct.unpack("=IHH", Copy[0:8])
+                Text = "%08x-%04x-%04x-%s-%s" % (Data1, Data2, Data3, Copy[8:10].hex(), Copy[10:16].hex())
+            else:
+                (Year, Month, Day, Hour, Minute) = struct.unpack("=HBBBB", Copy[0:6])
+                Text = "%02d/%02d/%04d  %02d:%02d" % (Month, Day, Year, Hour, Minute)
+            Flags = Flags.replace('0', '')
+        elif Type == 'r':
+            Index = Arg & ~(1 << 63)
+            if Arg == 0 or (Arg != Index and 0 < Index < len(self.EFI_ERROR_STRINGS)):
+                Text = self.EFI_ERROR_STRINGS[Index]
+            else:
+                Text = "%08X" % Arg
+            Flags = Flags.replace('0', '')
+        elif Type == 'c':
+            Text = chr(Arg & 0xFFFF)
+        else:
+            Bits = 64 if Long or Type == 'p' else 32
+            Arg &= (1 << Bits) - 1
+            if Type == 'd' and Arg >= (1 << (Bits - 1)):
+                Arg -= (1 << Bits)
+
+            if Type == 'p':
+                Text = "%016X" % Arg
+            elif Type == 'X':
+                Text = "%X" % Arg
+            elif Type == 'x':
+                Text = "%x" % Arg
+            else:
+                Text = "%d" % Arg
+                if ',' in Flags:
+                    Text = "{:,}".format(Arg)
+                if '+' in Flags and Arg >= 0:
+                    Text = '+' + Text
+                elif ' ' in Flags and Arg >= 0:
+                    Text = ' ' + Text
+
+        if '-' in Flags:
+            return Text.ljust(Width)
+        if '0' in Flags and Type in "dxXu":
+            Sign = Text[0] if Text[:1] in "+- " else ""
+            return Sign + Text[len(Sign):].rjust(Width - len(Sign), '0')
+        return Text.rjust(Width)
+
+    # ---------------------------------------------------------------------- #
+    #
+    #   _FormatDeferredMessage - Format a deferred ('ALM3') message from its
+    #                            format string address and its arguments.
+    #                            The format string of the table must have
+    #                            the CRC32 that was logged with the message.
+    #
+    # ---------------------------------------------------------------------- #
+    def _FormatDeferredMessage(self, FormatAddress, FormatHash, Data):
+        ArgCount = 0
+        Words = [struct.unpack("=Q", Data[Offset:Offset + 8])[0] for Offset in range(0, len(Data) - 7, 8)]
+        Format = self.FormatTable.get(FormatAddress)
+        if Format is None:
+            return "<deferred message 0x%X %s>\n" % (FormatAddress, " ".join("0x%X" % Word for Word in Words))
+
+        if zlib.crc32(Format.encode('latin-1', 'replace') + b'\0') != FormatHash:
+            return "<deferred message 0x%X does not match the format table>\n" % FormatAddress
+
+        #
+        # The first pass counts the arguments, so the copies can be found
+        # after the argument words.
+        #
+        Specifiers = []
+        Index = 0
+        while Index < len(Format):
+            if Format[Index] != '%':
+                Specifiers.append(Format[Index])
+                Index += 1
+                continue
+
+            #
+            # Flags, then the width, then the precision.  The precision is
+            # not used for the arguments a deferred message can have.
+            #
+            Flags = ""
+            Width = 0
+            WidthArg = None
+            Precision = False
+            Long = False
+            Index += 1
+            while Index < len(Format) and (Format[Index] in "-+ ,.*Ll" or Format[Index].isdigit()):
+                if Format[Index] == '*':
+                    if not Precision:
+                        WidthArg = ArgCount
+                    ArgCount += 1
+                elif Format[Index] in "Ll":
+                    Long = True
+                elif Format[Index] == '.':
+                    Precision = True
+                elif Precision:
+                    pass
+                elif Format[Index] == '0' and Width == 0:
+                    Flags += '0'
+                elif Format[Index].isdigit():
+                    Width = Width * 10 + int(Format[Index])
+                else:
+                    Flags += Format[Index]
+                Index += 1
+
+            if Index >= len(Format):
+                break
+
+            Type = Format[Index]
+            Index += 1
+            if Type in "%\n\r":
+                Specifiers.append('\n' if Type == '\n' else ('\r\n' if Type == '\r' else '%'))
+                continue
+
+            Specifiers.append((Type, Flags, Width, WidthArg, Long, ArgCount))
+            ArgCount += 1
+
+        if ArgCount > len(Words):
+            return "<deferred message 0x%X has too few arguments>\n" % FormatAddress
+
+        Copies = Data[ArgCount * 8:]
+        Text = ""
+        for Specifier in Specifiers:
+            if isinstance(Specifier, str):
+                Text += Specifier
+                continue
+
+            (Type, Flags, Width, WidthArg, Long, ArgIndex) = Specifier
+            if WidthArg is not None:
+                Width = Words[WidthArg]
+            Text += self._FormatDeferredArg(Type, Flags, Width, Long, Words[ArgIndex], Copies)
+
+        return Text
+
     # ---------------------------------------------------------------------- #
     #
     #   _ReadMessageEntry - Read message segment from the file
@@ -547,6 +757,21 @@ class AdvLogParser ():
             # Offset is from the start of the structure, so we do that from the beginning of this file
             InFile.seek(EntryStart + MessageEntry["MessageOffset"])
             MessageEntry["MessageText"] = InFile.read(MessageEntry["MessageLen"]).decode('utf-8', 'replace')
+        elif (MessageEntry["Signature"] == 'ALM3'):
+            MessageEntry["MajorVersion"] = struct.unpack("=B", InFile.read(1))[0]
+            MessageEntry["MinorVersion"] = struct.unpack("=B", InFile.read(1))[0]
+            MessageEntry["DebugLevel"] = struct.unpack("=I", InFile.read(4))[0]
+            MessageEntry["TimeStamp"] = struct.unpack("=Q", InFile.read(8))[0]
+            MessageEntry["Phase"] = struct.unpack("=H", InFile.read(2))[0]
+            MessageEntry["DataLen"] = struct.unpack("=H", InFile.read(2))[0]
+            MessageEntry["MessageOffset"] = struct.unpack("=H", InFile.read(2))[0]
+            InFile.read(2)  # FormatLen
+            FormatAddress = struct.unpack("=Q", InFile.read(8))[0]
+            FormatHash = struct.unpack("=I", InFile.read(4))[0]
+            InFile.seek(EntryStart + MessageEntry["MessageOffset"])
+            Data = InFile.read(MessageEntry["DataLen"])
+            MessageEntry["MessageText"] = self._FormatDeferredMessage(FormatAddress, FormatHash, Data)
+            MessageEntry["MessageLen"] = len(MessageEntry["MessageText"])
         else:
             return (None, None)
 
@@ -561,10 +786,54 @@ class AdvLogParser ():
             NextMessageLen = self.MESSAGE_ENTRY_SIZE + int(int((MessageEntry["MessageLen"] + 7) / 8) * 8)
         elif MessageEntry["Signature"] == 'ALM2':
             NextMessageLen = MessageEntry["MessageOffset"] + int(int((MessageEntry["MessageLen"] + 7) / 8) * 8)
+        elif MessageEntry["Signature"] == 'ALM3':
+            NextMessageLen = MessageEntry["MessageOffset"] + int(int((MessageEntry["DataLen"] + 7) / 8) * 8)
         NextMessage = NextMessage + NextMessageLen
 
         return (MessageEntry, NextMessage)
 
+    # ---------------------------------------------------------------------- #
+    #
+    #   Read the rest of the log when it holds sharded log chunks.  The
+    #   entries of the chunks are merged with the top level entries, and
+    #   all the entries are returned in TimeStamp order.
+    #
+    # ---------------------------------------------------------------------- #
+    def _ReadChunkEntries(self, LoggerInfo):
+        MessageEntries = []
+
+        InFile = LoggerInfo["InFile"]
+        while InFile.tell() < LoggerInfo["LogCurrent"]:
+            EntryStart = InFile.tell()
+            Signature = InFile.read(4).decode('utf-8', 'replace')
+            if Signature == 'ALMK':
+                ChunkSize = struct.unpack("=I", InFile.read(4))[0]
+                UsedSize = struct.unpack("=I", InFile.read(4))[0] & ~self.CHUNK_CLOSED
+                InFile.read(4)             # skip ProcessorIndex field
+                if ChunkSize < self.CHUNK_HEADER_SIZE or UsedSize > ChunkSize:
+                    raise Exception("Log chunk has invalid size at offset 0x%X" % EntryStart)
+
+                while InFile.tell() < EntryStart + UsedSize:
+                    (MessageEntry, _) = self._ReadMessageEntry(LoggerInfo)
+                    if MessageEntry is None:
+                        # The entry was reserved, but was still being written
+                        break
+
+                    MessageEntries.append(MessageEntry)
+
+                InFile.seek(EntryStart + ChunkSize)
+            else:
+                InFile.seek(EntryStart)
+                (MessageEntry, _) = self._ReadMessageEntry(LoggerInfo)
+                if MessageEntry is None:
+                    raise Exception("Message Block has wrong signature at offset 0x%X" % EntryStart)
+
+                MessageEntries.append(MessageEntry)
+
+        # The sort is stable, so entries with the same TimeStamp stay in log order
+        MessageEntries.sort(key=lambda Entry: Entry["TimeStamp"])
+        return MessageEntries
+
     # ---------------------------------------------------------------------- #
     #
     #   Read the next message block
@@ -582,14 +851,29 @@ class AdvLogParser ():
         if LoggerInfo["LogBuffer"] == LoggerInfo["LogCurrent"]:
             return (self.END_OF_FILE, MessageBlock)
 
-        if InFile.tell() >= LoggerInfo["LogCurrent"]:
-            return (self.END_OF_FILE, MessageBlock)
+        if "ChunkEntries" not in LoggerInfo:
+            if InFile.tell() >= LoggerInfo["LogCurrent"]:
+                return (self.END_OF_FILE, MessageBlock)
+
+            EntryStart = InFile.tell()
+            Signature = InFile.read(4).decode('utf-8', 'replace')
+            InFile.seek(EntryStart)
+            if Signature == 'ALMK':
+                LoggerInfo["ChunkEntries"] = self._ReadChunkEntries(LoggerInfo)
+                LoggerInfo["ChunkIndex"] = 0
 
-        (MessageEntry, NextMessage) = self._ReadMessageEntry(LoggerInfo)
+        if "ChunkEntries" in LoggerInfo:
+            if LoggerInfo["ChunkIndex"] >= len(LoggerInfo["ChunkEntries"]):
+                return (self.END_OF_FILE, MessageBlock)
 
-        if MessageEntry["Signature"] != 'ALMS' and MessageEntry["Signature"] != 'ALM2':
-            print("Log signature was incorrect.  Should be either 'ALMS' or 'ALM2', was '%s'" % MessageEntry["Signature"])
-            raise Exception("Message Block has wrong signature at offset 0x%X" % InFile.tell())
+            MessageEntry = LoggerInfo["ChunkEntries"][LoggerInfo["ChunkIndex"]]
+            LoggerInfo["ChunkIndex"] += 1
+        else:
+            (MessageEntry, NextMessage) = self._ReadMessageEntry(LoggerInfo)
+
+            if MessageEntry["Signature"] not in ('ALMS', 'ALM2', 'ALM3'):
+                print("Log signature was incorrect.  Should be 'ALMS', 'ALM2' or 'ALM3', was '%s'" % MessageEntry["Signature"])
+                raise Exception("Message Block has wrong signature at offset 0x%X" % InFile.tell())
 
         MessageBlock["Message"] = MessageEntry["MessageText"]
         MessageBlock["DebugLevel"] = MessageEntry["DebugLevel"]
@@ -756,7 +1040,7 @@ class AdvLogParser ():
             else:
                 # We found the first legible line, so we can start from here.
                 LogStream = LoggerInfo["InFile"].read()
-                StartOffset = LogStream.find(b'ALM2')
+                StartOffset = min([Offset for Offset in (LogStream.find(b'ALM2'), LogStream.find(b'ALM3')) if Offset != -1], default=-1)
                 if StartOffset == -1:
                     StartOffset = LogStream.find(b'ALMS')
                     if StartOffset == -1:
@@ -947,6 +1231,409 @@ class AdvLogParser ():
 
         return lines
 
+    # ----------------------------------------------------------------------- #
+    #
+    # Streaming decoder
+    #
+    # The streaming decoder maps the log file, and walks the entries in place
+    # without building a list of them.  A first pass over the entry headers
+    # splits the log into segments:
+    #
+    #   - The entries before the first sharded log chunk are one segment, and
+    #     are returned in log order, as _GetNextMessageBlock does.
+    #   - From the first chunk on, the entries are split into runs of rising
+    #     TimeStamp.  Runs that overlap in time are one segment, and are merged
+    #     by TimeStamp.  This returns the entries in the same order as the
+    #     stable sort of _ReadChunkEntries.
+    #
+    # When the log wrapped at runtime, the entries left at the end of the log
+    # buffer are decoded before the entries at the start of the log buffer.
+    #
+    # The segments, the phase changes and a checkpoint every
+    # INDEX_LINE_INTERVAL lines are saved in a sidecar index, so a later
+    # decode can start at a line, a time or a phase without walking the log
+    # again.  A checkpoint is a line that starts at the start of an entry,
+    # and holds the state of the merge of its segment.
+    #
+    # ----------------------------------------------------------------------- #
+    INDEX_VERSION = 1
+    INDEX_LINE_INTERVAL = 4096
+    FIRST_CHECKPOINT = [0, 0, 0, [], 0, None, None, -1]
+    STREAM_WRITE_LINES = 4096
+
+    MESSAGE_ENTRY_V1_HEADER = struct.Struct("=4sIQH")
+    MESSAGE_ENTRY_V2_HEADER = struct.Struct("=4sBBIQHHH")
+    CHUNK_HEADER = struct.Struct("=4sIII")
+    FORMAT_ADDRESS = struct.Struct("=HQI")
+
+    #
+    #   Read the header of the entry at Offset.  Returns (TimeStamp, Phase,
+    #   DebugLevel, Signature, DataStart, DataLen, NextOffset), or None when
+    #   there is no whole entry at Offset.
+    #
+    def _ReadStreamEntry(self, Log, Offset, End):
+        if Offset + self.MESSAGE_ENTRY_SIZE > End:
+            return None
+
+        Signature = Log[Offset:Offset + 4]
+        if Signature == b'ALM2' or Signature == b'ALM3':
+            if Offset + self.MESSAGE_ENTRY_SIZE_V2 > End:
+                return None
+
+            (_, _, _, DebugLevel, TimeStamp, Phase, DataLen, DataOffset) = self.MESSAGE_ENTRY_V2_HEADER.unpack_from(Log, Offset)
+            DataStart = Offset + DataOffset
+        elif Signature == b'ALMS':
+            (_, DebugLevel, TimeStamp, DataLen) = self.MESSAGE_ENTRY_V1_HEADER.unpack_from(Log, Offset)
+            Phase = self.ADVANCED_LOGGER_PHASE_UNSPECIFIED
+            DataStart = Offset + self.MESSAGE_ENTRY_SIZE
+        else:
+            return None
+
+        NextOffset = (DataStart + DataLen + 7) & ~7
+        if NextOffset > End:
+            return None
+
+        return (TimeStamp, Phase, DebugLevel, Signature, DataStart, DataLen, NextOffset)
+
+    #
+    #   Return the message blocks of a run of entries.  Each block is
+    #   (TimeStamp, Phase, DebugLevel, MessageText, Offset).
+    #
+    def _StreamBlocks(self, Log, Start, End):
+        Offset = Start
+        while Offset < End:
+            Entry = self._ReadStreamEntry(Log, Offset, End)
+            if Entry is None:
+                return
+
+            (TimeStamp, Phase, DebugLevel, Signature, DataStart, DataLen, NextOffset) = Entry
+            if Signature == b'ALM3':
+                (_, FormatAddress, FormatHash) = self.FORMAT_ADDRESS.unpack_from(Log, Offset + self.MESSAGE_ENTRY_SIZE_V2)
+                Text = self._FormatDeferredMessage(FormatAddress, FormatHash, Log[DataStart:DataStart + DataLen])
+            else:
+                Text = Log[DataStart:DataStart + DataLen].decode('utf-8', 'replace')
+
+            yield (TimeStamp, Phase, DebugLevel, Text, Offset)
+            Offset = NextOffset
+
+    #
+    #   Add a run of rising TimeStamps to the merge groups.  A run that starts
+    #   before the end of the last group is merged with it.
+    #
+    def _AddStreamRun(self, Groups, Start, End, MinTimeStamp, MaxTimeStamp):
+        if Start >= End:
+            return
+
+        Group = [MinTimeStamp, MaxTimeStamp, [[Start, End, MinTimeStamp]]]
+        while len(Groups) > 0 and Groups[-1][1] > Group[0]:
+            Previous = Groups.pop()
+            Group = [min(Previous[0], Group[0]), max(Previous[1], Group[1]), Previous[2] + Group[2]]
+
+        Groups.append(Group)
+
+    #
+    #   Walk the entry headers from Start to End, and add the segments to
+    #   Segments.  Returns the offset the walk stopped at.
+    #
+    def _ScanStreamRegion(self, Log, Start, End, Segments):
+        Groups = None
+        RunStart = Start
+        RunMin = None
+        RunMax = None
+        Offset = Start
+        while Offset < End:
+            if Log[Offset:Offset + 4] == b'ALMK':
+                (_, ChunkSize, UsedSize, _) = self.CHUNK_HEADER.unpack_from(Log, Offset)
+                UsedSize &= ~self.CHUNK_CLOSED
+                if ChunkSize < self.CHUNK_HEADER_SIZE or UsedSize > ChunkSize or Offset + ChunkSize > End:
+                    print("Log chunk has invalid size at offset 0x%X" % Offset)
+                    break
+
+                if Groups is None:
+                    if Offset > Start:
+                        Segments.append([[Start, Offset, 0]])
+                    Groups = []
+                else:
+                    self._AddStreamRun(Groups, RunStart, Offset, RunMin, RunMax)
+
+                # Split the entries of the chunk into runs of rising TimeStamps
+                ChunkEnd = Offset + UsedSize
+                EntryOffset = Offset + self.CHUNK_HEADER_SIZE
+                RunStart = EntryOffset
+                RunMin = None
+                while EntryOffset < ChunkEnd:
+                    Entry = self._ReadStreamEntry(Log, EntryOffset, ChunkEnd)
+                    if Entry is None:
+                        # The entry was reserved, but was still being written
+                        break
+
+                    if RunMin is not None and Entry[0] < RunMax:
+                        self._AddStreamRun(Groups, RunStart, EntryOffset, RunMin, RunMax)
+                        RunStart = EntryOffset
+                        RunMin = None
+
+                    if RunMin is None:
+                        RunMin = Entry[0]
+                    RunMax = Entry[0]
+                    EntryOffset = Entry[6]
+
+                self._AddStreamRun(Groups, RunStart, EntryOffset, RunMin, RunMax)
+                Offset += ChunkSize
+                RunStart = Offset
+                RunMin = None
+                continue
+
+            Entry = self._ReadStreamEntry(Log, Offset, End)
+            if Entry is None:
+                break
+
+            if Groups is not None:
+                if RunMin is not None and Entry[0] < RunMax:
+                    self._AddStreamRun(Groups, RunStart, Offset, RunMin, RunMax)
+                    RunStart = Offset
+                    RunMin = None
+
+                if RunMin is None:
+                    RunMin = Entry[0]
+                RunMax = Entry[0]
+
+            Offset = Entry[6]
+
+        if Groups is None:
+            if Offset > Start:
+                Segments.append([[Start, Offset, 0]])
+        else:
+            self._AddStreamRun(Groups, RunStart, Offset, RunMin, RunMax)
+            Segments.extend(Group[2] for Group in Groups)
+
+        return Offset
+
+    #
+    #   Find the entries left at the end of the log buffer when the log
+    #   wrapped at runtime.  These are the first whole entries after
+    #   LogCurrent that are older than the first entry of the log buffer.
+    #
+    def _FindWrappedTail(self, Log, LogStart, LogCurrent, LogEnd):
+        Head = self._ReadStreamEntry(Log, LogStart, LogCurrent)
+        if Head is None:
+            return None
+
+        Offset = (LogCurrent + 7) & ~7
+        while Offset < LogEnd:
+            Offset = Log.find(b'ALM', Offset, LogEnd)
+            if Offset == -1:
+                return None
+
+            if (Offset & 7) == 0:
+                Entry = self._ReadStreamEntry(Log, Offset, LogEnd)
+                if Entry is not None and Entry[0] <= Head[0]:
+                    return Offset
+
+            Offset += 1
+
+        return None
+
+    #
+    #   Split the log into segments
+    #
+    def _ScanStreamSegments(self, Log, LoggerInfo):
+        Segments = []
+        LogStart = LoggerInfo.get("LogBufferOffset", LoggerInfo["LogBuffer"])
+        LogCurrent = min(LoggerInfo["LogCurrent"], len(Log))
+        LogEnd = min(LogStart + LoggerInfo["LogBufferSize"], len(Log))
+
+        if LoggerInfo.get("AtRuntime", 0) != 0:
+            Tail = self._FindWrappedTail(Log, LogStart, LogCurrent, LogEnd)
+            if Tail is not None:
+                self._ScanStreamRegion(Log, Tail, LogEnd, Segments)
+
+        Offset = self._ScanStreamRegion(Log, LogStart, LogCurrent, Segments)
+        if Offset < LogCurrent:
+            print("Message Block has wrong signature at offset 0x%X" % Offset)
+
+        return Segments
+
+    #
+    #   Return the message blocks of the segments, starting at a checkpoint.
+    #   The runs of a segment are merged by TimeStamp, and a run is only read
+    #   once the merge reaches its first TimeStamp, so few runs are open at
+    #   once.  With each block, the state of the merge is returned as the
+    #   number of runs opened, and the [Run, Offset] of the next block of
+    #   each open run.
+    #
+    def _StreamSegmentBlocks(self, Log, Segments, FirstSegment, Opened, Cursors):
+        for SegmentIndex in range(FirstSegment, len(Segments)):
+            Runs = Segments[SegmentIndex]
+            Order = sorted(range(len(Runs)), key=lambda Run: (Runs[Run][2], Run))
+            if SegmentIndex != FirstSegment:
+                Opened = 0
+                Cursors = []
+
+            Heap = []
+            for (Run, Offset) in Cursors:
+                Blocks = self._StreamBlocks(Log, Offset, Runs[Run][1])
+                Block = next(Blocks, None)
+                if Block is not None:
+                    Heap.append((Block[0], Run, Block, Blocks))
+            heapq.heapify(Heap)
+
+            while True:
+                # Open the runs that start before the next block
+                while Opened < len(Order) and \
+                      (len(Heap) == 0 or (Runs[Order[Opened]][2], Order[Opened]) <= (Heap[0][0], Heap[0][1])):
+                    Run = Order[Opened]
+                    Opened += 1
+                    Blocks = self._StreamBlocks(Log, Runs[Run][0], Runs[Run][1])
+                    Block = next(Blocks, None)
+                    if Block is not None:
+                        heapq.heappush(Heap, (Block[0], Run, Block, Blocks))
+
+                if len(Heap) == 0:
+                    break
+
+                (_, Run, Block, Blocks) = Heap[0]
+                yield (SegmentIndex, Block, lambda: [Opened, [[Run, Block[4]]] + [[Item[1], Item[2][4]] for Item in Heap[1:]]])
+
+                Next = next(Blocks, None)
+                if Next is None:
+                    heapq.heappop(Heap)
+                else:
+                    heapq.heapreplace(Heap, (Next[0], Run, Next, Blocks))
+
+    #
+    #   Return the lines of the log as (LineNumber, TimeStamp, Phase,
+    #   DebugLevel, Message).  Lines are broken up the same way as
+    #   _GetNextFormattedLine does.  When Index is not None, checkpoints and
+    #   phase boundaries are added to it.
+    #
+    #   A checkpoint is [LineNumber, Segment, Opened, Cursors, TimeStamp,
+    #   newest TimeStamp before the checkpoint, oldest TimeStamp from the
+    #   checkpoint to the next checkpoint, Phase].
+    #
+    def _StreamLines(self, Log, Segments, Checkpoint, Index):
+        (LineNumber, FirstSegment, Opened, Cursors, _, RunningMax, _, LastPhase) = Checkpoint
+        MaxLength = self.MAX_MESSAGE_SIZE - 2
+        Message = ""
+        TimeStamp = 0
+        Phase = 0
+        DebugLevel = 0
+        IntervalMin = None
+        LastCheckpointLine = LineNumber
+        LastSegment = None
+        for (SegmentIndex, Block, State) in self._StreamSegmentBlocks(Log, Segments, FirstSegment, Opened, Cursors):
+            (TimeStamp, Phase, DebugLevel, Text, _) = Block
+            SegmentStart = SegmentIndex != LastSegment
+            LastSegment = SegmentIndex
+
+            if Index is not None and Message == "" and \
+               (SegmentStart or LineNumber - LastCheckpointLine >= self.INDEX_LINE_INTERVAL):
+                Checkpoints = Index["Checkpoints"]
+                if len(Checkpoints) > 0:
+                    Checkpoints[-1][6] = IntervalMin
+                (Opened, Cursors) = State()
+                Checkpoints.append([LineNumber, SegmentIndex, Opened, Cursors, TimeStamp, RunningMax, None, Phase])
+                LastCheckpointLine = LineNumber
+                IntervalMin = None
+
+            if IntervalMin is None or TimeStamp < IntervalMin:
+                IntervalMin = TimeStamp
+            if RunningMax is None or TimeStamp > RunningMax:
+                RunningMax = TimeStamp
+
+            while Text != "":
+                Piece = Text[:MaxLength]
+                LineBreak = Piece.find('\n')
+                if LineBreak != -1:
+                    Message += Piece[:LineBreak + 1]
+                    Text = Text[LineBreak + 1:]
+                elif len(Piece) == MaxLength:
+                    Message += Piece + '\n'
+                    Text = Text[MaxLength:]
+                else:
+                    Message += Piece
+                    break
+
+                if Index is not None and Phase != LastPhase:
+                    Index["Phases"].append([LineNumber, Phase, TimeStamp])
+
+                yield (LineNumber, TimeStamp, Phase, DebugLevel, Message)
+                LastPhase = Phase
+                LineNumber += 1
+                Message = ""
+
+        if Message != "":
+            if Index is not None and Phase != LastPhase:
+                Index["Phases"].append([LineNumber, Phase, TimeStamp])
+
+            yield (LineNumber, TimeStamp, Phase, DebugLevel, Message)
+            LineNumber += 1
+
+        if Index is not None:
+            if len(Index["Checkpoints"]) > 0:
+                Index["Checkpoints"][-1][6] = IntervalMin
+            Index["Lines"] = LineNumber
+
+    #
+    #   Return the key that ties a sidecar index to the log it was built from
+    #
+    def _GetStreamIndexKey(self, Log, LoggerInfo):
+        LogStart = LoggerInfo.get("LogBufferOffset", LoggerInfo["LogBuffer"])
+        return [len(Log), hashlib.sha256(Log[:LogStart]).hexdigest()]
+
+    #
+    #   Read the sidecar index of a log.  Returns None when there is no index,
+    #   or when it was built from a different log.
+    #
+    def _ReadStreamIndex(self, IndexPath, Key):
+        if IndexPath is None or not os.path.isfile(IndexPath):
+            return None
+
+        try:
+            with open(IndexPath, "r") as IndexFile:
+                Index = json.load(IndexFile)
+        except (OSError, ValueError):
+            return None
+
+        if Index.get("Version") != self.INDEX_VERSION or Index.get("Key") != Key:
+            return None
+
+        return Index
+
+    #
+    #   Find the checkpoint to start decoding at.  Decoding can start at a
+    #   checkpoint when every line before it is before StartLine, or older
+    #   than StartTicks.
+    #
+    def _FindStreamCheckpoint(self, Index, StartLine, StartTicks):
+        Checkpoint = self.FIRST_CHECKPOINT
+        for Candidate in Index["Checkpoints"]:
+            if Candidate[0] > StartLine and \
+               (StartTicks is None or Candidate[5] is None or Candidate[5] >= StartTicks):
+                break
+
+            Checkpoint = Candidate
+
+        return Checkpoint
+
+    #
+    #   Find the line to stop decoding at.  Decoding can stop at a checkpoint
+    #   when every line from it on is newer than EndTicks.
+    #
+    def _FindStreamEndLine(self, Index, EndTicks):
+        EndLine = None
+        SuffixMin = None
+        for Candidate in reversed(Index["Checkpoints"]):
+            if Candidate[6] is not None and (SuffixMin is None or Candidate[6] < SuffixMin):
+                SuffixMin = Candidate[6]
+
+            if SuffixMin is None or SuffixMin <= EndTicks:
+                break
+
+            EndLine = Candidate[0]
+
+        return EndLine
+
+
     # ----------------------------------------------------------------------- #
     #
     # External Interfaces
@@ -983,6 +1670,113 @@ class AdvLogParser ():
 
         return lines
 
+    # ----------------------------------------------------------------------- #
+    #
+    # ProcessMessagesStream - Decode the message buffer into OutFile without
+    #                         building the lines in memory.
+    #
+    #   StartTime and EndTime are in seconds, as printed in the log.  Lines
+    #   from StartLine and within the time range are written.  When StartPhase
+    #   is set, lines are written from the first line of that phase.  When
+    #   IndexPath is set, the sidecar index is used to seek to the first line,
+    #   and is written when the whole log is decoded and there is no index.
+    #
+    #   Returns the number of lines written.
+    #
+    # ----------------------------------------------------------------------- #
+    def ProcessMessagesStream(self, InFile, OutFile, StartLine=0, StartTime=None, EndTime=None,
+                              StartPhase=None, IndexPath=None):
+        LoggerInfo = self._InitializeLoggerInfo(InFile, StartLine)
+        Log = mmap.mmap(InFile.fileno(), 0, access=mmap.ACCESS_READ)
+
+        try:
+            Year = LoggerInfo["Year"]
+            Month = LoggerInfo["Month"]
+            Day = LoggerInfo["Day"]
+            Hour = LoggerInfo["Hour"]
+            Minute = LoggerInfo["Minute"]
+            Second = LoggerInfo["Second"]
+            OutFile.write(f"Log from {Month:2}/{Day:02}/{Year:04} at {Hour:2}:{Minute:02}:{Second:02}\n\n")
+
+            DiscardedSize = LoggerInfo["DiscardedSize"]
+            if (DiscardedSize != 0):
+                OutFile.write(f"The memory space was short by {DiscardedSize} bytes. Some PEI messages are not in the in memory log.\n\n")
+
+            Frequency = LoggerInfo["Frequency"]
+            BaseTime = LoggerInfo["BaseTime"]
+            StartTicks = None
+            EndTicks = None
+            if StartTime is not None:
+                StartTicks = self._GetTimeInTicks(int(StartTime * 1000000000), Frequency) - BaseTime
+            if EndTime is not None:
+                EndTicks = self._GetTimeInTicks(int(EndTime * 1000000000), Frequency) - BaseTime
+
+            Key = self._GetStreamIndexKey(Log, LoggerInfo)
+            Index = self._ReadStreamIndex(IndexPath, Key)
+            NewIndex = None
+            if Index is None:
+                Segments = self._ScanStreamSegments(Log, LoggerInfo)
+                if IndexPath is not None:
+                    NewIndex = {"Version": self.INDEX_VERSION, "Key": Key, "Segments": Segments,
+                                "Checkpoints": [], "Phases": [], "Lines": 0}
+            else:
+                Segments = Index["Segments"]
+
+            if StartPhase is not None:
+                if Index is None:
+                    raise Exception("A sidecar index is needed to start at a phase")
+
+                PhaseLines = [Line for (Line, Phase, _) in Index["Phases"] if Phase == StartPhase]
+                if len(PhaseLines) == 0:
+                    print(f"No lines logged in phase {StartPhase}")
+                    return 0
+
+                StartLine = max(StartLine, PhaseLines[0])
+
+            Checkpoint = self.FIRST_CHECKPOINT
+            EndLine = None
+            if Index is not None:
+                Checkpoint = self._FindStreamCheckpoint(Index, StartLine, StartTicks)
+                if EndTicks is not None:
+                    EndLine = self._FindStreamEndLine(Index, EndTicks)
+
+            PhaseStrings = [self._GetPhaseString(Phase) for Phase in range(self.ADVANCED_LOGGER_PHASE_CNT)]
+            DebugLevelStrings = {}
+            Lines = []
+            Count = 1 if DiscardedSize == 0 else 2
+            for (LineNumber, TimeStamp, Phase, DebugLevel, Message) in self._StreamLines(Log, Segments, Checkpoint, NewIndex):
+                if EndLine is not None and LineNumber >= EndLine:
+                    break
+
+                if LineNumber < StartLine or \
+                   (StartTicks is not None and TimeStamp < StartTicks) or \
+                   (EndTicks is not None and TimeStamp > EndTicks):
+                    continue
+
+                PhaseString = PhaseStrings[Phase] if Phase < self.ADVANCED_LOGGER_PHASE_CNT else self._GetPhaseString(Phase)
+                DebugLevelString = DebugLevelStrings.get(DebugLevel)
+                if DebugLevelString is None:
+                    DebugLevelString = self._GetDebugLevelString(DebugLevel)
+                    DebugLevelStrings[DebugLevel] = DebugLevelString
+
+                Lines.append(self._GetTimeStamp(TimeStamp, Frequency, BaseTime) + PhaseString + DebugLevelString + Message.rstrip("\r\n") + '\n')
+                if len(Lines) >= self.STREAM_WRITE_LINES:
+                    OutFile.writelines(Lines)
+                    Count += len(Lines)
+                    Lines = []
+
+            OutFile.writelines(Lines)
+            Count += len(Lines)
+
+            if NewIndex is not None and StartLine == 0 and EndTicks is None and StartTicks is None:
+                with open(IndexPath, "w") as IndexFile:
+                    json.dump(NewIndex, IndexFile)
+
+        finally:
+            Log.close()
+
+        return Count
+
 
 # ------------------------------------------------- ------------------------- #
 #
@@ -1017,6 +1811,26 @@ def ReadLogFromUefiInterface():
     return InFile
 
 
+# --------------------------------------------------------------------------- #
+#
+#   Read the format strings of deferred messages.  Each line of the table is
+#   the address of a format string, a tab, and the format string with C escapes.
+#
+# --------------------------------------------------------------------------- #
+def ReadFormatTable(FormatTablePath):
+    FormatTable = {}
+    with open(FormatTablePath, "r") as TableFile:
+        for Line in TableFile:
+            Line = Line.rstrip("\r\n")
+            if Line == "" or Line.startswith("#"):
+                continue
+
+            (Address, Format) = Line.split("\t", 1)
+            FormatTable[int(Address, 16)] = codecs.decode(Format, 'unicode_escape')
+
+    return FormatTable
+
+
 # --------------------------------------------------------------------------- #
 #
 #   Main processing for DecodeUefiLog
@@ -1036,9 +1850,32 @@ def main():
                         help="Path to binary Output LogFile")
     parser.add_argument("-s",  "--StartLine", dest="StartLine", default=0, type=int,
                         help="Print starting at StartLine")
+    parser.add_argument("-f",  "--FormatTable", dest="FormatTablePath", default=None,
+                        help="""Path to a table of format strings for deferred messages.  Each line is the
+                              address of a format string from the build map file, a tab, and the format
+                              string with C escapes""")
+    parser.add_argument("-m",  "--Stream", dest="Stream", action="store_true", default=False,
+                        help="""Decode the log in place and write each line as it is decoded, for large logs.
+                              When the log is read from a file, a sidecar index is kept next to it""")
+    parser.add_argument("-i",  "--Index", dest="IndexPath", default=None,
+                        help="Path to the sidecar index of the streaming decoder. Default is LogFile.idx")
+    parser.add_argument("--StartTime", dest="StartTime", default=None, type=float,
+                        help="Streaming decoder: print lines logged at or after StartTime, in seconds")
+    parser.add_argument("--EndTime", dest="EndTime", default=None, type=float,
+                        help="Streaming decoder: print lines logged at or before EndTime, in seconds")
+    parser.add_argument("--StartPhase", dest="StartPhase", default=None,
+                        help="Streaming decoder: print starting at the first line of a phase, such as DXE")
 
     options = parser.parse_args()
 
+    StartPhase = None
+    if options.StartPhase is not None:
+        PhaseName = "[" + options.StartPhase.strip("[]").upper() + "]"
+        if PhaseName in AdvLogParser.PHASE_STRING_LIST:
+            StartPhase = AdvLogParser.PHASE_STRING_LIST.index(PhaseName)
+        else:
+            StartPhase = int(options.StartPhase, 0)
+
     # if we don't have a log file, read it in from memory
     if options.LogFilePath is None:
         InFile = ReadLogFromUefiInterface()
@@ -1047,17 +1884,33 @@ def main():
     else:
         InFile = open(options.LogFilePath, "rb")
 
-    advlog = AdvLogParser()
+    FormatTable = {}
+    if options.FormatTablePath is not None:
+        FormatTable = ReadFormatTable(options.FormatTablePath)
+
+    advlog = AdvLogParser(FormatTable)
 
     try:
-        lines = advlog.ProcessMessages(InFile, options.StartLine)
-
-        if options.OutFilePath is not None:
-            OutFile = open(options.OutFilePath, "w", newline=None)
-            OutFile.writelines(lines)
-            OutFile.close()
-            CountOfLines = len(lines)
-            print(f"{CountOfLines} lines written to {options.OutFilePath}")
+        if options.Stream:
+            if options.OutFilePath is not None:
+                IndexPath = options.IndexPath
+                if IndexPath is None and options.LogFilePath is not None:
+                    IndexPath = options.LogFilePath + ".idx"
+
+                OutFile = open(options.OutFilePath, "w", newline=None)
+                CountOfLines = advlog.ProcessMessagesStream(InFile, OutFile, options.StartLine, options.StartTime,
+                                                            options.EndTime, StartPhase, IndexPath)
+                OutFile.close()
+                print(f"{CountOfLines} lines written to {options.OutFilePath}")
+        else:
+            lines = advlog.ProcessMessages(InFile, options.StartLine)
+
+            if options.OutFilePath is not None:
+                OutFile = open(options.OutFilePath, "w", newline=None)
+                OutFile.writelines(lines)
+                OutFile.close()
+                CountOfLines = len(lines)
+                print(f"{CountOfLines} lines written to {options.OutFilePath}")
 
     except Exception:
         print("Error processing log output.")
@@ -0,0 +1,209 @@
+# @file
+#
+# Benchmark the DecodeUefiLog decoders on a synthetic Advanced Logger log
+#
+# Copyright (c), Microsoft Corporation
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+
+import argparse
+import filecmp
+import os
+import random
+import struct
+import tempfile
+import time
+
+from DecodeUefiLog import AdvLogParser
+
+try:
+    import resource
+except ImportError:
+    resource = None
+
+
+# --------------------------------------------------------------------------- #
+#
+#   Synthetic log layout.  The logger info block is version 5, and the
+#   messages are 'ALM2' entries.  From a quarter of the log on, part of the
+#   entries are logged into closed sharded log chunks, as several processors
+#   would.
+#
+# --------------------------------------------------------------------------- #
+LOGGER_INFO = struct.Struct("=4sHH4xI4xIIIBBBBB3xQQHBBBBBxIHBx8x")
+MESSAGE_ENTRY_V2 = struct.Struct("=4sBBIQHHH")
+CHUNK_HEADER = struct.Struct("=4sIII")
+LOGGER_INFO_SIZE = 80
+CHUNK_SIZE = 0x2000
+FREQUENCY = 1000000000
+
+MESSAGES = [
+    "Loading driver at 0x%08X EntryPoint=0x%08X\n",
+    "InstallProtocolInterface: %08X-0000-0000-0000-000000000000 %X\n",
+    "Memory allocation of 0x%X bytes ",
+    "completed at 0x%X\n",
+    "Variable %X size %X\nVariable read done, status %X\n",
+]
+
+PHASES = [AdvLogParser.ADVANCED_LOGGER_PHASE_SEC,
+          AdvLogParser.ADVANCED_LOGGER_PHASE_PEI,
+          AdvLogParser.ADVANCED_LOGGER_PHASE_DXE,
+          AdvLogParser.ADVANCED_LOGGER_PHASE_RUNTIME]
+
+
+def WriteEntry(Log, Offset, TimeStamp, Phase, Text):
+    Data = Text.encode('utf-8')
+    MESSAGE_ENTRY_V2.pack_into(Log, Offset, b'ALM2', 2, 0, 0x40, TimeStamp, Phase, len(Data), MESSAGE_ENTRY_V2.size)
+    Log[Offset + MESSAGE_ENTRY_V2.size:Offset + MESSAGE_ENTRY_V2.size + len(Data)] = Data
+    return Offset + ((MESSAGE_ENTRY_V2.size + len(Data) + 7) & ~7)
+
+
+def MakeText(Random):
+    Format = MESSAGES[Random.randrange(len(MESSAGES))]
+    return Format % tuple(Random.randrange(0x100000000) for _ in range(Format.count('%')))
+
+
+# --------------------------------------------------------------------------- #
+#
+#   Build a synthetic log of Size bytes.  When Wrap is set, the log is
+#   written around the buffer one and a half times, as a runtime log that
+#   wrapped.  Returns the log and the last TimeStamp.
+#
+# --------------------------------------------------------------------------- #
+def BuildLog(Size, Wrap, Seed=1):
+    Random = random.Random(Seed)
+    Log = bytearray(Size)
+    LogEnd = Size - 1024
+    Offset = LOGGER_INFO_SIZE
+    TimeStamp = 1000
+    Index = 0
+
+    while Offset < LogEnd:
+        Phase = PHASES[min(len(PHASES) - 1, (Offset * len(PHASES)) // LogEnd)]
+        if not Wrap and Offset > LogEnd // 4 and Index % 16 == 0 and Offset + CHUNK_SIZE < LogEnd:
+            # A chunk of one processor, with entries interleaved in time with the next entries
+            ChunkStart = Offset
+            Entry = Offset + CHUNK_HEADER.size
+            ChunkTime = TimeStamp
+            while True:
+                Text = MakeText(Random)
+                if Entry + MESSAGE_ENTRY_V2.size + len(Text) + 8 > ChunkStart + CHUNK_SIZE:
+                    break
+
+                ChunkTime += Random.randrange(1, 200)
+                Entry = WriteEntry(Log, Entry, ChunkTime, Phase, Text)
+
+            CHUNK_HEADER.pack_into(Log, ChunkStart, b'ALMK', CHUNK_SIZE, (Entry - ChunkStart) | AdvLogParser.CHUNK_CLOSED, Index % 8)
+            Offset = ChunkStart + CHUNK_SIZE
+        else:
+            TimeStamp += Random.randrange(1, 100)
+            Offset = WriteEntry(Log, Offset, TimeStamp, Phase, MakeText(Random))
+
+        Index += 1
+
+    LogCurrent = Offset
+    AtRuntime = 0
+    if Wrap:
+        # Write the start of the log again, as the runtime log does when it wraps
+        AtRuntime = 1
+        Offset = LOGGER_INFO_SIZE
+        while Offset < LogEnd // 2:
+            TimeStamp += Random.randrange(1, 100)
+            Offset = WriteEntry(Log, Offset, TimeStamp, AdvLogParser.ADVANCED_LOGGER_PHASE_RUNTIME, MakeText(Random))
+
+        LogCurrent = Offset
+
+    LOGGER_INFO.pack_into(Log, 0, b'ALOG', 5, 0, LOGGER_INFO_SIZE, LogCurrent, 0, Size - LOGGER_INFO_SIZE,
+                          1, AtRuntime, 0, 1, 0, FREQUENCY, 1, 2024, 1, 1, 0, 0, 0, 0, 0, 0)
+    return (Log, TimeStamp)
+
+
+def Measure(Name, LogSize, Function):
+    Start = time.perf_counter()
+    Result = Function()
+    Seconds = time.perf_counter() - Start
+    print(f"{Name:40} {Seconds:8.2f} s {LogSize / Seconds / (1024 * 1024):8.1f} MB/s")
+    return Result
+
+
+def StreamDecode(LogPath, OutPath, **Arguments):
+    with open(LogPath, "rb") as InFile, open(OutPath, "w") as OutFile:
+        return AdvLogParser().ProcessMessagesStream(InFile, OutFile, **Arguments)
+
+
+def LegacyDecode(LogPath, OutPath):
+    with open(LogPath, "rb") as InFile:
+        Lines = AdvLogParser().ProcessMessages(InFile, 0)
+
+    with open(OutPath, "w") as OutFile:
+        OutFile.writelines(Lines)
+
+    return len(Lines)
+
+
+# --------------------------------------------------------------------------- #
+#
+#   Main processing for DecodeUefiLogBenchmark
+#
+# --------------------------------------------------------------------------- #
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark DecodeUefiLog on a synthetic log")
+    parser.add_argument("-s", "--Size", dest="Size", default=64, type=int,
+                        help="Size of the synthetic log in MB")
+    parser.add_argument("-w", "--Wrap", dest="Wrap", action="store_true", default=False,
+                        help="Make a runtime log that wrapped")
+    parser.add_argument("-c", "--Compare", dest="Compare", action="store_true", default=False,
+                        help="""Also decode with ProcessMessages, and check that both decoders write the same
+                              lines.  This takes minutes for large logs""")
+    options = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as Directory:
+        LogPath = os.path.join(Directory, "Log.bin")
+        StreamPath = os.path.join(Directory, "Stream.txt")
+        IndexPath = LogPath + ".idx"
+        LogSize = options.Size * 1024 * 1024
+
+        with open(LogPath, "wb") as LogFile:
+            (Log, LastTimeStamp) = BuildLog(LogSize, options.Wrap)
+            LogFile.write(Log)
+            del Log
+
+        Lines = Measure("Streaming decode", LogSize,
+                        lambda: StreamDecode(LogPath, StreamPath))
+        Measure("Streaming decode, building the index", LogSize,
+                lambda: StreamDecode(LogPath, StreamPath, IndexPath=IndexPath))
+        Measure("Streaming decode with the index", LogSize,
+                lambda: StreamDecode(LogPath, StreamPath, IndexPath=IndexPath))
+
+        Start = time.perf_counter()
+        StreamDecode(LogPath, os.path.join(Directory, "Last.txt"), StartLine=Lines * 9 // 10, IndexPath=IndexPath)
+        print(f"{'Last tenth of the lines with the index':40} {time.perf_counter() - Start:8.2f} s")
+
+        Start = time.perf_counter()
+        Middle = LastTimeStamp / FREQUENCY / 2
+        StreamDecode(LogPath, os.path.join(Directory, "Range.txt"), StartTime=Middle,
+                     EndTime=Middle + LastTimeStamp / FREQUENCY / 100, IndexPath=IndexPath)
+        print(f"{'Hundredth of the time with the index':40} {time.perf_counter() - Start:8.2f} s")
+
+        if options.Compare:
+            LegacyPath = os.path.join(Directory, "Legacy.txt")
+            Measure("ProcessMessages", LogSize, lambda: LegacyDecode(LogPath, LegacyPath))
+            if options.Wrap:
+                print("ProcessMessages does not decode the end of a wrapped version 5 log, lines are not compared")
+            elif filecmp.cmp(StreamPath, LegacyPath, shallow=False):
+                print("Both decoders wrote the same lines")
+            else:
+                print("ERROR: The decoders wrote different lines")
+                raise SystemExit(1)
+
+        if resource is not None:
+            print(f"Peak memory {resource.getrusage(resource.RUSAGE_SELF).ru_maxrss // 1024} MB")
+
+
+# --------------------------------------------------------------------------- #
+#
+#   Entry point
+#
+# --------------------------------------------------------------------------- #
+if __name__ == '__main__':
+
+    main()
@@ -88,22 +88,95 @@ typedef struct {
   CHAR8     MessageText[];                        // Message Text
 } ADVANCED_LOGGER_MESSAGE_ENTRY_V2;
 
+//
+// When PcdAdvancedLoggerDeferredFormat is TRUE, a message is logged as the address of its
+// format string and its arguments, and is formatted when the log is read.  The header
+// matches ADVANCED_LOGGER_MESSAGE_ENTRY_V2, with DataLen and DataOffset in place of
+// MessageLen and MessageOffset.
+//
+// FormatLen is the size of the format string, including the NULL terminator, and FormatHash
+// is the CRC32 of those FormatLen bytes.  Readers only use a format string that is outside
+// of the log, is still terminated at FormatLen, and still has the logged FormatHash.  Only
+// the DXE core logs deferred messages, so FormatAddress stays mapped and loaded while the
+// log is read in firmware.
+//
+// Data holds one UINT64 for each argument consumed by the format string, in order, followed
+// by copies of the strings, GUIDs and times the arguments point to.  For %a, %s, %S, %g and
+// %t arguments, the UINT64 is the offset of the copy from the end of the arguments, or
+// DEFERRED_ARG_NULL if the argument was NULL.  Each copy is 8 byte aligned.
+//
+typedef struct {
+  UINT32    Signature;                            // Signature
+  UINT8     MajorVersion;                         // Major version of advanced logger message structure
+  UINT8     MinorVersion;                         // Minor version of advanced logger message structure
+  UINT32    DebugLevel;                           // Debug Level
+  UINT64    TimeStamp;                            // Time stamp
+  UINT16    Phase;                                // Boot phase that produced this message entry
+  UINT16    DataLen;                              // Number of bytes in Data
+  UINT16    DataOffset;                           // Offset of Data from start of structure
+  UINT16    FormatLen;                            // Number of bytes in the format string
+  UINT64    FormatAddress;                        // Address of the format string of the message
+  UINT32    FormatHash;                           // CRC32 of the format string
+  UINT8     Data[];                               // Arguments of the message
+} ADVANCED_LOGGER_MESSAGE_ENTRY_V3;
+
+#define DEFERRED_ARG_NULL  MAX_UINT64
+
+//
+// Largest Data of a deferred message.  Messages with more argument data are formatted
+// when they are logged.
+//
+#define ADVANCED_LOGGER_DEFERRED_DATA_SIZE  256
+
+//
+// Largest format string of a deferred message, including the NULL terminator.
+//
+#define ADVANCED_LOGGER_DEFERRED_FORMAT_SIZE  256
+
 #define MESSAGE_ENTRY_SIZE(LenOfMessage)                 (ALIGN_VALUE(sizeof(ADVANCED_LOGGER_MESSAGE_ENTRY) + LenOfMessage, 8))
 #define MESSAGE_ENTRY_SIZE_V2(LenOfEntry, LenOfMessage)  (ALIGN_VALUE(LenOfEntry + LenOfMessage, 8))
 
 #define NEXT_LOG_ENTRY(LogEntry)       ((ADVANCED_LOGGER_MESSAGE_ENTRY *)((UINTN)LogEntry + MESSAGE_ENTRY_SIZE(LogEntry->MessageLen)))
 #define NEXT_LOG_ENTRY_V2(LogEntryV2)  ((ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)((UINTN)LogEntryV2 + MESSAGE_ENTRY_SIZE_V2(LogEntryV2->MessageOffset, LogEntryV2->MessageLen)))
+#define NEXT_LOG_ENTRY_V3(LogEntryV3)  ((ADVANCED_LOGGER_MESSAGE_ENTRY_V3 *)((UINTN)LogEntryV3 + MESSAGE_ENTRY_SIZE_V2(LogEntryV3->DataOffset, LogEntryV3->DataLen)))
 
 #define MESSAGE_ENTRY_SIGNATURE     SIGNATURE_32('A','L','M','S')
 #define MESSAGE_ENTRY_SIGNATURE_V2  SIGNATURE_32('A','L','M','2')
+#define MESSAGE_ENTRY_SIGNATURE_V3  SIGNATURE_32('A','L','M','3')
 
 #define MESSAGE_ENTRY_FROM_MSG(a)             BASE_CR (a, ADVANCED_LOGGER_MESSAGE_ENTRY, MessageText)
 #define MESSAGE_ENTRY_FROM_MSG_V2(a, offset)  ((UINTN)a - offset)
 
+//
+// When PcdAdvancedLoggerShardSize is not 0, a processor reserves a whole chunk of the log
+// with a single update of LogCurrentOffset, and then fills the chunk with V2 message entries
+// by updating the UsedSize of the chunk.  Chunks appear in the log as a single entry, and the
+// message entries within a chunk follow the chunk header.  Readers merge the entries of the
+// open chunks by TimeStamp.
+//
+typedef volatile struct {
+  UINT32    Signature;                            // Signature 'ALMK'
+  UINT32    ChunkSize;                            // Size of the chunk, including this header
+  UINT32    UsedSize;                             // Bytes of the chunk reserved, including this header.
+                                                  // CHUNK_CLOSED is set when no more entries will be added.
+  UINT32    ProcessorIndex;                       // Processor that reserved the chunk
+} ADVANCED_LOGGER_CHUNK_HEADER;
+
+#define CHUNK_HEADER_SIGNATURE  SIGNATURE_32('A','L','M','K')
+#define CHUNK_CLOSED            BIT31
+#define CHUNK_USED_SIZE(Chunk)  ((Chunk)->UsedSize & ~CHUNK_CLOSED)
+
+//
+// Number of chunks a writer keeps open at a time. Processors are assigned to a shard
+// by ProcessorIndex % ADVANCED_LOGGER_MAX_SHARDS.
+//
+#define ADVANCED_LOGGER_MAX_SHARDS  16
+
 //
 //  Insure the size of is a multiple of 8 bytes
 //
 STATIC_ASSERT (sizeof (ADVANCED_LOGGER_INFO) % 8 == 0, "Logger Info Misaligned");
+STATIC_ASSERT (sizeof (ADVANCED_LOGGER_CHUNK_HEADER) % 8 == 0, "Chunk Header Misaligned");
 
 #pragma pack (pop)
 
@@ -19,6 +19,18 @@ MAX MESSAGE size.
 
 #define ADVANCED_LOGGER_MAX_MESSAGE_SIZE  512
 
+//
+// Number of sharded log chunks a reader can merge at one time.  When more chunks are open,
+// the oldest open chunk is dropped from the merge.
+//
+#define ADVANCED_LOGGER_ACCESS_MAX_CHUNKS  16
+
+//
+// Size of the buffer a deferred message is formatted into.  This matches the message
+// buffer of the DebugLib that logged it.
+//
+#define ADVANCED_LOGGER_DEFERRED_MESSAGE_SIZE  256
+
 //
 // NOTE:
 //
@@ -31,6 +43,9 @@ MAX MESSAGE size.
 // the returned Message pointer points to raw text in the reserved memory space. MessageLen
 // is the number of valid characters.  There is no NULL guaranteed to be present.
 //
+// For deferred messages, the BLOCK_ENTRY Message points to the message formatted in the
+// DeferredMessage field, and is only valid until the next call.
+//
 // For LINE_ENTRY, the returned Message pointer is a one time allocated buffer.  The built
 // line will be NULL terminated.
 //
@@ -49,6 +64,17 @@ typedef struct {
   UINT16         Phase;                     // Boot phase that produced this message entry
   UINT64         TimeStamp;                 // Time stamp
   UINT16         MessageOffset;             // Offset of Message in the physical memory buffer
+
+  // DebugLevelMask is IN.  When it is not 0, entries without one of its DEBUG levels are
+  // skipped using only their header, so they are never formatted or copied.
+  UINT32         DebugLevelMask;            // 0 (all), DEBUG levels to return
+
+  // The following are private members used to walk the log, including the entries of
+  // sharded log chunks.  They are initialized when Message is NULL.
+  UINT32         NextOffset;                                    // (Private) Next entry outside of a chunk
+  UINT32         ChunkOffset[ADVANCED_LOGGER_ACCESS_MAX_CHUNKS]; // (Private) Open chunks, 0 if unused
+  UINT32         ChunkCursor[ADVANCED_LOGGER_ACCESS_MAX_CHUNKS]; // (Private) Next entry in each open chunk
+  CHAR8          DeferredMessage[ADVANCED_LOGGER_DEFERRED_MESSAGE_SIZE]; // (Private) Formatted deferred message
 } ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY;
 
 typedef struct {
@@ -72,6 +98,33 @@ typedef struct {
   ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY    BlockEntry;
 } ADVANCED_LOGGER_ACCESS_MESSAGE_LINE_ENTRY;
 
+//
+// Number of spans AdvancedLoggerAccessLibGetNextRawSpans can return at one time.  The
+// first span is the end of the log buffer when the log has wrapped.
+//
+#define ADVANCED_LOGGER_ACCESS_MAX_RAW_SPANS  2
+
+typedef struct {
+  CONST UINT8    *Data;                     // Start of the raw entries in the memory log
+  UINTN          DataLen;                   // Number of bytes in the span
+} ADVANCED_LOGGER_ACCESS_RAW_SPAN;
+
+//
+// The RAW_BLOCK_ENTRY returns the log entries as they are stored in the memory log,
+// without copying or formatting them.  Each span holds whole entries, including the
+// sharded log chunks that are closed, and is only valid until the log wraps over it.
+//
+typedef struct {
+  UINTN                              SpanCount;                                  // Number of valid spans
+  ADVANCED_LOGGER_ACCESS_RAW_SPAN    Span[ADVANCED_LOGGER_ACCESS_MAX_RAW_SPANS]; // Spans, oldest first
+
+  // The following are private members used to walk the log.
+  UINT32                             NextOffset;                                 // (Private) Next entry to return, 0 to start
+  UINT64                             LastTimeStamp;                              // (Private) Time stamp of the last entry returned
+  UINT32                             TailOffset;                                 // (Private) Next entry before the wrap, 0 if none
+  UINT64                             TailTimeStamp;                              // (Private) Time stamp of the last entry before the wrap
+} ADVANCED_LOGGER_ACCESS_RAW_BLOCK_ENTRY;
+
 /**
   Get Next Message Block.
 
@@ -125,6 +178,39 @@ AdvancedLoggerAccessLibGetNextFormattedLine (
   IN  ADVANCED_LOGGER_ACCESS_MESSAGE_LINE_ENTRY  *LineEntry
   );
 
+/**
+  Get Next Raw Spans.
+
+  Get the log entries written since the last call as spans of the in memory buffer.  The
+  entries are not copied or formatted, so a consumer that forwards the log can write each
+  span at once.
+
+  When the RawEntry structure is zeroed, the spans start at the beginning of the log.  An
+  entry that is still being written, and a sharded log chunk that is still open, end the
+  spans and are returned by a later call.  When this happens at the end of the log buffer
+  after the log wraps, the rest of those entries are returned by a later call, after
+  entries from the start of the log buffer were returned, until they are written over.
+
+  NOTE:  When the log wraps more than once between calls, the entries that were written
+         over are not detected.
+
+  @param  RawEntry               Information about the current spans.
+
+  @retval EFI_SUCCESS            RawEntry->Span holds RawEntry->SpanCount spans of whole log
+                                 entries.  The spans must be treated as CONSTANT.
+          EFI_NOT_STARTED        Error occurred during constructor
+          EFI_INVALID_PARAMETER  A Bad RawEntry pointer provided
+          EFI_COMPROMISED_DATA   The log holds an invalid entry or sharded log chunk.
+          EFI_END_OF_FILE        No more entries in the memory buffer.  The private fields are
+                                 still valid to check for more entries.
+
+**/
+EFI_STATUS
+EFIAPI
+AdvancedLoggerAccessLibGetNextRawSpans (
+  IN OUT ADVANCED_LOGGER_ACCESS_RAW_BLOCK_ENTRY  *RawEntry
+  );
+
 /**
   AdvancedLoggerAccessLibReset.
 
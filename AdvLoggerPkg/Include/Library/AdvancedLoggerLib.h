@@ -32,4 +32,49 @@ AdvancedLoggerWrite (
   IN       UINTN  NumberOfBytes
   );
 
+/**
+  Check if a message can be written to the in memory logging buffer without formatting it.
+
+  This only depends on the instance, the boot phase and the Hdw port routing of the debug
+  level, so callers can check it before they parse the arguments of the message.
+
+  @param  ErrorLevel       Error level passed into DebugLib
+
+  @retval TRUE             AdvancedLoggerWriteDeferred may log a message of this level.
+  @retval FALSE            The message must be formatted and written with AdvancedLoggerWrite.
+
+**/
+BOOLEAN
+EFIAPI
+AdvancedLoggerDeferredEnabled (
+  IN       UINTN  ErrorLevel
+  );
+
+/**
+  Write a message to the in memory logging buffer without formatting it.
+
+  The message is logged as the address of its format string and its arguments, and is
+  formatted when the log is read.  Only instances whose format strings stay readable by
+  the log readers support this, and only for messages that are not routed to the Hdw
+  port.  Otherwise, the caller must format the message and call AdvancedLoggerWrite.
+
+  @param  ErrorLevel       Error level passed into DebugLib
+  @param  Format           Format string of the message.
+  @param  Data             Arguments of the message, as described for
+                           ADVANCED_LOGGER_MESSAGE_ENTRY_V3.
+  @param  DataLen          Number of bytes in Data.
+
+  @retval EFI_SUCCESS      The message was logged, or discarded because the log is full.
+  @retval EFI_UNSUPPORTED  The message must be formatted and written with AdvancedLoggerWrite.
+
+**/
+EFI_STATUS
+EFIAPI
+AdvancedLoggerWriteDeferred (
+  IN       UINTN  ErrorLevel,
+  IN CONST CHAR8  *Format,
+  IN CONST UINT8  *Data,
+  IN       UINTN  DataLen
+  );
+
 #endif // __ADVANCED_LOGGER_LIB_H__
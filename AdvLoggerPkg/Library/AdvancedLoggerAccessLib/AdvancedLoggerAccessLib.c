@@ -216,6 +216,415 @@ FormatDebugLevelPrefix (
   return 0;
 }
 
+/**
+  Format a deferred message.
+
+  The arguments of the message are read back from the entry, as described for
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V3, and the message is formatted with its format string.
+
+  @param  Entry                  The deferred message entry.
+  @param  MessageBuffer          Buffer for the formatted message.
+  @param  MessageBufferSize      Size of MessageBuffer.
+
+  @retval Number of characters in MessageBuffer, not including the NULL terminator.
+**/
+STATIC
+UINT16
+FormatDeferredMessage (
+  IN  ADVANCED_LOGGER_MESSAGE_ENTRY_V3  *Entry,
+  OUT CHAR8                             *MessageBuffer,
+  IN  UINTN                             MessageBufferSize
+  )
+{
+  UINT64       BaseListBuffer[ADVANCED_LOGGER_DEFERRED_DATA_SIZE / sizeof (UINT64)];
+  CHAR8        ArgType[ADVANCED_LOGGER_DEFERRED_DATA_SIZE / sizeof (UINT64)];
+  BASE_LIST    BaseListMarker;
+  CONST CHAR8  *Format;
+  UINT8        *Copies;
+  UINTN        CopiesLen;
+  UINTN        ArgCount;
+  UINTN        Index;
+  BOOLEAN      LongType;
+  UINT64       Arg;
+
+  //
+  // The format string must be in memory outside of the log, and must still be the string
+  // that was logged.  A damaged entry, or a format string that was replaced, is not used,
+  // so the arguments are never formatted with specifiers they were not logged for.
+  //
+  if ((Entry->FormatAddress == 0) ||
+      (Entry->FormatLen == 0) ||
+      (Entry->FormatLen > ADVANCED_LOGGER_DEFERRED_FORMAT_SIZE) ||
+      (Entry->FormatAddress > MAX_ADDRESS - Entry->FormatLen) ||
+      ((Entry->FormatAddress + Entry->FormatLen > PA_FROM_PTR (mLoggerInfo)) && (Entry->FormatAddress < mHighAddress)))
+  {
+    return (UINT16)AsciiSPrint (MessageBuffer, MessageBufferSize, "Deferred message has an invalid format address %lx\n", Entry->FormatAddress);
+  }
+
+  Format = (CONST CHAR8 *)(UINTN)Entry->FormatAddress;
+  if ((AsciiStrnSizeS (Format, Entry->FormatLen) != Entry->FormatLen) ||
+      (CalculateCrc32 ((VOID *)Format, Entry->FormatLen) != Entry->FormatHash))
+  {
+    return (UINT16)AsciiSPrint (MessageBuffer, MessageBufferSize, "Deferred message format at %p has changed\n", Format);
+  }
+
+  //
+  // Find the type of each argument consumed by the format string.  This follows the
+  // format parsing of DebugLib when the message was logged.
+  //
+  ArgCount = 0;
+  for (Index = 0; Format[Index] != '\0'; Index++) {
+    if (Format[Index] != '%') {
+      continue;
+    }
+
+    LongType = FALSE;
+    for (Index++; Format[Index] != '\0'; Index++) {
+      if ((Format[Index] == '*') && (ArgCount < ARRAY_SIZE (ArgType))) {
+        ArgType[ArgCount++] = '*';
+      } else if ((Format[Index] == 'L') || (Format[Index] == 'l')) {
+        LongType = TRUE;
+      } else if ((Format[Index] != '.') && (Format[Index] != '-') && (Format[Index] != '+') &&
+                 (Format[Index] != ' ') && (Format[Index] != ',') &&
+                 ((Format[Index] < '0') || (Format[Index] > '9')))
+      {
+        break;
+      }
+    }
+
+    if (Format[Index] == '\0') {
+      break;
+    }
+
+    if ((Format[Index] == '%') || (Format[Index] == '\n') || (Format[Index] == '\r')) {
+      continue;
+    }
+
+    if (ArgCount == ARRAY_SIZE (ArgType)) {
+      break;
+    }
+
+    if (((Format[Index] == 'X') || (Format[Index] == 'x') || (Format[Index] == 'd') || (Format[Index] == 'u')) && LongType) {
+      ArgType[ArgCount++] = 'L';
+    } else {
+      ArgType[ArgCount++] = Format[Index];
+    }
+  }
+
+  if (ArgCount * sizeof (UINT64) > Entry->DataLen) {
+    return (UINT16)AsciiSPrint (MessageBuffer, MessageBufferSize, "Deferred message has too few arguments for format %p\n", Format);
+  }
+
+  Copies    = Entry->Data + ArgCount * sizeof (UINT64);
+  CopiesLen = Entry->DataLen - ArgCount * sizeof (UINT64);
+
+  //
+  // Build the BASE_LIST with the sizes of this reader.
+  //
+  BaseListMarker = (BASE_LIST)BaseListBuffer;
+  for (Index = 0; Index < ArgCount; Index++) {
+    Arg = ReadUnaligned64 ((UINT64 *)(Entry->Data + Index * sizeof (UINT64)));
+    switch (ArgType[Index]) {
+      case 'L':
+        BASE_ARG (BaseListMarker, INT64) = (INT64)Arg;
+        break;
+
+      case 'X':
+      case 'x':
+      case 'd':
+      case 'u':
+        BASE_ARG (BaseListMarker, int) = (int)(UINT32)Arg;
+        break;
+
+      case 'p':
+        BASE_ARG (BaseListMarker, VOID *) = (VOID *)(UINTN)Arg;
+        break;
+
+      case 'r':
+        if ((Arg & BIT63) != 0) {
+          BASE_ARG (BaseListMarker, RETURN_STATUS) = (RETURN_STATUS)(Arg & ~BIT63) | MAX_BIT;
+        } else {
+          BASE_ARG (BaseListMarker, RETURN_STATUS) = (RETURN_STATUS)Arg;
+        }
+
+        break;
+
+      case 'a':
+      case 's':
+      case 'S':
+      case 'g':
+      case 't':
+        if (Arg == DEFERRED_ARG_NULL) {
+          BASE_ARG (BaseListMarker, VOID *) = NULL;
+          break;
+        }
+
+        //
+        // The copy must be within the entry, and strings must be terminated.
+        //
+        if ((Arg >= CopiesLen) ||
+            ((ArgType[Index] == 'a') && (AsciiStrnLenS ((CHAR8 *)(Copies + Arg), CopiesLen - (UINTN)Arg) == CopiesLen - (UINTN)Arg)) ||
+            (((ArgType[Index] == 's') || (ArgType[Index] == 'S')) && (StrnLenS ((CHAR16 *)(Copies + Arg), (CopiesLen - (UINTN)Arg) / sizeof (CHAR16)) == (CopiesLen - (UINTN)Arg) / sizeof (CHAR16))) ||
+            ((ArgType[Index] == 'g') && (CopiesLen - Arg < sizeof (GUID))) ||
+            ((ArgType[Index] == 't') && (CopiesLen - Arg < sizeof (EFI_TIME))))
+        {
+          return (UINT16)AsciiSPrint (MessageBuffer, MessageBufferSize, "Deferred message has an invalid argument for format %p\n", Format);
+        }
+
+        BASE_ARG (BaseListMarker, VOID *) = Copies + Arg;
+        break;
+
+      default:
+        BASE_ARG (BaseListMarker, UINTN) = (UINTN)Arg;
+        break;
+    }
+  }
+
+  return (UINT16)AsciiBSPrint (MessageBuffer, MessageBufferSize, Format, (BASE_LIST)BaseListBuffer);
+}
+
+/**
+  Get the log entry at an offset from the logger info block.
+
+  @param  Offset                 Offset of the entry from the logger info block.
+
+  @retval Pointer to the log entry, or NULL if the offset is not a valid entry address.
+**/
+STATIC
+ADVANCED_LOGGER_MESSAGE_ENTRY *
+GetLogEntry (
+  IN UINT32  Offset
+  )
+{
+  ADVANCED_LOGGER_MESSAGE_ENTRY  *LogEntry;
+
+  LogEntry = (ADVANCED_LOGGER_MESSAGE_ENTRY *)((UINT8 *)mLoggerInfo + Offset);
+
+  // Validate that LogEntry points within the proper Memory Log region
+  // in memory log buffer
+  if ((LogEntry != (ADVANCED_LOGGER_MESSAGE_ENTRY *)ALIGN_POINTER (LogEntry, 8)) || // Insure pointer is on boundary
+      (PA_FROM_PTR (LogEntry) < mLowAddress) ||                                     // and within the log region
+      (PA_FROM_PTR (LogEntry) > mHighAddress))
+  {
+    DEBUG ((DEBUG_ERROR, "Invalid Address for LogEntry %p. Low=%p, High=%p\n", LogEntry, mLowAddress, mHighAddress));
+    return NULL;
+  }
+
+  return LogEntry;
+}
+
+/**
+  Get the next entry of an open sharded log chunk.
+
+  A chunk that is closed and has no more entries is removed from the open chunks.
+
+  @param  BlockEntry             Information about the current message block.
+  @param  Index                  Index of the open chunk.
+
+  @retval Pointer to the next entry of the chunk, or NULL if the chunk has no entry ready.
+**/
+STATIC
+ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *
+PeekChunkEntry (
+  IN  ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY  *BlockEntry,
+  IN  UINTN                                       Index
+  )
+{
+  ADVANCED_LOGGER_CHUNK_HEADER      *Chunk;
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V2  *ChunkEntry;
+
+  if (BlockEntry->ChunkOffset[Index] == 0) {
+    return NULL;
+  }
+
+  Chunk = (ADVANCED_LOGGER_CHUNK_HEADER *)((UINT8 *)mLoggerInfo + BlockEntry->ChunkOffset[Index]);
+  if (BlockEntry->ChunkCursor[Index] >= BlockEntry->ChunkOffset[Index] + CHUNK_USED_SIZE (Chunk)) {
+    if ((Chunk->UsedSize & CHUNK_CLOSED) != 0) {
+      // Every entry of this chunk has been returned.
+      BlockEntry->ChunkOffset[Index] = 0;
+    }
+
+    return NULL;
+  }
+
+  ChunkEntry = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)GetLogEntry (BlockEntry->ChunkCursor[Index]);
+  if ((ChunkEntry == NULL) ||
+      ((ChunkEntry->Signature != MESSAGE_ENTRY_SIGNATURE_V2) && (ChunkEntry->Signature != MESSAGE_ENTRY_SIGNATURE_V3)))
+  {
+    // The entry is reserved, but it is still being written.
+    return NULL;
+  }
+
+  return ChunkEntry;
+}
+
+/**
+  Get the next log entry, and move the cursors past it.
+
+  Entries of sharded log chunks are merged by TimeStamp with the rest of the log.  A chunk is
+  opened when the oldest entry it holds is the next entry to return, so only the chunks that
+  were being filled at the same time are open at once.
+
+  @param  BlockEntry             Information about the current message block.
+  @param  Entry                  Returns a version 1 entry, or an entry with the version 2 header.
+
+  @retval EFI_SUCCESS            Entry points to the next entry.
+          EFI_INVALID_PARAMETER  An entry is outside of the log.
+          EFI_COMPROMISED_DATA   The log holds an invalid entry or sharded log chunk.
+          EFI_END_OF_FILE        No more messages in the memory buffer.
+**/
+STATIC
+EFI_STATUS
+GetNextLogEntry (
+  IN  ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY  *BlockEntry,
+  OUT ADVANCED_LOGGER_MESSAGE_ENTRY               **Entry
+  )
+{
+  ADVANCED_LOGGER_MESSAGE_ENTRY     *LogEntry;
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V2  *LogEntryV2;
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V2  *ChunkEntry;
+  ADVANCED_LOGGER_CHUNK_HEADER      *Chunk;
+  UINT64                            TimeStamp;
+  UINTN                             Index;
+  UINTN                             Slot;
+  UINTN                             Selected;
+
+  //
+  // Find the oldest entry ready in the open chunks.
+  //
+  LogEntryV2 = NULL;
+  Selected   = ADVANCED_LOGGER_ACCESS_MAX_CHUNKS;
+  for (Index = 0; Index < ADVANCED_LOGGER_ACCESS_MAX_CHUNKS; Index++) {
+    ChunkEntry = PeekChunkEntry (BlockEntry, Index);
+    if ((ChunkEntry != NULL) && ((LogEntryV2 == NULL) || (ChunkEntry->TimeStamp < LogEntryV2->TimeStamp))) {
+      LogEntryV2 = ChunkEntry;
+      Selected   = Index;
+    }
+  }
+
+  //
+  // Open the chunks at the top level cursor that hold an older entry.
+  //
+  while (BlockEntry->NextOffset < mLoggerInfo->LogCurrentOffset) {
+    Chunk = (ADVANCED_LOGGER_CHUNK_HEADER *)GetLogEntry (BlockEntry->NextOffset);
+    if (Chunk == NULL) {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    if (Chunk->Signature != CHUNK_HEADER_SIGNATURE) {
+      break;
+    }
+
+    if ((Chunk->ChunkSize < sizeof (ADVANCED_LOGGER_CHUNK_HEADER)) ||
+        (CHUNK_USED_SIZE (Chunk) > Chunk->ChunkSize))
+    {
+      DEBUG ((DEBUG_ERROR, "Invalid log chunk at %p, Size=%x, Used=%x\n", Chunk, Chunk->ChunkSize, Chunk->UsedSize));
+      return EFI_COMPROMISED_DATA;
+    }
+
+    if (CHUNK_USED_SIZE (Chunk) == sizeof (ADVANCED_LOGGER_CHUNK_HEADER)) {
+      if ((Chunk->UsedSize & CHUNK_CLOSED) == 0) {
+        break;
+      }
+
+      // Closed without entries, skip it.
+      BlockEntry->NextOffset += Chunk->ChunkSize;
+      continue;
+    }
+
+    ChunkEntry = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)GetLogEntry (BlockEntry->NextOffset + sizeof (ADVANCED_LOGGER_CHUNK_HEADER));
+    if ((ChunkEntry == NULL) ||
+        ((ChunkEntry->Signature != MESSAGE_ENTRY_SIGNATURE_V2) && (ChunkEntry->Signature != MESSAGE_ENTRY_SIGNATURE_V3)) ||
+        ((LogEntryV2 != NULL) && (ChunkEntry->TimeStamp > LogEntryV2->TimeStamp)))
+    {
+      break;
+    }
+
+    for (Slot = 0; Slot < ADVANCED_LOGGER_ACCESS_MAX_CHUNKS; Slot++) {
+      if (BlockEntry->ChunkOffset[Slot] == 0) {
+        break;
+      }
+    }
+
+    if (Slot == ADVANCED_LOGGER_ACCESS_MAX_CHUNKS) {
+      if (LogEntryV2 != NULL) {
+        break;
+      }
+
+      //
+      // Every open chunk is waiting on its writer.  Drop the oldest one so the rest of the
+      // log can be read.
+      //
+      Slot = 0;
+      for (Index = 1; Index < ADVANCED_LOGGER_ACCESS_MAX_CHUNKS; Index++) {
+        if (BlockEntry->ChunkOffset[Index] < BlockEntry->ChunkOffset[Slot]) {
+          Slot = Index;
+        }
+      }
+
+      DEBUG ((DEBUG_WARN, "%a: Too many open log chunks, skipping rest of chunk at %x\n", __FUNCTION__, BlockEntry->ChunkOffset[Slot]));
+    }
+
+    BlockEntry->ChunkOffset[Slot] = BlockEntry->NextOffset;
+    BlockEntry->ChunkCursor[Slot] = BlockEntry->NextOffset + sizeof (ADVANCED_LOGGER_CHUNK_HEADER);
+    BlockEntry->NextOffset       += Chunk->ChunkSize;
+    LogEntryV2                    = ChunkEntry;
+    Selected                      = Slot;
+  }
+
+  //
+  // The entry at the top level cursor is returned if it is older than the chunk entry.
+  //
+  LogEntry = NULL;
+  if (BlockEntry->NextOffset < mLoggerInfo->LogCurrentOffset) {
+    LogEntry = GetLogEntry (BlockEntry->NextOffset);
+    if (LogEntry == NULL) {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE) {
+      TimeStamp = LogEntry->TimeStamp;
+    } else if ((LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE_V2) || (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE_V3)) {
+      TimeStamp = ((ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)LogEntry)->TimeStamp;
+    } else if (LogEntry->Signature == CHUNK_HEADER_SIGNATURE) {
+      // This chunk is opened once it holds the oldest entry.
+      LogEntry = NULL;
+    } else {
+      DEBUG ((DEBUG_ERROR, "Next LogEntry invalid signature at %p, Last=%p\n", LogEntry, BlockEntry->Message));
+      DUMP_HEX (DEBUG_INFO, 0, (CHAR8 *)LogEntry - 128, 256, "");
+      return EFI_COMPROMISED_DATA;
+    }
+
+    if ((LogEntry != NULL) && (LogEntryV2 != NULL) && (TimeStamp > LogEntryV2->TimeStamp)) {
+      LogEntry = NULL;
+    }
+  }
+
+  if (LogEntry != NULL) {
+    if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE) {
+      BlockEntry->NextOffset = (UINT32)((UINTN)NEXT_LOG_ENTRY (LogEntry) - (UINTN)mLoggerInfo);
+      *Entry                 = LogEntry;
+      return EFI_SUCCESS;
+    }
+
+    LogEntryV2 = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)LogEntry;
+    Selected   = ADVANCED_LOGGER_ACCESS_MAX_CHUNKS;
+  }
+
+  if (LogEntryV2 == NULL) {
+    return EFI_END_OF_FILE;
+  }
+
+  if (Selected == ADVANCED_LOGGER_ACCESS_MAX_CHUNKS) {
+    BlockEntry->NextOffset = (UINT32)((UINTN)NEXT_LOG_ENTRY_V2 (LogEntryV2) - (UINTN)mLoggerInfo);
+  } else {
+    BlockEntry->ChunkCursor[Selected] = (UINT32)((UINTN)NEXT_LOG_ENTRY_V2 (LogEntryV2) - (UINTN)mLoggerInfo);
+  }
+
+  *Entry = (ADVANCED_LOGGER_MESSAGE_ENTRY *)LogEntryV2;
+  return EFI_SUCCESS;
+}
+
 /**
   Get Next Message Block.
 
@@ -225,6 +634,9 @@ FormatDebugLevelPrefix (
   not expected during normal use, to start reading from the beginning of the log again, set the
   Context field NULL.  That memory pointed to by Context may be freed with FreePool.
 
+  Entries of sharded log chunks are merged by TimeStamp with the rest of the log.  When
+  DebugLevelMask is not 0, entries without one of its DEBUG levels are skipped.
+
   NOTE:  The message pointed to by CurrentMessage->Message is NOT NULL terminated.
 
   @param  CurrentMessage         Information about the current message.
@@ -243,8 +655,10 @@ AdvancedLoggerAccessLibGetNextMessageBlock (
   IN  ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY  *BlockEntry
   )
 {
-  ADVANCED_LOGGER_MESSAGE_ENTRY     *LogEntry   = NULL;
-  ADVANCED_LOGGER_MESSAGE_ENTRY_V2  *LogEntryV2 = NULL;
+  ADVANCED_LOGGER_MESSAGE_ENTRY     *LogEntry;
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V2  *LogEntryV2;
+  EFI_STATUS                        Status;
+  UINT32                            DebugLevel;
 
   if (mLoggerInfo == NULL) {
     return EFI_NOT_STARTED;
@@ -259,73 +673,51 @@ AdvancedLoggerAccessLibGetNextMessageBlock (
   }
 
   if (BlockEntry->Message == NULL) {
-    LogEntry = (ADVANCED_LOGGER_MESSAGE_ENTRY *)LOG_BUFFER_FROM_ALI (mLoggerInfo);
-    if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE_V2) {
-      // This is actually a v2 entry.
-      LogEntryV2 = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)LogEntry;
-    }
-  } else {
-    LogEntry = (ADVANCED_LOGGER_MESSAGE_ENTRY *)MESSAGE_ENTRY_FROM_MSG (BlockEntry->Message);
-    if (LogEntry->Signature != MESSAGE_ENTRY_SIGNATURE) {
-      // If this is not a v1 entry, this might be a v2 entry.
-      LogEntryV2 = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)MESSAGE_ENTRY_FROM_MSG_V2 (BlockEntry->Message, BlockEntry->MessageOffset);
-      if (LogEntryV2->Signature != MESSAGE_ENTRY_SIGNATURE_V2) {
-        DEBUG ((DEBUG_ERROR, "Resume LogEntry invalid signature at %p or %p\n", LogEntry, LogEntryV2));
-        DUMP_HEX (DEBUG_INFO, 0, (CHAR8 *)LogEntry - 128, 256, "");
-        return EFI_INVALID_PARAMETER;
-      }
+    BlockEntry->NextOffset = mLoggerInfo->LogBufferOffset;
+    ZeroMem (BlockEntry->ChunkOffset, sizeof (BlockEntry->ChunkOffset));
+    ZeroMem (BlockEntry->ChunkCursor, sizeof (BlockEntry->ChunkCursor));
+  }
+
+  do {
+    Status = GetNextLogEntry (BlockEntry, &LogEntry);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
 
-    if (LogEntryV2) {
-      LogEntryV2 = NEXT_LOG_ENTRY_V2 (LogEntryV2);
+    if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE) {
+      DebugLevel          = LogEntry->DebugLevel;
+      BlockEntry->Message = LogEntry->MessageText;
     } else {
-      LogEntry = NEXT_LOG_ENTRY (LogEntry);
+      DebugLevel          = ((ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)LogEntry)->DebugLevel;
+      BlockEntry->Message = ((ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)LogEntry)->MessageText;
     }
-  }
-
-  // At this point, if LogEntryV2 is not NULL, it points to the next entry to be read.
-  // Otherwise LogEntry will contain the next entry. So we simplify the logic by only
-  // using LogEntry and overwriting it to use the LogEntryV2 data as necessary. However,
-  // note that regardless of how we inherit the pointer it has the possibility of
-  // pointing to a different version of structure than the one we just looked at. So
-  // we need to validate the structure before we can use it.
-  if (LogEntryV2 != NULL) {
-    LogEntry = (ADVANCED_LOGGER_MESSAGE_ENTRY *)LogEntryV2;
-  }
-
-  // Validate that LogEntry points within the proper Memory Log region
-  // in memory log buffer
-  if ((LogEntry != (ADVANCED_LOGGER_MESSAGE_ENTRY *)ALIGN_POINTER (LogEntry, 8)) || // Insure pointer is on boundary
-      (PA_FROM_PTR (LogEntry) < mLowAddress) ||                                     // and within the log region
-      (PA_FROM_PTR (LogEntry) > mHighAddress))
-  {
-    DEBUG ((DEBUG_ERROR, "Invalid Address for LogEntry %p. Low=%p, High=%p\n", LogEntry, mLowAddress, mHighAddress));
-    return EFI_INVALID_PARAMETER;
-  }
 
-  if (LogEntry >= (ADVANCED_LOGGER_MESSAGE_ENTRY *)LOG_CURRENT_FROM_ALI (mLoggerInfo)) {
-    return EFI_END_OF_FILE;
-  }
+    // Message is set for skipped entries too, so the next call does not restart the walk.
+  } while ((BlockEntry->DebugLevelMask != 0) && ((DebugLevel & BlockEntry->DebugLevelMask) == 0));
 
   if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE) {
     BlockEntry->TimeStamp  = LogEntry->TimeStamp;
     BlockEntry->DebugLevel = LogEntry->DebugLevel;
-    BlockEntry->Message    = LogEntry->MessageText;
     BlockEntry->MessageLen = LogEntry->MessageLen;
     BlockEntry->Phase      = ADVANCED_LOGGER_PHASE_UNSPECIFIED;
-  } else if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE_V2) {
-    LogEntryV2                = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)LogEntry;
-    BlockEntry->TimeStamp     = LogEntryV2->TimeStamp;
-    BlockEntry->DebugLevel    = LogEntryV2->DebugLevel;
-    BlockEntry->Message       = LogEntryV2->MessageText;
-    BlockEntry->MessageLen    = LogEntryV2->MessageLen;
-    BlockEntry->MessageOffset = LogEntryV2->MessageOffset;
-    BlockEntry->Phase         = LogEntryV2->Phase;
+    return EFI_SUCCESS;
+  }
+
+  LogEntryV2                = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)LogEntry;
+  BlockEntry->TimeStamp     = LogEntryV2->TimeStamp;
+  BlockEntry->DebugLevel    = LogEntryV2->DebugLevel;
+  BlockEntry->MessageOffset = LogEntryV2->MessageOffset;
+  BlockEntry->Phase         = LogEntryV2->Phase;
+  if (LogEntryV2->Signature == MESSAGE_ENTRY_SIGNATURE_V3) {
+    // V3 entries share the V2 header, and are formatted into the block entry.
+    BlockEntry->MessageLen = FormatDeferredMessage (
+                               (ADVANCED_LOGGER_MESSAGE_ENTRY_V3 *)LogEntryV2,
+                               BlockEntry->DeferredMessage,
+                               sizeof (BlockEntry->DeferredMessage)
+                               );
+    BlockEntry->Message = BlockEntry->DeferredMessage;
   } else {
-    DEBUG ((DEBUG_ERROR, "Next LogEntry invalid signature at %p, Last=%p\n", LogEntry, BlockEntry->Message));
-    DUMP_HEX (DEBUG_INFO, 0, (CHAR8 *)BlockEntry->Message - 128, 256, "");
-    DUMP_HEX (DEBUG_INFO, 0, (CHAR8 *)LogEntry - 128, 256, "");
-    return EFI_COMPROMISED_DATA;
+    BlockEntry->MessageLen = LogEntryV2->MessageLen;
   }
 
   return EFI_SUCCESS;
@@ -493,6 +885,247 @@ AdvancedLoggerAccessLibGetNextFormattedLine (
   return Status;
 }
 
+/**
+  Find the end of the whole log entries from an offset.
+
+  Only the entry headers are read.  The walk stops at an entry that is still being written,
+  at a sharded log chunk that is still open, and, when StopAtOlder is set, at an entry older
+  than the last entry found.  Pending tells the first two cases apart from the others.
+
+  @param  Offset                 Offset of the first entry from the logger info block.
+  @param  EndOffset              Offset the entries must end at or before.
+  @param  StopAtOlder            Stop at an entry older than LastTimeStamp.
+  @param  LastTimeStamp          IN:  Time stamp of the entry before Offset.
+                                 OUT: Time stamp of the last entry found.
+  @param  SpanEnd                Offset of the end of the last entry found.
+  @param  Pending                TRUE when the walk stopped at an entry that is still being
+                                 written, or at a chunk that is still open.
+
+  @retval EFI_SUCCESS            SpanEnd is the end of the entries found.
+          EFI_INVALID_PARAMETER  An entry is outside of the log.
+          EFI_COMPROMISED_DATA   The log holds an invalid entry or sharded log chunk.
+**/
+STATIC
+EFI_STATUS
+FindRawSpanEnd (
+  IN     UINT32   Offset,
+  IN     UINT32   EndOffset,
+  IN     BOOLEAN  StopAtOlder,
+  IN OUT UINT64   *LastTimeStamp,
+  OUT    UINT32   *SpanEnd,
+  OUT    BOOLEAN  *Pending
+  )
+{
+  ADVANCED_LOGGER_MESSAGE_ENTRY     *LogEntry;
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V2  *LogEntryV2;
+  ADVANCED_LOGGER_CHUNK_HEADER      *Chunk;
+  UINT64                            TimeStamp;
+  UINT32                            EntrySize;
+  UINT32                            ChunkCursor;
+
+  *Pending = FALSE;
+  while (Offset < EndOffset) {
+    LogEntry = GetLogEntry (Offset);
+    if (LogEntry == NULL) {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    LogEntryV2 = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)LogEntry;
+    if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE) {
+      EntrySize = MESSAGE_ENTRY_SIZE (LogEntry->MessageLen);
+      TimeStamp = LogEntry->TimeStamp;
+    } else if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE_V2) {
+      EntrySize = MESSAGE_ENTRY_SIZE_V2 (LogEntryV2->MessageOffset, LogEntryV2->MessageLen);
+      TimeStamp = LogEntryV2->TimeStamp;
+    } else if (LogEntry->Signature == MESSAGE_ENTRY_SIGNATURE_V3) {
+      EntrySize = MESSAGE_ENTRY_SIZE_V2 (((ADVANCED_LOGGER_MESSAGE_ENTRY_V3 *)LogEntry)->DataOffset, ((ADVANCED_LOGGER_MESSAGE_ENTRY_V3 *)LogEntry)->DataLen);
+      TimeStamp = LogEntryV2->TimeStamp;
+    } else if (LogEntry->Signature == CHUNK_HEADER_SIGNATURE) {
+      Chunk = (ADVANCED_LOGGER_CHUNK_HEADER *)LogEntry;
+      if ((Chunk->ChunkSize < sizeof (ADVANCED_LOGGER_CHUNK_HEADER)) ||
+          (CHUNK_USED_SIZE (Chunk) > Chunk->ChunkSize))
+      {
+        DEBUG ((DEBUG_ERROR, "Invalid log chunk at %p, Size=%x, Used=%x\n", Chunk, Chunk->ChunkSize, Chunk->UsedSize));
+        return EFI_COMPROMISED_DATA;
+      }
+
+      if ((Chunk->UsedSize & CHUNK_CLOSED) == 0) {
+        *Pending = TRUE;
+        break;
+      }
+
+      //
+      // A closed chunk takes no more entries, but the entries reserved in it may still
+      // be being written.
+      //
+      for (ChunkCursor = sizeof (ADVANCED_LOGGER_CHUNK_HEADER); ChunkCursor < CHUNK_USED_SIZE (Chunk); ChunkCursor += EntrySize) {
+        LogEntryV2 = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)((UINT8 *)Chunk + ChunkCursor);
+        if ((LogEntryV2->Signature != MESSAGE_ENTRY_SIGNATURE_V2) && (LogEntryV2->Signature != MESSAGE_ENTRY_SIGNATURE_V3)) {
+          break;
+        }
+
+        // V3 entries share the V2 header.
+        EntrySize = MESSAGE_ENTRY_SIZE_V2 (LogEntryV2->MessageOffset, LogEntryV2->MessageLen);
+        if (EntrySize == 0) {
+          return EFI_COMPROMISED_DATA;
+        }
+      }
+
+      if (ChunkCursor < CHUNK_USED_SIZE (Chunk)) {
+        *Pending = TRUE;
+        break;
+      }
+
+      EntrySize = Chunk->ChunkSize;
+      TimeStamp = *LastTimeStamp;
+      if (CHUNK_USED_SIZE (Chunk) > sizeof (ADVANCED_LOGGER_CHUNK_HEADER)) {
+        // The first entry of the chunk is its oldest.
+        TimeStamp = ((ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)(Chunk + 1))->TimeStamp;
+      }
+    } else {
+      // The entry is reserved, but it is still being written.
+      *Pending = TRUE;
+      break;
+    }
+
+    if (EntrySize == 0) {
+      return EFI_COMPROMISED_DATA;
+    }
+
+    if ((EntrySize > EndOffset - Offset) || (StopAtOlder && (TimeStamp < *LastTimeStamp))) {
+      break;
+    }
+
+    if (TimeStamp > *LastTimeStamp) {
+      *LastTimeStamp = TimeStamp;
+    }
+
+    Offset += EntrySize;
+  }
+
+  *SpanEnd = Offset;
+  return EFI_SUCCESS;
+}
+
+/**
+  Get Next Raw Spans.
+
+  Get the log entries written since the last call as spans of the in memory buffer.  The
+  entries are not copied or formatted, so a consumer that forwards the log can write each
+  span at once.
+
+  When LogCurrentOffset is below the last offset returned, the log has wrapped.  The entries
+  at the end of the log buffer that are newer than the last entry returned are returned
+  in the first span, and the entries from the start of the log buffer in the second span.
+  When the end of the log buffer stops at an entry that is still being written, the tail
+  cursor is kept, and the rest of the tail is returned first by later calls.
+
+  @param  RawEntry               Information about the current spans.
+
+  @retval EFI_SUCCESS            RawEntry->Span holds RawEntry->SpanCount spans of whole log
+                                 entries.
+          EFI_NOT_STARTED        Error occurred during constructor
+          EFI_INVALID_PARAMETER  A Bad RawEntry pointer provided
+          EFI_COMPROMISED_DATA   The log holds an invalid entry or sharded log chunk.
+          EFI_END_OF_FILE        No more entries in the memory buffer.  The private fields are
+                                 still valid to check for more entries.
+
+**/
+EFI_STATUS
+EFIAPI
+AdvancedLoggerAccessLibGetNextRawSpans (
+  IN OUT ADVANCED_LOGGER_ACCESS_RAW_BLOCK_ENTRY  *RawEntry
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      CurrentOffset;
+  UINT32      SpanEnd;
+  BOOLEAN     Pending;
+
+  if (mLoggerInfo == NULL) {
+    return EFI_NOT_STARTED;
+  }
+
+  if (RawEntry == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (RawEntry->NextOffset == 0) {
+    RawEntry->NextOffset    = mLoggerInfo->LogBufferOffset;
+    RawEntry->LastTimeStamp = 0;
+    RawEntry->TailOffset    = 0;
+  }
+
+  RawEntry->SpanCount = 0;
+  CurrentOffset       = mLoggerInfo->LogCurrentOffset;
+  if (CurrentOffset > TOTAL_LOG_SIZE_WITH_ALI (mLoggerInfo)) {
+    CurrentOffset = TOTAL_LOG_SIZE_WITH_ALI (mLoggerInfo);
+  }
+
+  if (CurrentOffset < RawEntry->NextOffset) {
+    //
+    // The log has wrapped.  The entries from NextOffset to the end of the log buffer are
+    // the tail, and are returned before the entries from the start of the log buffer.
+    //
+    RawEntry->TailOffset    = RawEntry->NextOffset;
+    RawEntry->TailTimeStamp = RawEntry->LastTimeStamp;
+    RawEntry->NextOffset    = mLoggerInfo->LogBufferOffset;
+  }
+
+  if ((RawEntry->TailOffset != 0) && (CurrentOffset > RawEntry->TailOffset)) {
+    // The rest of the tail was written over.
+    RawEntry->TailOffset = 0;
+  }
+
+  if (RawEntry->TailOffset != 0) {
+    //
+    // Entries of the tail older than the last entry returned before the wrap were written
+    // before the previous wrap.
+    //
+    Status = FindRawSpanEnd (
+               RawEntry->TailOffset,
+               TOTAL_LOG_SIZE_WITH_ALI (mLoggerInfo),
+               TRUE,
+               &RawEntry->TailTimeStamp,
+               &SpanEnd,
+               &Pending
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    if (SpanEnd > RawEntry->TailOffset) {
+      RawEntry->Span[RawEntry->SpanCount].Data    = (UINT8 *)mLoggerInfo + RawEntry->TailOffset;
+      RawEntry->Span[RawEntry->SpanCount].DataLen = SpanEnd - RawEntry->TailOffset;
+      RawEntry->SpanCount++;
+    }
+
+    // Keep the tail cursor while an entry of the tail is still being written.
+    RawEntry->TailOffset = Pending ? SpanEnd : 0;
+  }
+
+  Status = FindRawSpanEnd (
+             RawEntry->NextOffset,
+             CurrentOffset,
+             FALSE,
+             &RawEntry->LastTimeStamp,
+             &SpanEnd,
+             &Pending
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (SpanEnd > RawEntry->NextOffset) {
+    RawEntry->Span[RawEntry->SpanCount].Data    = (UINT8 *)mLoggerInfo + RawEntry->NextOffset;
+    RawEntry->Span[RawEntry->SpanCount].DataLen = SpanEnd - RawEntry->NextOffset;
+    RawEntry->SpanCount++;
+    RawEntry->NextOffset = SpanEnd;
+  }
+
+  return (RawEntry->SpanCount == 0) ? EFI_END_OF_FILE : EFI_SUCCESS;
+}
+
 /**
   Advanced Logger Unit Test Initialize
 
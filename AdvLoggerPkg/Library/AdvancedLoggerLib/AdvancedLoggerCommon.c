@@ -12,6 +12,8 @@
 #include <AdvancedLoggerInternal.h>
 
 #include <Library/AdvancedLoggerHdwPortLib.h>
+#include <Library/AdvancedLoggerLib.h>
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/PcdLib.h>
 #include <Library/SynchronizationLib.h>
@@ -19,6 +21,243 @@
 
 #include "../AdvancedLoggerCommon.h"
 
+//
+// SEC and PEI may run in place from flash, where their globals cannot be written.  Sharding
+// keeps the open chunks in globals, so it is not built for them and PcdAdvancedLoggerShardSize
+// has no effect there.
+//
+#if !defined (ADVANCED_LOGGER_SEC) && !defined (ADVANCED_LOGGER_PEI)
+#define ADVANCED_LOGGER_SHARDS_SUPPORTED
+#endif
+
+//
+// Deferred messages keep the address of their format string until the log is read.  SEC and
+// PEI format strings may be in flash or temporary memory that is no longer mapped by then.
+//
+#if !defined (ADVANCED_LOGGER_SEC) && !defined (ADVANCED_LOGGER_PEI)
+#define ADVANCED_LOGGER_DEFERRED_SUPPORTED
+#endif
+
+#ifdef ADVANCED_LOGGER_SHARDS_SUPPORTED
+
+//
+// Chunk currently being filled by each shard, as an offset from mShardLoggerInfo.  0 means
+// the shard has no open chunk.
+//
+STATIC ADVANCED_LOGGER_INFO  *mShardLoggerInfo = NULL;
+STATIC volatile UINT32       mShardChunkOffset[ADVANCED_LOGGER_MAX_SHARDS];
+
+/**
+  Reserve space for a message entry from the chunk owned by this processor's shard.
+
+  When the chunk of the shard cannot hold the entry, the chunk is closed and a new chunk
+  is reserved from the log with a single update of LogCurrentOffset.
+
+  @param  LoggerInfo       The logger info block.
+  @param  EntrySize        Size of the message entry to reserve.
+
+  @retval Offset from LoggerInfo of the reserved entry, or 0 if the entry could not be
+          reserved from a chunk and the caller should reserve it from LogCurrentOffset.
+**/
+STATIC
+UINT32
+AdvancedLoggerShardReserve (
+  IN ADVANCED_LOGGER_INFO  *LoggerInfo,
+  IN UINTN                 EntrySize
+  )
+{
+  ADVANCED_LOGGER_CHUNK_HEADER  *Chunk;
+  UINT32                        ChunkSize;
+  UINT32                        ChunkOffset;
+  UINT32                        CurrentBuffer;
+  UINT32                        OldValue;
+  UINT32                        UsedSize;
+  UINTN                         ProcessorIndex;
+  UINTN                         Shard;
+
+  ChunkSize = ALIGN_VALUE (PcdGet32 (PcdAdvancedLoggerShardSize), 8);
+  if ((ChunkSize == 0) || (EntrySize > (ChunkSize - sizeof (ADVANCED_LOGGER_CHUNK_HEADER)))) {
+    return 0;
+  }
+
+  //
+  // A runtime wrap moves LogCurrentOffset back under open chunks, so chunks are not used
+  // once wrapping can happen.
+  //
+  if (FeaturePcdGet (PcdAdvancedLoggerAutoWrapEnable) && (LoggerInfo->AtRuntime)) {
+    return 0;
+  }
+
+  //
+  // The logger info block only moves during single threaded initialization, and any open
+  // chunks belong to the old buffer.
+  //
+  if (mShardLoggerInfo != LoggerInfo) {
+    ZeroMem ((VOID *)mShardChunkOffset, sizeof (mShardChunkOffset));
+    mShardLoggerInfo = LoggerInfo;
+  }
+
+  ProcessorIndex = AdvancedLoggerGetProcessorIndex ();
+  Shard          = ProcessorIndex % ADVANCED_LOGGER_MAX_SHARDS;
+
+  for ( ; ; ) {
+    ChunkOffset = mShardChunkOffset[Shard];
+    if (ChunkOffset != 0) {
+      Chunk = (ADVANCED_LOGGER_CHUNK_HEADER *)((UINT8 *)LoggerInfo + ChunkOffset);
+      do {
+        UsedSize = Chunk->UsedSize;
+        if ((UsedSize & CHUNK_CLOSED) != 0) {
+          break;
+        }
+
+        if ((Chunk->ChunkSize - UsedSize) < EntrySize) {
+          //
+          // Close the chunk.  Closing races with other processors of this shard that
+          // may still fit a smaller entry, so it is done with the same exchange.
+          //
+          InterlockedCompareExchange32 (&Chunk->UsedSize, UsedSize, UsedSize | CHUNK_CLOSED);
+          continue;
+        }
+
+        // EntrySize is less than the ChunkSize, this is safe to do
+        OldValue = InterlockedCompareExchange32 (&Chunk->UsedSize, UsedSize, UsedSize + (UINT32)EntrySize);
+        if (OldValue == UsedSize) {
+          return ChunkOffset + UsedSize;
+        }
+      } while (TRUE);
+    }
+
+    //
+    // Reserve a new chunk for this shard from the log.
+    //
+    do {
+      CurrentBuffer = LoggerInfo->LogCurrentOffset;
+      if ((USED_LOG_SIZE (LoggerInfo) >= LoggerInfo->LogBufferSize) ||
+          ((LoggerInfo->LogBufferSize - USED_LOG_SIZE (LoggerInfo)) < ChunkSize))
+      {
+        return 0;
+      }
+
+      OldValue = InterlockedCompareExchange32 (
+                   &LoggerInfo->LogCurrentOffset,
+                   CurrentBuffer,
+                   CurrentBuffer + ChunkSize
+                   );
+    } while (OldValue != CurrentBuffer);
+
+    Chunk                 = (ADVANCED_LOGGER_CHUNK_HEADER *)((UINT8 *)LoggerInfo + CurrentBuffer);
+    Chunk->ChunkSize      = ChunkSize;
+    Chunk->UsedSize       = sizeof (ADVANCED_LOGGER_CHUNK_HEADER);
+    Chunk->ProcessorIndex = (UINT32)ProcessorIndex;
+    Chunk->Signature      = CHUNK_HEADER_SIGNATURE;
+
+    OldValue = InterlockedCompareExchange32 (&mShardChunkOffset[Shard], ChunkOffset, CurrentBuffer);
+    if (OldValue != ChunkOffset) {
+      //
+      // Another processor of this shard installed a chunk first.  Close this one, it
+      // stays in the log as an empty chunk.
+      //
+      Chunk->UsedSize |= CHUNK_CLOSED;
+    }
+  }
+}
+
+#endif
+
+/**
+  Reserve space for a message entry in the in memory logging buffer.
+
+  When the log is full, the entry is counted in DiscardedSize.
+
+  @param  LoggerInfo       The logger info block.
+  @param  EntrySize        Size of the message entry to reserve.
+  @param  NumberOfBytes    Number of bytes of the message, added to DiscardedSize when
+                           the entry does not fit.
+
+  @retval Offset from LoggerInfo of the reserved entry, or 0 if the entry was discarded.
+**/
+STATIC
+UINT32
+AdvancedLoggerReserveEntry (
+  IN ADVANCED_LOGGER_INFO  *LoggerInfo,
+  IN UINTN                 EntrySize,
+  IN UINTN                 NumberOfBytes
+  )
+{
+  UINT32  CurrentBuffer;
+  UINT32  NewBuffer;
+  UINT32  OldValue;
+  UINT32  OldSize;
+  UINT32  NewSize;
+  UINT32  CurrentSize;
+  UINTN   UsedSize;
+
+ #ifdef ADVANCED_LOGGER_SHARDS_SUPPORTED
+  CurrentBuffer = AdvancedLoggerShardReserve (LoggerInfo, EntrySize);
+  if (CurrentBuffer != 0) {
+    return CurrentBuffer;
+  }
+
+ #endif
+
+  do {
+    CurrentBuffer = LoggerInfo->LogCurrentOffset;
+    UsedSize      = USED_LOG_SIZE (LoggerInfo);
+    if ((UsedSize >= LoggerInfo->LogBufferSize) ||
+        ((LoggerInfo->LogBufferSize - UsedSize) < EntrySize))
+    {
+      if (FeaturePcdGet (PcdAdvancedLoggerAutoWrapEnable) && (LoggerInfo->AtRuntime)) {
+        //
+        // Wrap around the current cursor when auto wrap is enabled on buffer full during runtime.
+        //
+        NewBuffer = LoggerInfo->LogBufferOffset;
+        OldValue  = InterlockedCompareExchange32 (
+                      &LoggerInfo->LogCurrentOffset,
+                      CurrentBuffer,
+                      NewBuffer
+                      );
+        if (OldValue != CurrentBuffer) {
+          //
+          // Another thread has updated the buffer, we should retry the logging.
+          //
+          continue;
+        }
+
+        // Now that we have a buffer that starts from the beginning, proceed to log the current message, from the beginning.
+        // Note that in this case, if there are other threads in the middle of logging a message, they will continue to write
+        // to the end of the buffer as it fits.
+        // If there is another clearing attempt on the other thread, i.e. another thread also try to fill up the buffer, the
+        // first clear will take effect and the other log entries will fail to update and proceed with a normal retry.
+      } else {
+        //
+        // Update the number of bytes of log that have not been captured
+        //
+        do {
+          CurrentSize = LoggerInfo->DiscardedSize;
+          NewSize     = CurrentSize + (UINT32)NumberOfBytes;
+          OldSize     = InterlockedCompareExchange32 (
+                          (UINT32 *)&LoggerInfo->DiscardedSize,
+                          (UINT32)CurrentSize,
+                          (UINT32)NewSize
+                          );
+        } while (OldSize != CurrentSize);
+
+        return 0;
+      }
+    }
+
+    // EntrySize is contained within a UINT32, this is safe to do
+    NewBuffer = (UINT32)(CurrentBuffer + EntrySize);
+    OldValue  = InterlockedCompareExchange32 (
+                  &LoggerInfo->LogCurrentOffset,
+                  CurrentBuffer,
+                  NewBuffer
+                  );
+  } while (OldValue != CurrentBuffer);
+
+  return CurrentBuffer;
+}
+
 /**
   Write data from buffer into the in memory logging buffer.
 
@@ -41,13 +280,7 @@ AdvancedLoggerMemoryLoggerWrite (
 {
   ADVANCED_LOGGER_INFO              *LoggerInfo;
   UINT32                            CurrentBuffer;
-  UINT32                            NewBuffer;
-  UINT32                            OldValue;
-  UINT32                            OldSize;
-  UINT32                            NewSize;
-  UINT32                            CurrentSize;
   UINTN                             EntrySize;
-  UINTN                             UsedSize;
   ADVANCED_LOGGER_MESSAGE_ENTRY_V2  *Entry;
 
   if ((NumberOfBytes == 0) || (Buffer == NULL)) {
@@ -61,61 +294,11 @@ AdvancedLoggerMemoryLoggerWrite (
   LoggerInfo = AdvancedLoggerGetLoggerInfo ();
 
   if (LoggerInfo != NULL) {
-    EntrySize = MESSAGE_ENTRY_SIZE_V2 (OFFSET_OF (ADVANCED_LOGGER_MESSAGE_ENTRY_V2, MessageText), NumberOfBytes);
-    do {
-      CurrentBuffer = LoggerInfo->LogCurrentOffset;
-      UsedSize      = USED_LOG_SIZE (LoggerInfo);
-      if ((UsedSize >= LoggerInfo->LogBufferSize) ||
-          ((LoggerInfo->LogBufferSize - UsedSize) < EntrySize))
-      {
-        if (FeaturePcdGet (PcdAdvancedLoggerAutoWrapEnable) && (LoggerInfo->AtRuntime)) {
-          //
-          // Wrap around the current cursor when auto wrap is enabled on buffer full during runtime.
-          //
-          NewBuffer = LoggerInfo->LogBufferOffset;
-          OldValue  = InterlockedCompareExchange32 (
-                        &LoggerInfo->LogCurrentOffset,
-                        CurrentBuffer,
-                        NewBuffer
-                        );
-          if (OldValue != CurrentBuffer) {
-            //
-            // Another thread has updated the buffer, we should retry the logging.
-            //
-            continue;
-          }
-
-          // Now that we have a buffer that starts from the beginning, proceed to log the current message, from the beginning.
-          // Note that in this case, if there are other threads in the middle of logging a message, they will continue to write
-          // to the end of the buffer as it fits.
-          // If there is another clearing attempt on the other thread, i.e. another thread also try to fill up the buffer, the
-          // first clear will take effect and the other log entries will fail to update and proceed with a normal retry.
-        } else {
-          //
-          // Update the number of bytes of log that have not been captured
-          //
-          do {
-            CurrentSize = LoggerInfo->DiscardedSize;
-            NewSize     = CurrentSize + (UINT32)NumberOfBytes;
-            OldSize     = InterlockedCompareExchange32 (
-                            (UINT32 *)&LoggerInfo->DiscardedSize,
-                            (UINT32)CurrentSize,
-                            (UINT32)NewSize
-                            );
-          } while (OldSize != CurrentSize);
-
-          return LoggerInfo;
-        }
-      }
-
-      // EntrySize is contained within a UINT32, this is safe to do
-      NewBuffer = (UINT32)(CurrentBuffer + EntrySize);
-      OldValue  = InterlockedCompareExchange32 (
-                    &LoggerInfo->LogCurrentOffset,
-                    CurrentBuffer,
-                    NewBuffer
-                    );
-    } while (OldValue != CurrentBuffer);
+    EntrySize     = MESSAGE_ENTRY_SIZE_V2 (OFFSET_OF (ADVANCED_LOGGER_MESSAGE_ENTRY_V2, MessageText), NumberOfBytes);
+    CurrentBuffer = AdvancedLoggerReserveEntry (LoggerInfo, EntrySize, NumberOfBytes);
+    if (CurrentBuffer == 0) {
+      return LoggerInfo;
+    }
 
     Entry               = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)((UINT8 *)LoggerInfo + CurrentBuffer);
     Entry->MajorVersion = ADVANCED_LOGGER_MSG_MAJ_VER;
@@ -135,6 +318,150 @@ AdvancedLoggerMemoryLoggerWrite (
   return LoggerInfo;
 }
 
+#ifndef ADVANCED_LOGGER_SEC
+
+/**
+  Check if a message is routed to the hdw port.
+
+  @param  LoggerInfo       The logger info block.
+  @param  DebugLevel       Debug level of the message
+
+  @retval TRUE             The message is written to the hdw port.
+  @retval FALSE            The message is only written to the in memory log.
+**/
+STATIC
+BOOLEAN
+AdvancedLoggerHdwPortSelected (
+  IN ADVANCED_LOGGER_INFO  *LoggerInfo,
+  IN UINTN                 DebugLevel
+  )
+{
+  if ((LoggerInfo == NULL) || (LoggerInfo->HdwPortDisabled)) {
+    return FALSE;
+  }
+
+  // if we are at a high enough version to support HW_LVL logging, only call the HdwPortWrite if this DebugLevel
+  // is asked to be logged
+  // if we are at an older version, check the PCD to see if we should log this message
+  if (LoggerInfo->Version >= ADVANCED_LOGGER_HW_LVL_VER) {
+    return (DebugLevel & LoggerInfo->HwPrintLevel) != 0;
+  }
+
+  return (DebugLevel & PcdGet32 (PcdAdvancedLoggerHdwPortDebugPrintErrorLevel)) != 0;
+}
+
+#endif
+
+/**
+  Check if a message can be written to the in memory logging buffer without formatting it.
+
+  This is only supported by the DXE core instance, whose format strings stay loaded and
+  mapped while the log is read during boot, and only for messages that are not routed to
+  the Hdw port.
+
+  @param  DebugLevel       Debug level of the message
+
+  @retval TRUE             AdvancedLoggerWriteDeferred may log a message of this level.
+  @retval FALSE            The message must be formatted and written with AdvancedLoggerWrite.
+
+**/
+BOOLEAN
+EFIAPI
+AdvancedLoggerDeferredEnabled (
+  IN       UINTN  DebugLevel
+  )
+{
+ #ifndef ADVANCED_LOGGER_DEFERRED_SUPPORTED
+  return FALSE;
+ #else
+  ADVANCED_LOGGER_INFO  *LoggerInfo;
+
+  //
+  // Format strings of other modules may be unloaded, or may be in memory the readers cannot
+  // access, before the log is read.
+  //
+  if (AdvancedLoggerGetPhase () != ADVANCED_LOGGER_PHASE_DXE) {
+    return FALSE;
+  }
+
+  LoggerInfo = AdvancedLoggerGetLoggerInfo ();
+  if ((LoggerInfo == NULL) || LoggerInfo->AtRuntime || AdvancedLoggerHdwPortSelected (LoggerInfo, DebugLevel)) {
+    return FALSE;
+  }
+
+  return TRUE;
+ #endif
+}
+
+/**
+  Write a message to the in memory logging buffer without formatting it.
+
+  The message is logged as the address of its format string and its arguments, and is
+  formatted when the log is read.  See AdvancedLoggerDeferredEnabled for when this is
+  supported.
+
+  @param  DebugLevel       Debug level of the message
+  @param  Format           Format string of the message.
+  @param  Data             Arguments of the message, as described for
+                           ADVANCED_LOGGER_MESSAGE_ENTRY_V3.
+  @param  DataLen          Number of bytes in Data.
+
+  @retval EFI_SUCCESS      The message was logged, or discarded because the log is full.
+  @retval EFI_UNSUPPORTED  The message must be formatted and written with AdvancedLoggerWrite.
+
+**/
+EFI_STATUS
+EFIAPI
+AdvancedLoggerWriteDeferred (
+  IN       UINTN  DebugLevel,
+  IN CONST CHAR8  *Format,
+  IN CONST UINT8  *Data,
+  IN       UINTN  DataLen
+  )
+{
+ #ifndef ADVANCED_LOGGER_DEFERRED_SUPPORTED
+  return EFI_UNSUPPORTED;
+ #else
+  ADVANCED_LOGGER_INFO              *LoggerInfo;
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V3  *Entry;
+  UINT32                            CurrentBuffer;
+  UINTN                             EntrySize;
+  UINTN                             FormatLen;
+
+  if ((Format == NULL) || (DataLen > ADVANCED_LOGGER_DEFERRED_DATA_SIZE) || ((Data == NULL) && (DataLen != 0))) {
+    return EFI_UNSUPPORTED;
+  }
+
+  FormatLen = AsciiStrnSizeS (Format, ADVANCED_LOGGER_DEFERRED_FORMAT_SIZE);
+  if ((FormatLen > ADVANCED_LOGGER_DEFERRED_FORMAT_SIZE) || !AdvancedLoggerDeferredEnabled (DebugLevel)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  LoggerInfo    = AdvancedLoggerGetLoggerInfo ();
+  EntrySize     = MESSAGE_ENTRY_SIZE_V2 (OFFSET_OF (ADVANCED_LOGGER_MESSAGE_ENTRY_V3, Data), DataLen);
+  CurrentBuffer = AdvancedLoggerReserveEntry (LoggerInfo, EntrySize, DataLen);
+  if (CurrentBuffer == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Entry                = (ADVANCED_LOGGER_MESSAGE_ENTRY_V3 *)((UINT8 *)LoggerInfo + CurrentBuffer);
+  Entry->MajorVersion  = ADVANCED_LOGGER_MSG_MAJ_VER;
+  Entry->MinorVersion  = ADVANCED_LOGGER_MSG_MIN_VER;
+  Entry->TimeStamp     = GetPerformanceCounter ();
+  Entry->Phase         = AdvancedLoggerGetPhase ();
+  Entry->DebugLevel    = (UINT32)DebugLevel;
+  Entry->DataOffset    = OFFSET_OF (ADVANCED_LOGGER_MESSAGE_ENTRY_V3, Data);
+  Entry->DataLen       = (UINT16)DataLen;
+  Entry->FormatLen     = (UINT16)FormatLen;
+  Entry->FormatAddress = (UINT64)(UINTN)Format;
+  Entry->FormatHash    = CalculateCrc32 ((VOID *)Format, FormatLen);
+  CopyMem (Entry->Data, Data, DataLen);
+  Entry->Signature = MESSAGE_ENTRY_SIGNATURE_V3;
+
+  return EFI_SUCCESS;
+ #endif
+}
+
 /**
   Write data from buffer to possible debugging devices.
 
@@ -176,17 +503,8 @@ AdvancedLoggerWrite (
   }
 
  #else
-  if ((LoggerInfo != NULL) && (!LoggerInfo->HdwPortDisabled)) {
-    // if we are at a high enough version to support HW_LVL logging, only call the HdwPortWrite if this DebugLevel
-    // is asked to be logged
-    // if we are at an older version, check the PCD to see if we should log this message
-    if (LoggerInfo->Version >= ADVANCED_LOGGER_HW_LVL_VER) {
-      if (DebugLevel & LoggerInfo->HwPrintLevel) {
-        AdvancedLoggerHdwPortWrite (DebugLevel, (UINT8 *)Buffer, NumberOfBytes);
-      }
-    } else if (DebugLevel & PcdGet32 (PcdAdvancedLoggerHdwPortDebugPrintErrorLevel)) {
-      AdvancedLoggerHdwPortWrite (DebugLevel, (UINT8 *)Buffer, NumberOfBytes);
-    }
+  if (AdvancedLoggerHdwPortSelected (LoggerInfo, DebugLevel)) {
+    AdvancedLoggerHdwPortWrite (DebugLevel, (UINT8 *)Buffer, NumberOfBytes);
   }
 
  #endif
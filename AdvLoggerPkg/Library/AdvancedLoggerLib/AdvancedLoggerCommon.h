@@ -58,6 +58,20 @@ AdvancedLoggerGetPhase (
   VOID
   );
 
+/**
+  Helper function to return an index for the processor that is logging.
+
+  The index is only used to spread processors across the log shards, so it does
+  not need to be dense or unique.
+
+  @return       Index of the current processor.
+**/
+UINTN
+EFIAPI
+AdvancedLoggerGetProcessorIndex (
+  VOID
+  );
+
 /**
   Write data from buffer into the in memory logging buffer.
 
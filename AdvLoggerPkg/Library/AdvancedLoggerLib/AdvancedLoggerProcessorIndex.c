@@ -0,0 +1,75 @@
+/** @file
+  Advanced Logger processor index for log sharding
+
+
+  Copyright (C) Microsoft Corporation. All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi/UefiBaseType.h>
+
+#include <AdvancedLoggerInternal.h>
+
+#include <Library/BaseLib.h>
+
+#if defined (MDE_CPU_AARCH64)
+  #include <Library/ArmLib.h>
+#endif
+
+#include "../AdvancedLoggerCommon.h"
+
+#if defined (MDE_CPU_IA32) || defined (MDE_CPU_X64)
+
+//
+// Initial APIC IDs of the processors running on recently used stack pages.  Each entry is the
+// stack page ORed with the APIC ID, so it is read and written atomically.  Every processor runs
+// on its own stack, so this avoids a CPUID on each log write.  An entry left over from another
+// processor only puts two processors in the same shard, which the shard reservation handles.
+//
+#define PROCESSOR_INDEX_CACHE_SIZE  64
+
+STATIC volatile UINTN  mProcessorIndexCache[PROCESSOR_INDEX_CACHE_SIZE];
+
+#endif
+
+/**
+  Helper function to return an index for the processor that is logging.
+
+  On IA32 and X64 this is the initial APIC ID of the processor, cached by stack page.  On
+  AARCH64 it combines the core and cluster affinity levels of MPIDR.  Other architectures
+  return 0, so all processors share one shard.
+
+  @return       Index of the current processor.
+**/
+UINTN
+EFIAPI
+AdvancedLoggerGetProcessorIndex (
+  VOID
+  )
+{
+ #if defined (MDE_CPU_IA32) || defined (MDE_CPU_X64)
+  UINTN   StackPage;
+  UINTN   Entry;
+  UINTN   Slot;
+  UINT32  RegEbx;
+
+  StackPage = (UINTN)&StackPage & ~(UINTN)EFI_PAGE_MASK;
+  Slot      = (StackPage >> EFI_PAGE_SHIFT) % PROCESSOR_INDEX_CACHE_SIZE;
+  Entry     = mProcessorIndexCache[Slot];
+  if ((Entry & ~(UINTN)EFI_PAGE_MASK) == StackPage) {
+    return Entry & EFI_PAGE_MASK;
+  }
+
+  AsmCpuid (1, NULL, &RegEbx, NULL, NULL);
+  mProcessorIndexCache[Slot] = StackPage | (RegEbx >> 24);
+  return (UINTN)(RegEbx >> 24);
+ #elif defined (MDE_CPU_AARCH64)
+  UINTN  Mpidr;
+
+  Mpidr = ArmReadMpidr ();
+  return (Mpidr & ARM_CORE_AFF) | ((Mpidr & ARM_CLUSTER_AFF) >> 4);
+ #else
+  return 0;
+ #endif
+}
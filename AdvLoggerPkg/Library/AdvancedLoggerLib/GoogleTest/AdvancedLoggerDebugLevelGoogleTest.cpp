@@ -0,0 +1,58 @@
+/** @file AdvancedLoggerDebugLevelGoogleTest.cpp
+
+    This file contains the host tests for reading the log of the Advanced Logger
+    Library back with a DebugLevelMask, which skips the entries of other DEBUG levels.
+
+    Copyright (c) Microsoft Corporation.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "AdvancedLoggerTestLog.h"
+
+/**
+  Test class for the DebugLevelMask of the access library.
+**/
+class AdvancedLoggerDebugLevelTest : public AdvancedLoggerTestLog {
+};
+
+//
+// Entries without a DEBUG level of the DebugLevelMask are skipped, and the walk resumes
+// after the skipped entries when more are logged.
+//
+TEST_F (AdvancedLoggerDebugLevelTest, DebugLevelMaskSkipsEntries) {
+  ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY  BlockEntry;
+  UINT64                                      Data[1];
+
+  Data[0] = 0;
+  PatchPcdSet32 (PcdAdvancedLoggerShardSize, SHARD_TEST_SHARD_SIZE);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Info\n", 5);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_ERROR, "Error 1\n", 8);
+  ASSERT_EQ (AdvancedLoggerWriteDeferred (DEBUG_VERBOSE, "Verbose %d\n", (UINT8 *)Data, sizeof (Data)), EFI_SUCCESS);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_ERROR | DEBUG_INFO, "Error 2\n", 8);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Info\n", 5);
+
+  ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+  ZeroMem (&BlockEntry, sizeof (BlockEntry));
+  BlockEntry.DebugLevelMask = DEBUG_ERROR;
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry), EFI_SUCCESS);
+  EXPECT_EQ (std::string (BlockEntry.Message, BlockEntry.MessageLen), "Error 1\n");
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry), EFI_SUCCESS);
+  EXPECT_EQ (std::string (BlockEntry.Message, BlockEntry.MessageLen), "Error 2\n");
+  EXPECT_EQ (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry), EFI_END_OF_FILE);
+
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Info\n", 5);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_ERROR, "Error 3\n", 8);
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry), EFI_SUCCESS);
+  EXPECT_EQ (std::string (BlockEntry.Message, BlockEntry.MessageLen), "Error 3\n");
+  EXPECT_EQ (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry), EFI_END_OF_FILE);
+}
+
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  InitGoogleTest (&argc, argv);
+  return RUN_ALL_TESTS ();
+}
@@ -0,0 +1,159 @@
+/** @file AdvancedLoggerDeferredGoogleTest.cpp
+
+    This file contains the host tests for the deferred-format message entries of the
+    Advanced Logger Library.  Deferred messages are logged as their format string and
+    arguments, and the access library formats them when the log is read.
+
+    Copyright (c) Microsoft Corporation.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "AdvancedLoggerTestLog.h"
+
+/**
+  Test class for the deferred-format message entries.
+**/
+class AdvancedLoggerDeferredTest : public AdvancedLoggerTestLog {
+protected:
+  //
+  // Read the only message of the log back through the access library.
+  //
+  std::string
+  ReadOnlyMessage (
+    VOID
+    )
+  {
+    ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY  BlockEntry;
+
+    EXPECT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+    ZeroMem (&BlockEntry, sizeof (BlockEntry));
+    if (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry) != EFI_SUCCESS) {
+      ADD_FAILURE ();
+      return "";
+    }
+
+    EXPECT_EQ (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry), EFI_END_OF_FILE);
+    return std::string (BlockEntry.Message, BlockEntry.MessageLen);
+  }
+};
+
+//
+// A deferred message is logged as its format string and arguments, and is formatted
+// when it is read back.
+//
+TEST_F (AdvancedLoggerDeferredTest, DeferredMessageIsFormattedWhenRead) {
+  ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY  BlockEntry;
+  STATIC CONST CHAR8                          Format[] = "Deferred %a %d %lx\n";
+  UINT64                                      Data[4];
+
+  // Two argument words, then the copy of the string argument.
+  Data[0] = 0;
+  Data[1] = (UINT64)-5;
+  Data[2] = 0x123456789AULL;
+  ZeroMem (&Data[3], sizeof (Data[3]));
+  CopyMem (&Data[3], "text", 5);
+
+  PatchPcdSet32 (PcdAdvancedLoggerShardSize, SHARD_TEST_SHARD_SIZE);
+  ASSERT_EQ (AdvancedLoggerWriteDeferred (DEBUG_INFO, Format, (UINT8 *)Data, sizeof (Data)), EFI_SUCCESS);
+  ASSERT_EQ (AdvancedLoggerWriteDeferred (DEBUG_INFO, NULL, (UINT8 *)Data, sizeof (Data)), EFI_UNSUPPORTED);
+
+  ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+  ZeroMem (&BlockEntry, sizeof (BlockEntry));
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry), EFI_SUCCESS);
+  EXPECT_EQ (std::string (BlockEntry.Message, BlockEntry.MessageLen), "Deferred text -5 123456789a\n");
+  EXPECT_EQ (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry), EFI_END_OF_FILE);
+}
+
+//
+// Deferred messages are not taken for levels routed to the Hdw port, or after
+// ExitBootServices, so the caller can format them before parsing any arguments.
+//
+TEST_F (AdvancedLoggerDeferredTest, DeferredEnabledFollowsHdwPortLevel) {
+  EXPECT_TRUE (AdvancedLoggerDeferredEnabled (DEBUG_INFO));
+
+  mTestLoggerInfo->HwPrintLevel = DEBUG_ERROR;
+  EXPECT_FALSE (AdvancedLoggerDeferredEnabled (DEBUG_ERROR));
+  EXPECT_TRUE (AdvancedLoggerDeferredEnabled (DEBUG_INFO));
+  EXPECT_EQ (AdvancedLoggerWriteDeferred (DEBUG_ERROR, "Error\n", NULL, 0), EFI_UNSUPPORTED);
+
+  mTestLoggerInfo->AtRuntime = TRUE;
+  EXPECT_FALSE (AdvancedLoggerDeferredEnabled (DEBUG_INFO));
+  EXPECT_EQ (mTestLoggerInfo->LogCurrentOffset, mTestLoggerInfo->LogBufferOffset);
+}
+
+//
+// A format string address that points into the log is not used.
+//
+TEST_F (AdvancedLoggerDeferredTest, FormatInsideLogIsRejected) {
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V3  *Entry;
+
+  ASSERT_EQ (AdvancedLoggerWriteDeferred (DEBUG_INFO, "Deferred\n", NULL, 0), EFI_SUCCESS);
+  Entry = (ADVANCED_LOGGER_MESSAGE_ENTRY_V3 *)LOG_BUFFER_FROM_ALI (mTestLoggerInfo);
+  ASSERT_EQ (Entry->Signature, MESSAGE_ENTRY_SIGNATURE_V3);
+  ASSERT_EQ (Entry->FormatLen, sizeof ("Deferred\n"));
+
+  // Point the entry at text of the log buffer that has the same length.
+  CopyMem ((UINT8 *)mTestLoggerInfo + mTestLoggerInfo->LogBufferSize, "Replaced\n", sizeof ("Replaced\n"));
+  Entry->FormatAddress = (UINT64)(UINTN)((UINT8 *)mTestLoggerInfo + mTestLoggerInfo->LogBufferSize);
+  EXPECT_EQ (ReadOnlyMessage ().rfind ("Deferred message has an invalid format address", 0), 0u);
+
+  Entry->FormatAddress = MAX_ADDRESS - 1;
+  EXPECT_EQ (ReadOnlyMessage ().rfind ("Deferred message has an invalid format address", 0), 0u);
+}
+
+//
+// A format string that no longer has the length that was logged is not used.
+//
+TEST_F (AdvancedLoggerDeferredTest, ChangedFormatIsRejected) {
+  CHAR8  Format[] = "Deferred\n";
+
+  ASSERT_EQ (AdvancedLoggerWriteDeferred (DEBUG_INFO, Format, NULL, 0), EFI_SUCCESS);
+  EXPECT_EQ (ReadOnlyMessage (), "Deferred\n");
+
+  Format[4] = '\0';
+  EXPECT_EQ (ReadOnlyMessage ().rfind ("Deferred message format at", 0), 0u);
+}
+
+//
+// A format string that was replaced by different text of the same length is not used,
+// so the arguments are not formatted with the wrong specifiers.
+//
+TEST_F (AdvancedLoggerDeferredTest, SameLengthFormatIsRejected) {
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V3  *Entry;
+  CHAR8                             Format[] = "Value %a\n";
+  UINT64                            Data[2];
+
+  Data[0] = 0;
+  ZeroMem (&Data[1], sizeof (Data[1]));
+  CopyMem (&Data[1], "text", 5);
+
+  ASSERT_EQ (AdvancedLoggerWriteDeferred (DEBUG_INFO, Format, (UINT8 *)Data, sizeof (Data)), EFI_SUCCESS);
+  Entry = (ADVANCED_LOGGER_MESSAGE_ENTRY_V3 *)LOG_BUFFER_FROM_ALI (mTestLoggerInfo);
+  ASSERT_EQ (Entry->Signature, MESSAGE_ENTRY_SIGNATURE_V3);
+  EXPECT_EQ (Entry->FormatHash, CalculateCrc32 (Format, sizeof (Format)));
+  EXPECT_EQ (ReadOnlyMessage (), "Value text\n");
+
+  Format[7] = 's';
+  EXPECT_EQ (ReadOnlyMessage ().rfind ("Deferred message format at", 0), 0u);
+}
+
+//
+// Format strings longer than the readers accept are left to be formatted when logged.
+//
+TEST_F (AdvancedLoggerDeferredTest, LongFormatIsUnsupported) {
+  std::string  Format (ADVANCED_LOGGER_DEFERRED_FORMAT_SIZE, 'F');
+
+  EXPECT_EQ (AdvancedLoggerWriteDeferred (DEBUG_INFO, Format.c_str (), NULL, 0), EFI_UNSUPPORTED);
+  Format.resize (ADVANCED_LOGGER_DEFERRED_FORMAT_SIZE - 1);
+  EXPECT_EQ (AdvancedLoggerWriteDeferred (DEBUG_INFO, Format.c_str (), NULL, 0), EFI_SUCCESS);
+}
+
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  InitGoogleTest (&argc, argv);
+  return RUN_ALL_TESTS ();
+}
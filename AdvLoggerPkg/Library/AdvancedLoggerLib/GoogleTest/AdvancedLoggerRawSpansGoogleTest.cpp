@@ -0,0 +1,270 @@
+/** @file AdvancedLoggerRawSpansGoogleTest.cpp
+
+    This file contains the host tests for reading the log of the Advanced Logger
+    Library back as raw spans.  The tests check the spans of sharded, unsharded and
+    wrapped logs.  Built with ADVANCED_LOGGER_HOST_BENCHMARK, they also report the
+    throughput of raw spans and of formatted lines.
+
+    Copyright (c) Microsoft Corporation.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Library/GoogleTestLib.h>
+#include <GoogleTest/Library/MockMemoryAllocationLib.h>
+
+#include "AdvancedLoggerTestLog.h"
+
+#define RAW_TEST_PASSES  20
+
+/**
+  Test class for the raw spans of the access library.
+**/
+class AdvancedLoggerRawSpansTest : public AdvancedLoggerTestLog {
+};
+
+//
+// The raw spans return the whole log as it is stored, including the closed chunks.
+//
+TEST_F (AdvancedLoggerRawSpansTest, RawSpansReturnWholeLog) {
+  ADVANCED_LOGGER_ACCESS_RAW_BLOCK_ENTRY  RawEntry;
+  UINT8                                   *LogStart;
+  UINTN                                   Length;
+
+  for (UINT32 ShardSize : { 0, SHARD_TEST_SHARD_SIZE }) {
+    SetUp ();
+    LogFromThreads (ShardSize);
+
+    // Close the chunks that are still open, as the writers would when they fill them.
+    for (UINT32 Offset = mTestLoggerInfo->LogBufferOffset; Offset < mTestLoggerInfo->LogCurrentOffset;) {
+      ADVANCED_LOGGER_CHUNK_HEADER  *Chunk = (ADVANCED_LOGGER_CHUNK_HEADER *)((UINT8 *)mTestLoggerInfo + Offset);
+
+      if (Chunk->Signature == CHUNK_HEADER_SIGNATURE) {
+        Chunk->UsedSize |= CHUNK_CLOSED;
+        Offset          += Chunk->ChunkSize;
+      } else {
+        Offset += MESSAGE_ENTRY_SIZE_V2 (((ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)Chunk)->MessageOffset, ((ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)Chunk)->MessageLen);
+      }
+    }
+
+    ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+    ZeroMem (&RawEntry, sizeof (RawEntry));
+    ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+    ASSERT_EQ (RawEntry.SpanCount, 1u);
+
+    LogStart = LOG_BUFFER_FROM_ALI (mTestLoggerInfo);
+    Length   = mTestLoggerInfo->LogCurrentOffset - mTestLoggerInfo->LogBufferOffset;
+    EXPECT_EQ (RawEntry.Span[0].Data, LogStart);
+    EXPECT_EQ (RawEntry.Span[0].DataLen, Length);
+    EXPECT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_END_OF_FILE);
+
+    // Only the new entries are returned by the next call.
+    PatchPcdSet32 (PcdAdvancedLoggerShardSize, 0);
+    AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Next\n", 5);
+    ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+    ASSERT_EQ (RawEntry.SpanCount, 1u);
+    EXPECT_EQ (RawEntry.Span[0].Data, LogStart + Length);
+    EXPECT_EQ (RawEntry.Span[0].DataLen, (UINTN)(mTestLoggerInfo->LogCurrentOffset - mTestLoggerInfo->LogBufferOffset) - Length);
+  }
+}
+
+//
+// An open chunk ends the raw spans until it is closed.
+//
+TEST_F (AdvancedLoggerRawSpansTest, RawSpansStopAtOpenChunk) {
+  ADVANCED_LOGGER_ACCESS_RAW_BLOCK_ENTRY  RawEntry;
+  ADVANCED_LOGGER_CHUNK_HEADER            *Chunk;
+  UINT32                                  ChunkOffset;
+
+  PatchPcdSet32 (PcdAdvancedLoggerShardSize, 0);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "First\n", 6);
+  ChunkOffset = mTestLoggerInfo->LogCurrentOffset;
+  PatchPcdSet32 (PcdAdvancedLoggerShardSize, SHARD_TEST_SHARD_SIZE);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Chunk\n", 6);
+  Chunk = (ADVANCED_LOGGER_CHUNK_HEADER *)((UINT8 *)mTestLoggerInfo + ChunkOffset);
+  ASSERT_EQ (Chunk->Signature, CHUNK_HEADER_SIGNATURE);
+
+  ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+  ZeroMem (&RawEntry, sizeof (RawEntry));
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+  ASSERT_EQ (RawEntry.SpanCount, 1u);
+  EXPECT_EQ (RawEntry.Span[0].DataLen, (UINTN)(ChunkOffset - mTestLoggerInfo->LogBufferOffset));
+  EXPECT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_END_OF_FILE);
+
+  Chunk->UsedSize |= CHUNK_CLOSED;
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+  ASSERT_EQ (RawEntry.SpanCount, 1u);
+  EXPECT_EQ (RawEntry.Span[0].Data, (UINT8 *)Chunk);
+  EXPECT_EQ (RawEntry.Span[0].DataLen, (UINTN)Chunk->ChunkSize);
+}
+
+//
+// When the log wraps, the entries at the end of the log buffer are returned before the
+// entries written over the start of the log buffer.
+//
+TEST_F (AdvancedLoggerRawSpansTest, RawSpansFollowWrap) {
+  ADVANCED_LOGGER_ACCESS_RAW_BLOCK_ENTRY  RawEntry;
+  UINT32                                  TailOffset;
+  UINT32                                  TailEnd;
+
+  PatchPcdSet32 (PcdAdvancedLoggerShardSize, 0);
+  for (UINTN Index = 0; Index < 8; Index++) {
+    AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Before the wrap\n", 16);
+  }
+
+  ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+  ZeroMem (&RawEntry, sizeof (RawEntry));
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+
+  TailOffset = mTestLoggerInfo->LogCurrentOffset;
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Tail\n", 5);
+  TailEnd = mTestLoggerInfo->LogCurrentOffset;
+
+  // Wrap, and write over the first entries.
+  mTestLoggerInfo->LogCurrentOffset = mTestLoggerInfo->LogBufferOffset;
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "After the wrap\n", 15);
+
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+  ASSERT_EQ (RawEntry.SpanCount, 2u);
+  EXPECT_EQ (RawEntry.Span[0].Data, (UINT8 *)mTestLoggerInfo + TailOffset);
+  EXPECT_EQ (RawEntry.Span[0].DataLen, (UINTN)(TailEnd - TailOffset));
+  EXPECT_EQ (RawEntry.Span[1].Data, LOG_BUFFER_FROM_ALI (mTestLoggerInfo));
+  EXPECT_EQ (RawEntry.Span[1].DataLen, (UINTN)(mTestLoggerInfo->LogCurrentOffset - mTestLoggerInfo->LogBufferOffset));
+
+  // Wrap again with a shorter entry.  The entries left from before the first wrap are
+  // older, and are not returned again.
+  mTestLoggerInfo->LogCurrentOffset = mTestLoggerInfo->LogBufferOffset;
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Wrap\n", 5);
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+  ASSERT_EQ (RawEntry.SpanCount, 1u);
+  EXPECT_EQ (RawEntry.Span[0].Data, LOG_BUFFER_FROM_ALI (mTestLoggerInfo));
+  EXPECT_EQ (RawEntry.Span[0].DataLen, (UINTN)(mTestLoggerInfo->LogCurrentOffset - mTestLoggerInfo->LogBufferOffset));
+}
+
+//
+// When the end of the log buffer stops at an entry that is still being written as the
+// log wraps, the rest of the end of the log buffer is returned once the entry is written.
+//
+TEST_F (AdvancedLoggerRawSpansTest, RawSpansResumeTailAfterWrap) {
+  ADVANCED_LOGGER_ACCESS_RAW_BLOCK_ENTRY  RawEntry;
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V2        *Pending;
+  UINT32                                  TailOffset;
+  UINT32                                  PendingOffset;
+  UINT32                                  TailEnd;
+
+  PatchPcdSet32 (PcdAdvancedLoggerShardSize, 0);
+  for (UINTN Index = 0; Index < 8; Index++) {
+    AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Before the wrap\n", 16);
+  }
+
+  ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+  ZeroMem (&RawEntry, sizeof (RawEntry));
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+
+  // The second entry of the tail is still being written when the log wraps.
+  TailOffset = mTestLoggerInfo->LogCurrentOffset;
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Tail 1\n", 7);
+  PendingOffset = mTestLoggerInfo->LogCurrentOffset;
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Tail 2\n", 7);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Tail 3\n", 7);
+  TailEnd            = mTestLoggerInfo->LogCurrentOffset;
+  Pending            = (ADVANCED_LOGGER_MESSAGE_ENTRY_V2 *)((UINT8 *)mTestLoggerInfo + PendingOffset);
+  Pending->Signature = 0;
+
+  mTestLoggerInfo->LogCurrentOffset = mTestLoggerInfo->LogBufferOffset;
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "After the wrap\n", 15);
+
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+  ASSERT_EQ (RawEntry.SpanCount, 2u);
+  EXPECT_EQ (RawEntry.Span[0].Data, (UINT8 *)mTestLoggerInfo + TailOffset);
+  EXPECT_EQ (RawEntry.Span[0].DataLen, (UINTN)(PendingOffset - TailOffset));
+  EXPECT_EQ (RawEntry.Span[1].Data, LOG_BUFFER_FROM_ALI (mTestLoggerInfo));
+  EXPECT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_END_OF_FILE);
+
+  // Once the entry is written, the rest of the tail is returned, then the new entries.
+  Pending->Signature = MESSAGE_ENTRY_SIGNATURE_V2;
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Next\n", 5);
+  ASSERT_EQ (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry), EFI_SUCCESS);
+  ASSERT_EQ (RawEntry.SpanCount, 2u);
+  EXPECT_EQ (RawEntry.Span[0].Data, (UINT8 *)Pending);
+  EXPECT_EQ (RawEntry.Span[0].DataLen, (UINTN)(TailEnd - PendingOffset));
+  EXPECT_EQ (RawEntry.Span[1].DataLen, (UINTN)MESSAGE_ENTRY_SIZE_V2 (OFFSET_OF (ADVANCED_LOGGER_MESSAGE_ENTRY_V2, MessageText), 5));
+}
+
+#ifdef ADVANCED_LOGGER_HOST_BENCHMARK
+
+//
+// Compare forwarding the log as formatted lines with forwarding it as raw spans.
+// Nothing is asserted about the numbers, they are reported for comparison.
+//
+TEST_F (AdvancedLoggerRawSpansTest, RawSpansBenchmark) {
+  MockMemoryAllocationLib                    MemoryAllocationLib;
+  ADVANCED_LOGGER_ACCESS_MESSAGE_LINE_ENTRY  LineEntry;
+  ADVANCED_LOGGER_ACCESS_RAW_BLOCK_ENTRY     RawEntry;
+  std::vector<CHAR8>                         LineBuffer (ADVANCED_LOGGER_MAX_MESSAGE_SIZE * 2);
+  std::vector<UINT8>                         Sink (SHARD_TEST_BUFFER_SIZE);
+  UINTN                                      SinkLen;
+  UINTN                                      LineBytes;
+  UINTN                                      RawBytes;
+  double                                     LineSeconds;
+  double                                     RawSeconds;
+
+  EXPECT_CALL (MemoryAllocationLib, AllocatePool (_))
+    .WillRepeatedly (Return (LineBuffer.data ()));
+
+  LogFromThreads (0);
+  ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+
+  LineBytes = 0;
+  auto  Start = std::chrono::steady_clock::now ();
+
+  for (UINTN Pass = 0; Pass < RAW_TEST_PASSES; Pass++) {
+    ZeroMem (&LineEntry, sizeof (LineEntry));
+    SinkLen = 0;
+    while (AdvancedLoggerAccessLibGetNextFormattedLine (&LineEntry) == EFI_SUCCESS) {
+      CopyMem (&Sink[SinkLen], LineEntry.Message, LineEntry.MessageLen);
+      SinkLen += LineEntry.MessageLen;
+    }
+
+    LineBytes += SinkLen;
+  }
+
+  LineSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now () - Start).count ();
+
+  RawBytes = 0;
+  Start    = std::chrono::steady_clock::now ();
+  for (UINTN Pass = 0; Pass < RAW_TEST_PASSES; Pass++) {
+    ZeroMem (&RawEntry, sizeof (RawEntry));
+    SinkLen = 0;
+    while (AdvancedLoggerAccessLibGetNextRawSpans (&RawEntry) == EFI_SUCCESS) {
+      for (UINTN Index = 0; Index < RawEntry.SpanCount; Index++) {
+        CopyMem (&Sink[SinkLen], RawEntry.Span[Index].Data, RawEntry.Span[Index].DataLen);
+        SinkLen += RawEntry.Span[Index].DataLen;
+      }
+    }
+
+    EXPECT_EQ (CompareMem (Sink.data (), LOG_BUFFER_FROM_ALI (mTestLoggerInfo), SinkLen), 0);
+    RawBytes += SinkLen;
+  }
+
+  RawSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now () - Start).count ();
+
+  printf (
+    "Formatted lines: %.1f MB/s, raw spans: %.1f MB/s\n",
+    LineBytes / LineSeconds / (1024 * 1024),
+    RawBytes / RawSeconds / (1024 * 1024)
+    );
+
+  EXPECT_EQ (RawBytes, (UINTN)(mTestLoggerInfo->LogCurrentOffset - mTestLoggerInfo->LogBufferOffset) * RAW_TEST_PASSES);
+}
+
+#endif
+
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  InitGoogleTest (&argc, argv);
+  return RUN_ALL_TESTS ();
+}
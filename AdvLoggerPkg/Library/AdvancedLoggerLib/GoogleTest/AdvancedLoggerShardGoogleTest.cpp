@@ -0,0 +1,133 @@
+/** @file AdvancedLoggerShardGoogleTest.cpp
+
+    This file contains the stress tests for the sharded log reservation of the
+    Advanced Logger Library.  Several threads log at the same time, and the tests
+    check that every message can be read back in the order each thread logged it.  When built
+    with ADVANCED_LOGGER_HOST_BENCHMARK, the tests also report the contended exchanges and the
+    bytes per second for both reservation modes.
+
+    Copyright (c) Microsoft Corporation.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "AdvancedLoggerTestLog.h"
+
+/**
+  Test class for the sharded log reservation.
+**/
+class AdvancedLoggerShardTest : public AdvancedLoggerTestLog {
+protected:
+  //
+  // Read the log back through the access library, and check that every message is
+  // returned once, and in order for each thread.
+  //
+  void
+  ValidateLog (
+    VOID
+    )
+  {
+    ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY  BlockEntry;
+    std::vector<UINTN>                          NextMessage (SHARD_TEST_THREADS, 0);
+    UINTN                                       Count;
+    UINT32                                      Thread;
+    UINT32                                      Index;
+
+    ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+
+    ZeroMem (&BlockEntry, sizeof (BlockEntry));
+    Count = 0;
+    while (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry) == EFI_SUCCESS) {
+      ASSERT_EQ (sscanf (BlockEntry.Message, "T%u M%u", &Thread, &Index), 2);
+      ASSERT_LT (Thread, (UINT32)SHARD_TEST_THREADS);
+      EXPECT_EQ (Index, NextMessage[Thread]);
+      NextMessage[Thread] = Index + 1;
+      Count++;
+    }
+
+    EXPECT_EQ (Count, (UINTN)(SHARD_TEST_THREADS * SHARD_TEST_MESSAGES));
+    EXPECT_EQ (mTestLoggerInfo->DiscardedSize, 0u);
+  }
+};
+
+//
+// Every message logged through the chunks is read back in order.
+//
+TEST_F (AdvancedLoggerShardTest, ShardedLogKeepsEveryMessage) {
+  LogFromThreads (SHARD_TEST_SHARD_SIZE);
+  ValidateLog ();
+}
+
+//
+// The unsharded log reads back the same way.
+//
+TEST_F (AdvancedLoggerShardTest, UnshardedLogKeepsEveryMessage) {
+  LogFromThreads (0);
+  ValidateLog ();
+}
+
+//
+// A message too large for a chunk is written at the top level of the log and merged
+// with the chunk entries.
+//
+TEST_F (AdvancedLoggerShardTest, LargeMessageBypassesChunk) {
+  ADVANCED_LOGGER_ACCESS_MESSAGE_BLOCK_ENTRY  BlockEntry;
+  std::vector<CHAR8>                          Large (SHARD_TEST_SHARD_SIZE, 'L');
+  UINTN                                       Count;
+
+  PatchPcdSet32 (PcdAdvancedLoggerShardSize, SHARD_TEST_SHARD_SIZE);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "First\n", 6);
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, Large.data (), Large.size ());
+  AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, "Last\n", 5);
+
+  ASSERT_EQ (AdvancedLoggerAccessLibUnitTestInitialize (&Container.AdvLoggerProtocol, 0), EFI_SUCCESS);
+  ZeroMem (&BlockEntry, sizeof (BlockEntry));
+  Count = 0;
+  while (AdvancedLoggerAccessLibGetNextMessageBlock (&BlockEntry) == EFI_SUCCESS) {
+    EXPECT_EQ (BlockEntry.TimeStamp, (UINT64)(Count + 1));
+    Count++;
+  }
+
+  EXPECT_EQ (Count, 3u);
+}
+
+#ifdef ADVANCED_LOGGER_HOST_BENCHMARK
+
+//
+// Compare the contended exchanges and the throughput of the two reservation modes.
+// Nothing is asserted about the numbers, they are reported for comparison.
+//
+TEST_F (AdvancedLoggerShardTest, ContentionBenchmark) {
+  UINT32  ShardSizes[] = { 0, SHARD_TEST_SHARD_SIZE };
+  double  Seconds;
+  UINT64  Bytes;
+
+  for (UINT32 ShardSize : ShardSizes) {
+    SetUp ();
+    Seconds = LogFromThreads (ShardSize);
+    Bytes   = mTestLoggerInfo->LogCurrentOffset - mTestLoggerInfo->LogBufferOffset;
+
+    printf (
+      "ShardSize=0x%x: %llu exchanges, %llu retries, %llu LogCurrentOffset retries, %.0f bytes/sec\n",
+      ShardSize,
+      (unsigned long long)mTestExchanges.load (),
+      (unsigned long long)mTestRetries.load (),
+      (unsigned long long)mTestCursorRetries.load (),
+      Bytes / Seconds
+      );
+
+    RecordProperty (ShardSize == 0 ? "UnshardedRetries" : "ShardedRetries", (int)mTestRetries.load ());
+    EXPECT_EQ (mTestLoggerInfo->DiscardedSize, 0u);
+  }
+}
+
+#endif
+
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  InitGoogleTest (&argc, argv);
+  return RUN_ALL_TESTS ();
+}
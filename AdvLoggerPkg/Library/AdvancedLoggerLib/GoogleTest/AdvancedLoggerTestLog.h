@@ -0,0 +1,211 @@
+/** @file AdvancedLoggerTestLog.h
+
+    The log buffer, library instance hooks and logging threads shared by the host
+    tests of the Advanced Logger Library.  Include it from the one source file of
+    each test application.
+
+    Copyright (c) Microsoft Corporation.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef ADVANCED_LOGGER_TEST_LOG_H_
+#define ADVANCED_LOGGER_TEST_LOG_H_
+
+#include <Library/GoogleTestLib.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/PcdLib.h>
+  #include <AdvancedLoggerInternal.h>
+  #include <Protocol/AdvancedLogger.h>
+  #include <AdvancedLoggerInternalProtocol.h>
+  #include <Library/AdvancedLoggerAccessLib.h>
+  #include <Library/AdvancedLoggerLib.h>
+  #include "../AdvancedLoggerCommon.h"
+}
+
+using namespace testing;
+
+#define SHARD_TEST_THREADS       8
+#define SHARD_TEST_MESSAGES      4000
+#define SHARD_TEST_BUFFER_SIZE   (4 * 1024 * 1024)
+#define SHARD_TEST_SHARD_SIZE    0x2000
+#define SHARD_TEST_MESSAGE_SIZE  64
+
+STATIC ADVANCED_LOGGER_INFO    *mTestLoggerInfo = NULL;
+STATIC std::atomic<UINT64>     mTestTimeStamp (0);
+STATIC std::atomic<UINT64>     mTestExchanges (0);
+STATIC std::atomic<UINT64>     mTestRetries (0);
+STATIC std::atomic<UINT64>     mTestCursorRetries (0);
+STATIC thread_local UINTN      mTestProcessorIndex = 0;
+
+//
+// The library instance hooks, timer and synchronization functions are provided
+// here so the tests control the processor index and count the exchanges.
+//
+extern "C" {
+  ADVANCED_LOGGER_INFO *
+  EFIAPI
+  AdvancedLoggerGetLoggerInfo (
+    VOID
+    )
+  {
+    return mTestLoggerInfo;
+  }
+
+  UINT16
+  EFIAPI
+  AdvancedLoggerGetPhase (
+    VOID
+    )
+  {
+    return ADVANCED_LOGGER_PHASE_DXE;
+  }
+
+  UINTN
+  EFIAPI
+  AdvancedLoggerGetProcessorIndex (
+    VOID
+    )
+  {
+    return mTestProcessorIndex;
+  }
+
+  UINT64
+  EFIAPI
+  GetPerformanceCounter (
+    VOID
+    )
+  {
+    return ++mTestTimeStamp;
+  }
+
+  UINT64
+  EFIAPI
+  GetTimeInNanoSecond (
+    IN UINT64  Ticks
+    )
+  {
+    return Ticks;
+  }
+
+  UINT32
+  EFIAPI
+  InterlockedCompareExchange32 (
+    IN OUT volatile UINT32  *Value,
+    IN UINT32               CompareValue,
+    IN UINT32               ExchangeValue
+    )
+  {
+    UINT32  OldValue;
+
+    OldValue = __sync_val_compare_and_swap (Value, CompareValue, ExchangeValue);
+    mTestExchanges++;
+    if (OldValue != CompareValue) {
+      mTestRetries++;
+      if (Value == &mTestLoggerInfo->LogCurrentOffset) {
+        mTestCursorRetries++;
+      }
+    }
+
+    return OldValue;
+  }
+}
+
+/**
+  Test class base with an empty log in a host buffer.
+**/
+class AdvancedLoggerTestLog : public Test {
+protected:
+  std::vector<UINT64> Buffer;
+  ADVANCED_LOGGER_PROTOCOL_CONTAINER Container;
+
+  void
+  SetUp (
+    ) override
+  {
+    Buffer.assign (SHARD_TEST_BUFFER_SIZE / sizeof (UINT64), 0);
+    mTestLoggerInfo                   = (ADVANCED_LOGGER_INFO *)Buffer.data ();
+    mTestLoggerInfo->Signature        = ADVANCED_LOGGER_SIGNATURE;
+    mTestLoggerInfo->Version          = ADVANCED_LOGGER_VERSION;
+    mTestLoggerInfo->LogBufferOffset  = EXPECTED_LOG_BUFFER_OFFSET (mTestLoggerInfo);
+    mTestLoggerInfo->LogCurrentOffset = mTestLoggerInfo->LogBufferOffset;
+    mTestLoggerInfo->LogBufferSize    = SHARD_TEST_BUFFER_SIZE - mTestLoggerInfo->LogBufferOffset;
+
+    ZeroMem (&Container, sizeof (Container));
+    Container.AdvLoggerProtocol.Signature = ADVANCED_LOGGER_PROTOCOL_SIGNATURE;
+    Container.AdvLoggerProtocol.Version   = ADVANCED_LOGGER_PROTOCOL_VERSION;
+    Container.LoggerInfo                  = mTestLoggerInfo;
+
+    mTestTimeStamp     = 0;
+    mTestExchanges     = 0;
+    mTestRetries       = 0;
+    mTestCursorRetries = 0;
+  }
+
+  void
+  TearDown (
+    ) override
+  {
+    mTestLoggerInfo = NULL;
+  }
+
+  //
+  // Log SHARD_TEST_MESSAGES messages from each of SHARD_TEST_THREADS threads, and
+  // return the time taken in seconds.
+  //
+  double
+  LogFromThreads (
+    UINT32  ShardSize
+    )
+  {
+    std::vector<std::thread>  Threads;
+    std::atomic<UINTN>        Ready (0);
+
+    PatchPcdSet32 (PcdAdvancedLoggerShardSize, ShardSize);
+
+    for (UINTN Thread = 0; Thread < SHARD_TEST_THREADS; Thread++) {
+      Threads.emplace_back (
+                [Thread, &Ready]() {
+        CHAR8  Message[SHARD_TEST_MESSAGE_SIZE];
+        UINTN  Length;
+
+        mTestProcessorIndex = Thread;
+
+        // Start logging from all threads at once.
+        Ready++;
+        while (Ready < SHARD_TEST_THREADS + 1) {
+        }
+
+        for (UINTN Index = 0; Index < SHARD_TEST_MESSAGES; Index++) {
+          Length = snprintf (Message, sizeof (Message), "T%02u M%06u shard stress message\n", (UINT32)Thread, (UINT32)Index);
+          AdvancedLoggerMemoryLoggerWrite (DEBUG_INFO, Message, Length);
+        }
+      }
+                );
+    }
+
+    while (Ready < SHARD_TEST_THREADS) {
+    }
+
+    auto  Start = std::chrono::steady_clock::now ();
+
+    Ready++;
+    for (auto &Thread : Threads) {
+      Thread.join ();
+    }
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now () - Start).count ();
+  }
+};
+
+#endif // ADVANCED_LOGGER_TEST_LOG_H_
@@ -84,6 +84,52 @@ AdvancedLoggerWrite (
   }
 }
 
+/**
+  Check if a message can be written to the in memory logging buffer without formatting it.
+
+  This instance routes messages to the Advanced Logger protocol, which only accepts formatted
+  messages.
+
+  @param  DebugLevel       Debug level of the message
+
+  @retval FALSE            The message must be formatted and written with AdvancedLoggerWrite.
+
+**/
+BOOLEAN
+EFIAPI
+AdvancedLoggerDeferredEnabled (
+  IN       UINTN  DebugLevel
+  )
+{
+  return FALSE;
+}
+
+/**
+  Write a message to the in memory logging buffer without formatting it.
+
+  This instance routes messages to the Advanced Logger protocol, which only accepts formatted
+  messages.
+
+  @param  DebugLevel       Debug level of the message
+  @param  Format           Format string of the message.
+  @param  Data             Arguments of the message.
+  @param  DataLen          Number of bytes in Data.
+
+  @retval EFI_UNSUPPORTED  The message must be formatted and written with AdvancedLoggerWrite.
+
+**/
+EFI_STATUS
+EFIAPI
+AdvancedLoggerWriteDeferred (
+  IN       UINTN  DebugLevel,
+  IN CONST CHAR8  *Format,
+  IN CONST UINT8  *Data,
+  IN       UINTN  DataLen
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
 /**
   The constructor function initializes Logger Information pointer to ensure that the
   pointer is initialized in DXE - either by the constructor, or the first DEBUG message.
@@ -120,6 +120,222 @@ DebugPrint (
   VA_END (Marker);
 }
 
+/**
+  Copy a string, GUID or time argument of a deferred message.
+
+  @param  Copies        Buffer of the copied arguments.
+  @param  CopiesSize    Size of the Copies buffer.
+  @param  CopiesLen     On input, the bytes of Copies in use.  On output, updated for the copy.
+  @param  Source        Argument to copy.
+  @param  SourceLen     Number of bytes to copy.
+  @param  Arg           Returns the offset of the copy, or DEFERRED_ARG_NULL if Source is NULL.
+
+  @retval TRUE          The argument was copied.
+  @retval FALSE         There is no room for the argument.
+**/
+STATIC
+BOOLEAN
+DebugCopyDeferredArg (
+  IN OUT UINT8       *Copies,
+  IN     UINTN       CopiesSize,
+  IN OUT UINTN       *CopiesLen,
+  IN     CONST VOID  *Source,
+  IN     UINTN       SourceLen,
+  OUT    UINT64      *Arg
+  )
+{
+  if (Source == NULL) {
+    *Arg = DEFERRED_ARG_NULL;
+    return TRUE;
+  }
+
+  if (ALIGN_VALUE (SourceLen, 8) > CopiesSize - *CopiesLen) {
+    return FALSE;
+  }
+
+  CopyMem (Copies + *CopiesLen, Source, SourceLen);
+  *Arg        = *CopiesLen;
+  *CopiesLen += ALIGN_VALUE (SourceLen, 8);
+
+  return TRUE;
+}
+
+/**
+  Logs a debug message without formatting it, when the Advanced Logger supports it.
+
+  The arguments consumed by Format are read from VaListMarker and saved as described for
+  ADVANCED_LOGGER_MESSAGE_ENTRY_V3, so the message can be formatted when the log is read.
+  Messages with a format the log readers could not reproduce are left to be formatted now.
+
+  @param  ErrorLevel    The error level of the debug message.
+  @param  Format        Format string for the debug message to print.
+  @param  VaListMarker  VA_LIST marker for the variable argument list.
+
+  @retval TRUE          The message was logged.
+  @retval FALSE         The message must be formatted and written with AdvancedLoggerWrite.
+**/
+STATIC
+BOOLEAN
+DebugPrintDeferred (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  IN  VA_LIST      VaListMarker
+  )
+{
+  UINT64      Args[ADVANCED_LOGGER_DEFERRED_DATA_SIZE / sizeof (UINT64)];
+  UINT8       Copies[ADVANCED_LOGGER_DEFERRED_DATA_SIZE];
+  UINTN       ArgCount;
+  UINTN       CopiesLen;
+  UINTN       Index;
+  BOOLEAN     LongType;
+  BOOLEAN     Precision;
+  BOOLEAN     Result;
+  VA_LIST     Marker;
+  CONST VOID  *Pointer;
+  UINTN       Status;
+
+  ArgCount  = 0;
+  CopiesLen = 0;
+  Result    = TRUE;
+  VA_COPY (Marker, VaListMarker);
+
+  for (Index = 0; Result && (Format[Index] != '\0'); Index++) {
+    if (Format[Index] != '%') {
+      continue;
+    }
+
+    //
+    // Flags, width and precision.  A '*' width or precision is an argument.
+    //
+    LongType  = FALSE;
+    Precision = FALSE;
+    for (Index++; Format[Index] != '\0'; Index++) {
+      if (Format[Index] == '*') {
+        if (ArgCount == ARRAY_SIZE (Args)) {
+          Result = FALSE;
+          break;
+        }
+
+        Args[ArgCount++] = VA_ARG (Marker, UINTN);
+      } else if ((Format[Index] == 'L') || (Format[Index] == 'l')) {
+        LongType = TRUE;
+      } else if (Format[Index] == '.') {
+        Precision = TRUE;
+      } else if ((Format[Index] != '-') && (Format[Index] != '+') && (Format[Index] != ' ') &&
+                 (Format[Index] != ',') && ((Format[Index] < '0') || (Format[Index] > '9')))
+      {
+        break;
+      }
+    }
+
+    if (!Result || (Format[Index] == '\0')) {
+      break;
+    }
+
+    if ((Format[Index] == '%') || (Format[Index] == '\n') || (Format[Index] == '\r')) {
+      continue;
+    }
+
+    if (ArgCount == ARRAY_SIZE (Args)) {
+      Result = FALSE;
+      break;
+    }
+
+    switch (Format[Index]) {
+      case 'p':
+        Args[ArgCount++] = (UINT64)(UINTN)VA_ARG (Marker, VOID *);
+        break;
+
+      case 'X':
+      case 'x':
+      case 'd':
+      case 'u':
+        if (LongType) {
+          Args[ArgCount++] = (UINT64)VA_ARG (Marker, INT64);
+        } else {
+          Args[ArgCount++] = (UINT32)VA_ARG (Marker, int);
+        }
+
+        break;
+
+      case 'c':
+        Args[ArgCount++] = VA_ARG (Marker, UINTN);
+        break;
+
+      case 'r':
+        //
+        // Keep the error bit of a 32 bit status in the high bit of the argument, so the
+        // status reads back the same way in a 64 bit reader.
+        //
+        Status = VA_ARG (Marker, UINTN);
+        if ((Status & MAX_BIT) != 0) {
+          Args[ArgCount++] = (Status & ~MAX_BIT) | BIT63;
+        } else {
+          Args[ArgCount++] = Status;
+        }
+
+        break;
+
+      case 'a':
+        Pointer = VA_ARG (Marker, CHAR8 *);
+        Result  = !Precision &&
+                  DebugCopyDeferredArg (
+                    Copies,
+                    sizeof (Copies),
+                    &CopiesLen,
+                    Pointer,
+                    (Pointer == NULL) ? 0 : AsciiStrSize (Pointer),
+                    &Args[ArgCount++]
+                    );
+        break;
+
+      case 's':
+      case 'S':
+        Pointer = VA_ARG (Marker, CHAR16 *);
+        Result  = !Precision &&
+                  DebugCopyDeferredArg (
+                    Copies,
+                    sizeof (Copies),
+                    &CopiesLen,
+                    Pointer,
+                    (Pointer == NULL) ? 0 : StrSize (Pointer),
+                    &Args[ArgCount++]
+                    );
+        break;
+
+      case 'g':
+        Pointer = VA_ARG (Marker, GUID *);
+        Result  = DebugCopyDeferredArg (Copies, sizeof (Copies), &CopiesLen, Pointer, sizeof (GUID), &Args[ArgCount++]);
+        break;
+
+      case 't':
+        Pointer = VA_ARG (Marker, EFI_TIME *);
+        Result  = DebugCopyDeferredArg (Copies, sizeof (Copies), &CopiesLen, Pointer, sizeof (EFI_TIME), &Args[ArgCount++]);
+        break;
+
+      default:
+        //
+        // Not a format the log readers know how to reproduce.
+        //
+        Result = FALSE;
+        break;
+    }
+  }
+
+  VA_END (Marker);
+
+  if (!Result || ((ArgCount * sizeof (UINT64)) + CopiesLen > sizeof (Args))) {
+    return FALSE;
+  }
+
+  //
+  // The copies follow the arguments, as the logger expects.
+  //
+  CopyMem (&Args[ArgCount], Copies, CopiesLen);
+
+  return !EFI_ERROR (AdvancedLoggerWriteDeferred (ErrorLevel, Format, (UINT8 *)Args, ArgCount * sizeof (UINT64) + CopiesLen));
+}
+
 /**
   Prints a debug message to the debug output device if the specified
   error level is enabled base on Null-terminated format string and a
@@ -159,6 +375,16 @@ DebugPrintMarker (
     return;
   }
 
+  //
+  // Log the message unformatted, and leave the formatting to the log readers.  Check that
+  // the logger takes the message before the arguments are parsed.
+  //
+  if (FeaturePcdGet (PcdAdvancedLoggerDeferredFormat) && (BaseListMarker == NULL) && AdvancedLoggerDeferredEnabled (ErrorLevel)) {
+    if (DebugPrintDeferred (ErrorLevel, Format, VaListMarker)) {
+      return;
+    }
+  }
+
   //
   // Convert the DEBUG() message to an ASCII String
   //
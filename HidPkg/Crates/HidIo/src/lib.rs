@@ -142,6 +142,36 @@ pub mod protocol {
     pub type HidIoUnregisterReportCallback =
         extern "efiapi" fn(this: *const Protocol, callback: HidIoReportCallback) -> Status;
 
+    /// Input report counters of a HID device, for diagnostics.
+    #[derive(Debug, Default, PartialEq, Eq, Clone, Copy)]
+    #[repr(C)]
+    pub struct HidIoReportStatistics {
+        /// Input reports received from the device.
+        pub reports_received: u64,
+        /// Reports merged into the newest report waiting for delivery.
+        pub reports_coalesced: u64,
+        /// Oldest waiting reports dropped because the report queue was full.
+        pub reports_dropped: u64,
+        /// Times input reports were restarted after a transfer error.
+        pub recoveries: u64,
+    }
+
+    /// Retrieves the input report counters of the device. The counters are kept from the time the device was started,
+    /// and are not reset when a report callback is unregistered.
+    ///
+    /// # Arguments
+    ///
+    /// * `this` - A pointer to the HidIo Instance
+    /// * `statistics` - Pointer to the buffer to receive the counters.
+    ///
+    /// # Return values
+    /// * `Status::SUCCESS` - Counters successfully returned.
+    /// * `Status::INVALID_PARAMETER` - Invalid input parameters.
+    /// * `Status::UNSUPPORTED` - The device driver does not keep input report counters.
+    ///
+    pub type HidIoGetReportStatistics =
+        extern "efiapi" fn(this: *const Protocol, statistics: *mut HidIoReportStatistics) -> Status;
+
     /// The HID_IO protocol provides a set of services for interacting with a HID device.
     #[repr(C)]
     pub struct Protocol {
@@ -150,5 +180,6 @@ pub mod protocol {
         pub set_report: HidIoSetReport,
         pub register_report_callback: HidIoRegisterReportCallback,
         pub unregister_report_callback: HidIoUnregisterReportCallback,
+        pub get_report_statistics: HidIoGetReportStatistics,
     }
 }
@@ -643,6 +643,97 @@ pub fn keyboard_layout_from_buffer(buffer: &[u8]) -> Result<HiiKeyboardLayout, L
     buffer.pread::<HiiKeyboardLayout>(0).map_err(LayoutError::ParseError)
 }
 
+/// Number of physical keys enumerated by [`EfiKey`].
+pub const EFI_KEY_COUNT: usize = EfiKey::Intl9 as usize + 1;
+
+/// Identifies a "non-spacing" key within a [`CompiledKeyboardLayout`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct NsKeyId(usize);
+
+/// Key descriptor lookup result from a [`CompiledKeyboardLayout`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum CompiledKey {
+    /// A normal key.
+    Key(HiiKeyDescriptor),
+    /// A "non-spacing" key; use [`CompiledKeyboardLayout::dependent_key`] to resolve the key that follows it.
+    NsKey(NsKeyId),
+}
+
+// A "non-spacing" key with its dependent keys indexed by EfiKey.
+#[derive(Debug, Clone, PartialEq, Eq)]
+struct CompiledNsKey {
+    ns_key: HiiNsKeyDescriptor,
+    dependent_keys: Vec<Option<HiiKeyDescriptor>>,
+}
+
+/// HII Keyboard Layout compiled for keystroke translation.
+/// Indexes the key descriptors of a [`HiiKeyboardLayout`] by [`EfiKey`], and the dependent keys of each "non-spacing"
+/// key the same way, so that translating a keystroke is a table lookup regardless of the size of the layout. Where the
+/// layout has more than one descriptor for a physical key the first one is used, as a scan of the layout would.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct CompiledKeyboardLayout {
+    layout: HiiKeyboardLayout,
+    keys: Vec<Option<CompiledKey>>,
+    ns_keys: Vec<CompiledNsKey>,
+}
+
+impl CompiledKeyboardLayout {
+    /// Builds the lookup tables for the given layout.
+    pub fn new(layout: HiiKeyboardLayout) -> Self {
+        let mut keys = vec![None; EFI_KEY_COUNT];
+        let mut ns_keys = Vec::new();
+
+        for key in &layout.keys {
+            match key {
+                HiiKey::Key(descriptor) => {
+                    keys[descriptor.key as usize].get_or_insert(CompiledKey::Key(*descriptor));
+                }
+                HiiKey::NsKey(ns_descriptor) => {
+                    let entry = &mut keys[ns_descriptor.descriptor.key as usize];
+                    if entry.is_some() {
+                        continue;
+                    }
+                    let mut dependent_keys = vec![None; EFI_KEY_COUNT];
+                    for descriptor in &ns_descriptor.dependent_keys {
+                        dependent_keys[descriptor.key as usize].get_or_insert(*descriptor);
+                    }
+                    *entry = Some(CompiledKey::NsKey(NsKeyId(ns_keys.len())));
+                    ns_keys.push(CompiledNsKey { ns_key: ns_descriptor.clone(), dependent_keys });
+                }
+            }
+        }
+
+        Self { layout, keys, ns_keys }
+    }
+
+    /// Returns the layout these tables were built from.
+    pub fn layout(&self) -> &HiiKeyboardLayout {
+        &self.layout
+    }
+
+    /// Returns the descriptor for the given physical key, if the layout defines one.
+    pub fn key(&self, key: EfiKey) -> Option<CompiledKey> {
+        self.keys[key as usize]
+    }
+
+    /// Returns the descriptor of the given "non-spacing" key.
+    pub fn ns_key(&self, ns_key: NsKeyId) -> &HiiNsKeyDescriptor {
+        &self.ns_keys[ns_key.0].ns_key
+    }
+
+    /// Returns the descriptor for the given physical key when it follows the given "non-spacing" key, if the
+    /// "non-spacing" key has a dependent key for it.
+    pub fn dependent_key(&self, ns_key: NsKeyId, key: EfiKey) -> Option<HiiKeyDescriptor> {
+        self.ns_keys[ns_key.0].dependent_keys[key as usize]
+    }
+}
+
+impl From<HiiKeyboardLayout> for CompiledKeyboardLayout {
+    fn from(layout: HiiKeyboardLayout) -> Self {
+        Self::new(layout)
+    }
+}
+
 #[cfg(test)]
 mod tests {
     extern crate std;
@@ -659,8 +750,8 @@ mod tests {
     use scroll::{Pread, Pwrite};
 
     use crate::{
-        get_default_keyboard_pkg, EfiKey, HiiKey, HiiKeyDescriptor, HiiKeyboardPkg, HiiKeyboardPkgList,
-        HiiNsKeyDescriptor,
+        get_default_keyboard_layout, get_default_keyboard_pkg, CompiledKey, CompiledKeyboardLayout, EfiKey, HiiKey,
+        HiiKeyDescriptor, HiiKeyboardLayout, HiiKeyboardPkg, HiiKeyboardPkgList, HiiNsKeyDescriptor, EFI_KEY_COUNT,
     };
 
     macro_rules! test_collateral {
@@ -777,4 +868,61 @@ mod tests {
 
         assert_eq!(pkg_list, deserialized_pkg_list);
     }
+
+    // Checks every physical key in the compiled layout against a scan of the layout it was built from.
+    fn check_compiled_layout(layout: &HiiKeyboardLayout) -> usize {
+        let compiled = CompiledKeyboardLayout::new(layout.clone());
+        assert_eq!(compiled.layout(), layout);
+
+        let mut ns_keys = 0;
+        for value in 0..EFI_KEY_COUNT as u32 {
+            let efi_key = EfiKey::try_from(value).unwrap();
+            let expected = layout.keys.iter().find(|key| match key {
+                HiiKey::Key(descriptor) => descriptor.key == efi_key,
+                HiiKey::NsKey(ns_descriptor) => ns_descriptor.descriptor.key == efi_key,
+            });
+            match (expected, compiled.key(efi_key)) {
+                (None, None) => (),
+                (Some(HiiKey::Key(expected)), Some(CompiledKey::Key(descriptor))) => assert_eq!(*expected, descriptor),
+                (Some(HiiKey::NsKey(expected)), Some(CompiledKey::NsKey(ns_key))) => {
+                    assert_eq!(compiled.ns_key(ns_key), expected);
+                    for value in 0..EFI_KEY_COUNT as u32 {
+                        let dependent_key = EfiKey::try_from(value).unwrap();
+                        let expected_dependent =
+                            expected.dependent_keys.iter().find(|descriptor| descriptor.key == dependent_key);
+                        assert_eq!(compiled.dependent_key(ns_key, dependent_key).as_ref(), expected_dependent);
+                    }
+                    ns_keys += 1;
+                }
+                mismatch => panic!("compiled layout mismatch for {:?}: {:?}", efi_key, mismatch),
+            }
+        }
+        ns_keys
+    }
+
+    #[test]
+    fn compiled_layout_should_match_layout_scan() {
+        assert_eq!(check_compiled_layout(&get_default_keyboard_layout()), 0);
+
+        let mut test_file = File::open(test_collateral!("KeyboardLayoutNs.bin")).expect("failed to open test file.");
+        let mut file_buffer = Vec::new();
+        test_file.read_to_end(&mut file_buffer).expect("failed to read test file");
+        let ns_file_pkg: HiiKeyboardPkg = file_buffer.pread(0).unwrap();
+
+        assert_eq!(check_compiled_layout(&ns_file_pkg.layouts[0]), 1);
+    }
+
+    #[test]
+    fn compiled_layout_should_use_first_descriptor_for_a_key() {
+        let mut layout = get_default_keyboard_layout();
+        let HiiKey::Key(original) = layout.keys[0] else { panic!("unexpected ns key in default layout") };
+
+        let mut duplicate = original;
+        duplicate.unicode = 'x' as u16;
+        layout.keys.push(HiiKey::Key(duplicate));
+        layout.keys.push(HiiKey::NsKey(HiiNsKeyDescriptor { descriptor: duplicate, dependent_keys: vec![] }));
+
+        let compiled = CompiledKeyboardLayout::new(layout);
+        assert_eq!(compiled.key(original.key), Some(CompiledKey::Key(original)));
+    }
 }
@@ -81,6 +81,11 @@ typedef struct _KEYBOARD_CONSOLE_IN_EX_NOTIFY {
 
 #define HID_NS_KEY_SIGNATURE  SIGNATURE_32 ('h', 'n', 's', 'k')
 
+//
+// Number of physical keys in EFI_KEY, used to size the tables indexed by EFI_KEY
+//
+#define NUMBER_OF_EFI_KEYS  (EfiKeyIntl9 + 1)
+
 typedef struct {
   UINTN                 Signature;
   LIST_ENTRY            Link;
@@ -95,6 +100,11 @@ typedef struct {
   // NsKey[1] ~ NsKey[KeyCount] : Physical keys
   //
   EFI_KEY_DESCRIPTOR    *NsKey;
+
+  //
+  // Index in NsKey of the first physical key for each EFI_KEY, 0 if there is none
+  //
+  UINT8                 PhysicalKeyIndex[NUMBER_OF_EFI_KEYS];
 } HID_NS_KEY;
 
 #define HID_NS_KEY_FORM_FROM_LINK(a)  CR (a, HID_NS_KEY, Link, HID_NS_KEY_SIGNATURE)
@@ -154,6 +164,7 @@ typedef struct {
   // Non-spacing key list
   //
   LIST_ENTRY                           NsKeyList;
+  HID_NS_KEY                           *NsKeyTable[NUMBER_OF_EFI_KEYS];
   HID_NS_KEY                           *CurrentNsKey;
   EFI_KEY_DESCRIPTOR                   *KeyConvertionTable;
   EFI_EVENT                            KeyboardLayoutEvent;
@@ -474,32 +474,20 @@ FindHidNsKey (
   IN EFI_KEY_DESCRIPTOR  *KeyDescriptor
   )
 {
-  LIST_ENTRY  *Link;
-  LIST_ENTRY  *NsKeyList;
-  HID_NS_KEY  *HidNsKey;
-
-  NsKeyList = &HidKeyboardDevice->NsKeyList;
-  Link      = GetFirstNode (NsKeyList);
-  while (!IsNull (NsKeyList, Link)) {
-    HidNsKey = HID_NS_KEY_FORM_FROM_LINK (Link);
-
-    if (HidNsKey->NsKey[0].Key == KeyDescriptor->Key) {
-      return HidNsKey;
-    }
-
-    Link = GetNextNode (NsKeyList, Link);
+  if ((UINTN)KeyDescriptor->Key >= NUMBER_OF_EFI_KEYS) {
+    return NULL;
   }
 
-  return NULL;
+  return HidKeyboardDevice->NsKeyTable[KeyDescriptor->Key];
 }
 
 /**
   Find physical key definition for a given key descriptor.
 
   For a specified non-spacing key, there are a list of physical
-  keys following it. This function traverses the list of
-  physical keys and tries to find the physical key matching
-  the KeyDescriptor.
+  keys following it. This function looks up the physical key
+  matching the KeyDescriptor in the index built for the
+  non-spacing key when the layout was loaded.
 
   @param  HidNsKey          The non-spacing key information.
   @param  KeyDescriptor     The key descriptor.
@@ -514,22 +502,21 @@ FindPhysicalKey (
   IN EFI_KEY_DESCRIPTOR  *KeyDescriptor
   )
 {
-  UINTN               Index;
-  EFI_KEY_DESCRIPTOR  *PhysicalKey;
+  UINT8  Index;
 
-  PhysicalKey = &HidNsKey->NsKey[1];
-  for (Index = 0; Index < HidNsKey->KeyCount; Index++) {
-    if (KeyDescriptor->Key == PhysicalKey->Key) {
-      return PhysicalKey;
-    }
+  if ((UINTN)KeyDescriptor->Key >= NUMBER_OF_EFI_KEYS) {
+    return KeyDescriptor;
+  }
 
-    PhysicalKey++;
+  Index = HidNsKey->PhysicalKeyIndex[KeyDescriptor->Key];
+  if (Index == 0) {
+    //
+    // No children definition matched, return original key
+    //
+    return KeyDescriptor;
   }
 
-  //
-  // No children definition matched, return original key
-  //
-  return KeyDescriptor;
+  return &HidNsKey->NsKey[Index];
 }
 
 /**
@@ -649,8 +636,34 @@ SetKeyboardLayoutEvent (
                               (KeyCount + 1) * sizeof (EFI_KEY_DESCRIPTOR),
                               KeyDescriptor
                               );
+      if (HidNsKey->NsKey == NULL) {
+        ASSERT (HidNsKey->NsKey != NULL);
+        FreePool (HidNsKey);
+        ReleaseKeyboardLayoutResources (HidKeyboardDevice);
+        FreePool (KeyboardLayout);
+        return;
+      }
+
       InsertTailList (&HidKeyboardDevice->NsKeyList, &HidNsKey->Link);
 
+      //
+      // Index the non-spacing key and its physical keys by EFI_KEY, so that key
+      // translation does not have to search them. The first definition wins.
+      //
+      for (Index2 = 1; (Index2 <= KeyCount) && (Index2 <= MAX_UINT8); Index2++) {
+        if (((UINTN)HidNsKey->NsKey[Index2].Key < NUMBER_OF_EFI_KEYS) &&
+            (HidNsKey->PhysicalKeyIndex[HidNsKey->NsKey[Index2].Key] == 0))
+        {
+          HidNsKey->PhysicalKeyIndex[HidNsKey->NsKey[Index2].Key] = (UINT8)Index2;
+        }
+      }
+
+      if (((UINTN)HidNsKey->NsKey[0].Key < NUMBER_OF_EFI_KEYS) &&
+          (HidKeyboardDevice->NsKeyTable[HidNsKey->NsKey[0].Key] == NULL))
+      {
+        HidKeyboardDevice->NsKeyTable[HidNsKey->NsKey[0].Key] = HidNsKey;
+      }
+
       //
       // Skip over the child physical keys
       //
@@ -700,6 +713,12 @@ ReleaseKeyboardLayoutResources (
 
   HidKeyboardDevice->KeyConvertionTable = NULL;
 
+  //
+  // The non-spacing keys are freed below, so drop the references to them.
+  //
+  ZeroMem (HidKeyboardDevice->NsKeyTable, sizeof (HidKeyboardDevice->NsKeyTable));
+  HidKeyboardDevice->CurrentNsKey = NULL;
+
   while (!IsListEmpty (&HidKeyboardDevice->NsKeyList)) {
     Link     = GetFirstNode (&HidKeyboardDevice->NsKeyList);
     HidNsKey = HID_NS_KEY_FORM_FROM_LINK (Link);
@@ -96,6 +96,9 @@ EFI_STATUS
 /**
   Report received callback function.
 
+  The callback is invoked at TPL_CALLBACK, with the reports in the order they were received. ReportBuffer is only
+  valid until the callback returns. The callback may unregister itself.
+
   @param  ReportBufferSize      Indicates the size of the provided buffer holding the received report.
   @param  ReportBuffer          Pointer to the buffer holding the report.
   @param  Context               Context provided when the callback was registered.
@@ -150,12 +153,43 @@ EFI_STATUS
   IN HID_IO_REPORT_CALLBACK Callback
   );
 
+//
+// Input report counters of a HID device, for diagnostics.
+//
+typedef struct {
+  UINT64    ReportsReceived;                        // Input reports received from the device.
+  UINT64    ReportsCoalesced;                       // Reports merged into the newest report waiting for delivery.
+  UINT64    ReportsDropped;                         // Oldest waiting reports dropped because the report queue was full.
+  UINT64    Recoveries;                             // Times input reports were restarted after a transfer error.
+} HID_IO_REPORT_STATISTICS;
+
+/**
+  Retrieves the input report counters of the device.
+
+  The counters are kept from the time the device was started, and are not reset when a report callback is
+  unregistered.
+
+  @param  This                  A pointer to the HidIo Instance
+  @param  Statistics            Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS           Counters successfully returned.
+  @retval EFI_INVALID_PARAMETER Invalid input parameters.
+  @retval EFI_UNSUPPORTED       The device driver does not keep input report counters.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *HID_IO_GET_REPORT_STATISTICS)(
+  IN HID_IO_PROTOCOL *This,
+  OUT HID_IO_REPORT_STATISTICS *Statistics
+  );
+
 struct _HID_IO_PROTOCOL {
   HID_IO_GET_REPORT_DESCRIPTOR         GetReportDescriptor;
   HID_IO_GET_REPORT                    GetReport;
   HID_IO_SET_REPORT                    SetReport;
   HID_IO_REGISTER_REPORT_CALLBACK      RegisterReportCallback;
   HID_IO_UNREGISTER_REPORT_CALLBACK    UnregisterReportCallback;
+  HID_IO_GET_REPORT_STATISTICS         GetReportStatistics;
 };
 
 #endif
@@ -344,12 +344,23 @@ mod test {
             efi::Status::SUCCESS
         }
 
+        extern "efiapi" fn mock_get_report_statistics(
+            this: *const hid_io::protocol::Protocol,
+            statistics: *mut hid_io::protocol::HidIoReportStatistics,
+        ) -> efi::Status {
+            assert_ne!(this, ptr::null());
+            assert_ne!(statistics, ptr::null_mut());
+            unsafe { statistics.write(Default::default()) };
+            efi::Status::SUCCESS
+        }
+
         hid_io::protocol::Protocol {
             get_report_descriptor: mock_get_report_descriptor,
             get_report: mock_get_report,
             set_report: mock_set_report,
             register_report_callback: mock_register_report_callback,
             unregister_report_callback: mock_unregister_report_callback,
+            get_report_statistics: mock_get_report_statistics,
         }
     }
 
@@ -13,13 +13,8 @@ mod key_queue;
 mod simple_text_in;
 mod simple_text_in_ex;
 
-use alloc::{
-    boxed::Box,
-    collections::{BTreeMap, BTreeSet},
-    vec,
-    vec::Vec,
-};
-use core::{ffi::c_void, ptr};
+use alloc::{boxed::Box, collections::BTreeMap, vec, vec::Vec};
+use core::{ffi::c_void, mem, ptr};
 
 use r_efi::{efi, hii, protocols};
 
@@ -33,7 +28,7 @@ use rust_advanced_logger_dxe::{debugln, DEBUG_ERROR, DEBUG_VERBOSE, DEBUG_WARN};
 use crate::{
     boot_services::UefiBootServices,
     hid_io::{HidIo, HidReportReceiver},
-    keyboard::key_queue::OrdKeyData,
+    keyboard::key_queue::{LedMask, OrdKeyData},
 };
 
 // usages supported by this module
@@ -44,18 +39,22 @@ const KEYBOARD_USAGE_MAX: u32 = 0x00070065;
 const LED_USAGE_MIN: u32 = 0x00080001;
 const LED_USAGE_MAX: u32 = 0x00080005;
 
+// usage page for keyboard key codes (including modifiers); key state is tracked for the usages in this page only.
+const KEYBOARD_USAGE_PAGE: u32 = 0x0007;
+const KEYBOARD_USAGE_IDS: usize = 256;
+
 // maps a given field to a routine that handles input from it.
 #[derive(Debug, Clone)]
 struct ReportFieldWithHandler<T> {
     field: T,
-    report_handler: fn(handler: &mut KeyboardHidHandler, field: T, report: &[u8]),
+    report_handler: fn(handler: &mut KeyboardHidHandler, field: &T, report: &[u8]),
 }
 
 // maps a given field to a routine that builds output reports from it.
 #[derive(Debug, Clone)]
 struct ReportFieldBuilder<T> {
     field: T,
-    field_builder: fn(&mut KeyboardHidHandler, field: T, report: &mut [u8]),
+    field_builder: fn(handler: &KeyboardHidHandler, field: &T, report: &mut [u8]),
 }
 
 // Defines an input report and the fields of interest in it.
@@ -75,6 +74,77 @@ struct KeyboardOutputReportBuilder {
     relevant_variable_fields: Vec<ReportFieldBuilder<VariableField>>,
 }
 
+// Fixed-size set of keyboard page usages, one bit per usage ID. Key state is rebuilt for every input report, so it is
+// kept in a bitmap rather than a collection that allocates on insert.
+#[derive(Debug, Default, Clone, Copy, PartialEq, Eq)]
+struct KeyUsageSet([u64; KEYBOARD_USAGE_IDS / 64]);
+
+impl KeyUsageSet {
+    // Returns the word index and bit mask for the given usage, or None if it is not a keyboard page usage.
+    fn bit(usage: Usage) -> Option<(usize, u64)> {
+        let usage = u32::from(usage);
+        let id = (usage & 0xFFFF) as usize;
+        if (usage >> 16) != KEYBOARD_USAGE_PAGE || id >= KEYBOARD_USAGE_IDS {
+            return None;
+        }
+        Some((id / 64, 1 << (id % 64)))
+    }
+
+    fn clear(&mut self) {
+        self.0 = Default::default();
+    }
+
+    #[cfg(test)]
+    fn is_empty(&self) -> bool {
+        self.0.iter().all(|word| *word == 0)
+    }
+
+    // Adds the usage to the set. Usages outside the keyboard page are ignored, as the key queue does not handle them.
+    fn insert(&mut self, usage: Usage) {
+        if let Some((word, mask)) = Self::bit(usage) {
+            self.0[word] |= mask;
+        }
+    }
+
+    // Returns the set of usages that are in self but not in `other`.
+    fn difference(&self, other: &Self) -> Self {
+        let mut difference = *self;
+        for (word, other_word) in difference.0.iter_mut().zip(other.0.iter()) {
+            *word &= !other_word;
+        }
+        difference
+    }
+
+    // Returns an iterator over the usages in the set, from the highest usage to the lowest.
+    fn iter_rev(self) -> KeyUsageIterRev {
+        KeyUsageIterRev { set: self, word: self.0.len() }
+    }
+}
+
+// Iterator over a KeyUsageSet from the highest usage to the lowest. Consumes its own copy of the set.
+struct KeyUsageIterRev {
+    set: KeyUsageSet,
+    word: usize,
+}
+
+impl Iterator for KeyUsageIterRev {
+    type Item = Usage;
+
+    fn next(&mut self) -> Option<Usage> {
+        while self.word > 0 {
+            let bits = &mut self.set.0[self.word - 1];
+            if *bits != 0 {
+                let bit = u64::BITS - 1 - bits.leading_zeros();
+                *bits &= !(1 << bit);
+                let id = (self.word - 1) as u32 * u64::BITS + bit;
+                return Some(Usage::from((KEYBOARD_USAGE_PAGE << 16) | id));
+            }
+            self.word -= 1;
+        }
+        None
+    }
+}
+
 #[repr(C)]
 struct LayoutChangeContext {
     boot_services: &'static dyn UefiBootServices,
@@ -89,9 +159,9 @@ pub struct KeyboardHidHandler {
     input_reports: BTreeMap<Option<ReportId>, KeyboardReportData>,
     output_builders: Vec<KeyboardOutputReportBuilder>,
     report_id_present: bool,
-    last_keys: BTreeSet<Usage>,
-    current_keys: BTreeSet<Usage>,
-    led_state: BTreeSet<Usage>,
+    last_keys: KeyUsageSet,
+    current_keys: KeyUsageSet,
+    led_state: LedMask,
     key_queue: key_queue::KeyQueue,
     notification_callbacks: BTreeMap<usize, (OrdKeyData, protocols::simple_text_input_ex::KeyNotifyFunction)>,
     next_notify_handle: usize,
@@ -110,9 +180,9 @@ impl KeyboardHidHandler {
             input_reports: BTreeMap::new(),
             output_builders: Vec::new(),
             report_id_present: false,
-            last_keys: BTreeSet::new(),
-            current_keys: BTreeSet::new(),
-            led_state: BTreeSet::new(),
+            last_keys: KeyUsageSet::default(),
+            current_keys: KeyUsageSet::default(),
+            led_state: 0,
             key_queue: Default::default(),
             notification_callbacks: BTreeMap::new(),
             next_notify_handle: 0,
@@ -215,15 +285,15 @@ impl KeyboardHidHandler {
     }
 
     // Helper routine to handle variable keyboard input report fields
-    fn handle_variable_key(&mut self, field: VariableField, report: &[u8]) {
+    fn handle_variable_key(&mut self, field: &VariableField, report: &[u8]) {
         match field.field_value(report) {
-            Some(x) if x != 0 => _ = self.current_keys.insert(field.usage),
+            Some(x) if x != 0 => self.current_keys.insert(field.usage),
             _ => (),
         }
     }
 
     // Helper routine to handle array keyboard input report fields
-    fn handle_array_key(&mut self, field: ArrayField, report: &[u8]) {
+    fn handle_array_key(&mut self, field: &ArrayField, report: &[u8]) {
         match field.field_value(report) {
             Some(index) if index != 0 => {
                 let mut index = (index as u32 - u32::from(field.logical_minimum)) as usize;
@@ -246,8 +316,10 @@ impl KeyboardHidHandler {
 
     // Helper routine that updates the fields in the given report buffer for the given field (called for each field for
     // every LED usage that was discovered in the output report descriptor).
-    fn build_led_report(&mut self, field: VariableField, report: &mut [u8]) {
-        let status = field.set_field_value(self.led_state.contains(&field.usage).into(), report);
+    fn build_led_report(&self, field: &VariableField, report: &mut [u8]) {
+        // LED fields are only registered for usages in LED_USAGE_MIN..=LED_USAGE_MAX, so the usage ID fits the mask.
+        let led = 1 << (u32::from(field.usage) & 0xFFFF);
+        let status = field.set_field_value(((self.led_state & led) != 0).into(), report);
         if status.is_err() {
             debugln!(DEBUG_WARN, "{:}: failed to set field value: {:?}", function!(), status);
         }
@@ -255,16 +327,17 @@ impl KeyboardHidHandler {
 
     // Generates LED output reports - usually there is only one, but this implementation handles an arbitrary number of
     // possible output reports. If more than one output report is defined, all will be sent whenever there is a change in
-    // LEDs.
+    // LEDs. Returns an empty (unallocated) vector if the LED state has not changed, which is the case for nearly every
+    // keystroke.
     fn generate_led_output_reports(&mut self) -> Vec<(Option<ReportId>, Vec<u8>)> {
         let mut output_vec = Vec::new();
-        let current_leds: BTreeSet<Usage> = self.key_queue.active_leds().iter().cloned().collect();
+        let current_leds = self.key_queue.active_leds();
         if current_leds != self.led_state {
             self.led_state = current_leds;
-            for output_builder in self.output_builders.clone() {
+            for output_builder in &self.output_builders {
                 let mut report_buffer = vec![0u8; output_builder.report_size];
                 for field_builder in &output_builder.relevant_variable_fields {
-                    (field_builder.field_builder)(self, field_builder.field.clone(), report_buffer.as_mut_slice());
+                    (field_builder.field_builder)(self, &field_builder.field, report_buffer.as_mut_slice());
                 }
                 output_vec.push((output_builder.report_id, report_buffer));
             }
@@ -395,6 +468,89 @@ impl KeyboardHidHandler {
         Ok(())
     }
 
+    // Hands an input report to the field handlers and passes any key presses and releases to the key queue. Returns true
+    // if the key state changed. This runs at TPL_NOTIFY for every interrupt report, so the field tables are borrowed
+    // rather than cloned and the key state is kept in fixed bitmaps; nothing here allocates.
+    fn process_input_report(&mut self, report: &[u8]) -> bool {
+        if report.is_empty() {
+            return false;
+        }
+        // determine whether report includes report id byte and adjust the buffer as needed.
+        let (report_id, report) = match self.report_id_present {
+            true => (Some(ReportId::from(&report[0..1])), &report[1..]),
+            false => (None, &report[0..]),
+        };
+
+        if report.is_empty() {
+            return false;
+        }
+
+        // the handlers take &mut self, so move the field tables out of self while they are walked. An empty BTreeMap
+        // does not allocate.
+        let input_reports = mem::take(&mut self.input_reports);
+        let dispatched = match input_reports.get(&report_id) {
+            Some(report_data) => {
+                if report.len() != report_data.report_size {
+                    //Some devices report extra bytes in their reports. Warn about this, but try and process anyway.
+                    debugln!(
+                        DEBUG_VERBOSE,
+                        "{:?}:{:?} unexpected report length for report_id: {:?}. expected {:?}, actual {:?}",
+                        function!(),
+                        line!(),
+                        report_id,
+                        report_data.report_size,
+                        report.len()
+                    );
+                    debugln!(DEBUG_VERBOSE, "report: {:x?}", report);
+                }
+
+                //reset currently active keys to empty set.
+                self.current_keys.clear();
+
+                // hand the report data to the handler for each relevant field for field-specific processing.
+                for field in &report_data.relevant_variable_fields {
+                    (field.report_handler)(self, &field.field, report);
+                }
+
+                for field in &report_data.relevant_array_fields {
+                    (field.report_handler)(self, &field.field, report);
+                }
+                true
+            }
+            None => false,
+        };
+        self.input_reports = input_reports;
+
+        if !dispatched {
+            return false;
+        }
+
+        //check if any key state has changed.
+        let keys_changed = self.last_keys != self.current_keys;
+        if keys_changed {
+            // process keys that are not in both sets: that is the set of keys that have changed.
+
+            // Modifier keys need to be processed first so that normal key processing includes modifiers that showed up in
+            // the same report. Modifier keys all have higher usages than normal keys - so iterate the key sets from the
+            // highest usage down to process the modifier keys first. In addition, all released keys should be processed
+            // first so that pressed keys (which typically generate key stroke events) have the most recent key state
+            // associated with them.
+            for key in self.last_keys.difference(&self.current_keys).iter_rev() {
+                //In the last key set, but not in current. This is a key release.
+                self.key_queue.keystroke(key, key_queue::KeyAction::KeyUp);
+            }
+            for key in self.current_keys.difference(&self.last_keys).iter_rev() {
+                //In the current key set, but not in last. This is a key press.
+                self.key_queue.keystroke(key, key_queue::KeyAction::KeyDown);
+            }
+        }
+
+        //after all key handling is complete for this report, the current key set becomes the last key set. The stale set
+        //swapped into current_keys is cleared when the next report arrives.
+        mem::swap(&mut self.last_keys, &mut self.current_keys);
+        keys_changed
+    }
+
     /// Resets the keyboard driver state. Clears any pending key state. `extended verification` will also reset toggle
     /// state.
     pub fn reset(&mut self, hid_io: &dyn HidIo, extended_verification: bool) -> Result<(), efi::Status> {
@@ -533,87 +689,15 @@ impl HidReportReceiver for KeyboardHidHandler {
         let old_tpl = self.boot_services.raise_tpl(efi::TPL_NOTIFY);
 
         let mut output_reports = Vec::new();
-        'report_processing: {
-            if report.is_empty() {
-                break 'report_processing;
-            }
-            // determine whether report includes report id byte and adjust the buffer as needed.
-            let (report_id, report) = match self.report_id_present {
-                true => (Some(ReportId::from(&report[0..1])), &report[1..]),
-                false => (None, &report[0..]),
-            };
-
-            if report.is_empty() {
-                break 'report_processing;
+        if self.process_input_report(report) {
+            //after processing all the key strokes, check if any keys were pressed that should trigger the notifier callback
+            //and if so, signal the event to trigger notify processing at the appropriate TPL.
+            if self.key_queue.peek_notify_key().is_some() {
+                self.boot_services.signal_event(self.key_notify_event);
             }
 
-            if let Some(report_data) = self.input_reports.get(&report_id).cloned() {
-                if report.len() != report_data.report_size {
-                    //Some devices report extra bytes in their reports. Warn about this, but try and process anyway.
-                    debugln!(
-                        DEBUG_VERBOSE,
-                        "{:?}:{:?} unexpected report length for report_id: {:?}. expected {:?}, actual {:?}",
-                        function!(),
-                        line!(),
-                        report_id,
-                        report_data.report_size,
-                        report.len()
-                    );
-                    debugln!(DEBUG_VERBOSE, "report: {:x?}", report);
-                }
-
-                //reset currently active keys to empty set.
-                self.current_keys.clear();
-
-                // hand the report data to the handler for each relevant field for field-specific processing.
-                for field in report_data.relevant_variable_fields {
-                    (field.report_handler)(self, field.field, report);
-                }
-
-                for field in report_data.relevant_array_fields {
-                    (field.report_handler)(self, field.field, report);
-                }
-
-                //check if any key state has changed.
-                if self.last_keys != self.current_keys {
-                    // process keys that are not in both sets: that is the set of keys that have changed.
-                    // XOR on the sets yields a set of keys that are in either last or current keys, but not both.
-
-                    // Modifier keys need to be processed first so that normal key processing includes modifiers that showed up in
-                    // the same report. The key sets are sorted by Usage, and modifier keys all have higher usages than normal keys
-                    // - so use a reverse iterator to process the modifier keys first. In addition, all released keys should be
-                    // processed first so that pressed keys (which typically generate key stroke events) have the most recent
-                    // key state associated with them.
-                    let mut released_keys = Vec::new();
-                    let mut pressed_keys = Vec::new();
-                    for changed_key in (&self.last_keys ^ &self.current_keys).into_iter().rev() {
-                        if self.last_keys.contains(&changed_key) {
-                            //In the last key list, but not in current. This is a key release.
-                            released_keys.push(changed_key);
-                        } else {
-                            //Not in last, so must be in current. This is a key press.
-                            pressed_keys.push(changed_key);
-                        }
-                    }
-                    for key in released_keys {
-                        self.key_queue.keystroke(key, key_queue::KeyAction::KeyUp);
-                    }
-                    for key in pressed_keys {
-                        self.key_queue.keystroke(key, key_queue::KeyAction::KeyDown);
-                    }
-
-                    //after processing all the key strokes, check if any keys were pressed that should trigger the notifier callback
-                    //and if so, signal the event to trigger notify processing at the appropriate TPL.
-                    if self.key_queue.peek_notify_key().is_some() {
-                        self.boot_services.signal_event(self.key_notify_event);
-                    }
-
-                    //after processing all the key strokes, send updated LED state if required.
-                    output_reports = self.generate_led_output_reports();
-                }
-                //after all key handling is complete for this report, update the last key set to match the current key set.
-                self.last_keys = self.current_keys.clone();
-            }
+            //after processing all the key strokes, send updated LED state if required.
+            output_reports = self.generate_led_output_reports();
         }
 
         self.boot_services.restore_tpl(old_tpl);
@@ -730,6 +814,7 @@ mod test {
 
     use core::{ffi::c_void, mem::MaybeUninit, slice::from_raw_parts_mut};
 
+    use hidparser::report_data_types::Usage;
     use hii_keyboard_layout::HiiKeyboardLayout;
     use r_efi::{efi, hii, protocols};
     use scroll::Pwrite;
@@ -737,7 +822,8 @@ mod test {
     use crate::{
         boot_services::MockUefiBootServices,
         hid_io::{HidReportReceiver, MockHidIo},
-        keyboard::{key_queue::OrdKeyData, on_layout_update, KeyboardHidHandler, LayoutChangeContext},
+        keyboard::{key_queue::OrdKeyData, on_layout_update, KeyUsageSet, KeyboardHidHandler, LayoutChangeContext},
+        test_allocator::count_allocations,
     };
 
     static BOOT_KEYBOARD_REPORT_DESCRIPTOR: &[u8] = &[
@@ -1122,8 +1208,8 @@ mod test {
         let report: &[u8] = &[0x00, 0x00, 0x39, 0x04, 0x05, 0x06, 0x00, 0x00];
         keyboard_handler.receive_report(report, &hid_io);
         assert!(keyboard_handler.key_queue.peek_key().is_some());
-        assert!(!keyboard_handler.led_state.is_empty());
-        let prev_led_state = keyboard_handler.led_state.clone();
+        assert_ne!(keyboard_handler.led_state, 0);
+        let prev_led_state = keyboard_handler.led_state;
         assert!(!keyboard_handler.last_keys.is_empty());
 
         let hid_io = MockHidIo::new();
@@ -1140,7 +1226,7 @@ mod test {
         });
 
         keyboard_handler.reset(&hid_io, true).unwrap();
-        assert!(keyboard_handler.led_state.is_empty());
+        assert_eq!(keyboard_handler.led_state, 0);
     }
 
     #[test]
@@ -1341,4 +1427,131 @@ mod test {
         assert!(callback_key_data.is_none());
         assert!(callbacks.is_empty());
     }
+
+    #[test]
+    fn key_usage_set_should_iterate_changed_keys_from_highest_usage() {
+        let mut last_keys = KeyUsageSet::default();
+        let mut current_keys = KeyUsageSet::default();
+        assert!(current_keys.is_empty());
+
+        // 'a' held, CapsLock and LeftCtrl released, 'b' and LeftShift pressed. Non-keyboard usages are ignored.
+        for usage in [0x00070004, 0x00070039, 0x000700E0] {
+            last_keys.insert(Usage::from(usage));
+        }
+        for usage in [0x00070004, 0x00070005, 0x000700E1, 0x00080001, 0x00070100] {
+            current_keys.insert(Usage::from(usage));
+        }
+
+        let released: Vec<u32> = last_keys.difference(&current_keys).iter_rev().map(u32::from).collect();
+        let pressed: Vec<u32> = current_keys.difference(&last_keys).iter_rev().map(u32::from).collect();
+        assert_eq!(released, [0x000700E0, 0x00070039]);
+        assert_eq!(pressed, [0x000700E1, 0x00070005]);
+
+        current_keys.clear();
+        assert!(current_keys.is_empty());
+        assert_eq!(current_keys.iter_rev().next(), None);
+    }
+
+    #[test]
+    fn keyboard_report_processing_should_not_allocate() {
+        let boot_services = create_fake_static_boot_service();
+        boot_services.expect_create_event().returning(|_, _, _, _, _| efi::Status::SUCCESS);
+        boot_services.expect_create_event_ex().returning(|_, _, _, _, _, _| efi::Status::SUCCESS);
+        boot_services.expect_install_protocol_interface().returning(|_, _, _, _| efi::Status::SUCCESS);
+        boot_services.expect_locate_protocol().returning(|_, _, _| efi::Status::NOT_FOUND);
+        boot_services.expect_signal_event().returning(|_| efi::Status::SUCCESS);
+        boot_services.expect_open_protocol().returning(|_, _, _, _, _, _| efi::Status::NOT_FOUND);
+        boot_services.expect_raise_tpl().returning(|_| efi::TPL_APPLICATION);
+        boot_services.expect_restore_tpl().returning(|_| ());
+
+        let mut keyboard_handler = KeyboardHidHandler::new(boot_services, 1 as efi::Handle);
+        let mut hid_io = MockHidIo::new();
+        hid_io
+            .expect_get_report_descriptor()
+            .returning(|| Ok(hidparser::parse_report_descriptor(&BOOT_KEYBOARD_REPORT_DESCRIPTOR).unwrap()));
+
+        keyboard_handler.key_queue.set_layout(Some(hii_keyboard_layout::get_default_keyboard_layout()));
+        keyboard_handler.initialize(2 as efi::Handle, &hid_io).unwrap();
+
+        let press_a: &[u8] = &[0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00];
+        let press_a_b: &[u8] = &[0x00, 0x00, 0x04, 0x05, 0x00, 0x00, 0x00, 0x00];
+        let press_shift_a: &[u8] = &[0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00];
+        let release: &[u8] = &[0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00];
+
+        // the first keystrokes grow the key queue; after that it reuses its capacity.
+        keyboard_handler.process_input_report(press_a_b);
+        keyboard_handler.process_input_report(release);
+        while keyboard_handler.key_queue.pop_key().is_some() {}
+
+        let ((), allocations) = count_allocations(|| {
+            for _ in 0..100 {
+                assert!(keyboard_handler.process_input_report(press_a));
+                assert!(!keyboard_handler.process_input_report(press_a));
+                assert!(keyboard_handler.process_input_report(press_a_b));
+                assert!(!keyboard_handler.process_input_report(press_a_b));
+                assert!(keyboard_handler.process_input_report(release));
+                assert_eq!(keyboard_handler.key_queue.pop_key().unwrap().key.unicode_char, 'a' as u16);
+                assert_eq!(keyboard_handler.key_queue.pop_key().unwrap().key.unicode_char, 'b' as u16);
+
+                // modifier state is tracked without allocation, and unchanged LEDs don't build output reports.
+                assert!(keyboard_handler.process_input_report(press_shift_a));
+                assert!(keyboard_handler.process_input_report(release));
+                assert_eq!(keyboard_handler.key_queue.pop_key().unwrap().key.unicode_char, 'A' as u16);
+                assert!(keyboard_handler.generate_led_output_reports().is_empty());
+            }
+        });
+        assert_eq!(allocations, 0);
+    }
+
+    // Measures the cost of input report dispatch. Run with:
+    // cargo test -p UefiHidDxeV2 --release keyboard_report_benchmark -- --ignored --nocapture
+    #[test]
+    #[ignore]
+    fn keyboard_report_benchmark() {
+        let boot_services = create_fake_static_boot_service();
+        boot_services.expect_create_event().returning(|_, _, _, _, _| efi::Status::SUCCESS);
+        boot_services.expect_create_event_ex().returning(|_, _, _, _, _, _| efi::Status::SUCCESS);
+        boot_services.expect_install_protocol_interface().returning(|_, _, _, _| efi::Status::SUCCESS);
+        boot_services.expect_locate_protocol().returning(|_, _, _| efi::Status::NOT_FOUND);
+        boot_services.expect_signal_event().returning(|_| efi::Status::SUCCESS);
+        boot_services.expect_open_protocol().returning(|_, _, _, _, _, _| efi::Status::NOT_FOUND);
+        boot_services.expect_raise_tpl().returning(|_| efi::TPL_APPLICATION);
+        boot_services.expect_restore_tpl().returning(|_| ());
+
+        let mut keyboard_handler = KeyboardHidHandler::new(boot_services, 1 as efi::Handle);
+        let mut hid_io = MockHidIo::new();
+        hid_io
+            .expect_get_report_descriptor()
+            .returning(|| Ok(hidparser::parse_report_descriptor(&BOOT_KEYBOARD_REPORT_DESCRIPTOR).unwrap()));
+
+        keyboard_handler.key_queue.set_layout(Some(hii_keyboard_layout::get_default_keyboard_layout()));
+        keyboard_handler.initialize(2 as efi::Handle, &hid_io).unwrap();
+
+        // a typing pattern: key down, held for a few reports (typematic reports repeat the same keys), key up.
+        let reports: [&[u8]; 8] = [
+            &[0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00],
+            &[0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00],
+            &[0x00, 0x00, 0x04, 0x05, 0x00, 0x00, 0x00, 0x00],
+            &[0x00, 0x00, 0x04, 0x05, 0x00, 0x00, 0x00, 0x00],
+            &[0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00],
+            &[0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00],
+            &[0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00],
+            &[0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00],
+        ];
+
+        const ITERATIONS: usize = 250_000;
+        let start = std::time::Instant::now();
+        for _ in 0..ITERATIONS {
+            for report in reports {
+                core::hint::black_box(keyboard_handler.process_input_report(core::hint::black_box(report)));
+            }
+            while keyboard_handler.key_queue.pop_key().is_some() {}
+        }
+        let elapsed = start.elapsed();
+        println!(
+            "keyboard: {} reports, {:.1} ns/report",
+            ITERATIONS * reports.len(),
+            elapsed.as_nanos() as f64 / (ITERATIONS * reports.len()) as f64
+        );
+    }
 }
@@ -9,13 +9,10 @@
 //! SPDX-License-Identifier: BSD-2-Clause-Patent
 //!
 
-use alloc::{
-    collections::{BTreeSet, VecDeque},
-    vec::Vec,
-};
+use alloc::collections::{BTreeMap, BTreeSet, VecDeque};
 use core::{ops::Deref, sync::atomic::Ordering};
 use hidparser::report_data_types::Usage;
-use hii_keyboard_layout::{EfiKey, HiiKey, HiiKeyboardLayout, HiiNsKeyDescriptor};
+use hii_keyboard_layout::{CompiledKey, CompiledKeyboardLayout, EfiKey, HiiKeyboardLayout, NsKeyId};
 use r_efi::{
     efi,
     protocols::{self, hii_database::*, simple_text_input::InputKey, simple_text_input_ex::*},
@@ -40,6 +37,46 @@ const CTRL_MODIFIERS: &[u16] = &[LEFT_CONTROL_MODIFIER, RIGHT_CONTROL_MODIFIER];
 const SHIFT_MODIFIERS: &[u16] = &[LEFT_SHIFT_MODIFIER, RIGHT_SHIFT_MODIFIER];
 const ALT_MODIFIERS: &[u16] = &[LEFT_ALT_MODIFIER, RIGHT_ALT_MODIFIER];
 
+// Modifiers that drive a keyboard LED, and the LED page usage ID of that LED.
+const LED_MODIFIERS: &[(u16, u32)] =
+    &[(NUM_LOCK_MODIFIER, 0x0001), (CAPS_LOCK_MODIFIER, 0x0002), (SCROLL_LOCK_MODIFIER, 0x0003)];
+
+// Active modifier state is kept as a mask with one bit per EFI modifier value, so that the modifier classes above can
+// be tested with a single AND on each keystroke rather than a set lookup per member.
+type ModifierMask = u64;
+
+const KEYBOARD_MODIFIER_MASK: ModifierMask = modifier_mask(KEYBOARD_MODIFIERS);
+const TOGGLE_MODIFIER_MASK: ModifierMask = modifier_mask(TOGGLE_MODIFIERS);
+const CTRL_MODIFIER_MASK: ModifierMask = modifier_mask(CTRL_MODIFIERS);
+const SHIFT_MODIFIER_MASK: ModifierMask = modifier_mask(SHIFT_MODIFIERS);
+const ALT_MODIFIER_MASK: ModifierMask = modifier_mask(ALT_MODIFIERS);
+const LED_MODIFIER_MASK: ModifierMask = modifier_mask(&[NUM_LOCK_MODIFIER, CAPS_LOCK_MODIFIER, SCROLL_LOCK_MODIFIER]);
+
+/// Set of keyboard LEDs, with bit n set if the LED with LED page usage ID n (e.g. 0x0001 for Num Lock) is lit.
+pub(crate) type LedMask = u32;
+
+// Returns the bit for the given modifier in a ModifierMask. Modifiers that don't fit in the mask are never tracked.
+const fn modifier_bit(modifier: u16) -> ModifierMask {
+    if (modifier as u32) < ModifierMask::BITS {
+        1 << modifier
+    } else {
+        0
+    }
+}
+
+// Builds a ModifierMask for the given modifiers. Evaluated at compile time, so a tracked modifier that does not fit in
+// the mask fails the build.
+const fn modifier_mask(modifiers: &[u16]) -> ModifierMask {
+    let mut mask = 0;
+    let mut index = 0;
+    while index < modifiers.len() {
+        assert!((modifiers[index] as u32) < ModifierMask::BITS);
+        mask |= modifier_bit(modifiers[index]);
+        index += 1;
+    }
+    mask
+}
+
 /// Defines whether a key stroke represents a key being pressed (KeyDown) or released (KeyUp)
 #[derive(Debug, PartialEq, Eq)]
 pub(crate) enum KeyAction {
@@ -128,12 +165,14 @@ impl OrdKeyData {
 // This structure manages the queue of pending keystrokes
 #[derive(Debug, Default)]
 pub(crate) struct KeyQueue {
-    layout: Option<HiiKeyboardLayout>,
-    active_modifiers: BTreeSet<u16>,
-    active_ns_key: Option<HiiNsKeyDescriptor>,
+    layout: Option<CompiledKeyboardLayout>,
+    active_modifiers: ModifierMask,
+    active_ns_key: Option<NsKeyId>,
     partial_key_support_active: bool,
     key_queue: VecDeque<KeyData>,
-    registered_keys: BTreeSet<OrdKeyData>,
+    // registered keys, keyed by (unicode_char, scan_code): a registration only matches keys with the same character
+    // and scan code, so a keystroke only needs to be checked against the registrations in its own bucket.
+    registered_keys: BTreeMap<(u16, u16), BTreeSet<OrdKeyData>>,
     notified_key_queue: VecDeque<KeyData>,
 }
 
@@ -141,10 +180,9 @@ impl KeyQueue {
     // resets the KeyQueue to initial state
     pub(crate) fn reset(&mut self, extended_reset: bool) {
         if extended_reset {
-            self.active_modifiers.clear();
+            self.active_modifiers = 0;
         } else {
-            let active_leds = self.active_led_modifiers();
-            self.active_modifiers.retain(|x| active_leds.contains(x));
+            self.active_modifiers &= LED_MODIFIER_MASK;
         }
         self.active_ns_key = None;
         self.partial_key_support_active = false;
@@ -167,33 +205,25 @@ impl KeyQueue {
         // Check if it is a dependent key of a currently active "non-spacing" (ns) key.
         // Non-spacing key handling is described in UEFI spec 2.10 section 33.2.4.3.
         let mut current_descriptor = None;
-        if let Some(ref ns_key) = self.active_ns_key {
-            for descriptor in &ns_key.dependent_keys {
-                if descriptor.key == efi_key {
-                    // found a dependent key for a previously active ns key.
-                    // de-activate the ns key and process the dependent descriptor.
-                    current_descriptor = Some(*descriptor);
-                    self.active_ns_key = None;
-                    break;
-                }
+        if let Some(ns_key) = self.active_ns_key {
+            if let Some(descriptor) = active_layout.dependent_key(ns_key, efi_key) {
+                // found a dependent key for a previously active ns key.
+                // de-activate the ns key and process the dependent descriptor.
+                current_descriptor = Some(descriptor);
+                self.active_ns_key = None;
             }
         }
 
         // If it is not a dependent key of a currently active ns key, then check if it is a regular or ns key.
         if current_descriptor.is_none() {
-            for key in &active_layout.keys {
-                match key {
-                    HiiKey::Key(descriptor) if descriptor.key == efi_key => {
-                        current_descriptor = Some(*descriptor);
-                        break;
-                    }
-                    HiiKey::NsKey(ns_descriptor) if ns_descriptor.descriptor.key == efi_key => {
-                        // if it is an ns_key, set it as the active ns key, and no further processing is needed.
-                        self.active_ns_key = Some(ns_descriptor.clone());
-                        return;
-                    }
-                    _ => continue,
+            match active_layout.key(efi_key) {
+                Some(CompiledKey::Key(descriptor)) => current_descriptor = Some(descriptor),
+                Some(CompiledKey::NsKey(ns_key)) => {
+                    // if it is an ns_key, set it as the active ns key, and no further processing is needed.
+                    self.active_ns_key = Some(ns_key);
+                    return;
                 }
+                None => (),
             }
         }
 
@@ -202,29 +232,22 @@ impl KeyQueue {
         };
 
         //handle modifiers that are active as long as they are pressed
-        if KEYBOARD_MODIFIERS.contains(&current_descriptor.modifier) {
+        let modifier = modifier_bit(current_descriptor.modifier);
+        if (modifier & KEYBOARD_MODIFIER_MASK) != 0 {
             match action {
-                KeyAction::KeyDown => {
-                    self.active_modifiers.insert(current_descriptor.modifier);
-                }
-                KeyAction::KeyUp => {
-                    self.active_modifiers.remove(&current_descriptor.modifier);
-                }
+                KeyAction::KeyDown => self.active_modifiers |= modifier,
+                KeyAction::KeyUp => self.active_modifiers &= !modifier,
             }
         }
 
         //handle modifiers that toggle each time the key is pressed.
-        if TOGGLE_MODIFIERS.contains(&current_descriptor.modifier) && action == KeyAction::KeyDown {
-            if self.active_modifiers.contains(&current_descriptor.modifier) {
-                self.active_modifiers.remove(&current_descriptor.modifier);
-            } else {
-                self.active_modifiers.insert(current_descriptor.modifier);
-            }
+        if (modifier & TOGGLE_MODIFIER_MASK) != 0 && action == KeyAction::KeyDown {
+            self.active_modifiers ^= modifier;
         }
 
         //handle ctrl-alt-delete
-        if CTRL_MODIFIERS.iter().any(|x| self.active_modifiers.contains(x))
-            && ALT_MODIFIERS.iter().any(|x| self.active_modifiers.contains(x))
+        if (self.active_modifiers & CTRL_MODIFIER_MASK) != 0
+            && (self.active_modifiers & ALT_MODIFIER_MASK) != 0
             && current_descriptor.modifier == DELETE_MODIFIER
         {
             debugln!(DEBUG_WARN, "Ctrl-Alt-Del pressed, resetting system.");
@@ -249,10 +272,10 @@ impl KeyQueue {
         };
 
         // retrieve relevant modifier state that may need to be applied to the key data.
-        let shift_active = SHIFT_MODIFIERS.iter().any(|x| self.active_modifiers.contains(x));
-        let alt_gr_active = self.active_modifiers.contains(&ALT_GR_MODIFIER);
-        let caps_lock_active = self.active_modifiers.contains(&CAPS_LOCK_MODIFIER);
-        let num_lock_active = self.active_modifiers.contains(&NUM_LOCK_MODIFIER);
+        let shift_active = (self.active_modifiers & SHIFT_MODIFIER_MASK) != 0;
+        let alt_gr_active = self.modifier_active(ALT_GR_MODIFIER);
+        let caps_lock_active = self.modifier_active(CAPS_LOCK_MODIFIER);
+        let num_lock_active = self.modifier_active(NUM_LOCK_MODIFIER);
 
         // Apply the shift modifier if needed. Track whether it was applied as the shift modifier is removed from the key
         // state if it was applied here.
@@ -321,12 +344,10 @@ impl KeyQueue {
     }
 
     fn is_registered_key(&self, current_key: KeyData) -> bool {
-        for registered_key in &self.registered_keys {
-            if OrdKeyData(current_key).matches_registered_key(registered_key) {
-                return true;
-            }
-        }
-        false
+        let Some(registered_keys) = self.registered_keys.get(&registered_key_index(&current_key)) else {
+            return false;
+        };
+        registered_keys.iter().any(|registered_key| OrdKeyData(current_key).matches_registered_key(registered_key))
     }
 
     // Creates a KeyState instance initialized based on the current modifier state.
@@ -338,8 +359,11 @@ impl KeyQueue {
             key_toggle_state |= KEY_STATE_EXPOSED;
         }
 
-        for modifier in &self.active_modifiers {
-            match *modifier {
+        let mut active_modifiers = self.active_modifiers;
+        while active_modifiers != 0 {
+            let modifier = active_modifiers.trailing_zeros() as u16;
+            active_modifiers &= active_modifiers - 1;
+            match modifier {
                 LEFT_CONTROL_MODIFIER => key_shift_state |= LEFT_CONTROL_PRESSED,
                 RIGHT_CONTROL_MODIFIER => key_shift_state |= RIGHT_CONTROL_PRESSED,
                 LEFT_ALT_MODIFIER => key_shift_state |= LEFT_ALT_PRESSED,
@@ -382,58 +406,76 @@ impl KeyQueue {
     // set the key toggle state. This allows control of scroll/caps/num locks, as well as whether partial key state is
     // exposed.
     pub(crate) fn set_key_toggle_state(&mut self, toggle_state: KeyToggleState) {
+        self.active_modifiers &= !TOGGLE_MODIFIER_MASK;
+
         if (toggle_state & SCROLL_LOCK_ACTIVE) != 0 {
-            self.active_modifiers.insert(SCROLL_LOCK_MODIFIER);
-        } else {
-            self.active_modifiers.remove(&SCROLL_LOCK_MODIFIER);
+            self.active_modifiers |= modifier_bit(SCROLL_LOCK_MODIFIER);
         }
 
         if (toggle_state & NUM_LOCK_ACTIVE) != 0 {
-            self.active_modifiers.insert(NUM_LOCK_MODIFIER);
-        } else {
-            self.active_modifiers.remove(&NUM_LOCK_MODIFIER);
+            self.active_modifiers |= modifier_bit(NUM_LOCK_MODIFIER);
         }
 
         if (toggle_state & CAPS_LOCK_ACTIVE) != 0 {
-            self.active_modifiers.insert(CAPS_LOCK_MODIFIER);
-        } else {
-            self.active_modifiers.remove(&CAPS_LOCK_MODIFIER);
+            self.active_modifiers |= modifier_bit(CAPS_LOCK_MODIFIER);
         }
 
         self.partial_key_support_active = (toggle_state & KEY_STATE_EXPOSED) != 0;
     }
 
-    fn active_led_modifiers(&self) -> Vec<u16> {
-        self.active_modifiers.iter().cloned().filter(|x| modifier_to_led_usage(*x).is_some()).collect()
+    // Returns whether the given modifier is currently active.
+    fn modifier_active(&self, modifier: u16) -> bool {
+        (self.active_modifiers & modifier_bit(modifier)) != 0
     }
-    // Returns a vector of HID usages corresponding to the active LEDs based on the active modifier state.
-    pub(crate) fn active_leds(&self) -> Vec<Usage> {
-        self.active_modifiers.iter().cloned().filter_map(modifier_to_led_usage).collect()
+
+    // Returns the mask of LEDs that should be lit based on the active modifier state.
+    pub(crate) fn active_leds(&self) -> LedMask {
+        let mut leds = 0;
+        for (modifier, led_usage_id) in LED_MODIFIERS {
+            if self.modifier_active(*modifier) {
+                leds |= 1 << led_usage_id;
+            }
+        }
+        leds
     }
 
     // Returns the current keyboard layout that the KeyQueue is using.
     pub(crate) fn layout(&self) -> Option<HiiKeyboardLayout> {
-        self.layout.clone()
+        self.layout.as_ref().map(|layout| layout.layout().clone())
     }
 
-    // Sets the current keyboard layout that the KeyQueue should use.
+    // Sets the current keyboard layout that the KeyQueue should use. The layout is compiled into lookup tables here so
+    // that keystroke translation does not need to search it.
     pub(crate) fn set_layout(&mut self, new_layout: Option<HiiKeyboardLayout>) {
-        self.layout = new_layout;
+        self.layout = new_layout.map(CompiledKeyboardLayout::new);
+        // an active ns key refers to the previous layout.
+        self.active_ns_key = None;
     }
 
     // Add a registration key for notifications; if a keystroke matches this key data, it will be added to the notify
     // queue in addition to the normal key queue.
     pub(crate) fn add_notify_key(&mut self, key_data: OrdKeyData) {
-        self.registered_keys.insert(key_data);
+        self.registered_keys.entry(registered_key_index(&key_data)).or_default().insert(key_data);
     }
 
     // Remove a previously added notify key; keystrokes matching this key data will no longer be added to the notify
     // queue.
     pub(crate) fn remove_notify_key(&mut self, key_data: &OrdKeyData) {
-        self.registered_keys.remove(key_data);
+        let index = registered_key_index(key_data);
+        if let Some(registered_keys) = self.registered_keys.get_mut(&index) {
+            registered_keys.remove(key_data);
+            if registered_keys.is_empty() {
+                self.registered_keys.remove(&index);
+            }
+        }
     }
 }
 
+// Helper routine that returns the registered_keys index for the given key.
+fn registered_key_index(key_data: &KeyData) -> (u16, u16) {
+    (key_data.key.unicode_char, key_data.key.scan_code)
+}
+
 // Helper routine that converts a HID Usage to the corresponding EfiKey.
 fn usage_to_efi_key(usage: Usage) -> Option<EfiKey> {
     //Refer to UEFI spec version 2.10 figure 34.3
@@ -607,16 +649,6 @@ fn modifier_to_scan(modifier: u16) -> u16 {
     }
 }
 
-// helper routine that converts the given modifier to the corresponding HID Usage.
-fn modifier_to_led_usage(modifier: u16) -> Option<Usage> {
-    match modifier {
-        NUM_LOCK_MODIFIER => Some(Usage::from(0x00080001)),
-        CAPS_LOCK_MODIFIER => Some(Usage::from(0x00080002)),
-        SCROLL_LOCK_MODIFIER => Some(Usage::from(0x00080003)),
-        _ => None,
-    }
-}
-
 #[cfg(test)]
 mod test {
 
@@ -631,7 +663,7 @@ mod test {
 
     use crate::keyboard::key_queue::{OrdKeyData, SCAN_DOWN};
 
-    use super::KeyQueue;
+    use super::{KeyAction, KeyQueue};
 
     // convenience macro for defining HiiKeyDescriptor structures.
     // note: for unicode characters, these are encoded as u16 for compliance with UEFI spec. UEFI only supports UCS-2
@@ -721,7 +753,8 @@ mod test {
         key_queue.keystroke(key, super::KeyAction::KeyUp);
 
         let HiiKey::NsKey(expected_key) = ns_key else { panic!() };
-        assert_eq!(key_queue.active_ns_key, Some(expected_key));
+        let active_ns_key = key_queue.active_ns_key.expect("ns key should be active");
+        assert_eq!(key_queue.layout.as_ref().unwrap().ns_key(active_ns_key), &expected_key);
 
         assert!(key_queue.peek_key().is_none());
 
@@ -732,4 +765,78 @@ mod test {
         let stroke = key_queue.pop_key().unwrap();
         assert_eq!(stroke.key.unicode_char, '\u{00E2}' as u16);
     }
+
+    #[test]
+    fn test_registered_keys() {
+        let mut key_queue = KeyQueue::default();
+
+        let mut key_a: protocols::simple_text_input_ex::KeyData = Default::default();
+        key_a.key.unicode_char = 'a' as u16;
+        let mut shifted_key_a = key_a;
+        shifted_key_a.key_state.key_shift_state =
+            protocols::simple_text_input_ex::SHIFT_STATE_VALID | protocols::simple_text_input_ex::LEFT_SHIFT_PRESSED;
+        let mut key_b: protocols::simple_text_input_ex::KeyData = Default::default();
+        key_b.key.unicode_char = 'b' as u16;
+
+        key_queue.add_notify_key(OrdKeyData(shifted_key_a));
+        assert!(key_queue.is_registered_key(shifted_key_a));
+        assert!(!key_queue.is_registered_key(key_a));
+        assert!(!key_queue.is_registered_key(key_b));
+
+        // a registration with zero shift state matches any shift state.
+        key_queue.add_notify_key(OrdKeyData(key_a));
+        assert!(key_queue.is_registered_key(key_a));
+        assert!(key_queue.is_registered_key(shifted_key_a));
+
+        key_queue.remove_notify_key(&OrdKeyData(key_a));
+        assert!(!key_queue.is_registered_key(key_a));
+        assert!(key_queue.is_registered_key(shifted_key_a));
+
+        key_queue.remove_notify_key(&OrdKeyData(shifted_key_a));
+        assert!(!key_queue.is_registered_key(shifted_key_a));
+        assert!(key_queue.registered_keys.is_empty());
+    }
+
+    #[test]
+    fn test_modifier_state() {
+        let mut key_queue = KeyQueue::default();
+        key_queue.set_layout(Some(hii_keyboard_layout::get_default_keyboard_layout()));
+
+        let left_shift = Usage::from(0x000700E1);
+        let caps_lock = Usage::from(0x00070039);
+        let num_lock = Usage::from(0x00070053);
+
+        // held modifiers are active while pressed.
+        key_queue.keystroke(left_shift, KeyAction::KeyDown);
+        assert_ne!(key_queue.init_key_state().key_shift_state & protocols::simple_text_input_ex::LEFT_SHIFT_PRESSED, 0);
+        key_queue.keystroke(left_shift, KeyAction::KeyUp);
+        assert_eq!(key_queue.init_key_state().key_shift_state, protocols::simple_text_input_ex::SHIFT_STATE_VALID);
+
+        // toggle modifiers flip on each press and drive the LEDs.
+        key_queue.keystroke(caps_lock, KeyAction::KeyDown);
+        key_queue.keystroke(caps_lock, KeyAction::KeyUp);
+        key_queue.keystroke(num_lock, KeyAction::KeyDown);
+        key_queue.keystroke(num_lock, KeyAction::KeyUp);
+        assert_eq!(key_queue.active_leds(), (1 << 0x0001) | (1 << 0x0002));
+        assert_eq!(
+            key_queue.init_key_state().key_toggle_state,
+            protocols::simple_text_input_ex::TOGGLE_STATE_VALID
+                | protocols::simple_text_input_ex::CAPS_LOCK_ACTIVE
+                | protocols::simple_text_input_ex::NUM_LOCK_ACTIVE
+        );
+
+        key_queue.keystroke(caps_lock, KeyAction::KeyDown);
+        assert_eq!(key_queue.active_leds(), 1 << 0x0001);
+
+        // a basic reset keeps the LED state but drops held modifiers; an extended reset clears everything.
+        key_queue.keystroke(left_shift, KeyAction::KeyDown);
+        key_queue.reset(false);
+        assert_eq!(key_queue.active_leds(), 1 << 0x0001);
+        assert_eq!(key_queue.init_key_state().key_shift_state, protocols::simple_text_input_ex::SHIFT_STATE_VALID);
+        key_queue.reset(true);
+        assert_eq!(key_queue.active_leds(), 0);
+
+        key_queue.set_key_toggle_state(protocols::simple_text_input_ex::SCROLL_LOCK_ACTIVE);
+        assert_eq!(key_queue.active_leds(), 1 << 0x0003);
+    }
 }
@@ -30,6 +30,9 @@ pub mod hid_io;
 pub mod keyboard;
 pub mod pointer;
 
+#[cfg(test)]
+mod test_allocator;
+
 use core::{ptr, sync::atomic::AtomicPtr};
 
 use r_efi::efi;
@@ -15,6 +15,7 @@ use alloc::{
     collections::{BTreeMap, BTreeSet},
     vec::Vec,
 };
+use core::mem;
 
 use r_efi::{efi, protocols};
 
@@ -49,7 +50,7 @@ const CENTER: u64 = AXIS_RESOLUTION / 2;
 #[derive(Debug, Clone)]
 struct ReportFieldWithHandler {
     field: VariableField,
-    report_handler: fn(&mut PointerHidHandler, field: VariableField, report: &[u8]),
+    report_handler: fn(&mut PointerHidHandler, field: &VariableField, report: &[u8]),
 }
 
 // Defines a report and the fields of interest within it.
@@ -157,7 +158,7 @@ impl PointerHidHandler {
 
     // Helper routine that handles projecting relative and absolute axis reports onto the fixed
     // absolute report axis that this driver produces.
-    fn resolve_axis(current_value: u64, field: VariableField, report: &[u8]) -> Option<u64> {
+    fn resolve_axis(current_value: u64, field: &VariableField, report: &[u8]) -> Option<u64> {
         if field.attributes.relative {
             //for relative, just update and clamp the current state.
             let new_value = current_value as i64 + field.field_value(report)?;
@@ -177,7 +178,7 @@ impl PointerHidHandler {
     }
 
     // handles x_axis inputs
-    fn x_axis_handler(&mut self, field: VariableField, report: &[u8]) {
+    fn x_axis_handler(&mut self, field: &VariableField, report: &[u8]) {
         if let Some(x_value) = Self::resolve_axis(self.current_state.current_x, field, report) {
             if self.current_state.current_x != x_value {
                 self.current_state.current_x = x_value;
@@ -187,7 +188,7 @@ impl PointerHidHandler {
     }
 
     // handles y_axis inputs
-    fn y_axis_handler(&mut self, field: VariableField, report: &[u8]) {
+    fn y_axis_handler(&mut self, field: &VariableField, report: &[u8]) {
         if let Some(y_value) = Self::resolve_axis(self.current_state.current_y, field, report) {
             if self.current_state.current_y != y_value {
                 self.current_state.current_y = y_value;
@@ -197,7 +198,7 @@ impl PointerHidHandler {
     }
 
     // handles z_axis inputs
-    fn z_axis_handler(&mut self, field: VariableField, report: &[u8]) {
+    fn z_axis_handler(&mut self, field: &VariableField, report: &[u8]) {
         if let Some(z_value) = Self::resolve_axis(self.current_state.current_z, field, report) {
             if self.current_state.current_z != z_value {
                 self.current_state.current_z = z_value;
@@ -207,7 +208,7 @@ impl PointerHidHandler {
     }
 
     // handles button inputs
-    fn button_handler(&mut self, field: VariableField, report: &[u8]) {
+    fn button_handler(&mut self, field: &VariableField, report: &[u8]) {
         let shift = match field.usage.into() {
             x @ BUTTON_MIN..=BUTTON_MAX => x - BUTTON_MIN,
             x @ DIGITIZER_SWITCH_MIN..=DIGITIZER_SWITCH_MAX => x - DIGITIZER_SWITCH_MIN,
@@ -233,6 +234,49 @@ impl PointerHidHandler {
         }
     }
 
+    // Hands an input report to the field handlers for its report id. This runs at TPL_NOTIFY for every interrupt report,
+    // so the field tables are borrowed rather than cloned and nothing here allocates.
+    fn process_input_report(&mut self, report: &[u8]) {
+        if report.is_empty() {
+            return;
+        }
+
+        // determine whether report includes report id byte and adjust the buffer as needed.
+        let (report_id, report) = match self.report_id_present {
+            true => (Some(ReportId::from(&report[0..1])), &report[1..]),
+            false => (None, &report[0..]),
+        };
+
+        if report.is_empty() {
+            return;
+        }
+
+        // the handlers take &mut self, so move the field tables out of self while they are walked. An empty BTreeMap
+        // does not allocate.
+        let input_reports = mem::take(&mut self.input_reports);
+        if let Some(report_data) = input_reports.get(&report_id) {
+            if report.len() != report_data.report_size {
+                //Some devices report extra bytes in their reports. Warn about this, but try and process anyway.
+                debugln!(
+                    DEBUG_VERBOSE,
+                    "{:?}:{:?} unexpected report length for report_id: {:?}. expected {:?}, actual {:?}",
+                    function!(),
+                    line!(),
+                    report_id,
+                    report_data.report_size,
+                    report.len()
+                );
+                debugln!(DEBUG_VERBOSE, "report: {:x?}", report);
+            }
+
+            // hand the report data to the handler for each relevant field for field-specific processing.
+            for field in &report_data.relevant_fields {
+                (field.report_handler)(self, &field.field, report);
+            }
+        }
+        self.input_reports = input_reports;
+    }
+
     fn reset_state(&mut self) {
         self.current_state = Default::default();
         // initialize pointer to center of screen
@@ -256,43 +300,7 @@ impl HidReportReceiver for PointerHidHandler {
     fn receive_report(&mut self, report: &[u8], _hid_io: &dyn HidIo) {
         let old_tpl = self.boot_services.raise_tpl(efi::TPL_NOTIFY);
 
-        'report_processing: {
-            if report.is_empty() {
-                break 'report_processing;
-            }
-
-            // determine whether report includes report id byte and adjust the buffer as needed.
-            let (report_id, report) = match self.report_id_present {
-                true => (Some(ReportId::from(&report[0..1])), &report[1..]),
-                false => (None, &report[0..]),
-            };
-
-            if report.is_empty() {
-                break 'report_processing;
-            }
-
-            if let Some(report_data) = self.input_reports.get(&report_id).cloned() {
-                if report.len() != report_data.report_size {
-                    //Some devices report extra bytes in their reports. Warn about this, but try and process anyway.
-                    debugln!(
-                        DEBUG_VERBOSE,
-                        "{:?}:{:?} unexpected report length for report_id: {:?}. expected {:?}, actual {:?}",
-                        function!(),
-                        line!(),
-                        report_id,
-                        report_data.report_size,
-                        report.len()
-                    );
-                    debugln!(DEBUG_VERBOSE, "report: {:x?}", report);
-                    //break 'report_processing;
-                }
-
-                // hand the report data to the handler for each relevant field for field-specific processing.
-                for field in report_data.relevant_fields {
-                    (field.report_handler)(self, field.field, report);
-                }
-            }
-        }
+        self.process_input_report(report);
 
         self.boot_services.restore_tpl(old_tpl);
     }
@@ -317,6 +325,7 @@ mod test {
         boot_services::MockUefiBootServices,
         hid_io::{HidReportReceiver, MockHidIo},
         pointer::{AXIS_RESOLUTION, CENTER},
+        test_allocator::count_allocations,
     };
     use r_efi::efi;
 
@@ -687,4 +696,107 @@ mod test {
         assert_eq!(pointer_handler.current_state.current_z, 4);
         assert_eq!(pointer_handler.state_changed, true);
     }
+
+    #[test]
+    fn pointer_report_processing_should_not_allocate() {
+        let boot_services = create_fake_static_boot_service();
+
+        static mut ABS_PTR_INTERFACE: *mut c_void = core::ptr::null_mut();
+
+        // expected on PointerHidHandler::initialize().
+        boot_services.expect_create_event().returning(|_, _, _, _, _| efi::Status::SUCCESS);
+        boot_services.expect_install_protocol_interface().returning(|_, _, _, interface| {
+            unsafe { ABS_PTR_INTERFACE = interface };
+            efi::Status::SUCCESS
+        });
+
+        // expected on PointerHidHandler::drop().
+        boot_services.expect_open_protocol().returning(|_, _, interface, _, _, _| {
+            unsafe { *interface = ABS_PTR_INTERFACE };
+            efi::Status::SUCCESS
+        });
+        boot_services.expect_uninstall_protocol_interface().returning(|_, _, _| efi::Status::SUCCESS);
+        boot_services.expect_close_event().returning(|_| efi::Status::SUCCESS);
+
+        let agent = 0x1 as efi::Handle;
+        let mut pointer_handler = PointerHidHandler::new(boot_services, agent);
+        let mut hid_io = MockHidIo::new();
+        hid_io
+            .expect_get_report_descriptor()
+            .returning(|| Ok(hidparser::parse_report_descriptor(&MOUSE_REPORT_DESCRIPTOR).unwrap()));
+
+        let controller = 0x2 as efi::Handle;
+        assert_eq!(pointer_handler.initialize(controller, &hid_io), Ok(()));
+
+        let ((), allocations) = count_allocations(|| {
+            for _ in 0..100 {
+                //click a button and move the cursor (+1,+1), then release and move it back (-1,-1) with the wheel (+1).
+                pointer_handler.process_input_report(&[0x01, 0x01, 0x01, 0x00]);
+                pointer_handler.process_input_report(&[0x00, 0xFF, 0xFF, 0x01]);
+            }
+        });
+        assert_eq!(allocations, 0);
+        assert_eq!(pointer_handler.current_state.active_buttons, 0);
+        assert_eq!(pointer_handler.current_state.current_x, CENTER);
+        assert_eq!(pointer_handler.current_state.current_y, CENTER);
+        assert_eq!(pointer_handler.current_state.current_z, 100);
+    }
+
+    // Measures the cost of input report dispatch. Run with:
+    // cargo test -p UefiHidDxeV2 --release pointer_report_benchmark -- --ignored --nocapture
+    #[test]
+    #[ignore]
+    fn pointer_report_benchmark() {
+        let boot_services = create_fake_static_boot_service();
+
+        static mut ABS_PTR_INTERFACE: *mut c_void = core::ptr::null_mut();
+
+        // expected on PointerHidHandler::initialize().
+        boot_services.expect_create_event().returning(|_, _, _, _, _| efi::Status::SUCCESS);
+        boot_services.expect_install_protocol_interface().returning(|_, _, _, interface| {
+            unsafe { ABS_PTR_INTERFACE = interface };
+            efi::Status::SUCCESS
+        });
+
+        // expected on PointerHidHandler::drop().
+        boot_services.expect_open_protocol().returning(|_, _, interface, _, _, _| {
+            unsafe { *interface = ABS_PTR_INTERFACE };
+            efi::Status::SUCCESS
+        });
+        boot_services.expect_uninstall_protocol_interface().returning(|_, _, _| efi::Status::SUCCESS);
+        boot_services.expect_close_event().returning(|_| efi::Status::SUCCESS);
+
+        let agent = 0x1 as efi::Handle;
+        let mut pointer_handler = PointerHidHandler::new(boot_services, agent);
+        let mut hid_io = MockHidIo::new();
+        hid_io
+            .expect_get_report_descriptor()
+            .returning(|| Ok(hidparser::parse_report_descriptor(&MOUSE_REPORT_DESCRIPTOR).unwrap()));
+
+        let controller = 0x2 as efi::Handle;
+        assert_eq!(pointer_handler.initialize(controller, &hid_io), Ok(()));
+
+        // mouse movement with a button held, as produced while dragging.
+        let reports: [&[u8]; 4] = [
+            &[0x01, 0x04, 0x02, 0x00],
+            &[0x01, 0x04, 0x02, 0x00],
+            &[0x01, 0xFC, 0xFE, 0x00],
+            &[0x01, 0xFC, 0xFE, 0x00],
+        ];
+
+        const ITERATIONS: usize = 500_000;
+        let start = std::time::Instant::now();
+        for _ in 0..ITERATIONS {
+            for report in reports {
+                pointer_handler.process_input_report(core::hint::black_box(report));
+            }
+        }
+        let elapsed = start.elapsed();
+        core::hint::black_box(pointer_handler.current_state.current_x);
+        println!(
+            "pointer: {} reports, {:.1} ns/report",
+            ITERATIONS * reports.len(),
+            elapsed.as_nanos() as f64 / (ITERATIONS * reports.len()) as f64
+        );
+    }
 }
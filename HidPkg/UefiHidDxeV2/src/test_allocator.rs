@@ -0,0 +1,51 @@
+//! Provides allocation counting for unit tests.
+//!
+//! This module wraps the system allocator so that tests can check that a code
+//! path does not use the heap. Counts are kept per thread, since the test
+//! harness runs tests in parallel.
+//!
+//! ## License
+//!
+//! Copyright (C) Microsoft Corporation. All rights reserved.
+//!
+//! SPDX-License-Identifier: BSD-2-Clause-Patent
+//!
+use std::{
+    alloc::{GlobalAlloc, Layout, System},
+    cell::Cell,
+};
+
+thread_local! {
+    static ALLOCATIONS: Cell<usize> = const { Cell::new(0) };
+}
+
+struct CountingAllocator;
+
+unsafe impl GlobalAlloc for CountingAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        // try_with: the thread local may already be gone during thread teardown.
+        _ = ALLOCATIONS.try_with(|count| count.set(count.get() + 1));
+        System.alloc(layout)
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        System.dealloc(ptr, layout)
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        _ = ALLOCATIONS.try_with(|count| count.set(count.get() + 1));
+        System.realloc(ptr, layout, new_size)
+    }
+}
+
+#[global_allocator]
+static GLOBAL_ALLOCATOR: CountingAllocator = CountingAllocator;
+
+/// Runs `f` and returns its result along with the number of heap allocations (including reallocations) that it made on
+/// the calling thread.
+pub fn count_allocations<R>(f: impl FnOnce() -> R) -> (R, usize) {
+    let start = ALLOCATIONS.with(|count| count.get());
+    let result = f();
+    let end = ALLOCATIONS.with(|count| count.get());
+    (result, end - start)
+}
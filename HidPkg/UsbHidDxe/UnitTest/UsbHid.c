@@ -0,0 +1,551 @@
+/** @file
+  This module tests the input report ring of UsbHidDxe: the report descriptor
+  scan for pointer movement fields, coalescing of movement reports, and the
+  delivery of queued reports to the report callback.
+
+  Copyright (c) Microsoft Corporation
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+#include <Library/UnitTestLib.h>
+#include "../UsbHidDxe.h"
+
+#define UNIT_TEST_NAME     "USB HID Report Ring Host Test"
+#define UNIT_TEST_VERSION  "0.1"
+
+#define TEST_MAX_PACKET_SIZE  8
+
+//
+// Boot protocol compatible mouse: 3 buttons, 5 bits of padding, then relative X, Y and wheel bytes.
+//
+STATIC UINT8  mMouseReportDescriptor[] = {
+  0x05, 0x01,       // Usage Page (Generic Desktop)
+  0x09, 0x02,       // Usage (Mouse)
+  0xA1, 0x01,       // Collection (Application)
+  0x09, 0x01,       //   Usage (Pointer)
+  0xA1, 0x00,       //   Collection (Physical)
+  0x05, 0x09,       //     Usage Page (Button)
+  0x19, 0x01,       //     Usage Minimum (1)
+  0x29, 0x03,       //     Usage Maximum (3)
+  0x15, 0x00,       //     Logical Minimum (0)
+  0x25, 0x01,       //     Logical Maximum (1)
+  0x95, 0x03,       //     Report Count (3)
+  0x75, 0x01,       //     Report Size (1)
+  0x81, 0x02,       //     Input (Data, Variable, Absolute)
+  0x95, 0x01,       //     Report Count (1)
+  0x75, 0x05,       //     Report Size (5)
+  0x81, 0x01,       //     Input (Constant)
+  0x05, 0x01,       //     Usage Page (Generic Desktop)
+  0x09, 0x30,       //     Usage (X)
+  0x09, 0x31,       //     Usage (Y)
+  0x09, 0x38,       //     Usage (Wheel)
+  0x15, 0x81,       //     Logical Minimum (-127)
+  0x25, 0x7F,       //     Logical Maximum (127)
+  0x75, 0x08,       //     Report Size (8)
+  0x95, 0x03,       //     Report Count (3)
+  0x81, 0x06,       //     Input (Data, Variable, Relative)
+  0xC0,             //   End Collection
+  0xC0              // End Collection
+};
+
+//
+// The same mouse, with the global items of the movement fields pushed and popped.
+//
+STATIC UINT8  mPushPopReportDescriptor[] = {
+  0x05, 0x01,       // Usage Page (Generic Desktop)
+  0x09, 0x02,       // Usage (Mouse)
+  0xA1, 0x01,       // Collection (Application)
+  0xA4,             //   Push
+  0x09, 0x30,       //   Usage (X)
+  0x09, 0x31,       //   Usage (Y)
+  0x75, 0x08,       //   Report Size (8)
+  0x95, 0x02,       //   Report Count (2)
+  0x81, 0x06,       //   Input (Data, Variable, Relative)
+  0xB4,             //   Pop
+  0xC0              // End Collection
+};
+
+STATIC EFI_BOOT_SERVICES    mBootServices;
+STATIC EFI_USB_IO_PROTOCOL  mUsbIo;
+STATIC UINTN                mEventCount;
+STATIC UINTN                mOpenEventCount;
+STATIC UINTN                mCreateEventCalls;
+STATIC UINTN                mFailingCreateEvent;  // CreateEvent call that fails, counting from 1, or 0 for none.
+STATIC EFI_STATUS           mAsyncTransferStatus;
+STATIC USB_HID_DEV          mDevice;
+STATIC UINTN                mCallbackCount;
+STATIC BOOLEAN              mRingHeldInCallback;
+
+/**
+  Boot services stubs, so the report ring can be run without a DXE core.
+**/
+EFI_TPL
+EFIAPI
+StubRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+VOID
+EFIAPI
+StubRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+}
+
+EFI_STATUS
+EFIAPI
+StubCreateEvent (
+  IN  UINT32            Type,
+  IN  EFI_TPL           NotifyTpl,
+  IN  EFI_EVENT_NOTIFY  NotifyFunction,
+  IN  VOID              *NotifyContext,
+  OUT EFI_EVENT         *Event
+  )
+{
+  if (++mCreateEventCalls == mFailingCreateEvent) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  mOpenEventCount++;
+  *Event = (EFI_EVENT)(UINTN)++mEventCount;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+StubCloseEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  mOpenEventCount--;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+StubSignalEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+StubUsbAsyncInterruptTransfer (
+  IN EFI_USB_IO_PROTOCOL              *This,
+  IN UINT8                            DeviceEndpoint,
+  IN BOOLEAN                          IsNewTransfer,
+  IN UINTN                            PollingInterval    OPTIONAL,
+  IN UINTN                            DataLength         OPTIONAL,
+  IN EFI_ASYNC_USB_TRANSFER_CALLBACK  InterruptCallBack  OPTIONAL,
+  IN VOID                             *Context OPTIONAL
+  )
+{
+  if (IsNewTransfer) {
+    return mAsyncTransferStatus;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Report callback that counts the reports it is given.
+**/
+VOID
+EFIAPI
+CountingReportCallback (
+  IN UINT16  ReportBufferSize,
+  IN VOID    *ReportBuffer,
+  IN VOID    *Context OPTIONAL
+  )
+{
+  mCallbackCount++;
+}
+
+/**
+  Report callback that unregisters itself, then checks the report ring was kept for the report it was given.
+**/
+VOID
+EFIAPI
+UnregisteringReportCallback (
+  IN UINT16  ReportBufferSize,
+  IN VOID    *ReportBuffer,
+  IN VOID    *Context OPTIONAL
+  )
+{
+  mCallbackCount++;
+  HidUnregisterReportCallback (&mDevice.HidIo, UnregisteringReportCallback);
+  mRingHeldInCallback = (BOOLEAN)((mDevice.ReportRing != NULL) && (ReportBuffer == mDevice.DrainBuffer));
+}
+
+/**
+  Starts input reports on the test device, with the given report descriptor and callback.
+**/
+EFI_STATUS
+StartTestDevice (
+  IN UINT8                   *ReportDescriptor,
+  IN UINTN                   ReportDescriptorLength,
+  IN HID_IO_REPORT_CALLBACK  Callback
+  )
+{
+  ZeroMem (&mDevice, sizeof (mDevice));
+  mDevice.Signature                             = USB_HID_DEV_SIGNATURE;
+  mDevice.UsbIo                                 = &mUsbIo;
+  mDevice.IntInEndpointDescriptor.MaxPacketSize = TEST_MAX_PACKET_SIZE;
+  mDevice.ReportDescriptor                      = ReportDescriptor;
+  mDevice.ReportDescriptorLength                = ReportDescriptorLength;
+  mDevice.ReportCallback                        = Callback;
+  mCallbackCount                                = 0;
+  mRingHeldInCallback                           = FALSE;
+  mCreateEventCalls                             = 0;
+
+  return InitiateAsyncInterruptInputTransfers (&mDevice);
+}
+
+/**
+  Clean up method to shut down input reports on the test device, even if the test fails in the middle.
+**/
+VOID
+EFIAPI
+StopTestDevice (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  ShutdownAsyncInterruptInputTransfers (&mDevice);
+  mDevice.ReportCallback = NULL;
+  mFailingCreateEvent    = 0;
+  mAsyncTransferStatus   = EFI_SUCCESS;
+}
+
+/**
+ * @brief Test the movement fields of a boot protocol mouse are found.
+ *
+ * @param Context
+ * @return UNIT_TEST_STATUS
+ */
+UNIT_TEST_STATUS
+EFIAPI
+TestFindMovementFieldsMouse (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  Status = StartTestDevice (mMouseReportDescriptor, sizeof (mMouseReportDescriptor), CountingReportCallback);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_SUCCESS);
+
+  // X, Y and wheel follow the button byte. The buttons and the padding are not movement fields.
+  UT_ASSERT_FALSE (mDevice.ReportIdsPresent);
+  UT_ASSERT_EQUAL (mDevice.MovementFieldCount, 3);
+  for (Index = 0; Index < mDevice.MovementFieldCount; Index++) {
+    UT_ASSERT_EQUAL (mDevice.MovementFields[Index].ReportId, 0);
+    UT_ASSERT_TRUE (mDevice.MovementFields[Index].Relative);
+    UT_ASSERT_EQUAL (mDevice.MovementFields[Index].BitOffset, 8 * (Index + 1));
+    UT_ASSERT_EQUAL (mDevice.MovementFields[Index].BitSize, 8);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+ * @brief Test a report descriptor using Push and Pop leaves coalescing disabled.
+ *
+ * @param Context
+ * @return UNIT_TEST_STATUS
+ */
+UNIT_TEST_STATUS
+EFIAPI
+TestFindMovementFieldsPushPop (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = StartTestDevice (mPushPopReportDescriptor, sizeof (mPushPopReportDescriptor), CountingReportCallback);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_SUCCESS);
+  UT_ASSERT_EQUAL (mDevice.MovementFieldCount, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+ * @brief Test reports that differ only in relative movement are merged, and the movement is summed.
+ *
+ * @param Context
+ * @return UNIT_TEST_STATUS
+ */
+UNIT_TEST_STATUS
+EFIAPI
+TestCoalesceRelativeMovement (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       Pending[] = { 0x01, 5, (UINT8)-3, 0 };
+  UINT8       Report[]  = { 0x01, 2, 1, (UINT8)-1 };
+  UINT8       Merged[]  = { 0x01, 7, (UINT8)-2, (UINT8)-1 };
+
+  Status = StartTestDevice (mMouseReportDescriptor, sizeof (mMouseReportDescriptor), CountingReportCallback);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_SUCCESS);
+
+  UT_ASSERT_TRUE (CoalesceMovementReport (&mDevice, Pending, sizeof (Pending), Report, sizeof (Report)));
+  UT_ASSERT_MEM_EQUAL (Pending, Merged, sizeof (Merged));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+ * @brief Test reports are not merged when the buttons change, or when the summed movement doesn't fit its field.
+ *
+ * @param Context
+ * @return UNIT_TEST_STATUS
+ */
+UNIT_TEST_STATUS
+EFIAPI
+TestCoalesceRejected (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       Pending[]  = { 0x01, 120, 0, 0 };
+  UINT8       Original[] = { 0x01, 120, 0, 0 };
+  UINT8       Released[] = { 0x00, 1, 0, 0 };
+  UINT8       Overflow[] = { 0x01, 10, 0, 0 };
+
+  Status = StartTestDevice (mMouseReportDescriptor, sizeof (mMouseReportDescriptor), CountingReportCallback);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_SUCCESS);
+
+  UT_ASSERT_FALSE (CoalesceMovementReport (&mDevice, Pending, sizeof (Pending), Released, sizeof (Released)));
+  UT_ASSERT_FALSE (CoalesceMovementReport (&mDevice, Pending, sizeof (Pending), Overflow, sizeof (Overflow)));
+  UT_ASSERT_FALSE (CoalesceMovementReport (&mDevice, Pending, sizeof (Pending), Released, sizeof (Released) - 1));
+  UT_ASSERT_MEM_EQUAL (Pending, Original, sizeof (Original));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+ * @brief Test a full report ring drops its oldest report, so the newest report is still delivered.
+ *
+ * @param Context
+ * @return UNIT_TEST_STATUS
+ */
+UNIT_TEST_STATUS
+EFIAPI
+TestQueueReportFullRingDropsOldest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS                Status;
+  HID_IO_REPORT_STATISTICS  Statistics;
+  UINT8                     Report[4];
+  UINTN                     Index;
+  UINTN                     Newest;
+
+  Status = StartTestDevice (mMouseReportDescriptor, sizeof (mMouseReportDescriptor), CountingReportCallback);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_SUCCESS);
+
+  // Toggle a button in each report, so none of them are coalesced.
+  for (Index = 0; Index <= USB_HID_REPORT_RING_SIZE; Index++) {
+    Report[0] = (UINT8)(Index & 1);
+    Report[1] = (UINT8)Index;
+    Report[2] = 0;
+    Report[3] = 0;
+    QueueReport (&mDevice, Report, sizeof (Report));
+  }
+
+  UT_ASSERT_STATUS_EQUAL (HidGetReportStatistics (&mDevice.HidIo, NULL), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (HidGetReportStatistics (&mDevice.HidIo, &Statistics), EFI_SUCCESS);
+  UT_ASSERT_EQUAL (Statistics.ReportsDropped, 1);
+  UT_ASSERT_EQUAL (Statistics.ReportsCoalesced, 0);
+  UT_ASSERT_EQUAL (mDevice.ReportRingCount, USB_HID_REPORT_RING_SIZE);
+
+  // The first report was dropped, and the last one queued.
+  UT_ASSERT_EQUAL (USB_HID_REPORT_RING_SLOT (&mDevice, mDevice.ReportRingHead)[1], 1);
+  Newest = (mDevice.ReportRingHead + mDevice.ReportRingCount - 1) % USB_HID_REPORT_RING_SIZE;
+  UT_ASSERT_EQUAL (USB_HID_REPORT_RING_SLOT (&mDevice, Newest)[1], USB_HID_REPORT_RING_SIZE);
+
+  DrainReportRing (NULL, &mDevice);
+  UT_ASSERT_EQUAL (mCallbackCount, USB_HID_REPORT_RING_SIZE);
+  UT_ASSERT_EQUAL (mDevice.ReportRingCount, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+ * @brief Test a report callback can unregister itself while it has a report, and the report ring is only freed once
+ * the callback returns.
+ *
+ * @param Context
+ * @return UNIT_TEST_STATUS
+ */
+UNIT_TEST_STATUS
+EFIAPI
+TestUnregisterFromReportCallback (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       Report[] = { 0x01, 0, 0, 0 };
+
+  Status = StartTestDevice (mMouseReportDescriptor, sizeof (mMouseReportDescriptor), UnregisteringReportCallback);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_SUCCESS);
+
+  QueueReport (&mDevice, Report, sizeof (Report));
+  Report[0] = 0x00;
+  QueueReport (&mDevice, Report, sizeof (Report));
+  UT_ASSERT_EQUAL (mDevice.ReportRingCount, 2);
+
+  // The second report is discarded when the callback shuts down input reports.
+  DrainReportRing (NULL, &mDevice);
+  UT_ASSERT_EQUAL (mCallbackCount, 1);
+  UT_ASSERT_TRUE (mRingHeldInCallback);
+  UT_ASSERT_TRUE (mDevice.ReportCallback == NULL);
+  UT_ASSERT_TRUE (mDevice.ReportRing == NULL);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+ * @brief Test a failed start of input reports closes its events and frees the report ring.
+ *
+ * @param Context
+ * @return UNIT_TEST_STATUS
+ */
+UNIT_TEST_STATUS
+EFIAPI
+TestStartFailureReleasesRing (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+
+  // The report drain event is the second event created, after the report ring is allocated.
+  mFailingCreateEvent = 2;
+  Status              = StartTestDevice (mMouseReportDescriptor, sizeof (mMouseReportDescriptor), CountingReportCallback);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_OUT_OF_RESOURCES);
+  UT_ASSERT_TRUE (mDevice.ReportRing == NULL);
+  UT_ASSERT_TRUE (mDevice.DelayedRecoveryEvent == NULL);
+  UT_ASSERT_TRUE (mDevice.ReportDrainEvent == NULL);
+  UT_ASSERT_EQUAL (mOpenEventCount, 0);
+
+  mFailingCreateEvent  = 0;
+  mAsyncTransferStatus = EFI_DEVICE_ERROR;
+  Status               = StartTestDevice (mMouseReportDescriptor, sizeof (mMouseReportDescriptor), CountingReportCallback);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_DEVICE_ERROR);
+  UT_ASSERT_TRUE (mDevice.ReportRing == NULL);
+  UT_ASSERT_TRUE (mDevice.DelayedRecoveryEvent == NULL);
+  UT_ASSERT_TRUE (mDevice.ReportDrainEvent == NULL);
+  UT_ASSERT_EQUAL (mOpenEventCount, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  USB HID report ring and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+EFI_STATUS
+EFIAPI
+UefiTestMain (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      DescriptorSuiteHandle;
+  UNIT_TEST_SUITE_HANDLE      RingSuiteHandle;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  //
+  // The report ring only needs a few boot services, which are stubbed.
+  //
+  mBootServices.RaiseTPL           = StubRaiseTpl;
+  mBootServices.RestoreTPL         = StubRestoreTpl;
+  mBootServices.CreateEvent        = StubCreateEvent;
+  mBootServices.CloseEvent         = StubCloseEvent;
+  mBootServices.SignalEvent        = StubSignalEvent;
+  gBS                              = &mBootServices;
+  mUsbIo.UsbAsyncInterruptTransfer = StubUsbAsyncInterruptTransfer;
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Create a suite
+  //
+  Status = CreateUnitTestSuite (&DescriptorSuiteHandle, Framework, "UsbHidDxe Movement Field Coalescing", "UsbHidDxe.Coalesce", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for DescriptorSuiteHandle\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // Register Tests
+  //
+  AddTestCase (DescriptorSuiteHandle, "Find the movement fields of a mouse", "FindMovementFields.Mouse", TestFindMovementFieldsMouse, NULL, StopTestDevice, NULL);
+  AddTestCase (DescriptorSuiteHandle, "Disable coalescing for a descriptor with Push and Pop", "FindMovementFields.PushPop", TestFindMovementFieldsPushPop, NULL, StopTestDevice, NULL);
+  AddTestCase (DescriptorSuiteHandle, "Merge reports that differ only in relative movement", "CoalesceMovementReport.Relative", TestCoalesceRelativeMovement, NULL, StopTestDevice, NULL);
+  AddTestCase (DescriptorSuiteHandle, "Keep reports that differ in buttons, length or overflow apart", "CoalesceMovementReport.Rejected", TestCoalesceRejected, NULL, StopTestDevice, NULL);
+
+  //
+  // Create a suite
+  //
+  Status = CreateUnitTestSuite (&RingSuiteHandle, Framework, "UsbHidDxe Report Ring", "UsbHidDxe.ReportRing", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for RingSuiteHandle\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // Register Tests
+  //
+  AddTestCase (RingSuiteHandle, "Drop the oldest report when the ring is full", "QueueReport.FullRing", TestQueueReportFullRingDropsOldest, NULL, StopTestDevice, NULL);
+  AddTestCase (RingSuiteHandle, "Unregister the report callback from the callback", "DrainReportRing.Unregister", TestUnregisterFromReportCallback, NULL, StopTestDevice, NULL);
+  AddTestCase (RingSuiteHandle, "Release the report ring when input reports fail to start", "InitiateAsyncInterruptInputTransfers.Failure", TestStartFailureReleasesRing, NULL, StopTestDevice, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UefiTestMain ();
+}
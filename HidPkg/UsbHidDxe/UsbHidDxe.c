@@ -9,69 +9,7 @@
 
 **/
 
-#include <Uefi.h>
-
-#include <Protocol/HidIo.h>
-
-#include <Protocol/DevicePath.h>
-#include <Protocol/DriverBinding.h>
-#include <Protocol/UsbIo.h>
-
-#include <Library/BaseMemoryLib.h>
-#include <Library/DebugLib.h>
-#include <Library/MemoryAllocationLib.h>
-#include <Library/UefiBootServicesTableLib.h>
-#include <Library/UefiLib.h>
-#include <Library/UefiUsbLib.h>
-
-#include <IndustryStandard/Usb.h>
-
-#define CLASS_HID      3
-#define SUBCLASS_BOOT  1
-
-// Refer to USB HID 1.11, section 7.2.6.
-#define BOOT_PROTOCOL    0
-#define REPORT_PROTOCOL  1
-
-//
-// A common header for usb standard descriptor.
-// Each stand descriptor has a length and type.
-//
-#pragma pack(1)
-typedef struct {
-  UINT8    Len;
-  UINT8    Type;
-} USB_DESC_HEAD;
-#pragma pack()
-
-#define USB_HID_DEV_SIGNATURE  SIGNATURE_32('U','H','I','D')
-
-typedef struct {
-  UINT32                          Signature;
-  HID_IO_PROTOCOL                 HidIo;
-  EFI_USB_IO_PROTOCOL             *UsbIo;
-  EFI_USB_INTERFACE_DESCRIPTOR    InterfaceDescriptor;
-  EFI_USB_ENDPOINT_DESCRIPTOR     IntInEndpointDescriptor;
-  EFI_USB_HID_DESCRIPTOR          *HidDescriptor;
-  UINTN                           ReportDescriptorLength;
-  VOID                            *ReportDescriptor;
-  HID_IO_REPORT_CALLBACK          ReportCallback;
-  VOID                            *CallbackContext;
-  EFI_EVENT                       DelayedRecoveryEvent;
-} USB_HID_DEV;
-
-#define USB_HID_DEV_FROM_HID_IO_PROTOCOL(a) \
-    CR(a, USB_HID_DEV, HidIo, USB_HID_DEV_SIGNATURE)
-
-EFI_STATUS
-InitiateAsyncInterruptInputTransfers (
-  USB_HID_DEV  *Device
-  );
-
-EFI_STATUS
-ShutdownAsyncInterruptInputTransfers (
-  USB_HID_DEV  *Device
-  );
+#include "UsbHidDxe.h"
 
 /**
   Retrieve the HID Report Descriptor from the device.
@@ -298,7 +236,11 @@ HidRegisterReportCallback (
   UsbHidDevice->CallbackContext = Context;
 
   Status = InitiateAsyncInterruptInputTransfers (UsbHidDevice);
-  ASSERT_EFI_ERROR (Status);
+  if (EFI_ERROR (Status)) {
+    ASSERT_EFI_ERROR (Status);
+    UsbHidDevice->ReportCallback  = NULL;
+    UsbHidDevice->CallbackContext = NULL;
+  }
 
   return Status;
 }
@@ -344,14 +286,463 @@ HidUnregisterReportCallback (
 }
 
 /**
-  Handles interrupt completion on USB with new HID report.
+  Retrieves the input report counters of the device.
+
+  @param  This                  A pointer to the HidIo Instance
+  @param  Statistics            Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS           Counters successfully returned.
+  @retval EFI_INVALID_PARAMETER Invalid input parameters.
+**/
+EFI_STATUS
+EFIAPI
+HidGetReportStatistics (
+  IN  HID_IO_PROTOCOL           *This,
+  OUT HID_IO_REPORT_STATISTICS  *Statistics
+  )
+{
+  if ((This == NULL) || (Statistics == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  GetReportStatistics (USB_HID_DEV_FROM_HID_IO_PROTOCOL (This), Statistics);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Reads a field of up to 32 bits from a report.
+
+  @param  Report                The report to read the field from.
+  @param  ReportLength          Length of the report in bytes.
+  @param  BitOffset             Offset of the field within the report, in bits.
+  @param  BitSize               Size of the field in bits.
+  @param  Value                 Receives the (unsigned) field value.
+
+  @retval TRUE                  The field value was returned.
+  @retval FALSE                 The field does not fit within the report.
+**/
+BOOLEAN
+GetReportField (
+  IN  CONST UINT8  *Report,
+  IN  UINTN        ReportLength,
+  IN  UINTN        BitOffset,
+  IN  UINTN        BitSize,
+  OUT UINT32       *Value
+  )
+{
+  UINTN  Index;
+
+  if ((BitSize > 32) || (BitOffset + BitSize > ReportLength * 8)) {
+    return FALSE;
+  }
+
+  *Value = 0;
+  for (Index = 0; Index < BitSize; Index++) {
+    if ((Report[(BitOffset + Index) / 8] & (1 << ((BitOffset + Index) % 8))) != 0) {
+      *Value |= (UINT32)1 << Index;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Writes a field of up to 32 bits into a report. The field must fit within the report (see GetReportField).
+
+  @param  Report                The report to write the field to.
+  @param  BitOffset             Offset of the field within the report, in bits.
+  @param  BitSize               Size of the field in bits.
+  @param  Value                 The field value. Bits above BitSize are ignored.
+**/
+VOID
+SetReportField (
+  IN OUT UINT8  *Report,
+  IN     UINTN  BitOffset,
+  IN     UINTN  BitSize,
+  IN     UINT32 Value
+  )
+{
+  UINTN  Index;
+  UINT8  Mask;
+
+  for (Index = 0; Index < BitSize; Index++) {
+    Mask = (UINT8)(1 << ((BitOffset + Index) % 8));
+    if ((Value & ((UINT32)1 << Index)) != 0) {
+      Report[(BitOffset + Index) / 8] |= Mask;
+    } else {
+      Report[(BitOffset + Index) / 8] &= (UINT8) ~Mask;
+    }
+  }
+}
+
+/**
+  Sign extends a field value read with GetReportField.
+
+  @param  Value                 The field value.
+  @param  BitSize               Size of the field in bits (1-32).
+
+  @retval                       The signed field value.
+**/
+INT64
+SignExtendReportField (
+  IN UINT32  Value,
+  IN UINTN   BitSize
+  )
+{
+  if ((BitSize < 32) && ((Value & ((UINT32)1 << (BitSize - 1))) != 0)) {
+    return (INT64)Value - ((INT64)1 << BitSize);
+  }
+
+  return (BitSize < 32) ? (INT64)Value : (INT64)(INT32)Value;
+}
+
+/**
+  Indicates whether the given usage is a pointer movement usage whose value may change between two reports that are
+  coalesced.
+
+  @param  Usage                 The usage, with the usage page in the upper 16 bits.
+
+  @retval TRUE                  The usage is a movement usage.
+  @retval FALSE                 The usage is not a movement usage.
+**/
+BOOLEAN
+IsMovementUsage (
+  IN UINT32  Usage
+  )
+{
+  // X, Y, Z, Rx, Ry, Rz, Slider, Dial, Wheel and horizontal scroll. Digitizers timestamp every report, so the scan time
+  // is treated like a position (the newest value wins) to allow touch reports to coalesce.
+  return (BOOLEAN)(((Usage >= HID_USAGE_GENERIC_DESKTOP_X) && (Usage <= HID_USAGE_GENERIC_DESKTOP_WHEEL)) ||
+                   (Usage == HID_USAGE_CONSUMER_AC_PAN) ||
+                   (Usage == HID_USAGE_DIGITIZER_SCAN_TIME));
+}
+
+/**
+  Scans the report descriptor for the pointer movement fields in the device's input reports, which allows consecutive
+  movement reports to be coalesced when the report callback cannot keep up with the device.
+
+  Coalescing is left disabled if the descriptor cannot be read or uses items this scan doesn't track.
+
+  @param  UsbHidDevice          The UsbHidDevice instance to scan the report descriptor for.
+**/
+VOID
+FindMovementFields (
+  IN USB_HID_DEV  *UsbHidDevice
+  )
+{
+  EFI_STATUS              Status;
+  UINTN                   DescriptorSize;
+  UINT8                   *Descriptor;
+  UINTN                   Cursor;
+  UINT8                   Prefix;
+  UINTN                   DataSize;
+  UINT32                  Data;
+  UINTN                   Index;
+  UINT32                  BitOffsets[MAX_UINT8 + 1];
+  UINT32                  UsagePage;
+  UINT32                  ReportSize;
+  UINT32                  ReportCount;
+  UINT8                   ReportId;
+  UINT32                  Usages[USB_HID_MAX_ITEM_USAGES];
+  UINTN                   UsageCount;
+  UINT32                  UsageMinimum;
+  UINT32                  UsageMaximum;
+  UINT32                  Usage;
+  USB_HID_MOVEMENT_FIELD  *Field;
+
+  UsbHidDevice->ReportIdsPresent   = FALSE;
+  UsbHidDevice->MovementFieldCount = 0;
+
+  // Query the size to make sure the descriptor has been read from the device.
+  DescriptorSize = 0;
+  Status         = HidGetReportDescriptor (&UsbHidDevice->HidIo, &DescriptorSize, NULL);
+  if ((Status != EFI_BUFFER_TOO_SMALL) || (UsbHidDevice->ReportDescriptor == NULL)) {
+    return;
+  }
+
+  Descriptor = (UINT8 *)UsbHidDevice->ReportDescriptor;
+  ZeroMem (BitOffsets, sizeof (BitOffsets));
+  UsagePage    = 0;
+  ReportSize   = 0;
+  ReportCount  = 0;
+  ReportId     = 0;
+  UsageCount   = 0;
+  UsageMinimum = 0;
+  UsageMaximum = 0;
+
+  Cursor = 0;
+  while (Cursor < DescriptorSize) {
+    Prefix = Descriptor[Cursor];
+    if (Prefix == HID_ITEM_LONG) {
+      // Long items are reserved and carry no field information; skip them.
+      if (Cursor + 1 >= DescriptorSize) {
+        break;
+      }
+
+      Cursor += 3 + Descriptor[Cursor + 1];
+      continue;
+    }
+
+    DataSize = Prefix & HID_ITEM_SIZE_MASK;
+    if (DataSize == 3) {
+      DataSize = 4;
+    }
+
+    if (Cursor + 1 + DataSize > DescriptorSize) {
+      goto Unsupported;
+    }
+
+    Data = 0;
+    for (Index = 0; Index < DataSize; Index++) {
+      Data |= (UINT32)Descriptor[Cursor + 1 + Index] << (8 * Index);
+    }
+
+    Cursor += 1 + DataSize;
+
+    switch (Prefix & ~HID_ITEM_SIZE_MASK) {
+      case HID_ITEM_USAGE_PAGE:
+        UsagePage = Data;
+        break;
+      case HID_ITEM_REPORT_SIZE:
+        ReportSize = Data;
+        break;
+      case HID_ITEM_REPORT_COUNT:
+        ReportCount = Data;
+        break;
+      case HID_ITEM_REPORT_ID:
+        ReportId                       = (UINT8)Data;
+        UsbHidDevice->ReportIdsPresent = TRUE;
+        break;
+      case HID_ITEM_PUSH:
+      case HID_ITEM_POP:
+        // Not used by pointing devices in practice; not worth tracking the global item stack for.
+        goto Unsupported;
+      case HID_ITEM_USAGE:
+        if (UsageCount < USB_HID_MAX_ITEM_USAGES) {
+          Usages[UsageCount++] = (DataSize == 4) ? Data : ((UsagePage << 16) | Data);
+        }
+
+        break;
+      case HID_ITEM_USAGE_MINIMUM:
+        UsageMinimum = (DataSize == 4) ? Data : ((UsagePage << 16) | Data);
+        break;
+      case HID_ITEM_USAGE_MAXIMUM:
+        UsageMaximum = (DataSize == 4) ? Data : ((UsagePage << 16) | Data);
+        break;
+      case HID_ITEM_INPUT:
+        for (Index = 0; Index < ReportCount; Index++) {
+          if (((Data & HID_MAIN_ITEM_CONSTANT) == 0) && ((Data & HID_MAIN_ITEM_VARIABLE) != 0)) {
+            // Fields use the usages in order, with the last usage repeated for any remaining fields.
+            if (UsageCount > 0) {
+              Usage = Usages[MIN (Index, UsageCount - 1)];
+            } else if (UsageMaximum >= UsageMinimum) {
+              Usage = MIN (UsageMinimum + (UINT32)Index, UsageMaximum);
+            } else {
+              Usage = 0;
+            }
+
+            if (IsMovementUsage (Usage) &&
+                (ReportSize > 0) && (ReportSize <= 32) &&
+                (BitOffsets[ReportId] + ReportSize <= MAX_UINT16) &&
+                (UsbHidDevice->MovementFieldCount < USB_HID_MAX_MOVEMENT_FIELDS))
+            {
+              Field            = &UsbHidDevice->MovementFields[UsbHidDevice->MovementFieldCount++];
+              Field->ReportId  = ReportId;
+              Field->Relative  = (BOOLEAN)((Data & HID_MAIN_ITEM_RELATIVE) != 0);
+              Field->BitOffset = (UINT16)BitOffsets[ReportId];
+              Field->BitSize   = (UINT8)ReportSize;
+            }
+          }
+
+          if (BitOffsets[ReportId] + ReportSize < BitOffsets[ReportId]) {
+            goto Unsupported;
+          }
+
+          BitOffsets[ReportId] += ReportSize;
+        }
+
+        break;
+      default:
+        break;
+    }
+
+    // Local items only apply to the next main item.
+    if ((Prefix & HID_ITEM_TYPE_MASK) == HID_ITEM_TYPE_MAIN) {
+      UsageCount   = 0;
+      UsageMinimum = 0;
+      UsageMaximum = 0;
+    }
+  }
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "[%a] %u pointer movement fields found.\n",
+    __FUNCTION__,
+    (UINT32)UsbHidDevice->MovementFieldCount
+    ));
+  return;
+
+Unsupported:
+  DEBUG ((DEBUG_VERBOSE, "[%a] report descriptor not supported for coalescing.\n", __FUNCTION__));
+  UsbHidDevice->MovementFieldCount = 0;
+}
+
+/**
+  Attempts to coalesce a report into the newest report waiting in the report ring. This is possible when the two
+  reports differ only in their pointer movement fields: absolute positions are replaced with the newer values, and
+  relative movements are summed, provided the sum still fits in the field.
+
+  @param  UsbHidDevice          The UsbHidDevice instance that received the report.
+  @param  Pending               The newest report waiting in the report ring. Updated if the report is coalesced.
+  @param  PendingLength         Length of the pending report.
+  @param  Report                The newly received report.
+  @param  ReportLength          Length of the newly received report.
+
+  @retval TRUE                  The report was coalesced into the pending report.
+  @retval FALSE                 The report must be queued separately.
+**/
+BOOLEAN
+CoalesceMovementReport (
+  IN     USB_HID_DEV  *UsbHidDevice,
+  IN OUT UINT8        *Pending,
+  IN     UINTN        PendingLength,
+  IN     CONST UINT8  *Report,
+  IN     UINTN        ReportLength
+  )
+{
+  USB_HID_MOVEMENT_FIELD  *Field;
+  UINTN                   Index;
+  UINT8                   ReportId;
+  UINTN                   FieldBase;
+  UINT32                  PendingValue;
+  UINT32                  ReportValue;
+  INT64                   Sum;
+  BOOLEAN                 MovementFound;
+
+  if ((UsbHidDevice->MovementFieldCount == 0) || (PendingLength != ReportLength)) {
+    return FALSE;
+  }
+
+  ReportId  = UsbHidDevice->ReportIdsPresent ? Report[0] : 0;
+  FieldBase = UsbHidDevice->ReportIdsPresent ? 8 : 0;
+
+  // Copy the pending movement values into the new report. If that makes it identical to the pending report, the two
+  // reports differ only in movement.
+  CopyMem (UsbHidDevice->CoalesceBuffer, Report, ReportLength);
+  MovementFound = FALSE;
+  for (Index = 0; Index < UsbHidDevice->MovementFieldCount; Index++) {
+    Field = &UsbHidDevice->MovementFields[Index];
+    if (Field->ReportId != ReportId) {
+      continue;
+    }
+
+    if (!GetReportField (Pending, PendingLength, FieldBase + Field->BitOffset, Field->BitSize, &PendingValue) ||
+        !GetReportField (Report, ReportLength, FieldBase + Field->BitOffset, Field->BitSize, &ReportValue))
+    {
+      return FALSE;
+    }
+
+    if (Field->Relative) {
+      Sum = SignExtendReportField (PendingValue, Field->BitSize) + SignExtendReportField (ReportValue, Field->BitSize);
+      if ((Sum < -((INT64)1 << (Field->BitSize - 1))) || (Sum >= ((INT64)1 << (Field->BitSize - 1)))) {
+        return FALSE;
+      }
+    }
+
+    SetReportField (UsbHidDevice->CoalesceBuffer, FieldBase + Field->BitOffset, Field->BitSize, PendingValue);
+    MovementFound = TRUE;
+  }
+
+  if (!MovementFound || (CompareMem (UsbHidDevice->CoalesceBuffer, Pending, PendingLength) != 0)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < UsbHidDevice->MovementFieldCount; Index++) {
+    Field = &UsbHidDevice->MovementFields[Index];
+    if (Field->ReportId != ReportId) {
+      continue;
+    }
+
+    GetReportField (Pending, PendingLength, FieldBase + Field->BitOffset, Field->BitSize, &PendingValue);
+    GetReportField (Report, ReportLength, FieldBase + Field->BitOffset, Field->BitSize, &ReportValue);
+    if (Field->Relative) {
+      Sum         = SignExtendReportField (PendingValue, Field->BitSize) +
+                    SignExtendReportField (ReportValue, Field->BitSize);
+      ReportValue = (UINT32)Sum;
+    }
+
+    SetReportField (Pending, FieldBase + Field->BitOffset, Field->BitSize, ReportValue);
+  }
+
+  return TRUE;
+}
+
+/**
+  Queues a report received on USB interrupt completion for delivery to the report callback at TPL_CALLBACK. The report
+  is coalesced into the newest queued report if possible. If the report ring is full, the oldest queued report is
+  dropped to make room, so the callback always sees the latest state of the device.
+
+  Must be called at TPL_NOTIFY.
+
+  @param  UsbHidDevice          The UsbHidDevice instance that received the report.
+  @param  Report                The received report.
+  @param  ReportLength          Length of the received report.
+**/
+VOID
+QueueReport (
+  IN USB_HID_DEV  *UsbHidDevice,
+  IN CONST UINT8  *Report,
+  IN UINTN        ReportLength
+  )
+{
+  UINTN  Slot;
+
+  if ((UsbHidDevice->ReportRing == NULL) || (ReportLength > UsbHidDevice->IntInEndpointDescriptor.MaxPacketSize)) {
+    UsbHidDevice->Statistics.ReportsDropped++;
+    return;
+  }
+
+  if (UsbHidDevice->ReportRingCount > 0) {
+    Slot = (UsbHidDevice->ReportRingHead + UsbHidDevice->ReportRingCount - 1) % USB_HID_REPORT_RING_SIZE;
+    if (CoalesceMovementReport (
+          UsbHidDevice,
+          USB_HID_REPORT_RING_SLOT (UsbHidDevice, Slot),
+          UsbHidDevice->ReportRingLength[Slot],
+          Report,
+          ReportLength
+          ))
+    {
+      UsbHidDevice->Statistics.ReportsCoalesced++;
+      return;
+    }
+  }
+
+  if (UsbHidDevice->ReportRingCount == USB_HID_REPORT_RING_SIZE) {
+    // Dropping the newest report instead could leave a key held down or a button pressed until the next report.
+    UsbHidDevice->ReportRingHead = (UsbHidDevice->ReportRingHead + 1) % USB_HID_REPORT_RING_SIZE;
+    UsbHidDevice->ReportRingCount--;
+    UsbHidDevice->Statistics.ReportsDropped++;
+  }
+
+  Slot = (UsbHidDevice->ReportRingHead + UsbHidDevice->ReportRingCount) % USB_HID_REPORT_RING_SIZE;
+  CopyMem (USB_HID_REPORT_RING_SLOT (UsbHidDevice, Slot), Report, ReportLength);
+  UsbHidDevice->ReportRingLength[Slot] = (UINT16)ReportLength;
+  UsbHidDevice->ReportRingCount++;
+
+  gBS->SignalEvent (UsbHidDevice->ReportDrainEvent);
+}
+
+/**
+  Handles interrupt completion on USB with new HID report. The report is queued in the report ring and delivered to the
+  report callback by DrainReportRing at TPL_CALLBACK, so that completion handling stays short.
 
   @param  Data                  Pointer to buffer containing data returned by USB interrupt completion.
   @param  DataLength            Length of data buffer.
   @param  Context               Context associated with transfer (points to UsbHidDevice that scheduled the transfer)
   @param  Result                Indicates if there was an error on USB.
 
-  @retval EFI_SUCCESS           Interrupt handled and passed up the stack.
+  @retval EFI_SUCCESS           Interrupt handled and the report queued for the report callback.
   @retval EFI_DEVICE_ERROR      There as an error with the transaction. The interrupt will be re-submitted after a
                                 delay.
   @retval Other                 Unexpected error handling the interrupt completion.
@@ -413,13 +804,8 @@ OnReportInterruptComplete (
     return EFI_SUCCESS;
   }
 
-  if (UsbHidDevice->ReportCallback != NULL) {
-    UsbHidDevice->ReportCallback (
-                    (UINT16)DataLength,
-                    Data,
-                    UsbHidDevice->CallbackContext
-                    );
-  }
+  UsbHidDevice->Statistics.ReportsReceived++;
+  QueueReport (UsbHidDevice, (UINT8 *)Data, DataLength);
 
   return EFI_SUCCESS;
 }
@@ -445,6 +831,14 @@ DelayedRecoveryHandler (
 
   UsbHidDev = (USB_HID_DEV *)Context;
 
+  UsbHidDev->Statistics.Recoveries++;
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "[%a] recovering input reports (%ld recoveries).\n",
+    __FUNCTION__,
+    UsbHidDev->Statistics.Recoveries
+    ));
+
   // Re-submit Asynchronous Interrupt Transfer for recovery.
   Status = UsbHidDev->UsbIo->UsbAsyncInterruptTransfer (
                                UsbHidDev->UsbIo,
@@ -458,6 +852,101 @@ DelayedRecoveryHandler (
   ASSERT_EFI_ERROR (Status);
 }
 
+/**
+  Returns the input report counters of a device.
+
+  @param  UsbHidDevice          The UsbHidDevice instance to return the counters of.
+  @param  Statistics            Receives the counters.
+**/
+VOID
+GetReportStatistics (
+  IN  USB_HID_DEV               *UsbHidDevice,
+  OUT HID_IO_REPORT_STATISTICS  *Statistics
+  )
+{
+  EFI_TPL  OldTpl;
+
+  // The counters are updated at TPL_NOTIFY, so copy them at TPL_NOTIFY to get a consistent set.
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  CopyMem (Statistics, &UsbHidDevice->Statistics, sizeof (HID_IO_REPORT_STATISTICS));
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Frees the report ring of a device, with the drain and coalesce buffers that follow it.
+
+  @param  UsbHidDevice          The UsbHidDevice instance to free the report ring of.
+**/
+VOID
+FreeReportRing (
+  IN USB_HID_DEV  *UsbHidDevice
+  )
+{
+  FreePool (UsbHidDevice->ReportRing);
+  UsbHidDevice->ReportRing     = NULL;
+  UsbHidDevice->DrainBuffer    = NULL;
+  UsbHidDevice->CoalesceBuffer = NULL;
+}
+
+/**
+  Report drain handler. Signaled when reports are queued in the report ring, and delivers them to the report callback
+  in the order they were received.
+
+  @param  Event                 Event associated with this callback.
+  @param  Context               Context associated with the event (points to UsbHidDevice that owns the report ring)
+
+  @retval None
+**/
+VOID
+EFIAPI
+DrainReportRing (
+  IN    EFI_EVENT  Event,
+  IN    VOID       *Context
+  )
+{
+  USB_HID_DEV  *UsbHidDevice;
+  EFI_TPL      OldTpl;
+  UINT16       ReportLength;
+
+  UsbHidDevice = (USB_HID_DEV *)Context;
+
+  while (TRUE) {
+    // The ring is filled at TPL_NOTIFY, so take each report out of it at TPL_NOTIFY too. The report is copied out so
+    // that the callback runs at TPL_CALLBACK while new reports continue to be queued.
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    if (UsbHidDevice->ReportRingCount == 0) {
+      gBS->RestoreTPL (OldTpl);
+      break;
+    }
+
+    ReportLength = UsbHidDevice->ReportRingLength[UsbHidDevice->ReportRingHead];
+    CopyMem (
+      UsbHidDevice->DrainBuffer,
+      USB_HID_REPORT_RING_SLOT (UsbHidDevice, UsbHidDevice->ReportRingHead),
+      ReportLength
+      );
+    UsbHidDevice->ReportRingHead = (UsbHidDevice->ReportRingHead + 1) % USB_HID_REPORT_RING_SIZE;
+    UsbHidDevice->ReportRingCount--;
+    gBS->RestoreTPL (OldTpl);
+
+    if (UsbHidDevice->ReportCallback != NULL) {
+      UsbHidDevice->Delivering = TRUE;
+      UsbHidDevice->ReportCallback (
+                      ReportLength,
+                      UsbHidDevice->DrainBuffer,
+                      UsbHidDevice->CallbackContext
+                      );
+      UsbHidDevice->Delivering = FALSE;
+    }
+  }
+
+  // If the callback unregistered itself, input reports were shut down while it still had the report, so the report
+  // ring was left for this handler to free.
+  if ((UsbHidDevice->ReportDrainEvent == NULL) && (UsbHidDevice->ReportRing != NULL)) {
+    FreeReportRing (UsbHidDevice);
+  }
+}
+
 /**
   Initiates input reports from the endpoint by scheduling an async interrupt transaction to poll the device.
 
@@ -494,9 +983,47 @@ InitiateAsyncInterruptInputTransfers (
 
   if (EFI_ERROR (Status)) {
     ASSERT_EFI_ERROR (Status);
-    return Status;
+    UsbHidDevice->DelayedRecoveryEvent = NULL;
+    goto ErrorExit;
+  }
+
+  // Configure the report ring and the event that drains it. The ring holds USB_HID_REPORT_RING_SIZE reports, followed
+  // by one buffer the drain handler copies each report into and one buffer used to check reports for coalescing.
+  if (UsbHidDevice->ReportRing == NULL) {
+    UsbHidDevice->ReportRing = AllocateZeroPool (
+                                 (USB_HID_REPORT_RING_SIZE + 2) * UsbHidDevice->IntInEndpointDescriptor.MaxPacketSize
+                                 );
+    if (UsbHidDevice->ReportRing == NULL) {
+      ASSERT (UsbHidDevice->ReportRing != NULL);
+      Status = EFI_OUT_OF_RESOURCES;
+      goto ErrorExit;
+    }
+
+    UsbHidDevice->DrainBuffer    = USB_HID_REPORT_RING_SLOT (UsbHidDevice, USB_HID_REPORT_RING_SIZE);
+    UsbHidDevice->CoalesceBuffer = USB_HID_REPORT_RING_SLOT (UsbHidDevice, USB_HID_REPORT_RING_SIZE + 1);
   }
 
+  UsbHidDevice->ReportRingHead  = 0;
+  UsbHidDevice->ReportRingCount = 0;
+
+  if (UsbHidDevice->ReportDrainEvent == NULL) {
+    Status = gBS->CreateEvent (
+                    EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    DrainReportRing,
+                    UsbHidDevice,
+                    &UsbHidDevice->ReportDrainEvent
+                    );
+
+    if (EFI_ERROR (Status)) {
+      ASSERT_EFI_ERROR (Status);
+      UsbHidDevice->ReportDrainEvent = NULL;
+      goto ErrorExit;
+    }
+  }
+
+  FindMovementFields (UsbHidDevice);
+
   // Start the async interrupt transfers for input reports.
   Status = UsbHidDevice->UsbIo->UsbAsyncInterruptTransfer (
                                   UsbHidDevice->UsbIo,
@@ -507,8 +1034,33 @@ InitiateAsyncInterruptInputTransfers (
                                   OnReportInterruptComplete,
                                   UsbHidDevice
                                   );
+  if (!EFI_ERROR (Status)) {
+    return EFI_SUCCESS;
+  }
+
   ASSERT_EFI_ERROR (Status);
 
+ErrorExit:
+  // Release what was set up for input reports, so a failed start leaves nothing behind.
+  if (UsbHidDevice->ReportDrainEvent != NULL) {
+    gBS->CloseEvent (UsbHidDevice->ReportDrainEvent);
+    UsbHidDevice->ReportDrainEvent = NULL;
+  }
+
+  if (UsbHidDevice->DelayedRecoveryEvent != NULL) {
+    gBS->CloseEvent (UsbHidDevice->DelayedRecoveryEvent);
+    UsbHidDevice->DelayedRecoveryEvent = NULL;
+  }
+
+  // A report callback that restarts input reports from DrainReportRing still has the report in DrainBuffer, so the
+  // ring is left for DrainReportRing to free once the callback returns.
+  if ((UsbHidDevice->ReportRing != NULL) && !UsbHidDevice->Delivering) {
+    FreeReportRing (UsbHidDevice);
+  }
+
+  UsbHidDevice->ReportRingHead  = 0;
+  UsbHidDevice->ReportRingCount = 0;
+
   return Status;
 }
 
@@ -525,7 +1077,8 @@ ShutdownAsyncInterruptInputTransfers (
   USB_HID_DEV  *UsbHidDevice
   )
 {
-  EFI_STATUS  Status;
+  EFI_STATUS                Status;
+  HID_IO_REPORT_STATISTICS  Statistics;
 
   // Stop the async transfers for input reports.
   Status = UsbHidDevice->UsbIo->UsbAsyncInterruptTransfer (
@@ -552,6 +1105,38 @@ ShutdownAsyncInterruptInputTransfers (
     UsbHidDevice->DelayedRecoveryEvent = NULL;
   }
 
+  // Close the report drain event and discard any reports that have not been delivered.
+  if (UsbHidDevice->ReportDrainEvent != NULL) {
+    Status = gBS->CloseEvent (UsbHidDevice->ReportDrainEvent);
+    if (EFI_ERROR (Status) && (Status != EFI_NOT_FOUND)) {
+      DEBUG ((DEBUG_WARN, "[%a] unexpected error closing report drain event: %r\n", __FUNCTION__, Status));
+    }
+
+    UsbHidDevice->ReportDrainEvent = NULL;
+  }
+
+  if (UsbHidDevice->ReportRing != NULL) {
+    GetReportStatistics (UsbHidDevice, &Statistics);
+    DEBUG ((
+      DEBUG_INFO,
+      "[%a] input reports received: %ld, coalesced: %ld, dropped: %ld, recoveries: %ld\n",
+      __FUNCTION__,
+      Statistics.ReportsReceived,
+      Statistics.ReportsCoalesced,
+      Statistics.ReportsDropped,
+      Statistics.Recoveries
+      ));
+
+    // The report callback may be shutting down input reports from DrainReportRing, while it still has the report in
+    // DrainBuffer. DrainReportRing frees the ring once the callback returns.
+    if (!UsbHidDevice->Delivering) {
+      FreeReportRing (UsbHidDevice);
+    }
+  }
+
+  UsbHidDevice->ReportRingHead  = 0;
+  UsbHidDevice->ReportRingCount = 0;
+
   return Status;
 }
 
@@ -947,6 +1532,7 @@ UsbHidDriverBindingStart (
   UsbHidDevice->HidIo.SetReport                = HidSetReport;
   UsbHidDevice->HidIo.RegisterReportCallback   = HidRegisterReportCallback;
   UsbHidDevice->HidIo.UnregisterReportCallback = HidUnregisterReportCallback;
+  UsbHidDevice->HidIo.GetReportStatistics      = HidGetReportStatistics;
 
   Status = ReadDescriptors (UsbHidDevice);
   if (EFI_ERROR (Status)) {
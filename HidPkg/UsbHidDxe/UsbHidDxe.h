@@ -0,0 +1,272 @@
+/** @file
+  USB HID Driver that manages USB HID devices and produces the HidIo protocol.
+
+  Private definitions of the USB HID Driver, shared with its host based unit test.
+
+  Copyright (c) Microsoft Corporation. All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _USB_HID_DXE_H_
+#define _USB_HID_DXE_H_
+
+#include <Uefi.h>
+
+#include <Protocol/HidIo.h>
+
+#include <Protocol/DevicePath.h>
+#include <Protocol/DriverBinding.h>
+#include <Protocol/UsbIo.h>
+
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiUsbLib.h>
+
+#include <IndustryStandard/Usb.h>
+
+#define CLASS_HID      3
+#define SUBCLASS_BOOT  1
+
+// Refer to USB HID 1.11, section 7.2.6.
+#define BOOT_PROTOCOL    0
+#define REPORT_PROTOCOL  1
+
+//
+// A common header for usb standard descriptor.
+// Each stand descriptor has a length and type.
+//
+#pragma pack(1)
+typedef struct {
+  UINT8    Len;
+  UINT8    Type;
+} USB_DESC_HEAD;
+#pragma pack()
+
+#define USB_HID_DEV_SIGNATURE  SIGNATURE_32('U','H','I','D')
+
+// Number of input reports that can be queued between USB interrupt completion and delivery to the report callback.
+#define USB_HID_REPORT_RING_SIZE  32
+
+// Limits on the report descriptor scan that finds pointer movement fields. Fields beyond these limits are treated as
+// ordinary report data, which only makes reports less likely to be coalesced.
+#define USB_HID_MAX_MOVEMENT_FIELDS  16
+#define USB_HID_MAX_ITEM_USAGES      16
+
+// Short item prefixes (tag and type, with the size bits masked off). Refer to USB HID 1.11, section 6.2.2.
+#define HID_ITEM_SIZE_MASK          0x03
+#define HID_ITEM_TYPE_MASK          0x0C
+#define HID_ITEM_TYPE_MAIN          0x00
+#define HID_ITEM_LONG               0xFE
+#define HID_ITEM_INPUT              0x80
+#define HID_ITEM_USAGE_PAGE         0x04
+#define HID_ITEM_REPORT_SIZE        0x74
+#define HID_ITEM_REPORT_ID          0x84
+#define HID_ITEM_REPORT_COUNT       0x94
+#define HID_ITEM_PUSH               0xA4
+#define HID_ITEM_POP                0xB4
+#define HID_ITEM_USAGE              0x08
+#define HID_ITEM_USAGE_MINIMUM      0x18
+#define HID_ITEM_USAGE_MAXIMUM      0x28
+
+// Input item data bits.
+#define HID_MAIN_ITEM_CONSTANT  BIT0
+#define HID_MAIN_ITEM_VARIABLE  BIT1
+#define HID_MAIN_ITEM_RELATIVE  BIT2
+
+// Usages (page in the upper 16 bits) of the fields that may differ between two reports that are coalesced.
+#define HID_USAGE_GENERIC_DESKTOP_X      0x00010030
+#define HID_USAGE_GENERIC_DESKTOP_WHEEL  0x00010038
+#define HID_USAGE_CONSUMER_AC_PAN        0x000C0238
+#define HID_USAGE_DIGITIZER_SCAN_TIME    0x000D0056
+
+//
+// A pointer movement field (X, Y, wheel, etc.) within an input report.
+//
+typedef struct {
+  UINT8      ReportId;
+  BOOLEAN    Relative;
+  UINT16     BitOffset; // Offset within the report, not counting the report ID byte.
+  UINT8      BitSize;
+} USB_HID_MOVEMENT_FIELD;
+
+typedef struct {
+  UINT32                          Signature;
+  HID_IO_PROTOCOL                 HidIo;
+  EFI_USB_IO_PROTOCOL             *UsbIo;
+  EFI_USB_INTERFACE_DESCRIPTOR    InterfaceDescriptor;
+  EFI_USB_ENDPOINT_DESCRIPTOR     IntInEndpointDescriptor;
+  EFI_USB_HID_DESCRIPTOR          *HidDescriptor;
+  UINTN                           ReportDescriptorLength;
+  VOID                            *ReportDescriptor;
+  HID_IO_REPORT_CALLBACK          ReportCallback;
+  VOID                            *CallbackContext;
+  EFI_EVENT                       DelayedRecoveryEvent;
+  EFI_EVENT                       ReportDrainEvent;
+  UINT8                           *ReportRing;
+  UINT8                           *DrainBuffer;
+  UINT8                           *CoalesceBuffer;
+  UINT16                          ReportRingLength[USB_HID_REPORT_RING_SIZE];
+  UINTN                           ReportRingHead;
+  UINTN                           ReportRingCount;
+  BOOLEAN                         Delivering; // A report in DrainBuffer is being delivered to the report callback.
+  BOOLEAN                         ReportIdsPresent;
+  UINTN                           MovementFieldCount;
+  USB_HID_MOVEMENT_FIELD          MovementFields[USB_HID_MAX_MOVEMENT_FIELDS];
+  HID_IO_REPORT_STATISTICS        Statistics;
+} USB_HID_DEV;
+
+#define USB_HID_DEV_FROM_HID_IO_PROTOCOL(a) \
+    CR(a, USB_HID_DEV, HidIo, USB_HID_DEV_SIGNATURE)
+
+// Each report ring slot holds one interrupt transfer, which is at most MaxPacketSize bytes.
+#define USB_HID_REPORT_RING_SLOT(Device, Index) \
+    ((Device)->ReportRing + (Index) * (Device)->IntInEndpointDescriptor.MaxPacketSize)
+
+/**
+  Unregisters a previously registered callback function.
+  The device driver will do any necessary initialization to configure the device to stop sending reports.
+
+  @param  This                  A pointer to the HidIo Instance
+  @param  Callback              Callback function to unregister.
+
+  @retval EFI_SUCCESS           Callback successfully unregistered.
+  @retval EFI_INVALID_PARAMETER Invalid input parameters.
+  @retval EFI_NOT_STARTED       Callback function was not previously registered.
+  @retval Other                 Unexpected error unregistering report or disabling report generation from device.
+**/
+EFI_STATUS
+EFIAPI
+HidUnregisterReportCallback (
+  IN HID_IO_PROTOCOL         *This,
+  IN HID_IO_REPORT_CALLBACK  Callback
+  );
+
+/**
+  Retrieves the input report counters of the device.
+
+  @param  This                  A pointer to the HidIo Instance
+  @param  Statistics            Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS           Counters successfully returned.
+  @retval EFI_INVALID_PARAMETER Invalid input parameters.
+**/
+EFI_STATUS
+EFIAPI
+HidGetReportStatistics (
+  IN  HID_IO_PROTOCOL           *This,
+  OUT HID_IO_REPORT_STATISTICS  *Statistics
+  );
+
+/**
+  Scans the report descriptor for the pointer movement fields in the device's input reports, which allows consecutive
+  movement reports to be coalesced when the report callback cannot keep up with the device.
+
+  Coalescing is left disabled if the descriptor cannot be read or uses items this scan doesn't track.
+
+  @param  UsbHidDevice          The UsbHidDevice instance to scan the report descriptor for.
+**/
+VOID
+FindMovementFields (
+  IN USB_HID_DEV  *UsbHidDevice
+  );
+
+/**
+  Attempts to coalesce a report into the newest report waiting in the report ring. This is possible when the two
+  reports differ only in their pointer movement fields: absolute positions are replaced with the newer values, and
+  relative movements are summed, provided the sum still fits in the field.
+
+  @param  UsbHidDevice          The UsbHidDevice instance that received the report.
+  @param  Pending               The newest report waiting in the report ring. Updated if the report is coalesced.
+  @param  PendingLength         Length of the pending report.
+  @param  Report                The newly received report.
+  @param  ReportLength          Length of the newly received report.
+
+  @retval TRUE                  The report was coalesced into the pending report.
+  @retval FALSE                 The report must be queued separately.
+**/
+BOOLEAN
+CoalesceMovementReport (
+  IN     USB_HID_DEV  *UsbHidDevice,
+  IN OUT UINT8        *Pending,
+  IN     UINTN        PendingLength,
+  IN     CONST UINT8  *Report,
+  IN     UINTN        ReportLength
+  );
+
+/**
+  Queues a report received on USB interrupt completion for delivery to the report callback at TPL_CALLBACK. The report
+  is coalesced into the newest queued report if possible. If the report ring is full, the oldest queued report is
+  dropped to make room, so the callback always sees the latest state of the device.
+
+  Must be called at TPL_NOTIFY.
+
+  @param  UsbHidDevice          The UsbHidDevice instance that received the report.
+  @param  Report                The received report.
+  @param  ReportLength          Length of the received report.
+**/
+VOID
+QueueReport (
+  IN USB_HID_DEV  *UsbHidDevice,
+  IN CONST UINT8  *Report,
+  IN UINTN        ReportLength
+  );
+
+/**
+  Returns the input report counters of a device.
+
+  @param  UsbHidDevice          The UsbHidDevice instance to return the counters of.
+  @param  Statistics            Receives the counters.
+**/
+VOID
+GetReportStatistics (
+  IN  USB_HID_DEV               *UsbHidDevice,
+  OUT HID_IO_REPORT_STATISTICS  *Statistics
+  );
+
+/**
+  Report drain handler. Signaled when reports are queued in the report ring, and delivers them to the report callback
+  in the order they were received.
+
+  @param  Event                 Event associated with this callback.
+  @param  Context               Context associated with the event (points to UsbHidDevice that owns the report ring)
+
+  @retval None
+**/
+VOID
+EFIAPI
+DrainReportRing (
+  IN    EFI_EVENT  Event,
+  IN    VOID       *Context
+  );
+
+/**
+  Initiates input reports from the endpoint by scheduling an async interrupt transaction to poll the device.
+
+  @param  UsbHidDevice        The UsbHidDevice instance that is initiating transfers.
+
+  @retval EFI_SUCCESS         Async Interrupt transfer to read input reports has been successfully initiated.
+  @retval Other               Unexpected error initiating the transfer.
+**/
+EFI_STATUS
+InitiateAsyncInterruptInputTransfers (
+  USB_HID_DEV  *UsbHidDevice
+  );
+
+/**
+  Shuts down input reports from the endpoint by deleting the async interrupt transaction to poll the device.
+
+  @param  UsbHidDevice        The UsbHidDevice instance that is initiating transfers.
+
+  @retval EFI_SUCCESS         Async Interrupt transfer to read input reports has been successfully deleted.
+  @retval Other               Unexpected error deleting the transfer.
+**/
+EFI_STATUS
+ShutdownAsyncInterruptInputTransfers (
+  USB_HID_DEV  *UsbHidDevice
+  );
+
+#endif
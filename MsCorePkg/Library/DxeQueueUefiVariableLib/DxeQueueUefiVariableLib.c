@@ -2,6 +2,13 @@
 An interface for managing a queue.
 This can currently hold a max of 100000 items
 
+Each item is stored in its own variable, named by a decimal ID.  A header variable
+per queue keeps the ID of the first item, the ID for the next item and the count,
+so that counting, adding and removing items does not walk the variable store.  The
+header is written together with each item added or removed, and the change is rolled
+back if either write fails.  The header is rebuilt by walking the variable store when
+it is missing or inconsistent.
+
 Copyright (c) Microsoft Corporation. All rights reserved.
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -23,6 +30,19 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define DEFAULT_QUEUE_VAR_NAME    L"00000"
 #define DEFAULT_QUEUE_VAR_FORMAT  L"%d"
 #define DEFAULT_QUEUE_MODULO      100000
+#define DEFAULT_QUEUE_FIRST_ID    1
+
+#define QUEUE_HEADER_VAR_NAME   L"QueueHeader"
+#define QUEUE_HEADER_SIGNATURE  SIGNATURE_32('Q','H','D','R')
+
+#pragma pack(push, 1)
+typedef struct {
+  UINT32    Signature;
+  UINT32    HeadId;                         // ID of the oldest item in the queue
+  UINT32    NextId;                         // ID given to the next item added to the queue
+  UINT32    Count;                          // Number of items between HeadId and NextId
+} QUEUE_HEADER;
+#pragma pack(pop)
 
 /**
   Writes a variable name string for a given ID
@@ -126,26 +146,20 @@ GetNextQueueVariableName (
   UINTN       CurrentVariableSize;
   CHAR16      *VariableName;
 
-  DEBUG ((DEBUG_INFO, "%a:%d - \n", __FUNCTION__, __LINE__));
-
   if (VariableNamePtr == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  DEBUG ((DEBUG_INFO, "%a:%d - \n", __FUNCTION__, __LINE__));
   VariableName = *VariableNamePtr;
   // if they passed us a pointer to a null, allocate with the default size
   if (VariableName == NULL) {
     CurrentVariableSize = 60;
     VariableName        = AllocateZeroPool (CurrentVariableSize);
-    DEBUG ((DEBUG_INFO, "%a:%d - \n", __FUNCTION__, __LINE__));
   } else {
-    DEBUG ((DEBUG_INFO, "%a:%d - \n", __FUNCTION__, __LINE__));
     CurrentVariableSize = *VariableNameSize;
   }
 
   if (VariableName == NULL) {
-    DEBUG ((DEBUG_INFO, "%a:%d - \n", __FUNCTION__, __LINE__));
     return EFI_OUT_OF_RESOURCES;
   }
 
@@ -165,70 +179,396 @@ GetNextQueueVariableName (
 
     // check if we have a variable
     if (!EFI_ERROR (Status) && CompareGuid (VariableGuid, DesiredVariableGuid)) {
-      DEBUG ((DEBUG_INFO, "%a:%d - \n", __FUNCTION__, __LINE__));
       break;
     }
   }
 
   *VariableNameSize = CurrentVariableSize;
   *VariableNamePtr  = VariableName;
-  DEBUG ((DEBUG_INFO, "%a:%d - \n", __FUNCTION__, __LINE__));
   return Status;
 }
 
 /**
-  Gets the number of items currently in the queue.
+  Gets the size of the data of a queue item
 
-  @param[in]  QueueGuid               The Identifier of the queue in question
-  @param[out] ItemCount               The number of items that have been queued.
+  @param[in]    QueueGuid                   The Identifier of the queue in question
+  @param[in]    ItemId                      ID of the queue item
+  @param[out]   ItemDataSize                Size of the data of the item
 
-  @retval     EFI_SUCCESS             Everything went as expected.
-  @retval     EFI_INVALID_PARAMETER   ItemCount or QueueGuid are NULL
-**/
+  @retval       EFI_SUCCESS                 The item is in the queue
+  @retval       EFI_NOT_FOUND               There is no item with this ID
+  @retval       Other                       The variable could not be read
+*/
 EFI_STATUS
-EFIAPI
-GetQueueItemCount (
+STATIC
+GetQueueItemSize (
   IN  EFI_GUID  *QueueGuid,
-  OUT UINTN     *ItemCount
+  IN  UINTN     ItemId,
+  OUT UINTN     *ItemDataSize
+  )
+{
+  EFI_STATUS  Status;
+  CHAR16      VarName[] = DEFAULT_QUEUE_VAR_NAME;
+
+  Status = GenerateVarName (ItemId, VarName, sizeof (VarName));
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  *ItemDataSize = 0;
+  Status        = gRT->GetVariable (VarName, QueueGuid, NULL, ItemDataSize, NULL);
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    return EFI_SUCCESS;
+  }
+
+  return EFI_ERROR (Status) ? Status : EFI_NOT_FOUND;
+}
+
+/**
+  Checks that a queue header is consistent with itself
+
+  @param[in]    Header                      The header read from the variable store
+  @param[in]    HeaderSize                  Size of the header variable
+
+  @retval       TRUE                        The header can be used
+  @retval       FALSE                       The header must be rebuilt
+*/
+BOOLEAN
+STATIC
+IsQueueHeaderValid (
+  IN QUEUE_HEADER  *Header,
+  IN UINTN         HeaderSize
+  )
+{
+  return (HeaderSize == sizeof (QUEUE_HEADER)) &&
+         (Header->Signature == QUEUE_HEADER_SIGNATURE) &&
+         (Header->HeadId >= DEFAULT_QUEUE_FIRST_ID) &&
+         (Header->HeadId <= Header->NextId) &&
+         (Header->NextId <= DEFAULT_QUEUE_MODULO) &&
+         (Header->Count <= Header->NextId - Header->HeadId);
+}
+
+/**
+  Saves the header of a queue
+
+  An empty queue starts again from the first ID, so that IDs are not used up.
+
+  @param[in]      QueueGuid                 The Identifier of the queue in question
+  @param[in, out] Header                    The header to save
+
+  @retval         EFI_SUCCESS               The header was saved
+  @retval         Other                     The variable could not be written
+*/
+EFI_STATUS
+STATIC
+SetQueueHeader (
+  IN     EFI_GUID      *QueueGuid,
+  IN OUT QUEUE_HEADER  *Header
+  )
+{
+  if (Header->Count == 0) {
+    Header->HeadId = DEFAULT_QUEUE_FIRST_ID;
+    Header->NextId = DEFAULT_QUEUE_FIRST_ID;
+  }
+
+  Header->Signature = QUEUE_HEADER_SIGNATURE;
+  return gRT->SetVariable (
+                QUEUE_HEADER_VAR_NAME,
+                QueueGuid,
+                DEFAULT_QUEUE_VAR_ATTR,
+                sizeof (QUEUE_HEADER),
+                Header
+                );
+}
+
+/**
+  Rebuilds the header of a queue by walking the variable store
+
+  This is used when the header is missing, for example for a queue written by an
+  earlier version of this library, or when it does not match the items in the queue.
+
+  @param[in]    QueueGuid                   The Identifier of the queue in question
+  @param[out]   Header                      The rebuilt header
+
+  @retval       EFI_SUCCESS                 The header was rebuilt and saved
+  @retval       Other                       The variable store could not be walked
+*/
+EFI_STATUS
+STATIC
+RebuildQueueHeader (
+  IN  EFI_GUID      *QueueGuid,
+  OUT QUEUE_HEADER  *Header
   )
 {
   EFI_STATUS  Status;
   CHAR16      *VariableName;
   UINTN       VariableNameSize;
-  UINTN       CurrenQueueCount;
   EFI_GUID    VariableGuid;
-
-  if ((ItemCount == NULL) || (QueueGuid == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
+  UINTN       VarId;
+  UINTN       VarMinId;
+  UINTN       VarMaxId;
+  UINTN       Count;
 
   VariableName     = NULL;
-  CurrenQueueCount = 0;
+  VariableNameSize = 0;
+  VarMinId         = MAX_UINTN;
+  VarMaxId         = 0;
+  Count            = 0;
   Status           = EFI_SUCCESS;
 
-  // look for all the capsule queue variables
   while (Status == EFI_SUCCESS) {
     Status = GetNextQueueVariableName (&VariableName, &VariableGuid, &VariableNameSize, QueueGuid);
-    if (!EFI_ERROR (Status)) {
-      CurrenQueueCount += 1;
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    // the header, and anything else that is not an item, does not have a decimal name
+    if (EFI_ERROR (GetIdFromVarName (VariableName, VariableNameSize, &VarId)) ||
+        (VarId < DEFAULT_QUEUE_FIRST_ID) || (VarId >= DEFAULT_QUEUE_MODULO))
+    {
+      continue;
     }
+
+    VarMinId = MIN (VarMinId, VarId);
+    VarMaxId = MAX (VarMaxId, VarId);
+    Count   += 1;
+  }
+
+  if (VariableName != NULL) {
+    FreePool (VariableName);
   }
 
   // going all the way to the end of the varstore gives us a EFI_NOT_FOUND
-  if (Status == EFI_NOT_FOUND) {
-    Status = EFI_SUCCESS;
+  if (Status != EFI_NOT_FOUND) {
+    DEBUG ((DEBUG_ERROR, "[%a] - failed to walk the variable store - %r\n", __FUNCTION__, Status));
+    return Status;
   }
 
-  *ItemCount = CurrenQueueCount;
+  DEBUG ((DEBUG_INFO, "[%a] - rebuilt queue header with %u items\n", __FUNCTION__, (UINT32)Count));
 
-  if (VariableName != NULL) {
-    FreePool (VariableName);
-    VariableName = NULL;
+  Header->Count  = (UINT32)Count;
+  Header->HeadId = (UINT32)((Count == 0) ? DEFAULT_QUEUE_FIRST_ID : VarMinId);
+  Header->NextId = (UINT32)((Count == 0) ? DEFAULT_QUEUE_FIRST_ID : VarMaxId + 1);
+  Status         = SetQueueHeader (QueueGuid, Header);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "[%a] - failed to save queue header - %r\n", __FUNCTION__, Status));
   }
 
   return Status;
 }
 
+/**
+  Reads the header of a queue, rebuilding it if it is missing or invalid
+
+  @param[in]    QueueGuid                   The Identifier of the queue in question
+  @param[out]   Header                      The header of the queue
+
+  @retval       EFI_SUCCESS                 Header holds the header of the queue
+  @retval       Other                       The header could not be read or rebuilt
+*/
+EFI_STATUS
+STATIC
+GetQueueHeader (
+  IN  EFI_GUID      *QueueGuid,
+  OUT QUEUE_HEADER  *Header
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       HeaderSize;
+
+  HeaderSize = sizeof (QUEUE_HEADER);
+  Status     = gRT->GetVariable (QUEUE_HEADER_VAR_NAME, QueueGuid, NULL, &HeaderSize, Header);
+  if (!EFI_ERROR (Status) && IsQueueHeaderValid (Header, HeaderSize)) {
+    return EFI_SUCCESS;
+  }
+
+  return RebuildQueueHeader (QueueGuid, Header);
+}
+
+/**
+  Finds the ID of the item at an index of the queue
+
+  When no item was removed from the middle of the queue, the IDs from HeadId to NextId
+  are all used and the ID is found without reading the variable store.  Otherwise the
+  IDs after HeadId are probed until the item is found.
+
+  @param[in]    QueueGuid                   The Identifier of the queue in question
+  @param[in]    Header                      The header of the queue
+  @param[in]    ItemIndex                   The index of the item in the queue
+  @param[out]   ItemId                      ID of the item
+  @param[out]   ItemDataSize                Size of the data of the item
+
+  @retval       EFI_SUCCESS                 The item was found
+  @retval       EFI_NOT_FOUND               The queue holds ItemIndex items or fewer
+  @retval       EFI_VOLUME_CORRUPTED        The header does not match the items in the queue
+  @retval       Other                       The variable store could not be read
+*/
+EFI_STATUS
+STATIC
+FindQueueItem (
+  IN  EFI_GUID      *QueueGuid,
+  IN  QUEUE_HEADER  *Header,
+  IN  UINTN         ItemIndex,
+  OUT UINTN         *ItemId,
+  OUT UINTN         *ItemDataSize
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       VarId;
+
+  if (ItemIndex >= Header->Count) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (Header->Count == Header->NextId - Header->HeadId) {
+    *ItemId = Header->HeadId + ItemIndex;
+    Status  = GetQueueItemSize (QueueGuid, *ItemId, ItemDataSize);
+    return (Status == EFI_NOT_FOUND) ? EFI_VOLUME_CORRUPTED : Status;
+  }
+
+  for (VarId = Header->HeadId; VarId < Header->NextId; VarId++) {
+    Status = GetQueueItemSize (QueueGuid, VarId, ItemDataSize);
+    if (Status == EFI_NOT_FOUND) {
+      continue;
+    }
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    if (ItemIndex == 0) {
+      *ItemId = VarId;
+      return EFI_SUCCESS;
+    }
+
+    ItemIndex -= 1;
+  }
+
+  return EFI_VOLUME_CORRUPTED;
+}
+
+/**
+  Finds the item at an index of the queue, rebuilding the header once if it does not
+  match the items in the queue
+
+  @param[in]    QueueGuid                   The Identifier of the queue in question
+  @param[in]    ItemIndex                   The index of the item in the queue
+  @param[out]   Header                      The header of the queue
+  @param[out]   ItemId                      ID of the item
+  @param[out]   ItemDataSize                Size of the data of the item
+
+  @retval       EFI_SUCCESS                 The item was found
+  @retval       EFI_NOT_FOUND               The queue holds ItemIndex items or fewer
+  @retval       Other                       The variable store could not be read
+*/
+EFI_STATUS
+STATIC
+LocateQueueItem (
+  IN  EFI_GUID      *QueueGuid,
+  IN  UINTN         ItemIndex,
+  OUT QUEUE_HEADER  *Header,
+  OUT UINTN         *ItemId,
+  OUT UINTN         *ItemDataSize
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = GetQueueHeader (QueueGuid, Header);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = FindQueueItem (QueueGuid, Header, ItemIndex, ItemId, ItemDataSize);
+  if (Status == EFI_VOLUME_CORRUPTED) {
+    DEBUG ((DEBUG_WARN, "[%a] - queue header does not match the queue, rebuilding it\n", __FUNCTION__));
+    Status = RebuildQueueHeader (QueueGuid, Header);
+    if (!EFI_ERROR (Status)) {
+      Status = FindQueueItem (QueueGuid, Header, ItemIndex, ItemId, ItemDataSize);
+    }
+  }
+
+  return (Status == EFI_VOLUME_CORRUPTED) ? EFI_NOT_FOUND : Status;
+}
+
+/**
+  Reads the data of a queue item into an allocated buffer
+
+  @param[in]    QueueGuid                   The Identifier of the queue in question
+  @param[in]    ItemId                      ID of the queue item
+  @param[in]    ItemDataSize                Size of the data of the item
+  @param[out]   ItemData                    The allocated buffer holding the data
+
+  @retval       EFI_SUCCESS                 The data was read
+  @retval       EFI_OUT_OF_RESOURCES        The buffer could not be allocated
+  @retval       Other                       The variable could not be read
+*/
+EFI_STATUS
+STATIC
+ReadQueueItem (
+  IN  EFI_GUID  *QueueGuid,
+  IN  UINTN     ItemId,
+  IN  UINTN     ItemDataSize,
+  OUT VOID      **ItemData
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *VariableData;
+  CHAR16      VarName[] = DEFAULT_QUEUE_VAR_NAME;
+
+  Status = GenerateVarName (ItemId, VarName, sizeof (VarName));
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  VariableData = AllocatePool (ItemDataSize);
+  if (VariableData == NULL) {
+    DEBUG ((DEBUG_ERROR, "[%a] - failed to allocate resources\n", __FUNCTION__));
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = gRT->GetVariable (VarName, QueueGuid, NULL, &ItemDataSize, VariableData);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "[%a] - failed to read variable data\n", __FUNCTION__));
+    FreePool (VariableData);
+    return Status;
+  }
+
+  *ItemData = VariableData;
+  return EFI_SUCCESS;
+}
+
+/**
+  Gets the number of items currently in the queue.
+
+  @param[in]  QueueGuid               The Identifier of the queue in question
+  @param[out] ItemCount               The number of items that have been queued.
+
+  @retval     EFI_SUCCESS             Everything went as expected.
+  @retval     EFI_INVALID_PARAMETER   ItemCount or QueueGuid are NULL
+**/
+EFI_STATUS
+EFIAPI
+GetQueueItemCount (
+  IN  EFI_GUID  *QueueGuid,
+  OUT UINTN     *ItemCount
+  )
+{
+  EFI_STATUS    Status;
+  QUEUE_HEADER  Header;
+
+  if ((ItemCount == NULL) || (QueueGuid == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = GetQueueHeader (QueueGuid, &Header);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  *ItemCount = Header.Count;
+  return EFI_SUCCESS;
+}
+
 /**
   Adds an item to the back of the queue.
 
@@ -247,50 +587,36 @@ QueueAddItem (
   IN  UINTN     ItemDataSize
   )
 {
-  EFI_STATUS  Status;
-  CHAR16      *VariableName;
-  UINTN       VariableNameSize;
-  EFI_GUID    VariableGuid;
-  UINTN       VarCurrentId;
-  UINTN       VarMaxId;
-  CHAR16      NewVarName[] = DEFAULT_QUEUE_VAR_NAME;
+  EFI_STATUS    Status;
+  QUEUE_HEADER  Header;
+  UINTN         VariableDataSize;
+  CHAR16        NewVarName[] = DEFAULT_QUEUE_VAR_NAME;
 
   if ((QueueGuid == NULL) || (ItemData == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
-  VariableName = NULL;
-  Status       = EFI_SUCCESS;
-  VarMaxId     = 0;
-
-  // Step 1: get the ID of the last item in the queue
-  while (Status == EFI_SUCCESS) {
-    Status = GetNextQueueVariableName (&VariableName, &VariableGuid, &VariableNameSize, QueueGuid);
-    if (Status == EFI_NOT_FOUND) {
-      Status = EFI_SUCCESS;
-      break;
-    }
+  // Step 1: get the ID for the new item from the header
+  Status = GetQueueHeader (QueueGuid, &Header);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 
+  // an item that is already there was added without updating the header
+  if (GetQueueItemSize (QueueGuid, Header.NextId, &VariableDataSize) != EFI_NOT_FOUND) {
+    DEBUG ((DEBUG_WARN, "[%a] - queue header does not match the queue, rebuilding it\n", __FUNCTION__));
+    Status = RebuildQueueHeader (QueueGuid, &Header);
     if (EFI_ERROR (Status)) {
-      break;
+      return Status;
     }
-
-    Status   = GetIdFromVarName (VariableName, VariableNameSize, &VarCurrentId);
-    VarMaxId = MAX (VarMaxId, VarCurrentId);
   }
 
-  if (EFI_ERROR (Status)) {
-    goto Cleanup;
-  }
-
-  // step 2: Add one to that and generate a new variable name
-  VarMaxId += 1;
-  if (VarMaxId >= DEFAULT_QUEUE_MODULO) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Cleanup;
+  // step 2: generate the variable name of the new item
+  if (Header.NextId >= DEFAULT_QUEUE_MODULO) {
+    return EFI_OUT_OF_RESOURCES;
   }
 
-  Status = GenerateVarName (VarMaxId, NewVarName, sizeof (NewVarName));
+  Status = GenerateVarName (Header.NextId, NewVarName, sizeof (NewVarName));
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -303,11 +629,23 @@ QueueAddItem (
                   ItemDataSize,
                   ItemData
                   );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 
-Cleanup:
-  if (VariableName != NULL) {
-    FreePool (VariableName);
-    VariableName = NULL;
+  // step 4: update the header, removing the item again if the header cannot be saved
+  Header.NextId += 1;
+  Header.Count  += 1;
+  Status         = SetQueueHeader (QueueGuid, &Header);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "[%a] - failed to save queue header - %r\n", __FUNCTION__, Status));
+    gRT->SetVariable (
+           NewVarName,
+           QueueGuid,
+           DEFAULT_QUEUE_VAR_ATTR,
+           0,
+           NULL
+           );
   }
 
   return Status;
@@ -341,97 +679,89 @@ QueuePopItemAtIndex (
   OUT UINTN     *ItemDataSize OPTIONAL
   )
 {
-  EFI_STATUS  Status;
-  CHAR16      *VariableName;
-  UINTN       VariableNameSize;
-  EFI_GUID    VariableGuid;
-  UINTN       VariableDataSize;
-  VOID        *VariableData;
-  UINTN       QueueIndex;
+  EFI_STATUS    Status;
+  QUEUE_HEADER  Header;
+  QUEUE_HEADER  OldHeader;
+  UINTN         ItemId;
+  UINTN         VariableDataSize;
+  UINTN         HeadDataSize;
+  VOID          *VariableData;
+  CHAR16        VarName[] = DEFAULT_QUEUE_VAR_NAME;
 
   if (QueueGuid == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  VariableName     = NULL;
-  Status           = EFI_SUCCESS;
-  VariableData     = NULL;
-  QueueIndex       = 0;
-  VariableDataSize = 0;
-
-  // Step 1: find the variable of the first item in the queue.
-  do {
-    Status = GetNextQueueVariableName (&VariableName, &VariableGuid, &VariableNameSize, QueueGuid);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "[%a] - failed to find next item in queue\n", __FUNCTION__));
-      goto Cleanup;
-    }
-
-    QueueIndex += 1;
-  } while (Status == EFI_SUCCESS && QueueIndex <= ItemIndex);
+  VariableData = NULL;
 
+  // Step 1: find the variable of the item in the queue.
+  Status = LocateQueueItem (QueueGuid, ItemIndex, &Header, &ItemId, &VariableDataSize);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "[%a] - failed to find the queue item at index %d\n", __FUNCTION__, ItemIndex));
-    goto Cleanup;
+    return Status;
   }
 
   // if they passed in non null pointers, we should return the variable data
   if ((ItemData != NULL) && (ItemDataSize != NULL)) {
-    // Step 2: figure out how big the variable is and allocate the data for it
-    Status = gRT->GetVariable (
-                    VariableName,
-                    QueueGuid,
-                    NULL,
-                    &VariableDataSize,
-                    NULL
-                    );
-    if (Status != EFI_BUFFER_TOO_SMALL) {
-      DEBUG ((DEBUG_ERROR, "[%a] - failed to get size of variable data\n", __FUNCTION__));
-      goto Cleanup;
+    // Step 2: read in the data to an allocated buffer
+    Status = ReadQueueItem (QueueGuid, ItemId, VariableDataSize, &VariableData);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
+  }
 
-    VariableData = AllocatePool (VariableDataSize);
-    if (VariableData == NULL) {
-      DEBUG ((DEBUG_ERROR, "[%a] - failed to allocate resources\n", __FUNCTION__));
-      Status = EFI_OUT_OF_RESOURCES;
-      goto Cleanup;
+  // step 3: update the header, moving the head past any items removed from the middle
+  CopyMem (&OldHeader, &Header, sizeof (QUEUE_HEADER));
+  Header.Count -= 1;
+  if (ItemId == Header.HeadId) {
+    Header.HeadId += 1;
+    while ((Header.Count < Header.NextId - Header.HeadId) &&
+           (GetQueueItemSize (QueueGuid, Header.HeadId, &HeadDataSize) == EFI_NOT_FOUND))
+    {
+      Header.HeadId += 1;
     }
+  } else if (ItemId == Header.NextId - 1) {
+    Header.NextId -= 1;
+  }
+
+  Status = SetQueueHeader (QueueGuid, &Header);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "[%a] - failed to save queue header - %r\n", __FUNCTION__, Status));
+    goto Exit;
+  }
 
-    // step 3: read in the data to the new allocated buffer
-    Status = gRT->GetVariable (
-                    VariableName,
+  // step 4: delete the variable, restoring the header if it cannot be deleted
+  Status = GenerateVarName (ItemId, VarName, sizeof (VarName));
+  if (!EFI_ERROR (Status)) {
+    Status = gRT->SetVariable (
+                    VarName,
                     QueueGuid,
-                    NULL,
-                    &VariableDataSize,
-                    VariableData
+                    DEFAULT_QUEUE_VAR_ATTR,
+                    0,
+                    NULL
                     );
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "[%a] - failed to read variable data\n", __FUNCTION__));
-      goto Cleanup;
-    }
-
-    // step 4: set the return pointer correctly
-    *ItemData     = VariableData;
-    *ItemDataSize = VariableDataSize;
   }
 
-  // step 5: delete the variable
-  Status = gRT->SetVariable (
-                  VariableName,
-                  QueueGuid,
-                  DEFAULT_QUEUE_VAR_ATTR,
-                  0,
-                  NULL
-                  );
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "[%a] - failed to delete variable\n", __FUNCTION__));
-    goto Cleanup;
+    if (EFI_ERROR (SetQueueHeader (QueueGuid, &OldHeader))) {
+      // the header is rebuilt the next time it does not match the queue
+      DEBUG ((DEBUG_ERROR, "[%a] - failed to restore queue header\n", __FUNCTION__));
+    }
+
+    goto Exit;
   }
 
-Cleanup:
-  if (VariableName != NULL) {
-    FreePool (VariableName);
-    VariableName = NULL;
+  // step 5: set the return pointer correctly
+  if (VariableData != NULL) {
+    *ItemData     = VariableData;
+    *ItemDataSize = VariableDataSize;
+    VariableData  = NULL;
+  }
+
+Exit:
+  if (VariableData != NULL) {
+    FreePool (VariableData);
   }
 
   return Status;
@@ -488,13 +818,11 @@ QueuePeekAtIndex (
   OUT UINTN     *ItemDataSize
   )
 {
-  EFI_STATUS  Status;
-  CHAR16      *VariableName;
-  UINTN       VariableNameSize;
-  EFI_GUID    VariableGuid;
-  UINTN       VariableDataSize;
-  VOID        *VariableData;
-  UINTN       QueueIndex;
+  EFI_STATUS    Status;
+  QUEUE_HEADER  Header;
+  UINTN         ItemId;
+  UINTN         VariableDataSize;
+  VOID          *VariableData;
 
   if (QueueGuid == NULL) {
     DEBUG ((DEBUG_ERROR, "[%a] - invalid parameter as QueueGuid is NULL\n", __FUNCTION__));
@@ -511,72 +839,21 @@ QueuePeekAtIndex (
     return EFI_INVALID_PARAMETER;
   }
 
-  // Step 1: find the variable name of the item at the specific index (if it exists)
-  VariableName     = NULL;
-  Status           = EFI_SUCCESS;
-  VariableData     = NULL;
-  QueueIndex       = 0;
-  VariableDataSize = 0;
-
-  do {
-    Status = GetNextQueueVariableName (&VariableName, &VariableGuid, &VariableNameSize, QueueGuid);
-
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "[%a] - failed to find next item in queue\n", __FUNCTION__));
-      goto Cleanup;
-    }
-
-    QueueIndex += 1;
-  } while (Status == EFI_SUCCESS && QueueIndex <= ItemIndex);
-
+  // Step 1: find the variable of the item at the specific index (if it exists)
+  Status = LocateQueueItem (QueueGuid, ItemIndex, &Header, &ItemId, &VariableDataSize);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "[%a] - failed to find the queue item at index %d\n", __FUNCTION__, ItemIndex));
-    goto Cleanup;
-  }
-
-  // Step 2: figure out how big the variable is and allocate the data for it
-  Status = gRT->GetVariable (
-                  VariableName,
-                  QueueGuid,
-                  NULL,
-                  &VariableDataSize,
-                  NULL
-                  );
-  if (EFI_ERROR (Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-    DEBUG ((DEBUG_ERROR, "[%a] - failed to find variable\n", __FUNCTION__));
-    goto Cleanup;
-  }
-
-  VariableData = AllocatePool (VariableDataSize);
-  if (VariableData == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "[%a] - failed to allocate resources\n", __FUNCTION__));
-    goto Cleanup;
+    return Status;
   }
 
-  // step 3: read in the data to the new allocated buffer
-  Status = gRT->GetVariable (
-                  VariableName,
-                  QueueGuid,
-                  NULL,
-                  &VariableDataSize,
-                  VariableData
-                  );
+  // Step 2: read in the data to an allocated buffer
+  Status = ReadQueueItem (QueueGuid, ItemId, VariableDataSize, &VariableData);
   if (EFI_ERROR (Status)) {
-    FreePool (VariableData);
-    DEBUG ((DEBUG_ERROR, "[%a] - failed to read in variable\n", __FUNCTION__));
-    goto Cleanup;
+    return Status;
   }
 
-  // step 4: set the return pointer correctly
+  // step 3: set the return pointer correctly
   *ItemData     = VariableData;
   *ItemDataSize = VariableDataSize;
-
-Cleanup:
-  if (VariableName != NULL) {
-    FreePool (VariableName);
-    VariableName = NULL;
-  }
-
-  return Status;
+  return EFI_SUCCESS;
 }
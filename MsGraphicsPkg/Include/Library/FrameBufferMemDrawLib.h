@@ -49,4 +49,55 @@ MemFillOnFrameBuffer (
   IN  INT32   HeightInPixels
   );
 
+//
+// Operations of a draw list command.
+//
+typedef enum {
+  MemDrawFill,            // Fill the rectangle with Color1.
+  MemDrawCopy,            // Copy Data, rows of 32 bit pixels, into the rectangle.
+  MemDrawExpand1Bpp,      // Expand Data, rows of 1 bit pixels with the first pixel in the high
+                          // bit of each byte, drawing set bits in Color1 and clear bits in Color2.
+  MemDrawCheckerboard     // Fill the rectangle with squares of SquareSize pixels, starting with a
+                          // Color1 square in the top-left corner, alternating with Color2.
+} MEM_DRAW_OPERATION;
+
+//
+// One primitive of a draw list.  Coordinates and sizes are in pixels.
+//
+typedef struct {
+  MEM_DRAW_OPERATION    Operation;
+  INT32                 X;
+  INT32                 Y;
+  INT32                 Width;
+  INT32                 Height;
+  UINT32                Color1;
+  UINT32                Color2;
+  CONST VOID            *Data;       // MemDrawCopy and MemDrawExpand1Bpp only.
+  INTN                  Delta;       // Bytes from the start of one row of Data to the next.  0 draws
+                                     // the first row on every row, and a negative Delta walks up.
+  INT32                 SquareSize;  // MemDrawCheckerboard only.
+} MEM_DRAW_COMMAND;
+
+/**
+Function to draw a list of primitives onto the frame buffer
+We assume colors and data are in 32 bit RGB reserved format
+
+The frame buffer configuration is checked once for the whole list, and every command is
+checked against the frame buffer before any is drawn.
+
+@param Commands          - The primitives to draw, in order
+@param CommandCount      - Number of commands in Commands
+
+@retval EFI_SUCCESS            - All of the commands were drawn.
+@retval EFI_INVALID_PARAMETER  - A command is invalid or outside of the frame buffer.  Nothing
+                                 was drawn.
+@retval Others                 - The frame buffer is not ready to draw.
+**/
+EFI_STATUS
+EFIAPI
+MemDrawListOnFrameBuffer (
+  IN  CONST MEM_DRAW_COMMAND  *Commands,
+  IN  UINTN                   CommandCount
+  );
+
 #endif
@@ -101,6 +101,15 @@ typedef struct {
   } State;
 } SWM_INPUT_STATE;
 
+// Pointer event queue statistics of a client.
+//
+typedef struct {
+  UINTN    Depth;                                   // Pointer events waiting to be read.
+  UINTN    HighWater;                               // Largest number of pointer events that were waiting.
+  UINTN    Dropped;                                 // Oldest pointer events dropped because the queue was full.
+  UINTN    Coalesced;                               // Pointer moves merged into the newest queued move.
+} SWM_POINTER_QUEUE_STATISTICS;
+
 // ****** Preprocessor constants ******
 //
 
@@ -235,19 +244,28 @@ EFI_STATUS
   IN BOOLEAN         ContinueTimer
   );
 
+typedef
+EFI_STATUS
+(EFIAPI *MS_SWM_GET_POINTER_QUEUE_STATISTICS)(
+  IN  MS_SIMPLE_WINDOW_MANAGER_PROTOCOL   *This,
+  IN  EFI_HANDLE                          ImageHandle,
+  OUT SWM_POINTER_QUEUE_STATISTICS        *Statistics
+  );
+
 // SWM protocol structure
 //
 struct _MS_SIMPLE_WINDOW_MANAGER_PROTOCOL {
   // Client Messaging and Window Interface
   //
-  MS_SWM_REGISTER_CLIENT         RegisterClient;
-  MS_SWM_UNREGISTER_CLIENT       UnregisterClient;
-  MS_SWM_ACTIVATE_WINDOW         ActivateWindow;
-  MS_SWM_SET_WINDOW_FRAME        SetWindowFrame;
-  MS_SWM_BLT_WINDOW              BltWindow;
-  MS_SWM_STRING_TO_WINDOW        StringToWindow;
-  MS_SWM_ENABLE_MOUSE_POINTER    EnableMousePointer;
-  MS_SWM_WAIT_FOR_EVENT          WaitForEvent;
+  MS_SWM_REGISTER_CLIENT                 RegisterClient;
+  MS_SWM_UNREGISTER_CLIENT               UnregisterClient;
+  MS_SWM_ACTIVATE_WINDOW                 ActivateWindow;
+  MS_SWM_SET_WINDOW_FRAME                SetWindowFrame;
+  MS_SWM_BLT_WINDOW                      BltWindow;
+  MS_SWM_STRING_TO_WINDOW                StringToWindow;
+  MS_SWM_ENABLE_MOUSE_POINTER            EnableMousePointer;
+  MS_SWM_WAIT_FOR_EVENT                  WaitForEvent;
+  MS_SWM_GET_POINTER_QUEUE_STATISTICS    GetPointerQueueStatistics;
 };
 
 extern EFI_GUID  gMsSWMProtocolGuid;
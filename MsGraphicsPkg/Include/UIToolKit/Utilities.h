@@ -104,4 +104,63 @@ BuildFontDisplayInfoFromFontInfo (
   IN EFI_FONT_INFO  *FontInfo
   );
 
+/**
+    Calculates the width and height of the specified text string as it is rendered.  Measurements are cached.
+
+    @param[in]      pString             The string to measure.  A NULL or empty string is measured as a single space.
+    @param[in]      FontInfo            Font information (defines size, style, etc.).
+    @param[in]      HiiFlags            HII flags the string is rendered with.
+    @param[in]      MaxWidth            Width the string is wrapped or clipped to.
+    @param[in]      MaxHeight           Height the string is clipped to.
+    @param[out]     Width               Width of the rendered string, or 0 if no rows are rendered.
+    @param[out]     Height              Height of the rendered string, or 0 if no rows are rendered.
+
+    @retval         EFI_SUCCESS
+
+**/
+
+EFI_STATUS
+EFIAPI
+GetTextStringMetrics (
+  IN  CHAR16             *pString,
+  IN  EFI_FONT_INFO      *FontInfo,
+  IN  EFI_HII_OUT_FLAGS  HiiFlags,
+  IN  UINT32             MaxWidth,
+  IN  UINT32             MaxHeight,
+  OUT UINT32             *Width,
+  OUT UINT32             *Height
+  );
+
+/**
+    Draws the specified text string to the window, filling the area the text covers with the background color.
+    Rendered text is cached, so redrawing the same text only copies the cached bitmap to the window.
+
+    @param[in]      pString             The string to draw.
+    @param[in]      FontInfo            Font information (defines size, style, etc.).
+    @param[in]      HiiFlags            HII flags the string is rendered with.
+    @param[in]      TextColor           Text color.
+    @param[in]      BackgroundColor     Background color.
+    @param[in]      OrigX               X-coordinate of the text.
+    @param[in]      OrigY               Y-coordinate of the text.
+    @param[in]      MaxWidth            Width the string is wrapped or clipped to.
+    @param[in]      MaxHeight           Height the string is clipped to.
+
+    @retval         EFI_SUCCESS
+
+**/
+
+EFI_STATUS
+EFIAPI
+DrawTextString (
+  IN CHAR16                         *pString,
+  IN EFI_FONT_INFO                  *FontInfo,
+  IN EFI_HII_OUT_FLAGS              HiiFlags,
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *TextColor,
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *BackgroundColor,
+  IN UINT32                         OrigX,
+  IN UINT32                         OrigY,
+  IN UINT32                         MaxWidth,
+  IN UINT32                         MaxHeight
+  );
+
 #endif // _UIT_UTILITIES_H_.
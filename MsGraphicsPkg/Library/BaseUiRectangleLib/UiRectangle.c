@@ -108,76 +108,94 @@ DrawRect (
   IN  UI_RECTANGLE  *this
   )
 {
-  EFI_STATUS            Status;
-  PRIVATE_UI_RECTANGLE  *priv = (PRIVATE_UI_RECTANGLE *)this;
-
-  for (INTN y = 0; y < (INTN)this->Height; y++) {
-    // each row
-    UINT32  *temp = NULL;
-    switch (this->StyleInfo.FillType) {
-      case FILL_SOLID:
-      case FILL_VERTICAL_STRIPE:
-        temp = (UINT32 *)priv->FillData;
-        break;
+  PRIVATE_UI_RECTANGLE    *priv = (PRIVATE_UI_RECTANGLE *)this;
+  UI_RECTANGLE_DRAW_LIST  List;
+  MEM_DRAW_COMMAND        Command;
 
-      case FILL_HORIZONTAL_STRIPE:
-        temp = (UINT32 *)priv->FillData;  // set to first row...else set to 2nd row
-        if (((y / priv->Public.StyleInfo.FillTypeInfo.StripeFill.StripeSize) % 2) == 0) {
-          // temp is uint32 pointer so move it forward by pixels
-          temp += priv->Public.Width;
-        }
+  List.Count  = 0;
+  List.Status = EFI_SUCCESS;
 
-        break;
-
-      case FILL_FORWARD_STRIPE:
-        temp  = (UINT32 *)priv->FillData;
-        temp += (y % priv->Public.Height);  // Add 1 each time
-        break;
-
-      case FILL_BACKWARD_STRIPE:
-        temp  = (UINT32 *)priv->FillData;
-        temp += (priv->Public.Height - (y % priv->Public.Height));
-        break;
-
-      case FILL_CHECKERBOARD:
-        temp = (UINT32 *)priv->FillData;
-        if (((y / priv->Public.StyleInfo.FillTypeInfo.CheckerboardFill.CheckboardWidth) % 2) == 0) {
-          temp += priv->Public.StyleInfo.FillTypeInfo.CheckerboardFill.CheckboardWidth;
-        }
+  ZeroMem (&Command, sizeof (Command));
+  Command.X      = (INT32)this->UpperLeft.X;
+  Command.Y      = (INT32)this->UpperLeft.Y;
+  Command.Width  = (INT32)this->Width;
+  Command.Height = (INT32)this->Height;
 
-        break;
+  switch (this->StyleInfo.FillType) {
+    case FILL_SOLID:
+      Command.Operation = MemDrawFill;
+      Command.Color1    = this->StyleInfo.FillTypeInfo.SolidFill.FillColor;
+      AddDrawCommand (&List, &Command);
+      break;
 
-      case FILL_POLKA_SQUARES:
-        temp = (UINT32 *)priv->FillData;  // set to first row
+    case FILL_CHECKERBOARD:
+      // Rows of even bands start with a Color2 square
+      Command.Operation  = MemDrawCheckerboard;
+      Command.Color1     = this->StyleInfo.FillTypeInfo.CheckerboardFill.Color2;
+      Command.Color2     = this->StyleInfo.FillTypeInfo.CheckerboardFill.Color1;
+      Command.SquareSize = this->StyleInfo.FillTypeInfo.CheckerboardFill.CheckboardWidth;
+      AddDrawCommand (&List, &Command);
+      break;
 
-        if (((y + (priv->Public.StyleInfo.FillTypeInfo.PolkaSquareFill.DistanceBetweenSquares / 2)) % (priv->Public.StyleInfo.FillTypeInfo.PolkaSquareFill.DistanceBetweenSquares + priv->Public.StyleInfo.FillTypeInfo.PolkaSquareFill.SquareWidth)) > priv->Public.StyleInfo.FillTypeInfo.PolkaSquareFill.DistanceBetweenSquares) {
-          // temp is uint32 pointer so move it forward by pixels
-          temp += priv->Public.Width;
+    default:
+      for (INTN y = 0; y < (INTN)this->Height; y++) {
+        // each row
+        UINT32  *temp = NULL;
+        switch (this->StyleInfo.FillType) {
+          case FILL_VERTICAL_STRIPE:
+            temp = (UINT32 *)priv->FillData;
+            break;
+
+          case FILL_HORIZONTAL_STRIPE:
+            temp = (UINT32 *)priv->FillData;  // set to first row...else set to 2nd row
+            if (((y / priv->Public.StyleInfo.FillTypeInfo.StripeFill.StripeSize) % 2) == 0) {
+              // temp is uint32 pointer so move it forward by pixels
+              temp += priv->Public.Width;
+            }
+
+            break;
+
+          case FILL_FORWARD_STRIPE:
+            temp  = (UINT32 *)priv->FillData;
+            temp += (y % priv->Public.Height);  // Add 1 each time
+            break;
+
+          case FILL_BACKWARD_STRIPE:
+            temp  = (UINT32 *)priv->FillData;
+            temp += (priv->Public.Height - (y % priv->Public.Height));
+            break;
+
+          case FILL_POLKA_SQUARES:
+            temp = (UINT32 *)priv->FillData;  // set to first row
+
+            if (((y + (priv->Public.StyleInfo.FillTypeInfo.PolkaSquareFill.DistanceBetweenSquares / 2)) % (priv->Public.StyleInfo.FillTypeInfo.PolkaSquareFill.DistanceBetweenSquares + priv->Public.StyleInfo.FillTypeInfo.PolkaSquareFill.SquareWidth)) > priv->Public.StyleInfo.FillTypeInfo.PolkaSquareFill.DistanceBetweenSquares) {
+              // temp is uint32 pointer so move it forward by pixels
+              temp += priv->Public.Width;
+            }
+
+            break;
+
+          default:
+            DEBUG ((DEBUG_ERROR, "Unsupported Fill Type.  Cant draw Rectangle  0x%X\n", this->StyleInfo.FillType));
+            return;
         }
 
-        break;
-
-      default:
-        DEBUG ((DEBUG_ERROR, "Unsupported Fill Type.  Cant draw Rectangle  0x%X\n", this->StyleInfo.FillType));
-        return;
-    }
+        // rows that step evenly through the fill data are drawn as one command
+        AddDrawRow (&List, temp, (INT32)this->UpperLeft.X, (INT32)(this->UpperLeft.Y + y), (INT32)this->Width);
+      }
 
-    // we draw it one row at a time
-    Status = MemDrawOnFrameBuffer (temp, (INT32)this->UpperLeft.X, (INT32)(this->UpperLeft.Y + y), (INT32)this->Width, 1);
-    if (EFI_ERROR (Status)) {
-      // We check if we failed but we don't assert
-      DEBUG ((DEBUG_ERROR, "Failed to draw on the UIRectangle\n"));
       break;
-    }
   }
 
   if (this->StyleInfo.Border.BorderWidth > 0) {
-    DrawBorder (priv);
+    DrawBorder (priv, &List);
   }
 
   if (this->StyleInfo.IconInfo.PixelData != NULL) {
-    DrawIcon (priv);
+    DrawIcon (priv, &List);
   }
+
+  FlushDrawList (&List);
 }
 
 /***  PRIVATE METHODS ***/
@@ -320,65 +338,134 @@ PRIVATE_Init (
   }
 }
 
+/**
+Method used to add a command to the draw list, drawing the list first if it is full.
+**/
+VOID
+AddDrawCommand (
+  IN UI_RECTANGLE_DRAW_LIST  *List,
+  IN CONST MEM_DRAW_COMMAND  *Command
+  )
+{
+  if (List->Count == UI_RECTANGLE_MAX_DRAW_COMMANDS) {
+    FlushDrawList (List);
+  }
+
+  List->Commands[List->Count++] = *Command;
+}
+
+/**
+Method used to add one row of pixels to the draw list.  A row that carries on from the
+rows of the last command, at the same step through the pixel data, grows that command.
+**/
+VOID
+AddDrawRow (
+  IN UI_RECTANGLE_DRAW_LIST  *List,
+  IN CONST UINT32            *Row,
+  IN INT32                   X,
+  IN INT32                   Y,
+  IN INT32                   Width
+  )
+{
+  MEM_DRAW_COMMAND  *Last;
+  MEM_DRAW_COMMAND  Command;
+
+  if (List->Count > 0) {
+    Last = &List->Commands[List->Count - 1];
+    if ((Last->Operation == MemDrawCopy) && (Last->X == X) && (Last->Width == Width) && (Last->Y + Last->Height == Y)) {
+      if (Last->Height == 1) {
+        Last->Delta = (CONST UINT8 *)Row - (CONST UINT8 *)Last->Data;
+        Last->Height++;
+        return;
+      }
+
+      if ((CONST UINT8 *)Last->Data + (INTN)Last->Height * Last->Delta == (CONST UINT8 *)Row) {
+        Last->Height++;
+        return;
+      }
+    }
+  }
+
+  ZeroMem (&Command, sizeof (Command));
+  Command.Operation = MemDrawCopy;
+  Command.X         = X;
+  Command.Y         = Y;
+  Command.Width     = Width;
+  Command.Height    = 1;
+  Command.Data      = Row;
+  AddDrawCommand (List, &Command);
+}
+
+/**
+Method used to draw the commands in the draw list and empty it.
+**/
+VOID
+FlushDrawList (
+  IN UI_RECTANGLE_DRAW_LIST  *List
+  )
+{
+  // Once drawing has failed the rest of the rectangle is dropped
+  if ((List->Count > 0) && !EFI_ERROR (List->Status)) {
+    List->Status = MemDrawListOnFrameBuffer (List->Commands, List->Count);
+    if (EFI_ERROR (List->Status)) {
+      // We check if we failed but we don't assert
+      DEBUG ((DEBUG_ERROR, "Failed to draw on the UIRectangle\n"));
+    }
+  }
+
+  List->Count = 0;
+}
+
 /**
 Method used to draw the rectangle border.  Border Width is included in rectangle width.
 **/
 VOID
 DrawBorder (
-  IN PRIVATE_UI_RECTANGLE  *priv
+  IN PRIVATE_UI_RECTANGLE    *priv,
+  IN UI_RECTANGLE_DRAW_LIST  *List
   )
 {
-  EFI_STATUS  Status;
+  MEM_DRAW_COMMAND  Command;
+  INT32             Top;
+  INT32             Bottom;
 
   if (priv->Public.StyleInfo.Border.BorderWidth <= 0) {
     return;
   }
 
-  // Draw borders
-  for (INTN Y = 0; Y < (INTN)priv->Public.Height; Y++) {
-    if ((Y >= priv->Public.StyleInfo.Border.BorderWidth) && (Y < (INTN)(priv->Public.Height - priv->Public.StyleInfo.Border.BorderWidth))) {
-      // left border
-      Status = MemFillOnFrameBuffer (
-                 priv->Public.StyleInfo.Border.BorderColor,
-                 (INT32)priv->Public.UpperLeft.X,
-                 (INT32)Y,
-                 priv->Public.StyleInfo.Border.BorderWidth,
-                 1
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "Failed to draw icon in UI Rectangle\n"));
-        break;
-      }
-
-      // right border
-      Status = MemFillOnFrameBuffer (
-                 priv->Public.StyleInfo.Border.BorderColor,
-                 (INT32)priv->Public.UpperLeft.X + (priv->Public.Width - priv->Public.StyleInfo.Border.BorderWidth),
-                 (INT32)Y,
-                 priv->Public.StyleInfo.Border.BorderWidth,
-                 1
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "Failed to draw icon in UI Rectangle\n"));
-        break;
-      }
-    } else {
-      // top or bottom border
-      Status = MemFillOnFrameBuffer (
-                 priv->Public.StyleInfo.Border.BorderColor,
-                 (INT32)priv->Public.UpperLeft.X,
-                 (INT32)Y,
-                 (INT32)priv->Public.Width,
-                 1
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "Failed to draw icon in UI Rectangle\n"));
-        break;
-      }
-    }
+  // Rows above Top and from Bottom down are top or bottom border, the rows between have left and right borders
+  Top    = MIN (priv->Public.StyleInfo.Border.BorderWidth, (INT32)priv->Public.Height);
+  Bottom = MAX (Top, (INT32)priv->Public.Height - priv->Public.StyleInfo.Border.BorderWidth);
+
+  ZeroMem (&Command, sizeof (Command));
+  Command.Operation = MemDrawFill;
+  Command.Color1    = priv->Public.StyleInfo.Border.BorderColor;
+
+  // top border
+  Command.X      = (INT32)priv->Public.UpperLeft.X;
+  Command.Y      = (INT32)priv->Public.UpperLeft.Y;
+  Command.Width  = (INT32)priv->Public.Width;
+  Command.Height = Top;
+  AddDrawCommand (List, &Command);
+
+  if (Bottom > Top) {
+    // left border
+    Command.Y      = (INT32)priv->Public.UpperLeft.Y + Top;
+    Command.Width  = priv->Public.StyleInfo.Border.BorderWidth;
+    Command.Height = Bottom - Top;
+    AddDrawCommand (List, &Command);
+
+    // right border
+    Command.X = (INT32)priv->Public.UpperLeft.X + (priv->Public.Width - priv->Public.StyleInfo.Border.BorderWidth);
+    AddDrawCommand (List, &Command);
   }
 
-  return;
+  // bottom border
+  Command.X      = (INT32)priv->Public.UpperLeft.X;
+  Command.Y      = (INT32)priv->Public.UpperLeft.Y + Bottom;
+  Command.Width  = (INT32)priv->Public.Width;
+  Command.Height = (INT32)priv->Public.Height - Bottom;
+  AddDrawCommand (List, &Command);
 }
 
 /**
@@ -386,15 +473,16 @@ Method used to draw an icon in the rectangle.
 **/
 VOID
 DrawIcon (
-  IN PRIVATE_UI_RECTANGLE  *priv
+  IN PRIVATE_UI_RECTANGLE    *priv,
+  IN UI_RECTANGLE_DRAW_LIST  *List
   )
 {
-  EFI_STATUS  Status;
-  INT32       OffsetX   = 0; // Left edge of icon in coordinate space of the rectangle
-  INT32       OffsetY   = 0; // Upper edge of icon in coordinate space of the rectangle
-  INT32       SizeX     = (priv->Public.Width - (priv->Public.StyleInfo.Border.BorderWidth * 2));
-  INT32       SizeY     = (priv->Public.Height - (priv->Public.StyleInfo.Border.BorderWidth * 2));
-  UINT32      *TempIcon = priv->Public.StyleInfo.IconInfo.PixelData;
+  MEM_DRAW_COMMAND  Command;
+  INT32             OffsetX   = 0; // Left edge of icon in coordinate space of the rectangle
+  INT32             OffsetY   = 0; // Upper edge of icon in coordinate space of the rectangle
+  INT32             SizeX     = (priv->Public.Width - (priv->Public.StyleInfo.Border.BorderWidth * 2));
+  INT32             SizeY     = (priv->Public.Height - (priv->Public.StyleInfo.Border.BorderWidth * 2));
+  UINT32            *TempIcon = priv->Public.StyleInfo.IconInfo.PixelData;
 
   if (priv->Public.StyleInfo.IconInfo.PixelData != NULL) {
     if ((priv->Public.StyleInfo.IconInfo.Width > SizeX) || (priv->Public.StyleInfo.IconInfo.Height >  SizeY)) {
@@ -457,9 +545,14 @@ DrawIcon (
         return;
     } // close switch
 
-    Status = MemDrawOnFrameBuffer (TempIcon, OffsetX, OffsetY, priv->Public.StyleInfo.IconInfo.Width, priv->Public.StyleInfo.IconInfo.Height);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "Failed to draw icon in UI Rectangle\n"));
-    }
+    ZeroMem (&Command, sizeof (Command));
+    Command.Operation = MemDrawCopy;
+    Command.X         = (INT32)priv->Public.UpperLeft.X + OffsetX;
+    Command.Y         = (INT32)priv->Public.UpperLeft.Y + OffsetY;
+    Command.Width     = priv->Public.StyleInfo.IconInfo.Width;
+    Command.Height    = priv->Public.StyleInfo.IconInfo.Height;
+    Command.Data      = TempIcon;
+    Command.Delta     = (INTN)(Command.Width * sizeof (UINT32));
+    AddDrawCommand (List, &Command);
   } // close if pixel data not null
 }
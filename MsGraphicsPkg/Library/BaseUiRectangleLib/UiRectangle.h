@@ -14,6 +14,18 @@ typedef struct {
   UINT8           FillData[0];
 } PRIVATE_UI_RECTANGLE;
 
+//
+// Commands gathered while drawing a rectangle, so the fill, border and icon
+// go to the frame buffer in as few MemDrawListOnFrameBuffer calls as possible.
+//
+#define UI_RECTANGLE_MAX_DRAW_COMMANDS  32
+
+typedef struct {
+  MEM_DRAW_COMMAND    Commands[UI_RECTANGLE_MAX_DRAW_COMMANDS];
+  UINTN               Count;
+  EFI_STATUS          Status;
+} UI_RECTANGLE_DRAW_LIST;
+
 /***  PRIVATE METHODS ***/
 
 /**
@@ -44,14 +56,46 @@ PRIVATE_Init (
   IN PRIVATE_UI_RECTANGLE  *priv
   );
 
+/**
+Method used to add a command to the draw list, drawing the list first if it is full.
+**/
+VOID
+AddDrawCommand (
+  IN UI_RECTANGLE_DRAW_LIST  *List,
+  IN CONST MEM_DRAW_COMMAND  *Command
+  );
+
+/**
+Method used to add one row of pixels to the draw list.  A row that carries on from the
+rows of the last command, at the same step through the pixel data, grows that command.
+**/
+VOID
+AddDrawRow (
+  IN UI_RECTANGLE_DRAW_LIST  *List,
+  IN CONST UINT32            *Row,
+  IN INT32                   X,
+  IN INT32                   Y,
+  IN INT32                   Width
+  );
+
+/**
+Method used to draw the commands in the draw list and empty it.
+**/
+VOID
+FlushDrawList (
+  IN UI_RECTANGLE_DRAW_LIST  *List
+  );
+
 VOID
 DrawBorder (
-  IN PRIVATE_UI_RECTANGLE  *priv
+  IN PRIVATE_UI_RECTANGLE    *priv,
+  IN UI_RECTANGLE_DRAW_LIST  *List
   );
 
 VOID
 DrawIcon (
-  IN PRIVATE_UI_RECTANGLE  *priv
+  IN PRIVATE_UI_RECTANGLE    *priv,
+  IN UI_RECTANGLE_DRAW_LIST  *List
   );
 
 #endif
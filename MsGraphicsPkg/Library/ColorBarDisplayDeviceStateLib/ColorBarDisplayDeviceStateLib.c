@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DeviceStateLib.h>
 #include <Library/DisplayDeviceStateLib.h>
 #include <Library/DebugLib.h>
+#include <Library/FrameBufferMemDrawLib.h>
 #include <Protocol/GraphicsOutput.h>  // structure defs
 #include <Library/MemoryAllocationLib.h>
 #include <UiPrimitiveSupport.h>
@@ -149,9 +150,11 @@ This is used to identify the correct icon for various screen resolutions.
 @param ArrayLength   - number of items in BlitArray
 @param IconPlacement - UI placement type for icon if found
 
-@return Style Info struct will be updated if valid icon is found
+@return The icon that fits, or NULL if none fits.  Style Info struct will be updated if
+        the icon is a raw blit buffer.  An RLE icon is left for the caller to draw with
+        DrawRleBitmap.
 **/
-VOID
+BITMAPDATA *
 EFIAPI
 PopulateIconData (
   IN OUT   UI_STYLE_INFO  *Style,
@@ -164,20 +167,109 @@ PopulateIconData (
 {
   if (Style == NULL) {
     ASSERT (Style != NULL);
-    return;
+    return NULL;
   }
 
   for (UINT32 index = 0; index < ArrayLength; index++) {
     DEBUG ((DEBUG_VERBOSE, "Checking icon of size %u x %u to see if it fits\n", BlitArray[index]->Height, BlitArray[index]->Width));
     if ((BlitArray[index]->Height <= BannerHeight) && (BlitArray[index]->Width <= BannerWidth)) {
       DEBUG ((DEBUG_VERBOSE, "Found fitting icon\n"));
-      Style->IconInfo.Width     = BlitArray[index]->Width;
-      Style->IconInfo.Height    = BlitArray[index]->Height;
-      Style->IconInfo.Placement = IconPlacement;
-      Style->IconInfo.PixelData = (UINT32 *)&BlitArray[index]->BlitData[0];
-      break;
+      if (BlitArray[index]->RleData == NULL) {
+        Style->IconInfo.Width     = BlitArray[index]->Width;
+        Style->IconInfo.Height    = BlitArray[index]->Height;
+        Style->IconInfo.Placement = IconPlacement;
+        Style->IconInfo.PixelData = (UINT32 *)&BlitArray[index]->BlitData[0];
+      }
+
+      return BlitArray[index];
     }
   }
+
+  return NULL;
+}
+
+/**
+Draw a run length encoded bitmap onto the frame buffer, one packet at a time.
+
+Repeat packets are filled in a single color, and literal packets are expanded into a
+buffer of at most BITMAP_RLE_MAX_COUNT pixels, so the bitmap is never expanded in memory.
+
+@param Bitmap            - RLE bitmap to draw
+@param TopLeftXInPixels  - The top-left X coordinate in pixels
+@param TopLeftYInPixels  - The top-left Y coordinate in pixels
+
+@retval EFI_SUCCESS           The bitmap was drawn.
+@retval EFI_COMPROMISED_DATA  The packets do not hold Width x Height pixels of the palette.
+@retval Others                The frame buffer could not be drawn.
+**/
+EFI_STATUS
+EFIAPI
+DrawRleBitmap (
+  IN CONST BITMAPDATA  *Bitmap,
+  IN       INT32       TopLeftXInPixels,
+  IN       INT32       TopLeftYInPixels
+  )
+{
+  EFI_STATUS   Status;
+  UINT32       Pixels[BITMAP_RLE_MAX_COUNT];
+  CONST UINT8  *Packet;
+  CONST UINT8  *End;
+  INT32        Row;
+  INT32        Column;
+  INT32        Count;
+  INT32        Index;
+
+  Packet = Bitmap->RleData;
+  End    = Bitmap->RleData + Bitmap->RleSize;
+  Status = EFI_SUCCESS;
+
+  for (Row = 0; Row < Bitmap->Height; Row++) {
+    for (Column = 0; Column < Bitmap->Width; Column += Count) {
+      if (Packet >= End) {
+        goto Corrupt;
+      }
+
+      Count = (*Packet & BITMAP_RLE_COUNT_MASK) + 1;
+      if (Column + Count > Bitmap->Width) {
+        goto Corrupt;
+      }
+
+      if (*Packet & BITMAP_RLE_REPEAT_PACKET) {
+        if ((End - Packet < 2) || (Packet[1] >= Bitmap->PaletteCount)) {
+          goto Corrupt;
+        }
+
+        Status  = MemFillOnFrameBuffer (Bitmap->Palette[Packet[1]], TopLeftXInPixels + Column, TopLeftYInPixels + Row, Count, 1);
+        Packet += 2;
+      } else {
+        if (End - Packet < 1 + Count) {
+          goto Corrupt;
+        }
+
+        for (Index = 0; Index < Count; Index++) {
+          if (Packet[1 + Index] >= Bitmap->PaletteCount) {
+            goto Corrupt;
+          }
+
+          Pixels[Index] = Bitmap->Palette[Packet[1 + Index]];
+        }
+
+        Status  = MemDrawOnFrameBuffer (Pixels, TopLeftXInPixels + Column, TopLeftYInPixels + Row, Count, 1);
+        Packet += 1 + Count;
+      }
+
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+  }
+
+  return EFI_SUCCESS;
+
+Corrupt:
+  DEBUG ((DEBUG_ERROR, "%a - RLE bitmap is corrupt at row %d column %d\n", __FUNCTION__, Row, Column));
+  ASSERT (FALSE);
+  return EFI_COMPROMISED_DATA;
 }
 
 /**
@@ -197,6 +289,7 @@ DisplayDeviceState (
   DEVICE_STATE  *SupportedNotification = mSupportedNotifications;
   POINT         ul;
   INT32         SingleBannerHeight = ((HeightInPixels * HEIGHT_OF_SINGLE_BANNER) / 100);
+  BITMAPDATA    *Icon;
 
   Notifications = GetDeviceState ();
   PrintValues (Notifications);
@@ -212,12 +305,13 @@ DisplayDeviceState (
       si.IconInfo.Width     = 0;
       si.IconInfo.Height    = 0;
       si.IconInfo.PixelData = NULL;
+      Icon                  = NULL;
 
       if (*SupportedNotification & DEVICE_STATE_SECUREBOOT_OFF) {
         si.FillType                         = FILL_SOLID;
         si.FillTypeInfo.SolidFill.FillColor = COLOR_RED;
         if (sizeof (mUnlockBlitArray) > 0) {
-          PopulateIconData (&si, SingleBannerHeight, WidthInPixels, mUnlockBlitArray, ARRAY_SIZE (mUnlockBlitArray), MIDDLE_CENTER);
+          Icon = PopulateIconData (&si, SingleBannerHeight, WidthInPixels, mUnlockBlitArray, ARRAY_SIZE (mUnlockBlitArray), MIDDLE_CENTER);
         }
       } else if (*SupportedNotification & DEVICE_STATE_PLATFORM_MODE_0) {
         si.FillType                         = FILL_SOLID;
@@ -281,6 +375,15 @@ DisplayDeviceState (
         delete_UI_RECTANGLE (rect);
       }
 
+      // RLE icons are drawn straight to the frame buffer, centered in the banner.
+      if ((Icon != NULL) && (Icon->RleData != NULL)) {
+        DrawRleBitmap (
+          Icon,
+          (INT32)ul.X + (WidthInPixels / 2) - (Icon->Width / 2),
+          (INT32)ul.Y + (SingleBannerHeight / 2) - (Icon->Height / 2)
+          );
+      }
+
       ul.Y          += SingleBannerHeight;
       Notifications -= *SupportedNotification;  // subtract notification so that we can break early.
     }  // close if notification is supported
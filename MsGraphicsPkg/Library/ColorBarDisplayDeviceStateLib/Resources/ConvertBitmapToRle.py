@@ -0,0 +1,210 @@
+# @file
+#
+# Convert an icon into the palette and run length encoded BITMAPDATA used by
+# ColorBarDisplayDeviceStateLib.
+#
+# The icon can be an uncompressed 24 or 32 bit BMP file, or a header holding
+# a raw 32bpp blit buffer, like UnlockBitmap256.h.
+#
+# Copyright (c) Microsoft Corporation.
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAX_PALETTE_COLORS = 256
+MAX_PACKET_PIXELS = 128     # Packet header holds the pixel count - 1 in 7 bits
+REPEAT_PACKET = 0x80
+MIN_REPEAT_PIXELS = 3       # Shorter runs are cheaper to keep in a literal packet
+
+
+def read_bmp(path):
+    ''' Returns (width, height, pixels) of an uncompressed 24 or 32 bit BMP, top row first '''
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[0:2] != b"BM":
+        raise ValueError(f"{path} is not a BMP file")
+
+    offset, = struct.unpack_from("<I", data, 10)
+    width, height, planes, bpp, compression = struct.unpack_from("<iiHHI", data, 18)
+    if bpp not in (24, 32) or compression not in (0, 3):
+        raise ValueError(f"{path} is {bpp} bpp with compression {compression}, only 24 and 32 bpp are supported")
+
+    top_down = height < 0
+    height = abs(height)
+    stride = ((width * bpp + 31) // 32) * 4
+    pixels = []
+    for y in range(height):
+        row = y if top_down else height - 1 - y
+        start = offset + row * stride
+        for x in range(width):
+            b, g, r = data[start + x * bpp // 8:start + x * bpp // 8 + 3]
+            pixels.append(b | (g << 8) | (r << 16))
+
+    return width, height, pixels
+
+
+def read_raw_header(path):
+    ''' Returns (width, height, pixels) of a header holding a raw UINT32 blit buffer '''
+    with open(path, "r") as f:
+        text = f.read()
+
+    width = re.search(r"#define\s+\w+_WIDTH\s+\(?(\d+)\)?", text)
+    height = re.search(r"#define\s+\w+_HEIGHT\s+\(?(\d+)\)?", text)
+    array = re.search(r"UINT32\s+\w+\[\]\s*=\s*\{(.*?)\};", text, re.DOTALL)
+    if width is None or height is None or array is None:
+        raise ValueError(f"{path} does not have WIDTH and HEIGHT defines and a UINT32 array")
+
+    width = int(width.group(1))
+    height = int(height.group(1))
+    pixels = [int(value, 16) for value in re.findall(r"0x[0-9A-Fa-f]+", array.group(1))]
+    if len(pixels) != width * height:
+        raise ValueError(f"{path} has {len(pixels)} pixels, expected {width} x {height}")
+
+    return width, height, pixels
+
+
+def encode_row(indices):
+    ''' Run length encodes one row of palette indices into packets '''
+    packets = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            count = min(len(literal), MAX_PACKET_PIXELS)
+            packets.append(count - 1)
+            packets.extend(literal[:count])
+            del literal[:count]
+
+    x = 0
+    while x < len(indices):
+        run = 1
+        while x + run < len(indices) and indices[x + run] == indices[x] and run < MAX_PACKET_PIXELS:
+            run += 1
+
+        if run >= MIN_REPEAT_PIXELS:
+            flush_literal()
+            packets.append(REPEAT_PACKET | (run - 1))
+            packets.append(indices[x])
+        else:
+            literal.extend(indices[x:x + run])
+
+        x += run
+
+    flush_literal()
+    return packets
+
+
+def encode(width, height, pixels):
+    ''' Returns (palette, packets) for the pixels, one row at a time '''
+    palette = []
+    lookup = {}
+    for pixel in pixels:
+        if pixel not in lookup:
+            lookup[pixel] = len(palette)
+            palette.append(pixel)
+
+    if len(palette) > MAX_PALETTE_COLORS:
+        raise ValueError(f"Icon has {len(palette)} colors, the palette holds {MAX_PALETTE_COLORS}")
+
+    packets = bytearray()
+    for y in range(height):
+        packets.extend(encode_row([lookup[pixel] for pixel in pixels[y * width:(y + 1) * width]]))
+
+    return palette, packets
+
+
+def decode(width, height, palette, packets):
+    ''' Expands the packets back into pixels, to check the encoding '''
+    pixels = []
+    offset = 0
+    for y in range(height):
+        row = []
+        while len(row) < width:
+            header = packets[offset]
+            count = (header & ~REPEAT_PACKET) + 1
+            if header & REPEAT_PACKET:
+                row.extend([palette[packets[offset + 1]]] * count)
+                offset += 2
+            else:
+                row.extend(palette[index] for index in packets[offset + 1:offset + 1 + count])
+                offset += 1 + count
+
+        if len(row) != width:
+            raise ValueError(f"Row {y} decodes to {len(row)} pixels")
+
+        pixels.extend(row)
+
+    return pixels
+
+
+def write_header(path, name, source, width, height, palette, packets):
+    upper = name.upper()
+    lines = []
+    lines.append("/** @file")
+    lines.append(f"    Palette and run length encoded pixel data for {width} x {height} unlock bitmap")
+    lines.append("")
+    lines.append(f"    Generated by ConvertBitmapToRle.py from {os.path.basename(source)}.")
+    lines.append("")
+    lines.append("    Copyright (C) Microsoft Corporation. All rights reserved.")
+    lines.append("    SPDX-License-Identifier: BSD-2-Clause-Patent")
+    lines.append("")
+    lines.append("**/")
+    lines.append("#pragma once")
+    lines.append("")
+    lines.append(f"#define {upper}_WIDTH   ({width})")
+    lines.append(f"#define {upper}_HEIGHT  ({height})")
+    lines.append("")
+    lines.append(f"// {width} x {height}, {len(palette)} colors, {len(packets)} bytes of packets")
+    lines.append(f"CONST UINT32  m{name[0].upper() + name[1:]}Palette[] = {{")
+    for i in range(0, len(palette), 4):
+        lines.append("  " + ", ".join(f"0x{color:08X}" for color in palette[i:i + 4]) + ",")
+
+    lines[-1] = lines[-1].rstrip(",")
+    lines.append("};")
+    lines.append("")
+    lines.append(f"CONST UINT8  m{name[0].upper() + name[1:]}RleData[] = {{")
+    for i in range(0, len(packets), 12):
+        lines.append("  " + ", ".join(f"0x{value:02X}" for value in packets[i:i + 12]) + ",")
+
+    lines[-1] = lines[-1].rstrip(",")
+    lines.append("};")
+    lines.append("")
+    lines.append(
+        f"BITMAPDATA  {name} = {{ {upper}_HEIGHT, {upper}_WIDTH, NULL, 0, "
+        f"m{name[0].upper() + name[1:]}Palette, ARRAY_SIZE (m{name[0].upper() + name[1:]}Palette), "
+        f"m{name[0].upper() + name[1:]}RleData, sizeof (m{name[0].upper() + name[1:]}RleData) }};")
+
+    with open(path, "w", newline="\r\n") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an icon to a palette and run length encoded BITMAPDATA header")
+    parser.add_argument("input", help="24 or 32 bit BMP file, or header holding a raw 32bpp blit buffer")
+    parser.add_argument("output", help="Header file to write")
+    parser.add_argument("-n", "--name", required=True, help="Name of the BITMAPDATA, like unlock256")
+    args = parser.parse_args()
+
+    if args.input.lower().endswith(".bmp"):
+        width, height, pixels = read_bmp(args.input)
+    else:
+        width, height, pixels = read_raw_header(args.input)
+
+    palette, packets = encode(width, height, pixels)
+    if decode(width, height, palette, packets) != pixels:
+        raise ValueError("Encoded icon does not decode to the input pixels")
+
+    write_header(args.output, args.name, args.input, width, height, palette, packets)
+    print(f"{args.name}: {width} x {height}, {width * height * 4} bytes raw, "
+          f"{len(palette) * 4 + len(packets)} bytes as {len(palette)} colors and {len(packets)} bytes of packets")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -12,11 +12,30 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #pragma once
 
+//
+//  A bitmap is either a raw 32bpp blit buffer in BlitData, or, when RleData is not NULL,
+//  a palette of up to 256 colors and rows of run length encoded palette indices.
+//
+//  Each row of RleData is a list of packets that covers exactly Width pixels.  A packet
+//  starts with a header byte:
+//    0x80 | (Count - 1)  - Count pixels of the color at the palette index in the next byte.
+//    (Count - 1)         - Count pixels, one palette index byte each, follow.
+//
+//  Resources/ConvertBitmapToRle.py creates the RLE bitmaps.
+//
+#define BITMAP_RLE_REPEAT_PACKET  0x80
+#define BITMAP_RLE_COUNT_MASK     0x7F
+#define BITMAP_RLE_MAX_COUNT      128
+
 typedef struct BITMAPDATA {
   CONST INT32     Height;
   CONST INT32     Width;
   CONST UINT32    *BlitData;
   CONST UINT32    BuffSize;
+  CONST UINT32    *Palette;
+  CONST UINT32    PaletteCount;
+  CONST UINT8     *RleData;
+  CONST UINT32    RleSize;
 } BITMAPDATA;
 
 //
@@ -30,22 +49,45 @@ typedef struct BITMAPDATA {
 //  Usage example to force Bitmap112
 //  *_*_*_CC_FLAGS         = /D COLOR_BAR_UNLOCK_ICON_BITMASK=4
 //
+//  The bitmaps are RLE compressed, to keep them small in the firmware volume.  Define
+//  COLOR_BAR_UNLOCK_ICON_RAW to build the raw 32bpp bitmaps instead.
+//
 #ifdef COLOR_BAR_UNLOCK_ICON_BITMASK
 
   #if COLOR_BAR_UNLOCK_ICON_BITMASK & 0x1
-    #include "UnlockBitmap32.h"
+    #ifdef COLOR_BAR_UNLOCK_ICON_RAW
+      #include "UnlockBitmap32.h"
+    #else
+      #include "UnlockBitmapRle32.h"
+    #endif
   #endif
   #if COLOR_BAR_UNLOCK_ICON_BITMASK & 0x2
-    #include "UnlockBitmap64.h"
+    #ifdef COLOR_BAR_UNLOCK_ICON_RAW
+      #include "UnlockBitmap64.h"
+    #else
+      #include "UnlockBitmapRle64.h"
+    #endif
   #endif
   #if COLOR_BAR_UNLOCK_ICON_BITMASK & 0x4
-    #include "UnlockBitmap112.h"
+    #ifdef COLOR_BAR_UNLOCK_ICON_RAW
+      #include "UnlockBitmap112.h"
+    #else
+      #include "UnlockBitmapRle112.h"
+    #endif
   #endif
   #if COLOR_BAR_UNLOCK_ICON_BITMASK & 0x8
-    #include "UnlockBitmap128.h"
+    #ifdef COLOR_BAR_UNLOCK_ICON_RAW
+      #include "UnlockBitmap128.h"
+    #else
+      #include "UnlockBitmapRle128.h"
+    #endif
   #endif
   #if COLOR_BAR_UNLOCK_ICON_BITMASK & 0x10
-    #include "UnlockBitmap256.h"
+    #ifdef COLOR_BAR_UNLOCK_ICON_RAW
+      #include "UnlockBitmap256.h"
+    #else
+      #include "UnlockBitmapRle256.h"
+    #endif
   #endif
 
 // Order of bitmaps in array must be in decending order.
@@ -83,11 +125,19 @@ BITMAPDATA  *mUnlockBlitArray[] = {
 
 #else
 
-  #include "UnlockBitmap32.h"
-  #include "UnlockBitmap64.h"
-  #include "UnlockBitmap112.h"
-  #include "UnlockBitmap128.h"
-  #include "UnlockBitmap256.h"
+  #ifdef COLOR_BAR_UNLOCK_ICON_RAW
+    #include "UnlockBitmap32.h"
+    #include "UnlockBitmap64.h"
+    #include "UnlockBitmap112.h"
+    #include "UnlockBitmap128.h"
+    #include "UnlockBitmap256.h"
+  #else
+    #include "UnlockBitmapRle32.h"
+    #include "UnlockBitmapRle64.h"
+    #include "UnlockBitmapRle112.h"
+    #include "UnlockBitmapRle128.h"
+    #include "UnlockBitmapRle256.h"
+  #endif
 
 // Pre-Defined Unlock Bitmap Sizes
 //  Pos 0: 166 x 256 x 32bpp
@@ -0,0 +1,133 @@
+/** @file
+    Palette and run length encoded pixel data for 73 x 112 unlock bitmap
+
+    Generated by ConvertBitmapToRle.py from UnlockBitmap112.h.
+
+    Copyright (C) Microsoft Corporation. All rights reserved.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#pragma once
+
+#define UNLOCK112_WIDTH   (73)
+#define UNLOCK112_HEIGHT  (112)
+
+// 73 x 112, 17 colors, 1265 bytes of packets
+CONST UINT32  mUnlock112Palette[] = {
+  0x00FF0000, 0x00FF3D3D, 0x00FF6E6E, 0x00FF9393,
+  0x00FFBCBC, 0x00FFDADA, 0x00FFF5F5, 0x00FFFFFF,
+  0x00FFC7C7, 0x00FFA3A3, 0x00FFE3E3, 0x00FFECEC,
+  0x00FF1F1F, 0x00FFD1D1, 0x00FF5757, 0x00FF8282,
+  0x00FFB1B1
+};
+
+CONST UINT8  mUnlock112RleData[] = {
+  0xC8, 0x00, 0xA1, 0x00, 0x00, 0x01, 0x82, 0x02, 0x00, 0x01, 0xA1, 0x00,
+  0x9B, 0x00, 0x04, 0x01, 0x03, 0x04, 0x05, 0x06, 0x87, 0x07, 0x03, 0x05,
+  0x08, 0x03, 0x01, 0x9B, 0x00, 0x98, 0x00, 0x02, 0x01, 0x09, 0x0A, 0x90,
+  0x07, 0x02, 0x0B, 0x04, 0x01, 0x98, 0x00, 0x96, 0x00, 0x01, 0x02, 0x08,
+  0x96, 0x07, 0x01, 0x05, 0x02, 0x96, 0x00, 0x94, 0x00, 0x01, 0x01, 0x05,
+  0x9A, 0x07, 0x01, 0x05, 0x02, 0x94, 0x00, 0x92, 0x00, 0x01, 0x0C, 0x04,
+  0x9E, 0x07, 0x01, 0x0D, 0x0C, 0x92, 0x00, 0x91, 0x00, 0x01, 0x0E, 0x0B,
+  0xA0, 0x07, 0x01, 0x06, 0x0F, 0x91, 0x00, 0x90, 0x00, 0x00, 0x03, 0xA4,
+  0x07, 0x00, 0x04, 0x90, 0x00, 0x8F, 0x00, 0x00, 0x04, 0xA6, 0x07, 0x00,
+  0x08, 0x8F, 0x00, 0x8E, 0x00, 0x00, 0x08, 0xA8, 0x07, 0x01, 0x0A, 0x0C,
+  0x8D, 0x00, 0x8D, 0x00, 0x00, 0x08, 0xAA, 0x07, 0x00, 0x0D, 0x8D, 0x00,
+  0x8C, 0x00, 0x00, 0x03, 0x8F, 0x07, 0x03, 0x0A, 0x04, 0x02, 0x01, 0x84,
+  0x00, 0x03, 0x0C, 0x02, 0x10, 0x05, 0x8F, 0x07, 0x00, 0x08, 0x8C, 0x00,
+  0x8B, 0x00, 0x00, 0x02, 0x8D, 0x07, 0x02, 0x06, 0x08, 0x01, 0x8C, 0x00,
+  0x02, 0x01, 0x10, 0x06, 0x8D, 0x07, 0x00, 0x09, 0x8B, 0x00, 0x8A, 0x00,
+  0x01, 0x0C, 0x06, 0x8C, 0x07, 0x01, 0x08, 0x0C, 0x90, 0x00, 0x02, 0x0C,
+  0x10, 0x06, 0x8C, 0x07, 0x00, 0x0E, 0x8A, 0x00, 0x8A, 0x00, 0x00, 0x0D,
+  0x8B, 0x07, 0x01, 0x0B, 0x02, 0x94, 0x00, 0x01, 0x01, 0x05, 0x8B, 0x07,
+  0x00, 0x0A, 0x8A, 0x00, 0x89, 0x00, 0x00, 0x02, 0x8B, 0x07, 0x01, 0x0D,
+  0x0C, 0x97, 0x00, 0x00, 0x04, 0x8B, 0x07, 0x00, 0x10, 0x89, 0x00, 0x89,
+  0x00, 0x00, 0x0B, 0x8A, 0x07, 0x00, 0x08, 0x9A, 0x00, 0x00, 0x03, 0x8A,
+  0x07, 0x01, 0x06, 0x01, 0x88, 0x00, 0x88, 0x00, 0x00, 0x03, 0x8A, 0x07,
+  0x00, 0x08, 0x9C, 0x00, 0x00, 0x09, 0x8A, 0x07, 0x00, 0x08, 0x88, 0x00,
+  0x88, 0x00, 0x00, 0x0B, 0x89, 0x07, 0x01, 0x0A, 0x0C, 0x9D, 0x00, 0x00,
+  0x08, 0x8A, 0x07, 0x00, 0x0C, 0x87, 0x00, 0x87, 0x00, 0x00, 0x0F, 0x89,
+  0x07, 0x01, 0x06, 0x01, 0x9E, 0x00, 0x01, 0x0C, 0x0B, 0x89, 0x07, 0x00,
+  0x10, 0x87, 0x00, 0x87, 0x00, 0x00, 0x0D, 0x89, 0x07, 0x00, 0x09, 0xA0,
+  0x00, 0x00, 0x02, 0x89, 0x07, 0x00, 0x0B, 0x87, 0x00, 0x86, 0x00, 0x00,
+  0x0C, 0x89, 0x07, 0x00, 0x0B, 0xA2, 0x00, 0x00, 0x0D, 0x89, 0x07, 0x00,
+  0x0E, 0x86, 0x00, 0x86, 0x00, 0x00, 0x03, 0x89, 0x07, 0x00, 0x03, 0xA2,
+  0x00, 0x00, 0x01, 0x89, 0x07, 0x00, 0x04, 0x86, 0x00, 0x86, 0x00, 0x00,
+  0x08, 0x88, 0x07, 0x00, 0x06, 0xA4, 0x00, 0x00, 0x05, 0x88, 0x07, 0x00,
+  0x0A, 0x86, 0x00, 0x86, 0x00, 0x00, 0x0B, 0x88, 0x07, 0x00, 0x04, 0xA4,
+  0x00, 0x00, 0x03, 0x89, 0x07, 0x00, 0x0C, 0x85, 0x00, 0x85, 0x00, 0x00,
+  0x0C, 0x89, 0x07, 0x00, 0x02, 0xA4, 0x00, 0x00, 0x0C, 0x89, 0x07, 0x00,
+  0x02, 0x85, 0x00, 0x85, 0x00, 0x00, 0x02, 0x89, 0x07, 0xA6, 0x00, 0x00,
+  0x0A, 0x88, 0x07, 0x00, 0x10, 0x85, 0x00, 0x85, 0x00, 0x00, 0x09, 0x88,
+  0x07, 0x00, 0x05, 0xA6, 0x00, 0x00, 0x04, 0x88, 0x07, 0x00, 0x10, 0x85,
+  0x00, 0x85, 0x00, 0x00, 0x10, 0x88, 0x07, 0x00, 0x08, 0xA6, 0x00, 0x00,
+  0x10, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0x85, 0x00, 0x00, 0x10, 0x88,
+  0x07, 0x00, 0x10, 0xA6, 0x00, 0x00, 0x0F, 0x88, 0x07, 0x00, 0x05, 0x85,
+  0x00, 0x85, 0x00, 0x00, 0x10, 0x88, 0x07, 0x00, 0x10, 0xA6, 0x00, 0x00,
+  0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0x85, 0x00, 0x00, 0x10, 0x88,
+  0x07, 0x00, 0x10, 0xA6, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85,
+  0x00, 0x85, 0x00, 0x00, 0x10, 0x88, 0x07, 0x00, 0x10, 0xA6, 0x00, 0x00,
+  0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0x85, 0x00, 0x00, 0x10, 0x88,
+  0x07, 0x00, 0x10, 0xA6, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85,
+  0x00, 0x85, 0x00, 0x00, 0x10, 0x88, 0x07, 0x00, 0x10, 0xA6, 0x00, 0x00,
+  0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0x85, 0x00, 0x00, 0x10, 0x88,
+  0x07, 0x00, 0x10, 0xA6, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85,
+  0x00, 0x85, 0x00, 0x00, 0x10, 0x88, 0x07, 0x00, 0x10, 0xA6, 0x00, 0x00,
+  0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0x85, 0x00, 0x00, 0x10, 0x88,
+  0x07, 0x00, 0x10, 0xA6, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85,
+  0x00, 0x85, 0x00, 0x00, 0x10, 0x88, 0x07, 0x00, 0x10, 0xA6, 0x00, 0x00,
+  0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88,
+  0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00,
+  0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85,
+  0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7,
+  0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00,
+  0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88,
+  0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00,
+  0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85,
+  0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7,
+  0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00,
+  0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88,
+  0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00,
+  0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85,
+  0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7,
+  0x00, 0x00, 0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00,
+  0x02, 0x88, 0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88,
+  0x07, 0x00, 0x05, 0x85, 0x00, 0xB7, 0x00, 0x00, 0x02, 0x88, 0x07, 0x00,
+  0x05, 0x85, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07,
+  0x01, 0x05, 0x00, 0x01, 0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01,
+  0x00, 0x05, 0xC4, 0x07, 0x01, 0x05, 0x00, 0x01, 0x00, 0x03, 0xC4, 0x10,
+  0x01, 0x03, 0x00, 0xC8, 0x00
+};
+
+BITMAPDATA  unlock112 = { UNLOCK112_HEIGHT, UNLOCK112_WIDTH, NULL, 0, mUnlock112Palette, ARRAY_SIZE (mUnlock112Palette), mUnlock112RleData, sizeof (mUnlock112RleData) };
@@ -0,0 +1,227 @@
+/** @file
+    Palette and run length encoded pixel data for 83 x 128 unlock bitmap
+
+    Generated by ConvertBitmapToRle.py from UnlockBitmap128.h.
+
+    Copyright (C) Microsoft Corporation. All rights reserved.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#pragma once
+
+#define UNLOCK128_WIDTH   (83)
+#define UNLOCK128_HEIGHT  (128)
+
+// 83 x 128, 185 colors, 1896 bytes of packets
+CONST UINT32  mUnlock128Palette[] = {
+  0x00FF0000, 0x00FF3434, 0x00FF5757, 0x00FF5555,
+  0x00FF3535, 0x00FF2222, 0x00FF5F5F, 0x00FF7F7F,
+  0x00FF9595, 0x00FFA9A9, 0x00FFB6B6, 0x00FFBEBE,
+  0x00FFD0D0, 0x00FFDBDB, 0x00FFBFBF, 0x00FFB9B9,
+  0x00FFAFAF, 0x00FF9797, 0x00FF8787, 0x00FF6060,
+  0x00FF2323, 0x00FF0101, 0x00FF3131, 0x00FF6767,
+  0x00FF8A8A, 0x00FFB3B3, 0x00FFD7D7, 0x00FFE9E9,
+  0x00FFF7F7, 0x00FFFFFF, 0x00FFF8F8, 0x00FFEFEF,
+  0x00FF8E8E, 0x00FF7676, 0x00FF3A3A, 0x00FF1B1B,
+  0x00FF4444, 0x00FF7474, 0x00FFAEAE, 0x00FFE4E4,
+  0x00FFF3F3, 0x00FFB7B7, 0x00FF7878, 0x00FF4C4C,
+  0x00FF0B0B, 0x00FF3737, 0x00FF8989, 0x00FFCFCF,
+  0x00FFDCDC, 0x00FF3838, 0x00FF1A1A, 0x00FF0606,
+  0x00FF2020, 0x00FFE8E8, 0x00FF2A2A, 0x00FF0808,
+  0x00FF0909, 0x00FFD3D3, 0x00FFE7E7, 0x00FF1C1C,
+  0x00FF8C8C, 0x00FFF4F4, 0x00FFFDFD, 0x00FFFEFE,
+  0x00FF3636, 0x00FFF2F2, 0x00FFD2D2, 0x00FF6464,
+  0x00FFC9C9, 0x00FFF9F9, 0x00FF6E6E, 0x00FFD5D5,
+  0x00FFDEDE, 0x00FF5050, 0x00FFDFDF, 0x00FFF5F5,
+  0x00FF6A6A, 0x00FF0303, 0x00FFC4C4, 0x00FFBDBD,
+  0x00FFCECE, 0x00FFE3E3, 0x00FFEBEB, 0x00FF4848,
+  0x00FF2B2B, 0x00FFB8B8, 0x00FFE5E5, 0x00FFC6C6,
+  0x00FFAAAA, 0x00FF7272, 0x00FF3E3E, 0x00FF1212,
+  0x00FF2F2F, 0x00FF6F6F, 0x00FF9E9E, 0x00FF4040,
+  0x00FF0505, 0x00FF9A9A, 0x00FFE6E6, 0x00FF3939,
+  0x00FFE1E1, 0x00FFC8C8, 0x00FFFBFB, 0x00FF9D9D,
+  0x00FF1717, 0x00FF0202, 0x00FF9090, 0x00FF1D1D,
+  0x00FF4E4E, 0x00FF5353, 0x00FF1313, 0x00FF1010,
+  0x00FF3333, 0x00FFF0F0, 0x00FF5D5D, 0x00FF2424,
+  0x00FF9F9F, 0x00FF8686, 0x00FF2D2D, 0x00FF1E1E,
+  0x00FFC3C3, 0x00FF4A4A, 0x00FF6C6C, 0x00FFF1F1,
+  0x00FF7171, 0x00FF6262, 0x00FF9999, 0x00FF2828,
+  0x00FFECEC, 0x00FF7979, 0x00FFDADA, 0x00FF5454,
+  0x00FF8484, 0x00FF8F8F, 0x00FF6868, 0x00FFB0B0,
+  0x00FF0E0E, 0x00FFC1C1, 0x00FFF6F6, 0x00FF0C0C,
+  0x00FFEEEE, 0x00FFD9D9, 0x00FFC5C5, 0x00FF0A0A,
+  0x00FFB1B1, 0x00FFA0A0, 0x00FF7B7B, 0x00FFD1D1,
+  0x00FF0F0F, 0x00FF4242, 0x00FF6B6B, 0x00FF6666,
+  0x00FF9B9B, 0x00FF1F1F, 0x00FF7777, 0x00FFFCFC,
+  0x00FFD4D4, 0x00FF6363, 0x00FF5151, 0x00FFE2E2,
+  0x00FF1919, 0x00FF4949, 0x00FF2929, 0x00FFA3A3,
+  0x00FF4545, 0x00FF0404, 0x00FF9696, 0x00FF5B5B,
+  0x00FF7E7E, 0x00FF1616, 0x00FFABAB, 0x00FFBABA,
+  0x00FF3F3F, 0x00FFCDCD, 0x00FFE0E0, 0x00FFBCBC,
+  0x00FF2727, 0x00FFACAC, 0x00FF9393, 0x00FFCBCB,
+  0x00FF8888, 0x00FF1414, 0x00FF8080, 0x00FF4F4F,
+  0x00FF9494
+};
+
+CONST UINT8  mUnlock128RleData[] = {
+  0xD2, 0x00, 0xA6, 0x00, 0x04, 0x01, 0x02, 0x03, 0x02, 0x04, 0xA6, 0x00,
+  0x9F, 0x00, 0x07, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x82,
+  0x0D, 0x07, 0x0C, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x9F, 0x00,
+  0x9B, 0x00, 0x07, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x8A,
+  0x1D, 0x06, 0x1E, 0x1F, 0x1A, 0x19, 0x20, 0x21, 0x22, 0x9C, 0x00, 0x99,
+  0x00, 0x04, 0x23, 0x24, 0x25, 0x26, 0x27, 0x94, 0x1D, 0x04, 0x28, 0x29,
+  0x2A, 0x2B, 0x23, 0x99, 0x00, 0x97, 0x00, 0x03, 0x2C, 0x2D, 0x2E, 0x2F,
+  0x9A, 0x1D, 0x03, 0x30, 0x2E, 0x31, 0x32, 0x97, 0x00, 0x95, 0x00, 0x03,
+  0x33, 0x34, 0x13, 0x27, 0x9E, 0x1D, 0x03, 0x35, 0x20, 0x36, 0x37, 0x95,
+  0x00, 0x94, 0x00, 0x02, 0x38, 0x2B, 0x39, 0xA2, 0x1D, 0x03, 0x3A, 0x03,
+  0x38, 0x15, 0x93, 0x00, 0x93, 0x00, 0x03, 0x3B, 0x3C, 0x3D, 0x3E, 0xA2,
+  0x1D, 0x03, 0x3F, 0x1E, 0x10, 0x40, 0x93, 0x00, 0x92, 0x00, 0x02, 0x24,
+  0x0F, 0x41, 0xA6, 0x1D, 0x02, 0x1C, 0x42, 0x43, 0x92, 0x00, 0x91, 0x00,
+  0x02, 0x43, 0x44, 0x45, 0xA9, 0x1D, 0x01, 0x1A, 0x46, 0x91, 0x00, 0x90,
+  0x00, 0x01, 0x43, 0x47, 0xAC, 0x1D, 0x02, 0x48, 0x2A, 0x33, 0x8F, 0x00,
+  0x8F, 0x00, 0x01, 0x49, 0x4A, 0xAE, 0x1D, 0x01, 0x4B, 0x4C, 0x8F, 0x00,
+  0x8D, 0x00, 0x02, 0x4D, 0x40, 0x27, 0x91, 0x1D, 0x03, 0x1C, 0x27, 0x39,
+  0x4E, 0x84, 0x0F, 0x04, 0x4F, 0x50, 0x51, 0x28, 0x3E, 0x90, 0x1D, 0x02,
+  0x52, 0x53, 0x33, 0x8D, 0x00, 0x8C, 0x00, 0x02, 0x4D, 0x54, 0x55, 0x8F,
+  0x1D, 0x06, 0x1E, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x5B, 0x85, 0x00, 0x05,
+  0x5C, 0x5D, 0x5E, 0x0E, 0x56, 0x4B, 0x8F, 0x1D, 0x02, 0x3A, 0x5F, 0x60,
+  0x8C, 0x00, 0x8C, 0x00, 0x01, 0x34, 0x61, 0x8D, 0x1D, 0x04, 0x3F, 0x45,
+  0x62, 0x0A, 0x63, 0x8E, 0x00, 0x04, 0x2D, 0x5E, 0x64, 0x45, 0x3F, 0x8D,
+  0x1D, 0x02, 0x65, 0x31, 0x15, 0x8B, 0x00, 0x8C, 0x00, 0x01, 0x06, 0x66,
+  0x8D, 0x1D, 0x04, 0x4B, 0x67, 0x68, 0x33, 0x69, 0x8E, 0x00, 0x04, 0x15,
+  0x60, 0x68, 0x18, 0x27, 0x8D, 0x1D, 0x02, 0x3E, 0x6A, 0x6B, 0x8B, 0x00,
+  0x8B, 0x00, 0x01, 0x6C, 0x0D, 0x8D, 0x1D, 0x02, 0x0E, 0x6D, 0x6E, 0x94,
+  0x00, 0x03, 0x6F, 0x70, 0x11, 0x3E, 0x8C, 0x1D, 0x01, 0x71, 0x72, 0x8B,
+  0x00, 0x8A, 0x00, 0x01, 0x73, 0x74, 0x8C, 0x1D, 0x03, 0x45, 0x75, 0x76,
+  0x37, 0x97, 0x00, 0x02, 0x77, 0x17, 0x52, 0x8C, 0x1D, 0x01, 0x78, 0x79,
+  0x8A, 0x00, 0x8A, 0x00, 0x01, 0x7A, 0x62, 0x8B, 0x1D, 0x02, 0x7B, 0x7C,
+  0x32, 0x9A, 0x00, 0x02, 0x38, 0x7D, 0x2F, 0x8B, 0x1D, 0x02, 0x45, 0x7E,
+  0x2C, 0x89, 0x00, 0x89, 0x00, 0x01, 0x7F, 0x29, 0x8B, 0x1D, 0x02, 0x80,
+  0x81, 0x4D, 0x9D, 0x00, 0x02, 0x03, 0x82, 0x3F, 0x8A, 0x1D, 0x01, 0x47,
+  0x83, 0x89, 0x00, 0x89, 0x00, 0x01, 0x84, 0x80, 0x8A, 0x1D, 0x01, 0x41,
+  0x85, 0xA0, 0x00, 0x02, 0x86, 0x56, 0x3F, 0x89, 0x1D, 0x01, 0x66, 0x87,
+  0x89, 0x00, 0x88, 0x00, 0x01, 0x88, 0x89, 0x8A, 0x1D, 0x02, 0x8A, 0x19,
+  0x8B, 0xA1, 0x00, 0x01, 0x85, 0x8C, 0x8A, 0x1D, 0x01, 0x8D, 0x14, 0x88,
+  0x00, 0x88, 0x00, 0x01, 0x7C, 0x35, 0x89, 0x1D, 0x02, 0x3F, 0x8E, 0x73,
+  0xA2, 0x00, 0x02, 0x8F, 0x90, 0x3E, 0x89, 0x1D, 0x01, 0x3D, 0x91, 0x88,
+  0x00, 0x88, 0x00, 0x01, 0x19, 0x45, 0x89, 0x1D, 0x02, 0x62, 0x92, 0x15,
+  0xA3, 0x00, 0x01, 0x2B, 0x50, 0x89, 0x1D, 0x01, 0x3F, 0x93, 0x88, 0x00,
+  0x87, 0x00, 0x02, 0x6F, 0x4A, 0x3F, 0x89, 0x1D, 0x01, 0x74, 0x94, 0xA4,
+  0x00, 0x02, 0x37, 0x2E, 0x66, 0x89, 0x1D, 0x02, 0x52, 0x95, 0x4D, 0x86,
+  0x00, 0x86, 0x00, 0x02, 0x60, 0x96, 0x7B, 0x89, 0x1D, 0x01, 0x51, 0x97,
+  0xA6, 0x00, 0x01, 0x5C, 0x0A, 0x89, 0x1D, 0x02, 0x1C, 0x67, 0x8F, 0x86,
+  0x00, 0x86, 0x00, 0x02, 0x8F, 0x10, 0x1C, 0x89, 0x1D, 0x01, 0x98, 0x99,
+  0xA6, 0x00, 0x02, 0x4D, 0x9A, 0x9B, 0x88, 0x1D, 0x02, 0x9B, 0x42, 0x8B,
+  0x86, 0x00, 0x86, 0x00, 0x02, 0x8F, 0x9C, 0x9B, 0x88, 0x1D, 0x01, 0x3D,
+  0x9D, 0xA8, 0x00, 0x01, 0x9E, 0x9F, 0x88, 0x1D, 0x02, 0x3F, 0x8C, 0xA0,
+  0x86, 0x00, 0x86, 0x00, 0x01, 0x6E, 0x1F, 0x89, 0x1D, 0x01, 0x2F, 0xA1,
+  0xA8, 0x00, 0x01, 0xA2, 0xA3, 0x8A, 0x1D, 0x01, 0xA4, 0xA5, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x69, 0x63, 0x9B, 0x89, 0x1D, 0x01, 0xA6, 0x14, 0xA9,
+  0x00, 0x01, 0xA7, 0x3F, 0x88, 0x1D, 0x02, 0x3E, 0x18, 0x5B, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x88, 0xA8, 0x9B, 0x88, 0x1D, 0x01, 0x3F, 0x49, 0xAA,
+  0x00, 0x01, 0x95, 0x3D, 0x88, 0x1D, 0x02, 0x3F, 0x0E, 0x3B, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0xA9, 0xAA, 0x9B, 0x88, 0x1D, 0x01, 0x71, 0xA4, 0xAA,
+  0x00, 0x01, 0x2D, 0x9C, 0x88, 0x1D, 0x02, 0x3F, 0x4F, 0x23, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0xA0, 0xAB, 0x3E, 0x88, 0x1D, 0x01, 0x9F, 0xAC, 0xAA,
+  0x00, 0x01, 0x01, 0xAD, 0x88, 0x1D, 0x02, 0x3F, 0xAE, 0x05, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0x2F, 0x2D, 0xAA,
+  0x00, 0x01, 0xB0, 0xB1, 0x88, 0x1D, 0x02, 0x3F, 0x3A, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0x44, 0x04, 0xAA,
+  0x00, 0x01, 0x77, 0xB2, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0xB3, 0x40, 0xAA,
+  0x00, 0x01, 0x23, 0x3C, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0xB3, 0x40, 0xAA,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0xB3, 0x40, 0xAA,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0xB3, 0x40, 0xAA,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0xB3, 0x40, 0xAA,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0xB3, 0x40, 0xAA,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0xB3, 0x40, 0xAA,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x02, 0x32, 0xAF, 0x3E, 0x88, 0x1D, 0x01, 0xB3, 0x40, 0xAA,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0x85, 0x00, 0x01, 0x23, 0x57, 0x89, 0x1D, 0x01, 0x47, 0x31, 0xAA, 0x00,
+  0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0x85,
+  0x00, 0x02, 0x5B, 0xB4, 0x55, 0x88, 0x0F, 0x01, 0xB2, 0xB0, 0xAA, 0x00,
+  0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85,
+  0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73,
+  0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62,
+  0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F,
+  0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02,
+  0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D,
+  0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88,
+  0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20,
+  0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B,
+  0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01,
+  0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00,
+  0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE,
+  0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00,
+  0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85,
+  0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73,
+  0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F, 0x62,
+  0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02, 0x3F,
+  0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D, 0x02,
+  0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88, 0x1D,
+  0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20, 0x88,
+  0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x3B, 0x20,
+  0x88, 0x1D, 0x02, 0x3F, 0x62, 0x73, 0x85, 0x00, 0xBE, 0x00, 0x01, 0x8B,
+  0x75, 0x88, 0x1D, 0x02, 0x3E, 0x27, 0xB5, 0x85, 0x00, 0x02, 0x00, 0x6C,
+  0x4C, 0xBB, 0x96, 0x01, 0x92, 0x4F, 0x88, 0x1D, 0x02, 0x3F, 0x71, 0xB6,
+  0x82, 0x96, 0x02, 0x4C, 0xB7, 0x00, 0x01, 0x00, 0x57, 0xCE, 0x1D, 0x01,
+  0x44, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00,
+  0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00,
+  0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B,
+  0xCC, 0x1D, 0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D,
+  0x02, 0x9B, 0xAF, 0x00, 0x02, 0x00, 0x0F, 0x9B, 0xCC, 0x1D, 0x02, 0x9B,
+  0xAF, 0x00, 0x01, 0x00, 0xAF, 0xCE, 0x1D, 0x01, 0x0E, 0x00, 0x03, 0x00,
+  0xB1, 0x80, 0x71, 0xCA, 0x1F, 0x03, 0x71, 0x80, 0x10, 0x00, 0x03, 0x00,
+  0x97, 0x85, 0xB8, 0xCA, 0xB2, 0x03, 0xB8, 0x85, 0x86, 0x00, 0xD2, 0x00
+};
+
+BITMAPDATA  unlock128 = { UNLOCK128_HEIGHT, UNLOCK128_WIDTH, NULL, 0, mUnlock128Palette, ARRAY_SIZE (mUnlock128Palette), mUnlock128RleData, sizeof (mUnlock128RleData) };
@@ -0,0 +1,613 @@
+/** @file
+    Palette and run length encoded pixel data for 166 x 256 unlock bitmap
+
+    Generated by ConvertBitmapToRle.py from UnlockBitmap256.h.
+
+    Copyright (C) Microsoft Corporation. All rights reserved.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#pragma once
+
+#define UNLOCK256_WIDTH   (166)
+#define UNLOCK256_HEIGHT  (256)
+
+// 166 x 256, 255 colors, 6317 bytes of packets
+CONST UINT32  mUnlock256Palette[] = {
+  0x00FF0000, 0x00FF0303, 0x00FF0909, 0x00FF0D0D,
+  0x00FF0F0F, 0x00FF0E0E, 0x00FF0404, 0x00FF1212,
+  0x00FF2626, 0x00FF3636, 0x00FF3D3D, 0x00FF3B3B,
+  0x00FF3C3C, 0x00FF2727, 0x00FF1313, 0x00FF0101,
+  0x00FF0606, 0x00FF1515, 0x00FF1818, 0x00FF1A1A,
+  0x00FF1D1D, 0x00FF1F1F, 0x00FF2020, 0x00FF2222,
+  0x00FF2323, 0x00FF2424, 0x00FF2D2D, 0x00FF4848,
+  0x00FF5F5F, 0x00FF7171, 0x00FF7878, 0x00FF7676,
+  0x00FF7777, 0x00FF6060, 0x00FF4949, 0x00FF1B1B,
+  0x00FF1717, 0x00FF0707, 0x00FF1C1C, 0x00FF3737,
+  0x00FF4B4B, 0x00FF5757, 0x00FF6262, 0x00FF6A6A,
+  0x00FF7474, 0x00FF7C7C, 0x00FF8383, 0x00FF8989,
+  0x00FF8D8D, 0x00FF9090, 0x00FF9797, 0x00FFA6A6,
+  0x00FFB3B3, 0x00FFBCBC, 0x00FFC0C0, 0x00FFBFBF,
+  0x00FF9898, 0x00FF9191, 0x00FF8F8F, 0x00FF8C8C,
+  0x00FF8888, 0x00FF8080, 0x00FF7575, 0x00FF6D6D,
+  0x00FF6868, 0x00FF5D5D, 0x00FF4D4D, 0x00FF0808,
+  0x00FF3333, 0x00FF4E4E, 0x00FF6F6F, 0x00FF8686,
+  0x00FF9595, 0x00FFA2A2, 0x00FFADAD, 0x00FFB7B7,
+  0x00FFC1C1, 0x00FFC8C8, 0x00FFCFCF, 0x00FFD3D3,
+  0x00FFD5D5, 0x00FFDADA, 0x00FFE1E1, 0x00FFE6E6,
+  0x00FFEAEA, 0x00FFEBEB, 0x00FFDBDB, 0x00FFD6D6,
+  0x00FFD2D2, 0x00FFCECE, 0x00FFC5C5, 0x00FFB9B9,
+  0x00FFB0B0, 0x00FFAAAA, 0x00FF9D9D, 0x00FF6E6E,
+  0x00FF3434, 0x00FF1616, 0x00FF0B0B, 0x00FF0505,
+  0x00FF2828, 0x00FF3E3E, 0x00FF5050, 0x00FF5E5E,
+  0x00FF8484, 0x00FF9B9B, 0x00FFC4C4, 0x00FFD8D8,
+  0x00FFE2E2, 0x00FFE8E8, 0x00FFEEEE, 0x00FFF2F2,
+  0x00FFF3F3, 0x00FFF4F4, 0x00FFF5F5, 0x00FFF6F6,
+  0x00FFF8F8, 0x00FFF9F9, 0x00FFFAFA, 0x00FFEFEF,
+  0x00FFE4E4, 0x00FFDFDF, 0x00FFC6C6, 0x00FF8585,
+  0x00FF6363, 0x00FF5B5B, 0x00FF4A4A, 0x00FF3131,
+  0x00FF0C0C, 0x00FF1111, 0x00FF5A5A, 0x00FF7979,
+  0x00FFB2B2, 0x00FFC3C3, 0x00FFF1F1, 0x00FFF7F7,
+  0x00FFFDFD, 0x00FFFFFF, 0x00FFFEFE, 0x00FFFBFB,
+  0x00FFECEC, 0x00FFE0E0, 0x00FFB5B5, 0x00FFA8A8,
+  0x00FF9F9F, 0x00FF6666, 0x00FF4444, 0x00FF2121,
+  0x00FF1414, 0x00FF7F7F, 0x00FFBDBD, 0x00FFD4D4,
+  0x00FFF0F0, 0x00FFFCFC, 0x00FFEDED, 0x00FFABAB,
+  0x00FF6464, 0x00FF3A3A, 0x00FF5555, 0x00FF7070,
+  0x00FF8B8B, 0x00FFA3A3, 0x00FFBBBB, 0x00FFA7A7,
+  0x00FF2F2F, 0x00FF5656, 0x00FFA0A0, 0x00FFE9E9,
+  0x00FFDEDE, 0x00FFCACA, 0x00FF2E2E, 0x00FF1010,
+  0x00FF9696, 0x00FFBABA, 0x00FFA4A4, 0x00FFD0D0,
+  0x00FFD1D1, 0x00FFB1B1, 0x00FF2525, 0x00FF0A0A,
+  0x00FF0202, 0x00FF5353, 0x00FF7272, 0x00FF6767,
+  0x00FF3F3F, 0x00FF1E1E, 0x00FFBEBE, 0x00FFE7E7,
+  0x00FFE3E3, 0x00FF5858, 0x00FF9999, 0x00FF3939,
+  0x00FF4F4F, 0x00FFC7C7, 0x00FF9E9E, 0x00FF3535,
+  0x00FF2A2A, 0x00FFC2C2, 0x00FFDDDD, 0x00FFAFAF,
+  0x00FF4242, 0x00FF4343, 0x00FF7B7B, 0x00FF3030,
+  0x00FF7D7D, 0x00FFB8B8, 0x00FF9C9C, 0x00FF9393,
+  0x00FFA5A5, 0x00FF6B6B, 0x00FF9A9A, 0x00FF6C6C,
+  0x00FF2B2B, 0x00FFAEAE, 0x00FFDCDC, 0x00FF5454,
+  0x00FF9292, 0x00FFD9D9, 0x00FF5151, 0x00FFACAC,
+  0x00FF8E8E, 0x00FFE5E5, 0x00FFCCCC, 0x00FF2C2C,
+  0x00FF7E7E, 0x00FF6161, 0x00FFB6B6, 0x00FFA1A1,
+  0x00FF4747, 0x00FF8282, 0x00FF2929, 0x00FF8A8A,
+  0x00FF9494, 0x00FFCDCD, 0x00FF3232, 0x00FFC9C9,
+  0x00FFD7D7, 0x00FFCBCB, 0x00FF4545, 0x00FFA9A9,
+  0x00FF7373, 0x00FF4141, 0x00FF5959, 0x00FF6565,
+  0x00FF4C4C, 0x00FFB4B4, 0x00FF4646, 0x00FF5252,
+  0x00FF3838, 0x00FF5C5C, 0x00FF8787, 0x00FF1919,
+  0x00FF4040, 0x00FF6969, 0x00FF7A7A
+};
+
+CONST UINT8  mUnlock256RleData[] = {
+  0xFF, 0x00, 0xA5, 0x00, 0xCD, 0x00, 0x03, 0x01, 0x02, 0x03, 0x04, 0x82,
+  0x05, 0x02, 0x03, 0x02, 0x06, 0xCD, 0x00, 0xCD, 0x00, 0x09, 0x07, 0x08,
+  0x09, 0x0A, 0x0B, 0x0B, 0x0C, 0x09, 0x0D, 0x0E, 0xCD, 0x00, 0xBF, 0x00,
+  0x25, 0x0F, 0x10, 0x03, 0x07, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+  0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x1F, 0x20, 0x1D, 0x21,
+  0x22, 0x1A, 0x19, 0x19, 0x18, 0x17, 0x16, 0x14, 0x23, 0x13, 0x24, 0x0E,
+  0x03, 0x10, 0x0F, 0xBF, 0x00, 0xBF, 0x00, 0x11, 0x25, 0x26, 0x27, 0x28,
+  0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x34,
+  0x35, 0x36, 0x82, 0x37, 0x10, 0x35, 0x34, 0x33, 0x38, 0x39, 0x3A, 0x3B,
+  0x3C, 0x3D, 0x3E, 0x3F, 0x40, 0x41, 0x42, 0x27, 0x26, 0x43, 0xBF, 0x00,
+  0xB9, 0x00, 0x16, 0x06, 0x02, 0x04, 0x0E, 0x24, 0x15, 0x44, 0x45, 0x46,
+  0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, 0x50, 0x51, 0x52,
+  0x53, 0x54, 0x83, 0x55, 0x16, 0x54, 0x53, 0x52, 0x56, 0x57, 0x50, 0x58,
+  0x59, 0x5A, 0x5B, 0x5C, 0x5D, 0x5E, 0x2F, 0x5F, 0x45, 0x60, 0x16, 0x12,
+  0x61, 0x07, 0x62, 0x63, 0xB9, 0x00, 0xB9, 0x00, 0x15, 0x0E, 0x64, 0x65,
+  0x66, 0x67, 0x5F, 0x68, 0x69, 0x34, 0x6A, 0x4E, 0x6B, 0x6C, 0x6D, 0x6E,
+  0x6F, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x85, 0x76, 0x15, 0x75, 0x74,
+  0x73, 0x72, 0x72, 0x71, 0x70, 0x77, 0x54, 0x78, 0x79, 0x50, 0x7A, 0x34,
+  0x69, 0x7B, 0x1D, 0x7C, 0x7D, 0x7E, 0x7F, 0x12, 0xB9, 0x00, 0xB3, 0x00,
+  0x12, 0x0F, 0x06, 0x43, 0x80, 0x81, 0x15, 0x0C, 0x82, 0x83, 0x31, 0x49,
+  0x84, 0x85, 0x4F, 0x52, 0x55, 0x86, 0x87, 0x88, 0x97, 0x89, 0x12, 0x8A,
+  0x8B, 0x72, 0x8C, 0x8D, 0x4F, 0x6A, 0x8E, 0x8F, 0x90, 0x2F, 0x91, 0x92,
+  0x93, 0x07, 0x05, 0x02, 0x06, 0x0F, 0xB3, 0x00, 0xB3, 0x00, 0x11, 0x25,
+  0x94, 0x18, 0x60, 0x1B, 0x1C, 0x95, 0x90, 0x96, 0x97, 0x78, 0x8C, 0x98,
+  0x71, 0x74, 0x76, 0x99, 0x88, 0x99, 0x89, 0x11, 0x8A, 0x88, 0x76, 0x87,
+  0x71, 0x98, 0x9A, 0x6D, 0x6C, 0x59, 0x9B, 0x3C, 0x9C, 0x28, 0x9D, 0x64,
+  0x94, 0x25, 0xB3, 0x00, 0xB0, 0x00, 0x0C, 0x0F, 0x06, 0x05, 0x18, 0x0C,
+  0x9E, 0x9F, 0xA0, 0xA1, 0xA2, 0x58, 0x6D, 0x75, 0xAA, 0x89, 0x0C, 0x71,
+  0x56, 0x4C, 0xA3, 0x3A, 0x83, 0x67, 0x0A, 0x18, 0x05, 0x06, 0x01, 0x0F,
+  0xAF, 0x00, 0xB0, 0x00, 0x0C, 0x10, 0x94, 0xA4, 0xA5, 0x2D, 0xA6, 0x37,
+  0x51, 0x6D, 0x6E, 0x71, 0x76, 0x8A, 0xAA, 0x89, 0x0C, 0x88, 0x73, 0x98,
+  0xA7, 0xA8, 0xA9, 0x9B, 0x95, 0xA5, 0xAA, 0x24, 0xAB, 0x25, 0xAF, 0x00,
+  0xAE, 0x00, 0x08, 0x63, 0x04, 0x08, 0x7E, 0x46, 0xAC, 0x4B, 0x50, 0x9A,
+  0xB5, 0x89, 0x09, 0x73, 0xA8, 0xAD, 0x48, 0x46, 0x66, 0x0B, 0x18, 0x62,
+  0x0F, 0xAD, 0x00, 0xAC, 0x00, 0x0A, 0x0F, 0x10, 0x11, 0xA4, 0x1C, 0xAE,
+  0xAF, 0x6C, 0x9A, 0x72, 0x8B, 0xB5, 0x89, 0x0A, 0x88, 0x87, 0x6E, 0x6C,
+  0xB0, 0xB1, 0x7B, 0xA5, 0xB2, 0xB3, 0xB4, 0xAC, 0x00, 0xAB, 0x00, 0x06,
+  0x43, 0x13, 0x09, 0xB5, 0xB6, 0x90, 0xA8, 0xBF, 0x89, 0x06, 0x54, 0x4C,
+  0xAC, 0xB7, 0xB8, 0x16, 0xB3, 0xAB, 0x00, 0xAA, 0x00, 0x07, 0x63, 0xB9,
+  0x42, 0x39, 0xBA, 0x57, 0xBB, 0x87, 0xBF, 0x89, 0x07, 0x76, 0x98, 0xBC,
+  0xB0, 0x49, 0xBD, 0x18, 0x06, 0xAA, 0x00, 0xA8, 0x00, 0x06, 0x10, 0x11,
+  0x7F, 0x82, 0x3A, 0x4E, 0x87, 0xC6, 0x89, 0x06, 0x79, 0xBE, 0x2A, 0xBF,
+  0x14, 0x80, 0x01, 0xA7, 0x00, 0xA7, 0x00, 0x07, 0x0F, 0x14, 0xC0, 0x68,
+  0x35, 0x52, 0x6F, 0x88, 0xC6, 0x89, 0x06, 0x87, 0x78, 0xC1, 0xC2, 0x5F,
+  0xC3, 0xAB, 0xA7, 0x00, 0xA5, 0x00, 0x06, 0x10, 0x0E, 0xC4, 0xB5, 0x30,
+  0xC5, 0x86, 0x82, 0x89, 0x00, 0x8A, 0xC3, 0x89, 0x0A, 0x8A, 0x8A, 0x89,
+  0x89, 0x8B, 0xC6, 0xC7, 0xB6, 0xC8, 0xB9, 0x62, 0xA5, 0x00, 0xA5, 0x00,
+  0x06, 0x13, 0xC9, 0xCA, 0x5D, 0xAF, 0x54, 0x76, 0x82, 0x89, 0x00, 0x8A,
+  0xC3, 0x89, 0x0B, 0x8A, 0x8A, 0x89, 0x89, 0x8A, 0x71, 0x8D, 0x85, 0x38,
+  0x21, 0xCB, 0x63, 0xA4, 0x00, 0xA3, 0x00, 0x06, 0x62, 0x16, 0x22, 0xCC,
+  0xCD, 0x8D, 0x72, 0xCF, 0x89, 0x06, 0x76, 0x86, 0x58, 0xCE, 0x7C, 0x64,
+  0x03, 0xA3, 0x00, 0xA2, 0x00, 0x07, 0x63, 0x7F, 0x1C, 0xCF, 0x37, 0x6C,
+  0x73, 0x99, 0xCF, 0x89, 0x07, 0x8A, 0x99, 0x77, 0x58, 0xD0, 0xD1, 0x27,
+  0x10, 0xA2, 0x00, 0xA0, 0x00, 0x07, 0x0F, 0x62, 0x08, 0x7C, 0xD2, 0xA9,
+  0xA7, 0x75, 0xD3, 0x89, 0x07, 0x8A, 0x6F, 0x50, 0xD0, 0xD3, 0xD4, 0x04,
+  0xB4, 0xA0, 0x00, 0xA0, 0x00, 0x07, 0x10, 0xCB, 0x2A, 0x49, 0xAF, 0x9A,
+  0x76, 0x8A, 0xD4, 0x89, 0x06, 0x99, 0x98, 0x6B, 0xD5, 0x1D, 0x0A, 0x03,
+  0xA0, 0x00, 0x9F, 0x00, 0x05, 0x25, 0x17, 0x7C, 0xC2, 0xB0, 0x86, 0xD9,
+  0x89, 0x06, 0x72, 0xD6, 0xB1, 0x1E, 0x7F, 0x80, 0x0F, 0x9E, 0x00, 0x9E,
+  0x00, 0x06, 0x01, 0x16, 0xD7, 0xD0, 0x51, 0x98, 0x99, 0xD9, 0x89, 0x06,
+  0x88, 0x73, 0x8C, 0x37, 0x5F, 0x7F, 0x25, 0x9E, 0x00, 0x9D, 0x00, 0x05,
+  0x01, 0x13, 0xB5, 0xD8, 0x50, 0x75, 0xA2, 0x89, 0x09, 0x8A, 0x99, 0x8B,
+  0x76, 0x74, 0x87, 0x73, 0x72, 0x71, 0x71, 0x83, 0x72, 0x09, 0x71, 0x71,
+  0x72, 0x72, 0x73, 0x87, 0x75, 0x8B, 0x99, 0x88, 0xA3, 0x89, 0x05, 0x54,
+  0x9B, 0xB7, 0x17, 0x10, 0x0F, 0x9C, 0x00, 0x9C, 0x00, 0x06, 0xB4, 0xAB,
+  0xC9, 0xA6, 0x56, 0x70, 0x8A, 0xA2, 0x89, 0x09, 0x76, 0x70, 0x6E, 0xA7,
+  0xBC, 0xA8, 0xD9, 0x97, 0x4F, 0x4F, 0x83, 0x97, 0x0A, 0x4F, 0x4F, 0x97,
+  0x50, 0xD9, 0x79, 0x53, 0x9A, 0x70, 0x74, 0x88, 0xA2, 0x89, 0x05, 0x75,
+  0x53, 0xD5, 0xDA, 0x13, 0x10, 0x9C, 0x00, 0x9B, 0x00, 0x04, 0xB4, 0x0E,
+  0x27, 0x1E, 0x58, 0x9F, 0x89, 0x0F, 0x8A, 0x8A, 0x99, 0x75, 0x71, 0x6E,
+  0xBC, 0x97, 0x7A, 0x5B, 0xDB, 0xA6, 0x32, 0x3A, 0x30, 0x30, 0x83, 0xDC,
+  0x0F, 0x30, 0x30, 0xDC, 0x3A, 0xAC, 0xA1, 0x34, 0x6A, 0x58, 0xA8, 0xA7,
+  0x98, 0x87, 0x8B, 0x8A, 0x8A, 0x9F, 0x89, 0x04, 0xC6, 0x3A, 0xC0, 0x15,
+  0x63, 0x9B, 0x00, 0x9A, 0x00, 0x05, 0x01, 0x03, 0x44, 0x83, 0x4B, 0x54,
+  0x9E, 0x89, 0x0E, 0x8A, 0x99, 0x74, 0x86, 0xDD, 0x6B, 0xDE, 0x5B, 0x5E,
+  0x2E, 0x2B, 0xB5, 0x0A, 0xA4, 0xB2, 0x88, 0x18, 0x0D, 0x19, 0xDF, 0xC9,
+  0x1C, 0xE0, 0xBE, 0xC7, 0xC5, 0xAF, 0x8D, 0x77, 0x75, 0x8B, 0x8A, 0x9E,
+  0x89, 0x05, 0x73, 0xD6, 0xA1, 0x28, 0x61, 0x63, 0x9A, 0x00, 0x99, 0x00,
+  0x06, 0xB4, 0xAB, 0xDF, 0xE1, 0x5C, 0x52, 0x75, 0x97, 0x89, 0x01, 0x8A,
+  0x8A, 0x83, 0x89, 0x0D, 0x99, 0x71, 0x78, 0xDE, 0xE2, 0xE3, 0xCF, 0x3C,
+  0x20, 0x67, 0xE4, 0x7F, 0x23, 0x43, 0x8C, 0x00, 0x0C, 0x03, 0x08, 0xC8,
+  0x7D, 0x5F, 0x95, 0x3B, 0x5E, 0x8E, 0xA9, 0xC6, 0x9A, 0x75, 0x84, 0x89,
+  0x00, 0x8A, 0x99, 0x89, 0x04, 0x6B, 0xE5, 0xC9, 0x13, 0x63, 0x99, 0x00,
+  0x98, 0x00, 0x07, 0x0F, 0x02, 0xE6, 0x1C, 0xCE, 0xC6, 0x74, 0x88, 0x97,
+  0x89, 0x01, 0x8A, 0x8A, 0x82, 0x89, 0x0E, 0x88, 0x6F, 0x79, 0xE2, 0x1E,
+  0x28, 0xA4, 0xB2, 0x17, 0x14, 0x24, 0x81, 0x62, 0x10, 0x0F, 0x8C, 0x00,
+  0x0D, 0xB4, 0x02, 0xAB, 0x61, 0x23, 0x16, 0x18, 0xAA, 0x28, 0xB6, 0xA1,
+  0xDE, 0x54, 0x8B, 0x83, 0x89, 0x00, 0x8A, 0x99, 0x89, 0x05, 0x77, 0x6A,
+  0xE7, 0xC8, 0x11, 0x01, 0x98, 0x00, 0x98, 0x00, 0x05, 0x01, 0x24, 0x1B,
+  0xE8, 0xE9, 0x73, 0x9B, 0x89, 0x08, 0x8B, 0x98, 0xA8, 0x7A, 0x5C, 0x5E,
+  0x3E, 0xBF, 0x04, 0x9D, 0x00, 0x09, 0x04, 0x44, 0x2A, 0xE7, 0x8F, 0x85,
+  0x51, 0x8C, 0x74, 0x8A, 0x9A, 0x89, 0x06, 0x99, 0x8C, 0x96, 0xD3, 0xEA,
+  0x04, 0x0F, 0x97, 0x00, 0x98, 0x00, 0x05, 0x63, 0x1A, 0x46, 0xEB, 0x6F,
+  0x88, 0x9B, 0x89, 0x08, 0x72, 0xAF, 0x69, 0x82, 0x60, 0xDF, 0x16, 0x04,
+  0x01, 0x9D, 0x00, 0x09, 0x01, 0x03, 0x13, 0x0D, 0x44, 0x9E, 0xDC, 0xBA,
+  0x53, 0x88, 0x9A, 0x89, 0x07, 0x8A, 0x76, 0xC6, 0x38, 0x82, 0x19, 0x43,
+  0x0F, 0x96, 0x00, 0x96, 0x00, 0x05, 0x0F, 0x43, 0x93, 0x7D, 0xC2, 0xA7,
+  0x9A, 0x89, 0x06, 0x75, 0x98, 0x52, 0xC5, 0xE8, 0x7D, 0x13, 0xA7, 0x00,
+  0x07, 0x24, 0x45, 0x3D, 0xDB, 0xE9, 0xBC, 0x6F, 0x8A, 0x99, 0x89, 0x05,
+  0x6F, 0x6A, 0x2F, 0xC9, 0x24, 0x01, 0x96, 0x00, 0x96, 0x00, 0x05, 0x10,
+  0x19, 0xA5, 0xE3, 0xEC, 0x73, 0x9A, 0x89, 0x06, 0x53, 0x4C, 0x3A, 0x7C,
+  0x0A, 0xB9, 0x25, 0xA7, 0x00, 0x07, 0x10, 0x23, 0x7F, 0x22, 0x3F, 0x5E,
+  0xED, 0x75, 0x99, 0x89, 0x05, 0x99, 0x6E, 0xBA, 0xD3, 0xAA, 0x10, 0x96,
+  0x00, 0x95, 0x00, 0x06, 0xB4, 0x94, 0xEE, 0x2E, 0x4E, 0x87, 0x88, 0x97,
+  0x89, 0x07, 0x99, 0x77, 0xD9, 0x34, 0x7B, 0x42, 0x08, 0x03, 0xAA, 0x00,
+  0x08, 0x0F, 0x10, 0x81, 0x1A, 0x41, 0xD8, 0xA9, 0x6D, 0x74, 0x99, 0x89,
+  0x05, 0x8D, 0x32, 0x9E, 0x15, 0x43, 0x0F, 0x94, 0x00, 0x94, 0x00, 0x07,
+  0xB4, 0x62, 0x1A, 0xD3, 0xEF, 0xDD, 0x88, 0x8A, 0x97, 0x89, 0x07, 0x6F,
+  0xBA, 0x30, 0x1C, 0x9D, 0x14, 0x62, 0xB4, 0xAC, 0x00, 0x06, 0x01, 0x03,
+  0xB2, 0xE4, 0xF0, 0x33, 0xBC, 0x99, 0x89, 0x05, 0x77, 0x6A, 0xDC, 0x45,
+  0x18, 0x25, 0x94, 0x00, 0x94, 0x00, 0x05, 0x10, 0x15, 0x45, 0xE8, 0xED,
+  0x71, 0x97, 0x89, 0x07, 0x76, 0x55, 0x7A, 0x68, 0xC0, 0x0D, 0x04, 0x01,
+  0xB0, 0x00, 0x08, 0x10, 0x12, 0x60, 0xB7, 0x84, 0x52, 0x6F, 0x8B, 0x8A,
+  0x95, 0x89, 0x05, 0x75, 0xDD, 0xA2, 0xCA, 0xF1, 0xAB, 0x94, 0x00, 0x94,
+  0x00, 0x05, 0x80, 0x0C, 0x20, 0x35, 0x6D, 0x76, 0x97, 0x89, 0x06, 0x6D,
+  0xD5, 0x1E, 0xC9, 0xB9, 0x62, 0x01, 0xB1, 0x00, 0x08, 0x0F, 0x63, 0x80,
+  0xAA, 0xB7, 0x5E, 0x59, 0x9A, 0x99, 0x95, 0x89, 0x05, 0x88, 0x74, 0xD6,
+  0xAE, 0x7C, 0x23, 0x94, 0x00, 0x93, 0x00, 0x06, 0xB4, 0x26, 0x67, 0x5E,
+  0xD9, 0x75, 0x88, 0x95, 0x89, 0x06, 0x75, 0x54, 0x96, 0x9F, 0x9D, 0x12,
+  0x06, 0xB6, 0x00, 0x07, 0x80, 0xA4, 0x67, 0xBE, 0xA9, 0x9A, 0x88, 0x8A,
+  0x95, 0x89, 0x05, 0x77, 0x6A, 0x47, 0xC3, 0x02, 0xB4, 0x92, 0x00, 0x92,
+  0x00, 0x07, 0x0F, 0x62, 0xC3, 0x2E, 0x36, 0x8C, 0x88, 0x8A, 0x94, 0x89,
+  0x06, 0x88, 0xDD, 0x8E, 0x1E, 0xA4, 0x05, 0x63, 0xB7, 0x00, 0x07, 0xB4,
+  0x62, 0x17, 0x9E, 0x31, 0xB0, 0x72, 0x88, 0x95, 0x89, 0x05, 0x73, 0xD6,
+  0x8F, 0x41, 0x64, 0x02, 0x92, 0x00, 0x92, 0x00, 0x05, 0x25, 0x19, 0x82,
+  0x33, 0x56, 0x87, 0x95, 0x89, 0x05, 0x74, 0x54, 0x37, 0x20, 0x0A, 0xB3,
+  0xBB, 0x00, 0x07, 0x01, 0xB2, 0xF2, 0xAE, 0xEC, 0x86, 0x8A, 0x8A, 0x93,
+  0x89, 0x05, 0x8B, 0x6E, 0x4D, 0x2F, 0x28, 0x81, 0x92, 0x00, 0x92, 0x00,
+  0x05, 0x07, 0x45, 0xA0, 0xEB, 0x77, 0x8B, 0x95, 0x89, 0x05, 0x55, 0x85,
+  0x47, 0x44, 0x04, 0xB4, 0xBC, 0x00, 0x06, 0x43, 0x19, 0xF3, 0xA1, 0x56,
+  0x75, 0x88, 0x93, 0x89, 0x05, 0x8A, 0x8B, 0x78, 0xCD, 0x2C, 0x13, 0x92,
+  0x00, 0x92, 0x00, 0x05, 0x26, 0x9F, 0x84, 0x6C, 0x8B, 0x8A, 0x91, 0x89,
+  0x07, 0x8A, 0x89, 0x8B, 0x71, 0x4E, 0x30, 0xF4, 0x62, 0xBF, 0x00, 0x07,
+  0x25, 0xEA, 0xD1, 0x4B, 0xDD, 0x73, 0x8A, 0x8A, 0x93, 0x89, 0x03, 0x72,
+  0xEC, 0xCF, 0x0D, 0x92, 0x00, 0x92, 0x00, 0x05, 0xB2, 0xE7, 0x59, 0x98,
+  0x8A, 0x8A, 0x91, 0x89, 0x07, 0x8A, 0x8A, 0x71, 0xA8, 0xD0, 0xE4, 0x0E,
+  0xB4, 0xBF, 0x00, 0x07, 0x0F, 0x80, 0xA4, 0x7B, 0xC5, 0x6D, 0x99, 0x8A,
+  0x93, 0x89, 0x04, 0x75, 0xBB, 0xA3, 0xBF, 0x06, 0x91, 0x00, 0x90, 0x00,
+  0x05, 0x01, 0x04, 0x92, 0x33, 0xBC, 0x75, 0x93, 0x89, 0x05, 0x88, 0x73,
+  0xD6, 0xD5, 0x3F, 0x23, 0xC3, 0x00, 0x05, 0x80, 0x45, 0x3B, 0xA9, 0x98,
+  0x8B, 0x93, 0x89, 0x05, 0x99, 0x6F, 0xBA, 0x2A, 0x19, 0x25, 0x90, 0x00,
+  0x90, 0x00, 0x05, 0x05, 0x0C, 0x83, 0x85, 0x98, 0x99, 0x93, 0x89, 0x05,
+  0x76, 0x53, 0xF5, 0x2A, 0xE6, 0x43, 0xC3, 0x00, 0x05, 0xB4, 0x0E, 0x92,
+  0x90, 0x56, 0x87, 0x93, 0x89, 0x05, 0x88, 0x75, 0x51, 0x49, 0x21, 0x24,
+  0x90, 0x00, 0x90, 0x00, 0x05, 0x24, 0xE1, 0x49, 0xD9, 0x74, 0x88, 0x91,
+  0x89, 0x06, 0x8A, 0x88, 0x77, 0xE9, 0x3A, 0xEA, 0x06, 0xC6, 0x00, 0x05,
+  0x23, 0xB6, 0xE2, 0x78, 0x76, 0x8A, 0x91, 0x89, 0x05, 0x8A, 0x88, 0x8C,
+  0xDE, 0x3C, 0x16, 0x90, 0x00, 0x90, 0x00, 0x05, 0x14, 0x2D, 0x36, 0x6D,
+  0x88, 0x8A, 0x91, 0x89, 0x05, 0x88, 0x74, 0xA8, 0xDB, 0xD3, 0xB9, 0xC7,
+  0x00, 0x05, 0x04, 0xF6, 0xE5, 0xC5, 0x55, 0x76, 0x91, 0x89, 0x05, 0x8A,
+  0x8A, 0x72, 0x8D, 0xD2, 0x17, 0x90, 0x00, 0x90, 0x00, 0x03, 0xB2, 0xE8,
+  0x6B, 0x6F, 0x93, 0x89, 0x05, 0x75, 0xBB, 0xBA, 0xCC, 0xC8, 0x04, 0xC7,
+  0x00, 0x05, 0x25, 0x17, 0xD7, 0x90, 0x50, 0x72, 0x93, 0x89, 0x05, 0x8B,
+  0x6E, 0xDB, 0x60, 0x10, 0x0F, 0x8E, 0x00, 0x90, 0x00, 0x03, 0xA4, 0xEF,
+  0x8C, 0x75, 0x93, 0x89, 0x05, 0x70, 0xA9, 0x3A, 0xF1, 0x81, 0x01, 0xC7,
+  0x00, 0x05, 0x0F, 0x43, 0xAA, 0x83, 0xAD, 0x77, 0x93, 0x89, 0x05, 0x88,
+  0x87, 0x37, 0x9E, 0x23, 0x25, 0x8E, 0x00, 0x8E, 0x00, 0x05, 0x06, 0x05,
+  0x28, 0x35, 0x87, 0x88, 0x91, 0x89, 0x05, 0x8A, 0x88, 0xBB, 0xD5, 0xD1,
+  0xB9, 0xCB, 0x00, 0x05, 0x11, 0xF7, 0xCF, 0x50, 0x73, 0x99, 0x91, 0x89,
+  0x05, 0x8A, 0x99, 0xAF, 0xCA, 0x0B, 0x81, 0x8E, 0x00, 0x8E, 0x00, 0x05,
+  0xAB, 0xF8, 0x1E, 0x4E, 0x8B, 0x8A, 0x91, 0x89, 0x05, 0x88, 0x87, 0x57,
+  0xE8, 0xD7, 0x94, 0xCB, 0x00, 0x05, 0x02, 0xC4, 0xE1, 0x5D, 0x56, 0x73,
+  0x91, 0x89, 0x05, 0x8A, 0x88, 0x8D, 0x33, 0x91, 0x16, 0x8E, 0x00, 0x8E,
+  0x00, 0x04, 0x23, 0xF9, 0xC2, 0xC6, 0x88, 0x92, 0x89, 0x05, 0x75, 0xDD,
+  0xCD, 0xB6, 0xBF, 0x80, 0xCB, 0x00, 0x05, 0xB4, 0xAB, 0x9D, 0x68, 0x36,
+  0x77, 0x92, 0x89, 0x04, 0x8A, 0x8C, 0xC1, 0xFA, 0xC4, 0x8E, 0x00, 0x8E,
+  0x00, 0x04, 0xB2, 0xCA, 0x35, 0x53, 0x88, 0x92, 0x89, 0x05, 0x86, 0x7A,
+  0xDC, 0x22, 0x13, 0x63, 0xCC, 0x00, 0x04, 0x01, 0x16, 0x7C, 0x33, 0x6D,
+  0x92, 0x89, 0x04, 0x8A, 0x70, 0xA8, 0x5E, 0xCB, 0x8E, 0x00, 0x8E, 0x00,
+  0x04, 0xDF, 0xD8, 0x4F, 0x6E, 0x88, 0x92, 0x89, 0x05, 0x6D, 0x5D, 0x2B,
+  0xC4, 0x25, 0x0F, 0xCD, 0x00, 0x05, 0x81, 0x28, 0x3A, 0xC6, 0x88, 0x8A,
+  0x91, 0x89, 0x03, 0x75, 0x77, 0xC7, 0x27, 0x8E, 0x00, 0x8E, 0x00, 0x04,
+  0xA4, 0xE3, 0xBC, 0x72, 0x8A, 0x92, 0x89, 0x04, 0xA8, 0x39, 0x45, 0x61,
+  0x0F, 0xCE, 0x00, 0x05, 0x05, 0x0A, 0xCC, 0x59, 0x74, 0x88, 0x91, 0x89,
+  0x03, 0x88, 0x8B, 0xA2, 0x65, 0x8E, 0x00, 0x8E, 0x00, 0x03, 0x60, 0xD5,
+  0x98, 0x76, 0x91, 0x89, 0x05, 0x88, 0x76, 0xAF, 0xE0, 0x0C, 0x80, 0xCF,
+  0x00, 0x05, 0xB3, 0xAA, 0xB7, 0xE2, 0xBB, 0x75, 0x93, 0x89, 0x03, 0x4D,
+  0x42, 0xB3, 0xB4, 0x8C, 0x00, 0x8E, 0x00, 0x03, 0x9D, 0xA2, 0x8B, 0x88,
+  0x91, 0x89, 0x05, 0x76, 0x55, 0x96, 0x9F, 0x60, 0x62, 0xCF, 0x00, 0x05,
+  0x10, 0x15, 0x45, 0x48, 0xDE, 0x6F, 0x93, 0x89, 0x03, 0x97, 0x2A, 0x14,
+  0x43, 0x8C, 0x00, 0x8C, 0x00, 0x03, 0x0F, 0x63, 0xF6, 0x7A, 0x93, 0x89,
+  0x05, 0x72, 0xEC, 0xD0, 0x41, 0xE6, 0x02, 0xCF, 0x00, 0x05, 0x01, 0x81,
+  0x60, 0x1D, 0xD5, 0x54, 0x93, 0x89, 0x03, 0xA8, 0x2D, 0xF8, 0x07, 0x8C,
+  0x00, 0x8C, 0x00, 0x03, 0x06, 0x11, 0xBD, 0xAF, 0x93, 0x89, 0x05, 0x77,
+  0x36, 0xFA, 0xEE, 0xFB, 0x63, 0xD0, 0x00, 0x04, 0x06, 0x24, 0x28, 0xDC,
+  0x6C, 0x93, 0x89, 0x04, 0x78, 0xD2, 0xF2, 0x93, 0x01, 0x8B, 0x00, 0x8C,
+  0x00, 0x03, 0x03, 0x1A, 0x1D, 0xD9, 0x93, 0x89, 0x05, 0x6D, 0xA1, 0x91,
+  0x1A, 0x03, 0xB4, 0xD1, 0x00, 0x03, 0x02, 0x44, 0x83, 0x51, 0x93, 0x89,
+  0x04, 0x55, 0xE2, 0x20, 0xAA, 0x10, 0x8B, 0x00, 0x8B, 0x00, 0x04, 0xB4,
+  0x23, 0xC0, 0x39, 0x8D, 0x93, 0x89, 0x04, 0x8D, 0x2E, 0xFC, 0x94, 0x01,
+  0xD2, 0x00, 0x03, 0x43, 0xD4, 0x5F, 0x97, 0x93, 0x89, 0x04, 0x86, 0x4E,
+  0x39, 0xBF, 0x02, 0x8B, 0x00, 0x8B, 0x00, 0x04, 0x06, 0x0D, 0x2B, 0x5D,
+  0x53, 0x93, 0x89, 0x03, 0x6B, 0x1D, 0xDF, 0x43, 0xD3, 0x00, 0x05, 0x43,
+  0x19, 0x9C, 0xEB, 0x76, 0x88, 0x91, 0x89, 0x05, 0x71, 0xD9, 0xCE, 0x0A,
+  0xB3, 0x0F, 0x8A, 0x00, 0x8B, 0x00, 0x04, 0x10, 0xA4, 0x95, 0x96, 0x55,
+  0x93, 0x89, 0x03, 0xAF, 0x3F, 0xC4, 0x02, 0xD3, 0x00, 0x05, 0x25, 0x93,
+  0xF9, 0xCD, 0x8C, 0x76, 0x91, 0x89, 0x04, 0x70, 0x97, 0x32, 0x0B, 0x02,
+  0x8B, 0x00, 0x8B, 0x00, 0x04, 0x25, 0xC3, 0x3B, 0xA9, 0x77, 0x91, 0x89,
+  0x05, 0x8A, 0x99, 0xEB, 0xFD, 0x64, 0x02, 0xD3, 0x00, 0x05, 0x10, 0x15,
+  0x29, 0xC7, 0x78, 0x74, 0x91, 0x89, 0x05, 0x72, 0x51, 0xC2, 0x65, 0xB3,
+  0x0F, 0x8A, 0x00, 0x8B, 0x00, 0x04, 0x25, 0xF8, 0xD8, 0xAF, 0x6F, 0x91,
+  0x89, 0x05, 0x99, 0x73, 0x85, 0xF3, 0x08, 0x43, 0xD3, 0x00, 0x05, 0x10,
+  0xB9, 0xA5, 0x4A, 0xBC, 0x74, 0x91, 0x89, 0x05, 0x76, 0x8C, 0xB1, 0xF6,
+  0x80, 0x0F, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x43, 0xBF, 0xAC, 0x4F,
+  0x70, 0x91, 0x89, 0x05, 0x8B, 0x77, 0xA2, 0x21, 0x19, 0x25, 0xD3, 0x00,
+  0x05, 0x63, 0x26, 0xDA, 0xAE, 0x56, 0x73, 0x91, 0x89, 0x05, 0x99, 0x73,
+  0xA2, 0x28, 0x03, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x43, 0x9D,
+  0xAC, 0x4F, 0x70, 0x91, 0x89, 0x05, 0x74, 0x53, 0xB1, 0x82, 0x17, 0x25,
+  0xD3, 0x00, 0x05, 0x06, 0x24, 0xF6, 0xCF, 0xDE, 0x6F, 0x91, 0x89, 0x05,
+  0x99, 0x74, 0x96, 0xF4, 0x03, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F,
+  0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05, 0x87, 0x8D, 0x9B, 0xA5,
+  0x16, 0x10, 0xD3, 0x00, 0x05, 0x01, 0x0E, 0x65, 0x7B, 0x37, 0x77, 0x91,
+  0x89, 0x05, 0x88, 0x75, 0xBA, 0x42, 0x05, 0xB4, 0x8A, 0x00, 0x8A, 0x00,
+  0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05, 0x87, 0xA8,
+  0x8F, 0x9E, 0x15, 0x10, 0xD3, 0x00, 0x05, 0x01, 0xAB, 0x27, 0x1E, 0x8E,
+  0x8C, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x05, 0xB4, 0x8A, 0x00,
+  0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05,
+  0x73, 0xA8, 0xA3, 0xD7, 0x15, 0x25, 0xD3, 0x00, 0x05, 0xB4, 0x05, 0x44,
+  0x9F, 0xD5, 0x54, 0x91, 0x89, 0x05, 0x88, 0x87, 0x35, 0x42, 0x04, 0xB4,
+  0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91,
+  0x89, 0x05, 0x73, 0x79, 0xEF, 0x9E, 0x15, 0x25, 0xD3, 0x00, 0x05, 0xB4,
+  0x03, 0x7F, 0x3F, 0x9B, 0x54, 0x91, 0x89, 0x05, 0x88, 0x87, 0x35, 0x42,
+  0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97,
+  0x70, 0x91, 0x89, 0x05, 0x87, 0x8D, 0x5D, 0xA5, 0x16, 0x25, 0xD3, 0x00,
+  0x05, 0xB4, 0x03, 0xCB, 0xD3, 0x5D, 0xA7, 0x91, 0x89, 0x05, 0x88, 0x74,
+  0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B,
+  0x32, 0x97, 0x70, 0x91, 0x89, 0x05, 0x87, 0x8D, 0x5D, 0xA5, 0x16, 0x25,
+  0xD3, 0x00, 0x05, 0xB4, 0x03, 0x7F, 0x5F, 0x9B, 0xA7, 0x91, 0x89, 0x05,
+  0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F,
+  0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05, 0x87, 0x8D, 0x5D, 0xA5,
+  0x16, 0x25, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91,
+  0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00,
+  0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05, 0x87, 0x8D,
+  0x5D, 0xA5, 0x16, 0x25, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB,
+  0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00,
+  0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05,
+  0x87, 0x8D, 0x5D, 0xA5, 0x16, 0x25, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA,
+  0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4,
+  0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91,
+  0x89, 0x05, 0x87, 0x8D, 0x5D, 0xA5, 0x16, 0x25, 0xD3, 0x00, 0x05, 0x01,
+  0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42,
+  0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97,
+  0x70, 0x91, 0x89, 0x05, 0x87, 0x8D, 0x5D, 0xA5, 0x16, 0x25, 0xD3, 0x00,
+  0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74,
+  0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B,
+  0x32, 0x97, 0x70, 0x91, 0x89, 0x05, 0x87, 0x8D, 0x5D, 0xA5, 0x16, 0x25,
+  0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05,
+  0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F,
+  0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05, 0x87, 0x8D, 0x5D, 0xA5,
+  0x16, 0x25, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91,
+  0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00,
+  0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05, 0x87, 0x8D,
+  0x5D, 0xA5, 0x16, 0x25, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB,
+  0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00,
+  0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91, 0x89, 0x05,
+  0x87, 0x8D, 0x5D, 0xA5, 0x16, 0x25, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA,
+  0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4,
+  0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x0B, 0x32, 0x97, 0x70, 0x91,
+  0x89, 0x05, 0x87, 0x8D, 0x5D, 0xA5, 0x16, 0x25, 0xD3, 0x00, 0x05, 0x01,
+  0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42,
+  0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x9D, 0xAC, 0x4F,
+  0x6F, 0x91, 0x89, 0x05, 0x73, 0x79, 0xEF, 0x9E, 0x15, 0x25, 0xD3, 0x00,
+  0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74,
+  0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F, 0x02, 0x9D,
+  0xAC, 0x4F, 0x6F, 0x91, 0x89, 0x05, 0x73, 0x79, 0xEF, 0x9E, 0x15, 0x25,
+  0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05,
+  0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00, 0x05, 0x0F,
+  0x02, 0x0C, 0xBE, 0xEC, 0x72, 0x91, 0x89, 0x05, 0x75, 0xBC, 0x4A, 0x29,
+  0x16, 0x25, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91,
+  0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8A, 0x00,
+  0x05, 0x0F, 0x02, 0x65, 0xA6, 0x79, 0x8B, 0x91, 0x89, 0x05, 0x8A, 0x55,
+  0x8E, 0x7D, 0x93, 0x25, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB,
+  0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00,
+  0x8B, 0x00, 0x04, 0x43, 0x0B, 0x32, 0x4F, 0x8C, 0x91, 0x72, 0x05, 0x77,
+  0xA8, 0x9B, 0xA5, 0x15, 0x10, 0xD3, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0x8B, 0x00, 0x05, 0x25, 0x7F, 0x95, 0x84, 0xA9, 0x50, 0x8F, 0x97,
+  0x06, 0x50, 0x59, 0xA2, 0x3A, 0x1B, 0x13, 0x63, 0xD3, 0x00, 0x05, 0x01,
+  0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42,
+  0x04, 0xB4, 0x8A, 0x00, 0x8B, 0x00, 0x05, 0x06, 0x16, 0xB5, 0x1F, 0xFA,
+  0x31, 0x8F, 0xDC, 0x06, 0x31, 0x2F, 0x2D, 0x67, 0xA4, 0x81, 0x01, 0xD3,
+  0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88,
+  0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0x8B, 0x00, 0x05, 0x0F, 0x43,
+  0x94, 0x14, 0x17, 0x19, 0x8F, 0x18, 0x05, 0x19, 0x17, 0x15, 0x24, 0x62,
+  0x06, 0xD4, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46,
+  0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A,
+  0x00, 0xFC, 0x00, 0x05, 0x01, 0x05, 0xEA, 0x46, 0xDB, 0x54, 0x91, 0x89,
+  0x05, 0x88, 0x74, 0x96, 0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFC, 0x00, 0x05,
+  0x01, 0x05, 0x44, 0x46, 0xDB, 0x54, 0x91, 0x89, 0x05, 0x88, 0x74, 0x96,
+  0x42, 0x04, 0xB4, 0x8A, 0x00, 0xFD, 0x00, 0x04, 0x43, 0xDF, 0xD1, 0x5D,
+  0xA7, 0x91, 0x89, 0x04, 0x99, 0x87, 0xA2, 0x1B, 0x02, 0x8B, 0x00, 0xFE,
+  0x00, 0x03, 0xB9, 0xE1, 0xD0, 0x6D, 0x91, 0x89, 0x03, 0x99, 0x73, 0xE2,
+  0x0B, 0x8C, 0x00, 0x04, 0x00, 0xB4, 0xB3, 0x05, 0x81, 0xF6, 0x07, 0x06,
+  0x81, 0x07, 0x0E, 0xEA, 0x46, 0x4A, 0x54, 0x91, 0x89, 0x06, 0x99, 0x87,
+  0x96, 0x42, 0x0E, 0x07, 0x81, 0x84, 0x07, 0x04, 0x81, 0x04, 0xB3, 0xB4,
+  0x00, 0x05, 0x00, 0xB3, 0xE6, 0x0A, 0xE4, 0x28, 0xF4, 0x7E, 0x07, 0x22,
+  0x22, 0x28, 0xDA, 0xFD, 0xAC, 0x85, 0x98, 0x91, 0x89, 0x07, 0x99, 0x75,
+  0x59, 0xCC, 0xDA, 0x28, 0x22, 0x22, 0x82, 0x7E, 0x05, 0x28, 0xE4, 0x65,
+  0xE6, 0xB3, 0x00, 0x05, 0x00, 0x94, 0xB5, 0xFE, 0xE7, 0x39, 0xF4, 0x31,
+  0x07, 0x3A, 0xDC, 0x39, 0x32, 0x33, 0x4C, 0x56, 0x73, 0x91, 0x89, 0x07,
+  0x88, 0x8B, 0x6C, 0x84, 0x32, 0x39, 0xDC, 0x3A, 0x82, 0x31, 0x05, 0x39,
+  0xE7, 0x2D, 0xD7, 0x11, 0x00, 0x04, 0x00, 0x93, 0x3C, 0x7A, 0xC6, 0xF6,
+  0xBC, 0x06, 0x6C, 0xBC, 0xDD, 0x6D, 0x77, 0x73, 0x99, 0x91, 0x89, 0x06,
+  0x8A, 0x8A, 0x87, 0x55, 0xDD, 0xBC, 0x6C, 0x84, 0xBC, 0x04, 0xC6, 0xEB,
+  0xE7, 0x17, 0x00, 0x03, 0x00, 0x0D, 0x5E, 0xDD, 0xFF, 0x89, 0x9D, 0x89,
+  0x03, 0xA7, 0xA6, 0x64, 0x00, 0x04, 0x00, 0x19, 0xD8, 0x6B, 0x73, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x87, 0x56, 0x48, 0xB2, 0x00, 0x04, 0x00, 0x18,
+  0x30, 0x58, 0x86, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x6F, 0x50, 0x31, 0x18,
+  0x00, 0x04, 0x00, 0x18, 0x30, 0x58, 0x86, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x6F, 0x50, 0x31, 0x18, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19,
+  0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x70, 0x57, 0x39, 0x19,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x4F, 0x6F, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x70, 0x57, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0x30, 0x58, 0x86, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x6F, 0x50, 0x31, 0x18, 0x00, 0x04, 0x00, 0x19,
+  0x30, 0x58, 0x86, 0xFF, 0x89, 0x9B, 0x89, 0x04, 0x6F, 0x50, 0x31, 0x18,
+  0x00, 0x04, 0x00, 0x19, 0xDC, 0x97, 0x70, 0xFF, 0x89, 0x9B, 0x89, 0x04,
+  0x71, 0xEC, 0x39, 0x19, 0x00, 0x04, 0x00, 0x19, 0x39, 0x57, 0x72, 0xFF,
+  0x89, 0x9B, 0x89, 0x04, 0x73, 0xD9, 0xCF, 0xB2, 0x00, 0x04, 0x00, 0x18,
+  0x3A, 0x97, 0x70, 0x82, 0x8A, 0xFF, 0x88, 0x95, 0x88, 0x82, 0x8A, 0x04,
+  0x71, 0xEC, 0x39, 0x19, 0x00, 0x0A, 0x00, 0x17, 0xE7, 0x59, 0x8C, 0x76,
+  0x75, 0x75, 0x74, 0x87, 0x87, 0xFF, 0x74, 0x8F, 0x74, 0x0A, 0x87, 0x87,
+  0x74, 0x75, 0x75, 0x76, 0x9A, 0xAF, 0x30, 0x18, 0x00, 0x0A, 0x00, 0xB9,
+  0x83, 0xE2, 0xB0, 0x8D, 0x79, 0x79, 0xA8, 0xC6, 0xC6, 0xFF, 0xA8, 0x8F,
+  0xA8, 0x0A, 0xC6, 0xC6, 0xA8, 0x79, 0x79, 0x8D, 0x58, 0xCD, 0x2D, 0x15,
+  0x00, 0x0A, 0x00, 0x24, 0x67, 0x30, 0xA1, 0xC7, 0x5C, 0x5C, 0xC7, 0xD5,
+  0xD5, 0xFF, 0xC7, 0x8F, 0xC7, 0x0A, 0xD5, 0xD5, 0xC7, 0x5C, 0xC7, 0xC7,
+  0xAE, 0x3A, 0x21, 0x12, 0x00, 0x0A, 0x00, 0x05, 0x9D, 0x29, 0x91, 0x3F,
+  0x46, 0x46, 0x5F, 0x3F, 0x3F, 0xFF, 0x5F, 0x8F, 0x5F, 0x0A, 0x3F, 0x3F,
+  0x5F, 0x46, 0x5F, 0x3F, 0x91, 0xF2, 0x0B, 0x05, 0x00, 0x04, 0x00, 0x01,
+  0x05, 0x11, 0xFB, 0xFF, 0x23, 0x9B, 0x23, 0x04, 0xFB, 0x61, 0x05, 0x01,
+  0x00, 0xFF, 0x00, 0xA5, 0x00
+};
+
+BITMAPDATA  unlock256 = { UNLOCK256_HEIGHT, UNLOCK256_WIDTH, NULL, 0, mUnlock256Palette, ARRAY_SIZE (mUnlock256Palette), mUnlock256RleData, sizeof (mUnlock256RleData) };
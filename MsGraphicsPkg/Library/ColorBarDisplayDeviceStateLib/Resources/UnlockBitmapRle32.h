@@ -0,0 +1,65 @@
+/** @file
+    Palette and run length encoded pixel data for 21 x 32 unlock bitmap
+
+    Generated by ConvertBitmapToRle.py from UnlockBitmap32.h.
+
+    Copyright (C) Microsoft Corporation. All rights reserved.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#pragma once
+
+#define UNLOCK32_WIDTH   (21)
+#define UNLOCK32_HEIGHT  (32)
+
+// 21 x 32, 64 colors, 319 bytes of packets
+CONST UINT32  mUnlock32Palette[] = {
+  0x00FF0000, 0x00FF1212, 0x00FF5353, 0x00FF7B7B,
+  0x00FF9494, 0x00FF5050, 0x00FF1414, 0x00FF9696,
+  0x00FFF3F3, 0x00FFFFFF, 0x00FF9191, 0x00FF3B3B,
+  0x00FFE2E2, 0x00FFE3E3, 0x00FF3535, 0x00FF2E2E,
+  0x00FFF2F2, 0x00FFFEFE, 0x00FFC1C1, 0x00FF8181,
+  0x00FF6E6E, 0x00FF8080, 0x00FFC4C4, 0x00FFF0F0,
+  0x00FF0909, 0x00FFD3D3, 0x00FFE0E0, 0x00FF4646,
+  0x00FF0101, 0x00FF4343, 0x00FF0808, 0x00FF6D6D,
+  0x00FFEAEA, 0x00FF2424, 0x00FF2525, 0x00FFEBEB,
+  0x00FF6C6C, 0x00FFC9C9, 0x00FF6767, 0x00FF6363,
+  0x00FFCACA, 0x00FF0F0F, 0x00FFFCFC, 0x00FFEFEF,
+  0x00FF0C0C, 0x00FF0E0E, 0x00FFF4F4, 0x00FF1919,
+  0x00FF3838, 0x00FFCDCD, 0x00FFD1D1, 0x00FF3636,
+  0x00FF3939, 0x00FFC8C8, 0x00FF5656, 0x00FFA1A1,
+  0x00FFEDED, 0x00FFFBFB, 0x00FFF1F1, 0x00FFAEAE,
+  0x00FF9F9F, 0x00FF6666, 0x00FF9797, 0x00FF5D5D
+};
+
+CONST UINT8  mUnlock32RleData[] = {
+  0x86, 0x00, 0x06, 0x01, 0x02, 0x03, 0x04, 0x03, 0x05, 0x01, 0x86, 0x00,
+  0x84, 0x00, 0x02, 0x06, 0x07, 0x08, 0x84, 0x09, 0x02, 0x08, 0x0A, 0x01,
+  0x84, 0x00, 0x83, 0x00, 0x01, 0x0B, 0x0C, 0x88, 0x09, 0x01, 0x0D, 0x0E,
+  0x83, 0x00, 0x82, 0x00, 0x0E, 0x0F, 0x10, 0x09, 0x09, 0x11, 0x12, 0x13,
+  0x14, 0x15, 0x16, 0x11, 0x09, 0x09, 0x17, 0x0F, 0x82, 0x00, 0x07, 0x00,
+  0x00, 0x18, 0x19, 0x09, 0x09, 0x1A, 0x1B, 0x83, 0x00, 0x08, 0x1C, 0x1D,
+  0x0D, 0x09, 0x09, 0x19, 0x1E, 0x00, 0x00, 0x06, 0x00, 0x00, 0x1F, 0x09,
+  0x09, 0x20, 0x21, 0x86, 0x00, 0x06, 0x22, 0x23, 0x09, 0x09, 0x24, 0x00,
+  0x00, 0x05, 0x00, 0x00, 0x25, 0x09, 0x09, 0x26, 0x88, 0x00, 0x05, 0x27,
+  0x09, 0x09, 0x28, 0x00, 0x00, 0x05, 0x00, 0x29, 0x2A, 0x09, 0x2B, 0x2C,
+  0x88, 0x00, 0x05, 0x2D, 0x2E, 0x09, 0x2A, 0x2F, 0x00, 0x04, 0x00, 0x30,
+  0x09, 0x09, 0x31, 0x8A, 0x00, 0x04, 0x32, 0x09, 0x11, 0x33, 0x00, 0x04,
+  0x00, 0x34, 0x09, 0x09, 0x35, 0x8A, 0x00, 0x04, 0x12, 0x09, 0x09, 0x34,
+  0x00, 0x04, 0x00, 0x34, 0x09, 0x09, 0x35, 0x8A, 0x00, 0x04, 0x12, 0x09,
+  0x09, 0x34, 0x00, 0x04, 0x00, 0x2F, 0x1F, 0x14, 0x36, 0x8A, 0x00, 0x04,
+  0x12, 0x09, 0x09, 0x34, 0x00, 0x8F, 0x00, 0x04, 0x12, 0x09, 0x09, 0x34,
+  0x00, 0x8F, 0x00, 0x04, 0x12, 0x09, 0x09, 0x34, 0x00, 0x8F, 0x00, 0x04,
+  0x12, 0x09, 0x09, 0x34, 0x00, 0x8F, 0x00, 0x04, 0x12, 0x09, 0x09, 0x34,
+  0x00, 0x8F, 0x00, 0x04, 0x12, 0x09, 0x09, 0x34, 0x00, 0x00, 0x37, 0x8E,
+  0x38, 0x04, 0x39, 0x09, 0x09, 0x3A, 0x04, 0x00, 0x3B, 0x92, 0x09, 0x00,
+  0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00, 0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00,
+  0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00, 0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00,
+  0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00, 0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00,
+  0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00, 0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00,
+  0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00, 0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00,
+  0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00, 0x3C, 0x00, 0x3B, 0x92, 0x09, 0x00,
+  0x3C, 0x00, 0x3D, 0x92, 0x3E, 0x00, 0x3F
+};
+
+BITMAPDATA  unlock32 = { UNLOCK32_HEIGHT, UNLOCK32_WIDTH, NULL, 0, mUnlock32Palette, ARRAY_SIZE (mUnlock32Palette), mUnlock32RleData, sizeof (mUnlock32RleData) };
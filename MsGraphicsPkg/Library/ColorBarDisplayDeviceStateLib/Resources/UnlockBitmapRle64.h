@@ -0,0 +1,119 @@
+/** @file
+    Palette and run length encoded pixel data for 42 x 64 unlock bitmap
+
+    Generated by ConvertBitmapToRle.py from UnlockBitmap64.h.
+
+    Copyright (C) Microsoft Corporation. All rights reserved.
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#pragma once
+
+#define UNLOCK64_WIDTH   (42)
+#define UNLOCK64_HEIGHT  (64)
+
+// 42 x 64, 111 colors, 819 bytes of packets
+CONST UINT32  mUnlock64Palette[] = {
+  0x00FF0000, 0x00FF0C0C, 0x00FF2E2E, 0x00FF2C2C,
+  0x00FF0909, 0x00FF0E0E, 0x00FF3838, 0x00FF8484,
+  0x00FFC8C8, 0x00FFEAEA, 0x00FFF7F7, 0x00FFFAFA,
+  0x00FFECEC, 0x00FFC7C7, 0x00FF7777, 0x00FF3B3B,
+  0x00FF0B0B, 0x00FF1010, 0x00FFD7D7, 0x00FFF6F6,
+  0x00FFFFFF, 0x00FFF8F8, 0x00FFD6D6, 0x00FF6464,
+  0x00FF1212, 0x00FF0101, 0x00FF5050, 0x00FFD1D1,
+  0x00FFFEFE, 0x00FFFCFC, 0x00FFD2D2, 0x00FF4848,
+  0x00FF9090, 0x00FF9393, 0x00FF0707, 0x00FF1515,
+  0x00FFC9C9, 0x00FFB6B6, 0x00FF1616, 0x00FF0D0D,
+  0x00FFCBCB, 0x00FFFBFB, 0x00FFEDED, 0x00FFDFDF,
+  0x00FFDBDB, 0x00FFDEDE, 0x00FFEEEE, 0x00FFC4C4,
+  0x00FFA2A2, 0x00FFBCBC, 0x00FF4D4D, 0x00FF2B2B,
+  0x00FF5353, 0x00FFC2C2, 0x00FFAAAA, 0x00FF0202,
+  0x00FF6565, 0x00FFFDFD, 0x00FF4141, 0x00FF4646,
+  0x00FF2323, 0x00FFE9E9, 0x00FF8888, 0x00FF0A0A,
+  0x00FF0404, 0x00FF9595, 0x00FFF9F9, 0x00FF2121,
+  0x00FF9F9F, 0x00FF8383, 0x00FF0303, 0x00FF0505,
+  0x00FF8686, 0x00FFF2F2, 0x00FFAEAE, 0x00FF0808,
+  0x00FFB0B0, 0x00FF2424, 0x00FF6363, 0x00FF2A2A,
+  0x00FFF1F1, 0x00FF5D5D, 0x00FF8585, 0x00FF7676,
+  0x00FFCECE, 0x00FFF0F0, 0x00FF2929, 0x00FF3232,
+  0x00FFF5F5, 0x00FF1414, 0x00FF3737, 0x00FFCFCF,
+  0x00FFDDDD, 0x00FF5151, 0x00FF6D6D, 0x00FFA7A7,
+  0x00FFB7B7, 0x00FF6666, 0x00FF7272, 0x00FF8E8E,
+  0x00FF6262, 0x00FFDADA, 0x00FF7B7B, 0x00FF4F4F,
+  0x00FFD9D9, 0x00FFEBEB, 0x00FF4444, 0x00FF5858,
+  0x00FFF4F4, 0x00FF3939, 0x00FF0F0F
+};
+
+CONST UINT8  mUnlock64RleData[] = {
+  0x92, 0x00, 0x03, 0x01, 0x02, 0x03, 0x04, 0x92, 0x00, 0x8D, 0x00, 0x0D,
+  0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0B, 0x0A, 0x0C, 0x0D, 0x0E,
+  0x0F, 0x10, 0x8D, 0x00, 0x8B, 0x00, 0x03, 0x11, 0x0E, 0x12, 0x13, 0x89,
+  0x14, 0x03, 0x15, 0x16, 0x17, 0x18, 0x8B, 0x00, 0x89, 0x00, 0x03, 0x19,
+  0x1A, 0x1B, 0x1C, 0x8D, 0x14, 0x02, 0x1D, 0x1E, 0x1F, 0x8A, 0x00, 0x88,
+  0x00, 0x02, 0x05, 0x20, 0x0B, 0x91, 0x14, 0x02, 0x1D, 0x21, 0x22, 0x88,
+  0x00, 0x87, 0x00, 0x02, 0x23, 0x24, 0x1C, 0x93, 0x14, 0x02, 0x1C, 0x25,
+  0x26, 0x87, 0x00, 0x86, 0x00, 0x02, 0x27, 0x28, 0x1C, 0x86, 0x14, 0x07,
+  0x29, 0x2A, 0x2B, 0x2C, 0x2C, 0x2D, 0x2E, 0x29, 0x86, 0x14, 0x02, 0x1C,
+  0x2F, 0x27, 0x86, 0x00, 0x85, 0x00, 0x01, 0x22, 0x30, 0x86, 0x14, 0x0B,
+  0x1D, 0x31, 0x32, 0x33, 0x10, 0x00, 0x00, 0x22, 0x03, 0x34, 0x35, 0x1D,
+  0x85, 0x14, 0x02, 0x1C, 0x36, 0x37, 0x85, 0x00, 0x85, 0x00, 0x01, 0x38,
+  0x39, 0x84, 0x14, 0x02, 0x39, 0x28, 0x3A, 0x88, 0x00, 0x03, 0x37, 0x3B,
+  0x35, 0x1C, 0x85, 0x14, 0x00, 0x17, 0x85, 0x00, 0x84, 0x00, 0x01, 0x3C,
+  0x3D, 0x84, 0x14, 0x02, 0x0B, 0x3E, 0x3F, 0x8B, 0x00, 0x02, 0x40, 0x41,
+  0x42, 0x84, 0x14, 0x01, 0x3D, 0x43, 0x84, 0x00, 0x84, 0x00, 0x01, 0x44,
+  0x1C, 0x83, 0x14, 0x02, 0x39, 0x45, 0x46, 0x8D, 0x00, 0x02, 0x47, 0x48,
+  0x1D, 0x84, 0x14, 0x01, 0x30, 0x19, 0x83, 0x00, 0x83, 0x00, 0x01, 0x3C,
+  0x49, 0x84, 0x14, 0x01, 0x4A, 0x4B, 0x8F, 0x00, 0x01, 0x22, 0x4C, 0x84,
+  0x14, 0x01, 0x3D, 0x4D, 0x83, 0x00, 0x83, 0x00, 0x01, 0x4E, 0x1C, 0x83,
+  0x14, 0x01, 0x2E, 0x4F, 0x91, 0x00, 0x01, 0x4D, 0x50, 0x83, 0x14, 0x01,
+  0x39, 0x51, 0x83, 0x00, 0x83, 0x00, 0x00, 0x2F, 0x83, 0x14, 0x01, 0x1C,
+  0x52, 0x93, 0x00, 0x01, 0x53, 0x1C, 0x83, 0x14, 0x00, 0x54, 0x83, 0x00,
+  0x82, 0x00, 0x01, 0x46, 0x49, 0x83, 0x14, 0x01, 0x55, 0x56, 0x93, 0x00,
+  0x01, 0x57, 0x58, 0x83, 0x14, 0x01, 0x13, 0x59, 0x82, 0x00, 0x82, 0x00,
+  0x00, 0x5A, 0x84, 0x14, 0x01, 0x5B, 0x4B, 0x93, 0x00, 0x01, 0x40, 0x5C,
+  0x83, 0x14, 0x01, 0x1D, 0x5D, 0x82, 0x00, 0x82, 0x00, 0x00, 0x5E, 0x84,
+  0x14, 0x00, 0x5F, 0x95, 0x00, 0x00, 0x60, 0x83, 0x14, 0x01, 0x39, 0x61,
+  0x82, 0x00, 0x82, 0x00, 0x00, 0x62, 0x84, 0x14, 0x00, 0x20, 0x95, 0x00,
+  0x00, 0x63, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x82, 0x00, 0x00,
+  0x62, 0x84, 0x14, 0x00, 0x20, 0x95, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01,
+  0x1C, 0x62, 0x82, 0x00, 0x82, 0x00, 0x00, 0x62, 0x84, 0x14, 0x00, 0x20,
+  0x95, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x82,
+  0x00, 0x00, 0x62, 0x84, 0x14, 0x00, 0x20, 0x95, 0x00, 0x00, 0x45, 0x83,
+  0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x82, 0x00, 0x00, 0x62, 0x84, 0x14,
+  0x00, 0x20, 0x95, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82,
+  0x00, 0x82, 0x00, 0x01, 0x64, 0x65, 0x83, 0x2C, 0x00, 0x66, 0x95, 0x00,
+  0x00, 0x45, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x9F, 0x00, 0x00,
+  0x45, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x9F, 0x00, 0x00, 0x45,
+  0x83, 0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x9F, 0x00, 0x00, 0x45, 0x83,
+  0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x9F, 0x00, 0x00, 0x45, 0x83, 0x14,
+  0x01, 0x1C, 0x62, 0x82, 0x00, 0x9F, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01,
+  0x1C, 0x62, 0x82, 0x00, 0x9F, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01, 0x1C,
+  0x62, 0x82, 0x00, 0x9F, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01, 0x1C, 0x62,
+  0x82, 0x00, 0x9F, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82,
+  0x00, 0x9F, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82, 0x00,
+  0x9F, 0x00, 0x00, 0x45, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x9F,
+  0x00, 0x00, 0x45, 0x83, 0x14, 0x01, 0x1C, 0x62, 0x82, 0x00, 0x01, 0x67,
+  0x68, 0x9D, 0x2C, 0x00, 0x2A, 0x84, 0x14, 0x03, 0x69, 0x2C, 0x16, 0x0F,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5,
+  0x14, 0x01, 0x42, 0x6A, 0x01, 0x51, 0x1C, 0xA5, 0x14, 0x01, 0x42, 0x6A,
+  0x01, 0x6B, 0x49, 0xA5, 0x6C, 0x01, 0x2E, 0x3A, 0x00, 0x59, 0xA6, 0x6D,
+  0x01, 0x5A, 0x6E
+};
+
+BITMAPDATA  unlock64 = { UNLOCK64_HEIGHT, UNLOCK64_WIDTH, NULL, 0, mUnlock64Palette, ARRAY_SIZE (mUnlock64Palette), mUnlock64RleData, sizeof (mUnlock64RleData) };
@@ -8,6 +8,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Base.h>
 #include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/FrameBufferMemDrawLib.h>
@@ -19,6 +21,9 @@ FRAME_BUFFER_CONFIGURE  *mFrameBufferConfig    = NULL;
 UINTN                   mFrameBufferConfigSize = 0;
 UINT32                  mModeConfigredFor      = 0xFFFFF; // set to a really high mode that likely won't be supported
 
+// The mode mFrameBufferConfig was last checked against
+STATIC EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE  *mFrameBufferMode = NULL;
+
 VOID
 FreeFrameBufferConfig (
   VOID
@@ -49,6 +54,8 @@ SetupFrameBufferConfig (
     return Status;
   }
 
+  mFrameBufferMode = Mode;
+
   if (mFrameBufferConfig != NULL) {
     // Check if we need to update it
     if (mModeConfigredFor == Mode->Mode) {
@@ -187,6 +194,315 @@ MemFillOnFrameBuffer (
   return Status;
 }
 
+/**
+Fills a run of pixels with a single color, using 64 bit stores for all but
+an unaligned first pixel and an odd last pixel.
+
+@param Pixels            - The first pixel to fill
+@param Count             - Number of pixels to fill
+@param Color             - The color to fill with
+**/
+STATIC
+VOID
+FillPixels (
+  IN  UINT32  *Pixels,
+  IN  UINTN   Count,
+  IN  UINT32  Color
+  )
+{
+  UINTN  Pairs;
+
+  if ((Count > 0) && (((UINTN)Pixels & (sizeof (UINT64) - 1)) != 0)) {
+    *Pixels++ = Color;
+    Count--;
+  }
+
+  Pairs = Count / 2;
+  if (Pairs > 0) {
+    SetMem64 (Pixels, Pairs * sizeof (UINT64), LShiftU64 (Color, 32) | Color);
+    Pixels += Pairs * 2;
+  }
+
+  if ((Count & 1) != 0) {
+    *Pixels = Color;
+  }
+}
+
+/**
+Renders one row of a fill, 1bpp expand or checkerboard command.
+
+@param Command           - The command to render
+@param Row               - The row of the command, from 0 to Height - 1
+@param Pixels            - Where to write the Width pixels of the row
+**/
+STATIC
+VOID
+RenderCommandRow (
+  IN  CONST MEM_DRAW_COMMAND  *Command,
+  IN  INT32                   Row,
+  OUT UINT32                  *Pixels
+  )
+{
+  CONST UINT8  *Bits;
+  UINT32       Color;
+  UINT32       OtherColor;
+  UINT32       Swap;
+  INT32        Column;
+  INT32        Run;
+  UINT8        Set;
+
+  switch (Command->Operation) {
+    case MemDrawFill:
+      FillPixels (Pixels, Command->Width, Command->Color1);
+      break;
+
+    case MemDrawExpand1Bpp:
+      // Fill each run of equal bits at once, stepping over whole bytes of one color
+      Bits = (CONST UINT8 *)Command->Data + (INTN)Row * Command->Delta;
+      for (Column = 0; Column < Command->Width; Column += Run) {
+        Set = (Bits[Column >> 3] >> (7 - (Column & 7))) & 1;
+        Run = 1;
+        while (Column + Run < Command->Width) {
+          if ((((Column + Run) & 7) == 0) &&
+              (Column + Run + 8 <= Command->Width) &&
+              (Bits[(Column + Run) >> 3] == (Set ? 0xFF : 0x00)))
+          {
+            Run += 8;
+          } else if (((Bits[(Column + Run) >> 3] >> (7 - ((Column + Run) & 7))) & 1) == Set) {
+            Run++;
+          } else {
+            break;
+          }
+        }
+
+        FillPixels (Pixels + Column, Run, Set ? Command->Color1 : Command->Color2);
+      }
+
+      break;
+
+    case MemDrawCheckerboard:
+      Color      = Command->Color1;
+      OtherColor = Command->Color2;
+      if (((Row / Command->SquareSize) & 1) != 0) {
+        Color      = Command->Color2;
+        OtherColor = Command->Color1;
+      }
+
+      for (Column = 0; Column < Command->Width; Column += Command->SquareSize) {
+        FillPixels (Pixels + Column, MIN (Command->SquareSize, Command->Width - Column), Color);
+        Swap       = Color;
+        Color      = OtherColor;
+        OtherColor = Swap;
+      }
+
+      break;
+
+    default:
+      ASSERT (FALSE);
+      break;
+  }
+}
+
+/**
+Checks that a command is well formed and inside of the frame buffer.
+
+@param Command           - The command to check
+@param Info              - The mode of the frame buffer
+
+@retval TRUE             - The command can be drawn.
+@retval FALSE            - The command is invalid.
+**/
+STATIC
+BOOLEAN
+IsCommandValid (
+  IN  CONST MEM_DRAW_COMMAND                      *Command,
+  IN  CONST EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  *Info
+  )
+{
+  if ((Command->X < 0) || (Command->Y < 0) || (Command->Width < 0) || (Command->Height < 0)) {
+    return FALSE;
+  }
+
+  if (((UINT64)Command->X + Command->Width > Info->HorizontalResolution) ||
+      ((UINT64)Command->Y + Command->Height > Info->VerticalResolution))
+  {
+    return FALSE;
+  }
+
+  switch (Command->Operation) {
+    case MemDrawFill:
+      return TRUE;
+
+    case MemDrawCopy:
+    case MemDrawExpand1Bpp:
+      return (BOOLEAN)(Command->Data != NULL);
+
+    case MemDrawCheckerboard:
+      return (BOOLEAN)(Command->SquareSize > 0);
+
+    default:
+      return FALSE;
+  }
+}
+
+/**
+Function to draw a list of primitives onto the frame buffer
+We assume colors and data are in 32 bit RGB reserved format
+
+The frame buffer configuration is checked once for the whole list, and every command is
+checked against the frame buffer before any is drawn.  When the frame buffer is in the
+same pixel format the commands are written straight into it, otherwise each command goes
+through FrameBufferBltLib.
+
+@param Commands          - The primitives to draw, in order
+@param CommandCount      - Number of commands in Commands
+
+@retval EFI_SUCCESS            - All of the commands were drawn.
+@retval EFI_INVALID_PARAMETER  - A command is invalid or outside of the frame buffer.  Nothing
+                                 was drawn.
+@retval Others                 - The frame buffer is not ready to draw.
+**/
+EFI_STATUS
+EFIAPI
+MemDrawListOnFrameBuffer (
+  IN  CONST MEM_DRAW_COMMAND  *Commands,
+  IN  UINTN                   CommandCount
+  )
+{
+  EFI_STATUS              Status;
+  CONST MEM_DRAW_COMMAND  *Command;
+  UINT32                  *FrameBuffer;
+  UINT32                  *Pixels;
+  UINT32                  *RowBuffer;
+  UINTN                   Stride;
+  UINTN                   Index;
+  INT32                   Row;
+  BOOLEAN                 NeedRowBuffer;
+
+  if ((Commands == NULL) && (CommandCount != 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  // Check if the frame buffer config is out of date in terms of mode
+  Status = SetupFrameBufferConfig ();
+  if ((mFrameBufferConfig == NULL) || (mFrameBufferMode == NULL)) {
+    Status = EFI_NOT_READY;
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "[%a %a:%d] we aren't setup to draw. Error: %r\n", __FILE__, __FUNCTION__, __LINE__, Status));
+    return Status;
+  }
+
+  // Only write the frame buffer directly when it holds pixels exactly as we do
+  FrameBuffer = NULL;
+  Stride      = mFrameBufferMode->Info->PixelsPerScanLine;
+  if ((mFrameBufferMode->Info->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) &&
+      (mFrameBufferMode->FrameBufferBase != 0))
+  {
+    FrameBuffer = (UINT32 *)(UINTN)mFrameBufferMode->FrameBufferBase;
+  }
+
+  NeedRowBuffer = FALSE;
+  for (Index = 0; Index < CommandCount; Index++) {
+    if (!IsCommandValid (&Commands[Index], mFrameBufferMode->Info)) {
+      DEBUG ((DEBUG_ERROR, "[%a %a:%d] command %u is invalid\n", __FILE__, __FUNCTION__, __LINE__, (UINT32)Index));
+      return EFI_INVALID_PARAMETER;
+    }
+
+    if ((Commands[Index].Operation == MemDrawExpand1Bpp) || (Commands[Index].Operation == MemDrawCheckerboard)) {
+      NeedRowBuffer = TRUE;
+    }
+  }
+
+  RowBuffer = NULL;
+  if ((FrameBuffer == NULL) && NeedRowBuffer) {
+    RowBuffer = AllocatePool (mFrameBufferMode->Info->HorizontalResolution * sizeof (UINT32));
+    if (RowBuffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
+
+  for (Index = 0; Index < CommandCount && !EFI_ERROR (Status); Index++) {
+    Command = &Commands[Index];
+    if ((Command->Width == 0) || (Command->Height == 0)) {
+      continue;
+    }
+
+    if (FrameBuffer != NULL) {
+      Pixels = FrameBuffer + (UINTN)Command->Y * Stride + Command->X;
+      for (Row = 0; Row < Command->Height; Row++, Pixels += Stride) {
+        if (Command->Operation == MemDrawCopy) {
+          CopyMem (Pixels, (CONST UINT8 *)Command->Data + (INTN)Row * Command->Delta, Command->Width * sizeof (UINT32));
+        } else {
+          RenderCommandRow (Command, Row, Pixels);
+        }
+      }
+
+      continue;
+    }
+
+    if (Command->Operation == MemDrawFill) {
+      Status = FrameBufferBlt (
+                 mFrameBufferConfig,
+                 (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)&Command->Color1,
+                 EfiBltVideoFill,
+                 0,
+                 0,
+                 Command->X,
+                 Command->Y,
+                 Command->Width,
+                 Command->Height,
+                 0
+                 );
+    } else if ((Command->Operation == MemDrawCopy) && (Command->Delta > 0)) {
+      Status = FrameBufferBlt (
+                 mFrameBufferConfig,
+                 (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)Command->Data,
+                 EfiBltBufferToVideo,
+                 0,
+                 0,
+                 Command->X,
+                 Command->Y,
+                 Command->Width,
+                 Command->Height,
+                 Command->Delta
+                 );
+    } else {
+      for (Row = 0; Row < Command->Height && !EFI_ERROR (Status); Row++) {
+        Pixels = (UINT32 *)((CONST UINT8 *)Command->Data + (INTN)Row * Command->Delta);
+        if (Command->Operation != MemDrawCopy) {
+          Pixels = RowBuffer;
+          RenderCommandRow (Command, Row, Pixels);
+        }
+
+        Status = FrameBufferBlt (
+                   mFrameBufferConfig,
+                   (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)Pixels,
+                   EfiBltBufferToVideo,
+                   0,
+                   0,
+                   Command->X,
+                   Command->Y + Row,
+                   Command->Width,
+                   1,
+                   0
+                   );
+      }
+    }
+
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "[%a %a:%d] can't draw command %u. Error: %r\n", __FILE__, __FUNCTION__, __LINE__, (UINT32)Index, Status));
+    }
+  }
+
+  if (RowBuffer != NULL) {
+    FreePool (RowBuffer);
+  }
+
+  return Status;
+}
+
 /**
     The destructor frees the frame buffer config
     @param  ImageHandle   The firmware allocated handle for the EFI image.
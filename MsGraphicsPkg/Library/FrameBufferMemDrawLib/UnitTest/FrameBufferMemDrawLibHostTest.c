@@ -0,0 +1,588 @@
+/** @file
+  This module tests that the draw lists of FrameBufferMemDrawLib render the same pixels as
+  drawing each primitive by hand, into a fake frame buffer, and measures the cost of each
+  primitive drawn alone and in a list.
+
+  Copyright (c) Microsoft Corporation
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifdef FRAME_BUFFER_MEM_DRAW_LIB_HOST_BENCHMARK
+  #include <time.h>
+#endif
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/FrameBufferMemDrawLib.h>
+#include <Library/UnitTestLib.h>
+#include "../FrameBufferMemDrawLib.h"
+
+#define UNIT_TEST_NAME     "FrameBufferMemDrawLib Host Test"
+#define UNIT_TEST_VERSION  "0.1"
+
+#define TEST_SCREEN_WIDTH        640
+#define TEST_SCREEN_HEIGHT       480
+#define TEST_SCAN_LINE           648                    // Padded past the visible width
+#define TEST_SOURCE_WIDTH        96
+#define TEST_SOURCE_HEIGHT       64
+#define TEST_BITS_DELTA          12                     // Bytes in each row of mBits
+#define TEST_BACKGROUND          0x00563456             // Same in BGR and RGB
+#define BENCHMARK_PASSES         200
+#define BENCHMARK_PRIMITIVES     256
+
+STATIC UINT32                                mFrameBuffer[TEST_SCAN_LINE * TEST_SCREEN_HEIGHT];
+STATIC UINT32                                mExpected[TEST_SCAN_LINE * TEST_SCREEN_HEIGHT];
+STATIC UINT32                                mSource[TEST_SOURCE_WIDTH * TEST_SOURCE_HEIGHT];
+STATIC UINT8                                 mBits[TEST_BITS_DELTA * TEST_SOURCE_HEIGHT];
+STATIC EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  mModeInfo;
+STATIC EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE     mMode;
+STATIC UINTN                                 mGraphicsInfoCalls;
+
+/**
+  Hands FrameBufferMemDrawLib the fake frame buffer, counting each time it is asked.
+**/
+EFI_STATUS
+GetGraphicsInfo (
+  EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE  **Mode
+  )
+{
+  mGraphicsInfoCalls++;
+  *Mode = &mMode;
+  return EFI_SUCCESS;
+}
+
+/**
+  Sets up a mode for the fake frame buffer in the given pixel format.
+**/
+STATIC
+VOID
+TestSetPixelFormat (
+  IN EFI_GRAPHICS_PIXEL_FORMAT  PixelFormat
+  )
+{
+  mModeInfo.Version              = 0;
+  mModeInfo.HorizontalResolution = TEST_SCREEN_WIDTH;
+  mModeInfo.VerticalResolution   = TEST_SCREEN_HEIGHT;
+  mModeInfo.PixelFormat          = PixelFormat;
+  mModeInfo.PixelsPerScanLine    = TEST_SCAN_LINE;
+
+  // A new mode number makes the library configure itself again
+  mMode.MaxMode         = 2;
+  mMode.Mode            = (mMode.Mode + 1) % mMode.MaxMode;
+  mMode.Info            = &mModeInfo;
+  mMode.SizeOfInfo      = sizeof (mModeInfo);
+  mMode.FrameBufferBase = (EFI_PHYSICAL_ADDRESS)(UINTN)mFrameBuffer;
+  mMode.FrameBufferSize = sizeof (mFrameBuffer);
+}
+
+/**
+  Fills the screen and the expected screen with the background, and the sources with a pattern.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestReset (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  Index;
+
+  TestSetPixelFormat (PixelBlueGreenRedReserved8BitPerColor);
+  SetMem32 (mFrameBuffer, sizeof (mFrameBuffer), TEST_BACKGROUND);
+  SetMem32 (mExpected, sizeof (mExpected), TEST_BACKGROUND);
+
+  for (Index = 0; Index < ARRAY_SIZE (mSource); Index++) {
+    mSource[Index] = (UINT32)(Index * 2654435761u) & 0x00FFFFFF;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mBits); Index++) {
+    mBits[Index] = (UINT8)((Index * 37) ^ (Index >> 3));
+  }
+
+  mBits[0] = 0x00;
+  mBits[1] = 0xFF;
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Draws a command into the expected screen, one pixel at a time.
+**/
+STATIC
+VOID
+TestDrawExpected (
+  IN CONST MEM_DRAW_COMMAND  *Command
+  )
+{
+  INT32        Row;
+  INT32        Column;
+  UINT32       Pixel;
+  CONST UINT8  *Data;
+
+  for (Row = 0; Row < Command->Height; Row++) {
+    Data = (CONST UINT8 *)Command->Data + (INTN)Row * Command->Delta;
+    for (Column = 0; Column < Command->Width; Column++) {
+      switch (Command->Operation) {
+        case MemDrawCopy:
+          Pixel = ((CONST UINT32 *)Data)[Column];
+          break;
+
+        case MemDrawExpand1Bpp:
+          Pixel = ((Data[Column / 8] & (0x80 >> (Column % 8))) != 0) ? Command->Color1 : Command->Color2;
+          break;
+
+        case MemDrawCheckerboard:
+          Pixel = (((Row / Command->SquareSize + Column / Command->SquareSize) % 2) == 0) ? Command->Color1 : Command->Color2;
+          break;
+
+        default:
+          Pixel = Command->Color1;
+          break;
+      }
+
+      mExpected[(Command->Y + Row) * TEST_SCAN_LINE + Command->X + Column] = Pixel;
+    }
+  }
+}
+
+/**
+  Builds a command.
+**/
+STATIC
+MEM_DRAW_COMMAND
+TestCommand (
+  IN MEM_DRAW_OPERATION  Operation,
+  IN INT32               X,
+  IN INT32               Y,
+  IN INT32               Width,
+  IN INT32               Height,
+  IN CONST VOID          *Data,
+  IN INTN                Delta
+  )
+{
+  MEM_DRAW_COMMAND  Command;
+
+  ZeroMem (&Command, sizeof (Command));
+  Command.Operation  = Operation;
+  Command.X          = X;
+  Command.Y          = Y;
+  Command.Width      = Width;
+  Command.Height     = Height;
+  Command.Color1     = 0x00FF8000;
+  Command.Color2     = 0x000040C0;
+  Command.Data       = Data;
+  Command.Delta      = Delta;
+  Command.SquareSize = 5;
+  return Command;
+}
+
+/**
+  Builds a list with each kind of command at odd and even positions and sizes.
+**/
+STATIC
+UINTN
+TestBuildList (
+  OUT MEM_DRAW_COMMAND  *Commands
+  )
+{
+  UINTN  Count;
+
+  Count             = 0;
+  Commands[Count++] = TestCommand (MemDrawFill, 0, 0, TEST_SCREEN_WIDTH, 3, NULL, 0);
+  Commands[Count++] = TestCommand (MemDrawFill, 1, 5, 1, 7, NULL, 0);
+  Commands[Count++] = TestCommand (MemDrawFill, 3, 7, 2, 2, NULL, 0);
+  Commands[Count++] = TestCommand (MemDrawFill, 17, 20, 101, 9, NULL, 0);
+  Commands[Count++] = TestCommand (MemDrawFill, 40, 40, 0, 9, NULL, 0);
+  Commands[Count++] = TestCommand (MemDrawCopy, 9, 33, TEST_SOURCE_WIDTH, TEST_SOURCE_HEIGHT, mSource, TEST_SOURCE_WIDTH * sizeof (UINT32));
+  Commands[Count++] = TestCommand (MemDrawCopy, 120, 33, 45, 30, mSource + 3, 0);
+  Commands[Count++] = TestCommand (MemDrawCopy, 200, 33, 31, 40, mSource + TEST_SOURCE_WIDTH + 40, sizeof (UINT32));
+  Commands[Count++] = TestCommand (
+                        MemDrawCopy,
+                        300,
+                        33,
+                        TEST_SOURCE_WIDTH,
+                        TEST_SOURCE_HEIGHT,
+                        mSource + (TEST_SOURCE_HEIGHT - 1) * TEST_SOURCE_WIDTH,
+                        -(INTN)(TEST_SOURCE_WIDTH * sizeof (UINT32))
+                        );
+  Commands[Count++] = TestCommand (MemDrawExpand1Bpp, 11, 120, TEST_BITS_DELTA * 8, TEST_SOURCE_HEIGHT, mBits, TEST_BITS_DELTA);
+  Commands[Count++] = TestCommand (MemDrawExpand1Bpp, 150, 120, 61, TEST_SOURCE_HEIGHT, mBits + 1, TEST_BITS_DELTA);
+  Commands[Count++] = TestCommand (MemDrawExpand1Bpp, 250, 120, 13, 20, mBits + 5, 0);
+  Commands[Count++] = TestCommand (MemDrawCheckerboard, 13, 250, 99, 51, NULL, 0);
+  Commands[Count++] = TestCommand (MemDrawCheckerboard, 150, 250, 64, 64, NULL, 0);
+  Commands[Count - 1].SquareSize = 8;
+  Commands[Count++]              = TestCommand (MemDrawCheckerboard, TEST_SCREEN_WIDTH - 7, TEST_SCREEN_HEIGHT - 7, 7, 7, NULL, 0);
+  Commands[Count - 1].SquareSize = 1;
+  Commands[Count++]              = TestCommand (MemDrawFill, 100, 100, 300, 300, NULL, 0);
+  Commands[Count - 1].Color1     = 0x00ABCDEF;
+  Commands[Count++]              = TestCommand (MemDrawFill, TEST_SCREEN_WIDTH - 1, TEST_SCREEN_HEIGHT - 1, 1, 1, NULL, 0);
+
+  return Count;
+}
+
+/**
+  Converts the expected screen from BGR to RGB pixels.
+**/
+STATIC
+VOID
+TestSwapExpectedRedAndBlue (
+  VOID
+  )
+{
+  UINTN   Index;
+  UINT32  Pixel;
+
+  for (Index = 0; Index < ARRAY_SIZE (mExpected); Index++) {
+    Pixel            = mExpected[Index];
+    mExpected[Index] = (Pixel & 0xFF00FF00) | ((Pixel >> 16) & 0xFF) | ((Pixel & 0xFF) << 16);
+  }
+}
+
+/**
+  Each kind of command draws the same pixels as drawing it by hand, and nothing else.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestEachCommand (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MEM_DRAW_COMMAND  Commands[32];
+  UINTN             Count;
+  UINTN             Index;
+
+  Count = TestBuildList (Commands);
+  for (Index = 0; Index < Count; Index++) {
+    UT_ASSERT_NOT_EFI_ERROR (MemDrawListOnFrameBuffer (&Commands[Index], 1));
+    TestDrawExpected (&Commands[Index]);
+    UT_ASSERT_MEM_EQUAL (mFrameBuffer, mExpected, sizeof (mFrameBuffer));
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A whole list draws the same pixels as drawing its commands in order.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestList (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MEM_DRAW_COMMAND  Commands[32];
+  UINTN             Count;
+  UINTN             Index;
+
+  Count = TestBuildList (Commands);
+  UT_ASSERT_NOT_EFI_ERROR (MemDrawListOnFrameBuffer (Commands, Count));
+  for (Index = 0; Index < Count; Index++) {
+    TestDrawExpected (&Commands[Index]);
+  }
+
+  UT_ASSERT_MEM_EQUAL (mFrameBuffer, mExpected, sizeof (mFrameBuffer));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Fills and copies in a list draw the same pixels as MemFillOnFrameBuffer and MemDrawOnFrameBuffer.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestListMatchesSingleCalls (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MEM_DRAW_COMMAND  Commands[32];
+  UINTN             Count;
+  UINTN             Index;
+
+  Count = TestBuildList (Commands);
+  for (Index = 0; Index < Count; Index++) {
+    if (Commands[Index].Width == 0) {
+      continue;
+    }
+
+    if (Commands[Index].Operation == MemDrawFill) {
+      UT_ASSERT_NOT_EFI_ERROR (
+        MemFillOnFrameBuffer (Commands[Index].Color1, Commands[Index].X, Commands[Index].Y, Commands[Index].Width, Commands[Index].Height)
+        );
+    } else if ((Commands[Index].Operation == MemDrawCopy) && (Commands[Index].Delta == (INTN)(Commands[Index].Width * sizeof (UINT32)))) {
+      UT_ASSERT_NOT_EFI_ERROR (
+        MemDrawOnFrameBuffer ((UINT32 *)Commands[Index].Data, Commands[Index].X, Commands[Index].Y, Commands[Index].Width, Commands[Index].Height)
+        );
+    } else {
+      Commands[Index].Width = 0;
+    }
+  }
+
+  CopyMem (mExpected, mFrameBuffer, sizeof (mFrameBuffer));
+  SetMem32 (mFrameBuffer, sizeof (mFrameBuffer), TEST_BACKGROUND);
+
+  UT_ASSERT_NOT_EFI_ERROR (MemDrawListOnFrameBuffer (Commands, Count));
+  UT_ASSERT_MEM_EQUAL (mFrameBuffer, mExpected, sizeof (mFrameBuffer));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A frame buffer in another pixel format is drawn through FrameBufferBltLib.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestOtherPixelFormat (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MEM_DRAW_COMMAND  Commands[32];
+  UINTN             Count;
+  UINTN             Index;
+
+  TestSetPixelFormat (PixelRedGreenBlueReserved8BitPerColor);
+
+  Count = TestBuildList (Commands);
+  UT_ASSERT_NOT_EFI_ERROR (MemDrawListOnFrameBuffer (Commands, Count));
+  for (Index = 0; Index < Count; Index++) {
+    TestDrawExpected (&Commands[Index]);
+  }
+
+  TestSwapExpectedRedAndBlue ();
+  UT_ASSERT_MEM_EQUAL (mFrameBuffer, mExpected, sizeof (mFrameBuffer));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A list with an invalid command fails without drawing any of the list.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestInvalidCommands (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MEM_DRAW_COMMAND  Commands[32];
+  MEM_DRAW_COMMAND  Invalid[8];
+  UINTN             Count;
+  UINTN             Index;
+
+  Invalid[0]            = TestCommand (MemDrawFill, TEST_SCREEN_WIDTH - 10, 0, 11, 1, NULL, 0);
+  Invalid[1]            = TestCommand (MemDrawFill, 0, TEST_SCREEN_HEIGHT, 1, 1, NULL, 0);
+  Invalid[2]            = TestCommand (MemDrawFill, -1, 0, 1, 1, NULL, 0);
+  Invalid[3]            = TestCommand (MemDrawFill, 0, 0, 1, -1, NULL, 0);
+  Invalid[4]            = TestCommand (MemDrawCopy, 0, 0, 1, 1, NULL, 0);
+  Invalid[5]            = TestCommand (MemDrawExpand1Bpp, 0, 0, 1, 1, NULL, 0);
+  Invalid[6]            = TestCommand (MemDrawCheckerboard, 0, 0, 1, 1, NULL, 0);
+  Invalid[6].SquareSize = 0;
+  Invalid[7]            = TestCommand ((MEM_DRAW_OPERATION)(MemDrawCheckerboard + 1), 0, 0, 1, 1, NULL, 0);
+
+  Count = TestBuildList (Commands);
+  for (Index = 0; Index < ARRAY_SIZE (Invalid); Index++) {
+    Commands[Count] = Invalid[Index];
+    UT_ASSERT_STATUS_EQUAL (MemDrawListOnFrameBuffer (Commands, Count + 1), EFI_INVALID_PARAMETER);
+    UT_ASSERT_MEM_EQUAL (mFrameBuffer, mExpected, sizeof (mFrameBuffer));
+  }
+
+  UT_ASSERT_STATUS_EQUAL (MemDrawListOnFrameBuffer (NULL, 1), EFI_INVALID_PARAMETER);
+  UT_ASSERT_NOT_EFI_ERROR (MemDrawListOnFrameBuffer (NULL, 0));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A list looks up the frame buffer once, where each single call looks it up again.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestConfigurationCheckedOnce (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MEM_DRAW_COMMAND  Commands[32];
+  UINTN             Count;
+  UINTN             Index;
+
+  Count = TestBuildList (Commands);
+  UT_ASSERT_NOT_EFI_ERROR (MemDrawListOnFrameBuffer (NULL, 0));
+
+  mGraphicsInfoCalls = 0;
+  UT_ASSERT_NOT_EFI_ERROR (MemDrawListOnFrameBuffer (Commands, Count));
+  UT_ASSERT_EQUAL (mGraphicsInfoCalls, 1);
+
+  mGraphicsInfoCalls = 0;
+  for (Index = 0; Index < Count; Index++) {
+    UT_ASSERT_NOT_EFI_ERROR (MemFillOnFrameBuffer (0, 0, 0, 1, 1));
+  }
+
+  UT_ASSERT_EQUAL (mGraphicsInfoCalls, Count);
+
+  return UNIT_TEST_PASSED;
+}
+
+#ifdef FRAME_BUFFER_MEM_DRAW_LIB_HOST_BENCHMARK
+
+/**
+  Returns nanoseconds per primitive for the clock ticks spent drawing BENCHMARK_PASSES lists.
+**/
+STATIC
+UINT64
+BenchmarkNanoseconds (
+  IN clock_t  Start
+  )
+{
+  return (UINT64)(clock () - Start) * 1000000000 / CLOCKS_PER_SEC / BENCHMARK_PASSES / BENCHMARK_PRIMITIVES;
+}
+
+/**
+  Time small primitives drawn one call at a time and as one list.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+BenchmarkPrimitives (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  STATIC MEM_DRAW_COMMAND  Commands[BENCHMARK_PRIMITIVES];
+  STATIC CONST CHAR8       *Names[] = { "Fill", "Copy", "Expand1Bpp", "Checkerboard" };
+  UINTN                    Operation;
+  UINTN                    Pass;
+  UINTN                    Index;
+  clock_t                  Start;
+
+  for (Operation = MemDrawFill; Operation <= MemDrawCheckerboard; Operation++) {
+    for (Index = 0; Index < BENCHMARK_PRIMITIVES; Index++) {
+      Commands[Index] = TestCommand (
+                          (MEM_DRAW_OPERATION)Operation,
+                          (INT32)(Index % 32) * 19,
+                          (INT32)(Index / 32) * 19,
+                          16,
+                          16,
+                          (Operation == MemDrawCopy) ? (CONST VOID *)mSource : (CONST VOID *)mBits,
+                          (Operation == MemDrawCopy) ? TEST_SOURCE_WIDTH * sizeof (UINT32) : TEST_BITS_DELTA
+                          );
+    }
+
+    if (Operation == MemDrawFill) {
+      Start = clock ();
+      for (Pass = 0; Pass < BENCHMARK_PASSES; Pass++) {
+        for (Index = 0; Index < BENCHMARK_PRIMITIVES; Index++) {
+          MemFillOnFrameBuffer (Commands[Index].Color1, Commands[Index].X, Commands[Index].Y, 16, 16);
+        }
+      }
+
+      UT_LOG_INFO ("MemFillOnFrameBuffer 16x16: %ld ns each\n", BenchmarkNanoseconds (Start));
+    }
+
+    if (Operation == MemDrawCopy) {
+      Start = clock ();
+      for (Pass = 0; Pass < BENCHMARK_PASSES; Pass++) {
+        for (Index = 0; Index < BENCHMARK_PRIMITIVES; Index++) {
+          MemDrawOnFrameBuffer (mSource, Commands[Index].X, Commands[Index].Y, 16, 16);
+        }
+      }
+
+      UT_LOG_INFO ("MemDrawOnFrameBuffer 16x16: %ld ns each\n", BenchmarkNanoseconds (Start));
+    }
+
+    Start = clock ();
+    for (Pass = 0; Pass < BENCHMARK_PASSES; Pass++) {
+      UT_ASSERT_NOT_EFI_ERROR (MemDrawListOnFrameBuffer (Commands, BENCHMARK_PRIMITIVES));
+    }
+
+    UT_LOG_INFO ("MemDrawListOnFrameBuffer %a 16x16: %ld ns each\n", Names[Operation], BenchmarkNanoseconds (Start));
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+#endif
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  frame buffer draw lists and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UefiTestMain (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      DrawListSuiteHandle;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Create a suite
+  //
+  Status = CreateUnitTestSuite (&DrawListSuiteHandle, Framework, "FrameBufferMemDrawLib Draw Lists", "FrameBufferMemDrawLib.DrawList", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for DrawListSuiteHandle\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // Register Tests
+  //
+  AddTestCase (DrawListSuiteHandle, "Each command draws its pixels and no others", "EachCommand", TestEachCommand, TestReset, NULL, NULL);
+  AddTestCase (DrawListSuiteHandle, "A list draws its commands in order", "List", TestList, TestReset, NULL, NULL);
+  AddTestCase (DrawListSuiteHandle, "A list matches single fill and draw calls", "SingleCalls", TestListMatchesSingleCalls, TestReset, NULL, NULL);
+  AddTestCase (DrawListSuiteHandle, "Other pixel formats draw through FrameBufferBltLib", "OtherPixelFormat", TestOtherPixelFormat, TestReset, NULL, NULL);
+  AddTestCase (DrawListSuiteHandle, "A list with an invalid command draws nothing", "InvalidCommands", TestInvalidCommands, TestReset, NULL, NULL);
+  AddTestCase (DrawListSuiteHandle, "A list checks the frame buffer once", "ConfigurationCheckedOnce", TestConfigurationCheckedOnce, TestReset, NULL, NULL);
+ #ifdef FRAME_BUFFER_MEM_DRAW_LIB_HOST_BENCHMARK
+  AddTestCase (DrawListSuiteHandle, "Time small primitives alone and in a list", "Benchmark", BenchmarkPrimitives, TestReset, NULL, NULL);
+ #endif
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UefiTestMain ();
+}
@@ -58,3 +58,21 @@ MemFillOnFrameBuffer (
   ASSERT (FALSE);
   return EFI_NO_RESPONSE;
 }
+
+/**
+Function to draw a list of primitives onto the frame buffer
+We assume colors and data are in 32 bit RGB reserved format
+
+@param Commands          - The primitives to draw, in order
+@param CommandCount      - Number of commands in Commands
+**/
+EFI_STATUS
+EFIAPI
+MemDrawListOnFrameBuffer (
+  IN  CONST MEM_DRAW_COMMAND  *Commands,
+  IN  UINTN                   CommandCount
+  )
+{
+  ASSERT (FALSE);
+  return EFI_NO_RESPONSE;
+}
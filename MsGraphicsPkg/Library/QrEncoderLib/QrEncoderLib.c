@@ -3,6 +3,10 @@ QrEncoderLib.c
 
 QrEncoderLib is used to generate a QR code from caller data.
 
+All of the encoder state is kept in a context allocated for each QrEncodeData call, so the
+encoder is reentrant.  The QR matrix is kept as rows of bits, so the data masks are applied
+and scored a word of modules at a time.
+
 Copyright (C) Microsoft Corporation. All rights reserved.
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -20,40 +24,68 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "QrEncoderTables.h"
 
+#define BITS_PER_BYTE  8
+
 // *----------------------------------------------------------------------------*
-// *   Global Variables                                prefix g for Global      *
+// *   Encoder Context                                                          *
 // *----------------------------------------------------------------------------*
-UINT8                          gQrVersion;
-INTN                           gQrSize;
-QRLEVEL                        gQrLevel;
-QRENCODING                     gQrMode;
-INTN                           gQrMask;
-UINT8                          *gQrBitmap = NULL;
-INTN                           gQrBitmapLen;
-UINT8                          *gCodeWords = NULL;
-UINTN                          gCodeWordCount;
-UINT8                          *gECWords = NULL;
-UINTN                          gECWordCount;
-UINT8                          *gBitStream = NULL;
-UINTN                          gBitStreamCount;
-CONST QrTableEntry             *gQrT;
-UINT32                         gFlags;
-EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *gBltBuffer = NULL;
-
-// Module Colors
-#define  QrRsvd     0x03
-#define  QrWhite    0x02
-#define  QrBlack    0x01
-#define  QrGray     0x00
-#define  QrExclude  0x80       // Color mask to assist with XOR pattern
-
-// Module Drawing state
-static BOOLEAN  up;
-static BOOLEAN  right;
-static INTN     row;
-static INTN     col;
+#define QR_MAX_SIZE        (QrMaxVersion * 4 + 17)                              // Modules on each side of a version 40 QR code
+#define QR_MAX_CODE_WORDS  3706                                                 // Data and EC code words in a version 40 QR code
+#define QR_MAX_EC_WORDS    30                                                   // Most EC words per block, ISO 18004:2015 Table 9
+#define QR_MASK_PERIOD     12                                                   // Every mask pattern repeats each 12 rows and columns
+#define QR_WORD_BITS       (sizeof (UINTN) * BITS_PER_BYTE)
+#define QR_ROW_WORDS       ((QR_MAX_SIZE + QR_WORD_BITS - 1) / QR_WORD_BITS)
+#define QR_WORD(Column)    ((Column) / QR_WORD_BITS)
+#define QR_BIT(Column)     ((UINTN)1 << ((Column) % QR_WORD_BITS))
+
+//
+// A row of modules, one bit per module.  Module Column is bit QR_BIT(Column) of word QR_WORD(Column).
+//
+typedef UINTN QR_ROW[QR_ROW_WORDS];
+
+typedef struct {
+  UINT8                            Version;
+  INTN                             Size;                                                // Modules on each side of the QR code
+  QRLEVEL                          Level;
+  QRENCODING                       Mode;
+  INTN                             Mask;
+  UINT32                           Flags;
+  CONST QrTableEntry               *QrT;
+
+  UINT8                            CodeWords[QR_MAX_CODE_WORDS];
+  UINTN                            CodeWordCount;
+  UINT8                            ECWords[QR_MAX_CODE_WORDS];
+  UINTN                            ECWordCount;
+  UINT8                            BitStream[QR_MAX_CODE_WORDS];
+  UINTN                            BitStreamCount;
+
+  UINTN                            CwIndex;                                             // AddCodeWordBits state
+  UINTN                            CwUsed;
+  UINTN                            CwTarget;
+
+  BOOLEAN                          Up;                                                  // Module drawing state
+  BOOLEAN                          Right;
+  INTN                             Row;
+  INTN                             Col;
+
+  UINT8                            GeneratorProducts[GF256_SIZE][QR_MAX_EC_WORDS];     // Generator polynomial multiplied by each value
+
+  UINTN                            RowWords;                                            // Words used by each row
+  QR_ROW                           ValidRow;                                            // Bits of the modules in a row
+  QR_ROW                           Dark[QR_MAX_SIZE];                                   // QrBlack modules
+  QR_ROW                           Function[QR_MAX_SIZE];                               // QrExclude modules, not masked
+  QR_ROW                           Used[QR_MAX_SIZE];                                   // Modules that are not QrGray
+  QR_ROW                           Reserved[QR_MAX_SIZE];                               // QrRsvd modules
+  QR_ROW                           DarkT[QR_MAX_SIZE];                                  // Dark and Function by column
+  QR_ROW                           FunctionT[QR_MAX_SIZE];
+  QR_ROW                           Masked[QR_MAX_SIZE];                                 // Dark with a mask applied, by row
+  QR_ROW                           MaskedT[QR_MAX_SIZE];                                // and by column
+  QR_ROW                           Pattern[QR_MASK_PATTERNS][QR_MASK_PERIOD];           // Mask pattern rows
+  QR_ROW                           PatternT[QR_MASK_PATTERNS][QR_MASK_PERIOD];          // Mask pattern columns
+
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *BltBuffer;
+} QR_ENCODER_CONTEXT;
 
-#define BITS_PER_BYTE  8
 // *----------------------------------------------------------------------------*
 // *   Check Encoding Type.                                                     *
 // *   Checks the data stream and returns the lowest encoding type for the      *
@@ -106,10 +138,12 @@ CheckEncodingType (
 // *   Checks the data stream and returns the lowest encoding type for the      *
 // *   data                                                                     *
 // *----------------------------------------------------------------------------*
+static
 UINT8
 CheckQrVersion (
-  UINT8   *Data,
-  UINT16  DataLen
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT8               *Data,
+  UINT16              DataLen
   )
 {
   UINTN               i;
@@ -117,13 +151,13 @@ CheckQrVersion (
   UINT16              qLen;
   CONST QrTableEntry  *QrT;
 
-  // Start with Version 1 table entry - using qQrLevel to select which of the 4 entries per version to look at
-  for (i = gQrLevel - 1; i < QR_TABLE_ENTRIES; i += 4) {
+  // Start with Version 1 table entry - using Level to select which of the 4 entries per version to look at
+  for (i = Ctx->Level - 1; i < QR_TABLE_ENTRIES; i += 4) {
     // Spec has versions 1-40, and 4 EC levels.
     QrT = &gQrTable[i];
     DEBUG ((DEBUG_INFO, "Checking version table entry %d\n", i));
 
-    switch (gQrMode) {
+    switch (Ctx->Mode) {
       case QrNumericMode:
         qLen = QrT->maxNumeric;
         break;
@@ -135,7 +169,7 @@ CheckQrVersion (
         break;
       default:
         qLen = 0;
-        DEBUG ((DEBUG_ERROR, "%a Internal error - QrMode invalid %d\n", __FUNCTION__, gQrMode));
+        DEBUG ((DEBUG_ERROR, "%a Internal error - QrMode invalid %d\n", __FUNCTION__, Ctx->Mode));
         ASSERT (FALSE);
     }
 
@@ -154,31 +188,22 @@ CheckQrVersion (
   return Version;
 }
 
-// *----------------------------------------------------------------------------*
-// *   Private Variables for AddCodeWordBits    prefix pv for Private Variables *
-// *----------------------------------------------------------------------------*
-static UINTN  pvCwIndex;
-static UINTN  pvCwUsed;
-static UINTN  pvCwTarget;
-
 /*--------------------------------------------------------------------------------*/
 /*  Init Code Word Bits                                                           */
-/*       Bits           - The bits to be added                                    */
-/*       Count          - Number of bits.  Intended to work with number of bits in*/
-/*                        Bits - 1                                                */
-/*       NOTE:  It is the callers responsibility to free the gCodeWords array     */
+/*       NumberOfCodeWords - Number of data code words in the QR code             */
 /*--------------------------------------------------------------------------------*/
 static
 VOID
 InitCodeWords (
-  UINTN  NumberOfCodeWords
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINTN               NumberOfCodeWords
   )
 {
-  gCodeWords     = AllocateZeroPool (NumberOfCodeWords); // CodeWords needs to be zeros.
-  gCodeWordCount = NumberOfCodeWords;
-  pvCwIndex      = 0;
-  pvCwUsed       = 0;
-  pvCwTarget     = NumberOfCodeWords;
+  ZeroMem (Ctx->CodeWords, NumberOfCodeWords);   // CodeWords needs to be zeros.
+  Ctx->CodeWordCount = NumberOfCodeWords;
+  Ctx->CwIndex       = 0;
+  Ctx->CwUsed        = 0;
+  Ctx->CwTarget      = NumberOfCodeWords;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -190,46 +215,44 @@ InitCodeWords (
 static
 VOID
 AddCodeWordBits (
-  UINTN  Bits,
-  UINTN  Count
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINTN               Bits,
+  UINTN               Count
   )
 {
   // allows bits up to 31/63
   UINTN  temp;
   UINTN  mask;
 
-  if (gFlags & QR_FLAGS_DEBUG_ENCODING) {
+  if (Ctx->Flags & QR_FLAGS_DEBUG_ENCODING) {
     DEBUG ((DEBUG_INFO, "Adding %d bits %x\n", Count, Bits));
   }
 
-  ASSERT (gCodeWords != NULL);
-
   while (Count > 0) {
     mask = (-1 << Count);
     temp = Bits & ~mask;
 
-    if (Count <= (BITS_PER_BYTE - pvCwUsed)) {
+    if (Count <= (BITS_PER_BYTE - Ctx->CwUsed)) {
       // All remaining bits fit into this CodeWord
-      temp    <<= (BITS_PER_BYTE - pvCwUsed) - Count;
-      pvCwUsed += Count;
-      Count     = 0;
+      temp       <<= (BITS_PER_BYTE - Ctx->CwUsed) - Count;
+      Ctx->CwUsed += Count;
+      Count        = 0;
     } else {
       // Take up to 8 bits from the remaining bits
-      temp    >>= Count - (BITS_PER_BYTE - pvCwUsed);
-      Count    -= (BITS_PER_BYTE - pvCwUsed);
-      pvCwUsed += BITS_PER_BYTE - pvCwUsed;
+      temp       >>= Count - (BITS_PER_BYTE - Ctx->CwUsed);
+      Count       -= (BITS_PER_BYTE - Ctx->CwUsed);
+      Ctx->CwUsed += BITS_PER_BYTE - Ctx->CwUsed;
     }
 
-    if (pvCwIndex < pvCwTarget) {
-      gCodeWords[pvCwIndex] |= (UINT8)temp;
+    if (Ctx->CwIndex < Ctx->CwTarget) {
+      Ctx->CodeWords[Ctx->CwIndex] |= (UINT8)temp;
     } else {
       DEBUG ((DEBUG_ERROR, "Unable to store bits %d\n", temp));
     }
 
-    gCodeWords[pvCwIndex] |= (UINT8)temp;
-    if (pvCwUsed == BITS_PER_BYTE) {
-      pvCwIndex++;
-      pvCwUsed = 0;
+    if (Ctx->CwUsed == BITS_PER_BYTE) {
+      Ctx->CwIndex++;
+      Ctx->CwUsed = 0;
     }
   }
 }
@@ -275,15 +298,12 @@ PrintBinary (
 }
 
 /*--------------------------------------------------------------------------------*/
-/*  AddCodeWordBits     Adds bits to the CodeWord array                           */
-/*       Bits           - The bits to be added                                    */
-/*       Count          - Number of bits.  Intended to work with number of bits in*/
-/*                        Bits - 1                                                */
+/*  AddCodeWordPadBytes  Fills the rest of the CodeWord array with pad code words */
 /*--------------------------------------------------------------------------------*/
 static
 VOID
 AddCodeWordPadBytes (
-  VOID
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
   BOOLEAN  PadSelect;
@@ -293,13 +313,13 @@ AddCodeWordPadBytes (
   #define PAD1  0xEC// Pad code word values from ISO 18004-2015 7.4.10
   #define PAD2  0x11
 
-  if (pvCwUsed > 0) {
-    pvCwIndex++;
+  if (Ctx->CwUsed > 0) {
+    Ctx->CwIndex++;
   }
 
   PadSelect = FALSE;
 
-  while (pvCwIndex < pvCwTarget) {
+  while (Ctx->CwIndex < Ctx->CwTarget) {
     if (PadSelect) {
       PadSelect    = FALSE;
       PadCharacter = PAD2;
@@ -308,123 +328,111 @@ AddCodeWordPadBytes (
       PadSelect    = TRUE;
     }
 
-    gCodeWords[pvCwIndex++] = PadCharacter;
+    Ctx->CodeWords[Ctx->CwIndex++] = PadCharacter;
   }
 
-  if (gFlags & QR_FLAGS_DEBUG_CODE_WORDS) {
-    for (i = 0; i < pvCwTarget; i++) {
-      DEBUG ((DEBUG_INFO, " CodeWord %4d is %4d - ", i, gCodeWords[i]));
-      PrintBinary (gCodeWords[i], 8, '0');
+  if (Ctx->Flags & QR_FLAGS_DEBUG_CODE_WORDS) {
+    for (i = 0; i < Ctx->CwTarget; i++) {
+      DEBUG ((DEBUG_INFO, " CodeWord %4d is %4d - ", i, Ctx->CodeWords[i]));
+      PrintBinary (Ctx->CodeWords[i], 8, '0');
       DEBUG ((DEBUG_INFO, "\n"));
     }
   }
 }
 
 /*--------------------------------------------------------------------------------*/
-/*  Polynomial divide                                                             */
-/*       DividendCount  - number of data code words                               */
-/*       Dividend       - CodeWords                                               */
-/*       RemainderCount - number of EC code words to generate                     */
-/*       Remainder      - Where to store the EC code words                        */
+/*  Build Generator Products                                                      */
+/*       Multiply the generator polynomial for the EC words per block by every    */
+/*       GF(256) value, so the polynomial division only needs table lookups.      */
 /*                                                                                */
 /*  Divisor is a polynomial from table A.1 based on the number of ECWords         */
 /*--------------------------------------------------------------------------------*/
 static
-VOID
-PolynomialDivision (
-  UINT16  DividendCount,
-  UINT8   *Dividend,
-  UINT16  RemainderCount,
-  UINT8   *Remainder
+EFI_STATUS
+BuildGeneratorProducts (
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
-  UINT8        *TempRemainder;
   CONST UINT8  *Divisor;
-  UINT8        temp;
-  UINTN        sizeofnumbers;
-  UINTN        i;
+  UINTN        RemainderCount;
+  UINTN        Value;
   UINTN        j;
-  UINT8        stepMultiplier;
 
-  Divisor = gGeneratorPolynomials[RemainderCount];
-  if (Divisor == NULL) {
+  RemainderCount = Ctx->QrT->ECWordsPerBlock;
+  Divisor        = gGeneratorPolynomials[RemainderCount];
+  if ((Divisor == NULL) || (RemainderCount > QR_MAX_EC_WORDS)) {
     DEBUG ((DEBUG_ERROR, "Unable to locate generator polynomial for word count %d\n", RemainderCount));
     ASSERT (FALSE);
-    return;
+    return EFI_INVALID_PARAMETER;
   }
 
-  if (gFlags & QR_FLAGS_DEBUG_POLYDIVIDE) {
+  if (Ctx->Flags & QR_FLAGS_DEBUG_POLYDIVIDE) {
     DEBUG ((DEBUG_INFO, "Divisor %3d  ", RemainderCount));
-    for (j = 0; j < (UINTN)(RemainderCount+1); j++) {
+    for (j = 0; j < RemainderCount + 1; j++) {
       DEBUG ((DEBUG_INFO, " %3d,", Divisor[j]));
     }
 
     DEBUG ((DEBUG_INFO, "\n"));
   }
 
-  sizeofnumbers = DividendCount + RemainderCount;
-  TempRemainder = AllocateZeroPool (sizeofnumbers);
-  // MU_CHANGE [BEGIN] - CodeQL change
-  if (TempRemainder == NULL) {
-    ASSERT (TempRemainder != NULL);
-    return;
+  //
+  // The divisor is a list of exponents of alpha.  Its lead term is always 1 (alpha^0), so
+  // only the remaining terms are multiplied.
+  //
+  ZeroMem (Ctx->GeneratorProducts[0], sizeof (Ctx->GeneratorProducts[0]));
+  for (Value = 1; Value < GF256_SIZE; Value++) {
+    for (j = 0; j < RemainderCount; j++) {
+      Ctx->GeneratorProducts[Value][j] = alogTable[(logTable[Value] + Divisor[j + 1]) % (GF256_SIZE - 1)];
+    }
   }
 
-  // MU_CHANGE [END] - CodeQL change
-
-  for (i = 0; i < DividendCount; i++) {
-    TempRemainder[i] = Dividend[i];
-  }
+  return EFI_SUCCESS;
+}
 
-  if (gFlags & QR_FLAGS_DEBUG_POLYDIVIDE) {
-    DEBUG ((DEBUG_INFO, "MsgPly %3d   ", i));
-    for (j = 0; j < sizeofnumbers; j++) {
-      DEBUG ((DEBUG_INFO, " %3d,", TempRemainder[j]));
-    }
+/*--------------------------------------------------------------------------------*/
+/*  Polynomial divide                                                             */
+/*       DividendCount  - number of data code words                               */
+/*       Dividend       - CodeWords                                               */
+/*       Remainder      - Where to store the EC code words                        */
+/*                                                                                */
+/*  The remainder is computed a code word at a time, like a shift register, using */
+/*  the generator products from BuildGeneratorProducts.                           */
+/*--------------------------------------------------------------------------------*/
+static
+VOID
+PolynomialDivision (
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT16              DividendCount,
+  UINT8               *Dividend,
+  UINT8               *Remainder
+  )
+{
+  UINTN  RemainderCount;
+  UINT8  *Product;
+  UINTN  i;
+  UINTN  j;
 
-    DEBUG ((DEBUG_INFO, "\n"));
-  }
+  RemainderCount = Ctx->QrT->ECWordsPerBlock;
+  ZeroMem (Remainder, RemainderCount);
 
   for (i = 0; i < DividendCount; i++) {
-    stepMultiplier = logTable[TempRemainder[i]];     // Lead term of message / previous result
-    if (TempRemainder[i] == 0) {
-      continue;
+    // Lead term of message + previous result selects the multiple of the divisor to subtract (XOR)
+    Product = Ctx->GeneratorProducts[Dividend[i] ^ Remainder[0]];
+    for (j = 0; j < RemainderCount - 1; j++) {
+      Remainder[j] = Remainder[j + 1] ^ Product[j];
     }
 
-    for (j = i; j < i + RemainderCount + 1; j++) {
-      temp              = alogTable[(stepMultiplier + Divisor[j - i]) % (GF256_SIZE - 1)];
-      TempRemainder[j] ^= temp;        // XOR is Galois field Add
-      if (gFlags & QR_FLAGS_DEBUG_POLYDIVIDE) {
-        DEBUG ((DEBUG_INFO, "--- s=%3d d=%3d t=%3d r=%3d\n", stepMultiplier, Divisor[j-i], temp, TempRemainder[j]));
-      }
-    }
-
-    if (gFlags & QR_FLAGS_DEBUG_POLYDIVIDE) {
-      DEBUG ((DEBUG_INFO, "Result %3d   ", i));
-      for (j = 0; j < sizeofnumbers; j++) {
-        DEBUG ((DEBUG_INFO, " %3d,", TempRemainder[j]));
-      }
-
-      DEBUG ((DEBUG_INFO, "\n"));
-    }
+    Remainder[RemainderCount - 1] = Product[RemainderCount - 1];
   }
 
-  if (gFlags & QR_FLAGS_DEBUG_POLYDIVIDE) {
+  if (Ctx->Flags & QR_FLAGS_DEBUG_POLYDIVIDE) {
     DEBUG ((DEBUG_INFO, "Result - "));
-  }
-
-  for (j = 0; j < RemainderCount; j++) {
-    Remainder[j] = TempRemainder[j+DividendCount];     // Copy remainder
-    if (gFlags & QR_FLAGS_DEBUG_POLYDIVIDE) {
+    for (j = 0; j < RemainderCount; j++) {
       DEBUG ((DEBUG_INFO, " %3d,", Remainder[j]));
     }
-  }
 
-  if (gFlags & QR_FLAGS_DEBUG_POLYDIVIDE) {
     DEBUG ((DEBUG_INFO, "\n"));
   }
-
-  FreePool (TempRemainder);
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -433,8 +441,9 @@ PolynomialDivision (
 static
 VOID
 EncodeBytes (
-  UINT8  *Data,
-  UINTN  DataLen
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT8               *Data,
+  UINTN               DataLen
   )
 {
   UINTN  i;
@@ -444,8 +453,8 @@ EncodeBytes (
   // all binary data is allowed.
 
   for (i = 0; i < DataLen; i++) {
-    AddCodeWordBits (Data[i], 8);
-    if (gFlags & QR_FLAGS_DEBUG_ENCODING) {
+    AddCodeWordBits (Ctx, Data[i], 8);
+    if (Ctx->Flags & QR_FLAGS_DEBUG_ENCODING) {
       DEBUG ((DEBUG_INFO, " Binary %2d:%2d is %4d - ", i - 1, i, Data[i]));
       PrintBinary (Data[i], 8, '0');
       DEBUG ((DEBUG_INFO, "\n"));
@@ -459,8 +468,9 @@ EncodeBytes (
 static
 VOID
 EncodeNumeric (
-  UINT8  *Data,
-  UINTN  DataLen
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT8               *Data,
+  UINTN               DataLen
   )
 {
   UINT16  Triplet  = 0;
@@ -473,8 +483,8 @@ EncodeNumeric (
     Triplet += Data[i] - '0';
     TripIndx++;
     if (TripIndx == 3) {
-      AddCodeWordBits (Triplet, 10);         // Three digits pack into 10 bits
-      if (gFlags & QR_FLAGS_DEBUG_ENCODING) {
+      AddCodeWordBits (Ctx, Triplet, 10);    // Three digits pack into 10 bits
+      if (Ctx->Flags & QR_FLAGS_DEBUG_ENCODING) {
         DEBUG ((DEBUG_INFO, " Triplet %2d:%2d is %4d - ", i - 1, i, Triplet));
         PrintBinary (Triplet, 10, '0');
         DEBUG ((DEBUG_INFO, "\n"));
@@ -487,15 +497,15 @@ EncodeNumeric (
 
   // Handle left over digits....
   if (TripIndx == 1) {
-    AddCodeWordBits (Triplet, 4);            // One left over digits pack into 4 bits
-    if (gFlags & QR_FLAGS_DEBUG_ENCODING) {
+    AddCodeWordBits (Ctx, Triplet, 4);       // One left over digits pack into 4 bits
+    if (Ctx->Flags & QR_FLAGS_DEBUG_ENCODING) {
       DEBUG ((DEBUG_INFO, " Triplet %2d:%2d is %4d -       ", i - 1, i, Triplet));
       PrintBinary (Triplet, 4, '0');
       DEBUG ((DEBUG_INFO, "\n"));
     }
   } else if (TripIndx == 2) {
-    AddCodeWordBits (Triplet, 7);            // Two left over digits pack into 7 bits;
-    if (gFlags & QR_FLAGS_DEBUG_ENCODING) {
+    AddCodeWordBits (Ctx, Triplet, 7);       // Two left over digits pack into 7 bits;
+    if (Ctx->Flags & QR_FLAGS_DEBUG_ENCODING) {
       DEBUG ((DEBUG_INFO, " Triplet %2d:%2d is %4d -    ", i - 1, i, Triplet));
       PrintBinary (Triplet, 7, '0');
       DEBUG ((DEBUG_INFO, "\n"));
@@ -509,8 +519,9 @@ EncodeNumeric (
 static
 VOID
 EncodeAlphanumeric (
-  UINT8  *Data,
-  UINTN  DataLen
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT8               *Data,
+  UINTN               DataLen
   )
 {
   UINTN   i;
@@ -536,8 +547,8 @@ EncodeAlphanumeric (
       Pair = index;
     } else {
       Pair = index + (UINT16)(Pair * 45);
-      AddCodeWordBits (Pair, 11);
-      if (gFlags & QR_FLAGS_DEBUG_ENCODING) {
+      AddCodeWordBits (Ctx, Pair, 11);
+      if (Ctx->Flags & QR_FLAGS_DEBUG_ENCODING) {
         DEBUG ((DEBUG_INFO, " Pair %2d:%2d is %4d - ", i - 1, i, Pair));
         PrintBinary (Pair, 11, '0');
         DEBUG ((DEBUG_INFO, "\n"));
@@ -546,8 +557,8 @@ EncodeAlphanumeric (
   }
 
   if (1 == (i % 2)) {
-    AddCodeWordBits (Pair, 6);
-    if (gFlags & QR_FLAGS_DEBUG_ENCODING) {
+    AddCodeWordBits (Ctx, Pair, 6);
+    if (Ctx->Flags & QR_FLAGS_DEBUG_ENCODING) {
       DEBUG ((DEBUG_INFO, " Pair  :%2d is%4d -      ", i, Pair));
       PrintBinary (Pair, 6, '0');
       DEBUG ((DEBUG_INFO, "\n"));
@@ -555,62 +566,138 @@ EncodeAlphanumeric (
   }
 }
 
+/*--------------------------------------------------------------------------------*/
+/* SetRowBit - set or clear the bit for a module in a row                         */
+/*--------------------------------------------------------------------------------*/
+static
+VOID
+SetRowBit (
+  UINTN    *Row,
+  INTN     Column,
+  BOOLEAN  Value
+  )
+{
+  if (Value) {
+    Row[QR_WORD (Column)] |= QR_BIT (Column);
+  } else {
+    Row[QR_WORD (Column)] &= ~QR_BIT (Column);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/* GetModule - return the color of the module at Row:Column                       */
+/*--------------------------------------------------------------------------------*/
+static
+UINT8
+GetModule (
+  QR_ENCODER_CONTEXT  *Ctx,
+  INTN                Row,
+  INTN                Column
+  )
+{
+  UINTN  Word;
+  UINTN  Bit;
+  UINT8  Color;
+
+  Word = QR_WORD (Column);
+  Bit  = QR_BIT (Column);
+
+  if ((Ctx->Reserved[Row][Word] & Bit) != 0) {
+    Color = QrRsvd;
+  } else if ((Ctx->Used[Row][Word] & Bit) == 0) {
+    Color = QrGray;
+  } else if ((Ctx->Dark[Row][Word] & Bit) != 0) {
+    Color = QrBlack;
+  } else {
+    Color = QrWhite;
+  }
+
+  if ((Ctx->Function[Row][Word] & Bit) != 0) {
+    Color |= QrExclude;
+  }
+
+  return Color;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* SetModule - set the color of the module at Row:Column                          */
+/*--------------------------------------------------------------------------------*/
+static
+VOID
+SetModule (
+  QR_ENCODER_CONTEXT  *Ctx,
+  INTN                Row,
+  INTN                Column,
+  UINT8               Color
+  )
+{
+  if ((Row < 0) || (Row >= Ctx->Size) || (Column < 0) || (Column >= Ctx->Size)) {
+    DEBUG ((DEBUG_ERROR, "%a Attempt to write module out of bitmap bounds\n", __FUNCTION__));
+    ASSERT (FALSE);
+    return;
+  }
+
+  SetRowBit (Ctx->Dark[Row], Column, (Color & ~QrExclude) == QrBlack);
+  SetRowBit (Ctx->Function[Row], Column, (Color & QrExclude) != 0);
+  SetRowBit (Ctx->Used[Row], Column, (Color & ~QrExclude) != QrGray);
+  SetRowBit (Ctx->Reserved[Row], Column, (Color & ~QrExclude) == QrRsvd);
+}
+
 /*--------------------------------------------------------------------------------*/
 /* setBitmap - this draws a module at the next module location ISO 18004 7.7.3    */
 /*--------------------------------------------------------------------------------*/
 static
 VOID
 setBitmap (
-  UINT8  *bitmap,
-  INTN   rowSize,
-  UINT8  Color
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT8               Color
   )
 {
   BOOLEAN  done = FALSE;
 
   while (!done) {
-    if (bitmap[row * rowSize + col] == QrGray) {
-      bitmap[row * rowSize + col] = Color;
-      done                        = TRUE;
+    if (GetModule (Ctx, Ctx->Row, Ctx->Col) == QrGray) {
+      SetModule (Ctx, Ctx->Row, Ctx->Col, Color);
+      done = TRUE;
     }
 
-    if (up) {
-      if (right) {
-        col--;
-        right = FALSE;
+    if (Ctx->Up) {
+      if (Ctx->Right) {
+        Ctx->Col--;
+        Ctx->Right = FALSE;
       } else {
-        if (row > 0) {
-          col++;
-          row--;
+        if (Ctx->Row > 0) {
+          Ctx->Col++;
+          Ctx->Row--;
         } else {
-          up = FALSE;
-          col--;
-          if (col == 6) {
+          Ctx->Up = FALSE;
+          Ctx->Col--;
+          if (Ctx->Col == 6) {
             // Column 7 is reserved
-            col = 5;
+            Ctx->Col = 5;
           }
         }
 
-        right = TRUE;
+        Ctx->Right = TRUE;
       }
     } else {
-      if (right) {
-        col--;
-        right = FALSE;
+      if (Ctx->Right) {
+        Ctx->Col--;
+        Ctx->Right = FALSE;
       } else {
-        if (row < (rowSize - 1)) {
-          col++;
-          row++;
+        if (Ctx->Row < (Ctx->Size - 1)) {
+          Ctx->Col++;
+          Ctx->Row++;
         } else {
-          up = TRUE;
-          col--;
-          if (col == 6) {
+          Ctx->Up = TRUE;
+          Ctx->Col--;
+          if (Ctx->Col == 6) {
             // Column 7 is reserved
-            col = 5;
+            Ctx->Col = 5;
           }
         }
 
-        right = TRUE;
+        Ctx->Right = TRUE;
       }
     }
   }
@@ -622,8 +709,7 @@ setBitmap (
 static
 VOID
 drawBits (
-  UINT8  *bitmap,
-  INTN   rowSize
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
   UINTN  i;
@@ -631,79 +717,62 @@ drawBits (
   UINT8  bit;
   UINTN  mask;
 
-  up    = TRUE;
-  right = TRUE;
-  row   = rowSize - 1;
-  col   = rowSize - 1;
+  Ctx->Up    = TRUE;
+  Ctx->Right = TRUE;
+  Ctx->Row   = Ctx->Size - 1;
+  Ctx->Col   = Ctx->Size - 1;
 
-  for (i = 0; i < gBitStreamCount; i++ ) {
-    data = gBitStream[i];
-    mask = 0x80;
+  for (i = 0; i < Ctx->BitStreamCount; i++ ) {
+    data = Ctx->BitStream[i];
 
     for (mask = 0x80; mask != 0; mask >>= 1) {
       bit = (UINT8)(data & mask);
-      setBitmap (bitmap, rowSize, (bit == 0) ? QrWhite : QrBlack);
+      setBitmap (Ctx, (bit == 0) ? QrWhite : QrBlack);
     }
   }
 
-  for (i = 0; i < gQrT->requiredRemainder; i++) {
-    setBitmap (bitmap, rowSize, QrWhite);
+  for (i = 0; i < Ctx->QrT->requiredRemainder; i++) {
+    setBitmap (Ctx, QrWhite);
   }
 }
 
 /*--------------------------------------------------------------------------------*/
-/* drawHLine - draw a horizontal line left to right from x:y to x+tx-1:y          */
+/* drawHLine - draw a horizontal line left to right from x:y to tx:y              */
 /*--------------------------------------------------------------------------------*/
 static
 VOID
 drawHLine (
-  UINT8  *bitmap,
-  INTN   s,
-  INTN   x,
-  INTN   y,
-  INTN   tx,
-  UINT8  Color
+  QR_ENCODER_CONTEXT  *Ctx,
+  INTN                x,
+  INTN                y,
+  INTN                tx,
+  UINT8               Color
   )
 {
   INTN  i;
-  INTN  g;
-  INTN  b;
 
-  g = y * s;         // Index of ROW to set bits into
-  b = g + x;         // Index of starting point for the line
   for (i = x; i <= tx; i++) {
-    if (b > (gQrBitmapLen)) {
-      DEBUG ((DEBUG_ERROR, "%a Attempt to write module out of bitmap bounds\n", __FUNCTION__));
-      ASSERT (FALSE);
-    } else {
-      bitmap[g + i] = Color;
-    }
+    SetModule (Ctx, y, i, Color);
   }
 }
 
 /*--------------------------------------------------------------------------------*/
-/* drawVLine - draw a vertical line top to bottom from x:y to x:y+ty-1            */
+/* drawVLine - draw a vertical line top to bottom from x:y to x:ty                */
 /*--------------------------------------------------------------------------------*/
 static
 VOID
 drawVLine (
-  UINT8  *bitmap,
-  INTN   s,
-  INTN   x,
-  INTN   y,
-  INTN   ty,
-  UINT8  Color
+  QR_ENCODER_CONTEXT  *Ctx,
+  INTN                x,
+  INTN                y,
+  INTN                ty,
+  UINT8               Color
   )
 {
   INTN  i;
 
   for (i = y; i <= ty; i++) {
-    if ((x + (i * s)) > (gQrBitmapLen)) {
-      DEBUG ((DEBUG_ERROR, "%a Attempt to write module out of bitmap bounds\n", __FUNCTION__));
-      ASSERT (FALSE);
-    } else {
-      bitmap[x +(i * s)] = Color;
-    }
+    SetModule (Ctx, i, x, Color);
   }
 }
 
@@ -713,23 +782,24 @@ drawVLine (
 static
 VOID
 drawReserved (
-  UINT8  *bitmap,
-  INTN   rowSize
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
-  drawVLine (bitmap, rowSize, 8, 0, 8, QrRsvd_E);
-  drawHLine (bitmap, rowSize, 0, 8, 7, QrRsvd_E);
-  drawVLine (bitmap, rowSize, 8, rowSize - 7, rowSize - 1, QrRsvd_E);
-  drawHLine (bitmap, rowSize, rowSize-8, 8, rowSize - 1, QrRsvd_E);
+  INTN  rowSize = Ctx->Size;
+
+  drawVLine (Ctx, 8, 0, 8, QrRsvd_E);
+  drawHLine (Ctx, 0, 8, 7, QrRsvd_E);
+  drawVLine (Ctx, 8, rowSize - 7, rowSize - 1, QrRsvd_E);
+  drawHLine (Ctx, rowSize-8, 8, rowSize - 1, QrRsvd_E);
 
-  if (gQrVersion >= 7) {
+  if (Ctx->Version >= 7) {
     // Reserve the Version locations
-    drawHLine (bitmap, rowSize, 0, rowSize - 11, 6, QrRsvd_E);
-    drawHLine (bitmap, rowSize, 0, rowSize - 10, 6, QrRsvd_E);
-    drawHLine (bitmap, rowSize, 0, rowSize -  9, 6, QrRsvd_E);
-    drawVLine (bitmap, rowSize, rowSize - 11, 0, 6, QrRsvd_E);
-    drawVLine (bitmap, rowSize, rowSize - 10, 0, 6, QrRsvd_E);
-    drawVLine (bitmap, rowSize, rowSize -  9, 0, 6, QrRsvd_E);
+    drawHLine (Ctx, 0, rowSize - 11, 6, QrRsvd_E);
+    drawHLine (Ctx, 0, rowSize - 10, 6, QrRsvd_E);
+    drawHLine (Ctx, 0, rowSize -  9, 6, QrRsvd_E);
+    drawVLine (Ctx, rowSize - 11, 0, 6, QrRsvd_E);
+    drawVLine (Ctx, rowSize - 10, 0, 6, QrRsvd_E);
+    drawVLine (Ctx, rowSize -  9, 0, 6, QrRsvd_E);
   }
 }
 
@@ -744,36 +814,35 @@ drawReserved (
 static
 VOID
 drawFinder (
-  UINT8  *bitmap,
-  INTN   rowSize,
-  INTN   x,
-  INTN   y
+  QR_ENCODER_CONTEXT  *Ctx,
+  INTN                x,
+  INTN                y
   )
 {
-  drawHLine (bitmap, rowSize, x, y, x + 6, QrBlack_E);
-  drawHLine (bitmap, rowSize, x, y + 6, x + 6, QrBlack_E);
-  drawVLine (bitmap, rowSize, x, y + 1, y + 6, QrBlack_E);
-  drawVLine (bitmap, rowSize, x + 6, y + 1, y + 6, QrBlack_E);
+  drawHLine (Ctx, x, y, x + 6, QrBlack_E);
+  drawHLine (Ctx, x, y + 6, x + 6, QrBlack_E);
+  drawVLine (Ctx, x, y + 1, y + 6, QrBlack_E);
+  drawVLine (Ctx, x + 6, y + 1, y + 6, QrBlack_E);
 
-  drawHLine (bitmap, rowSize, x + 1, y + 1, x + 5, QrWhite_E);
-  drawHLine (bitmap, rowSize, x + 1, y + 5, x + 5, QrWhite_E);
-  drawVLine (bitmap, rowSize, x + 1, y + 2, y + 5, QrWhite_E);
-  drawVLine (bitmap, rowSize, x + 5, y + 2, y + 5, QrWhite_E);
+  drawHLine (Ctx, x + 1, y + 1, x + 5, QrWhite_E);
+  drawHLine (Ctx, x + 1, y + 5, x + 5, QrWhite_E);
+  drawVLine (Ctx, x + 1, y + 2, y + 5, QrWhite_E);
+  drawVLine (Ctx, x + 5, y + 2, y + 5, QrWhite_E);
 
-  drawHLine (bitmap, rowSize, x + 2, y + 2, x + 4, QrBlack_E);
-  drawHLine (bitmap, rowSize, x + 2, y + 3, x + 4, QrBlack_E);
-  drawHLine (bitmap, rowSize, x + 2, y + 4, x + 4, QrBlack_E);
+  drawHLine (Ctx, x + 2, y + 2, x + 4, QrBlack_E);
+  drawHLine (Ctx, x + 2, y + 3, x + 4, QrBlack_E);
+  drawHLine (Ctx, x + 2, y + 4, x + 4, QrBlack_E);
 
   if (y != 0) {
-    drawHLine (bitmap, rowSize, x, y - 1, x + 7, QrWhite_E);
-    drawVLine (bitmap, rowSize, x + 7, y, y + 6, QrWhite_E);
+    drawHLine (Ctx, x, y - 1, x + 7, QrWhite_E);
+    drawVLine (Ctx, x + 7, y, y + 6, QrWhite_E);
   } else {
     if (x == 0) {
-      drawVLine (bitmap, rowSize, x + 7, y, y + 7, QrWhite_E);
-      drawHLine (bitmap, rowSize, x, y + 7, x + 6, QrWhite_E);
+      drawVLine (Ctx, x + 7, y, y + 7, QrWhite_E);
+      drawHLine (Ctx, x, y + 7, x + 6, QrWhite_E);
     } else {
-      drawVLine (bitmap, rowSize, x - 1, y, y + 7, QrWhite_E);
-      drawHLine (bitmap, rowSize, x, y + 7, x + 6, QrWhite_E);
+      drawVLine (Ctx, x - 1, y, y + 7, QrWhite_E);
+      drawHLine (Ctx, x, y + 7, x + 6, QrWhite_E);
     }
   }
 }
@@ -788,10 +857,9 @@ drawFinder (
 static
 VOID
 drawAlignment (
-  UINT8  *bitmap,
-  INTN   rowSize,
-  UINT8  x,
-  UINT8  y
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT8               x,
+  UINT8               y
   )
 {
   INTN  i;
@@ -802,20 +870,20 @@ drawAlignment (
   // Check to see if the area for the alignment patter is free
   for (i = y; i < y + 5; i++) {
     for (j = x; j < x + 5; j++) {
-      if (bitmap[(i * rowSize) + j] != QrGray) {
+      if (GetModule (Ctx, i, j) != QrGray) {
         return;          // No Alignment pattern here
       }
     }
   }
 
-  drawHLine (bitmap, rowSize, x, y, x + 4, QrBlack_E);
-  drawHLine (bitmap, rowSize, x, y + 4, x + 4, QrBlack_E);
-  drawVLine (bitmap, rowSize, x, y + 1, y + 4, QrBlack_E);
-  drawVLine (bitmap, rowSize, x + 4, y + 1, y + 4, QrBlack_E);
-  drawHLine (bitmap, rowSize, x + 1, y + 1, x + 3, QrWhite_E);
-  drawHLine (bitmap, rowSize, x + 1, y + 2, x + 3, QrWhite_E);
-  drawHLine (bitmap, rowSize, x + 1, y + 3, x + 3, QrWhite_E);
-  bitmap[x + 2 + ((y + 2)* rowSize)] = QrBlack_E;
+  drawHLine (Ctx, x, y, x + 4, QrBlack_E);
+  drawHLine (Ctx, x, y + 4, x + 4, QrBlack_E);
+  drawVLine (Ctx, x, y + 1, y + 4, QrBlack_E);
+  drawVLine (Ctx, x + 4, y + 1, y + 4, QrBlack_E);
+  drawHLine (Ctx, x + 1, y + 1, x + 3, QrWhite_E);
+  drawHLine (Ctx, x + 1, y + 2, x + 3, QrWhite_E);
+  drawHLine (Ctx, x + 1, y + 3, x + 3, QrWhite_E);
+  SetModule (Ctx, y + 2, x + 2, QrBlack_E);
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -824,23 +892,20 @@ drawAlignment (
 static
 VOID
 drawHTiming (
-  UINT8  *bitmap,
-  INTN   rowSize,
-  INTN   x,
-  INTN   y,
-  INTN   tx
+  QR_ENCODER_CONTEXT  *Ctx,
+  INTN                x,
+  INTN                y,
+  INTN                tx
   )
 {
   INTN     i;
-  INTN     b;
   BOOLEAN  IsWhite;
 
-  b       = (y - 1) * rowSize;
   IsWhite = FALSE;
 
   for (i = x; i < tx; i++) {
-    bitmap[b + i] = (IsWhite) ? QrWhite_E : QrBlack_E;
-    IsWhite       = !IsWhite;
+    SetModule (Ctx, y - 1, i, (IsWhite) ? QrWhite_E : QrBlack_E);
+    IsWhite = !IsWhite;
   }
 }
 
@@ -850,11 +915,10 @@ drawHTiming (
 static
 VOID
 drawVTiming (
-  UINT8  *bitmap,
-  INTN   rowSize,
-  INTN   x,
-  INTN   y,
-  INTN   ty
+  QR_ENCODER_CONTEXT  *Ctx,
+  INTN                x,
+  INTN                y,
+  INTN                ty
   )
 {
   INTN     i;
@@ -863,105 +927,152 @@ drawVTiming (
   IsWhite = FALSE;
 
   for (i = y; i < ty; i++) {
-    bitmap[(i - 1) * rowSize + x] = (IsWhite) ? QrWhite_E : QrBlack_E;
-    IsWhite                       = !IsWhite;
+    SetModule (Ctx, i - 1, x, (IsWhite) ? QrWhite_E : QrBlack_E);
+    IsWhite = !IsWhite;
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/* MaskBit - returns TRUE if the data mask pattern flips the module at Row:Column */
+/*--------------------------------------------------------------------------------*/
+static
+BOOLEAN
+MaskBit (
+  INTN  Mask,
+  INTN  Row,
+  INTN  Column
+  )
+{
+  switch (Mask) {
+    case 0:                                                        /* Data Mask Reference 000 */
+      return 0 == ((Row + Column) % 2);                            // (i + j) mod 2 = 0
+    case 1:                                                        /* Data Mask Reference 001 */
+      return 0 == (Row % 2);                                       // i mod 2 = 0
+    case 2:                                                        /* Data Mask Reference 010 */
+      return 0 == (Column % 3);                                    // j mod 3 = 0
+    case 3:                                                        /* Data Mask Reference 011 */
+      return 0 == ((Row + Column) % 3);                            // (i + j) mod 3 = 0
+    case 4:                                                        /* Data Mask Reference 100 */
+      return 0 == ((Row / 2) + (Column / 3)) % 2;                  // ((i div 2) + ( j div 3)) mod 2 = 0
+    case 5:                                                        /* Data Mask Reference 101 */
+      return 0 == ((Row * Column) % 2) + ((Row * Column) % 3);     // (i j) mod 2 + (i j) mod 3 = 0
+    case 6:                                                        /* Data Mask Reference 110 */
+      return 0 == (((Row * Column) % 2) + ((Row * Column) % 3)) % 2; // ((i j) mod 2 + (i j) mod 3) mod 2 = 0
+    default:                                                       /* Data Mask Reference 111 */
+      return 0 == (((Row + Column) % 2) + ((Row * Column) % 3)) % 2; // ((i+j) mod 2 + (i j) mod 3) mod 2 = 0
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/* ShiftRow - Dst = Src moved Count modules to the right (Count < QR_WORD_BITS)   */
+/*            Bit Column of Dst is bit Column - Count of Src.                     */
+/*--------------------------------------------------------------------------------*/
+static
+VOID
+ShiftRow (
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINTN               *Dst,
+  CONST UINTN         *Src,
+  UINTN               Count
+  )
+{
+  UINTN  w;
+
+  if (Count == 0) {
+    CopyMem (Dst, Src, Ctx->RowWords * sizeof (UINTN));
+    return;
+  }
+
+  for (w = Ctx->RowWords - 1; w > 0; w--) {
+    Dst[w] = (Src[w] << Count) | (Src[w - 1] >> (QR_WORD_BITS - Count));
+  }
+
+  Dst[0] = Src[0] << Count;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* CountRowBits - count the bits set in a row                                     */
+/*--------------------------------------------------------------------------------*/
+static
+INTN
+CountRowBits (
+  QR_ENCODER_CONTEXT  *Ctx,
+  CONST UINTN         *Row
+  )
+{
+  INTN   Count;
+  UINTN  Word;
+  UINTN  w;
+
+  Count = 0;
+  for (w = 0; w < Ctx->RowWords; w++) {
+    for (Word = Row[w]; Word != 0; Word &= Word - 1) {
+      Count++;
+    }
   }
+
+  return Count;
 }
 
 /*--------------------------------------------------------------------------------*/
 /* Evaluate 1                                                                     */
-/*         Compute a penalty based on runs of horizontal or vertical cells        */
-/*         of the same color.                                                     */
+/*         Compute a penalty based on runs of cells of the same color in each     */
+/*         row of Rows.  Called with the rows and the columns of the matrix.      */
 /*                                                                                */
-/*         5 points for 5 in a row.                                               */
+/*         3 points for 5 in a row.                                               */
 /*         1 additional point for each additional module of the same color        */
 /*--------------------------------------------------------------------------------*/
 static
 INTN
 Evaluate1 (
-  UINT8  *Bitmap,
-  INTN   RowSize
+  QR_ENCODER_CONTEXT  *Ctx,
+  QR_ROW              *Rows
   )
 {
-  INTN   Penalty;
-  INTN   x, y;
-  INTN   AdjacentCount;
-  INTN   RowOffset;
-  UINT8  Cell1;
-  UINT8  Cell2;
+  INTN    Penalty;
+  INTN    y;
+  UINTN   w;
+  QR_ROW  Same;
+  QR_ROW  Shifted;
+  QR_ROW  Five;
 
   Penalty = 0;
 
-  //
-  // Check each row for adjacent cells the same color.
-  //
-  for (y = 0; y < RowSize; y++) {
-    // Check every Row
-    AdjacentCount = 0;
-    RowOffset     = y * RowSize;
-    Cell1         = Bitmap[RowOffset] & ~QrExclude;
-    if (Cell1 == QrRsvd) {
-      Cell1 = QrWhite;
+  for (y = 0; y < Ctx->Size; y++) {
+    //
+    // Same bit x is set if module x is the same color as module x-1.
+    //
+    ShiftRow (Ctx, Shifted, Rows[y], 1);
+    for (w = 0; w < Ctx->RowWords; w++) {
+      Same[w] = ~(Rows[y][w] ^ Shifted[w]) & Ctx->ValidRow[w];
     }
 
-    for (x = 1; x < RowSize; x++) {
-      // Check every cell in the row
-      Cell2 = Bitmap[RowOffset + x] & ~QrExclude;
-      if (Cell2 == QrRsvd) {
-        Cell2 = QrWhite;
-      }
+    Same[0] &= ~(UINTN)1;
 
-      if (Cell1 == Cell2) {
-        AdjacentCount++;
-        if (AdjacentCount == 4) {
-          // 4th adjacent module is 5 in a row
-          Penalty += 3;
-        } else if (AdjacentCount > 4) {
-          Penalty++;
-        }
-      } else {
-        AdjacentCount = 0;
-      }
-
-      Cell1 = Cell2;
+    //
+    // Five bit x is set if modules x-4 through x are the same color.  A run of N >= 5
+    // sets N - 4 bits, so the run costs its Five bits plus 2.
+    //
+    ShiftRow (Ctx, Shifted, Same, 1);
+    for (w = 0; w < Ctx->RowWords; w++) {
+      Same[w] &= Shifted[w];
     }
-  }
 
-  //
-  // Check each column for adjacent cells the same color.
-  //
-  for (x = 0; x < RowSize; x++) {
-    // Check every column
-    AdjacentCount = 0;
-    Cell1         = Bitmap[x] & ~QrExclude;
-    if (Cell1 == QrRsvd) {
-      Cell1 = QrWhite;
+    ShiftRow (Ctx, Shifted, Same, 2);
+    for (w = 0; w < Ctx->RowWords; w++) {
+      Five[w] = Same[w] & Shifted[w];
     }
 
-    for (y = 1; y < RowSize; y++) {
-      // Check every cell in the column
-      Cell2 = Bitmap[(y * RowSize) + x] & ~QrExclude;
-      if (Cell2 == QrRsvd) {
-        Cell2 = QrWhite;
-      }
-
-      if (Cell1 == Cell2) {
-        AdjacentCount++;
-        if (AdjacentCount == 4) {
-          // 4th adjacent module is 5 in a row
-          Penalty += 3;
-        } else if (AdjacentCount > 4) {
-          Penalty++;
-        }
-      } else {
-        AdjacentCount = 0;
-      }
+    Penalty += CountRowBits (Ctx, Five);
 
-      Cell1 = Cell2;
+    ShiftRow (Ctx, Shifted, Five, 1);
+    for (w = 0; w < Ctx->RowWords; w++) {
+      Five[w] &= ~Shifted[w];
     }
+
+    Penalty += 2 * CountRowBits (Ctx, Five);
   }
 
-  DEBUG ((DEBUG_INFO, "Evaluate 1 penalty is %d\n", Penalty));
   return Penalty;
 }
 
@@ -976,57 +1087,37 @@ Evaluate1 (
 static
 INTN
 Evaluate2 (
-  UINT8  *Bitmap,
-  INTN   RowSize
+  QR_ENCODER_CONTEXT  *Ctx,
+  QR_ROW              *Rows
   )
 {
-  INTN   Penalty;
-  INTN   x, y;
-  UINT8  Cell1;
-  UINT8  Cell2;
-  UINT8  Cell3;
-  UINT8  Cell4;
+  INTN    Penalty;
+  INTN    y;
+  UINTN   w;
+  QR_ROW  Shifted1;
+  QR_ROW  Shifted2;
+  QR_ROW  Block;
 
   Penalty = 0;
 
-  //
-  // Check each row for 2x2 collections of the same color.
-  //
-  for (y = 0; y < (RowSize - 1); y++) {
-    // Check two cells vertically and two cells horizontal
-    for (x = 0; x < (RowSize - 1); x++) {
-      // Checking two cells - so stop one short
-      Cell1 = Bitmap[(y * RowSize) + x] & ~QrExclude;
-      if (Cell1 == QrRsvd) {
-        Cell1 = QrWhite;
-      }
-
-      Cell2 = Bitmap[(y * RowSize) + x + 1] & ~QrExclude;
-      if (Cell2 == QrRsvd) {
-        Cell2 = QrWhite;
-      }
-
-      if (Cell1 == Cell2) {
-        Cell3 = Bitmap[((y + 1) * RowSize) + x] & ~QrExclude;
-        if (Cell3 == QrRsvd) {
-          Cell3 = QrWhite;
-        }
+  for (y = 0; y < (Ctx->Size - 1); y++) {
+    //
+    // Block bit x is set if modules x-1 and x of rows y and y+1 are all the same color.
+    //
+    ShiftRow (Ctx, Shifted1, Rows[y], 1);
+    ShiftRow (Ctx, Shifted2, Rows[y + 1], 1);
+    for (w = 0; w < Ctx->RowWords; w++) {
+      Block[w] = ~(Rows[y][w] ^ Shifted1[w]) &
+                 ~(Rows[y + 1][w] ^ Shifted2[w]) &
+                 ~(Rows[y][w] ^ Rows[y + 1][w]) &
+                 Ctx->ValidRow[w];
+    }
 
-        if (Cell1 == Cell3) {
-          Cell4 = Bitmap[((y + 1) * RowSize) + x + 1] & ~QrExclude;
-          if (Cell4 == QrRsvd) {
-            Cell4 = QrWhite;
-          }
+    Block[0] &= ~(UINTN)1;
 
-          if (Cell1 == Cell4) {
-            Penalty += 3;
-          }
-        }
-      }
-    }
+    Penalty += 3 * CountRowBits (Ctx, Block);
   }
 
-  DEBUG ((DEBUG_INFO, "Evaluate 2 penalty is %d\n", Penalty));
   return Penalty;
 }
 
@@ -1034,108 +1125,52 @@ Evaluate2 (
 /* Evaluate 3                                                                     */
 /*         Look for the specific sequence of                                      */
 /*                                                                                */
-/*         1 0 1 1 1 0 1 0 0 0 0          or   B W B B B Q B W W W W              */
+/*         1 0 1 1 1 0 1 0 0 0 0          or   B W B B B W B W W W W              */
 /*         0 0 0 0 1 0 1 1 1 0 1               W W W W B W B B B W B              */
 /*                                                                                */
-/*         Either horizontally or vertically                                      */
-/*         Add a penalty of 40 points for each occurrence.                        */
+/*         in each row of Rows.  Called with the rows and the columns of the      */
+/*         matrix.  Add a penalty of 40 points for each occurrence.               */
 /*--------------------------------------------------------------------------------*/
 static
 INTN
 Evaluate3 (
-  UINT8  *Bitmap,
-  INTN   RowSize
+  QR_ENCODER_CONTEXT  *Ctx,
+  QR_ROW              *Rows
   )
 {
-  INTN   Penalty;
-  INTN   x, y;
-  UINT8  Cell;
-  INTN   Target1Index;
-  INTN   Target2Index;
-  UINT8  Target1[] = { QrBlack, QrWhite, QrBlack, QrBlack, QrBlack, QrWhite, QrBlack, QrWhite, QrWhite, QrWhite, QrWhite };
-  UINT8  Target2[] = { QrWhite, QrWhite, QrWhite, QrWhite, QrBlack, QrWhite, QrBlack, QrBlack, QrBlack, QrWhite, QrBlack };
+  INTN         Penalty;
+  INTN         y;
+  UINTN        w;
+  UINTN        j;
+  QR_ROW       Shifted;
+  QR_ROW       Match1;
+  QR_ROW       Match2;
+  CONST UINT8  Target1[] = { 1, 0, 1, 1, 1, 0, 1, 0, 0, 0, 0 };
+  CONST UINT8  Target2[] = { 0, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1 };
 
   Penalty = 0;
 
-  //
-  // Check each row for the special patters.
-  //
-  for (y = 0; y < RowSize; y++) {
-    // Check every Row
-    Target1Index = 0;
-    Target2Index = 0;
-    for (x = 0; x < (RowSize - 11); x++) {
-      // Checking mutiple cells
-
-      Cell = Bitmap[(y * RowSize) + x] & ~QrExclude;
-      if (Cell == QrRsvd) {
-        Cell = QrWhite;
-      }
-
-      if (Cell == Target1[Target1Index]) {
-        Target1Index++;
-        if (Target1Index == 10) {
-          Penalty     += 40;
-          Target1Index = 0;
-          DEBUG ((DEBUG_INFO, "Found horizontal pattern 1 at %d:%d\n", y, x));
-        }
-      } else {
-        Target1Index = 0;
-      }
-
-      if (Cell == Target2[Target2Index]) {
-        Target2Index++;
-        if (Target2Index == 10) {
-          Penalty     += 40;
-          Target2Index = 0;
-          DEBUG ((DEBUG_INFO, "Found horizontal pattern 2 at %d:%d\n", y, x));
-        }
-      } else {
-        Target2Index = 0;
+  for (y = 0; y < Ctx->Size; y++) {
+    //
+    // Match bit x is set if modules x-10 through x match the target.  Target module j
+    // is compared with the row moved right by 10-j modules.
+    //
+    CopyMem (Match1, Ctx->ValidRow, sizeof (QR_ROW));
+    CopyMem (Match2, Ctx->ValidRow, sizeof (QR_ROW));
+    Match1[0] &= ~(UINTN)0x3FF;
+    Match2[0] &= ~(UINTN)0x3FF;
+
+    for (j = 0; j < sizeof (Target1); j++) {
+      ShiftRow (Ctx, Shifted, Rows[y], sizeof (Target1) - 1 - j);
+      for (w = 0; w < Ctx->RowWords; w++) {
+        Match1[w] &= (Target1[j] != 0) ? Shifted[w] : ~Shifted[w];
+        Match2[w] &= (Target2[j] != 0) ? Shifted[w] : ~Shifted[w];
       }
     }
-  }
-
-  //
-  // Check each column for the special patterns
-  //
-  for (y = 0; y < RowSize; y++) {
-    // Check every Row
-    Target1Index = 0;
-    Target2Index = 0;
-    for (x = 0; x < (RowSize - 11); x++) {
-      // Checking mutiple cells
-
-      Cell = Bitmap[(y * RowSize) + x] & ~QrExclude;
-      if (Cell == QrRsvd) {
-        Cell = QrWhite;
-      }
 
-      if (Cell == Target1[Target1Index]) {
-        Target1Index++;
-        if (Target1Index == 10) {
-          Penalty     += 40;
-          Target1Index = 0;
-          DEBUG ((DEBUG_INFO, "Found vertical pattern 1 at %d:%d\n", y, x));
-        }
-      } else {
-        Target1Index = 0;
-      }
-
-      if (Cell == Target2[Target2Index]) {
-        Target2Index++;
-        if (Target2Index == 10) {
-          Penalty     += 40;
-          Target2Index = 0;
-          DEBUG ((DEBUG_INFO, "Found vertical pattern 2 at %d:%d\n", y, x));
-        }
-      } else {
-        Target2Index = 0;
-      }
-    }
+    Penalty += 40 * (CountRowBits (Ctx, Match1) + CountRowBits (Ctx, Match2));
   }
 
-  DEBUG ((DEBUG_INFO, "Evaluate 3 penalty is %d\n", Penalty));
   return Penalty;
 }
 
@@ -1146,32 +1181,25 @@ Evaluate3 (
 /*         For every 5% deviation, add 10 points                                  */
 /*         eg. 45% to 55% == 0 points                                             */
 /*         eg. 40% to 60% == 10 points                                            */
-/*         FYI - a 3x3 collection contains 4 2x2 collections - worth 12 points    */
 /*--------------------------------------------------------------------------------*/
 static
 INTN
 Evaluate4 (
-  UINT8  *Bitmap,
-  INTN   RowSize
+  QR_ENCODER_CONTEXT  *Ctx,
+  QR_ROW              *Rows
   )
 {
-  INTN   Penalty;
-  INTN   x, y;
-  UINT8  Cell;
-  INTN   CountOfBlack;
-  INTN   TotalCount;
-  INTN   Ratio;
-
-  TotalCount   = RowSize * RowSize;
+  INTN  Penalty;
+  INTN  y;
+  INTN  CountOfBlack;
+  INTN  TotalCount;
+  INTN  Ratio;
+
+  TotalCount   = Ctx->Size * Ctx->Size;
   CountOfBlack = 0;
-  for (y = 0; y < RowSize; y++) {
-    for (x = 0; x < RowSize; x++) {
-      Cell = Bitmap[(y * RowSize) + x] & ~QrExclude;
-      // gQrRsvd is treated as White
-      if (Cell == QrBlack) {
-        CountOfBlack++;
-      }
-    }
+  for (y = 0; y < Ctx->Size; y++) {
+    // QrRsvd is treated as White
+    CountOfBlack += CountRowBits (Ctx, Rows[y]);
   }
 
   Ratio = ((CountOfBlack * 100) / TotalCount) - 50;
@@ -1181,8 +1209,6 @@ Evaluate4 (
 
   Penalty = 10 * (Ratio / 5);
 
-  DEBUG ((DEBUG_INFO, "Evaluate 4 penalty is %d, based on TC=%d, CB=%d, R=%d\n", Penalty, TotalCount, CountOfBlack, Ratio));
-
   return Penalty;
 }
 
@@ -1193,78 +1219,83 @@ Evaluate4 (
 static
 EFI_STATUS
 Step1_Process (
-  UINT8   *Data,
-  UINT16  DataLen,
-  INTN    RegionSize
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT8               *Data,
+  UINT16              DataLen,
+  INTN                RegionSize
   )
 {
   QRENCODING  suggestedMode;
   UINT8       suggestedQrVersion;
+  INTN        i;
 
   suggestedMode = CheckEncodingType (Data, DataLen);
 
-  if (gQrMode  < suggestedMode) {
-    if (gQrMode == QrAutoMode) {
-      gQrMode = suggestedMode;
+  if (Ctx->Mode  < suggestedMode) {
+    if (Ctx->Mode == QrAutoMode) {
+      Ctx->Mode = suggestedMode;
     } else {
-      DEBUG ((DEBUG_ERROR, "Suggested mode %d is larger than requested mode %d\n", suggestedMode, gQrMode));
+      DEBUG ((DEBUG_ERROR, "Suggested mode %d is larger than requested mode %d\n", suggestedMode, Ctx->Mode));
       return EFI_INVALID_PARAMETER;
     }
   }
 
-  suggestedQrVersion = CheckQrVersion (Data, DataLen);
+  suggestedQrVersion = CheckQrVersion (Ctx, Data, DataLen);
 
-  if (gQrVersion < suggestedQrVersion) {
-    if (gQrVersion == QrAutoVersion) {
+  if (Ctx->Version < suggestedQrVersion) {
+    if (Ctx->Version == QrAutoVersion) {
       // Automatic selection
-      gQrVersion = suggestedQrVersion;
+      Ctx->Version = suggestedQrVersion;
     } else {
-      DEBUG ((DEBUG_INFO, "Suggested version %d is larger than requested version %d\n", suggestedQrVersion, gQrVersion));
+      DEBUG ((DEBUG_INFO, "Suggested version %d is larger than requested version %d\n", suggestedQrVersion, Ctx->Version));
       return EFI_INVALID_PARAMETER;
     }
   }
 
   // Validate that Version and Mode are currect after applying suggested values;
-  if ((gQrVersion < QrMinVersion) || (gQrVersion > QrMaxVersion)) {
+  if ((Ctx->Version < QrMinVersion) || (Ctx->Version > QrMaxVersion)) {
     // ISO 18004:2015 Qr Versions supported
-    DEBUG ((DEBUG_INFO, "Suggested version %d is not 1<=QrVersion<=40\n", gQrVersion));
+    DEBUG ((DEBUG_INFO, "Suggested version %d is not 1<=QrVersion<=40\n", Ctx->Version));
     return EFI_INVALID_PARAMETER;
   }
 
-  if ((gQrMode <= QrAutoMode) || (gQrMode > QrByteMode)) {
+  if ((Ctx->Mode <= QrAutoMode) || (Ctx->Mode > QrByteMode)) {
     // Only support Num/Alpha/Byte for now
-    DEBUG ((DEBUG_INFO, "Suggested QrMode %d is not supported\n", gQrMode));
+    DEBUG ((DEBUG_INFO, "Suggested QrMode %d is not supported\n", Ctx->Mode));
     return EFI_INVALID_PARAMETER;
   }
 
-  DEBUG ((DEBUG_INFO, "QrVersion is %d\n", gQrVersion));
-  gQrSize = gQrVersion * 4 + 17;    // Rule from ISO 18004.
-  if (RegionSize < (gQrSize + (2 * QR_QUIET_ZONE))) {
-    DEBUG ((DEBUG_ERROR, "Region size %d for QR code size %d is too small\n", RegionSize, gQrSize));
+  DEBUG ((DEBUG_INFO, "QrVersion is %d\n", Ctx->Version));
+  Ctx->Size = Ctx->Version * 4 + 17;    // Rule from ISO 18004.
+  if (RegionSize < (Ctx->Size + (2 * QR_QUIET_ZONE))) {
+    DEBUG ((DEBUG_ERROR, "Region size %d for QR code size %d is too small\n", RegionSize, Ctx->Size));
     return EFI_INVALID_PARAMETER;
   }
 
-  gQrBitmapLen = gQrSize * gQrSize;
-  gQrBitmap    = AllocateZeroPool (gQrBitmapLen); // Initialize to "gray"
+  // The matrix starts all "gray".
+  Ctx->RowWords = (Ctx->Size + QR_WORD_BITS - 1) / QR_WORD_BITS;
+  for (i = 0; i < Ctx->Size; i++) {
+    SetRowBit (Ctx->ValidRow, i, TRUE);
+  }
 
-  gQrT = &gQrTable[(gQrVersion - 1) * 4 + gQrLevel - 1];   // QrT points to the table entry to use;
+  Ctx->QrT = &gQrTable[(Ctx->Version - 1) * 4 + Ctx->Level - 1];   // QrT points to the table entry to use;
 
-  DEBUG ((DEBUG_INFO, "Using QrCode=%d (%dx%d), Mode=%d, ECLevel=%d\n", gQrVersion, gQrSize, gQrSize, gQrMode, gQrLevel));
+  DEBUG ((DEBUG_INFO, "Using QrCode=%d (%dx%d), Mode=%d, ECLevel=%d\n", Ctx->Version, Ctx->Size, Ctx->Size, Ctx->Mode, Ctx->Level));
 
   DEBUG ((
     DEBUG_INFO,
     "entry   %d %d %d %d %d %d %d %d %d %d %d\n",
-    gQrT->totalWords,
-    gQrT->ECWordsPerBlock,
-    gQrT->group1BlockCount,
-    gQrT->group1Words,
-    gQrT->group2BlockCount,
-    gQrT->group2Words,
-    gQrT->requiredRemainder,
-    gQrT->maxNumeric,
-    gQrT->maxAlphanumeric,
-    gQrT->maxBytes,
-    gQrT->maxKanji
+    Ctx->QrT->totalWords,
+    Ctx->QrT->ECWordsPerBlock,
+    Ctx->QrT->group1BlockCount,
+    Ctx->QrT->group1Words,
+    Ctx->QrT->group2BlockCount,
+    Ctx->QrT->group2Words,
+    Ctx->QrT->requiredRemainder,
+    Ctx->QrT->maxNumeric,
+    Ctx->QrT->maxAlphanumeric,
+    Ctx->QrT->maxBytes,
+    Ctx->QrT->maxKanji
     ));
 
   return EFI_SUCCESS;
@@ -1282,51 +1313,52 @@ Step1_Process (
 static
 EFI_STATUS
 Step2_Process (
-  UINT8  *Data,
-  UINTN  DataLen
+  QR_ENCODER_CONTEXT  *Ctx,
+  UINT8               *Data,
+  UINTN               DataLen
   )
 {
   UINTN  lengthBits = 0;
 
-  if (gQrVersion <= gLengthBits[0][0]) {
-    lengthBits = gLengthBits[0][gQrMode];
-  } else if (gQrVersion <= gLengthBits[1][0]) {
-    lengthBits = gLengthBits[1][gQrMode];
+  if (Ctx->Version <= gLengthBits[0][0]) {
+    lengthBits = gLengthBits[0][Ctx->Mode];
+  } else if (Ctx->Version <= gLengthBits[1][0]) {
+    lengthBits = gLengthBits[1][Ctx->Mode];
   } else {
-    lengthBits = gLengthBits[2][gQrMode];
+    lengthBits = gLengthBits[2][Ctx->Mode];
   }
 
-  InitCodeWords (gQrT->totalWords);
+  InitCodeWords (Ctx, Ctx->QrT->totalWords);
 
-  switch (gQrMode) {
+  switch (Ctx->Mode) {
     case QrNumericMode:
-      AddCodeWordBits (ISO_NUMERIC_CODE, 4);
-      AddCodeWordBits (DataLen, lengthBits);
-      EncodeNumeric (Data, DataLen);
+      AddCodeWordBits (Ctx, ISO_NUMERIC_CODE, 4);
+      AddCodeWordBits (Ctx, DataLen, lengthBits);
+      EncodeNumeric (Ctx, Data, DataLen);
       break;
 
     case QrAlphaNumericMode:
-      AddCodeWordBits (ISO_ALPHANUMERIC_CODE, 4);
-      AddCodeWordBits (DataLen, lengthBits);
-      EncodeAlphanumeric (Data, DataLen);
+      AddCodeWordBits (Ctx, ISO_ALPHANUMERIC_CODE, 4);
+      AddCodeWordBits (Ctx, DataLen, lengthBits);
+      EncodeAlphanumeric (Ctx, Data, DataLen);
       break;
 
     case QrByteMode:
-      AddCodeWordBits (ISO_BYTE_CODE, 4);
-      AddCodeWordBits (DataLen, lengthBits);
-      EncodeBytes (Data, DataLen);
+      AddCodeWordBits (Ctx, ISO_BYTE_CODE, 4);
+      AddCodeWordBits (Ctx, DataLen, lengthBits);
+      EncodeBytes (Ctx, Data, DataLen);
       break;
 
     default:
-      DEBUG ((DEBUG_ERROR, "Unsupported mode %d\n", gQrMode));
+      DEBUG ((DEBUG_ERROR, "Unsupported mode %d\n", Ctx->Mode));
       ASSERT (FALSE);
       break;
   }
 
   DEBUG ((DEBUG_INFO, "Adding terminator bits. They are allowed not to fit, so ignore AddWords error on this call\n"));
 
-  AddCodeWordBits (0, 4);    // Terminating 0000's as required - if they fit
-  AddCodeWordPadBytes ();
+  AddCodeWordBits (Ctx, 0, 4);    // Terminating 0000's as required - if they fit
+  AddCodeWordPadBytes (Ctx);
 
   return EFI_SUCCESS;
 }
@@ -1340,43 +1372,43 @@ Step2_Process (
 static
 EFI_STATUS
 Step3_Process (
-  VOID
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
-  UINTN   i;
-  UINTN   ECWordIndex;
-  UINTN   CodeWordIndex;
-  UINTN   ECWords;
-  UINT16  ECWordsPerBlock;
-  UINTN   Blocks;
-
-  Blocks          = gQrT->group1BlockCount + gQrT->group2BlockCount;
-  ECWordsPerBlock = gQrT->ECWordsPerBlock;
-  ECWords         = ECWordsPerBlock * Blocks;
-  CodeWordIndex   = 0;
-  ECWordIndex     = 0;
-
-  gECWords     = AllocatePool (ECWords);
-  gECWordCount = ECWords;
-  ASSERT (NULL != gECWords);
-  if (NULL == gECWords) {
-    return EFI_OUT_OF_RESOURCES;
+  EFI_STATUS  Status;
+  UINTN       i;
+  UINTN       ECWordIndex;
+  UINTN       CodeWordIndex;
+  UINTN       ECWords;
+  UINT16      ECWordsPerBlock;
+  UINTN       Blocks;
+
+  Blocks           = Ctx->QrT->group1BlockCount + Ctx->QrT->group2BlockCount;
+  ECWordsPerBlock  = Ctx->QrT->ECWordsPerBlock;
+  ECWords          = ECWordsPerBlock * Blocks;
+  CodeWordIndex    = 0;
+  ECWordIndex      = 0;
+  Ctx->ECWordCount = ECWords;
+
+  Status = BuildGeneratorProducts (Ctx);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
   //
   // Compute EC Words for every block
   //
-  for (i = 0; i < gQrT->group1BlockCount; i++) {
+  for (i = 0; i < Ctx->QrT->group1BlockCount; i++) {
     // Process Group 1 blocks
-    PolynomialDivision (gQrT->group1Words, &gCodeWords[CodeWordIndex], ECWordsPerBlock, &gECWords[ECWordIndex]);
-    CodeWordIndex += gQrT->group1Words;
+    PolynomialDivision (Ctx, Ctx->QrT->group1Words, &Ctx->CodeWords[CodeWordIndex], &Ctx->ECWords[ECWordIndex]);
+    CodeWordIndex += Ctx->QrT->group1Words;
     ECWordIndex   += ECWordsPerBlock;
   }
 
-  for (i = 0; i < gQrT->group2BlockCount; i++) {
+  for (i = 0; i < Ctx->QrT->group2BlockCount; i++) {
     // Process Group 2 blocks
-    PolynomialDivision (gQrT->group2Words, &gCodeWords[CodeWordIndex], ECWordsPerBlock, &gECWords[ECWordIndex]);
-    CodeWordIndex += gQrT->group2Words;
+    PolynomialDivision (Ctx, Ctx->QrT->group2Words, &Ctx->CodeWords[CodeWordIndex], &Ctx->ECWords[ECWordIndex]);
+    CodeWordIndex += Ctx->QrT->group2Words;
     ECWordIndex   += ECWordsPerBlock;
   }
 
@@ -1415,20 +1447,20 @@ Step3_Process (
 
   */
 
-  if ((gQrVersion == 1) &&                        // Specific data to match we site samples
-      (gQrMode    == QrAlphaNumericMode) &&       // of masking.  The underlying data at that
-      (gQrLevel   == QrECLevel_Q) &&              // site is invalid (IMHO) due to incorrect padding
-      (gFlags & QR_FLAGS_DEBUG_MASKING))
+  if ((Ctx->Version == 1) &&                      // Specific data to match we site samples
+      (Ctx->Mode    == QrAlphaNumericMode) &&     // of masking.  The underlying data at that
+      (Ctx->Level   == QrECLevel_Q) &&            // site is invalid (IMHO) due to incorrect padding
+      (Ctx->Flags & QR_FLAGS_DEBUG_MASKING))
   {
-    gCodeWords[12] = 0;                           // Codeword is incorrect on Web page
+    Ctx->CodeWords[12] = 0;                       // Codeword is incorrect on Web page
     DEBUG ((DEBUG_INFO, "CodeWord[12] set to 0 to match web page masking sample\n"));
   }
 
-  if (gFlags & QR_FLAGS_DEBUG_CODE_WORDS) {
+  if (Ctx->Flags & QR_FLAGS_DEBUG_CODE_WORDS) {
     DEBUG ((DEBUG_INFO, "ECWords=%d, ECWordIndex=%d\n", ECWords, ECWordIndex));
     for (i = 0; i < ECWords; i++) {
-      DEBUG ((DEBUG_INFO, " EC Word %4d is %4d - ", i, gECWords[i]));
-      PrintBinary (gECWords[i], 8, '0');
+      DEBUG ((DEBUG_INFO, " EC Word %4d is %4d - ", i, Ctx->ECWords[i]));
+      PrintBinary (Ctx->ECWords[i], 8, '0');
       DEBUG ((DEBUG_INFO, "\n"));
     }
   }
@@ -1444,55 +1476,56 @@ Step3_Process (
 static
 EFI_STATUS
 Step4_Process (
-  VOID
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
-  UINTN  StreamWordIndex;
-  UINTN  i;
-  UINTN  Indx;
-  UINTN  MaxIndx;
-  UINTN  Blocks;
-  UINTN  G2Base;
+  CONST QrTableEntry  *QrT;
+  UINTN               StreamWordIndex;
+  UINTN               i;
+  UINTN               Indx;
+  UINTN               MaxIndx;
+  UINTN               Blocks;
+  UINTN               G2Base;
 
-  gBitStreamCount = gCodeWordCount + gECWordCount;
-  gBitStream      = AllocatePool (gBitStreamCount);
-  StreamWordIndex = 0;
+  QrT                 = Ctx->QrT;
+  Ctx->BitStreamCount = Ctx->CodeWordCount + Ctx->ECWordCount;
+  StreamWordIndex     = 0;
 
-  Blocks = gQrT->group1BlockCount + gQrT->group2BlockCount;
+  Blocks = QrT->group1BlockCount + QrT->group2BlockCount;
 
-  MaxIndx = gQrT->group1Words;
-  if (MaxIndx < gQrT->group2Words) {
-    MaxIndx = gQrT->group2Words;
+  MaxIndx = QrT->group1Words;
+  if (MaxIndx < QrT->group2Words) {
+    MaxIndx = QrT->group2Words;
   }
 
-  G2Base =  gQrT->group1BlockCount * gQrT->group1Words;
+  G2Base =  QrT->group1BlockCount * QrT->group1Words;
   //
   //  Interleave the bitstream followed by interleaved EC words
   //
   for (Indx = 0; Indx < MaxIndx; Indx++) {
     for (i = 0; i < Blocks; i++) {
-      if (i < gQrT->group1BlockCount) {
-        if (Indx < gQrT->group1Words) {
-          gBitStream[StreamWordIndex++] = gCodeWords[(i * gQrT->group1Words) + Indx];
+      if (i < QrT->group1BlockCount) {
+        if (Indx < QrT->group1Words) {
+          Ctx->BitStream[StreamWordIndex++] = Ctx->CodeWords[(i * QrT->group1Words) + Indx];
         }
       } else {
-        if (Indx < gQrT->group2Words) {
-          gBitStream[StreamWordIndex++] = gCodeWords[G2Base + ((i - gQrT->group1BlockCount) * gQrT->group2Words) + Indx];
+        if (Indx < QrT->group2Words) {
+          Ctx->BitStream[StreamWordIndex++] = Ctx->CodeWords[G2Base + ((i - QrT->group1BlockCount) * QrT->group2Words) + Indx];
         }
       }
     }
   }
 
-  for (Indx = 0; Indx < gQrT->ECWordsPerBlock; Indx++) {
+  for (Indx = 0; Indx < QrT->ECWordsPerBlock; Indx++) {
     for (i = 0; i < Blocks; i++) {
-      gBitStream[StreamWordIndex++] = gECWords[(i * gQrT->ECWordsPerBlock) + Indx];
+      Ctx->BitStream[StreamWordIndex++] = Ctx->ECWords[(i * QrT->ECWordsPerBlock) + Indx];
     }
   }
 
-  if (gFlags & QR_FLAGS_DEBUG_BIT_STREAM) {
-    for (i = 0; i < gBitStreamCount; i++) {
-      DEBUG ((DEBUG_INFO, " BitStream %4d is %4d - ", i, gBitStream[i]));
-      PrintBinary (gBitStream[i], 8, '0');
+  if (Ctx->Flags & QR_FLAGS_DEBUG_BIT_STREAM) {
+    for (i = 0; i < Ctx->BitStreamCount; i++) {
+      DEBUG ((DEBUG_INFO, " BitStream %4d is %4d - ", i, Ctx->BitStream[i]));
+      PrintBinary (Ctx->BitStream[i], 8, '0');
       DEBUG ((DEBUG_INFO, "\n"));
     }
   }
@@ -1515,44 +1548,46 @@ Step4_Process (
 static
 EFI_STATUS
 Step5_Process (
-  VOID
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
-  INTN  i;
-  INTN  j;
+  INTN         i;
+  INTN         j;
+  CONST UINT8  *Locations;
 
   // All QR Codes get the same size finder in the upper left, upper right, and lower left cornet
   // along with a single black module next to the lower left Finder.
-  drawFinder (gQrBitmap, gQrSize, 0, 0);
-  drawFinder (gQrBitmap, gQrSize, gQrSize - 7, 0);
-  drawFinder (gQrBitmap, gQrSize, 0, gQrSize - 7);
+  drawFinder (Ctx, 0, 0);
+  drawFinder (Ctx, Ctx->Size - 7, 0);
+  drawFinder (Ctx, 0, Ctx->Size - 7);
 
-  gQrBitmap[((4 * gQrVersion) + 9)  * gQrSize + 8] = QrBlack_E;
+  SetModule (Ctx, (4 * Ctx->Version) + 9, 8, QrBlack_E);
 
   // All QR Code > version 1 get alignment patterns
-  if (gQrVersion > 1) {
+  if (Ctx->Version > 1) {
+    Locations = gAlignmentLocations[Ctx->Version - 2];
     for (i = 0; i < QR_MAX_LOCATIONS; i++) {
-      if (gAlignmentLocations[gQrVersion-2][i] == 0) {
+      if (Locations[i] == 0) {
         break;
       }
 
       for (j = 0; j < QR_MAX_LOCATIONS; j++) {
-        if (gAlignmentLocations[gQrVersion-2][j] == 0) {
+        if (Locations[j] == 0) {
           break;
         }
 
-        drawAlignment (gQrBitmap, gQrSize, gAlignmentLocations[gQrVersion-2][i], gAlignmentLocations[gQrVersion-2][j]);
-        drawAlignment (gQrBitmap, gQrSize, gAlignmentLocations[gQrVersion-2][j], gAlignmentLocations[gQrVersion-2][i]);
+        drawAlignment (Ctx, Locations[i], Locations[j]);
+        drawAlignment (Ctx, Locations[j], Locations[i]);
       }
     }
   }
 
-  drawReserved (gQrBitmap, gQrSize);
+  drawReserved (Ctx);
 
-  drawVTiming (gQrBitmap, gQrSize, 6, 9, gQrSize - 7);
-  drawHTiming (gQrBitmap, gQrSize, 8, 7, gQrSize - 8);
+  drawVTiming (Ctx, 6, 9, Ctx->Size - 7);
+  drawHTiming (Ctx, 8, 7, Ctx->Size - 8);
 
-  drawBits (gQrBitmap, gQrSize);
+  drawBits (Ctx);
 
   return EFI_SUCCESS;
 }
@@ -1561,99 +1596,55 @@ Step5_Process (
 /* Step 6. Data Masking                                                           */
 /*         Apply the 8 data masking patterns and evaluate each pattern for quality*/
 /*         Choose the pattern with the best quality                               */
+/*                                                                                */
+/*         Every mask pattern repeats each QR_MASK_PERIOD rows and columns, so    */
+/*         the patterns are built once as rows of bits, and each mask is applied  */
+/*         to the rows and columns of the matrix a word of modules at a time.     */
 /*--------------------------------------------------------------------------------*/
 static
 EFI_STATUS
 Step6_Process (
-  VOID
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
-  UINT8    *TestBitmaps[QR_MASK_PATTERNS];
-  INTN     TestPenalty[QR_MASK_PATTERNS];
-  BOOLEAN  flip = FALSE;
-  UINT8    *Temp;
-  INTN     MinPenalty = MAX_INTN;
-  INTN     MinPenaltyIndex = QR_MASK_PATTERNS;
-  INTN     k, Row, Column;
-  UINT8    Cell;
-
-  // Get 8 copies of the bitmap to apply mask patterns to.
+  INTN   TestPenalty[QR_MASK_PATTERNS];
+  INTN   MinPenalty      = MAX_INTN;
+  INTN   MinPenaltyIndex = QR_MASK_PATTERNS;
+  INTN   k, Row, Column;
+  UINTN  w;
+
+  // Build the mask patterns, by row and by column
   for (k = 0; k < QR_MASK_PATTERNS; k++) {
-    DEBUG ((DEBUG_INFO, "Processing pattern %d\n", k));
-    TestBitmaps[k] = AllocateCopyPool (gQrBitmapLen, gQrBitmap);
-
-    for (Row = 0; Row < gQrSize; Row++) {
-      // i is Row
-      for (Column = 0; Column < gQrSize; Column++) {
-        // j is Column
-        switch (k) {
-          case 0:                              /* Data Mask Reference 000 */
-            flip =  0 == ((Row + Column) % 2); // (i + j) mod 2 = 0
-            break;
-          case 1:                   /* Data Mask Reference 001 */
-            flip =  0 == (Row % 2); // i mod 2 = 0
-            break;
-          case 2:                      /* Data Mask Reference 010 */
-            flip =  0 == (Column % 3); // j mod 3 = 0
-            break;
-          case 3:                              /* Data Mask Reference 011 */
-            flip =  0 == ((Row + Column) % 3); // (i + j) mod 3 = 0
-            break;
-          case 4:                                        /* Data Mask Reference 100 */
-            flip =  0 == ((Row / 2) + (Column / 3)) % 2; // ((i div 2) + ( j div 3)) mod 2 = 0
-            break;
-          case 5:                                                     /* Data Mask Reference 101 */
-            flip =  0 == ((Row * Column) % 2) + ((Row * Column) % 3); // (i j) mod 2 + (i j) mod 3 = 0
-            break;
-          case 6:                                                           /* Data Mask Reference 110 */
-            flip =  0 == (((Row * Column) % 2) + ((Row * Column) % 3)) % 2; // ((i j) mod 2 + (i j) mod 3) mod 2 = 0
-            break;
-          case 7:                                                           /* Data Mask Reference 111 */
-            flip =  0 == (((Row + Column) % 2) + ((Row * Column) % 3)) % 2; // ((i+j) mod 2 + (i j) mod 3) mod 2 = 0
-            break;
-        }
+    for (Row = 0; Row < QR_MASK_PERIOD; Row++) {
+      for (Column = 0; Column < Ctx->Size; Column++) {
+        SetRowBit (Ctx->Pattern[k][Row], Column, MaskBit (k, Row, Column));
+        SetRowBit (Ctx->PatternT[k][Row], Column, MaskBit (k, Column, Row));
+      }
+    }
+  }
 
-        if (gFlags & QR_FLAGS_DEBUG_MASK_ONLY) {
-          // Draw the Masking patters from ISO Spec Fig 21
-          Cell = TestBitmaps[k][Row * gQrSize + Column];
-          if ( 0 != (Cell & QrExclude)) {
-            // If a module is "excluded", draw as gray
-            if (flip) {
-              Cell = QrGray;
-            } else {
-              Cell = QrWhite;
-            }
-          } else {
-            if (flip) {
-              Cell = QrBlack;
-            } else {
-              Cell = QrWhite;
-            }
-          }
+  // Build the columns of the matrix
+  for (Row = 0; Row < Ctx->Size; Row++) {
+    for (Column = 0; Column < Ctx->Size; Column++) {
+      SetRowBit (Ctx->DarkT[Column], Row, (Ctx->Dark[Row][QR_WORD (Column)] & QR_BIT (Column)) != 0);
+      SetRowBit (Ctx->FunctionT[Column], Row, (Ctx->Function[Row][QR_WORD (Column)] & QR_BIT (Column)) != 0);
+    }
+  }
 
-          TestBitmaps[k][Row * gQrSize + Column] = Cell;
-        } else {
-          if (flip) {
-            Cell = TestBitmaps[k][Row * gQrSize + Column];
-            if ( 0 == (Cell & QrExclude)) {
-              // If a module is "excluded", don't flip the bit.
-              if (Cell == QrWhite) {
-                Cell = QrBlack;
-              } else {
-                Cell = QrWhite;
-              }
-
-              TestBitmaps[k][Row * gQrSize + Column] = Cell;
-            }
-          }
-        }
+  for (k = 0; k < QR_MASK_PATTERNS; k++) {
+    // If a module is "excluded", don't flip the bit.
+    for (Row = 0; Row < Ctx->Size; Row++) {
+      for (w = 0; w < Ctx->RowWords; w++) {
+        Ctx->Masked[Row][w]  = Ctx->Dark[Row][w] ^ (Ctx->Pattern[k][Row % QR_MASK_PERIOD][w] & ~Ctx->Function[Row][w]);
+        Ctx->MaskedT[Row][w] = Ctx->DarkT[Row][w] ^ (Ctx->PatternT[k][Row % QR_MASK_PERIOD][w] & ~Ctx->FunctionT[Row][w]);
       }
     }
 
-    TestPenalty[k]  = Evaluate1 (TestBitmaps[k], gQrSize);
-    TestPenalty[k] += Evaluate2 (TestBitmaps[k], gQrSize);
-    TestPenalty[k] += Evaluate3 (TestBitmaps[k], gQrSize);
-    TestPenalty[k] += Evaluate4 (TestBitmaps[k], gQrSize);
+    TestPenalty[k]  = Evaluate1 (Ctx, Ctx->Masked) + Evaluate1 (Ctx, Ctx->MaskedT);
+    TestPenalty[k] += Evaluate2 (Ctx, Ctx->Masked);
+    TestPenalty[k] += Evaluate3 (Ctx, Ctx->Masked) + Evaluate3 (Ctx, Ctx->MaskedT);
+    TestPenalty[k] += Evaluate4 (Ctx, Ctx->Masked);
+    DEBUG ((DEBUG_INFO, "Pattern %d penalty is %d\n", k, TestPenalty[k]));
     if (MinPenalty > TestPenalty[k]) {
       MinPenalty      = TestPenalty[k];
       MinPenaltyIndex = k;
@@ -1662,23 +1653,30 @@ Step6_Process (
 
   DEBUG ((DEBUG_INFO, "Minimum penalty is %d from index %d\n", MinPenalty, MinPenaltyIndex));
   ASSERT (MinPenaltyIndex < QR_MASK_PATTERNS);
-  if (gFlags & QR_FLAGS_NO_MASK) {
+  if (Ctx->Flags & QR_FLAGS_NO_MASK) {
     DEBUG ((DEBUG_INFO, "Not using mask\n"));
-  } else {
-    if (gFlags & QR_FLAGS_MASK_SEL) {
-      MinPenaltyIndex = gFlags & 0x07;
-    }
+    return EFI_SUCCESS;
+  }
 
-    // Swap the "best" masked bitmap with gQrBitmap, and free the 8 unused bitmaps.
-    Temp                         = TestBitmaps[MinPenaltyIndex];
-    TestBitmaps[MinPenaltyIndex] = gQrBitmap;
-    gQrBitmap                    = Temp;
-    gQrMask                      = MinPenaltyIndex;
-    DEBUG ((DEBUG_INFO, "Using mask %d\n", MinPenaltyIndex));
+  if (Ctx->Flags & QR_FLAGS_MASK_SEL) {
+    MinPenaltyIndex = Ctx->Flags & 0x07;
   }
 
-  for (k = 0; k < QR_MASK_PATTERNS; k++) {
-    FreePool (TestBitmaps[k]);
+  Ctx->Mask = MinPenaltyIndex;
+  DEBUG ((DEBUG_INFO, "Using mask %d\n", MinPenaltyIndex));
+
+  for (Row = 0; Row < Ctx->Size; Row++) {
+    for (w = 0; w < Ctx->RowWords; w++) {
+      if (Ctx->Flags & QR_FLAGS_DEBUG_MASK_ONLY) {
+        // Draw the Masking patters from ISO Spec Fig 21.  If a module is "excluded", draw as gray
+        Ctx->Dark[Row][w]     = Ctx->Pattern[Ctx->Mask][Row % QR_MASK_PERIOD][w] & ~Ctx->Function[Row][w];
+        Ctx->Used[Row][w]     = ~(Ctx->Pattern[Ctx->Mask][Row % QR_MASK_PERIOD][w] & Ctx->Function[Row][w]) & Ctx->ValidRow[w];
+        Ctx->Function[Row][w] = 0;
+        Ctx->Reserved[Row][w] = 0;
+      } else {
+        Ctx->Dark[Row][w] ^= Ctx->Pattern[Ctx->Mask][Row % QR_MASK_PERIOD][w] & ~Ctx->Function[Row][w];
+      }
+    }
   }
 
   return EFI_SUCCESS;
@@ -1692,7 +1690,7 @@ Step6_Process (
 static
 EFI_STATUS
 Step7_Process (
-  VOID
+  QR_ENCODER_CONTEXT  *Ctx
   )
 {
   UINT16  FormatInfo;
@@ -1700,15 +1698,17 @@ Step7_Process (
   INTN    t;
   INTN    i;
   INTN    j;
+  INTN    Size;
   UINT16  Mask;
   UINT32  VMask;
 
-  FormatInfo = gFormatInfo[gQrLevel-1][gQrMask];
+  Size       = Ctx->Size;
+  FormatInfo = gFormatInfo[Ctx->Level-1][Ctx->Mask];
 
   DEBUG ((DEBUG_INFO, " FormatInfo %x - ", FormatInfo));
   PrintBinary (FormatInfo, 15, '0');
   DEBUG ((DEBUG_INFO, "\n"));
-  if (gFlags & QR_FLAGS_DEBUG_MASK_ONLY) {
+  if (Ctx->Flags & QR_FLAGS_DEBUG_MASK_ONLY) {
     // Don't draw Format or version info
     return EFI_SUCCESS;
   }
@@ -1721,9 +1721,9 @@ Step7_Process (
       t = 1;
     }
 
-    gQrBitmap[(i + t) * gQrSize + 8] = (Mask & FormatInfo) ? QrBlack : QrWhite;
-    gQrBitmap[9 * gQrSize - 1 - i]   = (Mask & FormatInfo) ? QrBlack : QrWhite;
-    Mask                           <<= 1;
+    SetModule (Ctx, i + t, 8, (Mask & FormatInfo) ? QrBlack : QrWhite);
+    SetModule (Ctx, 8, Size - 1 - i, (Mask & FormatInfo) ? QrBlack : QrWhite);
+    Mask <<= 1;
   }
 
   t = 1;
@@ -1733,13 +1733,13 @@ Step7_Process (
       t = 0;
     }
 
-    gQrBitmap[8 * gQrSize + 6 - i + t]         = (Mask & FormatInfo) ? QrBlack : QrWhite;
-    gQrBitmap[(gQrSize - 7 + i) * gQrSize + 8] = (Mask & FormatInfo) ? QrBlack : QrWhite;
-    Mask                                     <<= 1;
+    SetModule (Ctx, 8, 6 - i + t, (Mask & FormatInfo) ? QrBlack : QrWhite);
+    SetModule (Ctx, Size - 7 + i, 8, (Mask & FormatInfo) ? QrBlack : QrWhite);
+    Mask <<= 1;
   }
 
-  if (gQrVersion > 6) {
-    VersionInfo = gVersionInfo[gQrVersion-7];      // Table starts at version 7
+  if (Ctx->Version > 6) {
+    VersionInfo = gVersionInfo[Ctx->Version-7];      // Table starts at version 7
     VMask       = 0x00001;
     DEBUG ((DEBUG_INFO, " VersionInfo  %x - ", VersionInfo));
     PrintBinary (VersionInfo, 18, '0');
@@ -1750,10 +1750,10 @@ Step7_Process (
       for (i = 0; i < 3; i++) {
         // Enter data column by column
         // Lower Left block
-        gQrBitmap[(gQrSize - 11 + i) * gQrSize + j] = (VMask & VersionInfo) ? QrBlack : QrWhite;
+        SetModule (Ctx, Size - 11 + i, j, (VMask & VersionInfo) ? QrBlack : QrWhite);
         // Upper Right block
-        gQrBitmap[(gQrSize * j) + gQrSize - 11 + i] = (VMask & VersionInfo) ? QrBlack : QrWhite;
-        VMask                                     <<= 1;
+        SetModule (Ctx, j, Size - 11 + i, (VMask & VersionInfo) ? QrBlack : QrWhite);
+        VMask <<= 1;
       }
     }
   }
@@ -1763,115 +1763,74 @@ Step7_Process (
 
 /*--------------------------------------------------------------------------------*/
 /* Step 8. Build the Gop->Blt ready bitmap                                        */
-/*         Generate the format information and version information and complete   */
-/*         the symbol.                                                            */
+/*         Each module is drawn as Factor x Factor pixels.  A row of modules is   */
+/*         drawn once, and copied to the remaining pixel lines of the row.        */
 /*--------------------------------------------------------------------------------*/
 static
 EFI_STATUS
 Step8_Process (
-  INTN  RegionSize
+  QR_ENCODER_CONTEXT  *Ctx,
+  INTN                RegionSize
   )
 {
   INTN                           Factor;
   UINTN                          QrOffset;
   UINTN                          BltBufferSize;
-  UINTN                          Offset;
-  INTN                           y, x, fy, fx;
-  INTN                           yy, xx;
+  INTN                           y, x, yy, xx;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Line;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Color;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorRsvd   =  { 232, 162, 0, 255 };        // Visibly different error pixel
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorWhite  =  { 255, 255, 255, 255 };
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorBlack  =  { 0, 0, 0, 255 };
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorGray   =  { 135, 135, 135, 255 };      // Visibly different missing pixel
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorBad    =  { 0, 255, 0, 255 };          // Visibly different data corruption pixel
-  BOOLEAN                        OutOfBounds = FALSE;
-
-  Factor   = RegionSize / (gQrSize + 2 * QR_QUIET_ZONE);    // There must be 4 modules of white around bitmap from spec.
-  QrOffset = ((RegionSize - (Factor * gQrSize)) / Factor) / 2;
-  DEBUG ((DEBUG_INFO, "RegionSize data R=%d, Computed R%d\n", RegionSize, Factor * gQrSize));
-  BltBufferSize = RegionSize * RegionSize;
-  gBltBuffer    = AllocatePool (BltBufferSize * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-  if (NULL == gBltBuffer) {
-    DEBUG ((DEBUG_ERROR, "Error allocating gBltBuffer\n"));
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorRsvd  =  { 232, 162, 0, 255 };         // Visibly different error pixel
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorWhite =  { 255, 255, 255, 255 };
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorBlack =  { 0, 0, 0, 255 };
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  ColorGray  =  { 135, 135, 135, 255 };       // Visibly different missing pixel
+
+  Factor   = RegionSize / (Ctx->Size + 2 * QR_QUIET_ZONE);    // There must be 4 modules of white around bitmap from spec.
+  QrOffset = ((RegionSize - (Factor * Ctx->Size)) / Factor) / 2;
+  DEBUG ((DEBUG_INFO, "RegionSize data R=%d, Computed R%d\n", RegionSize, Factor * Ctx->Size));
+  BltBufferSize  = RegionSize * RegionSize;
+  Ctx->BltBuffer = AllocatePool (BltBufferSize * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  if (NULL == Ctx->BltBuffer) {
+    DEBUG ((DEBUG_ERROR, "Error allocating BltBuffer\n"));
     return EFI_OUT_OF_RESOURCES;
   }
 
-  SetMem32 (gBltBuffer, BltBufferSize * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL), (UINT32)0xffffffff);
+  SetMem32 (Ctx->BltBuffer, BltBufferSize * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL), (UINT32)0xffffffff);
 
-  for (y = 0; y < gQrSize; y++) {
-    for (x = 0; x < gQrSize; x++) {
-      switch (gQrBitmap[y * gQrSize + x]) {
+  //
+  // QrCode is centered within the Region provided, and entire region is
+  // set to white before the QrCode is written
+  //
+  if ((INTN)(QrOffset + Ctx->Size) * Factor > RegionSize) {
+    DEBUG ((DEBUG_ERROR, "Out of bounds for PIXEL Array. Factor=%d, Offset=%d, Reg=%d\n", Factor, QrOffset, RegionSize));
+    return EFI_NO_MEDIA;
+  }
+
+  for (y = 0; y < Ctx->Size; y++) {
+    Line = &Ctx->BltBuffer[(y + QrOffset) * Factor * RegionSize + QrOffset * Factor];
+
+    for (x = 0; x < Ctx->Size; x++) {
+      switch (GetModule (Ctx, y, x) & ~QrExclude) {
         case QrRsvd:
-        case QrRsvd_E:
           Color =  ColorRsvd;
           break;
         case QrWhite:
-        case QrWhite_E:
           Color =  ColorWhite;
           break;
         case QrBlack:
-        case QrBlack_E:
           Color =  ColorBlack;
           break;
-        case QrGray:
-        case QrGray_E:
-          Color =  ColorGray;
-          break;
         default:
-          Color =  ColorBad;
+          Color =  ColorGray;
           break;
       }
 
-      //
-      // The BltBuffer larger than the Bitmap buffer - Factor * each side.
-      fy = (y + QrOffset) * Factor;
-      fx = (x + QrOffset) * Factor;
-
-      //
-      //  copy Bitmap[x:y] to BltBuffer[fx:fy], but fill in BltBuffer with Factor * Factor pixels
-      //  for each single pixel in Bitmap.
-      //                                fxo = fx + QrOffset
-      //                                fyo = fy + QrOffset
-      // QrCode is centered within the Region provided, and entire region is
-      // set to white before the QrCode is written
-      for (yy = 0; (yy < Factor) && (!OutOfBounds); yy++) {
-        for (xx = 0; (xx < Factor) && (!OutOfBounds); xx++) {
-          Offset = ((fy + yy) * RegionSize) + fx + xx;
-          if (Offset >= BltBufferSize) {
-            DEBUG ((DEBUG_ERROR, "Out of bounds for PIXEL Array. y=%d, x=%d, fy=%d, fx=%d, yy=%d, xx=%d, Factor=%d, Of=%d, BltSize=%d,Reg=%d\n", y, x, fy, fx, yy, xx, Factor, Offset, BltBufferSize, RegionSize));
-            OutOfBounds = TRUE;
-          } else {
-            gBltBuffer[Offset] = Color;
-          }
-        }
-      }
-
-      if (OutOfBounds) {
-        return EFI_NO_MEDIA;
-      }
-
- #if 0
-      //
-      // The BltBuffer larger than the Bitmap buffer - Factor * each side.
-
-      fy = (y * Factor) * (BitmapLen * Factor);
-      fx = x * Factor;
-      //
-      //  copy Bitmap[x:y] to BltBuffer[fx:fy], but fill in BltBuffer with Factor * Factor pixels
-      //
-      for (yy = 0; yy < Factor; yy++) {
-        for (xx = 0; xx < Factor; xx++) {
-          Offset = fy + (yy * BitmapLen * Factor) + fx + xx;
-          if (Offset > BltBufferElements) {
-            DEBUG ((DEBUG_ERROR, "Out of bounds for PIXEL Array\n"));
-            ASSERT (FALSE);
-          }
-
-          BltBuffer[Offset] = Color;
-        }
+      for (xx = 0; xx < Factor; xx++) {
+        Line[x * Factor + xx] = Color;
       }
+    }
 
- #endif
+    for (yy = 1; yy < Factor; yy++) {
+      CopyMem (&Line[yy * RegionSize], Line, Ctx->Size * Factor * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
     }
   }
 
@@ -1881,13 +1840,14 @@ Step8_Process (
 // *----------------------------------------------------------------------------*
 // *   QrInitialize                                                             *
 // *                                                                            *
-// *   Initializes the encoder for a fixed choice of QR code, QR                *
+// *   Initializes the encoder context for a fixed choice of QR code, QR        *
 // *   Correction level, and character encoding mode.                           *
 // *                                                                            *
 // *   QR Version and Encoding mode can be set to Auto, and will be determined  *
 // *   by the data.                                                             *
 // *                                                                            *
 // *   Input:                                                                   *
+// *       Ctx                  = Encoder context                               *
 // *       Version              = Version Requested (1-40, QrAutoVersion=Auto)  *
 // *       Level                = Error Correction Level                        *
 // *       Mode                 = Character Encoding mode                       *
@@ -1904,10 +1864,11 @@ Step8_Process (
 static
 EFI_STATUS
 QrInitialize (
-  IN UINT8       Version,
-  IN QRLEVEL     Level,
-  IN QRENCODING  Mode,
-  IN UINT32      Flags
+  IN QR_ENCODER_CONTEXT  *Ctx,
+  IN UINT8               Version,
+  IN QRLEVEL             Level,
+  IN QRENCODING          Mode,
+  IN UINT32              Flags
   )
 {
   if (Version > QrMaxVersion) {
@@ -1930,12 +1891,12 @@ QrInitialize (
 
   InitializeLogTables ();
 
-  gQrVersion = Version;
-  gQrSize    = 0;
-  gQrLevel   = Level;
-  gQrMode    = Mode;
-  gQrMask    = 0;
-  gFlags     = Flags;
+  Ctx->Version = Version;
+  Ctx->Size    = 0;
+  Ctx->Level   = Level;
+  Ctx->Mode    = Mode;
+  Ctx->Mask    = 0;
+  Ctx->Flags   = Flags;
 
   return EFI_SUCCESS;
 }
@@ -1965,6 +1926,7 @@ QrInitialize (
 // *                              Data == NULL, or Datalen == 0                 *
 // *                              RegionSize too small                          *
 // *                              Bitmap == NULL, BitmapLen == NULL,            *
+// *      EFI_OUT_OF_RESOURCES  = Unable to allocate the encoder context        *
 // *----------------------------------------------------------------------------*
 EFI_STATUS
 EFIAPI
@@ -1980,24 +1942,31 @@ QrEncodeData (
   )
 {
   // Place to store the created bitmap pointer
-  EFI_STATUS  Status;
+  EFI_STATUS          Status;
+  QR_ENCODER_CONTEXT  *Ctx;
 
   if ((Data == NULL) || (DataLen == 0) || (Bitmap == NULL)) {
     DEBUG ((DEBUG_ERROR, "%a - Data == NULL, DataLen == 0, or Bitmap == NULL\n", __FUNCTION__));
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = QrInitialize (Version, Level, Mode, Flags);
+  Ctx = AllocateZeroPool (sizeof (QR_ENCODER_CONTEXT));
+  if (Ctx == NULL) {
+    DEBUG ((DEBUG_ERROR, "%a - Unable to allocate the encoder context\n", __FUNCTION__));
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = QrInitialize (Ctx, Version, Level, Mode, Flags);
 
   if (EFI_ERROR (Status)) {
-    return Status;
+    goto error_exit;
   }
 
   /*--------------------------------------------------------------------------------*/
   /* Step 1. Data Analysis                                                          */
   /*         Analyze input data to identify the characteristics of the data         */
   /*--------------------------------------------------------------------------------*/
-  Status = Step1_Process (Data, DataLen, RegionSize);
+  Status = Step1_Process (Ctx, Data, DataLen, RegionSize);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Step 1 Process error.  Code=%r\n", Status));
     goto error_exit;
@@ -2009,7 +1978,7 @@ QrEncodeData (
   /*         Convert the characters to a bit stream in accordance with the QR Code, */
   /*         the encoding mode, and the EC lavel.                                   */
   /*--------------------------------------------------------------------------------*/
-  Status = Step2_Process (Data, DataLen);
+  Status = Step2_Process (Ctx, Data, DataLen);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Step 2 Process error.  Code=%r\n", Status));
     goto error_exit;
@@ -2023,7 +1992,7 @@ QrEncodeData (
   /*         the error correction codewords for each block.                         */
   /*         the encoding mode, and the EC lavel.                                   */
   /*--------------------------------------------------------------------------------*/
-  Status = Step3_Process ();
+  Status = Step3_Process (Ctx);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Step 3 Process error.  Code=%r\n", Status));
     goto error_exit;
@@ -2036,7 +2005,7 @@ QrEncodeData (
   /*         Interleave the data and codewords from each block and add remainder    */
   /*         bits if necessary                                                      */
   /*--------------------------------------------------------------------------------*/
-  Status = Step4_Process ();
+  Status = Step4_Process (Ctx);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Step 4 Process error.  Code=%r\n", Status));
     goto error_exit;
@@ -2053,7 +2022,7 @@ QrEncodeData (
   /*         Place the alignment patterns (if required)                             */
   /*         Place the codewords into the Matrix                                    */
   /*--------------------------------------------------------------------------------*/
-  Status = Step5_Process ();
+  Status = Step5_Process (Ctx);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Step 5 Process error.  Code=%r\n", Status));
     goto error_exit;
@@ -2066,7 +2035,7 @@ QrEncodeData (
   /*         Apply the 8 data masking patterns and evaluate each pattern for quality*/
   /*         Choose the pattern with the best quality                               */
   /*--------------------------------------------------------------------------------*/
-  Status = Step6_Process ();
+  Status = Step6_Process (Ctx);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Step 6 Process error.  Code=%r\n", Status));
     goto error_exit;
@@ -2079,7 +2048,7 @@ QrEncodeData (
   /*         Generate the format information and version information and complete   */
   /*         the symbol.                                                            */
   /*--------------------------------------------------------------------------------*/
-  Status = Step7_Process ();
+  Status = Step7_Process (Ctx);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Step 7 Process error.  Code=%r\n", Status));
     goto error_exit;
@@ -2090,7 +2059,7 @@ QrEncodeData (
   /*--------------------------------------------------------------------------------*/
   /* Step 8. Build the Gop->Blt ready bitmap                                        */
   /*--------------------------------------------------------------------------------*/
-  Status = Step8_Process (RegionSize);
+  Status = Step8_Process (Ctx, RegionSize);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Step 8 Process error.  Code=%r\n", Status));
     goto error_exit;
@@ -2100,39 +2069,19 @@ QrEncodeData (
 
 error_exit:
 
-  // Free all the memory allocated - EXCEPT the returned bitmap
-
-  if (NULL != gCodeWords ) {
-    FreePool (gCodeWords);
-    gCodeWords = NULL;
-  }
-
-  if (NULL != gECWords ) {
-    FreePool (gECWords);
-    gECWords = NULL;
-  }
-
-  if (NULL != gBitStream ) {
-    FreePool (gBitStream);
-    gBitStream = NULL;
-  }
-
-  if (gQrBitmap != NULL) {
-    FreePool (gQrBitmap);
-    gQrBitmap = NULL;
-  }
+  // Free the encoder context - EXCEPT the returned bitmap
 
   if (EFI_ERROR (Status)) {
     *Bitmap = NULL;
-    if (NULL != gBltBuffer) {
-      FreePool (gBltBuffer);
-      gBltBuffer = NULL;
+    if (NULL != Ctx->BltBuffer) {
+      FreePool (Ctx->BltBuffer);
     }
   } else {
-    *Bitmap    = gBltBuffer;
-    gBltBuffer = NULL;
+    *Bitmap = Ctx->BltBuffer;
   }
 
+  FreePool (Ctx);
+
   DEBUG ((DEBUG_INFO, "QrEncode complete. Code = %r\n", Status));
 
   return Status;
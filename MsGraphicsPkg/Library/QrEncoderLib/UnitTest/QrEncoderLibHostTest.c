@@ -0,0 +1,938 @@
+/** @file
+  This module tests QrEncoderLib by reading back the QR codes it draws.  Each bitmap is
+  sampled into modules, unmasked, and split back into blocks, and the error correction
+  words and the encoded data are checked against the input.
+
+  Copyright (c) Microsoft Corporation
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifdef QR_ENCODER_LIB_HOST_BENCHMARK
+  #include <time.h>
+#endif
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/QrEncoderLib.h>
+#include <Library/UnitTestLib.h>
+#include "../QrEncoderTables.h"
+
+#define UNIT_TEST_NAME     "QrEncoderLib Host Test"
+#define UNIT_TEST_VERSION  "0.1"
+
+#define TEST_MAX_SIZE             (QrMaxVersion * 4 + 17)
+#define TEST_MAX_DATA             7089                  // Numeric capacity of version 40-L
+#define TEST_MAX_CODE_WORDS       3706
+#define TEST_PIXELS_PER_MODULE    2
+#define TEST_GF256_POLYNOMIAL     0x11D                 // ISO 18004:2015 7.5.2
+#define QR_BENCHMARK_PASSES       20
+#define QR_BENCHMARK_MODULE_SIZE  4
+
+typedef struct {
+  INTN          Size;                                   // Modules on each side of the QR code
+  QRLEVEL       Level;
+  INTN          Mask;
+  QRENCODING    Mode;
+  UINT8         Data[TEST_MAX_DATA];
+  UINTN         DataLen;
+} DECODED_QR_CODE;
+
+STATIC UINT8            mData[TEST_MAX_DATA];
+STATIC DECODED_QR_CODE  mDecoded;
+STATIC BOOLEAN          mModules[TEST_MAX_SIZE][TEST_MAX_SIZE];
+STATIC UINT8            mCodeWords[TEST_MAX_CODE_WORDS];
+STATIC UINT8            mBlocks[TEST_MAX_CODE_WORDS];
+STATIC UINT8            mExp[512];
+STATIC UINT8            mLog[256];
+
+/**
+  Builds the GF(256) tables used to check the error correction words.
+**/
+STATIC
+VOID
+TestInitGf256 (
+  VOID
+  )
+{
+  UINTN  Index;
+  UINTN  Value;
+
+  Value = 1;
+  for (Index = 0; Index < 255; Index++) {
+    mExp[Index]       = (UINT8)Value;
+    mExp[Index + 255] = (UINT8)Value;
+    mLog[Value]       = (UINT8)Index;
+    Value           <<= 1;
+    if (Value & 0x100) {
+      Value ^= TEST_GF256_POLYNOMIAL;
+    }
+  }
+}
+
+/**
+  Returns the table entry of a QR code version and error correction level.
+**/
+STATIC
+CONST QrTableEntry *
+TestTableEntry (
+  IN UINTN    Version,
+  IN QRLEVEL  Level
+  )
+{
+  return &gQrTable[(Version - 1) * 4 + Level - 1];
+}
+
+/**
+  Returns the number of characters a QR code version and level can hold in a mode.
+**/
+STATIC
+UINT16
+TestCapacity (
+  IN UINTN       Version,
+  IN QRLEVEL     Level,
+  IN QRENCODING  Mode
+  )
+{
+  CONST QrTableEntry  *QrT;
+
+  QrT = TestTableEntry (Version, Level);
+  switch (Mode) {
+    case QrNumericMode:
+      return QrT->maxNumeric;
+    case QrAlphaNumericMode:
+      return QrT->maxAlphanumeric;
+    default:
+      return QrT->maxBytes;
+  }
+}
+
+/**
+  Fills mData with Length characters that can only be encoded in Mode.
+**/
+STATIC
+VOID
+TestFillData (
+  IN QRENCODING  Mode,
+  IN UINTN       Length,
+  IN UINTN       Seed
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    switch (Mode) {
+      case QrNumericMode:
+        mData[Index] = (UINT8)('0' + (Index * 7 + Seed) % 10);
+        break;
+      case QrAlphaNumericMode:
+        mData[Index] = gAlphaNumerics[(Index * 11 + Seed) % QR_ALPHA_TABLE_SIZE];
+        break;
+      default:
+        mData[Index] = (UINT8)(Index * 37 + Seed);
+        break;
+    }
+  }
+
+  // Make sure the data needs the requested mode.
+  if (Mode == QrAlphaNumericMode) {
+    mData[0] = 'Q';
+  } else if (Mode == QrByteMode) {
+    mData[0] = 'q';
+  }
+}
+
+/**
+  Returns TRUE if the data mask pattern flips the module at Row:Column.
+**/
+STATIC
+BOOLEAN
+TestMaskBit (
+  IN INTN  Mask,
+  IN INTN  Row,
+  IN INTN  Column
+  )
+{
+  switch (Mask) {
+    case 0:
+      return ((Row + Column) % 2) == 0;
+    case 1:
+      return (Row % 2) == 0;
+    case 2:
+      return (Column % 3) == 0;
+    case 3:
+      return ((Row + Column) % 3) == 0;
+    case 4:
+      return (((Row / 2) + (Column / 3)) % 2) == 0;
+    case 5:
+      return (((Row * Column) % 2) + ((Row * Column) % 3)) == 0;
+    case 6:
+      return ((((Row * Column) % 2) + ((Row * Column) % 3)) % 2) == 0;
+    default:
+      return ((((Row + Column) % 2) + ((Row * Column) % 3)) % 2) == 0;
+  }
+}
+
+/**
+  Returns TRUE if the module at Row:Column is part of a function pattern, the format
+  information, or the version information.
+**/
+STATIC
+BOOLEAN
+TestIsFunctionModule (
+  IN INTN  Version,
+  IN INTN  Size,
+  IN INTN  Row,
+  IN INTN  Column
+  )
+{
+  CONST UINT8  *Locations;
+  INTN         i;
+  INTN         j;
+  INTN         CenterRow;
+  INTN         CenterColumn;
+
+  // Finder patterns with their separators and format information
+  if (((Row <= 8) && (Column <= 8)) || ((Row <= 8) && (Column >= Size - 8)) || ((Row >= Size - 8) && (Column <= 8))) {
+    return TRUE;
+  }
+
+  // Timing patterns
+  if ((Row == 6) || (Column == 6)) {
+    return TRUE;
+  }
+
+  // Version information
+  if ((Version >= 7) &&
+      (((Row < 6) && (Column >= Size - 11) && (Column < Size - 8)) ||
+       ((Column < 6) && (Row >= Size - 11) && (Row < Size - 8))))
+  {
+    return TRUE;
+  }
+
+  // Alignment patterns, except where they would overlap a finder pattern
+  if (Version > 1) {
+    Locations = gAlignmentLocations[Version - 2];
+    for (i = 0; (i < QR_MAX_LOCATIONS) && (Locations[i] != 0); i++) {
+      for (j = 0; (j < QR_MAX_LOCATIONS) && (Locations[j] != 0); j++) {
+        CenterRow    = Locations[i];
+        CenterColumn = Locations[j];
+        if (((CenterRow <= 8) && (CenterColumn <= 8)) ||
+            ((CenterRow <= 8) && (CenterColumn >= Size - 8)) ||
+            ((CenterRow >= Size - 8) && (CenterColumn <= 8)))
+        {
+          continue;
+        }
+
+        if ((ABS (Row - CenterRow) <= 2) && (ABS (Column - CenterColumn) <= 2)) {
+          return TRUE;
+        }
+      }
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Samples the modules of the QR code drawn in Bitmap into mModules.
+
+  @retval EFI_SUCCESS           The modules were sampled.
+  @retval EFI_COMPROMISED_DATA  The bitmap has pixels that are not black or white, or
+                                has no QR code.
+**/
+STATIC
+EFI_STATUS
+TestSampleModules (
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Bitmap,
+  IN  INTN                           RegionSize,
+  OUT INTN                           *Size
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Pixel;
+  INTN                           Index;
+  INTN                           Top;
+  INTN                           Left;
+  INTN                           Right;
+  INTN                           Factor;
+  INTN                           Row;
+  INTN                           Column;
+
+  Top  = -1;
+  Left = -1;
+  for (Index = 0; Index < RegionSize * RegionSize; Index++) {
+    Pixel = &Bitmap[Index];
+    if ((Pixel->Blue != Pixel->Green) || (Pixel->Blue != Pixel->Red) || ((Pixel->Blue != 0) && (Pixel->Blue != 0xFF))) {
+      DEBUG ((DEBUG_ERROR, "Pixel %d is not black or white\n", Index));
+      return EFI_COMPROMISED_DATA;
+    }
+
+    if ((Top < 0) && (Pixel->Blue == 0)) {
+      Top  = Index / RegionSize;
+      Left = Index % RegionSize;
+    }
+  }
+
+  if (Top < 0) {
+    return EFI_COMPROMISED_DATA;
+  }
+
+  // The top row of the upper left finder pattern is 7 modules wide.
+  for (Index = Left; (Index < RegionSize) && (Bitmap[Top * RegionSize + Index].Blue == 0); Index++) {
+  }
+
+  Factor = (Index - Left) / 7;
+
+  // The last dark pixel of the top row belongs to the upper right finder pattern.
+  for (Right = RegionSize - 1; Bitmap[Top * RegionSize + Right].Blue != 0; Right--) {
+  }
+
+  *Size = (Right - Left + 1) / Factor;
+  if ((Factor == 0) || (*Size > TEST_MAX_SIZE) || (Top + *Size * Factor > RegionSize)) {
+    return EFI_COMPROMISED_DATA;
+  }
+
+  for (Row = 0; Row < *Size; Row++) {
+    for (Column = 0; Column < *Size; Column++) {
+      mModules[Row][Column] = Bitmap[(Top + Row * Factor + Factor / 2) * RegionSize + Left + Column * Factor + Factor / 2].Blue == 0;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Reads Count bits from Words at *BitOffset.
+**/
+STATIC
+UINTN
+TestReadBits (
+  IN     UINT8  *Words,
+  IN OUT UINTN  *BitOffset,
+  IN     UINTN  Count
+  )
+{
+  UINTN  Value;
+
+  Value = 0;
+  while (Count-- > 0) {
+    Value = (Value << 1) | ((Words[*BitOffset / 8] >> (7 - *BitOffset % 8)) & 1);
+    (*BitOffset)++;
+  }
+
+  return Value;
+}
+
+/**
+  Reads the QR code drawn in Bitmap back into mDecoded.
+
+  @retval EFI_SUCCESS           The QR code was decoded.
+  @retval EFI_COMPROMISED_DATA  The QR code is not valid.
+**/
+STATIC
+EFI_STATUS
+TestDecodeQrCode (
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Bitmap,
+  IN INTN                           RegionSize
+  )
+{
+  EFI_STATUS          Status;
+  CONST QrTableEntry  *QrT;
+  INTN                Size;
+  INTN                Version;
+  UINT16              Format1;
+  UINT16              Format2;
+  INTN                i;
+  INTN                t;
+  INTN                Level;
+  INTN                Mask;
+  INTN                Right;
+  INTN                Vertical;
+  INTN                Row;
+  INTN                Column;
+  BOOLEAN             Up;
+  UINTN               TotalWords;
+  UINTN               BitOffset;
+  UINTN               Blocks;
+  UINTN               Block;
+  UINTN               BlockWords;
+  UINTN               MaxWords;
+  UINTN               Word;
+  UINTN               BlockStart;
+  UINTN               Root;
+  UINT8               Syndrome;
+  UINTN               LengthBits;
+  UINTN               Value;
+  UINTN               Index;
+
+  ZeroMem (&mDecoded, sizeof (mDecoded));
+
+  Status = TestSampleModules (Bitmap, RegionSize, &Size);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Version = (Size - 17) / 4;
+  if ((Version < QrMinVersion) || (Version > QrMaxVersion) || (Size != Version * 4 + 17)) {
+    DEBUG ((DEBUG_ERROR, "Invalid QR code size %d\n", Size));
+    return EFI_COMPROMISED_DATA;
+  }
+
+  //
+  // Both copies of the format information must name the same level and mask.
+  //
+  Format1 = 0;
+  Format2 = 0;
+  t       = 0;
+  for (i = 0; i < 8; i++) {
+    if (i == 6) {
+      t = 1;
+    }
+
+    Format1 |= (UINT16)(mModules[i + t][8] << i);
+    Format2 |= (UINT16)(mModules[8][Size - 1 - i] << i);
+  }
+
+  t = 1;
+  for (i = 0; i < 7; i++) {
+    if (i == 1) {
+      t = 0;
+    }
+
+    Format1 |= (UINT16)(mModules[8][6 - i + t] << (i + 8));
+    Format2 |= (UINT16)(mModules[Size - 7 + i][8] << (i + 8));
+  }
+
+  if (Format1 != Format2) {
+    DEBUG ((DEBUG_ERROR, "Format information copies differ %x %x\n", Format1, Format2));
+    return EFI_COMPROMISED_DATA;
+  }
+
+  for (Level = 0; Level < QR_EC_LEVELS; Level++) {
+    for (Mask = 0; Mask < QR_MASK_PATTERNS; Mask++) {
+      if (gFormatInfo[Level][Mask] == Format1) {
+        mDecoded.Level = (QRLEVEL)(Level + 1);
+        mDecoded.Mask  = Mask;
+      }
+    }
+  }
+
+  if (mDecoded.Level == 0) {
+    DEBUG ((DEBUG_ERROR, "Invalid format information %x\n", Format1));
+    return EFI_COMPROMISED_DATA;
+  }
+
+  if (!mModules[Size - 8][8]) {
+    DEBUG ((DEBUG_ERROR, "Dark module is missing\n"));
+    return EFI_COMPROMISED_DATA;
+  }
+
+  if (Version >= 7) {
+    for (i = 0; i < 18; i++) {
+      if ((mModules[Size - 11 + i % 3][i / 3] != ((gVersionInfo[Version - 7] >> i) & 1)) ||
+          (mModules[i / 3][Size - 11 + i % 3] != ((gVersionInfo[Version - 7] >> i) & 1)))
+      {
+        DEBUG ((DEBUG_ERROR, "Invalid version information\n"));
+        return EFI_COMPROMISED_DATA;
+      }
+    }
+  }
+
+  //
+  // Read the code words in module placement order, ISO 18004:2015 7.7.3
+  //
+  mDecoded.Size = Size;
+  QrT           = TestTableEntry (Version, mDecoded.Level);
+  Blocks        = QrT->group1BlockCount + QrT->group2BlockCount;
+  TotalWords    = QrT->totalWords + Blocks * QrT->ECWordsPerBlock;
+  ZeroMem (mCodeWords, sizeof (mCodeWords));
+  BitOffset = 0;
+  Up        = TRUE;
+  for (Right = Size - 1; Right >= 1; Right -= 2) {
+    if (Right == 6) {
+      Right = 5;
+    }
+
+    for (Vertical = 0; Vertical < Size; Vertical++) {
+      Row = Up ? Size - 1 - Vertical : Vertical;
+      for (Column = Right; Column >= Right - 1; Column--) {
+        if (TestIsFunctionModule (Version, Size, Row, Column) || (BitOffset >= TotalWords * 8)) {
+          continue;
+        }
+
+        if (mModules[Row][Column] != TestMaskBit (mDecoded.Mask, Row, Column)) {
+          mCodeWords[BitOffset / 8] |= (UINT8)(0x80 >> (BitOffset % 8));
+        }
+
+        BitOffset++;
+      }
+    }
+
+    Up = !Up;
+  }
+
+  if (BitOffset != TotalWords * 8) {
+    DEBUG ((DEBUG_ERROR, "QR code has room for %d bits, expected %d\n", (UINT32)BitOffset, (UINT32)(TotalWords * 8)));
+    return EFI_COMPROMISED_DATA;
+  }
+
+  //
+  // Split the interleaved code words back into blocks of data words followed by EC words,
+  // and check each block has no errors.
+  //
+  MaxWords = MAX (QrT->group1Words, QrT->group2Words);
+  // The data words of the blocks in order are the bit stream.
+  Index = 0;
+  for (Word = 0; Word < MaxWords; Word++) {
+    BlockStart = 0;
+    for (Block = 0; Block < Blocks; Block++) {
+      BlockWords = (Block < QrT->group1BlockCount) ? QrT->group1Words : QrT->group2Words;
+      if (Word < BlockWords) {
+        mBlocks[BlockStart + Word] = mCodeWords[Index++];
+      }
+
+      BlockStart += BlockWords;
+    }
+  }
+
+  BlockStart = 0;
+  for (Block = 0; Block < Blocks; Block++) {
+    BlockWords = (Block < QrT->group1BlockCount) ? QrT->group1Words : QrT->group2Words;
+    for (Root = 0; Root < QrT->ECWordsPerBlock; Root++) {
+      // The block is a code word polynomial with a root at each alpha^Root of the generator.
+      Syndrome = 0;
+      for (Word = 0; Word < BlockWords + QrT->ECWordsPerBlock; Word++) {
+        if (Syndrome != 0) {
+          Syndrome = mExp[mLog[Syndrome] + Root];
+        }
+
+        if (Word < BlockWords) {
+          Syndrome ^= mBlocks[BlockStart + Word];
+        } else {
+          Syndrome ^= mCodeWords[QrT->totalWords + (Word - BlockWords) * Blocks + Block];
+        }
+      }
+
+      if (Syndrome != 0) {
+        DEBUG ((DEBUG_ERROR, "Block %d has an error\n", (UINT32)Block));
+        return EFI_COMPROMISED_DATA;
+      }
+    }
+
+    BlockStart += BlockWords;
+  }
+
+  //
+  // Parse the data segment.
+  //
+  BitOffset = 0;
+  Value     = TestReadBits (mBlocks, &BitOffset, 4);
+  switch (Value) {
+    case 1:
+      mDecoded.Mode = QrNumericMode;
+      LengthBits    = (Version <= 9) ? 10 : ((Version <= 26) ? 12 : 14);
+      break;
+    case 2:
+      mDecoded.Mode = QrAlphaNumericMode;
+      LengthBits    = (Version <= 9) ? 9 : ((Version <= 26) ? 11 : 13);
+      break;
+    case 4:
+      mDecoded.Mode = QrByteMode;
+      LengthBits    = (Version <= 9) ? 8 : 16;
+      break;
+    default:
+      DEBUG ((DEBUG_ERROR, "Invalid mode indicator %d\n", (UINT32)Value));
+      return EFI_COMPROMISED_DATA;
+  }
+
+  mDecoded.DataLen = TestReadBits (mBlocks, &BitOffset, LengthBits);
+  if (mDecoded.DataLen > TEST_MAX_DATA) {
+    return EFI_COMPROMISED_DATA;
+  }
+
+  for (Index = 0; Index < mDecoded.DataLen;) {
+    switch (mDecoded.Mode) {
+      case QrNumericMode:
+        if (mDecoded.DataLen - Index >= 3) {
+          Value                  = TestReadBits (mBlocks, &BitOffset, 10);
+          mDecoded.Data[Index++] = (UINT8)('0' + Value / 100);
+          mDecoded.Data[Index++] = (UINT8)('0' + (Value / 10) % 10);
+          mDecoded.Data[Index++] = (UINT8)('0' + Value % 10);
+        } else if (mDecoded.DataLen - Index == 2) {
+          Value                  = TestReadBits (mBlocks, &BitOffset, 7);
+          mDecoded.Data[Index++] = (UINT8)('0' + Value / 10);
+          mDecoded.Data[Index++] = (UINT8)('0' + Value % 10);
+        } else {
+          Value                  = TestReadBits (mBlocks, &BitOffset, 4);
+          mDecoded.Data[Index++] = (UINT8)('0' + Value);
+        }
+
+        break;
+      case QrAlphaNumericMode:
+        if (mDecoded.DataLen - Index >= 2) {
+          Value                  = TestReadBits (mBlocks, &BitOffset, 11);
+          mDecoded.Data[Index++] = gAlphaNumerics[(Value / 45) % QR_ALPHA_TABLE_SIZE];
+          mDecoded.Data[Index++] = gAlphaNumerics[Value % 45];
+        } else {
+          Value                  = TestReadBits (mBlocks, &BitOffset, 6);
+          mDecoded.Data[Index++] = gAlphaNumerics[Value % QR_ALPHA_TABLE_SIZE];
+        }
+
+        break;
+      default:
+        mDecoded.Data[Index++] = (UINT8)TestReadBits (mBlocks, &BitOffset, 8);
+        break;
+    }
+
+    if (BitOffset > QrT->totalWords * 8) {
+      DEBUG ((DEBUG_ERROR, "Data runs past the data words\n"));
+      return EFI_COMPROMISED_DATA;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Encodes the first DataLen bytes of mData and decodes the QR code into mDecoded.
+
+  @retval EFI_SUCCESS           The QR code decoded.
+  @retval Others                The encode failed, or the QR code did not decode.
+**/
+STATIC
+EFI_STATUS
+TestEncodeAndDecode (
+  IN UINT8       Version,
+  IN QRLEVEL     Level,
+  IN QRENCODING  Mode,
+  IN UINT32      Flags,
+  IN UINT16      DataLen
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Bitmap;
+  INTN                           RegionSize;
+
+  // Leave some room in the region to check the QR code is found where it is centered.
+  RegionSize = (TEST_MAX_SIZE + 2 * QR_QUIET_ZONE) * TEST_PIXELS_PER_MODULE + 3;
+  Status     = QrEncodeData (Version, Level, Mode, Flags, mData, DataLen, RegionSize, &Bitmap);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = TestDecodeQrCode (Bitmap, RegionSize);
+  FreePool (Bitmap);
+  return Status;
+}
+
+/**
+  Every version, level, and mode encodes a QR code holding as much data as the version
+  allows, which reads back to the data.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestEncodeAllVersions (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       Version;
+  QRLEVEL     Level;
+  QRENCODING  Mode;
+  UINT16      DataLen;
+
+  for (Version = QrMinVersion; Version <= QrMaxVersion; Version++) {
+    for (Level = QrECLevel_L; Level <= QrECLevel_H; Level++) {
+      for (Mode = QrNumericMode; Mode <= QrByteMode; Mode++) {
+        DataLen = TestCapacity (Version, Level, Mode);
+        TestFillData (Mode, DataLen, Version);
+        Status = TestEncodeAndDecode (Version, Level, Mode, 0, DataLen);
+        UT_ASSERT_NOT_EFI_ERROR (Status);
+        UT_ASSERT_EQUAL (mDecoded.Size, Version * 4 + 17);
+        UT_ASSERT_EQUAL (mDecoded.Level, Level);
+        UT_ASSERT_EQUAL (mDecoded.Mode, Mode);
+        UT_ASSERT_EQUAL (mDecoded.DataLen, DataLen);
+        UT_ASSERT_MEM_EQUAL (mDecoded.Data, mData, DataLen);
+      }
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Auto version and mode pick the smallest version and mode that hold the data.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestAutoVersionAndMode (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       Version;
+  QRENCODING  Mode;
+  UINT16      DataLen;
+
+  for (Version = QrMinVersion; Version <= QrMaxVersion; Version++) {
+    for (Mode = QrNumericMode; Mode <= QrByteMode; Mode++) {
+      DataLen = TestCapacity (Version, QrECLevel_M, Mode);
+      TestFillData (Mode, DataLen, Version);
+      Status = TestEncodeAndDecode (QrAutoVersion, QrECLevel_M, QrAutoMode, 0, DataLen);
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      UT_ASSERT_EQUAL (mDecoded.Size, Version * 4 + 17);
+      UT_ASSERT_EQUAL (mDecoded.Mode, Mode);
+      UT_ASSERT_MEM_EQUAL (mDecoded.Data, mData, DataLen);
+
+      if (Version < QrMaxVersion) {
+        TestFillData (Mode, DataLen + 1, Version);
+        Status = TestEncodeAndDecode (QrAutoVersion, QrECLevel_M, QrAutoMode, 0, DataLen + 1);
+        UT_ASSERT_NOT_EFI_ERROR (Status);
+        UT_ASSERT_EQUAL (mDecoded.Size, (Version + 1) * 4 + 17);
+      }
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  QR_FLAGS_MASK_SEL selects the mask pattern, and every mask pattern reads back.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestSelectedMask (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS   Status;
+  CONST UINT8  Versions[] = { 1, 2, 7, 21, 40 };
+  UINTN        Index;
+  UINT32       Mask;
+  UINT16       DataLen;
+
+  for (Index = 0; Index < ARRAY_SIZE (Versions); Index++) {
+    for (Mask = 0; Mask < QR_MASK_PATTERNS; Mask++) {
+      DataLen = TestCapacity (Versions[Index], QrECLevel_Q, QrByteMode);
+      TestFillData (QrByteMode, DataLen, Mask);
+      Status = TestEncodeAndDecode (Versions[Index], QrECLevel_Q, QrByteMode, QR_FLAGS_MASK_SEL | Mask, DataLen);
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      UT_ASSERT_EQUAL (mDecoded.Mask, Mask);
+      UT_ASSERT_MEM_EQUAL (mDecoded.Data, mData, DataLen);
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Encoding a QR code does not depend on the QR codes encoded before it.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestEncodeIsRepeatable (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *First;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Other;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Second;
+  INTN                           RegionSize;
+  UINT8                          Small[] = "HTTPS://AKA.MS/";
+
+  RegionSize = 200;
+  TestFillData (QrByteMode, 100, 1);
+  Status = QrEncodeData (QrAutoVersion, QrECLevel_L, QrAutoMode, 0, mData, 100, RegionSize, &First);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = QrEncodeData (QrAutoVersion, QrECLevel_H, QrAutoMode, 0, Small, sizeof (Small) - 1, RegionSize, &Other);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = QrEncodeData (QrAutoVersion, QrECLevel_L, QrAutoMode, 0, mData, 100, RegionSize, &Second);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  UT_ASSERT_MEM_EQUAL (First, Second, RegionSize * RegionSize * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+
+  FreePool (First);
+  FreePool (Other);
+  FreePool (Second);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Invalid requests fail without returning a bitmap.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestInvalidParameters (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Bitmap;
+  UINT8                          Text[] = "QR CODE";
+
+  Bitmap = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)Text;
+  UT_ASSERT_STATUS_EQUAL (QrEncodeData (QrAutoVersion, QrECLevel_M, QrAutoMode, 0, NULL, 7, 200, &Bitmap), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (QrEncodeData (QrAutoVersion, QrECLevel_M, QrAutoMode, 0, Text, 0, 200, &Bitmap), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (QrEncodeData (QrAutoVersion, QrECLevel_M, QrAutoMode, 0, Text, 7, 200, NULL), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (QrEncodeData (QrMaxVersion + 1, QrECLevel_M, QrAutoMode, 0, Text, 7, 200, &Bitmap), EFI_INVALID_PARAMETER);
+  UT_ASSERT_NULL (Bitmap);
+
+  Bitmap = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)Text;
+  UT_ASSERT_STATUS_EQUAL (QrEncodeData (QrAutoVersion, 0, QrAutoMode, 0, Text, 7, 200, &Bitmap), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (QrEncodeData (QrAutoVersion, QrECLevel_M, QrNumericMode, 0, Text, 7, 200, &Bitmap), EFI_INVALID_PARAMETER);
+  UT_ASSERT_NULL (Bitmap);
+
+  // Version 1 is 21 modules, plus a 4 module quiet zone on each side.
+  Bitmap = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)Text;
+  UT_ASSERT_STATUS_EQUAL (QrEncodeData (1, QrECLevel_M, QrAutoMode, 0, Text, 7, 28, &Bitmap), EFI_INVALID_PARAMETER);
+  UT_ASSERT_NULL (Bitmap);
+  UT_ASSERT_NOT_EFI_ERROR (QrEncodeData (1, QrECLevel_M, QrAutoMode, 0, Text, 7, 29, &Bitmap));
+  UT_ASSERT_NOT_NULL (Bitmap);
+  FreePool (Bitmap);
+
+  // Too much data for the version requested
+  TestFillData (QrByteMode, TestCapacity (1, QrECLevel_M, QrByteMode) + 1, 0);
+  Bitmap = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)Text;
+  UT_ASSERT_STATUS_EQUAL (QrEncodeData (1, QrECLevel_M, QrByteMode, 0, mData, TestCapacity (1, QrECLevel_M, QrByteMode) + 1, 200, &Bitmap), EFI_INVALID_PARAMETER);
+  UT_ASSERT_NULL (Bitmap);
+
+  return UNIT_TEST_PASSED;
+}
+
+#ifdef QR_ENCODER_LIB_HOST_BENCHMARK
+
+/**
+  Time encoding a full QR code of each version.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+BenchmarkEncodeAllVersions (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Bitmap;
+  UINT8                          Version;
+  UINT16                         DataLen;
+  INTN                           RegionSize;
+  UINTN                          Pass;
+  clock_t                        Start;
+  UINT64                         Microseconds;
+  UINT64                         TotalMicroseconds;
+
+  TotalMicroseconds = 0;
+  for (Version = QrMinVersion; Version <= QrMaxVersion; Version++) {
+    DataLen    = TestCapacity (Version, QrECLevel_M, QrByteMode);
+    RegionSize = (Version * 4 + 17 + 2 * QR_QUIET_ZONE) * QR_BENCHMARK_MODULE_SIZE;
+    TestFillData (QrByteMode, DataLen, Version);
+
+    Start = clock ();
+    for (Pass = 0; Pass < QR_BENCHMARK_PASSES; Pass++) {
+      Status = QrEncodeData (Version, QrECLevel_M, QrByteMode, 0, mData, DataLen, RegionSize, &Bitmap);
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      FreePool (Bitmap);
+    }
+
+    Microseconds       = (UINT64)(clock () - Start) * 1000000 / CLOCKS_PER_SEC / QR_BENCHMARK_PASSES;
+    TotalMicroseconds += Microseconds;
+    UT_LOG_INFO ("QrEncodeData version %d-M, %d bytes: %ld us\n", Version, DataLen, Microseconds);
+  }
+
+  UT_LOG_INFO ("QrEncodeData versions 1-40: %ld us\n", TotalMicroseconds);
+
+  return UNIT_TEST_PASSED;
+}
+
+#endif
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  QR encoder and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UefiTestMain (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      EncodeSuiteHandle;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  TestInitGf256 ();
+
+  //
+  // Create a suite
+  //
+  Status = CreateUnitTestSuite (&EncodeSuiteHandle, Framework, "QrEncoderLib Encode", "QrEncoderLib.Encode", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for EncodeSuiteHandle\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // Register Tests
+  //
+  AddTestCase (EncodeSuiteHandle, "Every version, level, and mode reads back", "AllVersions", TestEncodeAllVersions, NULL, NULL, NULL);
+  AddTestCase (EncodeSuiteHandle, "Auto version and mode pick the smallest that fits", "AutoVersion", TestAutoVersionAndMode, NULL, NULL, NULL);
+  AddTestCase (EncodeSuiteHandle, "Selected mask patterns are used", "SelectedMask", TestSelectedMask, NULL, NULL, NULL);
+  AddTestCase (EncodeSuiteHandle, "Encoding does not depend on earlier encodes", "Repeatable", TestEncodeIsRepeatable, NULL, NULL, NULL);
+  AddTestCase (EncodeSuiteHandle, "Invalid requests fail", "InvalidParameters", TestInvalidParameters, NULL, NULL, NULL);
+ #ifdef QR_ENCODER_LIB_HOST_BENCHMARK
+  AddTestCase (EncodeSuiteHandle, "Time encoding each version", "Benchmark", BenchmarkEncodeAllVersions, NULL, NULL, NULL);
+ #endif
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UefiTestMain ();
+}
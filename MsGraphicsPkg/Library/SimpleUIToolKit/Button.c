@@ -24,8 +24,6 @@ RenderButton (
 {
   EFI_STATUS                     Status = EFI_SUCCESS;
   UINTN                          Width, Height;
-  EFI_FONT_DISPLAY_INFO          *StringInfo = NULL;
-  EFI_IMAGE_OUTPUT               *pBltBuffer = NULL;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *pTextColor;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *pFillColor;
 
@@ -55,29 +53,6 @@ RenderButton (
       break;
   }
 
-  StringInfo = BuildFontDisplayInfoFromFontInfo (this->m_FontInfo);
-  if (NULL == StringInfo) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  CopyMem (&StringInfo->BackgroundColor, pFillColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-  CopyMem (&StringInfo->ForegroundColor, pTextColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-
-  // Prepare string blitting buffer.
-  //
-  pBltBuffer = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
-  ASSERT (pBltBuffer != NULL);
-
-  if (NULL == pBltBuffer) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  pBltBuffer->Width        = (UINT16)mUITGop->Mode->Info->HorizontalResolution;
-  pBltBuffer->Height       = (UINT16)mUITGop->Mode->Info->VerticalResolution;
-  pBltBuffer->Image.Screen = mUITGop;
-
   // Compute button width and height.
   //
   Width  = SWM_RECT_WIDTH (this->m_pButton->ButtonBounds);
@@ -129,37 +104,22 @@ RenderButton (
       );
   }
 
-  // Draw button text.
-  //
-  // Select preferred font size and style for the button (smaller, normal font).
+  // Draw button text.  The text is clipped to the screen and drawn on the button's fill color.  Buttons are redrawn with the same
+  // text each time their state changes, so the rendered text is cached.
   //
-  StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
-
-  mUITSWM->StringToWindow (
-             mUITSWM,
-             mClientImageHandle,
-             EFI_HII_OUT_FLAG_CLIP |
-             EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
-             EFI_HII_IGNORE_LINE_BREAK | EFI_HII_DIRECT_TO_SCREEN,
-             this->m_pButton->pButtonText,
-             StringInfo,
-             &pBltBuffer,
-             this->m_pButton->ButtonTextBounds.Left,
-             this->m_pButton->ButtonTextBounds.Top,
-             NULL,
-             NULL,
-             NULL
-             );
-
-Exit:
-
-  if (NULL != StringInfo) {
-    FreePool (StringInfo);
-  }
-
-  if (NULL != pBltBuffer) {
-    FreePool (pBltBuffer);
-  }
+  DrawTextString (
+    this->m_pButton->pButtonText,
+    this->m_FontInfo,
+    EFI_HII_OUT_FLAG_CLIP |
+    EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
+    EFI_HII_IGNORE_LINE_BREAK,
+    pTextColor,
+    pFillColor,
+    this->m_pButton->ButtonTextBounds.Left,
+    this->m_pButton->ButtonTextBounds.Top,
+    (mUITGop->Mode->Info->HorizontalResolution - this->m_pButton->ButtonTextBounds.Left),
+    (mUITGop->Mode->Info->VerticalResolution - this->m_pButton->ButtonTextBounds.Top)
+    );
 
   return Status;
 }
@@ -30,7 +30,6 @@ RenderEditBox (
   EFI_STATUS                     Status = EFI_SUCCESS;
   UINTN                          Width, Height;
   EFI_FONT_DISPLAY_INFO          *StringInfo = NULL;
-  EFI_IMAGE_OUTPUT               *BltBuffer  = NULL;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *TextColor;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *FillColor;
 
@@ -65,20 +64,6 @@ RenderEditBox (
   CopyMem (&StringInfo->BackgroundColor, FillColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
   CopyMem (&StringInfo->ForegroundColor, TextColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
 
-  // Prepare the string blitting buffer.
-  //
-  BltBuffer = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
-
-  ASSERT (BltBuffer != NULL);
-  if (NULL == BltBuffer) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  BltBuffer->Width        = (UINT16)mUITGop->Mode->Info->HorizontalResolution;
-  BltBuffer->Height       = (UINT16)mUITGop->Mode->Info->VerticalResolution;
-  BltBuffer->Image.Screen = mUITGop;
-
   // Compute editbox width and height.
   //
   Width  = SWM_RECT_WIDTH (this->m_EditBoxBounds);
@@ -104,10 +89,6 @@ RenderEditBox (
   // enough for the watermark text as well.
   //
   if (0 == this->m_CurrentPosition) {
-    // Select preferred font size and style for the watermark text.
-    //
-    StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
-
     // Override text color and font for watermark.
     //
     if (this->m_State != GRAYED) {
@@ -119,42 +100,35 @@ RenderEditBox (
       StringInfo->FontInfo.FontSize = MsUiGetSmallFontHeight ();         // TODO
     }
 
-    mUITSWM->StringToWindow (
-               mUITSWM,
-               mClientImageHandle,
-               EFI_HII_OUT_FLAG_CLIP |
-               EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
-               EFI_HII_IGNORE_LINE_BREAK | EFI_HII_DIRECT_TO_SCREEN,
-               this->m_EditBoxWatermarkText,
-               StringInfo,
-               &BltBuffer,
-               this->m_EditBoxTextBounds.Left,
-               this->m_EditBoxTextBounds.Top,
-               NULL,
-               NULL,
-               NULL
-               );
+    DrawTextString (
+      this->m_EditBoxWatermarkText,
+      &StringInfo->FontInfo,
+      EFI_HII_OUT_FLAG_CLIP |
+      EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
+      EFI_HII_IGNORE_LINE_BREAK,
+      &StringInfo->ForegroundColor,
+      &StringInfo->BackgroundColor,
+      this->m_EditBoxTextBounds.Left,
+      this->m_EditBoxTextBounds.Top,
+      (mUITGop->Mode->Info->HorizontalResolution - this->m_EditBoxTextBounds.Left),
+      (mUITGop->Mode->Info->VerticalResolution - this->m_EditBoxTextBounds.Top)
+      );
   } else {
     // Draw editbox text.
     //
-    // Select preferred font size and style for the editbox text.
-    StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
-
-    mUITSWM->StringToWindow (
-               mUITSWM,
-               mClientImageHandle,
-               EFI_HII_OUT_FLAG_CLIP |
-               EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
-               EFI_HII_IGNORE_LINE_BREAK | EFI_HII_DIRECT_TO_SCREEN,
-               &this->m_EditBoxDisplayText[this->m_DisplayStartPosition],
-               StringInfo,
-               &BltBuffer,
-               this->m_EditBoxTextBounds.Left,
-               this->m_EditBoxTextBounds.Top,
-               NULL,
-               NULL,
-               NULL
-               );
+    DrawTextString (
+      &this->m_EditBoxDisplayText[this->m_DisplayStartPosition],
+      &StringInfo->FontInfo,
+      EFI_HII_OUT_FLAG_CLIP |
+      EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
+      EFI_HII_IGNORE_LINE_BREAK,
+      &StringInfo->ForegroundColor,
+      &StringInfo->BackgroundColor,
+      this->m_EditBoxTextBounds.Left,
+      this->m_EditBoxTextBounds.Top,
+      (mUITGop->Mode->Info->HorizontalResolution - this->m_EditBoxTextBounds.Left),
+      (mUITGop->Mode->Info->VerticalResolution - this->m_EditBoxTextBounds.Top)
+      );
   }
 
   if ((TRUE == DrawHighlight) && (this->m_Type == UIT_EDITBOX_TYPE_SELECTABLE)) {
@@ -172,10 +146,6 @@ Exit:
 
   // Clean up.
   //
-  if (NULL != BltBuffer) {
-    FreePool (BltBuffer);
-  }
-
   if (NULL != StringInfo) {
     FreePool (StringInfo);
   }
@@ -66,64 +66,22 @@ RenderLabel (
   IN Label  *this
   )
 {
-  EFI_STATUS             Status       = EFI_SUCCESS;
-  EFI_FONT_DISPLAY_INFO  *StringInfo  = NULL;
-  EFI_IMAGE_OUTPUT       *BltBuffer   = NULL;
-  SWM_RECT               *LabelBounds = &this->m_pLabel->LabelBoundsCurrent;
+  SWM_RECT  *LabelBounds = &this->m_pLabel->LabelBoundsCurrent;
 
-  // Prepare string blitting buffer.
+  // The text wraps at the label bounding box limit and is clipped to the current label bounding box.  Labels are redrawn with the
+  // same text, so the rendered text is cached.
   //
-  BltBuffer = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
-
-  ASSERT (NULL != BltBuffer);
-  if (NULL == BltBuffer) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  // The blitting buffer should describe current label bounding box limits in order to wrap as specified.
-  //
-  // BltBuffer->Width        = (UINT16)LabelBounds->Right;
-  BltBuffer->Width        = (UINT16)this->m_pLabel->LabelBoundsLimit.Right +1;         // TODO
-  BltBuffer->Height       = (UINT16)LabelBounds->Bottom + 1;
-  BltBuffer->Image.Screen = mUITGop;
-
-  StringInfo = BuildFontDisplayInfoFromFontInfo (this->m_FontInfo);
-  if (NULL == StringInfo) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  StringInfo->ForegroundColor = this->m_TextColor;
-  StringInfo->BackgroundColor = this->m_BackgroundColor;
-
-  StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
-
-  mUITSWM->StringToWindow (
-             mUITSWM,
-             mClientImageHandle,
-             EFI_HII_OUT_FLAG_WRAP | EFI_HII_DIRECT_TO_SCREEN,
-             this->m_pLabel->pLabelText,
-             StringInfo,
-             &BltBuffer,
-             LabelBounds->Left,
-             LabelBounds->Top,
-             NULL,
-             NULL,
-             NULL
-             );
-
-Exit:
-
-  if (NULL != BltBuffer) {
-    FreePool (BltBuffer);
-  }
-
-  if (NULL != StringInfo) {
-    FreePool (StringInfo);
-  }
-
-  return Status;
+  return DrawTextString (
+           this->m_pLabel->pLabelText,
+           this->m_FontInfo,
+           EFI_HII_OUT_FLAG_WRAP,
+           &this->m_TextColor,
+           &this->m_BackgroundColor,
+           LabelBounds->Left,
+           LabelBounds->Top,
+           (this->m_pLabel->LabelBoundsLimit.Right + 1 - LabelBounds->Left),
+           SWM_RECT_HEIGHT (*LabelBounds)
+           );
 }
 
 static
@@ -159,9 +159,8 @@ RenderCellTrashcan (
   CHAR16                         TrashcanString[] = { (CHAR16)0xE107, 0x00 };
   EFI_STRING                     Trashcan         = (EFI_STRING)&TrashcanString;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *pFillColor;
-  EFI_IMAGE_OUTPUT               *pBltBuffer = NULL;
-  UINTN                          Left;
-  UINTN                          Top;
+  UINT32                         Left;
+  UINT32                         Top;
 
   if (!this->m_pCells[CellIndex].TrashcanEnabled) {
     return EFI_SUCCESS;
@@ -190,43 +189,26 @@ RenderCellTrashcan (
 
   CopyMem (&StringInfo->BackgroundColor, pFillColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
 
-  StringInfo->FontInfoMask      = EFI_FONT_INFO_ANY_FONT;
   StringInfo->FontInfo.FontSize = MsUiGetLargeFontHeight ();
 
-  // Prepare string blitting buffer.
-  //
-  pBltBuffer = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
-  ASSERT (pBltBuffer != NULL);
-
-  if (NULL == pBltBuffer) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  pBltBuffer->Width        = (UINT16)mUITGop->Mode->Info->HorizontalResolution;
-  pBltBuffer->Height       = (UINT16)mUITGop->Mode->Info->VerticalResolution;
-  pBltBuffer->Image.Screen = mUITGop;
-
   Left = this->m_pCells[CellIndex].CellTrashcanBounds.Left +
          (SWM_RECT_WIDTH (this->m_pCells[CellIndex].CellTrashcanBounds) -  MsUiGetLargeFontWidth ()) / 2;
   Top = this->m_pCells[CellIndex].CellTrashcanBounds.Top +
         (SWM_RECT_HEIGHT (this->m_pCells[CellIndex].CellTrashcanBounds) -  MsUiGetLargeFontHeight ()) / 2;
 
-  Status = mUITSWM->StringToWindow (
-                      mUITSWM,
-                      mClientImageHandle,
-                      EFI_HII_DIRECT_TO_SCREEN,
-                      Trashcan,
-                      StringInfo,
-                      &pBltBuffer,
-                      Left,
-                      Top,
-                      NULL,
-                      NULL,
-                      NULL
-                      );
+  Status = DrawTextString (
+             Trashcan,
+             &StringInfo->FontInfo,
+             0,
+             &StringInfo->ForegroundColor,
+             &StringInfo->BackgroundColor,
+             Left,
+             Top,
+             (mUITGop->Mode->Info->HorizontalResolution - Left),
+             (mUITGop->Mode->Info->VerticalResolution - Top)
+             );
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "StringToWindow error %r\n", Status));
+    DEBUG ((DEBUG_ERROR, "DrawTextString error %r\n", Status));
   }
 
 Exit:
@@ -235,10 +217,6 @@ Exit:
     FreePool (StringInfo);
   }
 
-  if (NULL != pBltBuffer) {
-    FreePool (pBltBuffer);
-  }
-
   return EFI_SUCCESS;
 }
 
@@ -298,7 +276,6 @@ RenderCell (
 {
   EFI_STATUS                     Status      = EFI_SUCCESS;
   EFI_FONT_DISPLAY_INFO          *StringInfo = NULL;
-  EFI_IMAGE_OUTPUT               *pBltBuffer = NULL;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *pFillColor;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *pCellRingColor;
 
@@ -396,49 +373,27 @@ RenderCell (
     RenderCellTrashcan (this, CellIndex);
   }
 
-  // Prepare string blitting buffer.
-  //
-  pBltBuffer = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
-  ASSERT (pBltBuffer != NULL);
-
-  if (NULL == pBltBuffer) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  pBltBuffer->Width        = (UINT16)mUITGop->Mode->Info->HorizontalResolution;
-  pBltBuffer->Height       = (UINT16)mUITGop->Mode->Info->VerticalResolution;
-  pBltBuffer->Image.Screen = mUITGop;
-
-  StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
-
   // TODO - for checkbox type listbox cells, how to handle text indent - indent checkbox as well?  For now
   // we keep the checkbox left-justified in the cell and the caller-specified text indent value affects the cell text only.
 
   // Draw cell text.
   //
-  mUITSWM->StringToWindow (
-             mUITSWM,
-             mClientImageHandle,
-             EFI_HII_OUT_FLAG_CLIP |
-             EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
-             EFI_HII_IGNORE_LINE_BREAK | EFI_HII_DIRECT_TO_SCREEN,
-             pCell->pCellText,
-             StringInfo,
-             &pBltBuffer,
-             pCell->CellTextBounds.Left,
-             pCell->CellTextBounds.Top,
-             NULL,
-             NULL,
-             NULL
-             );
+  DrawTextString (
+    pCell->pCellText,
+    this->m_FontInfo,
+    EFI_HII_OUT_FLAG_CLIP |
+    EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
+    EFI_HII_IGNORE_LINE_BREAK,
+    &StringInfo->ForegroundColor,
+    &StringInfo->BackgroundColor,
+    pCell->CellTextBounds.Left,
+    pCell->CellTextBounds.Top,
+    (mUITGop->Mode->Info->HorizontalResolution - pCell->CellTextBounds.Left),
+    (mUITGop->Mode->Info->VerticalResolution - pCell->CellTextBounds.Top)
+    );
 
 Exit:
 
-  if (NULL != pBltBuffer) {
-    FreePool (pBltBuffer);
-  }
-
   if (NULL != StringInfo) {
     FreePool (StringInfo);
   }
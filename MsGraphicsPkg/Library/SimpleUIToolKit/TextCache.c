@@ -0,0 +1,773 @@
+/** @file
+
+  Implements the Simple UI Toolkit text measurement and rendered text caches.
+
+  Controls measure their text when they are laid out and render the same text each time they
+  are drawn.  Both results only depend on the string, the font, the HII flags and the area the
+  text is limited to, so they are cached to avoid rendering the text again.  Text is measured
+  from the metrics of its glyphs, which are measured once per font, so measuring text never
+  renders it.
+
+Copyright (C) Microsoft Corporation. All rights reserved.
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "SimpleUIToolKitInternal.h"
+
+// ****** Preprocessor constants ******
+//
+#define UIT_TEXT_METRICS_CACHE_SIZE   128                 // Number of text measurements cached.
+#define UIT_TEXT_RUN_CACHE_SIZE       32                  // Number of rendered text bitmaps cached.
+#define UIT_TEXT_RUN_MAX_PIXELS       (64 * 1024)         // Largest rendered text bitmap cached (256KB).
+#define UIT_GLYPH_FONT_CACHE_SIZE     8                   // Number of fonts glyph metrics are cached for.
+#define UIT_GLYPH_METRICS_CACHE_SIZE  1024                // Number of glyph measurements cached.
+#define UIT_TEXT_NO_BREAK             MAX_UINTN           // The row has no line break opportunity.
+#define UIT_TEXT_HASH_SEED            0x811C9DC5          // FNV-1a offset basis.
+#define UIT_TEXT_HASH_PRIME           0x01000193          // FNV-1a prime.
+
+// ****** Typedefs and structures ******
+//
+typedef struct {
+  UINT32               Hash;                              // Hash of all of the members below.
+  CHAR16               *String;                           // Copy of the string, NULL if the entry is unused.
+  EFI_FONT_INFO        *FontInfo;                         // Copy of the font information.
+  EFI_HII_OUT_FLAGS    HiiFlags;
+  UINT32               MaxWidth;                          // Width the text is wrapped or clipped to.
+  UINT32               MaxHeight;                         // Height the text is clipped to.
+} UIT_TEXT_KEY;
+
+typedef struct {
+  UIT_TEXT_KEY    Key;
+  UINT32          Width;                                  // Width of the text as rendered.
+  UINT32          Height;                                 // Height of the text as rendered.
+} UIT_TEXT_METRICS_ENTRY;
+
+typedef struct {
+  UIT_TEXT_KEY                     Key;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    TextColor;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    BackgroundColor;
+  UINT32                           Width;
+  UINT32                           Height;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *Bitmap;               // Width x Height bitmap of the rendered text.
+} UIT_TEXT_RUN_ENTRY;
+
+typedef struct {
+  UINT8      Font;                                        // Index of the font in mGlyphFonts plus one, 0 if the entry is unused.
+  BOOLEAN    IgnoreIfNoGlyph;                             // Measured with EFI_HII_IGNORE_IF_NO_GLYPH.
+  CHAR16     Char;
+  UINT16     Width;                                       // Width the glyph advances its row by.
+  UINT16     Height;                                      // Height of a row holding the glyph.
+} UIT_GLYPH_METRICS_ENTRY;
+
+// ****** Global variables ******
+//
+STATIC UIT_TEXT_METRICS_ENTRY   mTextMetricsCache[UIT_TEXT_METRICS_CACHE_SIZE];
+STATIC UIT_TEXT_RUN_ENTRY       mTextRunCache[UIT_TEXT_RUN_CACHE_SIZE];
+STATIC EFI_FONT_INFO            *mGlyphFonts[UIT_GLYPH_FONT_CACHE_SIZE];      // Fonts glyphs have been measured with.
+STATIC UINTN                    mGlyphFontNext = 0;                           // Font replaced when another font is measured.
+STATIC UIT_GLYPH_METRICS_ENTRY  mGlyphMetricsCache[UIT_GLYPH_METRICS_CACHE_SIZE];
+
+// ****** Function declarations ******
+//
+
+static
+UINT32
+HashBytes (
+  IN UINT32  Hash,
+  IN VOID    *Buffer,
+  IN UINTN   Length
+  )
+{
+  UINT8  *Bytes = (UINT8 *)Buffer;
+  UINTN  Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    Hash = (Hash ^ Bytes[Index]) * UIT_TEXT_HASH_PRIME;
+  }
+
+  return Hash;
+}
+
+static
+UINTN
+FontNameLength (
+  IN EFI_FONT_INFO  *FontInfo
+  )
+{
+  UINTN  Length;
+
+  // Match the font name size DupFontInfo copies.
+  //
+  Length = StrnLenS (FontInfo->FontName, MAX_FONT_NAME_SIZE);
+  if ((Length * sizeof (CHAR16)) > MAX_FONT_NAME_SIZE) {
+    Length = 0;
+  }
+
+  return Length;
+}
+
+static
+BOOLEAN
+FontInfoMatches (
+  IN EFI_FONT_INFO  *Entry,
+  IN EFI_FONT_INFO  *FontInfo
+  )
+{
+  UINTN  NameLength;
+
+  if ((Entry->FontStyle != FontInfo->FontStyle) ||
+      (Entry->FontSize != FontInfo->FontSize))
+  {
+    return FALSE;
+  }
+
+  NameLength = FontNameLength (FontInfo);
+
+  return (BOOLEAN)((FontNameLength (Entry) == NameLength) &&
+                   ((0 == NameLength) || (0 == StrnCmp (Entry->FontName, FontInfo->FontName, NameLength))));
+}
+
+static
+VOID
+InitTextKey (
+  OUT UIT_TEXT_KEY       *Key,
+  IN  CHAR16             *pString,
+  IN  EFI_FONT_INFO      *FontInfo,
+  IN  EFI_HII_OUT_FLAGS  HiiFlags,
+  IN  UINT32             MaxWidth,
+  IN  UINT32             MaxHeight
+  )
+{
+  UINT32  Hash = UIT_TEXT_HASH_SEED;
+
+  // The key points to the caller's string and font until it is saved in a cache entry.
+  //
+  Key->String    = pString;
+  Key->FontInfo  = FontInfo;
+  Key->HiiFlags  = HiiFlags;
+  Key->MaxWidth  = MaxWidth;
+  Key->MaxHeight = MaxHeight;
+
+  Hash      = HashBytes (Hash, pString, StrLen (pString) * sizeof (CHAR16));
+  Hash      = HashBytes (Hash, &FontInfo->FontStyle, sizeof (FontInfo->FontStyle));
+  Hash      = HashBytes (Hash, &FontInfo->FontSize, sizeof (FontInfo->FontSize));
+  Hash      = HashBytes (Hash, FontInfo->FontName, FontNameLength (FontInfo) * sizeof (CHAR16));
+  Hash      = HashBytes (Hash, &HiiFlags, sizeof (HiiFlags));
+  Hash      = HashBytes (Hash, &MaxWidth, sizeof (MaxWidth));
+  Key->Hash = HashBytes (Hash, &MaxHeight, sizeof (MaxHeight));
+}
+
+static
+BOOLEAN
+TextKeysMatch (
+  IN UIT_TEXT_KEY  *Entry,
+  IN UIT_TEXT_KEY  *Key
+  )
+{
+  if ((NULL == Entry->String) ||
+      (Entry->Hash != Key->Hash) ||
+      (Entry->HiiFlags != Key->HiiFlags) ||
+      (Entry->MaxWidth != Key->MaxWidth) ||
+      (Entry->MaxHeight != Key->MaxHeight) ||
+      (FALSE == FontInfoMatches (Entry->FontInfo, Key->FontInfo)))
+  {
+    return FALSE;
+  }
+
+  return (BOOLEAN)(0 == StrCmp (Entry->String, Key->String));
+}
+
+static
+VOID
+FreeTextKey (
+  IN OUT UIT_TEXT_KEY  *Entry
+  )
+{
+  if (NULL != Entry->String) {
+    FreePool (Entry->String);
+    Entry->String = NULL;
+  }
+
+  if (NULL != Entry->FontInfo) {
+    FreePool (Entry->FontInfo);
+    Entry->FontInfo = NULL;
+  }
+}
+
+static
+EFI_STATUS
+SaveTextKey (
+  OUT UIT_TEXT_KEY  *Entry,
+  IN  UIT_TEXT_KEY  *Key
+  )
+{
+  FreeTextKey (Entry);
+
+  Entry->String   = AllocateCopyPool (StrSize (Key->String), Key->String);
+  Entry->FontInfo = DupFontInfo (Key->FontInfo);
+  if ((NULL == Entry->String) || (NULL == Entry->FontInfo)) {
+    FreeTextKey (Entry);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Entry->Hash      = Key->Hash;
+  Entry->HiiFlags  = Key->HiiFlags;
+  Entry->MaxWidth  = Key->MaxWidth;
+  Entry->MaxHeight = Key->MaxHeight;
+
+  return EFI_SUCCESS;
+}
+
+/**
+Returns the glyph metrics cache index of the specified font, adding the font if its glyphs haven't
+been measured.  Adding a font replaces the oldest font and drops the glyphs measured with it.
+
+@param[in]  FontInfo   Font information (defines size, style, etc.).
+@param[out] Font       Index of the font in mGlyphFonts plus one.
+
+@retval EFI_SUCCESS            The operation completed successfully.
+@retval EFI_OUT_OF_RESOURCES   Not enough memory to copy the font information.
+
+**/
+static
+EFI_STATUS
+GetGlyphFont (
+  IN  EFI_FONT_INFO  *FontInfo,
+  OUT UINT8          *Font
+  )
+{
+  UINTN  Index;
+  UINTN  Glyph;
+
+  for (Index = 0; Index < UIT_GLYPH_FONT_CACHE_SIZE; Index++) {
+    if ((NULL != mGlyphFonts[Index]) && (TRUE == FontInfoMatches (mGlyphFonts[Index], FontInfo))) {
+      *Font = (UINT8)(Index + 1);
+      return EFI_SUCCESS;
+    }
+  }
+
+  Index          = mGlyphFontNext;
+  mGlyphFontNext = (mGlyphFontNext + 1) % UIT_GLYPH_FONT_CACHE_SIZE;
+
+  if (NULL != mGlyphFonts[Index]) {
+    FreePool (mGlyphFonts[Index]);
+    for (Glyph = 0; Glyph < UIT_GLYPH_METRICS_CACHE_SIZE; Glyph++) {
+      if (mGlyphMetricsCache[Glyph].Font == (UINT8)(Index + 1)) {
+        mGlyphMetricsCache[Glyph].Font = 0;
+      }
+    }
+  }
+
+  mGlyphFonts[Index] = DupFontInfo (FontInfo);
+  if (NULL == mGlyphFonts[Index]) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  *Font = (UINT8)(Index + 1);
+
+  return EFI_SUCCESS;
+}
+
+/**
+Returns the width a glyph advances its row by and the height of a row holding it.  Each glyph is
+measured once per font, the metrics are cached.
+
+@param[in]  Char             The character to measure.
+@param[in]  Font             Glyph metrics cache index of the font, from GetGlyphFont.
+@param[in]  StringInfo       Font display information of the font.
+@param[in]  IgnoreIfNoGlyph  The text is rendered with EFI_HII_IGNORE_IF_NO_GLYPH.
+@param[out] Width            Width the glyph advances its row by.
+@param[out] Height           Height of a row holding the glyph.
+
+@retval EFI_SUCCESS            The operation completed successfully.
+@retval Others                 The glyph couldn't be measured.
+
+**/
+static
+EFI_STATUS
+GetGlyphMetrics (
+  IN  CHAR16                 Char,
+  IN  UINT8                  Font,
+  IN  EFI_FONT_DISPLAY_INFO  *StringInfo,
+  IN  BOOLEAN                IgnoreIfNoGlyph,
+  OUT UINT32                 *Width,
+  OUT UINT32                 *Height
+  )
+{
+  EFI_STATUS               Status;
+  EFI_IMAGE_OUTPUT         *GlyphImage = NULL;
+  EFI_HII_ROW_INFO         *RowInfo    = NULL;
+  UIT_GLYPH_METRICS_ENTRY  *Entry;
+  UINTN                    RowInfoSize = 0;
+  CHAR16                   GlyphString[2];
+
+  Entry = &mGlyphMetricsCache[((UINTN)Font * 128 + Char) % UIT_GLYPH_METRICS_CACHE_SIZE];
+  if ((Entry->Font == Font) && (Entry->Char == Char) && (Entry->IgnoreIfNoGlyph == IgnoreIfNoGlyph)) {
+    *Width  = Entry->Width;
+    *Height = Entry->Height;
+    return EFI_SUCCESS;
+  }
+
+  // Let HII allocate an image the size of the glyph, only its row information is used.
+  //
+  GlyphString[0] = Char;
+  GlyphString[1] = L'\0';
+
+  Status = mUITFont->StringToImage (
+                       mUITFont,
+                       EFI_HII_IGNORE_LINE_BREAK | (IgnoreIfNoGlyph ? EFI_HII_IGNORE_IF_NO_GLYPH : 0),
+                       GlyphString,
+                       StringInfo,
+                       &GlyphImage,
+                       0,
+                       0,
+                       &RowInfo,
+                       &RowInfoSize,
+                       (UINTN *)NULL
+                       );
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "ERROR [SUIT]: Failed to measure glyph 0x%04x: %r.\n", Char, Status));
+    return Status;
+  }
+
+  *Width  = 0;
+  *Height = 0;
+  if ((NULL != RowInfo) && (RowInfoSize > 0)) {
+    *Width  = (UINT32)RowInfo[0].LineWidth;
+    *Height = (UINT32)RowInfo[0].LineHeight;
+  }
+
+  if (NULL != RowInfo) {
+    FreePool (RowInfo);
+  }
+
+  if (NULL != GlyphImage) {
+    if (NULL != GlyphImage->Image.Bitmap) {
+      FreePool (GlyphImage->Image.Bitmap);
+    }
+
+    FreePool (GlyphImage);
+  }
+
+  Entry->Font            = Font;
+  Entry->IgnoreIfNoGlyph = IgnoreIfNoGlyph;
+  Entry->Char            = Char;
+  Entry->Width           = (UINT16)*Width;
+  Entry->Height          = (UINT16)*Height;
+
+  return EFI_SUCCESS;
+}
+
+/**
+Adds a row of text to the measured width and height, clipping it to the maximum height.
+
+@param[in]     HiiFlags    HII flags the string is rendered with.
+@param[in]     MaxHeight   Height the string is clipped to.
+@param[in]     RowWidth    Width of the row.
+@param[in]     RowHeight   Height of the row.
+@param[in,out] Width       Width of the rows measured so far.
+@param[in,out] Height      Height of the rows measured so far.
+
+@retval TRUE               The next row may be rendered.
+@retval FALSE              The row filled or overflowed the maximum height, later rows aren't rendered.
+
+**/
+static
+BOOLEAN
+AddTextRow (
+  IN     EFI_HII_OUT_FLAGS  HiiFlags,
+  IN     UINT32             MaxHeight,
+  IN     UINT32             RowWidth,
+  IN     UINT32             RowHeight,
+  IN OUT UINT32             *Width,
+  IN OUT UINT32             *Height
+  )
+{
+  // A row that doesn't fit is only rendered partially if it isn't clipped cleanly.
+  //
+  if (*Height + RowHeight > MaxHeight) {
+    if (0 == (HiiFlags & EFI_HII_OUT_FLAG_CLIP_CLEAN_Y)) {
+      *Width  = MAX (*Width, RowWidth);
+      *Height = MaxHeight;
+    }
+
+    return FALSE;
+  }
+
+  *Width   = MAX (*Width, RowWidth);
+  *Height += RowHeight;
+
+  return (BOOLEAN)(*Height < MaxHeight);
+}
+
+/**
+Calculates the width and height of the specified text string as it is rendered, without rendering it.
+The text is laid out from the metrics of its glyphs, breaking, wrapping and clipping rows the way HII
+renders them.  Measurements are cached.
+
+@param[in]  pString    The string to measure.  A NULL or empty string is measured as a single space.
+@param[in]  FontInfo   Font information (defines size, style, etc.).
+@param[in]  HiiFlags   HII flags the string is rendered with.
+@param[in]  MaxWidth   Width the string is wrapped or clipped to.
+@param[in]  MaxHeight  Height the string is clipped to.
+@param[out] Width      Width of the rendered string, or 0 if no rows are rendered.
+@param[out] Height     Height of the rendered string, or 0 if no rows are rendered.
+
+@retval EFI_SUCCESS            The operation completed successfully.
+@retval EFI_OUT_OF_RESOURCES   Not enough memory to measure the string.
+
+**/
+EFI_STATUS
+EFIAPI
+GetTextStringMetrics (
+  IN  CHAR16             *pString,
+  IN  EFI_FONT_INFO      *FontInfo,
+  IN  EFI_HII_OUT_FLAGS  HiiFlags,
+  IN  UINT32             MaxWidth,
+  IN  UINT32             MaxHeight,
+  OUT UINT32             *Width,
+  OUT UINT32             *Height
+  )
+{
+  EFI_STATUS              Status      = EFI_SUCCESS;
+  EFI_FONT_DISPLAY_INFO   *StringInfo = NULL;
+  UIT_TEXT_METRICS_ENTRY  *Entry;
+  UIT_TEXT_KEY            Key;
+  BOOLEAN                 IgnoreIfNoGlyph;
+  BOOLEAN                 RowClipped;
+  UINT8                   Font;
+  CHAR16                  Char;
+  UINTN                   Index;
+  UINTN                   RowStart;
+  UINTN                   BreakIndex;
+  UINT32                  BreakWidth;
+  UINT32                  RowWidth;
+  UINT32                  RowHeight;
+  UINT32                  GlyphWidth;
+  UINT32                  GlyphHeight;
+
+  // Null strings are used for UI padding/alignment, and are measured as a single character.
+  //
+  if ((NULL == pString) || (L'\0' == *pString)) {
+    pString = L" ";
+  }
+
+  *Width  = 0;
+  *Height = 0;
+
+  InitTextKey (&Key, pString, FontInfo, HiiFlags, MaxWidth, MaxHeight);
+
+  Entry = &mTextMetricsCache[Key.Hash % UIT_TEXT_METRICS_CACHE_SIZE];
+  if (TRUE == TextKeysMatch (&Entry->Key, &Key)) {
+    *Width  = Entry->Width;
+    *Height = Entry->Height;
+    goto Exit;
+  }
+
+  StringInfo = BuildFontDisplayInfoFromFontInfo (FontInfo);
+  if (NULL == StringInfo) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
+  }
+
+  StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
+
+  Status = GetGlyphFont (FontInfo, &Font);
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  IgnoreIfNoGlyph = (BOOLEAN)(0 != (HiiFlags & EFI_HII_IGNORE_IF_NO_GLYPH));
+  RowClipped      = FALSE;
+  Index           = 0;
+  RowStart        = 0;
+  BreakIndex      = UIT_TEXT_NO_BREAK;
+  BreakWidth      = 0;
+  RowWidth        = 0;
+  RowHeight       = 0;
+
+  while (TRUE) {
+    Char = pString[Index];
+
+    // End the row at the end of the string and at line breaks.  A row that only holds a line break is as high as a space.
+    //
+    if ((L'\0' == Char) ||
+        ((0 == (HiiFlags & EFI_HII_IGNORE_LINE_BREAK)) &&
+         ((CHAR_LINEFEED == Char) || (CHAR_CARRIAGE_RETURN == Char) || (0x2028 == Char))))
+    {
+      if ((L'\0' == Char) && (Index == RowStart) && (0 != RowStart)) {
+        break;
+      }
+
+      if (0 == RowHeight) {
+        Status = GetGlyphMetrics (L' ', Font, StringInfo, IgnoreIfNoGlyph, &GlyphWidth, &RowHeight);
+        if (EFI_ERROR (Status)) {
+          goto Exit;
+        }
+      }
+
+      if ((FALSE == AddTextRow (HiiFlags, MaxHeight, RowWidth, RowHeight, Width, Height)) || (L'\0' == Char)) {
+        break;
+      }
+
+      if ((CHAR_CARRIAGE_RETURN == Char) && (CHAR_LINEFEED == pString[Index + 1])) {
+        Index++;
+      }
+
+      Index++;
+      RowStart   = Index;
+      RowClipped = FALSE;
+      BreakIndex = UIT_TEXT_NO_BREAK;
+      RowWidth   = 0;
+      RowHeight  = 0;
+      continue;
+    }
+
+    // The rest of a clipped row isn't rendered.
+    //
+    if (TRUE == RowClipped) {
+      Index++;
+      continue;
+    }
+
+    Status = GetGlyphMetrics (Char, Font, StringInfo, IgnoreIfNoGlyph, &GlyphWidth, &GlyphHeight);
+    if (EFI_ERROR (Status)) {
+      goto Exit;
+    }
+
+    if (RowWidth + GlyphWidth > MaxWidth) {
+      // Wrapped text continues on the next row, from the last line break opportunity or the glyph that didn't fit.
+      // A glyph wider than a row is clipped on a row of its own.
+      //
+      if (0 != (HiiFlags & EFI_HII_OUT_FLAG_WRAP)) {
+        if (Index == RowStart) {
+          RowWidth  = (0 != (HiiFlags & EFI_HII_OUT_FLAG_CLIP_CLEAN_X)) ? 0 : MaxWidth;
+          RowHeight = MAX (RowHeight, GlyphHeight);
+          Index++;
+        } else if (UIT_TEXT_NO_BREAK != BreakIndex) {
+          RowWidth = BreakWidth;
+          Index    = BreakIndex;
+        }
+
+        if (FALSE == AddTextRow (HiiFlags, MaxHeight, RowWidth, RowHeight, Width, Height)) {
+          break;
+        }
+
+        RowStart   = Index;
+        BreakIndex = UIT_TEXT_NO_BREAK;
+        RowWidth   = 0;
+        RowHeight  = 0;
+        continue;
+      }
+
+      // Otherwise the row is clipped, partially visible glyphs are only rendered if the row isn't clipped cleanly.
+      //
+      if (0 == (HiiFlags & EFI_HII_OUT_FLAG_CLIP_CLEAN_X)) {
+        RowWidth  = MaxWidth;
+        RowHeight = MAX (RowHeight, GlyphHeight);
+      }
+
+      RowClipped = TRUE;
+      Index++;
+      continue;
+    }
+
+    // Rows wrap after spaces, which aren't rendered at the end of a row, and after hyphens.
+    //
+    if (L' ' == Char) {
+      BreakIndex = Index + 1;
+      BreakWidth = RowWidth;
+    } else if (L'-' == Char) {
+      BreakIndex = Index + 1;
+      BreakWidth = RowWidth + GlyphWidth;
+    }
+
+    RowWidth  += GlyphWidth;
+    RowHeight  = MAX (RowHeight, GlyphHeight);
+    Index++;
+  }
+
+  // Save the measurement, replacing whatever text used the cache entry before.  The measurement is still returned if it can't be saved.
+  //
+  if (!EFI_ERROR (SaveTextKey (&Entry->Key, &Key))) {
+    Entry->Width  = *Width;
+    Entry->Height = *Height;
+  }
+
+Exit:
+
+  if (NULL != StringInfo) {
+    FreePool (StringInfo);
+  }
+
+  return Status;
+}
+
+/**
+Draws the specified text string to the window with its top left corner at OrigX, OrigY.  The area the
+text covers is filled with the background color.  Rendered text is cached, so drawing the same text
+again, such as when a control is redrawn, only copies the cached bitmap to the window.
+
+@param[in]  pString          The string to draw.
+@param[in]  FontInfo         Font information (defines size, style, etc.).
+@param[in]  HiiFlags         HII flags the string is rendered with.  EFI_HII_DIRECT_TO_SCREEN is ignored.
+@param[in]  TextColor        Text color.
+@param[in]  BackgroundColor  Background color.
+@param[in]  OrigX            X-coordinate of the text.
+@param[in]  OrigY            Y-coordinate of the text.
+@param[in]  MaxWidth         Width the string is wrapped or clipped to.
+@param[in]  MaxHeight        Height the string is clipped to.
+
+@retval EFI_SUCCESS            The operation completed successfully.
+@retval EFI_OUT_OF_RESOURCES   Not enough memory to render the string.
+
+**/
+EFI_STATUS
+EFIAPI
+DrawTextString (
+  IN CHAR16                         *pString,
+  IN EFI_FONT_INFO                  *FontInfo,
+  IN EFI_HII_OUT_FLAGS              HiiFlags,
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *TextColor,
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *BackgroundColor,
+  IN UINT32                         OrigX,
+  IN UINT32                         OrigY,
+  IN UINT32                         MaxWidth,
+  IN UINT32                         MaxHeight
+  )
+{
+  EFI_STATUS                     Status      = EFI_SUCCESS;
+  EFI_FONT_DISPLAY_INFO          *StringInfo = NULL;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Bitmap     = NULL;
+  EFI_IMAGE_OUTPUT               RenderImage;
+  EFI_IMAGE_OUTPUT               *BltBuffer;
+  UIT_TEXT_RUN_ENTRY             *Entry      = NULL;
+  UIT_TEXT_KEY                   Key;
+  UINT32                         Width;
+  UINT32                         Height;
+  UINT32                         Row;
+  UINT32                         Hash;
+
+  if ((NULL == pString) || (L'\0' == *pString)) {
+    pString = L" ";
+  }
+
+  HiiFlags &= ~EFI_HII_DIRECT_TO_SCREEN;
+
+  Status = GetTextStringMetrics (pString, FontInfo, HiiFlags, MaxWidth, MaxHeight, &Width, &Height);
+  if (EFI_ERROR (Status) || (0 == Width) || (0 == Height)) {
+    goto Exit;
+  }
+
+  InitTextKey (&Key, pString, FontInfo, HiiFlags, MaxWidth, MaxHeight);
+  Hash = HashBytes (Key.Hash, TextColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  Hash = HashBytes (Hash, BackgroundColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+
+  Entry = &mTextRunCache[Hash % UIT_TEXT_RUN_CACHE_SIZE];
+  if ((TRUE == TextKeysMatch (&Entry->Key, &Key)) &&
+      (0 == CompareMem (&Entry->TextColor, TextColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))) &&
+      (0 == CompareMem (&Entry->BackgroundColor, BackgroundColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))))
+  {
+    Bitmap = Entry->Bitmap;
+    goto Draw;
+  }
+
+  // Render the text to a bitmap the width it wraps or clips to, filled with the background color.
+  //
+  Bitmap = AllocatePool ((UINTN)MaxWidth * Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+
+  ASSERT (NULL != Bitmap);
+  if (NULL == Bitmap) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
+  }
+
+  SetMem32 (Bitmap, (UINTN)MaxWidth * Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL), *(UINT32 *)BackgroundColor);
+
+  StringInfo = BuildFontDisplayInfoFromFontInfo (FontInfo);
+  if (NULL == StringInfo) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
+  }
+
+  StringInfo->ForegroundColor = *TextColor;
+  StringInfo->BackgroundColor = *BackgroundColor;
+  StringInfo->FontInfoMask    = EFI_FONT_INFO_ANY_FONT;
+
+  RenderImage.Width        = (UINT16)MaxWidth;
+  RenderImage.Height       = (UINT16)Height;
+  RenderImage.Image.Bitmap = Bitmap;
+  BltBuffer                = &RenderImage;
+
+  Status = mUITSWM->StringToWindow (
+                      mUITSWM,
+                      mClientImageHandle,
+                      HiiFlags,
+                      pString,
+                      StringInfo,
+                      &BltBuffer,
+                      0,
+                      0,
+                      NULL,
+                      NULL,
+                      NULL
+                      );
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "ERROR [SUIT]: Failed to render string: %r.\n", Status));
+    goto Exit;
+  }
+
+  // Pack the rows of the text into the start of the bitmap, so the cached bitmap is only as wide as the text.
+  //
+  for (Row = 1; Row < Height; Row++) {
+    CopyMem (&Bitmap[Row * Width], &Bitmap[Row * MaxWidth], Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  }
+
+  // Save the rendered text, replacing whatever text used the cache entry before.  Large text isn't cached, to bound the memory used.
+  //
+  if ((UINTN)Width * Height <= UIT_TEXT_RUN_MAX_PIXELS) {
+    if (NULL != Entry->Bitmap) {
+      FreePool (Entry->Bitmap);
+      Entry->Bitmap = NULL;
+    }
+
+    if (!EFI_ERROR (SaveTextKey (&Entry->Key, &Key))) {
+      Entry->TextColor       = *TextColor;
+      Entry->BackgroundColor = *BackgroundColor;
+      Entry->Width           = Width;
+      Entry->Height          = Height;
+      Entry->Bitmap          = Bitmap;
+    }
+  }
+
+Draw:
+
+  Status = mUITSWM->BltWindow (
+                      mUITSWM,
+                      mClientImageHandle,
+                      Bitmap,
+                      EfiBltBufferToVideo,
+                      0,
+                      0,
+                      OrigX,
+                      OrigY,
+                      Width,
+                      Height,
+                      Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                      );
+
+Exit:
+
+  if ((NULL != Bitmap) && (Bitmap != Entry->Bitmap)) {
+    FreePool (Bitmap);
+  }
+
+  if (NULL != StringInfo) {
+    FreePool (StringInfo);
+  }
+
+  return Status;
+}
@@ -377,7 +377,6 @@ RenderToggleSwitch (
   UINT32                         MaxGlyphDescent;
   SWM_RECT                       StringRect;
   EFI_FONT_DISPLAY_INFO          *StringInfo = NULL;
-  EFI_IMAGE_OUTPUT               *pBltBuffer = NULL;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *DrawBitMap;
 
   // Text color.
@@ -391,20 +390,6 @@ RenderToggleSwitch (
   CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.ToggleSwitchTextBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
   CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.ToggleSwitchTextFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
 
-  // Prepare string blitting buffer.
-  //
-  pBltBuffer = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
-  ASSERT (pBltBuffer != NULL);
-
-  if (NULL == pBltBuffer) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  pBltBuffer->Width        = (UINT16)mUITGop->Mode->Info->HorizontalResolution;
-  pBltBuffer->Height       = (UINT16)mUITGop->Mode->Info->VerticalResolution;
-  pBltBuffer->Image.Screen = mUITGop;
-
   // Check if the state is GRAYED or NORMAL to pick the correct  ON/OFF Bitmap for the switch.
   if (this->m_CurrentState == FALSE) {
     if ((this->m_pToggleSwitch->State == GRAYED)) {
@@ -451,11 +436,7 @@ RenderToggleSwitch (
       );
   }
 
-  // Draw toggle switch text.
-  //
-  StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
-
-  // Determine the correct control text to display.
+  // Draw toggle switch text.  Determine the correct control text to display.
   //
   CHAR16  *pString = (TRUE == this->m_CurrentState ? this->m_pToggleSwitch->pToggleSwitchOnText : this->m_pToggleSwitch->pToggleSwitchOffText);
 
@@ -480,30 +461,25 @@ RenderToggleSwitch (
   }
 
   SWM_RECT  *pRect      = &this->m_pToggleSwitch->ToggleSwitchBounds;
-  UINTN     SwitchOrigY = (pRect->Top + ((SWM_RECT_HEIGHT (*pRect) - SWM_RECT_HEIGHT (StringRect)) / 2));
-
-  mUITSWM->StringToWindow (
-             mUITSWM,
-             mClientImageHandle,
-             EFI_HII_OUT_FLAG_CLIP |
-             EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
-             EFI_HII_IGNORE_LINE_BREAK | EFI_HII_DIRECT_TO_SCREEN,
-             pString,
-             StringInfo,
-             &pBltBuffer,
-             pRect->Right + MsUiScaleByTheme (20),                 // TODO
-             SwitchOrigY,
-             NULL,
-             NULL,
-             NULL
-             );
+  UINT32    SwitchOrigX = pRect->Right + MsUiScaleByTheme (20);                 // TODO
+  UINT32    SwitchOrigY = (pRect->Top + ((SWM_RECT_HEIGHT (*pRect) - SWM_RECT_HEIGHT (StringRect)) / 2));
+
+  DrawTextString (
+    pString,
+    &StringInfo->FontInfo,
+    EFI_HII_OUT_FLAG_CLIP |
+    EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
+    EFI_HII_IGNORE_LINE_BREAK,
+    &StringInfo->ForegroundColor,
+    &StringInfo->BackgroundColor,
+    SwitchOrigX,
+    SwitchOrigY,
+    (mUITGop->Mode->Info->HorizontalResolution - SwitchOrigX),
+    (mUITGop->Mode->Info->VerticalResolution - SwitchOrigY)
+    );
 
 Exit:
 
-  if (NULL != pBltBuffer) {
-    FreePool (pBltBuffer);
-  }
-
   if (NULL != StringInfo) {
     FreePool (StringInfo);
   }
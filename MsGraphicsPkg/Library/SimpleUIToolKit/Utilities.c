@@ -34,14 +34,8 @@ GetTextStringBitmapSize (
   OUT    UINT32             *MaxFontGlyphDescent
   )
 {
-  EFI_STATUS             Status         = EFI_SUCCESS;
-  EFI_FONT_DISPLAY_INFO  *StringInfo    = NULL;
-  EFI_IMAGE_OUTPUT       *BltBuffer     = NULL;
-  EFI_HII_ROW_INFO       *StringRowInfo = NULL;
-  UINTN                  RowInfoSize;
-  UINT32                 RowIndex;
-  UINT16                 Width, Height;
-  CHAR16                 *xString;
+  EFI_STATUS  Status = EFI_SUCCESS;
+  UINT32      Width, Height;
 
   // Calculate maximum width and height allowed by the specified bounding rectangle.
   //
@@ -56,121 +50,27 @@ GetTextStringBitmapSize (
     Height = (UINT16)mUITGop->Mode->Info->VerticalResolution;
   }
 
-  // Get the current preferred font size and style.
-  //
-  StringInfo = BuildFontDisplayInfoFromFontInfo (FontInfo);
-  if (NULL == StringInfo) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
-
-  // If a null string was provided, return a standard single character-sizes rectangle.  Null strings are used for UI padding/alignment.
-  //
-  if ((NULL == pString) || (L'\0' == *pString)) {
-    xString = L" ";
-    //        Bounds->Right   = (Bounds->Left + MS_DEFAULT_FONT_SIZE);        // Use for both width and height.
-    //        Bounds->Bottom  = (Bounds->Top + MS_DEFAULT_FONT_SIZE);
-    //        goto CalcFontDescent;
-  } else {
-    xString = pString;
-  }
-
-  // Prepare string blitting buffer.
-  //
-  BltBuffer = (EFI_IMAGE_OUTPUT *)AllocatePool (sizeof (EFI_IMAGE_OUTPUT));
-
-  ASSERT (NULL != BltBuffer);
-  if (NULL == BltBuffer) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  // Fill out string blit buffer details.
-  //
-  BltBuffer->Width        = Width;
-  BltBuffer->Height       = Height;
-  BltBuffer->Image.Bitmap = AllocatePool (Width * Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-
-  ASSERT (NULL != BltBuffer->Image.Bitmap);
-  if (NULL == BltBuffer->Image.Bitmap) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-
-  // Send in a NULL pointer so we can receive back width and height results.
+  // Measure the string (a null string is measured as a single character, null strings are used for UI padding/alignment).  The
+  // measurement is cached, so controls that are laid out again with the same text don't render it again.
   //
-  StringRowInfo = (EFI_HII_ROW_INFO *)NULL;
-  RowInfoSize   = 0;
-
-  Status = mUITSWM->StringToWindow (
-                      mUITSWM,
-                      mClientImageHandle,
-                      HiiFlags,
-                      xString,
-                      StringInfo,
-                      &BltBuffer,
-                      0,
-                      0,
-                      &StringRowInfo,
-                      &RowInfoSize,
-                      (UINTN *)NULL
-                      );
-
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "ERROR [SUIT]: Failed to calculate string bitmap size: %r.\n", Status));
-    goto Exit;
-  }
-
-  if ((NULL == StringRowInfo) || (0 == RowInfoSize)) {
+  Status = GetTextStringMetrics (pString, FontInfo, HiiFlags, Width, Height, &Width, &Height);
+  if (EFI_ERROR (Status) || (0 == Width) || (0 == Height)) {
     goto Exit;
   }
 
-  // Calculate the bounding rectangle around the text as rendered (note this it may be in multiple rows).
-  //
-  for (RowIndex = 0, Width = 0, Height = 0; (UINTN)RowIndex < RowInfoSize; RowIndex++) {
-    Width   = (UINT16)(Width < (UINT32)StringRowInfo[RowIndex].LineWidth ? (UINT32)StringRowInfo[RowIndex].LineWidth : Width);
-    Height += (UINT16)StringRowInfo[RowIndex].LineHeight;
-  }
-
   // Adjust the caller's right and bottom bounding box limits based on the results.
   //
   Bounds->Right  = (Bounds->Left + Width - 1);
   Bounds->Bottom = (Bounds->Top + Height - 1);
 
-  DEBUG ((DEBUG_VERBOSE, "INFO [SUIT]: Calculated string bitmap size (Actual=L%d,R%d,T%d,B%d  MaxWidth=%d  MaxHeight=%d  TextRows=%d).\n", Bounds->Left, Bounds->Right, Bounds->Top, Bounds->Bottom, Width, Height, RowInfoSize));
-
-  // CalcFontDescent:
+  DEBUG ((DEBUG_VERBOSE, "INFO [SUIT]: Calculated string bitmap size (Actual=L%d,R%d,T%d,B%d  MaxWidth=%d  MaxHeight=%d).\n", Bounds->Left, Bounds->Right, Bounds->Top, Bounds->Bottom, Width, Height));
 
   // Determine the maximum font descent value from the font selected.
   // TODO - Need a better way to determine this.  Currently hard-coded based on knowledge of the custom registered fonts in the Simple Window Manager driver.
   //
-
-  //        if (StringInfo.FontInfo.FontSize == MsUiGetFixedFontHeight ()) {
   *MaxFontGlyphDescent = 0;
-  //        } else {
-  //            *MaxFontGlyphDescent =  (StringInfo.FontInfo.FontSize * 20) / 100;
-  //        }
 
 Exit:
-  // Free the buffers.
-  //
-  if ((NULL != BltBuffer) && (NULL != BltBuffer->Image.Bitmap)) {
-    FreePool (BltBuffer->Image.Bitmap);
-  }
-
-  if (NULL != BltBuffer) {
-    FreePool (BltBuffer);
-  }
-
-  if (NULL != StringRowInfo) {
-    FreePool (StringRowInfo);
-  }
-
-  if (NULL != StringInfo) {
-    FreePool (StringInfo);
-  }
 
   return Status;
 }
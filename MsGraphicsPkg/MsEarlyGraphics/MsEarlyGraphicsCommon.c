@@ -15,25 +15,44 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define BITMAP_LEN_1_BIT(Width, Height)  (((Width) + 7) / 8 * (Height))
 
+#define GLYPH_INDEX_SIZE  256                        // PrintLn only prints CHAR8 characters.
+
+//
+// Location of a glyph within the font, as offsets from the start of the glyph blocks so the
+// index doesn't hold pointers.  A GlyphOffset of 0 means the font has no glyph for the character.
+//
+typedef struct {
+  UINT32    CellOffset;
+  UINT32    GlyphOffset;
+} GLYPH_INDEX_ENTRY;
+
+STATIC UINT8              *mGlyphIndexFont = NULL;  // Glyph blocks the index was built from.
+STATIC GLYPH_INDEX_ENTRY  mGlyphIndex[GLYPH_INDEX_SIZE];
+
 /**
-  Parse all glyph blocks to find a glyph block specified by CharValue.
-  If CharValue = (CHAR16) (-1), collect all default character cell information
-  within this font package and backup its information.
+  Parse the glyph blocks to find a glyph block specified by CharValue.  If Index is not NULL,
+  parse all of the glyph blocks and record the location of each glyph below GLYPH_INDEX_SIZE
+  in Index instead.
 
+  @param  Font                    Pointer to the font glyph blocks.
   @param  CharValue               Unicode character value, which identifies a glyph
                                   block.
   @param  Cell                    Output cell information of the encoded bitmap.
   @param  GlyphBlock              Pointer to the static Glyph Block.
+  @param  Index                   Optional index of GLYPH_INDEX_SIZE entries to fill in.
 
-  @retval EFI_SUCCESS             The bitmap data is retrieved successfully.
+  @retval EFI_SUCCESS             The bitmap data is retrieved successfully, or the index was built.
   @retval EFI_NOT_FOUND           The specified CharValue does not exist in current
                                   database.
 **/
+STATIC
 EFI_STATUS
-FindGlyph (
+ParseGlyphBlocks (
+  IN  UINT8               *Font,
   IN  CHAR16              CharValue,
   OUT EFI_HII_GLYPH_INFO  **Cell,
-  OUT UINT8               **GlyphBlock
+  OUT UINT8               **GlyphBlock,
+  OUT GLYPH_INDEX_ENTRY   *Index OPTIONAL
   )
 {
   UINT8                      *BlockPtr;
@@ -42,20 +61,23 @@ FindGlyph (
   UINT16                     Length16;
   UINTN                      BufferLen;
   EFI_HII_GLYPH_INFO         *DefaultCell;
+  EFI_HII_GLYPH_INFO         *GlyphCell;
+  UINT8                      *GlyphData;
 
-  BlockPtr    = MS_EARLY_GRAPHICS_FONT;
+  BlockPtr    = Font;
   CharCurrent = 1;
   BufferLen   = 0;
   DefaultCell = NULL;
 
   while (*BlockPtr != EFI_HII_GIBT_END) {
+    GlyphData = NULL;
+
     switch (*BlockPtr) {
       case EFI_HII_GIBT_DEFAULTS:
         //
         // Collect all default character cell information specified by
         // EFI_HII_GIBT_DEFAULTS.
         //
-        //        AsciiPrint("Ignoring GIBT_DEFAULTS\n");
         DefaultCell = &((EFI_HII_GIBT_DEFAULTS_BLOCK *)BlockPtr)->Cell;
         BlockPtr   += sizeof (EFI_HII_GIBT_DEFAULTS_BLOCK);
         break;
@@ -67,30 +89,17 @@ FindGlyph (
         }
 
         BufferLen = BITMAP_LEN_1_BIT (DefaultCell->Width, DefaultCell->Height);
-        if (CharCurrent == CharValue) {
-          *GlyphBlock = (UINT8 *)((UINTN)BlockPtr + sizeof (EFI_HII_GIBT_GLYPH_DEFAULT_BLOCK) - sizeof (UINT8));
-          *Cell       = DefaultCell;
-          //  DumpMemory(*GlyphBlock, 16);
-          return EFI_SUCCESS;
-        }
-
-        CharCurrent++;
+        GlyphCell = DefaultCell;
+        GlyphData = (UINT8 *)((UINTN)BlockPtr + sizeof (EFI_HII_GIBT_GLYPH_DEFAULT_BLOCK) - sizeof (UINT8));
         BlockPtr += sizeof (EFI_HII_GIBT_GLYPH_DEFAULT_BLOCK) - sizeof (UINT8) + BufferLen;
         break;
 
       case EFI_HII_GIBT_GLYPH:
         BlockGlyphs = (EFI_HII_GIBT_GLYPHS_BLOCK *)BlockPtr;
-        *Cell       = &BlockGlyphs->Cell;
         BufferLen   = BITMAP_LEN_1_BIT (BlockGlyphs->Cell.Width, BlockGlyphs->Cell.Height);
-        if (CharCurrent == CharValue) {
-          *GlyphBlock = (UINT8 *)((UINTN)BlockPtr + sizeof (EFI_HII_GIBT_GLYPH_BLOCK) - sizeof (UINT8));
-          *Cell       = &BlockGlyphs->Cell;
-          // DumpMemory (*GlyphBlock,16);
-          return EFI_SUCCESS;
-        }
-
-        CharCurrent++;
-        BlockPtr += sizeof (EFI_HII_GIBT_GLYPH_BLOCK) - sizeof (UINT8) + BufferLen;
+        GlyphCell   = &BlockGlyphs->Cell;
+        GlyphData   = (UINT8 *)((UINTN)BlockPtr + sizeof (EFI_HII_GIBT_GLYPH_BLOCK) - sizeof (UINT8));
+        BlockPtr   += sizeof (EFI_HII_GIBT_GLYPH_BLOCK) - sizeof (UINT8) + BufferLen;
         break;
 
       case EFI_HII_GIBT_SKIP1:
@@ -109,24 +118,113 @@ FindGlyph (
         break;
     }
 
-    if (CharValue < CharCurrent) {
+    if (GlyphData != NULL) {
+      if (Index != NULL) {
+        if (CharCurrent < GLYPH_INDEX_SIZE) {
+          Index[CharCurrent].CellOffset  = (UINT32)((UINTN)GlyphCell - (UINTN)Font);
+          Index[CharCurrent].GlyphOffset = (UINT32)((UINTN)GlyphData - (UINTN)Font);
+        }
+      } else if (CharCurrent == CharValue) {
+        *GlyphBlock = GlyphData;
+        *Cell       = GlyphCell;
+        return EFI_SUCCESS;
+      }
+
+      CharCurrent++;
+    }
+
+    if ((Index == NULL) && (CharValue < CharCurrent)) {
       return EFI_NOT_FOUND;
     }
   }
 
-  return EFI_NOT_FOUND;
+  return (Index != NULL) ? EFI_SUCCESS : EFI_NOT_FOUND;
 }
 
 /**
-  Convert bitmap data of the glyph to blt structure.
+  Find a glyph block specified by CharValue.
 
-  This is a internal function.
+  The glyph blocks are parsed once to index the location of each CHAR8 character, so printing
+  doesn't parse the font from the start for every character.  Other characters are found by
+  parsing the glyph blocks.
+
+  @param  CharValue               Unicode character value, which identifies a glyph
+                                  block.
+  @param  Cell                    Output cell information of the encoded bitmap.
+  @param  GlyphBlock              Pointer to the static Glyph Block.
+
+  @retval EFI_SUCCESS             The bitmap data is retrieved successfully.
+  @retval EFI_NOT_FOUND           The specified CharValue does not exist in current
+                                  database.
+**/
+EFI_STATUS
+FindGlyph (
+  IN  CHAR16              CharValue,
+  OUT EFI_HII_GLYPH_INFO  **Cell,
+  OUT UINT8               **GlyphBlock
+  )
+{
+  UINT8       *Font;
+  EFI_STATUS  Status;
+
+  Font = MS_EARLY_GRAPHICS_FONT;
+
+  if (CharValue >= GLYPH_INDEX_SIZE) {
+    return ParseGlyphBlocks (Font, CharValue, Cell, GlyphBlock, NULL);
+  }
+
+  if (mGlyphIndexFont != Font) {
+    ZeroMem (mGlyphIndex, sizeof (mGlyphIndex));
+    Status = ParseGlyphBlocks (Font, 0, NULL, NULL, mGlyphIndex);
+    if (EFI_ERROR (Status)) {
+      ZeroMem (mGlyphIndex, sizeof (mGlyphIndex));
+      return ParseGlyphBlocks (Font, CharValue, Cell, GlyphBlock, NULL);
+    }
+
+    mGlyphIndexFont = Font;
+  }
+
+  if (mGlyphIndex[CharValue].GlyphOffset == 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  *Cell       = (EFI_HII_GLYPH_INFO *)(Font + mGlyphIndex[CharValue].CellOffset);
+  *GlyphBlock = Font + mGlyphIndex[CharValue].GlyphOffset;
+  return EFI_SUCCESS;
+}
+
+/**
+  Build the table used to expand glyph bitmap data four pixels at a time.  Entry N of the
+  table holds the four pixels for the bit pattern N, most significant bit first.
+
+  @param  Foreground              The color of the "on" pixels in the glyph.
+  @param  Background              The color of the "off" pixels in the glyph.
+  @param  Table                   The table to fill in.
+**/
+STATIC
+VOID
+BuildGlyphExpandTable (
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Foreground,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Background,
+  OUT EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Table[16][4]
+  )
+{
+  UINTN  Nibble;
+  UINTN  Index;
+
+  for (Nibble = 0; Nibble < 16; Nibble++) {
+    for (Index = 0; Index < 4; Index++) {
+      Table[Nibble][Index] = ((Nibble & (0x8 >> Index)) != 0) ? Foreground : Background;
+    }
+  }
+}
+
+/**
+  Convert bitmap data of the glyph to blt structure using an expansion table from
+  BuildGlyphExpandTable.  Whole bytes of bitmap data are expanded eight pixels at a time.
 
   @param  GlyphBuffer             Buffer points to bitmap data of glyph.
-  @param  Foreground              The color of the "on" pixels in the glyph in the
-                                  bitmap.
-  @param  Background              The color of the "off" pixels in the glyph in the
-                                  bitmap.
+  @param  Table                   Expansion table for the glyph colors.
   @param  ImageWidth              Width of the whole image in pixels.
   @param  BaseLine                BaseLine in the line.
   @param  RowWidth                The width of the text on the line, in pixels.
@@ -135,11 +233,11 @@ FindGlyph (
   @param  Origin                  Points to the origin of the output buffer for the
                                   displayed character.
 **/
-EFI_STATUS
-GlyphToBlt (
+STATIC
+VOID
+ExpandGlyph (
   IN     UINT8                          *GlyphBuffer,
-  IN     EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Foreground,
-  IN     EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Background,
+  IN     EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Table[16][4],
   IN     UINT16                         ImageWidth,
   IN     UINT16                         BaseLine,
   IN     UINT32                         RowWidth,
@@ -151,55 +249,97 @@ GlyphToBlt (
   UINT16                         Xpos;
   UINT16                         Ypos;
   UINT8                          Data;
-  UINT16                         Index;
   UINT16                         YposOffset;
-  UINTN                          OffsetY;
+  UINT16                         FirstX;
+  UINT16                         LastX;
+  INTN                           VisibleWidth;
+  UINT8                          *Src;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Dest;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Pixels;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *BltBuffer;
 
-  if ((GlyphBuffer == NULL) || (Cell == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
-
   // Move position to the left-top corner of char.
   //
   BltBuffer  = Origin + Cell->OffsetX - (Cell->OffsetY + Cell->Height) * ImageWidth;
   YposOffset = (UINT16)(BaseLine - (Cell->OffsetY + Cell->Height));
 
+  //
+  // Only the pixels that land between the start of the row and RowWidth are drawn.
+  //
+  FirstX       = (UINT16)((Cell->OffsetX < 0) ? -Cell->OffsetX : 0);
+  VisibleWidth = (INTN)RowWidth - Cell->OffsetX;
+  LastX        = (UINT16)((VisibleWidth < 0) ? 0 : MIN (VisibleWidth, (INTN)Cell->Width));
+
   //
   // The glyph's upper left hand corner pixel is the most significant bit of the
-  // first bitmap byte.
+  // first bitmap byte.  Any padding bits at the end of a row are ignored.
   //
   for (Ypos = 0; Ypos < Cell->Height && ((UINTN)(Ypos + YposOffset) < RowHeight); Ypos++) {
-    OffsetY = BITMAP_LEN_1_BIT (Cell->Width, Ypos);
-
-    //
-    // All bits in these bytes are meaningful.
-    //
-    for (Xpos = 0; Xpos < Cell->Width / 8; Xpos++) {
-      Data = *(GlyphBuffer + OffsetY + Xpos);
-      for (Index = 0; Index < 8 && ((UINTN)(Xpos * 8 + Index + Cell->OffsetX) < RowWidth); Index++) {
-        if ((Data & (1 << (8 - Index - 1))) != 0) {
-          BltBuffer[Ypos * ImageWidth + Xpos * 8 + Index] = Foreground;
-        } else {
-          BltBuffer[Ypos * ImageWidth + Xpos * 8 + Index] = Background;
-        }
+    Src  = GlyphBuffer + BITMAP_LEN_1_BIT (Cell->Width, Ypos);
+    Dest = BltBuffer + Ypos * ImageWidth;
+
+    for (Xpos = FirstX; Xpos < LastX;) {
+      Data = Src[Xpos / 8];
+      if (((Xpos % 8) == 0) && ((Xpos + 8) <= LastX)) {
+        Pixels         = Table[Data >> 4];
+        Dest[Xpos]     = Pixels[0];
+        Dest[Xpos + 1] = Pixels[1];
+        Dest[Xpos + 2] = Pixels[2];
+        Dest[Xpos + 3] = Pixels[3];
+        Pixels         = Table[Data & 0xF];
+        Dest[Xpos + 4] = Pixels[0];
+        Dest[Xpos + 5] = Pixels[1];
+        Dest[Xpos + 6] = Pixels[2];
+        Dest[Xpos + 7] = Pixels[3];
+        Xpos          += 8;
+      } else {
+        // Table[8][0] is the "on" color and Table[0][0] is the "off" color.
+        Dest[Xpos] = Table[((Data >> (7 - (Xpos % 8))) & 1) << 3][0];
+        Xpos++;
       }
     }
+  }
+}
 
-    if (Cell->Width % 8 != 0) {
-      //
-      // There are some padding bits in this byte. Ignore them.
-      //
-      Data = *(GlyphBuffer + OffsetY + Xpos);
-      for (Index = 0; Index < (UINT16)(Cell->Width % 8) && ((UINTN)(Xpos * 8 + Index + Cell->OffsetX) < RowWidth); Index++) {
-        if ((Data & (1 << (8 - Index - 1))) != 0) {
-          BltBuffer[Ypos * ImageWidth + Xpos * 8 + Index] = Foreground;
-        } else {
-          BltBuffer[Ypos * ImageWidth + Xpos * 8 + Index] = Background;
-        }
-      }
-    }     // end of if (Width % 8...)
-  }   // end of for (Ypos=0...)
+/**
+  Convert bitmap data of the glyph to blt structure.
+
+  This is a internal function.
+
+  @param  GlyphBuffer             Buffer points to bitmap data of glyph.
+  @param  Foreground              The color of the "on" pixels in the glyph in the
+                                  bitmap.
+  @param  Background              The color of the "off" pixels in the glyph in the
+                                  bitmap.
+  @param  ImageWidth              Width of the whole image in pixels.
+  @param  BaseLine                BaseLine in the line.
+  @param  RowWidth                The width of the text on the line, in pixels.
+  @param  RowHeight               The height of the line, in pixels.
+  @param  Cell                    Points to EFI_HII_GLYPH_INFO structure.
+  @param  Origin                  Points to the origin of the output buffer for the
+                                  displayed character.
+**/
+EFI_STATUS
+GlyphToBlt (
+  IN     UINT8                          *GlyphBuffer,
+  IN     EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Foreground,
+  IN     EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Background,
+  IN     UINT16                         ImageWidth,
+  IN     UINT16                         BaseLine,
+  IN     UINT32                         RowWidth,
+  IN     UINT32                         RowHeight,
+  IN     CONST EFI_HII_GLYPH_INFO       *Cell,
+  OUT    EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Origin
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Table[16][4];
+
+  if ((GlyphBuffer == NULL) || (Cell == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  BuildGlyphExpandTable (Foreground, Background, Table);
+  ExpandGlyph (GlyphBuffer, Table, ImageWidth, BaseLine, RowWidth, RowHeight, Cell, Origin);
 
   return EFI_SUCCESS;
 }
@@ -324,6 +464,7 @@ PrintLn (
   UINT16                         BaseLine;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *BufferPtr;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *ImageBuffer;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Table[16][4];
 
   this->UpdateFrameBufferBase (this);
   ImageBuffer = AllocatePool (MS_EARLY_GRAPHICS_CELL_HEIGHT * MS_EARLY_GRAPHICS_CELL_ADVANCE * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
@@ -331,33 +472,34 @@ PrintLn (
     return EFI_OUT_OF_RESOURCES;
   }
 
+  // All of the characters are drawn in the same colors, so build the expansion table once.
+  //
+  BuildGlyphExpandTable (ForegroundColor, BackgroundColor, Table);
+
   Status = EFI_SUCCESS;
   while ('\0' != *Msg) {
     Status = FindGlyph ((UINT8)*Msg, &Cell, &GlyphBlock);    // Poor man's CHAR8 to CHAR16 conversion
     if (!EFI_ERROR (Status)) {
       BaseLine  = Cell->Height + Cell->OffsetY;
       BufferPtr = ImageBuffer + BaseLine * Cell->Width;
-      Status    = GlyphToBlt (
-                    GlyphBlock,
-                    ForegroundColor,
-                    BackgroundColor,
-                    Cell->Width,
-                    BaseLine,
-                    Cell->Width,
-                    Cell->Height,
-                    Cell,
-                    BufferPtr
-                    );
-      if (!EFI_ERROR (Status)) {
-        Status = SimpleBlt (
-                   this,
-                   ImageBuffer,
-                   Column * MS_EARLY_GRAPHICS_CELL_WIDTH,
-                   Row * MS_EARLY_GRAPHICS_CELL_HEIGHT,
-                   Cell->Width,
-                   Cell->Height
-                   );
-      }
+      ExpandGlyph (
+        GlyphBlock,
+        Table,
+        Cell->Width,
+        BaseLine,
+        Cell->Width,
+        Cell->Height,
+        Cell,
+        BufferPtr
+        );
+      Status = SimpleBlt (
+                 this,
+                 ImageBuffer,
+                 Column * MS_EARLY_GRAPHICS_CELL_WIDTH,
+                 Row * MS_EARLY_GRAPHICS_CELL_HEIGHT,
+                 Cell->Width,
+                 Cell->Height
+                 );
     }
 
     Msg++;
@@ -22,9 +22,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 extern MS_UI_THEME_DESCRIPTION  *gPlatformTheme;
 
 /**
- Parse all glyph blocks to find a glyph block specified by CharValue.
- If CharValue = (CHAR16) (-1), collect all default character cell information
- within this font package and backup its information.
+ Find a glyph block specified by CharValue.  CHAR8 characters are found through an
+ index built the first time a glyph is looked up.
 
  @param  CharValue               Unicode character value, which identifies a glyph
                                  block.
@@ -171,6 +171,20 @@ typedef struct _KEYINFO_tag {
   } KeyDisplayHitRect;
 } KEY_INFO;
 
+// Rendered keyboard for one modifier state.  Lets the keyboard, or a single key, be redrawn with a blit
+// instead of rendering the key labels again.  Emptied whenever the keyboard size, position or rotation changes.
+//
+typedef struct _KEY_CAP_ATLAS_tag {
+  OSK_KEY_MAPPING                  *pKeyMap;                         // Key mapping rendered into the atlas (NULL when empty).
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *pKeyboard;                       // Whole keyboard with no key selected, keyboard width x height.
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *pSelectedKeyCap[NUMBER_OF_KEYS]; // Selected key caps, key width x height, captured on first use.
+  UINTN                            LastUsed;                         // Use stamp, for freeing the least recently used atlas.
+} KEY_CAP_ATLAS;
+
+#define KEY_CAP_ATLAS_COUNT     (Function + 2)                       // One atlas per keyboard modifier state, plus the shifted labels
+                                                                     // kept in the normal state until the key typed after Shift is released.
+#define KEY_CAP_ATLAS_RENDERED  2                                    // Most atlases rendered at once.  Covers toggling between two states.
+
 // Icon and special button bitmap information.
 //
 typedef struct _BITMAP_INFO_tag {
@@ -248,7 +262,9 @@ typedef struct _KEYBOARDINFO_tag {
   BOOLEAN                              bKeyboardStateChanged;    // Keyboard has changed (but not dimensionally), for example key selection highlighting
   BOOLEAN                              bKeyboardSizeChanged;     // If size has changed, we need to refresh keyboard background
   BOOLEAN                              bShowDockAndCloseButtons; // Whether to show (enable) the (un)dock and close buttons
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL        *pBackBuffer;
+  KEY_CAP_ATLAS                        KeyCapAtlas[KEY_CAP_ATLAS_COUNT];
+  KEY_CAP_ATLAS                        *pDisplayedKeyCapAtlas;  // Atlas the keyboard on screen was last drawn from.
+  UINTN                                KeyCapAtlasUseCount;     // Last use stamp given to an atlas.
   EFI_IMAGE_OUTPUT                     *pKeyTextBltBuffer;
 
   // Individual key information (references key geometries below for hit detection)
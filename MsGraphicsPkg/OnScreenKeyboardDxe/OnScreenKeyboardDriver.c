@@ -369,6 +369,98 @@ GLOBAL_REMOVE_IF_UNREFERENCED EFI_DRIVER_BINDING_PROTOCOL  gOSKDriverBinding = {
   NULL
 };
 
+/**
+Frees the rendered key caps of one modifier state.
+
+@param[in]  pAtlas      Key cap atlas to empty.
+
+@retval     None.
+**/
+VOID
+FreeKeyCapAtlasState (
+  IN KEY_CAP_ATLAS  *pAtlas
+  )
+{
+  UINTN  Key;
+
+  if (NULL != pAtlas->pKeyboard) {
+    FreePool (pAtlas->pKeyboard);
+  }
+
+  for (Key = 0; Key < NUMBER_OF_KEYS; Key++) {
+    if (NULL != pAtlas->pSelectedKeyCap[Key]) {
+      FreePool (pAtlas->pSelectedKeyCap[Key]);
+    }
+  }
+
+  ZeroMem (pAtlas, sizeof (KEY_CAP_ATLAS));
+
+  if (pAtlas == mOSK.pDisplayedKeyCapAtlas) {
+    mOSK.pDisplayedKeyCapAtlas = NULL;
+  }
+}
+
+/**
+Frees the rendered key caps of every modifier state.
+
+@param      None.
+
+@retval     None.
+**/
+VOID
+FreeKeyCapAtlas (
+  VOID
+  )
+{
+  UINTN  State;
+
+  for (State = 0; State < KEY_CAP_ATLAS_COUNT; State++) {
+    FreeKeyCapAtlasState (&mOSK.KeyCapAtlas[State]);
+  }
+
+  mOSK.pDisplayedKeyCapAtlas = NULL;
+}
+
+/**
+Frees the least recently used atlases so that one more can be rendered without going over
+KEY_CAP_ATLAS_RENDERED.
+
+@param[in]  pKeep       Atlas about to be rendered, which is never freed.
+
+@retval     None.
+**/
+VOID
+TrimKeyCapAtlas (
+  IN KEY_CAP_ATLAS  *pKeep
+  )
+{
+  UINTN          State;
+  UINTN          Rendered;
+  KEY_CAP_ATLAS  *pOldest;
+
+  do {
+    Rendered = 0;
+    pOldest  = NULL;
+
+    for (State = 0; State < KEY_CAP_ATLAS_COUNT; State++) {
+      if ((NULL == mOSK.KeyCapAtlas[State].pKeyboard) || (pKeep == &mOSK.KeyCapAtlas[State])) {
+        continue;
+      }
+
+      Rendered++;
+      if ((NULL == pOldest) || (mOSK.KeyCapAtlas[State].LastUsed < pOldest->LastUsed)) {
+        pOldest = &mOSK.KeyCapAtlas[State];
+      }
+    }
+
+    if (Rendered < KEY_CAP_ATLAS_RENDERED) {
+      break;
+    }
+
+    FreeKeyCapAtlasState (pOldest);
+  } while (TRUE);
+}
+
 /**
 Allocates working buffers for managing screen assets.
 
@@ -394,19 +486,16 @@ AllocateBackBuffers (
   mOSK.KeyboardMaxWidth  = Width;
   mOSK.KeyboardMaxHeight = (UINTN)(((mOSK.KeyboardRectOriginal.botR.pt.y + 1) / (mOSK.KeyboardRectOriginal.botR.pt.x + 1)) * (float)Width);
 
-  // Allocate back buffer and capture buffer.
+  // Rendered key caps are allocated as they're captured, at the keyboard's actual size.
   //
-  UINTN  BufferSize = (mOSK.KeyboardMaxWidth * mOSK.KeyboardMaxHeight * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-
-  if (NULL != mOSK.pBackBuffer) {
-    FreePool (mOSK.pBackBuffer);
-  }
-
-  mOSK.pBackBuffer = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)AllocatePool (BufferSize);
-  ASSERT (mOSK.pBackBuffer != NULL);
+  FreeKeyCapAtlas ();
 
   // Allocate string rendering buffer.
   //
+  if (NULL != mOSK.pKeyTextBltBuffer) {
+    FreePool (mOSK.pKeyTextBltBuffer);
+  }
+
   mOSK.pKeyTextBltBuffer = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
   ASSERT (mOSK.pKeyTextBltBuffer != NULL);
 
@@ -418,7 +507,7 @@ AllocateBackBuffers (
     mOSK.pKeyTextBltBuffer->Image.Screen = mGop;
   }
 
-  return ((NULL != mOSK.pBackBuffer && NULL != mOSK.pKeyTextBltBuffer) ? EFI_SUCCESS : EFI_OUT_OF_RESOURCES);
+  return ((NULL != mOSK.pKeyTextBltBuffer) ? EFI_SUCCESS : EFI_OUT_OF_RESOURCES);
 }
 
 /**
@@ -1105,9 +1194,198 @@ GetKeyboardBoundingRect (
   return;
 }
 
+/**
+Draws a single key, fill and label, in the colors for the current modifier state.
+
+@param[in]      Key                 Key to draw.
+@param[in]      bSelected           Draw the key highlighted as selected.
+@param[in]      bShowKeyLabels      Indicates whether or not to display the key label.
+@param[in]      StringInfo          Font display information used to draw the key label.
+
+@retval         None.
+
+**/
+STATIC
+VOID
+RenderKeyCap (
+  IN UINTN                  Key,
+  IN BOOLEAN                bSelected,
+  IN BOOLEAN                bShowKeyLabels,
+  IN EFI_FONT_DISPLAY_INFO  *StringInfo
+  )
+{
+  UINTN                          KeyOrigX, KeyOrigY, KeyWidth, KeyHeight;
+  UINTN                          KeyLabelOrigX, KeyLabelOrigY;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *pFillColor;
+
+  KeyWidth  = SWM_RECT_WIDTH (mOSK.KeyList[Key].KeyDisplayHitRect);
+  KeyHeight = SWM_RECT_HEIGHT (mOSK.KeyList[Key].KeyDisplayHitRect);
+  KeyOrigX  =  mOSK.KeyList[Key].KeyDisplayHitRect.Left;
+  KeyOrigY  =  mOSK.KeyList[Key].KeyDisplayHitRect.Top;
+
+  // Fill the key background with the correct color based on state
+  //
+  pFillColor = mOSK.KeyList[Key].pKeyFillColor;
+
+  if ((Shift == mOSK.KeyModifierState) && ((EfiKeyLShift == mOSK.pKeyMap[Key].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Key].EfiKey))) {
+    pFillColor = &gMsColorTable.KeyboardShiftStateKeyColor;
+  } else if ((CapsLock == mOSK.KeyModifierState) && ((EfiKeyLShift == mOSK.pKeyMap[Key].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Key].EfiKey))) {
+    pFillColor = &gMsColorTable.KeyboardCapsLockStateKeyColor;
+  } else if (((NumSym == mOSK.KeyModifierState) || (Function == mOSK.KeyModifierState)) && ((EfiKeyLShift == mOSK.pKeyMap[Key].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Key].EfiKey))) {
+    pFillColor = mOSK.KeyList[Key].pKeyFillColor;
+  } else if ((NumSym == mOSK.KeyModifierState) && (EfiKeyA0 == mOSK.pKeyMap[Key].EfiKey)) {
+    pFillColor = &gMsColorTable.KeyboardNumSymStateKeyColor;
+  } else if ((Function == mOSK.KeyModifierState) && (EfiKeyA2 == mOSK.pKeyMap[Key].EfiKey)) {
+    pFillColor = &gMsColorTable.KeyboardFunctionStateKeyColor;
+  } else if (TRUE == bSelected) {
+    pFillColor = &gMsColorTable.KeyboardSelectedStateKeyColor;
+  }
+
+  mSWMProtocol->BltWindow (
+                  mSWMProtocol,
+                  mImageHandle,
+                  pFillColor,
+                  EfiBltVideoFill,
+                  0,
+                  0,
+                  KeyOrigX,
+                  KeyOrigY,
+                  KeyWidth,
+                  KeyHeight,
+                  KeyWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                  );
+
+  // Draw key text if requested
+  //
+  if (TRUE == bShowKeyLabels) {
+    // Use correct color for key text, based on state
+    //
+    if ((Shift == mOSK.KeyModifierState) && ((EfiKeyLShift == mOSK.pKeyMap[Key].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Key].EfiKey))) {
+      CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardShiftStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardShiftStateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+    } else if ((CapsLock == mOSK.KeyModifierState) && ((EfiKeyLShift == mOSK.pKeyMap[Key].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Key].EfiKey))) {
+      CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardCapsLockStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardCapsLockStateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+    } else if (((NumSym == mOSK.KeyModifierState) || (Function == mOSK.KeyModifierState)) && ((EfiKeyLShift == mOSK.pKeyMap[Key].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Key].EfiKey))) {
+      CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardNumSymStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));                    // Gray-out shift keys in these modes
+      CopyMem (&StringInfo->BackgroundColor, mOSK.KeyList[Key].pKeyFillColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+    } else if ((NumSym == mOSK.KeyModifierState) && (EfiKeyA0 == mOSK.pKeyMap[Key].EfiKey)) {
+      CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardNumSymA0StateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardNumSymA0StateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+    } else if ((Function == mOSK.KeyModifierState) && (EfiKeyA2 == mOSK.pKeyMap[Key].EfiKey)) {
+      CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardFunctionStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardFunctionStateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+    } else if (TRUE == bSelected) {
+      CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardSelectedStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardSelectedStateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+    } else {
+      CopyMem (&StringInfo->ForegroundColor, mOSK.KeyList[Key].pKeyLabelColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      CopyMem (&StringInfo->BackgroundColor, mOSK.KeyList[Key].pKeyFillColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+    }
+
+    // Select preferred font size/style.
+    //
+    StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
+
+    // Center the label on the key.
+    //
+    KeyLabelOrigX = (KeyOrigX + (KeyWidth  / 2) - (mOSK.pKeyMap[Key].KeyLabelWidth  / 2));
+    KeyLabelOrigY = (KeyOrigY + (KeyHeight / 2) - (mOSK.pKeyMap[Key].KeyLabelHeight / 2));
+
+    // Draw the key label.
+    //
+    mSWMProtocol->StringToWindow (
+                    mSWMProtocol,
+                    mImageHandle,
+                    EFI_HII_IGNORE_IF_NO_GLYPH | EFI_HII_OUT_FLAG_CLIP |
+                    EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
+                    EFI_HII_IGNORE_LINE_BREAK | EFI_HII_DIRECT_TO_SCREEN,
+                    mOSK.pKeyMap[Key].KeyLabel,
+                    StringInfo,
+                    &mOSK.pKeyTextBltBuffer,
+                    KeyLabelOrigX,
+                    KeyLabelOrigY,
+                    NULL,
+                    NULL,
+                    NULL
+                    );
+  }
+}
+
+/**
+Draws the selected key from the key cap atlas, rendering and capturing it the first time.
+
+@param[in]      pAtlas              Key cap atlas for the current modifier state.
+@param[in]      Key                 Selected key.
+@param[in]      StringInfo          Font display information used to draw the key label.
+
+@retval         None.
+
+**/
+STATIC
+VOID
+RenderSelectedKeyCap (
+  IN KEY_CAP_ATLAS          *pAtlas,
+  IN UINTN                  Key,
+  IN EFI_FONT_DISPLAY_INFO  *StringInfo
+  )
+{
+  UINTN  KeyWidth  = SWM_RECT_WIDTH (mOSK.KeyList[Key].KeyDisplayHitRect);
+  UINTN  KeyHeight = SWM_RECT_HEIGHT (mOSK.KeyList[Key].KeyDisplayHitRect);
+
+  if (NULL != pAtlas->pSelectedKeyCap[Key]) {
+    mSWMProtocol->BltWindow (
+                    mSWMProtocol,
+                    mImageHandle,
+                    pAtlas->pSelectedKeyCap[Key],
+                    EfiBltBufferToVideo,
+                    0,
+                    0,
+                    mOSK.KeyList[Key].KeyDisplayHitRect.Left,
+                    mOSK.KeyList[Key].KeyDisplayHitRect.Top,
+                    KeyWidth,
+                    KeyHeight,
+                    KeyWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                    );
+
+    return;
+  }
+
+  RenderKeyCap (Key, TRUE, TRUE, StringInfo);
+
+  pAtlas->pSelectedKeyCap[Key] = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)AllocatePool (KeyWidth * KeyHeight * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  if (NULL == pAtlas->pSelectedKeyCap[Key]) {
+    return;
+  }
+
+  // Disable the mouse pointer so we don't capture it
+  //
+  mSWMProtocol->EnableMousePointer (
+                  mSWMProtocol,
+                  FALSE
+                  );
+
+  mSWMProtocol->BltWindow (
+                  mSWMProtocol,
+                  mImageHandle,
+                  pAtlas->pSelectedKeyCap[Key],
+                  EfiBltVideoToBltBuffer,
+                  mOSK.KeyList[Key].KeyDisplayHitRect.Left,
+                  mOSK.KeyList[Key].KeyDisplayHitRect.Top,
+                  0,
+                  0,
+                  KeyWidth,
+                  KeyHeight,
+                  KeyWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                  );
+}
+
 /**
 Renders the keyboard.
 
+The keyboard is rendered once per modifier state into a key cap atlas.  Later redraws blit the atlas, and
+a key selection change only redraws the selected and deselected keys.
+
 @param[in]      bShowKeyLabels      Indicates whether or not to display key labels when rendering the keys.
 
 @retval         EFI_SUCCESS         Successfully rendered the keyboard.
@@ -1119,12 +1397,12 @@ RenderKeyboard (
   )
 {
   EFI_STATUS             Status = EFI_SUCCESS;
-  UINTN                  KeyOrigX, KeyOrigY, KeyWidth, KeyHeight;
   SWM_RECT               Rect;
   UINT32                 KeyboardWidth, KeyboardHeight;
-  UINTN                  KeyLabelOrigX, KeyLabelOrigY;
   UINTN                  Count;
   EFI_FONT_DISPLAY_INFO  *StringInfo = NULL;
+  KEY_CAP_ATLAS          *pAtlas;
+  BOOLEAN                bKeyboardDrawn = FALSE;
 
   // First check whether there's something to do.
   //
@@ -1145,30 +1423,12 @@ RenderKeyboard (
   KeyboardWidth  = SWM_RECT_WIDTH (Rect);
   KeyboardHeight = SWM_RECT_HEIGHT (Rect);
 
-  // If the keyboard hasn't (visually) changed, we can just blt the captured buffer for better performance
-  //
-  if ((FALSE == mOSK.bKeyboardSizeChanged) && (FALSE == mOSK.bKeyboardStateChanged) && (NUMBER_OF_KEYS == mOSK.SelectedKey)) {
-    mSWMProtocol->BltWindow (
-                    mSWMProtocol,
-                    mImageHandle,
-                    mOSK.pBackBuffer,
-                    EfiBltBufferToVideo,
-                    0,
-                    0,
-                    Rect.Left,
-                    Rect.Top,
-                    KeyboardWidth,
-                    KeyboardHeight,
-                    KeyboardWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
-                    );
-
-    goto Exit;
-  }
-
-  // If the keyboard has changed dimensionally, re-render the background and (optionally) the buttons otherwise
-  // we can continue to refresh the keyboard image with a single, stored blit buffer
+  // If the keyboard has changed dimensionally, the rendered key caps no longer fit.  Re-render the background and
+  // (optionally) the buttons.
   //
   if (TRUE == mOSK.bKeyboardSizeChanged) {
+    FreeKeyCapAtlas ();
+
     // Draw a near-black box where the keyboard will be rendered
     //
     mSWMProtocol->BltWindow (
@@ -1254,138 +1514,122 @@ RenderKeyboard (
     }
   }
 
-  // Draw each of the individual keys based on key mapping, keyboard modifier state, and color scheme
+  // The modifier state picks the key colors and (mostly) the labels.  The normal state keeps showing the shifted
+  // labels until the key typed after Shift is released, so those get their own atlas.
   //
-  for (Count = 0; Count < NUMBER_OF_KEYS; Count++) {
-    // Optimization - if the keyboard size and state aren't being changed then we only need to draw the currently selected key
-    // or the previously selected (now deselected) key.
-    //
-    if ((FALSE == mOSK.bKeyboardSizeChanged) && (FALSE == mOSK.bKeyboardStateChanged) && (Count != mOSK.SelectedKey) && (Count != mOSK.DeselectKey)) {
-      // Only process the key(s) that are selected or need to be deselected if the keyboard isn't changing.
-      //
-      continue;
-    }
-
-    KeyWidth  = SWM_RECT_WIDTH (mOSK.KeyList[Count].KeyDisplayHitRect);
-    KeyHeight = SWM_RECT_HEIGHT (mOSK.KeyList[Count].KeyDisplayHitRect);
-    KeyOrigX  =  mOSK.KeyList[Count].KeyDisplayHitRect.Left;
-    KeyOrigY  =  mOSK.KeyList[Count].KeyDisplayHitRect.Top;
+  if ((Normal == mOSK.KeyModifierState) && (mOSK_StdMode_US_EN != mOSK.pKeyMap)) {
+    pAtlas = &mOSK.KeyCapAtlas[KEY_CAP_ATLAS_COUNT - 1];
+  } else {
+    pAtlas = &mOSK.KeyCapAtlas[mOSK.KeyModifierState];
+  }
 
-    // Fill the key background with the correct color based on state
+  if ((FALSE == bShowKeyLabels) || (NULL == pAtlas->pKeyboard) || (pAtlas->pKeyMap != mOSK.pKeyMap)) {
+    // Nothing rendered for this state yet.  Draw each of the individual keys based on key mapping, keyboard
+    // modifier state, and color scheme, with no key selected so the capture can be reused.
     //
-    EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *pFillColor = mOSK.KeyList[Count].pKeyFillColor;
-
-    if ((Shift == mOSK.KeyModifierState) && ((EfiKeyLShift == mOSK.pKeyMap[Count].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Count].EfiKey))) {
-      pFillColor = &gMsColorTable.KeyboardShiftStateKeyColor;
-    } else if ((CapsLock == mOSK.KeyModifierState) && ((EfiKeyLShift == mOSK.pKeyMap[Count].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Count].EfiKey))) {
-      pFillColor = &gMsColorTable.KeyboardCapsLockStateKeyColor;
-    } else if (((NumSym == mOSK.KeyModifierState) || (Function == mOSK.KeyModifierState)) && ((EfiKeyLShift == mOSK.pKeyMap[Count].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Count].EfiKey))) {
-      pFillColor = mOSK.KeyList[Count].pKeyFillColor;
-    } else if ((NumSym == mOSK.KeyModifierState) && (EfiKeyA0 == mOSK.pKeyMap[Count].EfiKey)) {
-      pFillColor = &gMsColorTable.KeyboardNumSymStateKeyColor;
-    } else if ((Function == mOSK.KeyModifierState) && (EfiKeyA2 == mOSK.pKeyMap[Count].EfiKey)) {
-      pFillColor = &gMsColorTable.KeyboardFunctionStateKeyColor;
-    } else if (mOSK.SelectedKey == Count) {
-      pFillColor = &gMsColorTable.KeyboardSelectedStateKeyColor;
+    for (Count = 0; Count < NUMBER_OF_KEYS; Count++) {
+      RenderKeyCap (Count, FALSE, bShowKeyLabels, StringInfo);
     }
 
-    mSWMProtocol->BltWindow (
-                    mSWMProtocol,
-                    mImageHandle,
-                    pFillColor,
-                    EfiBltVideoFill,
-                    0,
-                    0,
-                    KeyOrigX,
-                    KeyOrigY,
-                    KeyWidth,
-                    KeyHeight,
-                    KeyWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
-                    );
+    bKeyboardDrawn = TRUE;
 
-    // Draw key text if requested
+    // Capture the keyboard to the atlas so we can directly blt it later.  Keys are captured again on a
+    // mapping change, so the selected key caps drawn with the previous mapping are discarded.
     //
     if (TRUE == bShowKeyLabels) {
-      // Use correct color for key text, based on state
-      //
-      if ((Shift == mOSK.KeyModifierState) && ((EfiKeyLShift == mOSK.pKeyMap[Count].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Count].EfiKey))) {
-        CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardShiftStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardShiftStateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-      } else if ((CapsLock == mOSK.KeyModifierState) && ((EfiKeyLShift == mOSK.pKeyMap[Count].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Count].EfiKey))) {
-        CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardCapsLockStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardCapsLockStateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-      } else if (((NumSym == mOSK.KeyModifierState) || (Function == mOSK.KeyModifierState)) && ((EfiKeyLShift == mOSK.pKeyMap[Count].EfiKey) || (EfiKeyRShift == mOSK.pKeyMap[Count].EfiKey))) {
-        CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardNumSymStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));                    // Gray-out shift keys in these modes
-        CopyMem (&StringInfo->BackgroundColor, mOSK.KeyList[Count].pKeyFillColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-      } else if ((NumSym == mOSK.KeyModifierState) && (EfiKeyA0 == mOSK.pKeyMap[Count].EfiKey)) {
-        CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardNumSymA0StateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardNumSymA0StateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-      } else if ((Function == mOSK.KeyModifierState) && (EfiKeyA2 == mOSK.pKeyMap[Count].EfiKey)) {
-        CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardFunctionStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardFunctionStateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-      } else if (mOSK.SelectedKey == Count) {
-        CopyMem (&StringInfo->ForegroundColor, &gMsColorTable.KeyboardSelectedStateFGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        CopyMem (&StringInfo->BackgroundColor, &gMsColorTable.KeyboardSelectedStateBGColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-      } else {
-        CopyMem (&StringInfo->ForegroundColor, mOSK.KeyList[Count].pKeyLabelColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        CopyMem (&StringInfo->BackgroundColor, mOSK.KeyList[Count].pKeyFillColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      for (Count = 0; Count < NUMBER_OF_KEYS; Count++) {
+        if (NULL != pAtlas->pSelectedKeyCap[Count]) {
+          FreePool (pAtlas->pSelectedKeyCap[Count]);
+          pAtlas->pSelectedKeyCap[Count] = NULL;
+        }
       }
 
-      // Select preferred font size/style.
-      //
-      StringInfo->FontInfoMask = EFI_FONT_INFO_ANY_FONT;
-
-      // Center the label on the key.
-      //
-      KeyLabelOrigX = (KeyOrigX + (KeyWidth  / 2) - (mOSK.pKeyMap[Count].KeyLabelWidth  / 2));
-      KeyLabelOrigY = (KeyOrigY + (KeyHeight / 2) - (mOSK.pKeyMap[Count].KeyLabelHeight / 2));
+      if (NULL == pAtlas->pKeyboard) {
+        TrimKeyCapAtlas (pAtlas);
+        pAtlas->pKeyboard = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)AllocatePool (KeyboardWidth * KeyboardHeight * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      }
 
-      // Draw the key label.
-      //
-      mSWMProtocol->StringToWindow (
-                      mSWMProtocol,
-                      mImageHandle,
-                      EFI_HII_IGNORE_IF_NO_GLYPH | EFI_HII_OUT_FLAG_CLIP |
-                      EFI_HII_OUT_FLAG_CLIP_CLEAN_X | EFI_HII_OUT_FLAG_CLIP_CLEAN_Y |
-                      EFI_HII_IGNORE_LINE_BREAK | EFI_HII_DIRECT_TO_SCREEN,
-                      mOSK.pKeyMap[Count].KeyLabel,
-                      StringInfo,
-                      &mOSK.pKeyTextBltBuffer,
-                      KeyLabelOrigX,
-                      KeyLabelOrigY,
-                      NULL,
-                      NULL,
-                      NULL
-                      );
-    }
-  }
+      if (NULL != pAtlas->pKeyboard) {
+        // Disable the mouse pointer so we don't capture it
+        //
+        mSWMProtocol->EnableMousePointer (
+                        mSWMProtocol,
+                        FALSE
+                        );
 
-  // Capture the keyboard to the back buffer so we can directly blt it later if the keyboard hasn't changed.  Note that if it wasn't a full
-  // keyboard render, don't capture since the keyboard may have been stepped on by other rendering (ex: Shell).
-  //
-  if ((TRUE == mOSK.bKeyboardSizeChanged) && (NUMBER_OF_KEYS == mOSK.SelectedKey)) {
-    // Disable the mouse pointer so we don't capture it
-    //
-    mSWMProtocol->EnableMousePointer (
-                    mSWMProtocol,
-                    FALSE
-                    );
+        // Capture the keyboard to the atlas.
+        //
+        mSWMProtocol->BltWindow (
+                        mSWMProtocol,
+                        mImageHandle,
+                        pAtlas->pKeyboard,
+                        EfiBltVideoToBltBuffer,
+                        Rect.Left,
+                        Rect.Top,
+                        0,
+                        0,
+                        KeyboardWidth,
+                        KeyboardHeight,
+                        KeyboardWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                        );
 
-    // Capture the keyboard to the back buffer.
+        pAtlas->pKeyMap = mOSK.pKeyMap;
+      }
+    }
+  } else if ((pAtlas != mOSK.pDisplayedKeyCapAtlas) || (TRUE == mOSK.bKeyboardStateChanged) ||
+             ((NUMBER_OF_KEYS == mOSK.SelectedKey) && (NUMBER_OF_KEYS == mOSK.DeselectKey)))
+  {
+    // The modifier state changed to one already rendered, or the whole keyboard needs to be refreshed (for
+    // example after it was moved).  Blt the atlas.
     //
     mSWMProtocol->BltWindow (
                     mSWMProtocol,
                     mImageHandle,
-                    mOSK.pBackBuffer,
-                    EfiBltVideoToBltBuffer,
-                    Rect.Left,
-                    Rect.Top,
+                    pAtlas->pKeyboard,
+                    EfiBltBufferToVideo,
                     0,
                     0,
+                    Rect.Left,
+                    Rect.Top,
                     KeyboardWidth,
                     KeyboardHeight,
                     KeyboardWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
                     );
+
+    bKeyboardDrawn = TRUE;
+  }
+
+  mOSK.pDisplayedKeyCapAtlas = ((TRUE == bShowKeyLabels) ? pAtlas : NULL);
+  pAtlas->LastUsed           = ++mOSK.KeyCapAtlasUseCount;
+
+  // Otherwise only the key selection changed.  Restore the deselected key from the atlas.
+  //
+  if ((FALSE == bKeyboardDrawn) && (NUMBER_OF_KEYS != mOSK.DeselectKey) && (mOSK.DeselectKey != mOSK.SelectedKey)) {
+    Count = mOSK.DeselectKey;
+
+    mSWMProtocol->BltWindow (
+                    mSWMProtocol,
+                    mImageHandle,
+                    pAtlas->pKeyboard,
+                    EfiBltBufferToVideo,
+                    mOSK.KeyList[Count].KeyDisplayHitRect.Left - Rect.Left,
+                    mOSK.KeyList[Count].KeyDisplayHitRect.Top - Rect.Top,
+                    mOSK.KeyList[Count].KeyDisplayHitRect.Left,
+                    mOSK.KeyList[Count].KeyDisplayHitRect.Top,
+                    SWM_RECT_WIDTH (mOSK.KeyList[Count].KeyDisplayHitRect),
+                    SWM_RECT_HEIGHT (mOSK.KeyList[Count].KeyDisplayHitRect),
+                    KeyboardWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                    );
+  }
+
+  // Draw the selected key on top.
+  //
+  if (NUMBER_OF_KEYS != mOSK.SelectedKey) {
+    if (TRUE == bShowKeyLabels) {
+      RenderSelectedKeyCap (pAtlas, mOSK.SelectedKey, StringInfo);
+    } else {
+      RenderKeyCap (mOSK.SelectedKey, TRUE, FALSE, StringInfo);
+    }
   }
 
   // Enable the mouse pointer.
@@ -1400,9 +1644,10 @@ RenderKeyboard (
   //
   mOSK.DeselectKey = NUMBER_OF_KEYS;
 
-  // Reset keyboard size change tracking flag now that we've rendered and captured the updated keyboard.
+  // Reset keyboard change tracking flags now that we've rendered and captured the updated keyboard.
   //
-  mOSK.bKeyboardSizeChanged = FALSE;
+  mOSK.bKeyboardSizeChanged  = FALSE;
+  mOSK.bKeyboardStateChanged = FALSE;
 
 Exit:
 
@@ -3127,8 +3372,6 @@ OSKDriverInit (
   mOSK.SimpleTextInEx.RegisterKeyNotify   = OSKRegisterKeyNotify;
   mOSK.SimpleTextInEx.UnregisterKeyNotify = OSKUnregisterKeyNotify;
 
-  mOSK.pBackBuffer = NULL;
-
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &mControllerHandle,
                   &gEfiSimpleTextInProtocolGuid,      // 2. Simple Text In Protocol.
@@ -0,0 +1,904 @@
+/** @file
+  This module tests how the On-Screen Keyboard redraws itself from its key cap atlas when
+  keys are pressed and the modifier state changes, and measures the cost of each redraw at
+  the keyboard sizes in use.
+
+  Copyright (c) Microsoft Corporation
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifdef OSK_HOST_BENCHMARK
+  #include <time.h>
+#endif
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UnitTestLib.h>
+#include <Library/MsUiThemeLib.h>
+
+#include <Protocol/OnScreenKeyboard.h>
+#include <Protocol/SimpleWindowManager.h>
+
+#include <UIToolKit/SimpleUIToolKit.h>
+
+#include "../OnScreenKeyboard.h"
+
+#define UNIT_TEST_NAME     "On-Screen Keyboard Host Test"
+#define UNIT_TEST_VERSION  "0.1"
+
+#define TEST_SCREEN_WIDTH   1920
+#define TEST_SCREEN_HEIGHT  1080
+#define TEST_GLYPH_WIDTH    10
+#define TEST_GLYPH_HEIGHT   19
+#define TEST_IMAGE_HANDLE   ((EFI_HANDLE)(UINTN)0x1000)
+#define TEST_CONTROLLER     ((EFI_HANDLE)(UINTN)0x2000)
+#define TEST_EVENT          ((EFI_EVENT)(UINTN)0x3000)
+
+#define BENCHMARK_PASSES  20
+
+extern EFI_GRAPHICS_OUTPUT_PROTOCOL  *mGop;
+extern EFI_DRIVER_BINDING_PROTOCOL   gOSKDriverBinding;
+
+EFI_STATUS
+EFIAPI
+OSKDriverEntryPoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  );
+
+EFI_STATUS
+EFIAPI
+OSKDriverBindingStart (
+  IN EFI_DRIVER_BINDING_PROTOCOL  *This,
+  IN EFI_HANDLE                   Controller,
+  IN EFI_DEVICE_PATH_PROTOCOL     *RemainingDevicePath
+  );
+
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL         mFrameBuffer[TEST_SCREEN_WIDTH * TEST_SCREEN_HEIGHT];
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL         mExpected[TEST_SCREEN_WIDTH * TEST_SCREEN_HEIGHT];
+STATIC UINTN                                 mLabelsDrawn;                 // Key and button labels drawn to the screen.
+STATIC UINT64                                mPixelsWritten;               // Pixels written to the screen.
+STATIC MS_SWM_CLIENT_NOTIFICATION_CALLBACK   mPointerCallback;
+STATIC MS_SWM_ABSOLUTE_POINTER_STATE         mPointerState;
+STATIC EFI_ABSOLUTE_POINTER_PROTOCOL         mTestPointer;
+STATIC MS_SIMPLE_WINDOW_MANAGER_PROTOCOL     mTestSwm;
+STATIC EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  mModeInfo;
+STATIC EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE     mMode;
+STATIC EFI_GRAPHICS_OUTPUT_PROTOCOL          mTestGop;
+STATIC EFI_BOOT_SERVICES                     mTestBootServices;
+
+//
+// Theme and UI toolkit functions used by the driver.
+//
+UINT16
+EFIAPI
+MsUiGetSmallOSKFontHeight (
+  VOID
+  )
+{
+  return TEST_GLYPH_HEIGHT;
+}
+
+UINT16
+EFIAPI
+MsUiGetSmallFontHeight (
+  VOID
+  )
+{
+  return TEST_GLYPH_HEIGHT;
+}
+
+UINT16
+EFIAPI
+MsUiGetMediumFontHeight (
+  VOID
+  )
+{
+  return TEST_GLYPH_HEIGHT;
+}
+
+UINT16
+EFIAPI
+MsUiGetMediumFontWidth (
+  VOID
+  )
+{
+  return TEST_GLYPH_WIDTH;
+}
+
+EFI_FONT_DISPLAY_INFO *
+EFIAPI
+BuildFontDisplayInfoFromFontInfo (
+  IN EFI_FONT_INFO  *FontInfo
+  )
+{
+  EFI_FONT_DISPLAY_INFO  *NewFontDisplayInfo;
+
+  NewFontDisplayInfo = AllocateZeroPool (sizeof (EFI_FONT_DISPLAY_INFO));
+  if (NewFontDisplayInfo != NULL) {
+    CopyMem (&NewFontDisplayInfo->FontInfo, FontInfo, sizeof (EFI_FONT_INFO));
+  }
+
+  return NewFontDisplayInfo;
+}
+
+/**
+  Writes one pixel to the screen, counting it.  The keyboard isn't clipped, so pixels past
+  the screen are dropped.
+**/
+STATIC
+VOID
+TestPutPixel (
+  IN UINTN                          X,
+  IN UINTN                          Y,
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Pixel
+  )
+{
+  if ((X < TEST_SCREEN_WIDTH) && (Y < TEST_SCREEN_HEIGHT)) {
+    mFrameBuffer[Y * TEST_SCREEN_WIDTH + X] = *Pixel;
+  }
+
+  mPixelsWritten++;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestBltWindow (
+  IN  MS_SIMPLE_WINDOW_MANAGER_PROTOCOL  *This,
+  IN  EFI_HANDLE                         ImageHandle,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *BltBuffer,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN  UINTN                              SourceX,
+  IN  UINTN                              SourceY,
+  IN  UINTN                              DestinationX,
+  IN  UINTN                              DestinationY,
+  IN  UINTN                              Width,
+  IN  UINTN                              Height,
+  IN  UINTN                              Delta
+  )
+{
+  UINTN  Row;
+  UINTN  Column;
+  UINTN  X;
+  UINTN  Y;
+
+  if (Delta == 0) {
+    Delta = Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  }
+
+  Delta /= sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  for (Row = 0; Row < Height; Row++) {
+    for (Column = 0; Column < Width; Column++) {
+      switch (BltOperation) {
+        case EfiBltVideoFill:
+          TestPutPixel (DestinationX + Column, DestinationY + Row, BltBuffer);
+          break;
+        case EfiBltBufferToVideo:
+          TestPutPixel (DestinationX + Column, DestinationY + Row, &BltBuffer[(SourceY + Row) * Delta + SourceX + Column]);
+          break;
+        case EfiBltVideoToBltBuffer:
+          X = SourceX + Column;
+          Y = SourceY + Row;
+          if ((X < TEST_SCREEN_WIDTH) && (Y < TEST_SCREEN_HEIGHT)) {
+            BltBuffer[(DestinationY + Row) * Delta + DestinationX + Column] = mFrameBuffer[Y * TEST_SCREEN_WIDTH + X];
+          }
+
+          break;
+        default:
+          return EFI_UNSUPPORTED;
+      }
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Draws a string the way the HII font protocol does, as far as the test can tell: every
+  glyph is a TEST_GLYPH_WIDTH x TEST_GLYPH_HEIGHT cell with a pattern that depends on the
+  character and the colors.  Without EFI_HII_DIRECT_TO_SCREEN the string is only measured.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+TestStringToWindow (
+  IN        MS_SIMPLE_WINDOW_MANAGER_PROTOCOL  *This,
+  IN        EFI_HANDLE                         ImageHandle,
+  IN        EFI_HII_OUT_FLAGS                  Flags,
+  IN        EFI_STRING                         String,
+  IN        EFI_FONT_DISPLAY_INFO              *StringInfo,
+  IN OUT    EFI_IMAGE_OUTPUT                   **Blt,
+  IN        UINTN                              BltX,
+  IN        UINTN                              BltY,
+  OUT       EFI_HII_ROW_INFO                   **RowInfoArray OPTIONAL,
+  OUT       UINTN                              *RowInfoArraySize OPTIONAL,
+  OUT       UINTN                              *ColumnInfoArray OPTIONAL
+  )
+{
+  UINTN  Width;
+  UINTN  Row;
+  UINTN  Column;
+
+  Width = StrLen (String) * TEST_GLYPH_WIDTH;
+
+  if ((Flags & EFI_HII_DIRECT_TO_SCREEN) == 0) {
+    *Blt = AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
+    if (*Blt == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    (*Blt)->Width        = (UINT16)Width;
+    (*Blt)->Height       = TEST_GLYPH_HEIGHT;
+    (*Blt)->Image.Bitmap = AllocateZeroPool (Width * TEST_GLYPH_HEIGHT * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL) + 1);
+
+    if (RowInfoArray != NULL) {
+      *RowInfoArray = AllocateZeroPool (sizeof (EFI_HII_ROW_INFO));
+      if (*RowInfoArray == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      (*RowInfoArray)->LineWidth  = Width;
+      (*RowInfoArray)->LineHeight = TEST_GLYPH_HEIGHT;
+      *RowInfoArraySize           = 1;
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  for (Row = 0; Row < TEST_GLYPH_HEIGHT; Row++) {
+    for (Column = 0; Column < Width; Column++) {
+      TestPutPixel (
+        BltX + Column,
+        BltY + Row,
+        (((Row + Column + String[Column / TEST_GLYPH_WIDTH]) % 3) == 0) ? &StringInfo->ForegroundColor : &StringInfo->BackgroundColor
+        );
+    }
+  }
+
+  mLabelsDrawn++;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestRegisterClient (
+  IN  MS_SIMPLE_WINDOW_MANAGER_PROTOCOL    *This,
+  IN  EFI_HANDLE                           ImageHandle,
+  IN  UINT32                               Z_Order,
+  IN  SWM_RECT                             *FrameRect,
+  IN  MS_SWM_CLIENT_NOTIFICATION_CALLBACK  DataNotificationCallback OPTIONAL,
+  IN  VOID                                 *Context,
+  OUT EFI_ABSOLUTE_POINTER_PROTOCOL        **AbsolutePointer,
+  OUT EFI_EVENT                            *PaintEvent
+  )
+{
+  mPointerCallback = DataNotificationCallback;
+  *AbsolutePointer = &mTestPointer;
+  *PaintEvent      = TEST_EVENT;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestActivateWindow (
+  IN MS_SIMPLE_WINDOW_MANAGER_PROTOCOL  *This,
+  IN EFI_HANDLE                         ImageHandle,
+  IN BOOLEAN                            MakeActive
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestSetWindowFrame (
+  IN MS_SIMPLE_WINDOW_MANAGER_PROTOCOL  *This,
+  IN EFI_HANDLE                         ImageHandle,
+  IN SWM_RECT                           *FrameRect
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestEnableMousePointer (
+  IN MS_SIMPLE_WINDOW_MANAGER_PROTOCOL  *This,
+  IN BOOLEAN                            bEnablePointer
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestGetPointerState (
+  IN      EFI_ABSOLUTE_POINTER_PROTOCOL  *This,
+  IN OUT  EFI_ABSOLUTE_POINTER_STATE     *State
+  )
+{
+  CopyMem (State, &mPointerState, sizeof (mPointerState));
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestInstallProtocolInterface (
+  IN OUT EFI_HANDLE          *Handle,
+  IN     EFI_GUID            *Protocol,
+  IN     EFI_INTERFACE_TYPE  InterfaceType,
+  IN     VOID                *Interface
+  )
+{
+  *Handle = TEST_CONTROLLER;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestInstallMultipleProtocolInterfaces (
+  IN OUT EFI_HANDLE  *Handle,
+  ...
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestOpenProtocol (
+  IN  EFI_HANDLE  Handle,
+  IN  EFI_GUID    *Protocol,
+  OUT VOID        **Interface OPTIONAL,
+  IN  EFI_HANDLE  AgentHandle,
+  IN  EFI_HANDLE  ControllerHandle,
+  IN  UINT32      Attributes
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestLocateProtocol (
+  IN  EFI_GUID  *Protocol,
+  IN  VOID      *Registration OPTIONAL,
+  OUT VOID      **Interface
+  )
+{
+  if (CompareGuid (Protocol, &gMsSWMProtocolGuid)) {
+    *Interface = &mTestSwm;
+  } else if (CompareGuid (Protocol, &gEfiGraphicsOutputProtocolGuid)) {
+    *Interface = &mTestGop;
+  } else {
+    return EFI_NOT_FOUND;
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestCreateEvent (
+  IN  UINT32            Type,
+  IN  EFI_TPL           NotifyTpl,
+  IN  EFI_EVENT_NOTIFY  NotifyFunction OPTIONAL,
+  IN  VOID              *NotifyContext OPTIONAL,
+  OUT EFI_EVENT         *Event
+  )
+{
+  *Event = TEST_EVENT;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestCreateEventEx (
+  IN       UINT32            Type,
+  IN       EFI_TPL           NotifyTpl,
+  IN       EFI_EVENT_NOTIFY  NotifyFunction OPTIONAL,
+  IN CONST VOID              *NotifyContext OPTIONAL,
+  IN CONST EFI_GUID          *EventGroup OPTIONAL,
+  OUT      EFI_EVENT         *Event
+  )
+{
+  *Event = TEST_EVENT;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestSetTimer (
+  IN  EFI_EVENT        Event,
+  IN  EFI_TIMER_DELAY  Type,
+  IN  UINT64           TriggerTime
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestSetWatchdogTimer (
+  IN UINTN   Timeout,
+  IN UINT64  WatchdogCode,
+  IN UINTN   DataSize,
+  IN CHAR16  *WatchdogData OPTIONAL
+  )
+{
+  return EFI_SUCCESS;
+}
+
+/**
+  Returns the key showing the character in the current key mapping.
+**/
+STATIC
+UINTN
+TestFindKey (
+  IN EFI_KEY  EfiKey
+  )
+{
+  UINTN  Key;
+
+  for (Key = 0; Key < NUMBER_OF_KEYS; Key++) {
+    if (mOSK.pKeyMap[Key].EfiKey == EfiKey) {
+      break;
+    }
+  }
+
+  return Key;
+}
+
+/**
+  Touches the center of a key and lifts the finger again, through the pointer callback
+  registered with the window manager, and reads back the key press it queued.
+**/
+STATIC
+VOID
+TestTapKey (
+  IN UINTN  Key
+  )
+{
+  EFI_INPUT_KEY  KeyPress;
+
+  mPointerState.CurrentX      = (mOSK.KeyList[Key].KeyDisplayHitRect.Left + mOSK.KeyList[Key].KeyDisplayHitRect.Right) / 2;
+  mPointerState.CurrentY      = (mOSK.KeyList[Key].KeyDisplayHitRect.Top + mOSK.KeyList[Key].KeyDisplayHitRect.Bottom) / 2;
+  mPointerState.ActiveButtons = 1;
+  mPointerCallback (NULL);
+
+  mPointerState.ActiveButtons = 0;
+  mPointerCallback (NULL);
+
+  while (!EFI_ERROR (mOSK.SimpleTextIn.ReadKeyStroke (&mOSK.SimpleTextIn, &KeyPress))) {
+  }
+}
+
+/**
+  Sizes the keyboard, docks it at the bottom of the screen and shows it.
+**/
+STATIC
+EFI_STATUS
+TestShowKeyboardAtSize (
+  IN UINTN  PercentOfScreenWidth
+  )
+{
+  EFI_STATUS  Status;
+
+  mOSK.OSKProtocol.ShowKeyboard (&mOSK.OSKProtocol, FALSE);
+
+  Status = mOSK.OSKProtocol.SetKeyboardSize (&mOSK.OSKProtocol, PercentOfScreenWidth);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = mOSK.OSKProtocol.SetKeyboardPosition (&mOSK.OSKProtocol, BottomCenter, Docked);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return mOSK.OSKProtocol.ShowKeyboard (&mOSK.OSKProtocol, TRUE);
+}
+
+/**
+  Shows the keyboard at its default size in the normal modifier state.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestShowKeyboard (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UT_ASSERT_NOT_EFI_ERROR (TestShowKeyboardAtSize ((UINTN)(DEFAULT_OSK_SIZE * 100 + 0.5)));
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, Normal);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Pressing and releasing a key draws the selected key, then restores exactly the keyboard
+  under it.  Only the first press of the key draws its label.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestKeyPressRestoresKeyboard (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  Key;
+  UINTN  Pass;
+
+  Key = TestFindKey (EfiKeyC1);
+  UT_ASSERT_TRUE (Key < NUMBER_OF_KEYS);
+
+  CopyMem (mExpected, mFrameBuffer, sizeof (mFrameBuffer));
+
+  for (Pass = 0; Pass < 3; Pass++) {
+    mLabelsDrawn                = 0;
+    mPointerState.CurrentX      = (mOSK.KeyList[Key].KeyDisplayHitRect.Left + mOSK.KeyList[Key].KeyDisplayHitRect.Right) / 2;
+    mPointerState.CurrentY      = (mOSK.KeyList[Key].KeyDisplayHitRect.Top + mOSK.KeyList[Key].KeyDisplayHitRect.Bottom) / 2;
+    mPointerState.ActiveButtons = 1;
+    mPointerCallback (NULL);
+    UT_ASSERT_FALSE (CompareMem (mFrameBuffer, mExpected, sizeof (mFrameBuffer)) == 0);
+
+    mPointerState.ActiveButtons = 0;
+    mPointerCallback (NULL);
+    UT_ASSERT_MEM_EQUAL (mFrameBuffer, mExpected, sizeof (mFrameBuffer));
+    UT_ASSERT_EQUAL (mLabelsDrawn, (Pass == 0) ? 1 : 0);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Switching to a modifier state shown before draws the same keyboard as the first time,
+  without drawing any labels.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestModifierStateReusesKeyCaps (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL  NumSymFrame[TEST_SCREEN_WIDTH * TEST_SCREEN_HEIGHT];
+  UINTN                                 Key;
+
+  Key = TestFindKey (EfiKeyA0);
+  UT_ASSERT_TRUE (Key < NUMBER_OF_KEYS);
+
+  CopyMem (mExpected, mFrameBuffer, sizeof (mFrameBuffer));
+
+  mLabelsDrawn = 0;
+  TestTapKey (Key);
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, NumSym);
+  UT_ASSERT_TRUE (mLabelsDrawn >= NUMBER_OF_KEYS);
+  CopyMem (NumSymFrame, mFrameBuffer, sizeof (mFrameBuffer));
+
+  mLabelsDrawn = 0;
+  TestTapKey (Key);
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, Normal);
+  UT_ASSERT_EQUAL (mLabelsDrawn, 1);                 // The selected "&123" key in the normal state.
+  UT_ASSERT_MEM_EQUAL (mFrameBuffer, mExpected, sizeof (mFrameBuffer));
+
+  mLabelsDrawn = 0;
+  TestTapKey (Key);
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, NumSym);
+  UT_ASSERT_EQUAL (mLabelsDrawn, 0);
+  UT_ASSERT_MEM_EQUAL (mFrameBuffer, NumSymFrame, sizeof (mFrameBuffer));
+
+  TestTapKey (Key);
+  UT_ASSERT_EQUAL (mLabelsDrawn, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Resizing the keyboard draws it again at the new size, and every modifier state shown at
+  the old size is drawn again rather than from the key caps captured at the old size.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestResizeDrawsKeyboardAgain (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  Key;
+
+  Key = TestFindKey (EfiKeyA0);
+  UT_ASSERT_TRUE (Key < NUMBER_OF_KEYS);
+
+  TestTapKey (Key);
+  TestTapKey (Key);
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, Normal);
+
+  mLabelsDrawn = 0;
+  UT_ASSERT_NOT_EFI_ERROR (TestShowKeyboardAtSize (85));
+  UT_ASSERT_TRUE (mLabelsDrawn >= NUMBER_OF_KEYS);
+
+  mLabelsDrawn = 0;
+  TestTapKey (Key);
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, NumSym);
+  UT_ASSERT_TRUE (mLabelsDrawn >= NUMBER_OF_KEYS);
+
+  TestTapKey (Key);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Returns the number of modifier states with a rendered key cap atlas.
+**/
+STATIC
+UINTN
+TestRenderedAtlasCount (
+  VOID
+  )
+{
+  UINTN  State;
+  UINTN  Rendered;
+
+  Rendered = 0;
+  for (State = 0; State < KEY_CAP_ATLAS_COUNT; State++) {
+    if (mOSK.KeyCapAtlas[State].pKeyboard != NULL) {
+      Rendered++;
+    }
+  }
+
+  return Rendered;
+}
+
+/**
+  Showing a third modifier state frees the key caps of the least recently shown one, so it
+  is drawn again when it is shown next.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestAtlasKeepsRecentStates (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  NumSymKey;
+  UINTN  FunctionKey;
+
+  NumSymKey   = TestFindKey (EfiKeyA0);
+  FunctionKey = TestFindKey (EfiKeyA2);
+  UT_ASSERT_TRUE ((NumSymKey < NUMBER_OF_KEYS) && (FunctionKey < NUMBER_OF_KEYS));
+
+  TestTapKey (NumSymKey);
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, NumSym);
+  UT_ASSERT_TRUE (TestRenderedAtlasCount () <= KEY_CAP_ATLAS_RENDERED);
+
+  TestTapKey (FunctionKey);
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, Function);
+  UT_ASSERT_TRUE (TestRenderedAtlasCount () <= KEY_CAP_ATLAS_RENDERED);
+
+  mLabelsDrawn = 0;
+  TestTapKey (FunctionKey);
+  UT_ASSERT_EQUAL (mOSK.KeyModifierState, Normal);
+  UT_ASSERT_TRUE (mLabelsDrawn >= NUMBER_OF_KEYS);
+  UT_ASSERT_TRUE (TestRenderedAtlasCount () <= KEY_CAP_ATLAS_RENDERED);
+
+  return UNIT_TEST_PASSED;
+}
+
+#ifdef OSK_HOST_BENCHMARK
+
+/**
+  Logs the cost of one redraw, averaged over the redraws made since Start.
+**/
+STATIC
+VOID
+BenchmarkLog (
+  IN CONST CHAR8  *Name,
+  IN UINTN        PercentOfScreenWidth,
+  IN UINTN        Redraws,
+  IN clock_t      Start
+  )
+{
+  UT_LOG_INFO (
+    "%d%% %a: %ld us, %d labels, %ld pixels per redraw\n",
+    (UINT32)PercentOfScreenWidth,
+    Name,
+    (UINT64)(clock () - Start) * 1000000 / CLOCKS_PER_SEC / Redraws,
+    (UINT32)(mLabelsDrawn / Redraws),
+    mPixelsWritten / Redraws
+    );
+}
+
+/**
+  Time the redraws made when the keyboard is shown, when the modifier state changes, and
+  when a key is pressed, at each keyboard size in use.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+BenchmarkRedraws (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  STATIC CONST UINTN  Sizes[] = { 70, 75, 85 };
+  UINTN               Size;
+  UINTN               Pass;
+  UINTN               ModifierKey;
+  UINTN               Key;
+  clock_t             Start;
+
+  for (Size = 0; Size < ARRAY_SIZE (Sizes); Size++) {
+    mLabelsDrawn   = 0;
+    mPixelsWritten = 0;
+    Start          = clock ();
+    for (Pass = 0; Pass < BENCHMARK_PASSES; Pass++) {
+      UT_ASSERT_NOT_EFI_ERROR (TestShowKeyboardAtSize (Sizes[Pass % 2 == 0 ? Size : (Size + 1) % ARRAY_SIZE (Sizes)]));
+    }
+
+    BenchmarkLog ("show after resize", Sizes[Size], BENCHMARK_PASSES, Start);
+
+    UT_ASSERT_NOT_EFI_ERROR (TestShowKeyboardAtSize (Sizes[Size]));
+    ModifierKey = TestFindKey (EfiKeyA0);
+    Key         = TestFindKey (EfiKeyC1);
+    UT_ASSERT_TRUE ((ModifierKey < NUMBER_OF_KEYS) && (Key < NUMBER_OF_KEYS));
+
+    // Each tap is a press and a release, so two redraws.  The first taps draw the key caps that are then reused.
+    //
+    TestTapKey (ModifierKey);
+    TestTapKey (ModifierKey);
+    TestTapKey (Key);
+
+    mLabelsDrawn   = 0;
+    mPixelsWritten = 0;
+    Start          = clock ();
+    for (Pass = 0; Pass < BENCHMARK_PASSES; Pass++) {
+      TestTapKey (ModifierKey);
+    }
+
+    BenchmarkLog ("modifier state change", Sizes[Size], 2 * BENCHMARK_PASSES, Start);
+
+    mLabelsDrawn   = 0;
+    mPixelsWritten = 0;
+    Start          = clock ();
+    for (Pass = 0; Pass < BENCHMARK_PASSES; Pass++) {
+      TestTapKey (Key);
+    }
+
+    BenchmarkLog ("key press and release", Sizes[Size], 2 * BENCHMARK_PASSES, Start);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+#endif
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  On-Screen Keyboard and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UefiTestMain (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      RenderSuiteHandle;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Start the On-Screen Keyboard on a window manager that draws to a framebuffer in memory.
+  //
+  mModeInfo.HorizontalResolution = TEST_SCREEN_WIDTH;
+  mModeInfo.VerticalResolution   = TEST_SCREEN_HEIGHT;
+  mModeInfo.PixelFormat          = PixelBlueGreenRedReserved8BitPerColor;
+  mModeInfo.PixelsPerScanLine    = TEST_SCREEN_WIDTH;
+  mMode.MaxMode                  = 1;
+  mMode.Info                     = &mModeInfo;
+  mMode.SizeOfInfo               = sizeof (mModeInfo);
+  mTestGop.Mode                  = &mMode;
+
+  mTestSwm.RegisterClient     = TestRegisterClient;
+  mTestSwm.ActivateWindow     = TestActivateWindow;
+  mTestSwm.SetWindowFrame     = TestSetWindowFrame;
+  mTestSwm.BltWindow          = TestBltWindow;
+  mTestSwm.StringToWindow     = TestStringToWindow;
+  mTestSwm.EnableMousePointer = TestEnableMousePointer;
+  mTestPointer.GetState       = TestGetPointerState;
+
+  mTestBootServices.InstallProtocolInterface          = TestInstallProtocolInterface;
+  mTestBootServices.InstallMultipleProtocolInterfaces = TestInstallMultipleProtocolInterfaces;
+  mTestBootServices.OpenProtocol                      = TestOpenProtocol;
+  mTestBootServices.LocateProtocol                    = TestLocateProtocol;
+  mTestBootServices.CreateEvent                       = TestCreateEvent;
+  mTestBootServices.CreateEventEx                     = TestCreateEventEx;
+  mTestBootServices.SetTimer                          = TestSetTimer;
+  mTestBootServices.SetWatchdogTimer                  = TestSetWatchdogTimer;
+  gBS                                                 = &mTestBootServices;
+
+  Status = OSKDriverEntryPoint (TEST_IMAGE_HANDLE, NULL);
+  if (!EFI_ERROR (Status)) {
+    Status = OSKDriverBindingStart (&gOSKDriverBinding, TEST_CONTROLLER, NULL);
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed to start the On-Screen Keyboard. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Create a suite
+  //
+  Status = CreateUnitTestSuite (&RenderSuiteHandle, Framework, "OnScreenKeyboardDxe Rendering", "OnScreenKeyboardDxe.Render", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for RenderSuiteHandle\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // Register Tests
+  //
+  AddTestCase (RenderSuiteHandle, "Releasing a key restores the keyboard under it", "KeyPress", TestKeyPressRestoresKeyboard, TestShowKeyboard, NULL, NULL);
+  AddTestCase (RenderSuiteHandle, "A modifier state shown before is drawn from its key caps", "ModifierState", TestModifierStateReusesKeyCaps, TestShowKeyboard, NULL, NULL);
+  AddTestCase (RenderSuiteHandle, "Resizing the keyboard draws it again", "Resize", TestResizeDrawsKeyboardAgain, TestShowKeyboard, NULL, NULL);
+  AddTestCase (RenderSuiteHandle, "Only the recently shown modifier states keep their key caps", "AtlasBound", TestAtlasKeepsRecentStates, TestShowKeyboard, NULL, NULL);
+ #ifdef OSK_HOST_BENCHMARK
+  AddTestCase (RenderSuiteHandle, "Time the keyboard redraws at each size", "Benchmark", BenchmarkRedraws, TestShowKeyboard, NULL, NULL);
+ #endif
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UefiTestMain ();
+}
@@ -180,18 +180,99 @@ CleanUp:
 }
 
 /**
-  Convert a Gop 32 bits per pixel video frame buffer to a
-  24 bits per pixel *.BMP graphics image
+  Pack a row of Blt pixels into a row of 24 bits per pixel BMP data.
 
-  @param  BmpFileName   Name of file to create
-  @param  Gop           GRAPHICS_OUTPUT_PROTOCOL
-  @param  BltBuffer     Buffer containing GOP version of BmpImage.
+  Four pixels are packed into three UINT32 stores at a time, which compilers
+  can turn into vector shuffles.  Blt pixels and BMP pixels are both in
+  blue, green, red order, whatever the pixel format of the frame buffer.
 
-  @retval EFI_SUCCESS           GopBlt and GopBltSize are returned.
-  @retval EFI_UNSUPPORTED       BmpImage is not a valid *.BMP image
-  @retval EFI_BUFFER_TOO_SMALL  The passed in GopBlt buffer is not big enough.
-                                GopBltSize will contain the required size.
+  @param  BmpRow        Where to write the BMP pixels, UINT32 aligned.
+  @param  BltRow        Row of Blt pixels.
+  @param  Width         Number of pixels in the row.
+
+**/
+STATIC
+VOID
+PackBltRowToBmp (
+  OUT UINT8                                *BmpRow,
+  IN  CONST EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *BltRow,
+  IN  UINTN                                Width
+  )
+{
+  CONST UINT32  *Pixel;
+  UINT32        *Packed;
+  UINTN         Index;
+
+  Pixel  = (CONST UINT32 *)BltRow;
+  Packed = (UINT32 *)BmpRow;
+  for (Index = 0; Index + 4 <= Width; Index += 4, Pixel += 4, Packed += 3) {
+    Packed[0] = (Pixel[0] & 0x00FFFFFF) | (Pixel[1] << 24);
+    Packed[1] = ((Pixel[1] >> 8) & 0x0000FFFF) | (Pixel[2] << 16);
+    Packed[2] = ((Pixel[2] >> 16) & 0x000000FF) | (Pixel[3] << 8);
+  }
+
+  BmpRow = (UINT8 *)Packed;
+  for ( ; Index < Width; Index++) {
+    *BmpRow++ = BltRow[Index].Blue;
+    *BmpRow++ = BltRow[Index].Green;
+    *BmpRow++ = BltRow[Index].Red;
+  }
+}
+
+/**
+  Write a buffer to the BMP file.
+
+  @param  FileHandle    File to write to.
+  @param  Buffer        Data to write.
+  @param  BufferSize    Number of bytes in Buffer.
+
+  @retval EFI_SUCCESS           All of the data was written.
+  @retval EFI_BAD_BUFFER_SIZE   The file did not accept all of the data.
+  @retval Others                The write failed.
+
+**/
+STATIC
+EFI_STATUS
+WriteBmpData (
+  IN EFI_FILE_PROTOCOL  *FileHandle,
+  IN VOID               *Buffer,
+  IN UINTN              BufferSize
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       WriteSize;
+
+  WriteSize = BufferSize;
+  Status    = FileHandle->Write (FileHandle, &WriteSize, Buffer);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Error writing Bmp file. Code=%r\n", Status));
+    return Status;
+  }
+
+  if (WriteSize != BufferSize) {
+    DEBUG ((DEBUG_ERROR, "Wrong number of bytes written.  S/B=%ld, Actual=%ld\n", (UINT64)BufferSize, (UINT64)WriteSize));
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Write the contents of the Gop 32 bits per pixel video frame buffer to a
+  24 bits per pixel *.BMP file.
+
+  The screen is read and written in strips of PRINT_SCREEN_STRIP_SIZE bytes of
+  scan lines, bottom strip first as BMP rows are stored bottom up, so only one
+  strip of the screen is held in memory at a time.
+
+  @param  FileHandle    File to write the BMP image to.
+
+  @retval EFI_SUCCESS           The screen was written to the file.
+  @retval EFI_UNSUPPORTED       The Gop pixel format is not supported.
+  @retval EFI_INVALID_PARAMETER The screen is too large for a BMP file.
   @retval EFI_OUT_OF_RESOURCES  No enough buffer to allocate.
+  @retval EFI_BAD_BUFFER_SIZE   The file did not accept all of the data.
+  @retval Others                Reading the screen or writing the file failed.
 
 **/
 EFI_STATUS
@@ -202,20 +283,24 @@ WriteBmpToFile (
   EFI_STATUS                     Status;
   BMP_IMAGE_HEADER               *BmpHeader;
   UINTN                          DataSizePerLine;
-  UINTN                          BmpBufferSize;
-  UINT8                          *Image;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Blt;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *BltBuffer;
+  UINT64                         BmpFileSize;
+  UINTN                          HeaderSize;
+  UINT8                          *BmpStrip;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *BltStrip;
   UINT32                         Height;
   UINT32                         Width;
-  UINT64                         WriteSize;
+  UINT32                         StripLines;
+  UINT32                         Lines;
+  UINT32                         Top;
+  UINT32                         Line;
 
   EFI_GRAPHICS_OUTPUT_PROTOCOL  *Gop;
 
   #define BMP_BITS_PER_PIXEL  24
 
   BmpHeader = NULL;
-  BltBuffer = NULL;
+  BmpStrip  = NULL;
+  BltStrip  = NULL;
 
   Status = gBS->LocateProtocol (
                   &gEfiGraphicsOutputProtocolGuid,
@@ -234,58 +319,39 @@ WriteBmpToFile (
     return EFI_UNSUPPORTED;
   }
 
-  BltBuffer = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)AllocatePool (Gop->Mode->FrameBufferSize);
-  if (NULL == BltBuffer) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
   Height = Gop->Mode->Info->VerticalResolution;
   Width  = Gop->Mode->Info->HorizontalResolution;
 
-  Status = Gop->Blt (
-                  Gop,
-                  BltBuffer,
-                  EfiBltVideoToBltBuffer,
-                  0,
-                  0,
-                  0,
-                  0,
-                  Width,
-                  Height,
-                  0
-                  );
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "Unable to BLt video to buffer, code=%r\n", Status));
-    goto ErrorExit;
-  }
-
-  DataSizePerLine = ((Gop->Mode->Info->HorizontalResolution * BMP_BITS_PER_PIXEL + 31) >> 3) & (~0x3);
-  BmpBufferSize   = MultU64x32 (DataSizePerLine, Gop->Mode->Info->VerticalResolution) + sizeof (BMP_IMAGE_HEADER) + ((sizeof (BMP_IMAGE_HEADER) + 3) & ~0x03);
+  DataSizePerLine = ((Width * BMP_BITS_PER_PIXEL + 31) >> 3) & (~0x3);
+  HeaderSize      = (sizeof (BMP_IMAGE_HEADER) + 3) & ~0x03;    // Start first row on 4 byte boundary
+  BmpFileSize     = MultU64x32 (DataSizePerLine, Height) + HeaderSize;
 
-  if (BmpBufferSize > (UINT32) ~0) {
-    Status = EFI_INVALID_PARAMETER;
-    goto ErrorExit;
+  if ((BmpFileSize > (UINT32) ~0) || (Width == 0) || (Height == 0)) {
+    return EFI_INVALID_PARAMETER;
   }
 
-  BmpHeader = AllocateZeroPool (BmpBufferSize);   // Insure unfilled area is zeroed
-  if (NULL == BmpHeader) {
+  StripLines = (UINT32)MAX (1, PRINT_SCREEN_STRIP_SIZE / (Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)));
+  StripLines = MIN (StripLines, Height);
+
+  BmpHeader = AllocateZeroPool (HeaderSize);   // Insure unfilled area is zeroed
+  BltStrip  = AllocatePool (StripLines * Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  BmpStrip  = AllocateZeroPool (StripLines * DataSizePerLine);  // Row padding stays zero
+  if ((BmpHeader == NULL) || (BltStrip == NULL) || (BmpStrip == NULL)) {
     Status = EFI_OUT_OF_RESOURCES;
     goto ErrorExit;
   }
 
-  Status = EFI_SUCCESS;
-
   BmpHeader->CharB           = 'B';   // Header flag
   BmpHeader->CharM           = 'M';
-  BmpHeader->Size            = (UINT32)BmpBufferSize;
+  BmpHeader->Size            = (UINT32)BmpFileSize;
   BmpHeader->Reserved[0]     = 0;
   BmpHeader->Reserved[1]     = 0;
-  BmpHeader->ImageOffset     = (sizeof (BMP_IMAGE_HEADER) + 3) & ~0x03; // Start first row on 4 byte boundary
+  BmpHeader->ImageOffset     = (UINT32)HeaderSize;
   BmpHeader->HeaderSize      = sizeof (BMP_IMAGE_HEADER) - OFFSET_OF (BMP_IMAGE_HEADER, HeaderSize);
   BmpHeader->PixelWidth      = Width;
   BmpHeader->PixelHeight     = Height;
   BmpHeader->Planes          = 1;
-  BmpHeader->BitPerPixel     = 24;
+  BmpHeader->BitPerPixel     = BMP_BITS_PER_PIXEL;
   BmpHeader->CompressionType = 0;     // Not Compressed
   BmpHeader->ImageSize       = 0;
   BmpHeader->XPixelsPerMeter = 11000;    // Approximately 300 dpi
@@ -293,40 +359,52 @@ WriteBmpToFile (
   BmpHeader->NumberOfColors  = 0;
   BmpHeader->ImportantColors = 0;
 
-  Image = ((UINT8 *)BmpHeader) + BmpHeader->ImageOffset;
-
-  for (Height = 0; Height < BmpHeader->PixelHeight; Height++) {
-    Blt = &BltBuffer[(BmpHeader->PixelHeight - Height - 1) * BmpHeader->PixelWidth];
-    for (Width = 0; Width < BmpHeader->PixelWidth; Width++, Blt++) {
-      if (Gop->Mode->Info->PixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
-        *Image++ = Blt->Red;
-        *Image++ = Blt->Green;
-        *Image++ = Blt->Blue;
-      } else {
-        // PixelBlueGreenRedReserved8BitPerColor
-        *Image++ = Blt->Blue;
-        *Image++ = Blt->Green;
-        *Image++ = Blt->Red;
-      }
+  Status = WriteBmpData (FileHandle, BmpHeader, HeaderSize);
+  if (EFI_ERROR (Status)) {
+    goto ErrorExit;
+  }
+
+  //
+  // BMP rows are stored bottom up, so read the screen from the bottom strip up
+  // and write the rows of each strip in reverse.
+  //
+  for (Top = Height; Top > 0; Top -= Lines) {
+    Lines = MIN (StripLines, Top);
+
+    Status = Gop->Blt (
+                    Gop,
+                    BltStrip,
+                    EfiBltVideoToBltBuffer,
+                    0,
+                    Top - Lines,
+                    0,
+                    0,
+                    Width,
+                    Lines,
+                    0
+                    );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "Unable to BLt video to buffer, code=%r\n", Status));
+      goto ErrorExit;
     }
 
-    Image = (UINT8 *)(((UINT64)Image + 3) & ~0x03);        // Start next row on 4 byte boundary.
-  }
+    for (Line = 0; Line < Lines; Line++) {
+      PackBltRowToBmp (&BmpStrip[Line * DataSizePerLine], &BltStrip[(Lines - Line - 1) * Width], Width);
+    }
 
-  WriteSize = BmpBufferSize;
-  Status    = FileHandle->Write (FileHandle, &WriteSize, BmpHeader);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "Error writing Bmp file. Code=%r\n", Status));
+    Status = WriteBmpData (FileHandle, BmpStrip, Lines * DataSizePerLine);
+    if (EFI_ERROR (Status)) {
+      goto ErrorExit;
+    }
   }
 
-  if (WriteSize != BmpBufferSize) {
-    DEBUG ((DEBUG_ERROR, "Wrong number of bytes written.  S/B=%ld, Actual=%ld\n", BmpBufferSize, WriteSize));
-    Status = EFI_BAD_BUFFER_SIZE;
+ErrorExit:
+  if (BltStrip != NULL) {
+    FreePool (BltStrip);
   }
 
-ErrorExit:
-  if (BltBuffer != NULL) {
-    FreePool (BltBuffer);
+  if (BmpStrip != NULL) {
+    FreePool (BmpStrip);
   }
 
   if (BmpHeader != NULL) {
@@ -31,6 +31,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define MAX_PRINT_SCREEN_FILES        512
 #define PRINT_SCREEN_DEBUG_WARNING    32
 
+//
+// The screen is read and written this many bytes of scan lines at a time, so
+// a capture never holds a full copy of the screen in memory.
+//
+#define PRINT_SCREEN_STRIP_SIZE  SIZE_256KB
+
 //
 // Print Screen Delay.  There appears to be no way to see the difference between
 // PrtScn key down and key up.  So, we get called twice.  Also, the PrtScn key appears
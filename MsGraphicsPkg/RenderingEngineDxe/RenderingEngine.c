@@ -13,6 +13,7 @@ Copyright (C) Microsoft Corporation. All rights reserved.
 //
 #define SURFACE_FRAME_SAMPLE_REFRESH_INTERVAL  (200 * 10 * 1000)            // Sample surface frames: 200ms in 100ns units
 #define SURFACE_FRAME_SAMPLE_PIXEL_SPACING     50                           // Pixel spacing when checking whether the surface frame has been changed.
+#define SHADOW_FRAME_BUFFER_FLUSH_INTERVAL     (16 * 10 * 1000)             // Flush the shadow framebuffer: 16ms in 100ns units.
 
 // ****** Global variables ******
 //
@@ -21,8 +22,10 @@ EFI_HANDLE                    mSREGopHandle;
 EFI_GRAPHICS_OUTPUT_PROTOCOL  *mParentGop;
 RENDERING_ENGINE_CONTEXT      mSRE;
 EFI_EVENT                     mSampleSurfaceFrameTimerEvent;
+EFI_EVENT                     mFlushShadowFrameBufferTimerEvent;
 EFI_GUID                      *mMsGopOverrideProtocolGuid;
 BOOLEAN                       mPreExitBootServices = FALSE;
+BOOLEAN                       mShadowFrameBufferEnabled = FALSE;
 
 // ****** Typedefs and structures ******
 //
@@ -55,6 +58,28 @@ CalculateSurfaceFrameChecksum (
   IN  SRE_SURFACE_LIST  *Surface
   );
 
+static
+VOID
+CaptureSurfaceDamage (
+  IN  SRE_SURFACE_LIST  *Surface,
+  IN  SWM_RECT          Rect,
+  IN  BOOLEAN           HidePointer
+  );
+
+static
+EFI_STATUS
+ScreenBlt (
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *BltBuffer,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN  UINTN                              SourceX,
+  IN  UINTN                              SourceY,
+  IN  UINTN                              DestinationX,
+  IN  UINTN                              DestinationY,
+  IN  UINTN                              Width,
+  IN  UINTN                              Height,
+  IN  UINTN                              Delta
+  );
+
 VOID
 DisplaySurfaceList (
   VOID
@@ -93,24 +118,25 @@ DrawMousePointer (
   IN UINTN    NewOrigY
   )
 {
-  EFI_STATUS  Status = EFI_SUCCESS;
-  UINTN       Index;
+  EFI_STATUS        Status = EFI_SUCCESS;
+  UINTN             Index;
+  SRE_SURFACE_LIST  *Surface;
+  SWM_RECT          PointerRect;
 
   // Restore the location where the mouse pointer currently resides with the original screen content.
   //
   if (TRUE == mSRE.ShowingMousePointer) {
-    mParentGop->Blt (
-                  mParentGop,
-                  mSRE.MousePointerBackBuffer,
-                  EfiBltBufferToVideo,
-                  0,
-                  0,
-                  mSRE.MousePointerOrigX,
-                  mSRE.MousePointerOrigY,
-                  mSRE.MousePointerWidth,
-                  mSRE.MousePointerHeight,
-                  0
-                  );
+    ScreenBlt (
+      mSRE.MousePointerBackBuffer,
+      EfiBltBufferToVideo,
+      0,
+      0,
+      mSRE.MousePointerOrigX,
+      mSRE.MousePointerOrigY,
+      mSRE.MousePointerWidth,
+      mSRE.MousePointerHeight,
+      0
+      );
   }
 
   // If we don't need to show the mouse pointer, we're done.
@@ -119,35 +145,49 @@ DrawMousePointer (
     goto Exit;
   }
 
+  // Recapture any surface damage under the new location before the pointer covers it.
+  //
+  SWM_RECT_INIT2 (
+    PointerRect,
+    (UINT32)NewOrigX,
+    (UINT32)NewOrigY,
+    (UINT32)mSRE.MousePointerWidth,
+    (UINT32)mSRE.MousePointerHeight
+    );
+
+  Surface = mSRE.Surfaces;
+  while (NULL != Surface) {
+    CaptureSurfaceDamage (Surface, PointerRect, FALSE);
+    Surface = Surface->pNext;
+  }
+
   // Otherwise capture screen contents at the new location.
   //
-  mParentGop->Blt (
-                mParentGop,
-                mSRE.MousePointerBackBuffer,
-                EfiBltVideoToBltBuffer,
-                NewOrigX,
-                NewOrigY,
-                0,
-                0,
-                mSRE.MousePointerWidth,
-                mSRE.MousePointerHeight,
-                0
-                );
+  ScreenBlt (
+    mSRE.MousePointerBackBuffer,
+    EfiBltVideoToBltBuffer,
+    NewOrigX,
+    NewOrigY,
+    0,
+    0,
+    mSRE.MousePointerWidth,
+    mSRE.MousePointerHeight,
+    0
+    );
 
   // Proceed to draw the mouse pointer at the new location.
   //
-  mParentGop->Blt (
-                mParentGop,
-                mSRE.MousePointerBltBuffer,
-                EfiBltVideoToBltBuffer,
-                NewOrigX,
-                NewOrigY,
-                0,
-                0,
-                mSRE.MousePointerWidth,
-                mSRE.MousePointerHeight,
-                0
-                );
+  ScreenBlt (
+    mSRE.MousePointerBltBuffer,
+    EfiBltVideoToBltBuffer,
+    NewOrigX,
+    NewOrigY,
+    0,
+    0,
+    mSRE.MousePointerWidth,
+    mSRE.MousePointerHeight,
+    0
+    );
 
   // Logically "OR" the mouse pointer into the blt buffer
   //
@@ -163,18 +203,17 @@ DrawMousePointer (
 
   // Blt the result to the screen
   //
-  mParentGop->Blt (
-                mParentGop,
-                mSRE.MousePointerBltBuffer,
-                EfiBltBufferToVideo,
-                0,
-                0,
-                NewOrigX,
-                NewOrigY,
-                mSRE.MousePointerWidth,
-                mSRE.MousePointerHeight,
-                0
-                );
+  ScreenBlt (
+    mSRE.MousePointerBltBuffer,
+    EfiBltBufferToVideo,
+    0,
+    0,
+    NewOrigX,
+    NewOrigY,
+    mSRE.MousePointerWidth,
+    mSRE.MousePointerHeight,
+    0
+    );
 
 Exit:
 
@@ -208,6 +247,458 @@ RectsOverlap (
   return XOverlap && YOverlap;
 }
 
+static
+BOOLEAN
+IntersectRects (
+  IN  SWM_RECT  A,
+  IN  SWM_RECT  B,
+  OUT SWM_RECT  *Result
+  )
+{
+  if (FALSE == RectsOverlap (A, B)) {
+    return FALSE;
+  }
+
+  Result->Left   = MAX (A.Left, B.Left);
+  Result->Top    = MAX (A.Top, B.Top);
+  Result->Right  = MIN (A.Right, B.Right);
+  Result->Bottom = MIN (A.Bottom, B.Bottom);
+
+  return TRUE;
+}
+
+static
+UINT64
+RectArea (
+  IN SWM_RECT  Rect
+  )
+{
+  return MultU64x32 (SWM_RECT_WIDTH (Rect), SWM_RECT_HEIGHT (Rect));
+}
+
+static
+VOID
+AddDirtyRect (
+  IN SWM_RECT  Rect
+  )
+{
+  UINTN     Index;
+  UINTN     BestIndex;
+  UINT64    BestGrowth;
+  UINT64    Growth;
+  SWM_RECT  Bounds;
+
+  // Merge the dirty rectangle with those it can share a flush with, which is when their bounding rectangle is no larger than the two of them
+  // together.  Flushing more of the shadow framebuffer than changed is harmless, so this only bounds the extra pixels flushed.
+  //
+  Index = 0;
+  while (Index < mSRE.DirtyCount) {
+    Bounds.Left   = MIN (Rect.Left, mSRE.DirtyRect[Index].Left);
+    Bounds.Top    = MIN (Rect.Top, mSRE.DirtyRect[Index].Top);
+    Bounds.Right  = MAX (Rect.Right, mSRE.DirtyRect[Index].Right);
+    Bounds.Bottom = MAX (Rect.Bottom, mSRE.DirtyRect[Index].Bottom);
+
+    if (RectArea (Bounds) > RectArea (Rect) + RectArea (mSRE.DirtyRect[Index])) {
+      Index++;
+      continue;
+    }
+
+    // Replace the merged entry and try again, since the larger rectangle may now merge with others.
+    //
+    Rect = Bounds;
+    mSRE.DirtyCount--;
+    mSRE.DirtyRect[Index] = mSRE.DirtyRect[mSRE.DirtyCount];
+    Index                 = 0;
+  }
+
+  if (mSRE.DirtyCount < SRE_MAX_DIRTY_RECTS) {
+    mSRE.DirtyRect[mSRE.DirtyCount] = Rect;
+    mSRE.DirtyCount++;
+    return;
+  }
+
+  // If there's no room, grow the dirty rectangle that grows the least, so the number of flushes per frame stays bounded.
+  //
+  BestIndex  = 0;
+  BestGrowth = MAX_UINT64;
+  for (Index = 0; Index < mSRE.DirtyCount; Index++) {
+    Bounds.Left   = MIN (Rect.Left, mSRE.DirtyRect[Index].Left);
+    Bounds.Top    = MIN (Rect.Top, mSRE.DirtyRect[Index].Top);
+    Bounds.Right  = MAX (Rect.Right, mSRE.DirtyRect[Index].Right);
+    Bounds.Bottom = MAX (Rect.Bottom, mSRE.DirtyRect[Index].Bottom);
+
+    Growth = RectArea (Bounds) - RectArea (mSRE.DirtyRect[Index]);
+    if (Growth < BestGrowth) {
+      BestGrowth = Growth;
+      BestIndex  = Index;
+    }
+  }
+
+  mSRE.DirtyRect[BestIndex].Left   = MIN (Rect.Left, mSRE.DirtyRect[BestIndex].Left);
+  mSRE.DirtyRect[BestIndex].Top    = MIN (Rect.Top, mSRE.DirtyRect[BestIndex].Top);
+  mSRE.DirtyRect[BestIndex].Right  = MAX (Rect.Right, mSRE.DirtyRect[BestIndex].Right);
+  mSRE.DirtyRect[BestIndex].Bottom = MAX (Rect.Bottom, mSRE.DirtyRect[BestIndex].Bottom);
+}
+
+static
+EFI_STATUS
+ScreenBlt (
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *BltBuffer,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN  UINTN                              SourceX,
+  IN  UINTN                              SourceY,
+  IN  UINTN                              DestinationX,
+  IN  UINTN                              DestinationY,
+  IN  UINTN                              Width,
+  IN  UINTN                              Height,
+  IN  UINTN                              Delta
+  )
+{
+  EFI_STATUS  Status;
+  SWM_RECT    DirtyRect;
+
+  // Without a shadow framebuffer, blit to the parent GOP directly.
+  //
+  if (NULL == mSRE.ShadowFrameBuffer) {
+    return mParentGop->Blt (
+                         mParentGop,
+                         BltBuffer,
+                         BltOperation,
+                         SourceX,
+                         SourceY,
+                         DestinationX,
+                         DestinationY,
+                         Width,
+                         Height,
+                         Delta
+                         );
+  }
+
+  // Otherwise blit to the shadow framebuffer, and remember the area it changed for the next flush.
+  //
+  Status = FrameBufferBlt (
+             mSRE.ShadowConfigure,
+             BltBuffer,
+             BltOperation,
+             SourceX,
+             SourceY,
+             DestinationX,
+             DestinationY,
+             Width,
+             Height,
+             Delta
+             );
+
+  if (!EFI_ERROR (Status) && (EfiBltVideoToBltBuffer != BltOperation)) {
+    SWM_RECT_INIT2 (
+      DirtyRect,
+      (UINT32)DestinationX,
+      (UINT32)DestinationY,
+      (UINT32)Width,
+      (UINT32)Height
+      );
+
+    AddDirtyRect (DirtyRect);
+  }
+
+  return Status;
+}
+
+static
+VOID
+FlushShadowFrameBuffer (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  // Copy the areas of the shadow framebuffer that changed since the last flush to the parent GOP.
+  //
+  for (Index = 0; Index < mSRE.DirtyCount; Index++) {
+    mParentGop->Blt (
+                  mParentGop,
+                  mSRE.ShadowFrameBuffer,
+                  EfiBltBufferToVideo,
+                  mSRE.DirtyRect[Index].Left,
+                  mSRE.DirtyRect[Index].Top,
+                  mSRE.DirtyRect[Index].Left,
+                  mSRE.DirtyRect[Index].Top,
+                  SWM_RECT_WIDTH (mSRE.DirtyRect[Index]),
+                  SWM_RECT_HEIGHT (mSRE.DirtyRect[Index]),
+                  mSRE.ShadowWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                  );
+  }
+
+  mSRE.DirtyCount = 0;
+}
+
+VOID
+EFIAPI
+FlushShadowFrameBufferTimerCallback (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  // Raise the TPL to avoid getting interrupted while we access shared data structures.
+  //
+  EFI_TPL  PreviousTPL = gBS->RaiseTPL (TPL_NOTIFY);
+
+  FlushShadowFrameBuffer ();
+
+  // Restore the TPL.
+  //
+  gBS->RestoreTPL (PreviousTPL);
+}
+
+static
+VOID
+ReleaseShadowFrameBuffer (
+  VOID
+  )
+{
+  // Flush what is still pending, after which blits go to the parent GOP directly.
+  //
+  if (NULL != mSRE.ShadowFrameBuffer) {
+    FlushShadowFrameBuffer ();
+    FreePool (mSRE.ShadowFrameBuffer);
+    mSRE.ShadowFrameBuffer = NULL;
+  }
+
+  if (NULL != mSRE.ShadowConfigure) {
+    FreePool (mSRE.ShadowConfigure);
+    mSRE.ShadowConfigure = NULL;
+  }
+
+  mSRE.DirtyCount = 0;
+}
+
+static
+EFI_STATUS
+ConfigureShadowFrameBuffer (
+  VOID
+  )
+{
+  EFI_STATUS                            Status;
+  EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  ShadowInfo;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL         *ShadowFrameBuffer;
+  FRAME_BUFFER_CONFIGURE                *ShadowConfigure;
+  UINTN                                 ConfigureSize;
+  UINT32                                Width  = mParentGop->Mode->Info->HorizontalResolution;
+  UINT32                                Height = mParentGop->Mode->Info->VerticalResolution;
+
+  ReleaseShadowFrameBuffer ();
+
+  ShadowConfigure   = NULL;
+  ShadowFrameBuffer = AllocatePool (Width * Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  if (NULL == ShadowFrameBuffer) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
+  }
+
+  // The shadow framebuffer holds blit pixels, whatever the pixel format of the parent GOP.
+  //
+  ZeroMem (&ShadowInfo, sizeof (ShadowInfo));
+  ShadowInfo.HorizontalResolution = Width;
+  ShadowInfo.VerticalResolution   = Height;
+  ShadowInfo.PixelFormat          = PixelBlueGreenRedReserved8BitPerColor;
+  ShadowInfo.PixelsPerScanLine    = Width;
+
+  ConfigureSize = 0;
+  Status        = FrameBufferBltConfigure (ShadowFrameBuffer, &ShadowInfo, NULL, &ConfigureSize);
+  if (EFI_BUFFER_TOO_SMALL == Status) {
+    ShadowConfigure = AllocatePool (ConfigureSize);
+    if (NULL == ShadowConfigure) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto Exit;
+    }
+
+    Status = FrameBufferBltConfigure (ShadowFrameBuffer, &ShadowInfo, ShadowConfigure, &ConfigureSize);
+  }
+
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  // Start from the current screen contents.  This is the only time the framebuffer is read.
+  //
+  Status = mParentGop->Blt (
+                         mParentGop,
+                         ShadowFrameBuffer,
+                         EfiBltVideoToBltBuffer,
+                         0,
+                         0,
+                         0,
+                         0,
+                         Width,
+                         Height,
+                         0
+                         );
+
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  mSRE.ShadowFrameBuffer = ShadowFrameBuffer;
+  mSRE.ShadowConfigure   = ShadowConfigure;
+  mSRE.ShadowWidth       = Width;
+  mSRE.ShadowHeight      = Height;
+
+Exit:
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "WARN [SRE]: Failed to configure the shadow framebuffer, blitting to the framebuffer directly (%r).\r\n", Status));
+
+    if (NULL != ShadowFrameBuffer) {
+      FreePool (ShadowFrameBuffer);
+    }
+
+    if (NULL != ShadowConfigure) {
+      FreePool (ShadowConfigure);
+    }
+  }
+
+  return Status;
+}
+
+static
+VOID
+RestoreSurfaceRect (
+  IN SRE_SURFACE_LIST  *Surface,
+  IN SWM_RECT          Rect
+  )
+{
+  // Restore the part of the capture buffer under Rect, which must be inside the surface frame.
+  //
+  ScreenBlt (
+    Surface->pCaptureBuffer,
+    EfiBltBufferToVideo,
+    Rect.Left - Surface->FrameRect.Left,
+    Rect.Top - Surface->FrameRect.Top,
+    Rect.Left,
+    Rect.Top,
+    SWM_RECT_WIDTH (Rect),
+    SWM_RECT_HEIGHT (Rect),
+    SWM_RECT_WIDTH (Surface->FrameRect) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+    );
+}
+
+static
+VOID
+CaptureSurfaceRect (
+  IN SRE_SURFACE_LIST  *Surface,
+  IN SWM_RECT          Rect
+  )
+{
+  // Save the framebuffer under Rect, which must be inside the surface frame, to the capture buffer.
+  //
+  ScreenBlt (
+    Surface->pCaptureBuffer,
+    EfiBltVideoToBltBuffer,
+    Rect.Left,
+    Rect.Top,
+    Rect.Left - Surface->FrameRect.Left,
+    Rect.Top - Surface->FrameRect.Top,
+    SWM_RECT_WIDTH (Rect),
+    SWM_RECT_HEIGHT (Rect),
+    SWM_RECT_WIDTH (Surface->FrameRect) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+    );
+}
+
+static
+VOID
+CaptureSurfaceDamage (
+  IN  SRE_SURFACE_LIST  *Surface,
+  IN  SWM_RECT          Rect,
+  IN  BOOLEAN           HidePointer
+  )
+{
+  UINTN     Index;
+  SWM_RECT  PointerRect;
+
+  SWM_RECT_INIT2 (
+    PointerRect,
+    (UINT32)mSRE.MousePointerOrigX,
+    (UINT32)mSRE.MousePointerOrigY,
+    (UINT32)mSRE.MousePointerWidth,
+    (UINT32)mSRE.MousePointerHeight
+    );
+
+  // Recapture the damage that Rect overlaps, since the framebuffer under it is about to change.
+  //
+  Index = 0;
+  while (Index < Surface->DamageCount) {
+    if (FALSE == RectsOverlap (Surface->DamageRect[Index], Rect)) {
+      Index++;
+      continue;
+    }
+
+    // The mouse pointer mustn't be captured with the screen contents.
+    //
+    if ((TRUE == HidePointer) && (TRUE == mSRE.ShowingMousePointer) && (TRUE == RectsOverlap (PointerRect, Surface->DamageRect[Index]))) {
+      SREShowMousePointer (
+        &mSRE.SREProtocol,
+        FALSE
+        );
+    }
+
+    CaptureSurfaceRect (Surface, Surface->DamageRect[Index]);
+
+    Surface->DamageCount--;
+    Surface->DamageRect[Index] = Surface->DamageRect[Surface->DamageCount];
+  }
+}
+
+static
+VOID
+AddSurfaceDamage (
+  IN SRE_SURFACE_LIST  *Surface,
+  IN SWM_RECT          Rect
+  )
+{
+  UINTN     Index;
+  SWM_RECT  Bounds;
+  SWM_RECT  Overlap;
+  UINT64    OverlapArea;
+
+  // Merge the damage with the damage it covers, is covered by, or is adjacent to along a whole edge.  Only rectangles whose
+  // union is itself a rectangle are merged, because the framebuffer outside the damage may hold the client's surface.
+  //
+  Index = 0;
+  while (Index < Surface->DamageCount) {
+    Bounds.Left   = MIN (Rect.Left, Surface->DamageRect[Index].Left);
+    Bounds.Top    = MIN (Rect.Top, Surface->DamageRect[Index].Top);
+    Bounds.Right  = MAX (Rect.Right, Surface->DamageRect[Index].Right);
+    Bounds.Bottom = MAX (Rect.Bottom, Surface->DamageRect[Index].Bottom);
+
+    OverlapArea = 0;
+    if (TRUE == IntersectRects (Rect, Surface->DamageRect[Index], &Overlap)) {
+      OverlapArea = RectArea (Overlap);
+    }
+
+    if (RectArea (Bounds) + OverlapArea != RectArea (Rect) + RectArea (Surface->DamageRect[Index])) {
+      Index++;
+      continue;
+    }
+
+    // Replace the merged entry and try again, since the larger rectangle may now merge with others.
+    //
+    Rect = Bounds;
+    Surface->DamageCount--;
+    Surface->DamageRect[Index] = Surface->DamageRect[Surface->DamageCount];
+    Index                      = 0;
+  }
+
+  // If there's no room to track the damage, recapture it now.
+  //
+  if (Surface->DamageCount >= SRE_MAX_DAMAGE_RECTS) {
+    CaptureSurfaceRect (Surface, Rect);
+    return;
+  }
+
+  Surface->DamageRect[Surface->DamageCount] = Rect;
+  Surface->DamageCount++;
+}
+
 static
 EFI_STATUS
 EFIAPI
@@ -228,8 +719,9 @@ SREBlt (
   EFI_TPL           PreviousTPL = 0;
   SRE_SURFACE_LIST  *Surface;
   SWM_RECT          BltRect;
+  SWM_RECT          SourceRect;
+  SWM_RECT          DamageRect;
   SWM_RECT          PointerRect;
-  UINT32            FrameWidth, FrameHeight;
   BOOLEAN           MousePointerState = mSRE.ShowingMousePointer;
 
   // Current blit operation bounding rectangle.
@@ -265,49 +757,67 @@ SREBlt (
       );
   }
 
-  // First see if the blit intersects with one of the active surfaces.  If it does, restore surface back buffer contents first.  We ignore
-  // a surface if the blitting flag is set so that drawing to a surface doesn't trigger a self-refresh.
+  // First see if the blit intersects with one of the active surfaces.  We ignore a surface if the blitting flag is set so that drawing to a
+  // surface doesn't trigger a self-refresh.  Only the area the blit reads from or writes to is restored and recaptured: the rest of the
+  // capture buffer still holds the screen contents underlying the client's window.
   //
   Surface = mSRE.Surfaces;
   while ((NULL != Surface) && (EfiBltVideoToBltBuffer != BltOperation)) {
-    if ((TRUE  == Surface->Active) &&
-        (FALSE == Surface->BlittingSurface) &&
-        ((TRUE  == RectsOverlap (Surface->FrameRect, BltRect)) || (Surface->FrameChecksum != CalculateSurfaceFrameChecksum (Surface))))
-    {
-      FrameWidth  = SWM_RECT_WIDTH (Surface->FrameRect);
-      FrameHeight = SWM_RECT_HEIGHT (Surface->FrameRect);
-
-      // Remember that we need to notify the client to redraw.
-      //
-      Surface->PaintNotify = TRUE;
+    if (TRUE == Surface->Active) {
+      if (TRUE == Surface->BlittingSurface) {
+        // The client is drawing over screen contents that changed since they were captured, so recapture them first.
+        //
+        CaptureSurfaceDamage (Surface, BltRect, TRUE);
+      } else if (TRUE == RectsOverlap (Surface->FrameRect, BltRect)) {
+        // Remember that we need to notify the client to redraw.
+        //
+        Surface->PaintNotify = TRUE;
 
-      // If restoring the screen under the surface intersects with the mouse, we need to temporarily hide the mouse pointer.
-      //
-      if ((TRUE == mSRE.ShowingMousePointer) && (TRUE == RectsOverlap (PointerRect, Surface->FrameRect))) {
-        SREShowMousePointer (
-          &mSRE.SREProtocol,
-          FALSE
+        // Fills and buffer to video blits write every pixel of the blit rectangle, so only a video to video blit needs the screen contents
+        // restored, under the area it copies from.
+        //
+        SWM_RECT_INIT2 (
+          SourceRect,
+          (UINT32)SourceX,
+          (UINT32)SourceY,
+          (UINT32)Width,
+          (UINT32)Height
           );
-      }
 
-      // Restore the contents to the framebuffer.
-      //
-      mParentGop->Blt (
-                    mParentGop,
-                    Surface->pCaptureBuffer,
-                    EfiBltBufferToVideo,
-                    0,
-                    0,
-                    Surface->FrameRect.Left,
-                    Surface->FrameRect.Top,
-                    FrameWidth,
-                    FrameHeight,
-                    0
-                    );
+        if ((EfiBltVideoToVideo == BltOperation) && (TRUE == IntersectRects (Surface->FrameRect, SourceRect, &DamageRect))) {
+          if ((TRUE == mSRE.ShowingMousePointer) && (TRUE == RectsOverlap (PointerRect, DamageRect))) {
+            SREShowMousePointer (
+              &mSRE.SREProtocol,
+              FALSE
+              );
+          }
 
-      // Re-calculate the surface frame checksum.
-      //
-      Surface->FrameChecksum = CalculateSurfaceFrameChecksum (Surface);
+          CaptureSurfaceDamage (Surface, DamageRect, TRUE);
+          RestoreSurfaceRect (Surface, DamageRect);
+        }
+      } else if (Surface->FrameChecksum != CalculateSurfaceFrameChecksum (Surface)) {
+        // Someone accessed the framebuffer directly, so the whole surface is restored.
+        //
+        Surface->PaintNotify = TRUE;
+
+        // If restoring the screen under the surface intersects with the mouse, we need to temporarily hide the mouse pointer.
+        //
+        if ((TRUE == mSRE.ShowingMousePointer) && (TRUE == RectsOverlap (PointerRect, Surface->FrameRect))) {
+          SREShowMousePointer (
+            &mSRE.SREProtocol,
+            FALSE
+            );
+        }
+
+        // Restore the contents to the framebuffer.
+        //
+        CaptureSurfaceDamage (Surface, Surface->FrameRect, TRUE);
+        RestoreSurfaceRect (Surface, Surface->FrameRect);
+
+        // Re-calculate the surface frame checksum.
+        //
+        Surface->FrameChecksum = CalculateSurfaceFrameChecksum (Surface);
+      }
     }
 
     Surface = Surface->pNext;
@@ -315,48 +825,30 @@ SREBlt (
 
   // Perform the caller's requested blit operation.
   //
-  mParentGop->Blt (
-                mParentGop,
-                BltBuffer,
-                BltOperation,
-                SourceX,
-                SourceY,
-                DestinationX,
-                DestinationY,
-                Width,
-                Height,
-                Delta
-                );
-
-  // Now that we've finished the caller's requested blitting, recapture the contents underlying any active client surface that intersected with the blit rectangle.
-  // Note that we ignore video to blit buffer operations since these don't affect the framebuffer.
+  ScreenBlt (
+    BltBuffer,
+    BltOperation,
+    SourceX,
+    SourceY,
+    DestinationX,
+    DestinationY,
+    Width,
+    Height,
+    Delta
+    );
+
+  // Now that we've finished the caller's requested blitting, record the part of any active client surface that intersected with the blit
+  // rectangle as damage.  It is recaptured before anything else draws over it, which lets repeated blits to the same area, such as a
+  // blinking cursor or a progress bar, be recaptured once.  Note that we ignore video to blit buffer operations since these don't affect
+  // the framebuffer.
   //
   Surface = mSRE.Surfaces;
   while ((NULL != Surface) && (EfiBltVideoToBltBuffer != BltOperation)) {
-    // Capture screen contents for any surfaces that intersected with the blit operation.  Again, we can ignore any surfaces which are marked
-    // with the blitting flag in order to avoid triggering a refresh.
+    // Again, we can ignore any surfaces which are marked with the blitting flag in order to avoid triggering a refresh.
     //
-    if (TRUE  == Surface->Active) {
-      if ((FALSE == Surface->BlittingSurface) &&
-          (TRUE  == RectsOverlap (Surface->FrameRect, BltRect)))
-      {
-        FrameWidth  = SWM_RECT_WIDTH (Surface->FrameRect);
-        FrameHeight = SWM_RECT_HEIGHT (Surface->FrameRect);
-
-        // Save the contents of the framebuffer to this capture buffer.
-        //
-        mParentGop->Blt (
-                      mParentGop,
-                      Surface->pCaptureBuffer,
-                      EfiBltVideoToBltBuffer,
-                      Surface->FrameRect.Left,
-                      Surface->FrameRect.Top,
-                      0,
-                      0,
-                      FrameWidth,
-                      FrameHeight,
-                      FrameWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
-                      );
+    if ((TRUE == Surface->Active) && (TRUE == IntersectRects (Surface->FrameRect, BltRect, &DamageRect))) {
+      if (FALSE == Surface->BlittingSurface) {
+        AddSurfaceDamage (Surface, DamageRect);
       }
 
       // Re-calculate the surface frame checksum.
@@ -422,6 +914,13 @@ SRESetMode (
                          mParentGop,
                          ModeNumber
                          );
+
+  // The shadow framebuffer must match the resolution of the new mode.
+  //
+  if (!EFI_ERROR (Status) && (NULL != mSRE.ShadowFrameBuffer)) {
+    mSRE.DirtyCount = 0;
+    ConfigureShadowFrameBuffer ();
+  }
   // Restore the TPL.
   //
   gBS->RestoreTPL (PreviousTPL);
@@ -626,13 +1125,25 @@ CalculateSurfaceFrameChecksum (
 {
   UINT32                         Width  = SWM_RECT_WIDTH (Surface->FrameRect);
   UINT32                         Height = SWM_RECT_HEIGHT (Surface->FrameRect);
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *FrameBuffer;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *SurfaceOrigin;
+  UINT32                         PixelsPerScanLine;
   UINT32                         Offset;
   UINT32                         Checksum = 0;
 
+  // Sample the shadow framebuffer when there is one, so the framebuffer isn't read.
+  //
+  if (NULL != mSRE.ShadowFrameBuffer) {
+    FrameBuffer       = mSRE.ShadowFrameBuffer;
+    PixelsPerScanLine = mSRE.ShadowWidth;
+  } else {
+    FrameBuffer       = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)(UINTN)mParentGop->Mode->FrameBufferBase;
+    PixelsPerScanLine = mParentGop->Mode->Info->PixelsPerScanLine;
+  }
+
   // Sample top edge.
   //
-  SurfaceOrigin = ((EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)mParentGop->Mode->FrameBufferBase + (Surface->FrameRect.Top * mParentGop->Mode->Info->PixelsPerScanLine) + Surface->FrameRect.Left);
+  SurfaceOrigin = (FrameBuffer + (Surface->FrameRect.Top * PixelsPerScanLine) + Surface->FrameRect.Left);
   for (Offset = 0; Offset < Width; Offset += SURFACE_FRAME_SAMPLE_PIXEL_SPACING) {
     Checksum += *(UINT32 *)(SurfaceOrigin + Offset);
   }
@@ -641,18 +1152,18 @@ CalculateSurfaceFrameChecksum (
   //
   for (Offset = 0; Offset < Height; Offset += SURFACE_FRAME_SAMPLE_PIXEL_SPACING) {
     // Left edge.
-    Checksum += *(UINT32 *)(SurfaceOrigin + (Offset * mParentGop->Mode->Info->PixelsPerScanLine));
+    Checksum += *(UINT32 *)(SurfaceOrigin + (Offset * PixelsPerScanLine));
 
     // Midpoint bisecting line.
-    Checksum += *(UINT32 *)(SurfaceOrigin + (Offset * mParentGop->Mode->Info->PixelsPerScanLine) + ((Width - 1) /2));
+    Checksum += *(UINT32 *)(SurfaceOrigin + (Offset * PixelsPerScanLine) + ((Width - 1) /2));
 
     // Right edge.
-    Checksum += *(UINT32 *)(SurfaceOrigin + (Offset * mParentGop->Mode->Info->PixelsPerScanLine) + (Width - 1));
+    Checksum += *(UINT32 *)(SurfaceOrigin + (Offset * PixelsPerScanLine) + (Width - 1));
   }
 
   // Sample bottom edge.
   //
-  SurfaceOrigin = ((EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)mParentGop->Mode->FrameBufferBase + ((Surface->FrameRect.Bottom - 1) * mParentGop->Mode->Info->PixelsPerScanLine) + Surface->FrameRect.Left);
+  SurfaceOrigin = (FrameBuffer + ((Surface->FrameRect.Bottom - 1) * PixelsPerScanLine) + Surface->FrameRect.Left);
   for (Offset = 0; Offset < Width; Offset += SURFACE_FRAME_SAMPLE_PIXEL_SPACING) {
     Checksum += *(UINT32 *)(SurfaceOrigin + Offset);
   }
@@ -846,24 +1357,26 @@ SREResizeSurface (
 
           // Restore the contents to the framebuffer.
           //
-          mParentGop->Blt (
-                        mParentGop,
-                        Surface->pCaptureBuffer,
-                        EfiBltBufferToVideo,
-                        0,
-                        0,
-                        Surface->FrameRect.Left,
-                        Surface->FrameRect.Top,
-                        Width,
-                        Height,
-                        0
-                        );
+          CaptureSurfaceDamage (Surface, Surface->FrameRect, FALSE);
+          ScreenBlt (
+            Surface->pCaptureBuffer,
+            EfiBltBufferToVideo,
+            0,
+            0,
+            Surface->FrameRect.Left,
+            Surface->FrameRect.Top,
+            Width,
+            Height,
+            0
+            );
         }
 
         FreePool (Surface->pCaptureBuffer);
         Surface->pCaptureBuffer = NULL;
       }
 
+      Surface->DamageCount = 0;
+
       // Capture the new frame rectangle.
       //
       CopyMem (&Surface->FrameRect, FrameRect, sizeof (SWM_RECT));
@@ -885,18 +1398,17 @@ SREResizeSurface (
       if (TRUE == Surface->Active) {
         // Save the contents of the framebuffer to this capture buffer.
         //
-        mParentGop->Blt (
-                      mParentGop,
-                      Surface->pCaptureBuffer,
-                      EfiBltVideoToBltBuffer,
-                      Surface->FrameRect.Left,
-                      Surface->FrameRect.Top,
-                      0,
-                      0,
-                      Width,
-                      Height,
-                      0
-                      );
+        ScreenBlt (
+          Surface->pCaptureBuffer,
+          EfiBltVideoToBltBuffer,
+          Surface->FrameRect.Left,
+          Surface->FrameRect.Top,
+          0,
+          0,
+          Width,
+          Height,
+          0
+          );
 
         // Compute the surface frame checksum.
         //
@@ -980,23 +1492,27 @@ SREActivateSurface (
       if (TRUE == MakeActive) {
         Surface->PreviousActive = ActiveSurface;
         if (ActiveSurface != NULL) {
+          // The screen contents under the previous surface aren't tracked while it is inactive, so recapture its damage now.
+          //
+          CaptureSurfaceDamage (ActiveSurface, ActiveSurface->FrameRect, FALSE);
           ActiveSurface->Active = FALSE;
         }
 
         // Save the contents of the framebuffer to this capture buffer.
         //
-        mParentGop->Blt (
-                      mParentGop,
-                      Surface->pCaptureBuffer,
-                      EfiBltVideoToBltBuffer,
-                      Surface->FrameRect.Left,
-                      Surface->FrameRect.Top,
-                      0,
-                      0,
-                      FrameWidth,
-                      FrameHeight,
-                      0
-                      );
+        ScreenBlt (
+          Surface->pCaptureBuffer,
+          EfiBltVideoToBltBuffer,
+          Surface->FrameRect.Left,
+          Surface->FrameRect.Top,
+          0,
+          0,
+          FrameWidth,
+          FrameHeight,
+          0
+          );
+
+        Surface->DamageCount = 0;
       } else {
         if (Surface->PreviousActive != NULL) {
           Surface->PreviousActive->Active = TRUE;
@@ -1005,33 +1521,32 @@ SREActivateSurface (
 
         // Restore the contents to the framebuffer.
         //
+        CaptureSurfaceDamage (Surface, Surface->FrameRect, FALSE);
 
         if (mPreExitBootServices) {
-          mParentGop->Blt (
-                        mParentGop,
-                        &BlackPixel,
-                        EfiBltVideoFill,
-                        0,
-                        0,
-                        Surface->FrameRect.Left,
-                        Surface->FrameRect.Top,
-                        FrameWidth,
-                        FrameHeight,
-                        0
-                        );
+          ScreenBlt (
+            &BlackPixel,
+            EfiBltVideoFill,
+            0,
+            0,
+            Surface->FrameRect.Left,
+            Surface->FrameRect.Top,
+            FrameWidth,
+            FrameHeight,
+            0
+            );
         } else {
-          mParentGop->Blt (
-                        mParentGop,
-                        Surface->pCaptureBuffer,
-                        EfiBltBufferToVideo,
-                        0,
-                        0,
-                        Surface->FrameRect.Left,
-                        Surface->FrameRect.Top,
-                        FrameWidth,
-                        FrameHeight,
-                        0
-                        );
+          ScreenBlt (
+            Surface->pCaptureBuffer,
+            EfiBltBufferToVideo,
+            0,
+            0,
+            Surface->FrameRect.Left,
+            Surface->FrameRect.Top,
+            FrameWidth,
+            FrameHeight,
+            0
+            );
         }
       }
 
@@ -1219,6 +1734,31 @@ InitializeRenderingEngine (
   mSRE.Gop.SetMode   = SRESetMode;
   mSRE.Gop.Mode      = mParentGop->Mode;                        // Reference our parent's Mode structure directly.
 
+  // With a shadow framebuffer, blits operate on system memory and a periodic timer flushes the areas they changed to the parent GOP.
+  //
+  if (mShadowFrameBufferEnabled && !EFI_ERROR (ConfigureShadowFrameBuffer ())) {
+    Status = gBS->CreateEvent (
+                    EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    FlushShadowFrameBufferTimerCallback,
+                    NULL,
+                    &mFlushShadowFrameBufferTimerEvent
+                    );
+
+    if (!EFI_ERROR (Status)) {
+      Status = gBS->SetTimer (
+                      mFlushShadowFrameBufferTimerEvent,
+                      TimerPeriodic,
+                      SHADOW_FRAME_BUFFER_FLUSH_INTERVAL
+                      );
+    }
+
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "ERROR [SRE]: Failed to start the shadow framebuffer flush timer (%r).\r\n", Status));
+      ReleaseShadowFrameBuffer ();
+    }
+  }
+
   // Install our Rendering Engine protocol.
   //
   mSRE.SREProtocol.SetMousePointer  = SRESetMousePointer;
@@ -1419,6 +1959,16 @@ SREDriverStop (
          0
          );
 
+  // Cancel the shadow framebuffer flush timer.
+  //
+  if (NULL != mFlushShadowFrameBufferTimerEvent) {
+    gBS->SetTimer (
+           mFlushShadowFrameBufferTimerEvent,
+           TimerCancel,
+           0
+           );
+  }
+
   // Uninstall protocol interfaces.
   //
   Status = gBS->UninstallMultipleProtocolInterfaces (
@@ -1443,6 +1993,10 @@ SREDriverStop (
       );
   }
 
+  // Flush and free the shadow framebuffer.
+  //
+  ReleaseShadowFrameBuffer ();
+
   // Close the parent (real) GOP.
   //
   gBS->CloseProtocol (
@@ -1464,6 +2018,7 @@ Exit:
 
 /**
     Change Deactivate to ignore the original background, and only paint black at PreExitBootServices.
+    The shadow framebuffer is flushed and released, so the screen is up to date for the OS.
 
     @param    Event           Not Used.
     @param    Context         Not Used.
@@ -1478,6 +2033,7 @@ OnPreExitBootServicesNotification (
   )
 {
   mPreExitBootServices = TRUE;
+  ReleaseShadowFrameBuffer ();
   gBS->CloseEvent (Event);
 }
 
@@ -1506,6 +2062,7 @@ DriverInit (
   mImageHandle = ImageHandle;
 
   mMsGopOverrideProtocolGuid = PcdGetPtr (PcdMsGopOverrideProtocolGuid);
+  mShadowFrameBufferEnabled  = FeaturePcdGet (PcdRenderingEngineShadowFrameBuffer);
 
   // Install the Driver Binding Protocol.
   //
@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/DxeServicesTableLib.h>
+#include <Library/FrameBufferBltLib.h>
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -26,6 +27,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 // ****** Preprocessor constants ******
 //
+#define SRE_MAX_DAMAGE_RECTS  8                                             // Framebuffer areas a surface tracks before recapturing them immediately.
+#define SRE_MAX_DIRTY_RECTS   16                                            // Shadow framebuffer areas flushed to the parent GOP per frame.
 
 // ****** Function prototypes ******
 //
@@ -99,6 +102,8 @@ typedef struct _SRE_SURFACE_LIST_tag {
   SWM_RECT                         FrameRect;               // Clients on-screen window frame rectangle (used for hit detection).
   UINT32                           FrameChecksum;           // Simple checksum from a sampling of surface frame pixels (used to detect surface changes from someone accessing the framebuffer directly).
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *pCaptureBuffer;         // Buffer for capturing screen contents underlying the client's window area.
+  UINTN                            DamageCount;             // Number of valid entries in DamageRect.
+  SWM_RECT                         DamageRect[SRE_MAX_DAMAGE_RECTS]; // Framebuffer areas under the window that were blitted to but not yet recaptured to pCaptureBuffer.
   EFI_HANDLE                       ImageHandle;             // Image handle associated with the surface context.
   struct _SRE_SURFACE_LIST_tag     *PreviousActive;         // Previous ACTIVE Surface
   struct _SRE_SURFACE_LIST_tag     *pNext;                  // Next surface in the list.
@@ -126,6 +131,15 @@ typedef struct _RENDERING_ENGINE_CONTEXT_tag_ {
   //
   SRE_SURFACE_LIST                 *Surfaces;
 
+  // Shadow framebuffer-related members.  When ShadowFrameBuffer is NULL, blits go to the parent GOP directly.
+  //
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *ShadowFrameBuffer;                // System memory copy of the screen that all blits operate on.
+  FRAME_BUFFER_CONFIGURE           *ShadowConfigure;                  // FrameBufferBltLib configuration for ShadowFrameBuffer.
+  UINT32                           ShadowWidth;
+  UINT32                           ShadowHeight;
+  UINTN                            DirtyCount;                        // Number of valid entries in DirtyRect.
+  SWM_RECT                         DirtyRect[SRE_MAX_DIRTY_RECTS];    // Shadow framebuffer areas not yet flushed to the parent GOP.
+
   // Protocols.
   //
   EFI_GRAPHICS_OUTPUT_PROTOCOL     Gop;
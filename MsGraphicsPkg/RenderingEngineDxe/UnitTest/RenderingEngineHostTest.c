@@ -0,0 +1,720 @@
+/** @file
+  This module tests how the Rendering Engine keeps the screen contents under an active
+  surface while other blits draw over it, and measures the bytes it moves to do so, with
+  and without the shadow framebuffer.
+
+  Copyright (c) Microsoft Corporation
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+#include <Library/UnitTestLib.h>
+#include "../RenderingEngineInternal.h"
+
+#define UNIT_TEST_NAME     "Rendering Engine Host Test"
+#define UNIT_TEST_VERSION  "0.1"
+
+#define TEST_SCREEN_WIDTH    1024
+#define TEST_SCREEN_HEIGHT   768
+#define TEST_POINTER_SIZE    16
+#define TEST_CONTROLLER      ((EFI_HANDLE)(UINTN)0x1000)
+#define TEST_SURFACE_HANDLE  ((EFI_HANDLE)(UINTN)0x2000)
+#define TEST_FIRST_EVENT     0x3000
+#define TEST_MAX_EVENTS      4
+
+extern RENDERING_ENGINE_CONTEXT  mSRE;
+extern EFI_GUID                  *mMsGopOverrideProtocolGuid;
+extern BOOLEAN                   mShadowFrameBufferEnabled;
+
+typedef struct {
+  CHAR8    *Name;                             // Name of the UI interaction.
+  UINTN    BltCount;                          // Number of blits the interaction makes.
+  VOID     (*Blt)(UINTN Index);               // Makes one blit of the interaction.
+} TEST_INTERACTION;
+
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL         mFrameBuffer[TEST_SCREEN_WIDTH * TEST_SCREEN_HEIGHT];
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL         mExpected[TEST_SCREEN_WIDTH * TEST_SCREEN_HEIGHT]; // Screen without the surface.
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL         mTextBuffer[320 * 20];
+STATIC UINT32                                mPointerBitmap[TEST_POINTER_SIZE * TEST_POINTER_SIZE];
+STATIC UINT64                                mBytesMoved;
+STATIC UINT64                                mCallerBytes;
+STATIC UINT64                                mBytesRead;
+STATIC UINTN                                 mEventCount;
+STATIC EFI_EVENT_NOTIFY                      mTimerNotify[TEST_MAX_EVENTS];
+STATIC BOOLEAN                               mTimerPeriodic[TEST_MAX_EVENTS];
+STATIC SWM_RECT                              mSurfaceRect = { 256, 160, 767, 607 };
+STATIC EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  mModeInfo;
+STATIC EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE     mMode;
+STATIC EFI_GRAPHICS_OUTPUT_PROTOCOL          mTestParentGop;
+STATIC EFI_DRIVER_BINDING_PROTOCOL           mTestDriverBinding;
+STATIC EFI_BOOT_SERVICES                     mTestBootServices;
+
+/**
+  Performs a blit on a screen buffer the way a GOP does.
+**/
+STATIC
+VOID
+TestBltToScreen (
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *Screen,
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *BltBuffer,
+  IN EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN UINTN                              SourceX,
+  IN UINTN                              SourceY,
+  IN UINTN                              DestinationX,
+  IN UINTN                              DestinationY,
+  IN UINTN                              Width,
+  IN UINTN                              Height,
+  IN UINTN                              Delta
+  )
+{
+  UINTN  Row;
+  UINTN  Column;
+  UINTN  Line;
+
+  if (Delta == 0) {
+    Delta = Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  }
+
+  Delta /= sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  for (Row = 0; Row < Height; Row++) {
+    // Copy the lines from the bottom up when a video to video blit moves them down.
+    Line = ((BltOperation == EfiBltVideoToVideo) && (DestinationY > SourceY)) ? Height - 1 - Row : Row;
+    switch (BltOperation) {
+      case EfiBltVideoFill:
+        for (Column = 0; Column < Width; Column++) {
+          Screen[(DestinationY + Line) * TEST_SCREEN_WIDTH + DestinationX + Column] = *BltBuffer;
+        }
+
+        break;
+      case EfiBltVideoToBltBuffer:
+        CopyMem (
+          &BltBuffer[(DestinationY + Line) * Delta + DestinationX],
+          &Screen[(SourceY + Line) * TEST_SCREEN_WIDTH + SourceX],
+          Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+          );
+        break;
+      case EfiBltBufferToVideo:
+        CopyMem (
+          &Screen[(DestinationY + Line) * TEST_SCREEN_WIDTH + DestinationX],
+          &BltBuffer[(SourceY + Line) * Delta + SourceX],
+          Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+          );
+        break;
+      case EfiBltVideoToVideo:
+        CopyMem (
+          &Screen[(DestinationY + Line) * TEST_SCREEN_WIDTH + DestinationX],
+          &Screen[(SourceY + Line) * TEST_SCREEN_WIDTH + SourceX],
+          Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+          );
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+/**
+  Blt of the parent GOP, which counts the bytes moved to or from the framebuffer, and
+  the bytes read from it.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+TestParentBlt (
+  IN  EFI_GRAPHICS_OUTPUT_PROTOCOL       *This,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *BltBuffer,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN  UINTN                              SourceX,
+  IN  UINTN                              SourceY,
+  IN  UINTN                              DestinationX,
+  IN  UINTN                              DestinationY,
+  IN  UINTN                              Width,
+  IN  UINTN                              Height,
+  IN  UINTN                              Delta
+  )
+{
+  TestBltToScreen (mFrameBuffer, BltBuffer, BltOperation, SourceX, SourceY, DestinationX, DestinationY, Width, Height, Delta);
+  mBytesMoved += Width * Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  if ((BltOperation == EfiBltVideoToBltBuffer) || (BltOperation == EfiBltVideoToVideo)) {
+    mBytesRead += Width * Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_TPL
+EFIAPI
+TestRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+STATIC
+VOID
+EFIAPI
+TestRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestOpenProtocol (
+  IN  EFI_HANDLE  Handle,
+  IN  EFI_GUID    *Protocol,
+  OUT VOID        **Interface OPTIONAL,
+  IN  EFI_HANDLE  AgentHandle,
+  IN  EFI_HANDLE  ControllerHandle,
+  IN  UINT32      Attributes
+  )
+{
+  if (Interface != NULL) {
+    *Interface = &mTestParentGop;
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestInstallMultipleProtocolInterfaces (
+  IN OUT EFI_HANDLE  *Handle,
+  ...
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestUninstallMultipleProtocolInterfaces (
+  IN EFI_HANDLE  Handle,
+  ...
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestCloseProtocol (
+  IN EFI_HANDLE  Handle,
+  IN EFI_GUID    *Protocol,
+  IN EFI_HANDLE  AgentHandle,
+  IN EFI_HANDLE  ControllerHandle
+  )
+{
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestCreateEvent (
+  IN  UINT32            Type,
+  IN  EFI_TPL           NotifyTpl,
+  IN  EFI_EVENT_NOTIFY  NotifyFunction OPTIONAL,
+  IN  VOID              *NotifyContext OPTIONAL,
+  OUT EFI_EVENT         *Event
+  )
+{
+  // Only the timer events, which have no context, are signaled by the test.
+  //
+  if ((Type & EVT_TIMER) != 0) {
+    if (mEventCount >= TEST_MAX_EVENTS) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    mTimerNotify[mEventCount]   = NotifyFunction;
+    mTimerPeriodic[mEventCount] = FALSE;
+    *Event                      = (EFI_EVENT)(UINTN)(TEST_FIRST_EVENT + mEventCount);
+    mEventCount++;
+  } else {
+    *Event = (EFI_EVENT)(UINTN)(TEST_FIRST_EVENT + TEST_MAX_EVENTS);
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+TestSetTimer (
+  IN  EFI_EVENT        Event,
+  IN  EFI_TIMER_DELAY  Type,
+  IN  UINT64           TriggerTime
+  )
+{
+  UINTN  Index;
+
+  Index = (UINTN)Event - TEST_FIRST_EVENT;
+  if (Index < mEventCount) {
+    mTimerPeriodic[Index] = (Type == TimerPeriodic);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Signals the periodic timers, as happens once per frame.
+**/
+STATIC
+VOID
+TestTick (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < mEventCount; Index++) {
+    if (mTimerPeriodic[Index] && (mTimerNotify[Index] != NULL)) {
+      mTimerNotify[Index]((EFI_EVENT)(UINTN)(TEST_FIRST_EVENT + Index), NULL);
+    }
+  }
+}
+
+/**
+  Makes a blit that doesn't come from the surface's client, to the screen and to the
+  expected screen contents.
+**/
+STATIC
+VOID
+TestBackgroundBlt (
+  IN EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *BltBuffer,
+  IN EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN UINTN                              SourceX,
+  IN UINTN                              SourceY,
+  IN UINTN                              DestinationX,
+  IN UINTN                              DestinationY,
+  IN UINTN                              Width,
+  IN UINTN                              Height,
+  IN UINTN                              Delta
+  )
+{
+  TestBltToScreen (mExpected, BltBuffer, BltOperation, SourceX, SourceY, DestinationX, DestinationY, Width, Height, Delta);
+  mCallerBytes += Width * Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  mSRE.Gop.Blt (&mSRE.Gop, BltBuffer, BltOperation, SourceX, SourceY, DestinationX, DestinationY, Width, Height, Delta);
+}
+
+STATIC
+VOID
+TestCursorBlt (
+  IN UINTN  Index
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Color;
+
+  SetMem (&Color, sizeof (Color), ((Index % 2) == 0) ? 0xFF : 0x00);
+  TestBackgroundBlt (&Color, EfiBltVideoFill, 0, 0, 400, 300, 2, 20, 0);
+}
+
+STATIC
+VOID
+TestProgressBarBlt (
+  IN UINTN  Index
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Color = { 0x00, 0xC0, 0x00, 0x00 };
+
+  TestBackgroundBlt (&Color, EfiBltVideoFill, 0, 0, 300 + Index * 6, 500, 6, 16, 0);
+}
+
+STATIC
+VOID
+TestStatusTextBlt (
+  IN UINTN  Index
+  )
+{
+  SetMem (mTextBuffer, sizeof (mTextBuffer), (UINT8)(0x20 + Index));
+  TestBackgroundBlt (mTextBuffer, EfiBltBufferToVideo, 0, 0, 350, 550, 320, 20, 0);
+}
+
+STATIC
+VOID
+TestScrollBlt (
+  IN UINTN  Index
+  )
+{
+  TestBackgroundBlt (NULL, EfiBltVideoToVideo, 300, 210, 300, 200, 200, 100, 0);
+}
+
+STATIC
+VOID
+TestEdgeBlt (
+  IN UINTN  Index
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Color = { 0x80, 0x00, (UINT8)Index, 0x00 };
+
+  TestBackgroundBlt (&Color, EfiBltVideoFill, 0, 0, 200 + Index * 10, 140, 100, 40, 0);
+}
+
+STATIC TEST_INTERACTION  mInteractions[] = {
+  { "Blinking cursor",  20, TestCursorBlt      },
+  { "Progress bar",     64, TestProgressBarBlt },
+  { "Status text",      10, TestStatusTextBlt  },
+  { "Scrolled area",    5,  TestScrollBlt      },
+  { "Window edge",      8,  TestEdgeBlt        }
+};
+
+/**
+  Draws the whole surface the way its client does when it is asked to paint.
+**/
+STATIC
+VOID
+TestPaintSurface (
+  VOID
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Color = { 0xA0, 0x40, 0x20, 0x00 };
+
+  mSRE.SREProtocol.SetModeSurface (&mSRE.SREProtocol, TEST_SURFACE_HANDLE, PAINT_BEGIN);
+  mSRE.Gop.Blt (
+             &mSRE.Gop,
+             &Color,
+             EfiBltVideoFill,
+             0,
+             0,
+             mSurfaceRect.Left,
+             mSurfaceRect.Top,
+             SWM_RECT_WIDTH (mSurfaceRect),
+             SWM_RECT_HEIGHT (mSurfaceRect),
+             0
+             );
+  mSRE.SREProtocol.SetModeSurface (&mSRE.SREProtocol, TEST_SURFACE_HANDLE, PAINT_END);
+}
+
+/**
+  Fills the screen with a pattern and shows an active surface over it.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestShowSurface (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  EFI_EVENT   PaintEvent;
+  UINTN       Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (mExpected); Index++) {
+    mExpected[Index].Blue  = (UINT8)(Index % TEST_SCREEN_WIDTH);
+    mExpected[Index].Green = (UINT8)(Index / TEST_SCREEN_WIDTH);
+    mExpected[Index].Red   = (UINT8)(Index >> 4);
+  }
+
+  mSRE.Gop.Blt (&mSRE.Gop, mExpected, EfiBltBufferToVideo, 0, 0, 0, 0, TEST_SCREEN_WIDTH, TEST_SCREEN_HEIGHT, 0);
+
+  Status = mSRE.SREProtocol.CreateSurface (&mSRE.SREProtocol, TEST_SURFACE_HANDLE, mSurfaceRect, &PaintEvent);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Status = mSRE.SREProtocol.ActivateSurface (&mSRE.SREProtocol, TEST_SURFACE_HANDLE, TRUE);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  TestPaintSurface ();
+  TestTick ();
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Removes the surface shown by TestShowSurface.
+**/
+STATIC
+VOID
+EFIAPI
+TestDeleteSurface (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  mSRE.SREProtocol.ShowMousePointer (&mSRE.SREProtocol, FALSE);
+  mSRE.SREProtocol.DeleteSurface (&mSRE.SREProtocol, TEST_SURFACE_HANDLE);
+}
+
+/**
+  Makes every interaction over the surface, with the client painting the surface when it
+  is asked to and the mouse pointer moving over it, then checks that removing the surface
+  shows the screen as the blits left it once the next frame is presented.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestSurfaceRestoresBackground (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Interaction;
+  UINTN       Index;
+
+  Status = mSRE.SREProtocol.ShowMousePointer (&mSRE.SREProtocol, TRUE);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  for (Interaction = 0; Interaction < ARRAY_SIZE (mInteractions); Interaction++) {
+    for (Index = 0; Index < mInteractions[Interaction].BltCount; Index++) {
+      mInteractions[Interaction].Blt (Index);
+      mSRE.SREProtocol.MoveMousePointer (&mSRE.SREProtocol, (UINT32)(390 + Index * 3), (UINT32)(290 + Interaction * 40));
+      if ((Index % 4) == 3) {
+        TestPaintSurface ();
+      }
+    }
+
+    if (mSRE.Surfaces->PaintNotify) {
+      mSRE.Surfaces->PaintNotify = FALSE;
+      TestPaintSurface ();
+    }
+  }
+
+  Status = mSRE.SREProtocol.ShowMousePointer (&mSRE.SREProtocol, FALSE);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Status = mSRE.SREProtocol.ActivateSurface (&mSRE.SREProtocol, TEST_SURFACE_HANDLE, FALSE);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  TestTick ();
+  UT_ASSERT_MEM_EQUAL (mFrameBuffer, mExpected, sizeof (mFrameBuffer));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Measures the bytes the Rendering Engine moves, beyond the blits themselves, for each
+  interaction over the surface, and compares them with restoring and recapturing the whole
+  surface on every blit.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestBytesMovedPerInteraction (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN   Interaction;
+  UINTN   Index;
+  UINT64  FrameBytes;
+  UINT64  EngineBytes;
+  UINT64  FullFrameBytes;
+
+  FrameBytes = (UINT64)SWM_RECT_WIDTH (mSurfaceRect) * SWM_RECT_HEIGHT (mSurfaceRect) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+
+  for (Interaction = 0; Interaction < ARRAY_SIZE (mInteractions); Interaction++) {
+    mBytesMoved  = 0;
+    mCallerBytes = 0;
+    for (Index = 0; Index < mInteractions[Interaction].BltCount; Index++) {
+      mInteractions[Interaction].Blt (Index);
+    }
+
+    // The client's paint recaptures the damage the blits left.  The paint itself is the same either way, so it isn't counted.
+    //
+    mSRE.Surfaces->PaintNotify = FALSE;
+    TestPaintSurface ();
+
+    EngineBytes    = mBytesMoved - mCallerBytes - FrameBytes;
+    FullFrameBytes = 2 * FrameBytes * mInteractions[Interaction].BltCount;
+    UT_LOG_INFO (
+      "%a: %d blits of %ld bytes moved %ld bytes for the surface, %ld bytes restoring and recapturing the whole surface\n",
+      mInteractions[Interaction].Name,
+      (UINT32)mInteractions[Interaction].BltCount,
+      mCallerBytes,
+      EngineBytes,
+      FullFrameBytes
+      );
+
+    UT_ASSERT_TRUE (EngineBytes < FullFrameBytes);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Presents one frame for each blit of every interaction over the surface, and checks that
+  the framebuffer is never read and is the same as the shadow framebuffer after each frame.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestShadowFrameBufferFlush (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN   Interaction;
+  UINTN   Index;
+  UINT64  FrameBytes;
+
+  UT_ASSERT_NOT_NULL (mSRE.ShadowFrameBuffer);
+
+  FrameBytes = (UINT64)SWM_RECT_WIDTH (mSurfaceRect) * SWM_RECT_HEIGHT (mSurfaceRect) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+
+  for (Interaction = 0; Interaction < ARRAY_SIZE (mInteractions); Interaction++) {
+    mBytesMoved  = 0;
+    mBytesRead   = 0;
+    mCallerBytes = 0;
+    for (Index = 0; Index < mInteractions[Interaction].BltCount; Index++) {
+      mInteractions[Interaction].Blt (Index);
+      TestTick ();
+      UT_ASSERT_MEM_EQUAL (mFrameBuffer, mSRE.ShadowFrameBuffer, sizeof (mFrameBuffer));
+    }
+
+    mSRE.Surfaces->PaintNotify = FALSE;
+    TestPaintSurface ();
+    TestTick ();
+    UT_ASSERT_MEM_EQUAL (mFrameBuffer, mSRE.ShadowFrameBuffer, sizeof (mFrameBuffer));
+
+    UT_LOG_INFO (
+      "%a: %d frames of %ld bytes flushed %ld bytes, %ld of them for the surface's paint\n",
+      mInteractions[Interaction].Name,
+      (UINT32)mInteractions[Interaction].BltCount,
+      mCallerBytes,
+      mBytesMoved,
+      FrameBytes
+      );
+
+    UT_ASSERT_EQUAL (mBytesRead, 0);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Restarts the Rendering Engine with the shadow framebuffer.
+**/
+STATIC
+VOID
+EFIAPI
+TestStartShadowFrameBuffer (
+  VOID
+  )
+{
+  SREDriverStop (&mTestDriverBinding, TEST_CONTROLLER, 0, NULL);
+
+  mShadowFrameBufferEnabled = TRUE;
+  mEventCount               = 0;
+  SREDriverStart (&mTestDriverBinding, TEST_CONTROLLER, NULL);
+  mSRE.SREProtocol.SetMousePointer (&mSRE.SREProtocol, mPointerBitmap, TEST_POINTER_SIZE, TEST_POINTER_SIZE, 32);
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  Rendering Engine and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UefiTestMain (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      SurfaceSuiteHandle;
+  UNIT_TEST_SUITE_HANDLE      ShadowSuiteHandle;
+  UINTN                       Index;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Start the Rendering Engine on a parent GOP with a framebuffer in memory.
+  //
+  mModeInfo.HorizontalResolution = TEST_SCREEN_WIDTH;
+  mModeInfo.VerticalResolution   = TEST_SCREEN_HEIGHT;
+  mModeInfo.PixelFormat          = PixelBlueGreenRedReserved8BitPerColor;
+  mModeInfo.PixelsPerScanLine    = TEST_SCREEN_WIDTH;
+  mMode.MaxMode                  = 1;
+  mMode.Info                     = &mModeInfo;
+  mMode.SizeOfInfo               = sizeof (mModeInfo);
+  mMode.FrameBufferBase          = (EFI_PHYSICAL_ADDRESS)(UINTN)mFrameBuffer;
+  mMode.FrameBufferSize          = sizeof (mFrameBuffer);
+  mTestParentGop.Blt             = TestParentBlt;
+  mTestParentGop.Mode            = &mMode;
+
+  mTestBootServices.RaiseTPL                            = TestRaiseTpl;
+  mTestBootServices.RestoreTPL                          = TestRestoreTpl;
+  mTestBootServices.OpenProtocol                        = TestOpenProtocol;
+  mTestBootServices.InstallMultipleProtocolInterfaces   = TestInstallMultipleProtocolInterfaces;
+  mTestBootServices.UninstallMultipleProtocolInterfaces = TestUninstallMultipleProtocolInterfaces;
+  mTestBootServices.CloseProtocol                       = TestCloseProtocol;
+  mTestBootServices.CreateEvent                         = TestCreateEvent;
+  mTestBootServices.SetTimer                            = TestSetTimer;
+  gBS                                                   = &mTestBootServices;
+  mMsGopOverrideProtocolGuid                            = &gEfiGraphicsOutputProtocolGuid;
+
+  Status = SREDriverStart (&mTestDriverBinding, TEST_CONTROLLER, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed to start the Rendering Engine. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mPointerBitmap); Index++) {
+    mPointerBitmap[Index] = ((Index % TEST_POINTER_SIZE) <= (Index / TEST_POINTER_SIZE)) ? 0x00FFFFFF : 0;
+  }
+
+  mSRE.SREProtocol.SetMousePointer (&mSRE.SREProtocol, mPointerBitmap, TEST_POINTER_SIZE, TEST_POINTER_SIZE, 32);
+
+  //
+  // Create a suite
+  //
+  Status = CreateUnitTestSuite (&SurfaceSuiteHandle, Framework, "RenderingEngineDxe Surface Blits", "RenderingEngineDxe.Surface.Blt", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for SurfaceSuiteHandle\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // Register Tests
+  //
+  AddTestCase (SurfaceSuiteHandle, "Blits over an active surface keep the screen contents under it", "RestoresBackground", TestSurfaceRestoresBackground, TestShowSurface, TestDeleteSurface, NULL);
+  AddTestCase (SurfaceSuiteHandle, "Bytes moved for the surface per UI interaction", "BytesMoved", TestBytesMovedPerInteraction, TestShowSurface, TestDeleteSurface, NULL);
+
+  Status = CreateUnitTestSuite (&ShadowSuiteHandle, Framework, "RenderingEngineDxe Shadow Framebuffer", "RenderingEngineDxe.ShadowFrameBuffer", TestStartShadowFrameBuffer, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for ShadowSuiteHandle\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (ShadowSuiteHandle, "Blits over an active surface keep the screen contents under it", "RestoresBackground", TestSurfaceRestoresBackground, TestShowSurface, TestDeleteSurface, NULL);
+  AddTestCase (ShadowSuiteHandle, "Each frame is flushed without reading the framebuffer", "Flush", TestShadowFrameBufferFlush, TestShowSurface, TestDeleteSurface, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UefiTestMain ();
+}
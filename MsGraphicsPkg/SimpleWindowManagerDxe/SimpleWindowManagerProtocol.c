@@ -28,23 +28,12 @@ SWMAbsolutePointerReset (
   EFI_STATUS           Status     = EFI_SUCCESS;
   WINMGR_AP_WATCHLIST  *pProvider = mSWM.AbsolutePointerProviders;
   WINMGR_CLIENT        *Client    = WINMGR_CLIENT_FROM_ABS_PTR (this);
-  EFI_TPL              PreviousTPL;
 
   DEBUG ((DEBUG_INFO, "INFO [SWM]: Purging event queue and resetting all Absolute Pointer sources.\r\n"));
 
-  PreviousTPL = gBS->RaiseTPL (TPL_NOTIFY);
-
   // Purge the event queue (removes old pending events).
   //
-  Client->Queue.bQueueEmpty         = TRUE;
-  Client->Queue.QueueInputPosition  = 0;
-  Client->Queue.QueueOutputPosition = 0;
-
-  // Restore the TPL
-  //
-  if (PreviousTPL) {
-    gBS->RestoreTPL (PreviousTPL);
-  }
+  PurgeAbsolutePointerQueue (Client);
 
   // Call each aggregated Absolute Pointer protocol providers Reset function.
   //
@@ -124,6 +113,9 @@ AbsolutePointerWaitForInput (
   //
   Status = PeekAtAbsolutePointerEventInQueue (Client, &PointerState);
   if (EFI_ERROR (Status)) {
+    // Nothing queued, have the providers scanned instead of waiting for the next periodic scan.
+    //
+    RequestPointerProviderScan ();
     goto Exit;
   }
 
@@ -385,6 +377,7 @@ SWMUnregisterClient (
         }
       }
 
+      PurgeAbsolutePointerQueue (pList);
       gBS->CloseEvent (pList->ClientAbsPtr.WaitForInput);
       FreePool (pList);
 
@@ -794,3 +787,52 @@ SWMEnableMousePointer (
 
   return Status;
 }
+
+/**
+    Returns the pointer event queue statistics of the client.
+
+    @param[in]   This         Pointer to the instance of this driver.
+    @param[in]   ImageHandle  Image handle representing the client.
+    @param[out]  Statistics   Queue depth, high water mark, dropped and coalesced event counts.
+
+    @retval EFI_SUCCESS            Statistics were returned.
+    @retval EFI_INVALID_PARAMETER  Statistics is NULL or the client isn't registered.
+
+**/
+EFI_STATUS
+EFIAPI
+SWMGetPointerQueueStatistics (
+  IN  MS_SIMPLE_WINDOW_MANAGER_PROTOCOL  *This,
+  IN  EFI_HANDLE                         ImageHandle,
+  OUT SWM_POINTER_QUEUE_STATISTICS       *Statistics
+  )
+{
+  EFI_STATUS     Status = EFI_INVALID_PARAMETER;
+  WINMGR_CLIENT  *pList = mSWM.Clients;
+  EFI_TPL        PreviousTPL;
+
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  // Raise the TPL so the counts are read as a consistent snapshot.
+  //
+  PreviousTPL = gBS->RaiseTPL (TPL_NOTIFY);
+
+  while (pList != NULL) {
+    if (pList->ImageHandle == ImageHandle) {
+      Statistics->Depth     = pList->Queue.Depth;
+      Statistics->HighWater = pList->Queue.HighWater;
+      Statistics->Dropped   = pList->Queue.Dropped;
+      Statistics->Coalesced = pList->Queue.Coalesced;
+      Status                = EFI_SUCCESS;
+      break;
+    }
+
+    pList = pList->pNext;
+  }
+
+  gBS->RestoreTPL (PreviousTPL);
+
+  return Status;
+}
@@ -287,4 +287,23 @@ SWMWaitForEvent (
   IN BOOLEAN    ContinueTimer
   );
 
+/**
+    Returns the pointer event queue statistics of the client.
+
+    @param[in]   This         Pointer to the instance of this driver.
+    @param[in]   ImageHandle  Image handle representing the client.
+    @param[out]  Statistics   Queue depth, high water mark, dropped and coalesced event counts.
+
+    @retval EFI_SUCCESS            Statistics were returned.
+    @retval EFI_INVALID_PARAMETER  Statistics is NULL or the client isn't registered.
+
+**/
+EFI_STATUS
+EFIAPI
+SWMGetPointerQueueStatistics (
+  IN  MS_SIMPLE_WINDOW_MANAGER_PROTOCOL  *This,
+  IN  EFI_HANDLE                         ImageHandle,
+  OUT SWM_POINTER_QUEUE_STATISTICS       *Statistics
+  );
+
 #endif // _SIMPLE_WINDOW_MANAGER_PROTOCOL_H_
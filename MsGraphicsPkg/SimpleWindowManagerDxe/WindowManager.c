@@ -46,6 +46,9 @@ EFI_EVENT                      mGopRegisterEvent;
 VOID                           *mGopRegistration;
 WINMGR_CONTEXT                 mSWM;
 EFI_EVENT                      mSWMWatchListTimerEvent;
+EFI_EVENT                      mSWMPointerScanEvent = NULL;
+UINTN                          mSWMQuietPointerScans;
+BOOLEAN                        mSWMPointerTimerIdle;
 EFI_ABSOLUTE_POINTER_MODE      mAbsPointerMode;
 EFI_ABSOLUTE_POINTER_PROTOCOL  *mConsplitterAbsolutePointer = NULL;
 
@@ -383,10 +386,14 @@ SignalClient (
 /**
     Inserts the specified pointer event state into an aggregate event queue (FIFO).
 
+    When the queue is full the oldest event is dropped to make room.  When PcdSwmEventDrivenPointerInput
+    is TRUE, a move that doesn't change the buttons replaces the newest queued event if that event is
+    also such a move, so button transitions are always kept.
+
     @param[in] PointerState         Pointer event to insert.
 
     @retval EFI_SUCCESS             Successfully inserted the event state.
-    @retval EFI_OUT_OF_RESOURCES    Event queue overflowed.
+    @retval EFI_BUFFER_TOO_SMALL    Event queue overflowed and the oldest event was dropped.
 
 **/
 static EFI_STATUS
@@ -398,16 +405,41 @@ InsertPointerEventIntoQueue (
   EFI_STATUS                     Status      = EFI_SUCCESS;
   EFI_TPL                        PreviousTPL = 0;
   MS_SWM_ABSOLUTE_POINTER_QUEUE  *Queue      = &Client->Queue;
+  UINT32                         Buttons;
+  UINTN                          Position;
+  BOOLEAN                        bIsMove;
+
+  Buttons = (PointerState->ActiveButtons & 0x1);      // We only recognize the LSB.
 
   // Raise the TPL to avoid race condition with the peek-extract routines.
   //
   PreviousTPL = gBS->RaiseTPL (TPL_NOTIFY);
 
-  // If queue input and output positions collide, there is a buffer overflow
+  bIsMove            = (Buttons == Queue->LastButtons);
+  Queue->LastButtons = Buttons;
+
+  // Merge a move into the newest queued event when that event is a move the client hasn't read yet.
+  //
+  if (FeaturePcdGet (PcdSwmEventDrivenPointerInput) && bIsMove && Queue->bLastIsMove && (FALSE == Queue->bQueueEmpty)) {
+    Position = (Queue->QueueInputPosition + POINTER_STATE_INPUT_QUEUE_SIZE - 1) % POINTER_STATE_INPUT_QUEUE_SIZE;
+    Queue->PointerStateQueue[Position].CurrentX = PointerState->CurrentX;
+    Queue->PointerStateQueue[Position].CurrentY = PointerState->CurrentY;
+    ++Queue->Coalesced;
+
+    // The client was already signalled for the event being replaced.
+    //
+    goto Exit;
+  }
+
+  // If the queue is full, drop the oldest event to make room for the new one.
   //
-  if ((Queue->QueueInputPosition == Queue->QueueOutputPosition) && (FALSE == Queue->bQueueEmpty)) {
-    DEBUG ((DEBUG_WARN, "WARN [SWM]: Pointer event %p queue overflow!\r\n", Queue));
-    // Just throw the queue away and queue the next point
+  if (Queue->Depth == POINTER_STATE_INPUT_QUEUE_SIZE) {
+    ++Queue->QueueOutputPosition;
+    Queue->QueueOutputPosition %= POINTER_STATE_INPUT_QUEUE_SIZE;
+    --Queue->Depth;
+    ++Queue->Dropped;
+    Status = EFI_BUFFER_TOO_SMALL;
+    DEBUG ((DEBUG_WARN, "WARN [SWM]: Pointer event %p queue overflow, %u events dropped.\r\n", Queue, (UINT32)Queue->Dropped));
   }
 
   // Store pointer state data in the queue
@@ -415,13 +447,20 @@ InsertPointerEventIntoQueue (
   Queue->PointerStateQueue[Queue->QueueInputPosition].CurrentX      = PointerState->CurrentX;
   Queue->PointerStateQueue[Queue->QueueInputPosition].CurrentY      = PointerState->CurrentY;
   Queue->PointerStateQueue[Queue->QueueInputPosition].CurrentZ      = 0;                                        // Z should always be 0.
-  Queue->PointerStateQueue[Queue->QueueInputPosition].ActiveButtons = (PointerState->ActiveButtons & 0x1);      // We only recognize the LSB.
+  Queue->PointerStateQueue[Queue->QueueInputPosition].ActiveButtons = Buttons;
 
   // Increment the input position to the next slot and handle wrap-around
   //
   ++Queue->QueueInputPosition;
   Queue->QueueInputPosition %= POINTER_STATE_INPUT_QUEUE_SIZE;
 
+  ++Queue->Depth;
+  if (Queue->Depth > Queue->HighWater) {
+    Queue->HighWater = Queue->Depth;
+  }
+
+  Queue->bLastIsMove = bIsMove;
+
   // No longer the first insertion
   //
   Queue->bQueueEmpty = FALSE;
@@ -430,6 +469,8 @@ InsertPointerEventIntoQueue (
   //
   SignalClient (Client);
 
+Exit:
+
   // Restore the TPL.
   //
   if (PreviousTPL) {
@@ -529,6 +570,8 @@ ExtractAbsolutePointerEventFromQueue (
   ++Queue->QueueOutputPosition;
   Queue->QueueOutputPosition %= POINTER_STATE_INPUT_QUEUE_SIZE;
 
+  --Queue->Depth;
+
   // If queue input and output positions are the same, the queue is empty
   //
   if (Queue->QueueInputPosition == Queue->QueueOutputPosition) {
@@ -548,6 +591,69 @@ Exit:
   return Status;
 }
 
+/**
+    Empties a client's aggregate event queue and logs its queue statistics.
+
+    @param[in] Client               Client whose queue is purged.
+
+    @retval None.
+
+**/
+VOID
+PurgeAbsolutePointerQueue (
+  IN WINMGR_CLIENT  *Client
+  )
+{
+  EFI_TPL                        PreviousTPL = 0;
+  MS_SWM_ABSOLUTE_POINTER_QUEUE  *Queue      = &Client->Queue;
+
+  DEBUG ((
+    DEBUG_INFO,
+    "INFO [SWM]: Pointer event %p queue purged.  Depth=%u, HighWater=%u, Dropped=%u, Coalesced=%u\r\n",
+    Queue,
+    (UINT32)Queue->Depth,
+    (UINT32)Queue->HighWater,
+    (UINT32)Queue->Dropped,
+    (UINT32)Queue->Coalesced
+    ));
+
+  // Raise the TPL to avoid race condition with the insert-extract routines.
+  //
+  PreviousTPL = gBS->RaiseTPL (TPL_NOTIFY);
+
+  Queue->bQueueEmpty         = TRUE;
+  Queue->QueueInputPosition  = 0;
+  Queue->QueueOutputPosition = 0;
+  Queue->Depth               = 0;
+  Queue->bLastIsMove         = FALSE;
+
+  // Restore the TPL.
+  //
+  if (PreviousTPL) {
+    gBS->RestoreTPL (PreviousTPL);
+  }
+}
+
+/**
+    Requests a scan of the Absolute Pointer providers ahead of the periodic timer.  Only
+    does anything when PcdSwmEventDrivenPointerInput is TRUE.
+
+    @retval None.
+
+**/
+VOID
+RequestPointerProviderScan (
+  VOID
+  )
+{
+  // The scan runs at TPL_CALLBACK as soon as the caller drops below it, so it can be
+  // requested from the TPL_NOTIFY client wait functions.
+  //
+  if (FeaturePcdGet (PcdSwmEventDrivenPointerInput) && (NULL != mSWMPointerScanEvent)) {
+    gBS->SignalEvent (mSWMPointerScanEvent);
+  }
+}
+
 /**
     FilterPointerState      Returns the WINMGR_CLIENT that matches the pointer state.
 
@@ -894,7 +1000,11 @@ Exit:
     Timer Callback that Polls the Absolute Pointer provider watchlist for incoming pointer events,
     and Queues them to the proper queue.
 
-    @param[in] Event                Ignored.
+    When PcdSwmEventDrivenPointerInput is TRUE this also runs when a client waits for pointer input,
+    every pending state is read from each provider, and the periodic timer is slowed down while the
+    providers are quiet.
+
+    @param[in] Event                Timer event, or the pointer scan event.
     @param[in] Context              Ignored.
 
     @retval None.
@@ -911,6 +1021,9 @@ CheckWatchListCallback (
   WINMGR_AP_WATCHLIST  *pList = mSWM.AbsolutePointerProviders;
   WINMGR_CLIENT        *Client;
   UINTN                ScreenMaxX, ScreenMaxY;
+  UINTN                MaxStates;
+  UINTN                StateCount;
+  BOOLEAN              bHadInput = FALSE;
 
   // Get screen coordinate space maximums.
   //
@@ -927,84 +1040,92 @@ CheckWatchListCallback (
     SelectMousePointer ();
   }
 
+  // Polling reads one state per provider per tick.  The event-driven mode reads until the provider
+  // has nothing left, bounded so a chattering device can't hold us here.
+  //
+  MaxStates = FeaturePcdGet (PcdSwmEventDrivenPointerInput) ? POINTER_STATE_INPUT_QUEUE_SIZE : 1;
+
   // Scan the Absolute Pointer provider watchlist and check for signalled events
   // indicating there's state to be read.
   //
   while (pList != NULL) {
-    if (gBS->CheckEvent (pList->AbsolutePointer->WaitForInput) == EFI_SUCCESS) {
+    for (StateCount = 0; StateCount < MaxStates; StateCount++) {
       EFI_ABSOLUTE_POINTER_STATE  PointerState;
       UINTN                       AbsolutePointerMaxX, AbsolutePointerMaxY;
 
+      if (gBS->CheckEvent (pList->AbsolutePointer->WaitForInput) != EFI_SUCCESS) {
+        break;
+      }
+
       Status = pList->AbsolutePointer->GetState (
                                          pList->AbsolutePointer,
                                          &PointerState
                                          );
 
-      if (!EFI_ERROR (Status)) {
-        // Conditionally filter the raw pointer event.  For now, don't filter mouse pointer events (only touch).
-        //
-        if ((FALSE == pList->bNeedsMousePointer) && (TRUE == FilterPointerEvent (&PointerState, pList->AbsolutePointer->Mode))) {
-          // Toss the pointer event.
-          //
-          continue;
-        }
+      if (EFI_ERROR (Status)) {
+        break;
+      }
 
-        // Get Absolute Pointer coordinate space maximums.
-        //
-        AbsolutePointerMaxX = pList->AbsolutePointer->Mode->AbsoluteMaxX;
-        AbsolutePointerMaxY = pList->AbsolutePointer->Mode->AbsoluteMaxY;
+      bHadInput = TRUE;
 
-        // Get screen coordinate space maximums.
+      // Conditionally filter the raw pointer event.  For now, don't filter mouse pointer events (only touch).
+      //
+      if ((FALSE == pList->bNeedsMousePointer) && (TRUE == FilterPointerEvent (&PointerState, pList->AbsolutePointer->Mode))) {
+        // Toss the pointer event.
         //
-        ScreenMaxX = mGop->Mode->Info->HorizontalResolution;
-        ScreenMaxY = mGop->Mode->Info->VerticalResolution;
+        continue;
+      }
 
-        // Fudge in case the request for the mode occurs after a mode set.
-        mAbsPointerMode.AbsoluteMaxX = mGop->Mode->Info->HorizontalResolution;
-        mAbsPointerMode.AbsoluteMaxY = mGop->Mode->Info->VerticalResolution;
+      // Get Absolute Pointer coordinate space maximums.
+      //
+      AbsolutePointerMaxX = pList->AbsolutePointer->Mode->AbsoluteMaxX;
+      AbsolutePointerMaxY = pList->AbsolutePointer->Mode->AbsoluteMaxY;
 
-        // Map touch coordinate space to the current graphics mode coordinate space.
-        //
-        PointerState.CurrentX = MultU64x32 (PointerState.CurrentX, (UINT32)ScreenMaxX);
-        PointerState.CurrentX = DivU64x32 (PointerState.CurrentX, (UINT32)AbsolutePointerMaxX);
+      // Fudge in case the request for the mode occurs after a mode set.
+      mAbsPointerMode.AbsoluteMaxX = ScreenMaxX;
+      mAbsPointerMode.AbsoluteMaxY = ScreenMaxY;
 
-        PointerState.CurrentY = MultU64x32 (PointerState.CurrentY, (UINT32)ScreenMaxY);
-        PointerState.CurrentY = DivU64x32 (PointerState.CurrentY, (UINT32)AbsolutePointerMaxY);
+      // Map touch coordinate space to the current graphics mode coordinate space.
+      //
+      PointerState.CurrentX = MultU64x32 (PointerState.CurrentX, (UINT32)ScreenMaxX);
+      PointerState.CurrentX = DivU64x32 (PointerState.CurrentX, (UINT32)AbsolutePointerMaxX);
 
-        // Range-check the mouse pointer location based on screen size.
-        //
-        if (TRUE == pList->bNeedsMousePointer) {
-          if (PointerState.CurrentX >= (ScreenMaxX - mSWM.MousePointer.Width)) {
-            PointerState.CurrentX = (ScreenMaxX - mSWM.MousePointer.Width - 1);
-          }
-
-          if (PointerState.CurrentY >= (ScreenMaxY - mSWM.MousePointer.Height)) {
-            PointerState.CurrentY = (ScreenMaxY - mSWM.MousePointer.Height - 1);
-          }
+      PointerState.CurrentY = MultU64x32 (PointerState.CurrentY, (UINT32)ScreenMaxY);
+      PointerState.CurrentY = DivU64x32 (PointerState.CurrentY, (UINT32)AbsolutePointerMaxY);
+
+      // Range-check the mouse pointer location based on screen size.
+      //
+      if (TRUE == pList->bNeedsMousePointer) {
+        if (PointerState.CurrentX >= (ScreenMaxX - mSWM.MousePointer.Width)) {
+          PointerState.CurrentX = (ScreenMaxX - mSWM.MousePointer.Width - 1);
         }
 
-        // Display the mouse pointer if needed and update the the mouse pointer location else hide it as needed.
-        //
-        if ((FALSE == pList->bNeedsMousePointer) && (TRUE == mSWM.bDisplayingMousePointer)) {
-          DEBUG ((DEBUG_INFO, "INFO [SWM]: Hiding mouse pointer.\r\n"));
-          HideMousePointer ();
-        } else if ((TRUE == pList->bNeedsMousePointer) && (TRUE == mSWM.bMousePointerEnabled) && (FALSE == mSWM.bDisplayingMousePointer)) {
-          DEBUG ((DEBUG_INFO, "INFO [SWM]: Showing mouse pointer.\r\n"));
-          ShowMousePointer ();
-        } else {
-          MoveMousePointer ((UINTN)PointerState.CurrentX, (UINTN)PointerState.CurrentY, TRUE);
+        if (PointerState.CurrentY >= (ScreenMaxY - mSWM.MousePointer.Height)) {
+          PointerState.CurrentY = (ScreenMaxY - mSWM.MousePointer.Height - 1);
         }
+      }
 
-        // Remember whether this pointer event required drawing the mouse pointer.  We need this should a client (re)enable the mouse pointer
-        // from the SWM protocol interface.  If the last move didn't require a mouse pointer then enabling the pointer will wait for a move event that
-        // requires it instead of immediately rendering the pointer.
-        //
-        mSWM.bLastMoveRequiredMousePointer = pList->bNeedsMousePointer;
+      // Display the mouse pointer if needed and update the the mouse pointer location else hide it as needed.
+      //
+      if ((FALSE == pList->bNeedsMousePointer) && (TRUE == mSWM.bDisplayingMousePointer)) {
+        DEBUG ((DEBUG_INFO, "INFO [SWM]: Hiding mouse pointer.\r\n"));
+        HideMousePointer ();
+      } else if ((TRUE == pList->bNeedsMousePointer) && (TRUE == mSWM.bMousePointerEnabled) && (FALSE == mSWM.bDisplayingMousePointer)) {
+        DEBUG ((DEBUG_INFO, "INFO [SWM]: Showing mouse pointer.\r\n"));
+        ShowMousePointer ();
+      } else {
+        MoveMousePointer ((UINTN)PointerState.CurrentX, (UINTN)PointerState.CurrentY, TRUE);
+      }
 
-        Client = FilterPointerState (&PointerState);
-        if (Client != NULL) {
-          InsertPointerEventIntoQueue (Client, &PointerState);
-        }
+      // Remember whether this pointer event required drawing the mouse pointer.  We need this should a client (re)enable the mouse pointer
+      // from the SWM protocol interface.  If the last move didn't require a mouse pointer then enabling the pointer will wait for a move event that
+      // requires it instead of immediately rendering the pointer.
+      //
+      mSWM.bLastMoveRequiredMousePointer = pList->bNeedsMousePointer;
+
+      Client = FilterPointerState (&PointerState);
+      if (Client != NULL) {
+        InsertPointerEventIntoQueue (Client, &PointerState);
       }
     }
 
@@ -1012,6 +1133,24 @@ CheckWatchListCallback (
     //
     pList = pList->pNext;
   }
+
+  // In the event-driven mode, clients waiting for input request scans, so the periodic timer only needs to
+  // run fast while the providers are producing states.
+  //
+  if (FeaturePcdGet (PcdSwmEventDrivenPointerInput)) {
+    if (bHadInput) {
+      mSWMQuietPointerScans = 0;
+      if (mSWMPointerTimerIdle) {
+        mSWMPointerTimerIdle = FALSE;
+        gBS->SetTimer (mSWMWatchListTimerEvent, TimerPeriodic, PERIODIC_REFRESH_INTERVAL);
+      }
+    } else if ((Event == mSWMWatchListTimerEvent) && !mSWMPointerTimerIdle) {
+      if (++mSWMQuietPointerScans >= IDLE_REFRESH_TICKS) {
+        mSWMPointerTimerIdle = TRUE;
+        gBS->SetTimer (mSWMWatchListTimerEvent, TimerPeriodic, IDLE_REFRESH_INTERVAL);
+      }
+    }
+  }
 }
 
 /**
@@ -1395,14 +1534,15 @@ DriverInitStage2 (
 
   // Install the Simple Window Manager Protocol.
   //
-  mSWM.SWMProtocol.RegisterClient     = SWMRegisterClient;
-  mSWM.SWMProtocol.UnregisterClient   = SWMUnregisterClient;
-  mSWM.SWMProtocol.ActivateWindow     = SWMActivateWindow;
-  mSWM.SWMProtocol.SetWindowFrame     = SWMSetWindowFrame;
-  mSWM.SWMProtocol.BltWindow          = SWMBltWindow;
-  mSWM.SWMProtocol.StringToWindow     = SWMStringToWindow;
-  mSWM.SWMProtocol.EnableMousePointer = SWMEnableMousePointer;
-  mSWM.SWMProtocol.WaitForEvent       = SWMWaitForEvent;
+  mSWM.SWMProtocol.RegisterClient            = SWMRegisterClient;
+  mSWM.SWMProtocol.UnregisterClient          = SWMUnregisterClient;
+  mSWM.SWMProtocol.ActivateWindow            = SWMActivateWindow;
+  mSWM.SWMProtocol.SetWindowFrame            = SWMSetWindowFrame;
+  mSWM.SWMProtocol.BltWindow                 = SWMBltWindow;
+  mSWM.SWMProtocol.StringToWindow            = SWMStringToWindow;
+  mSWM.SWMProtocol.EnableMousePointer        = SWMEnableMousePointer;
+  mSWM.SWMProtocol.WaitForEvent              = SWMWaitForEvent;
+  mSWM.SWMProtocol.GetPointerQueueStatistics = SWMGetPointerQueueStatistics;
 
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &ImageHandle,
@@ -1431,6 +1571,23 @@ DriverInitStage2 (
     goto Exit;
   }
 
+  // Create the event clients signal to scan the watchlist as soon as they wait for pointer input.
+  //
+  if (FeaturePcdGet (PcdSwmEventDrivenPointerInput)) {
+    Status = gBS->CreateEvent (
+                    EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    CheckWatchListCallback,
+                    NULL,
+                    &mSWMPointerScanEvent
+                    );
+
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "ERROR [SWM]: Failed to create the pointer provider scan event.  Status = %r\r\n", Status));
+      goto Exit;
+    }
+  }
+
   // Initialize the Simple Window Manager.
   //
   InitializeWindowManagerContext ();
@@ -1669,6 +1826,11 @@ DriverCleanUp (
     Status = gBS->CloseEvent (mSWMWatchListTimerEvent);
   }
 
+  if (NULL != mSWMPointerScanEvent) {
+    gBS->CloseEvent (mSWMPointerScanEvent);
+    mSWMPointerScanEvent = NULL;
+  }
+
   // Clean up the provider watchlist.
   //
   FreeAbsolutePointerInterfaceWatchList ();
@@ -46,6 +46,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define POINTER_STATE_INPUT_QUEUE_SIZE  50                                  // Depth of aggregate pointer event queue.
 #define PERIODIC_REFRESH_INTERVAL       (5 * 10 * 1000)                     // Interval for scanning AP providers: 5ms in 100ns units.
+#define IDLE_REFRESH_INTERVAL           (25 * 10 * 1000)                    // Event-driven mode interval once the providers go quiet: 25ms in 100ns units.
+#define IDLE_REFRESH_TICKS              100                                 // Event-driven mode quiet periodic scans before switching to the idle interval.
 
 #define SWM_POINTER_EVENT_FILTER_BOX_SIZE_PERCENT  50                       // Filter window in fraction of a percent (0.50%) of the absolute pointer maximum width.
 
@@ -59,6 +61,12 @@ typedef struct {
   BOOLEAN                          bQueueEmpty;
   UINTN                            QueueInputPosition;
   UINTN                            QueueOutputPosition;
+  UINTN                            Depth;                           // Number of events waiting in the queue.
+  UINTN                            HighWater;                       // Largest depth the queue has reached.
+  UINTN                            Dropped;                         // Oldest events dropped because the queue was full.
+  UINTN                            Coalesced;                       // Move events merged into the newest queued move.
+  UINT32                           LastButtons;                     // Buttons of the last inserted event.
+  BOOLEAN                          bLastIsMove;                     // TRUE = newest queued event didn't change the buttons.
   MS_SWM_ABSOLUTE_POINTER_STATE    PointerStateQueue[POINTER_STATE_INPUT_QUEUE_SIZE];
 } MS_SWM_ABSOLUTE_POINTER_QUEUE;
 
@@ -403,4 +411,29 @@ ExtractAbsolutePointerEventFromQueue (
   OUT MS_SWM_ABSOLUTE_POINTER_STATE  *pPointerState
   );
 
+/**
+    Empties a client's aggregate event queue and logs its queue statistics.
+
+    @param[in] Client               Client whose queue is purged.
+
+    @retval None.
+
+**/
+VOID
+PurgeAbsolutePointerQueue (
+  IN WINMGR_CLIENT  *Client
+  );
+
+/**
+    Requests a scan of the Absolute Pointer providers ahead of the periodic timer.  Only
+    does anything when PcdSwmEventDrivenPointerInput is TRUE.
+
+    @retval None.
+
+**/
+VOID
+RequestPointerProviderScan (
+  VOID
+  );
+
 #endif // _WINDOW_MANAGER_H_
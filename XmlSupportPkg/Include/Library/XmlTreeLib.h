@@ -32,9 +32,40 @@ CreateXmlTree (
   OUT       XmlNode  **RootNode
   );
 
+//
+// Options for CreateXmlTreeEx
+//
+// XML_TREE_OPTION_ARENA - All of the nodes, attributes and strings of the tree are carved from a
+//                         few large page blocks.  FreeXmlTree releases the blocks at once.  Nodes and
+//                         attributes of the tree must not be freed with FreePool, and deleting them
+//                         only releases their memory when the whole tree is freed.
+//
+#define XML_TREE_OPTION_ARENA  BIT0
+
+/**
+This function will create a xml tree given an XML document as a ascii string.
+
+@param   XmlDocument     -- XML document to create the node list for.
+@param   SizeXmlDocument -- Length of the document.
+@param   Options         -- XML_TREE_OPTION_* flags for how the tree is stored.
+@param   RootNode        -- The root node that contains the node list.
+
+@return  EFI_SUCCESS or underlying failure code.
+**/
+EFI_STATUS
+EFIAPI
+CreateXmlTreeEx (
+  IN  CONST CHAR8    *XmlDocument,
+  IN        UINTN    SizeXmlDocument,
+  IN        UINT32   Options,
+  OUT       XmlNode  **RootNode
+  );
+
 /**
   This function creates a new XML tree.
 
+  When Parent is in an arena, the new node is carved from the same arena.
+
   @param[in]   Parent   -- Optional parent for this node.
   @param[in]   Name     -- Name for this node.
   @param[in]   Value    -- Optional value for this node.
@@ -55,6 +86,9 @@ AddNode (
 /**
   This function adds an existing tree to a parent node.
 
+  A tree can only be added to a parent in the same arena, or to a parent that is not in
+  an arena when the tree is not either.
+
   @param   Parent   -- Parent to add to.
   @param   Tree     -- Existing Tree to to add to the parent as a child.
 
@@ -218,6 +252,57 @@ XmlUnEscape (
   OUT CHAR8       **String
   );
 
+/**
+Find the first child of a node with a name, and optionally with an attribute that has a value.
+
+Nodes with many children and attributes build an index on the first lookup, so later lookups
+do not walk the children.  The index is dropped when a child or attribute is added or deleted
+through this library.  Changing a node name or an attribute directly requires XmlTreeIndexReset.
+
+@param Parent         - Node whose children are searched
+@param Name           - Name of the child
+@param AttributeName  - Optional name of an attribute the child must have
+@param AttributeValue - Value the attribute must have.  Required when AttributeName is not NULL.
+
+@return The first matching child, or NULL if there is none.
+**/
+XmlNode *
+EFIAPI
+XmlTreeFindChild (
+  IN CONST XmlNode  *Parent,
+  IN CONST CHAR8    *Name,
+  IN CONST CHAR8    *AttributeName OPTIONAL,
+  IN CONST CHAR8    *AttributeValue OPTIONAL
+  );
+
+/**
+Find the first attribute of a node with a name, using the index of the node.
+
+@param Node - Node whose attributes are searched
+@param Name - Name of the attribute
+
+@return The first matching attribute, or NULL if there is none.
+**/
+XmlAttribute *
+EFIAPI
+XmlTreeFindAttribute (
+  IN CONST XmlNode  *Node,
+  IN CONST CHAR8    *Name
+  );
+
+/**
+Drop the lookup indexes that hold a node, after its name, its attributes or its list of
+children were changed directly.  Both the index of the node and the index of its parent
+are dropped.
+
+@param Node - Node that was changed
+**/
+VOID
+EFIAPI
+XmlTreeIndexReset (
+  IN XmlNode  *Node
+  );
+
 /**
 Function to go thru a tree and count the nodes
 **/
@@ -44,4 +44,27 @@ FindFirstAttributeByName (
   IN CONST CHAR8    *AttributeName
   );
 
+/**
+Find a node by a path of element names, such as
+"SettingsPacket/Settings/Setting[Id='Device.Setting.Name']".
+
+Each step of the path is an element name, and can select the child with an attribute value
+with [AttributeName=Value].  The value can be quoted with ' or ".  Each step selects the
+first matching child, using the index of the node.
+
+A path that starts with '/' is absolute, and its first step must match the root of the tree
+that Node is in.  Otherwise the first step is a child of Node.
+
+@param[in]  Node  Node to start from
+@param[in]  Path  Path to the node
+
+@retval XmlNode that matches or NULL if not found or the path is not valid
+**/
+XmlNode *
+EFIAPI
+FindNodeByPath (
+  IN CONST XmlNode  *Node,
+  IN CONST CHAR8    *Path
+  );
+
 #endif
@@ -15,6 +15,16 @@ typedef struct _XmlDeclaration {
   CHAR8    *Declaration;
 } XmlDeclaration;
 
+//
+// Arena a tree can be carved from.  It is private to XmlTreeLib.
+//
+typedef struct _XML_TREE_ARENA XML_TREE_ARENA;
+
+//
+// Index of the children and attributes of a node by name.  It is private to XmlTreeLib.
+//
+typedef struct _XML_NODE_INDEX XML_NODE_INDEX;
+
 // Dev Note:  Keep the LIST_ENTRY item as the first element in all
 //            of these structures, so that we can cast them to
 //            the structure types.
@@ -30,6 +40,8 @@ typedef struct _XmlNode {
   CHAR8              *Name;              // Name of this node.
   CHAR8              *Value;             // Optional value.
   XmlDeclaration     XmlDeclaration;     // Optional XML declaration for the node.
+  XML_TREE_ARENA     *Arena;             // Optional arena the node and its strings are in.
+  XML_NODE_INDEX     *Index;             // Optional index, built by the first lookup that needs it.
 } XmlNode;
 
 typedef struct _XmlAttribute {
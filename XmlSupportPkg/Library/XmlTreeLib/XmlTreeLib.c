@@ -31,6 +31,54 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 // DEFINE the max number of nodes deep the parser will support
 #define MAX_RECURSIVE_LEVEL  (25)
 
+//
+// Arena that the nodes, attributes and strings of a tree are carved from.  Blocks are
+// allocated as pages, each twice the size of the last up to XML_ARENA_MAX_PAGES, and are
+// only released when the tree is freed.
+//
+#define XML_ARENA_MIN_PAGES  (4)
+#define XML_ARENA_MAX_PAGES  (256)
+
+typedef struct _XML_ARENA_BLOCK {
+  struct _XML_ARENA_BLOCK    *Next;       // Block allocated before this one
+  UINTN                      Pages;       // Size of this block in pages
+} XML_ARENA_BLOCK;
+
+struct _XML_TREE_ARENA {
+  XML_ARENA_BLOCK    *Blocks;             // Most recent block
+  UINT8              *Free;               // Next free byte in the most recent block
+  UINTN              Remaining;           // Number of free bytes at Free
+  XmlNode            *Root;               // Root node of the tree, freed with the arena
+};
+
+//
+// Index of the children and attributes of a node.  Each child has an entry for its name
+// and one for each of its attributes with the attribute value, and each attribute of the
+// node has an entry for its name.  Entries of a bucket are chained in document order.
+// Nodes with fewer than XML_NODE_INDEX_MIN_ENTRIES entries are not indexed.  Buffers
+// carved from an arena are never released, so the index of an arena tree is only marked
+// stale when it changes, and is built again in place when it is large enough.
+//
+#define XML_NODE_INDEX_MIN_ENTRIES  (16)
+#define XML_NODE_INDEX_END          MAX_UINT32
+#define XML_NODE_INDEX_SEED         (0x811C9DC5)
+#define XML_NODE_INDEX_PRIME        (0x01000193)
+
+typedef struct {
+  UINT32          Hash;                   // Hash of the key
+  UINT32          Next;                   // Next entry in the bucket, or XML_NODE_INDEX_END
+  XmlNode         *Node;                  // Child in the key, or NULL for an attribute of the node
+  XmlAttribute    *Attribute;             // Attribute in the key, or NULL for a child by name
+} XML_NODE_INDEX_ENTRY;
+
+struct _XML_NODE_INDEX {
+  UINTN                   Size;           // Number of bytes allocated for the index
+  BOOLEAN                 Stale;          // The node changed, so the index is built again before use
+  UINT32                  BucketMask;     // Number of buckets - 1, the number is a power of 2
+  UINT32                  *Buckets;       // First entry of each bucket, or XML_NODE_INDEX_END
+  XML_NODE_INDEX_ENTRY    *Entries;       // Entries, in document order
+};
+
 //
 // Private function prototypes
 //
@@ -47,6 +95,14 @@ _GetXmlEscapedLength (
   IN UINTN        MaxStringLength
   );
 
+EFI_STATUS
+_XmlUnEscape (
+  IN     XML_TREE_ARENA  *Arena OPTIONAL,
+  IN     CONST CHAR8     *EscapedString,
+  IN     UINTN           MaxEscapedStringLength,
+  OUT    CHAR8           **String
+  );
+
 /**
 Given a character, determine if it is white space.
 ch -- Character to test.
@@ -90,28 +146,385 @@ SafeFreeBuffer (
   }
 }// SafeFreeBuffer()
 
-//
-// Public functions
-//
+/**
+Create an arena with a first block sized for a document.
+This is an internal function.
+
+@param SizeHint - Size of the document the tree is built from
+
+@return The arena, or NULL if it could not be allocated.
+**/
+STATIC
+XML_TREE_ARENA *
+_XmlArenaCreate (
+  IN UINTN  SizeHint
+  )
+{
+  XML_ARENA_BLOCK  *Block;
+  XML_TREE_ARENA   *Arena;
+  UINTN            Pages;
+
+  Pages = EFI_SIZE_TO_PAGES (SizeHint);
+  Pages = MIN (MAX (Pages, XML_ARENA_MIN_PAGES), XML_ARENA_MAX_PAGES);
+
+  Block = (XML_ARENA_BLOCK *)AllocatePages (Pages);
+  if (Block == NULL) {
+    DEBUG ((DEBUG_ERROR, "%a - Failed to allocate 0x%X pages\n", __FUNCTION__, Pages));
+    return NULL;
+  }
+
+  Block->Next  = NULL;
+  Block->Pages = Pages;
+
+  //
+  // The arena itself is the first allocation of its first block
+  //
+  Arena = (XML_TREE_ARENA *)(Block + 1);
+  ZeroMem (Arena, sizeof (XML_TREE_ARENA));
+  Arena->Blocks    = Block;
+  Arena->Free      = (UINT8 *)(Arena + 1);
+  Arena->Remaining = EFI_PAGES_TO_SIZE (Pages) - sizeof (XML_ARENA_BLOCK) - sizeof (XML_TREE_ARENA);
+
+  return Arena;
+}
 
 /**
-This function creates a new XML tree.
+Free all of the blocks of an arena, and the arena itself.
+This is an internal function.
+**/
+STATIC
+VOID
+_XmlArenaFree (
+  IN XML_TREE_ARENA  *Arena
+  )
+{
+  XML_ARENA_BLOCK  *Block;
+  XML_ARENA_BLOCK  *Next;
 
-@param[in]   Parent   -- Optional parent for this node.
-@param[in]   Name     -- Name for this node.
-@param[in]   Value    -- Optional value for this node.
-@param[out]  Node     -- Optional return pointer for this node.
+  //
+  // The arena is in its first block, so read the list head before freeing anything
+  //
+  for (Block = Arena->Blocks; Block != NULL; Block = Next) {
+    Next = Block->Next;
+    FreePages (Block, Block->Pages);
+  }
+}
 
-@return  EFI_SUCCESS or underlying failure code.
+/**
+Carve a zeroed buffer from an arena.
+This is an internal function.
+
+@param Arena - Arena to allocate from
+@param Size  - Number of bytes needed
+
+@return The buffer, or NULL if a new block could not be allocated.
+**/
+STATIC
+VOID *
+_XmlArenaAllocate (
+  IN XML_TREE_ARENA  *Arena,
+  IN UINTN           Size
+  )
+{
+  XML_ARENA_BLOCK  *Block;
+  UINTN            Pages;
+  VOID             *Buffer;
+
+  Size = ALIGN_VALUE (Size, sizeof (UINT64));
+  if (Size > Arena->Remaining) {
+    Pages = MIN (Arena->Blocks->Pages * 2, XML_ARENA_MAX_PAGES);
+    Pages = MAX (Pages, EFI_SIZE_TO_PAGES (Size + sizeof (XML_ARENA_BLOCK)));
+
+    Block = (XML_ARENA_BLOCK *)AllocatePages (Pages);
+    if (Block == NULL) {
+      DEBUG ((DEBUG_ERROR, "%a - Failed to allocate 0x%X pages\n", __FUNCTION__, Pages));
+      return NULL;
+    }
+
+    Block->Next      = Arena->Blocks;
+    Block->Pages     = Pages;
+    Arena->Blocks    = Block;
+    Arena->Free      = (UINT8 *)(Block + 1);
+    Arena->Remaining = EFI_PAGES_TO_SIZE (Pages) - sizeof (XML_ARENA_BLOCK);
+  }
+
+  Buffer            = Arena->Free;
+  Arena->Free      += Size;
+  Arena->Remaining -= Size;
+
+  ZeroMem (Buffer, Size);
+  return Buffer;
+}
+
+/**
+Allocate a zeroed buffer for a tree, from its arena if it has one.
+This is an internal function.
+**/
+STATIC
+VOID *
+_XmlAllocate (
+  IN XML_TREE_ARENA  *Arena OPTIONAL,
+  IN UINTN           Size
+  )
+{
+  if (Arena != NULL) {
+    return _XmlArenaAllocate (Arena, Size);
+  }
+
+  return AllocateZeroPool (Size);
+}
+
+/**
+Free a buffer of a tree.  Buffers carved from an arena are only released
+with the whole arena, so they are just forgotten.
+This is an internal function.
+**/
+STATIC
+VOID
+_XmlFree (
+  IN     XML_TREE_ARENA  *Arena OPTIONAL,
+  IN OUT CHAR8           **ppBuff
+  )
+{
+  if (Arena != NULL) {
+    *ppBuff = NULL;
+  } else {
+    SafeFreeBuffer (ppBuff);
+  }
+}
+
+/**
+Fold a string and its NULL terminator into an index hash (FNV-1a).
+This is an internal function.
+**/
+STATIC
+UINT32
+_XmlIndexHash (
+  IN       UINT32  Hash,
+  IN CONST CHAR8   *String
+  )
+{
+  do {
+    Hash = (Hash ^ (UINT8)*String) * XML_NODE_INDEX_PRIME;
+  } while (*String++ != '\0');
+
+  return Hash;
+}
+
+/**
+Hash of the index key for a child by name, or by name and attribute value.
+This is an internal function.
+**/
+STATIC
+UINT32
+_XmlIndexChildHash (
+  IN CONST CHAR8  *Name,
+  IN CONST CHAR8  *AttributeName OPTIONAL,
+  IN CONST CHAR8  *AttributeValue OPTIONAL
+  )
+{
+  UINT32  Hash;
+
+  Hash = _XmlIndexHash (XML_NODE_INDEX_SEED, Name);
+  if (AttributeName != NULL) {
+    Hash = _XmlIndexHash (Hash, AttributeName);
+    Hash = _XmlIndexHash (Hash, AttributeValue);
+  }
+
+  return Hash;
+}
+
+/**
+Hash of the index key for an attribute of the node by name.
+This is an internal function.
+**/
+STATIC
+UINT32
+_XmlIndexAttributeHash (
+  IN CONST CHAR8  *Name
+  )
+{
+  // '@' can't start an element name, so the key is apart from a child of the same name
+  return _XmlIndexHash (_XmlIndexHash (XML_NODE_INDEX_SEED, "@"), Name);
+}
+
+/**
+Drop the index of a node, if it has one.  The index is built again by the
+next lookup that needs it.  The index of an arena tree is kept for that
+lookup to reuse, and is only marked stale.
+This is an internal function.
+**/
+STATIC
+VOID
+_XmlIndexFree (
+  IN XmlNode  *Node OPTIONAL
+  )
+{
+  if ((Node != NULL) && (Node->Index != NULL)) {
+    if (Node->Arena != NULL) {
+      Node->Index->Stale = TRUE;
+    } else {
+      SafeFreeBuffer ((CHAR8 **)&Node->Index);
+    }
+  }
+}
+
+/**
+Add an entry to an index that is being built.  Entries are added last to first,
+so each is put at the head of its bucket.
+This is an internal function.
+
+@param Index - Index being built
+@param Entry - Number of entries that are still free, decremented for the new entry
+
+@return FALSE if all of the entries of the index are already used.
+**/
+STATIC
+BOOLEAN
+_XmlIndexInsert (
+  IN OUT XML_NODE_INDEX  *Index,
+  IN OUT UINT32          *Entry,
+  IN     UINT32          Hash,
+  IN     XmlNode         *Node OPTIONAL,
+  IN     XmlAttribute    *Attribute OPTIONAL
+  )
+{
+  if (*Entry == 0) {
+    return FALSE;
+  }
+
+  (*Entry)--;
+  Index->Entries[*Entry].Hash              = Hash;
+  Index->Entries[*Entry].Node              = Node;
+  Index->Entries[*Entry].Attribute         = Attribute;
+  Index->Entries[*Entry].Next              = Index->Buckets[Hash & Index->BucketMask];
+  Index->Buckets[Hash & Index->BucketMask] = *Entry;
+  return TRUE;
+}
 
+/**
+Get the index of a node, and build it if the node is large enough to need one.
+This is an internal function.
+
+@param Node - Node to get the index of
+
+@return The index, or NULL if the node is too small or the index could not be allocated.
 **/
+STATIC
+XML_NODE_INDEX *
+_XmlIndexGet (
+  IN XmlNode  *Node
+  )
+{
+  XML_NODE_INDEX  *Index;
+  LIST_ENTRY      *Link;
+  LIST_ENTRY      *AttributeLink;
+  XmlNode         *Child;
+  XmlAttribute    *Attribute;
+  UINTN           Count;
+  UINTN           Buckets;
+  UINTN           Size;
+  UINT32          Entry;
+
+  Index = Node->Index;
+  if ((Index != NULL) && !Index->Stale) {
+    return Index;
+  }
+
+  Count = Node->NumChildren + Node->NumAttributes;
+  for (Link = GetFirstNode (&Node->ChildrenListHead); !IsNull (&Node->ChildrenListHead, Link); Link = GetNextNode (&Node->ChildrenListHead, Link)) {
+    Count += ((XmlNode *)Link)->NumAttributes;
+  }
+
+  if ((Count < XML_NODE_INDEX_MIN_ENTRIES) || (Count >= XML_NODE_INDEX_END / 2)) {
+    return NULL;
+  }
+
+  // At most half of the buckets are used
+  Buckets = GetPowerOfTwo32 ((UINT32)Count) * 4;
+  Size    = sizeof (XML_NODE_INDEX) + (Buckets * sizeof (UINT32)) + (Count * sizeof (XML_NODE_INDEX_ENTRY));
+
+  //
+  // A stale index of an arena tree is reused when it is large enough.  Otherwise it is
+  // replaced by one at least twice its size, so a node that keeps growing only leaves
+  // a few stale indexes behind in the arena.
+  //
+  if ((Index == NULL) || (Index->Size < Size)) {
+    if (Index != NULL) {
+      Size = MAX (Size, Index->Size * 2);
+    }
+
+    Index = (XML_NODE_INDEX *)_XmlAllocate (Node->Arena, Size);
+    if (Index == NULL) {
+      DEBUG ((DEBUG_WARN, "%a - No index for node '%a', lookups walk its children\n", __FUNCTION__, Node->Name));
+      return NULL;
+    }
+
+    Index->Size = Size;
+    Node->Index = Index;
+  }
+
+  Index->Stale      = FALSE;
+  Index->BucketMask = (UINT32)(Buckets - 1);
+  Index->Entries    = (XML_NODE_INDEX_ENTRY *)(Index + 1);
+  Index->Buckets    = (UINT32 *)(Index->Entries + Count);
+  SetMem32 (Index->Buckets, Buckets * sizeof (UINT32), XML_NODE_INDEX_END);
+
+  //
+  // Walk the lists backwards, so the buckets end up in document order
+  //
+  Entry = (UINT32)Count;
+  for (Link = GetPreviousNode (&Node->ChildrenListHead, &Node->ChildrenListHead); !IsNull (&Node->ChildrenListHead, Link); Link = GetPreviousNode (&Node->ChildrenListHead, Link)) {
+    Child = (XmlNode *)Link;
+    for (AttributeLink = GetPreviousNode (&Child->AttributesListHead, &Child->AttributesListHead);
+         !IsNull (&Child->AttributesListHead, AttributeLink);
+         AttributeLink = GetPreviousNode (&Child->AttributesListHead, AttributeLink))
+    {
+      Attribute = (XmlAttribute *)AttributeLink;
+      if (!_XmlIndexInsert (Index, &Entry, _XmlIndexChildHash (Child->Name, Attribute->Name, Attribute->Value), Child, Attribute)) {
+        goto MISMATCH;
+      }
+    }
+
+    if (!_XmlIndexInsert (Index, &Entry, _XmlIndexChildHash (Child->Name, NULL, NULL), Child, NULL)) {
+      goto MISMATCH;
+    }
+  }
+
+  for (Link = GetPreviousNode (&Node->AttributesListHead, &Node->AttributesListHead); !IsNull (&Node->AttributesListHead, Link); Link = GetPreviousNode (&Node->AttributesListHead, Link)) {
+    Attribute = (XmlAttribute *)Link;
+    if (!_XmlIndexInsert (Index, &Entry, _XmlIndexAttributeHash (Attribute->Name), NULL, Attribute)) {
+      goto MISMATCH;
+    }
+  }
+
+  if (Entry == 0) {
+    return Index;
+  }
+
+MISMATCH:
+  //
+  // NumChildren or NumAttributes do not match the lists, so the node was changed directly.
+  // Lookups walk its children instead.
+  //
+  DEBUG ((DEBUG_ERROR, "%a - Counts of node '%a' do not match its lists\n", __FUNCTION__, Node->Name));
+  ASSERT (FALSE);
+  _XmlIndexFree (Node);
+  return NULL;
+}
+
+/**
+Internal function to create a new node, carved from Arena when it is not NULL.
+Public function is AddNode.
+**/
+STATIC
 EFI_STATUS
-EFIAPI
-AddNode (
-  IN        XmlNode  *Parent OPTIONAL,
-  IN  CONST CHAR8    *Name,
-  IN  CONST CHAR8    *Value OPTIONAL,
-  OUT       XmlNode  **Node OPTIONAL
+_AddNode (
+  IN        XML_TREE_ARENA  *Arena OPTIONAL,
+  IN        XmlNode         *Parent OPTIONAL,
+  IN  CONST CHAR8           *Name,
+  IN  CONST CHAR8           *Value OPTIONAL,
+  OUT       XmlNode         **Node OPTIONAL
   )
 {
   EFI_STATUS  Status     = EFI_SUCCESS;
@@ -130,13 +543,13 @@ AddNode (
       *Node = NULL;
     }
 
-    NodeTemp = (XmlNode *)AllocateZeroPool (sizeof (XmlNode));
+    NodeTemp = (XmlNode *)_XmlAllocate (Arena, sizeof (XmlNode));
     if (NodeTemp == NULL) {
       Status = EFI_OUT_OF_RESOURCES;
       break;
     }
 
-    NodeName = (CHAR8 *)AllocateZeroPool (AsciiStrLen (Name) + 1);
+    NodeName = (CHAR8 *)_XmlAllocate (Arena, AsciiStrLen (Name) + 1);
     if (NodeName == NULL) {
       Status = EFI_OUT_OF_RESOURCES;
       break;
@@ -148,8 +561,7 @@ AddNode (
     }
 
     if (Value && (*Value != '\0')) {
-      Status = XmlUnEscape (Value, XML_MAX_ELEMENT_VALUE_LENGTH, &NodeValue);
-      // NodeValue = AllocateZeroPool(AsciiStrLen(Value) + 1);
+      Status = _XmlUnEscape (Arena, Value, XML_MAX_ELEMENT_VALUE_LENGTH, &NodeValue);
       if (EFI_ERROR (Status)) {
         break;
       }
@@ -161,6 +573,7 @@ AddNode (
     NodeTemp->ParentNode = Parent;
     NodeTemp->Name       = NodeName;
     NodeTemp->Value      = NodeValue;
+    NodeTemp->Arena      = Arena;
 
     //
     // Initialize our list head entries.
@@ -175,6 +588,7 @@ AddNode (
       //
       // Add the node to the parent's child list.
       //
+      _XmlIndexFree (Parent);
       InsertTailList (&(Parent->ChildrenListHead), &NodeTemp->Link);
 
       //
@@ -196,15 +610,44 @@ AddNode (
   //
   if (EFI_ERROR (Status)) {
     //
-    // SafeFreeBuffer() only frees the memory if the pointer is not NULL.
+    // _XmlFree() only frees the memory if the pointer is not NULL and not in an arena.
     // It then sets the pointer to null.
     //
-    SafeFreeBuffer ((CHAR8 **)&NodeTemp);
-    SafeFreeBuffer (&NodeName);
-    SafeFreeBuffer (&NodeValue);
+    _XmlFree (Arena, (CHAR8 **)&NodeTemp);
+    _XmlFree (Arena, &NodeName);
+    _XmlFree (Arena, &NodeValue);
   }
 
   return Status;
+}// _AddNode()
+
+//
+// Public functions
+//
+
+/**
+This function creates a new XML tree.
+
+When Parent is in an arena, the new node is carved from the same arena.
+
+@param[in]   Parent   -- Optional parent for this node.
+@param[in]   Name     -- Name for this node.
+@param[in]   Value    -- Optional value for this node.
+@param[out]  Node     -- Optional return pointer for this node.
+
+@return  EFI_SUCCESS or underlying failure code.
+
+**/
+EFI_STATUS
+EFIAPI
+AddNode (
+  IN        XmlNode  *Parent OPTIONAL,
+  IN  CONST CHAR8    *Name,
+  IN  CONST CHAR8    *Value OPTIONAL,
+  OUT       XmlNode  **Node OPTIONAL
+  )
+{
+  return _AddNode ((Parent != NULL) ? Parent->Arena : NULL, Parent, Name, Value, Node);
 }// AddNode()
 
 /**
@@ -231,9 +674,19 @@ AddChildTree (
       break;
     }
 
+    //
+    // The tree is freed with the parent, so both must be in the same arena or in none.
+    //
+    if (Parent->Arena != Tree->Arena) {
+      DEBUG ((DEBUG_ERROR, "%a - Tree and Parent are not in the same arena\n", __FUNCTION__));
+      Status = EFI_INVALID_PARAMETER;
+      break;
+    }
+
     //
     // Add the node to the parent's child list.
     //
+    _XmlIndexFree (Parent);
     InsertTailList (&(Parent->ChildrenListHead), &Tree->Link);
 
     //
@@ -282,7 +735,7 @@ AddAttributeToNode (
     //
     // Allocate the attribute structure
     //
-    Attribute = (XmlAttribute *)AllocateZeroPool (sizeof (XmlAttribute));
+    Attribute = (XmlAttribute *)_XmlAllocate (Parent->Arena, sizeof (XmlAttribute));
     if (Attribute == NULL) {
       Status = EFI_OUT_OF_RESOURCES;
       break;
@@ -291,7 +744,7 @@ AddAttributeToNode (
     //
     // Allocate and store the name...
     //
-    AsciiString = (CHAR8 *)AllocateZeroPool (AsciiStrLen (Name) + 1);
+    AsciiString = (CHAR8 *)_XmlAllocate (Parent->Arena, AsciiStrLen (Name) + 1);
     if (AsciiString == NULL) {
       Status = EFI_OUT_OF_RESOURCES;
       break;
@@ -308,7 +761,7 @@ AddAttributeToNode (
     // Allocate and store the value...
     //
     AsciiString = NULL;
-    Status      = XmlUnEscape (Value, XML_MAX_ATTRIBUTE_VALUE_LENGTH, &AsciiString);
+    Status      = _XmlUnEscape (Parent->Arena, Value, XML_MAX_ATTRIBUTE_VALUE_LENGTH, &AsciiString);
     if (EFI_ERROR (Status)) {
       break;
     }
@@ -319,6 +772,8 @@ AddAttributeToNode (
     // Add the node to the parent's child list and increase the number of
     // attributes within this node.
     //
+    _XmlIndexFree (Parent);
+    _XmlIndexFree (Parent->ParentNode);
     InsertTailList (&(Parent->AttributesListHead), &(Attribute->Link));
     Parent->NumAttributes++;
     Attribute->Parent = Parent;
@@ -333,9 +788,9 @@ AddAttributeToNode (
     // It then sets the pointer to null.
     //
     if (Attribute) {
-      SafeFreeBuffer ((CHAR8 **)&Attribute->Name);
-      SafeFreeBuffer ((CHAR8 **)&Attribute->Value);
-      SafeFreeBuffer ((CHAR8 **)&Attribute);
+      _XmlFree (Parent->Arena, (CHAR8 **)&Attribute->Name);
+      _XmlFree (Parent->Arena, (CHAR8 **)&Attribute->Value);
+      _XmlFree (Parent->Arena, (CHAR8 **)&Attribute);
     }
   }
 
@@ -365,6 +820,10 @@ DeleteNode (
     return EFI_INVALID_PARAMETER;
   }
 
+  // the indexes that hold the node or its children are no longer valid
+  _XmlIndexFree (Node);
+  _XmlIndexFree (Node->ParentNode);
+
   // delete any children - can't use for loop because removal breaks iterator
   while (!IsListEmpty (&Node->ChildrenListHead)) {
     Link   = GetFirstNode (&Node->ChildrenListHead);
@@ -377,7 +836,7 @@ DeleteNode (
     // Now remove it from our children list
     RemoveEntryList (Link);
     Node->NumChildren--;
-    FreePool (Link);
+    _XmlFree (Node->Arena, (CHAR8 **)&Link);
   }
 
   // all children gone....
@@ -394,13 +853,13 @@ DeleteNode (
     // now remove from Attribute list
     RemoveEntryList (Link);
     Node->NumAttributes--;
-    FreePool (Link);
+    _XmlFree (Node->Arena, (CHAR8 **)&Link);
   }// go to next attribute
 
   // now free our node memory
-  SafeFreeBuffer (&(Node->XmlDeclaration.Declaration));
-  SafeFreeBuffer (&(Node->Name));
-  SafeFreeBuffer (&(Node->Value));
+  _XmlFree (Node->Arena, &(Node->XmlDeclaration.Declaration));
+  _XmlFree (Node->Arena, &(Node->Name));
+  _XmlFree (Node->Arena, &(Node->Value));
   Node->ParentNode = NULL;
 
   return Status;
@@ -421,162 +880,213 @@ DeleteAttribute (
   IN XmlAttribute  *Attribute
   )
 {
-  EFI_STATUS  Status = EFI_SUCCESS;
+  EFI_STATUS      Status = EFI_SUCCESS;
+  XML_TREE_ARENA  *Arena;
 
   if (Attribute == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  SafeFreeBuffer (&(Attribute->Name));
-  SafeFreeBuffer (&(Attribute->Value));
+  Arena = NULL;
+  if (Attribute->Parent != NULL) {
+    Arena = Attribute->Parent->Arena;
+    _XmlIndexFree (Attribute->Parent);
+    _XmlIndexFree (Attribute->Parent->ParentNode);
+  }
+
+  _XmlFree (Arena, &(Attribute->Name));
+  _XmlFree (Arena, &(Attribute->Value));
   Attribute->Parent = NULL;
   return Status;
 }// DeleteAttribute()
 
+//
+// Output cursor used to write an xml tree as a string.  Each write appends at Length, so
+// the string is never scanned again.  When Count is TRUE nothing is written, and only
+// Length is counted.
+//
+typedef struct {
+  CHAR8      *Buffer;                     // Output buffer, grown as needed
+  UINTN      BufferSize;                  // Size of Buffer in bytes
+  UINTN      Length;                      // Number of characters written
+  BOOLEAN    Count;                       // TRUE to only count the characters
+} XML_WRITER;
+
+// Initial size of the string buffer.  It is doubled each time it is full.
+#define XML_WRITER_INITIAL_SIZE  (0x1000)
+
 /**
-Function to calculate the size of the Ascii string needed
-to print this XmlNode and its children.
-This uses a shortened XML format, minimal whitespace, and xml encoded strings
+Append characters to the output of a writer.  The buffer always has room for a
+NULL terminator after the characters.
 
-This is an internal function.  Public function is CalculateXmlDocSize
+This is an internal function.
 
+@param Writer - Writer to append to
+@param Data   - Characters to append
+@param Length - Number of characters to append
+
+@return EFI_SUCCESS or EFI_OUT_OF_RESOURCES
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-_CaclSizeRecursively (
-  IN  CONST XmlNode  *Node,
-  IN        BOOLEAN  Escaped,
-  OUT       UINTN    *Size,
-  IN        UINTN    Level
+_XmlWrite (
+  IN OUT       XML_WRITER  *Writer,
+  IN     CONST CHAR8       *Data,
+  IN           UINTN       Length
   )
 {
-  XmlAttribute  *Att     = NULL;
-  LIST_ENTRY    *Link    = NULL;
-  UINTN         NameSize = 0;
-  EFI_STATUS    Status   = EFI_SUCCESS;
+  UINTN  NewSize;
+  CHAR8  *NewBuffer;
+
+  if (!Writer->Count) {
+    if (Writer->Length + Length + 1 > Writer->BufferSize) {
+      NewSize = MAX (Writer->BufferSize * 2, Writer->Length + Length + 1);
+      NewSize = MAX (NewSize, XML_WRITER_INITIAL_SIZE);
+
+      NewBuffer = ReallocatePool (Writer->BufferSize, NewSize, Writer->Buffer);
+      if (NewBuffer == NULL) {
+        DEBUG ((DEBUG_ERROR, "%a - Failed to grow xml string to 0x%X bytes\n", __FUNCTION__, NewSize));
+        return EFI_OUT_OF_RESOURCES;
+      }
 
-  if ((Node == NULL) || (Size == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
+      Writer->Buffer     = NewBuffer;
+      Writer->BufferSize = NewSize;
+    }
 
-  if (Level > MAX_RECURSIVE_LEVEL) {
-    DEBUG ((DEBUG_ERROR, "!!!ERROR: BAD XML.  Allowable recursive depth exceeded.\n"));
-    return EFI_BAD_BUFFER_SIZE;
+    CopyMem (Writer->Buffer + Writer->Length, Data, Length);
   }
 
-  /* handle the xml decl*/
-  if (Node->XmlDeclaration.Declaration != NULL) {
-    if (Node->ParentNode != NULL) {
-      DEBUG ((DEBUG_ERROR, "!!!ERROR: BAD XML.  Should not have XmlDeclaration for a non-root node\n"));
-    }
+  Writer->Length += Length;
+  return EFI_SUCCESS;
+}
 
-    *Size = (*Size) + AsciiStrLen (Node->XmlDeclaration.Declaration);
-  }
+/**
+Append a NULL terminated string to the output of a writer.
 
-  /* Handle start tag*/
-  NameSize = AsciiStrLen (Node->Name);
-  *Size    = (*Size) + NameSize + 1; // '<'
+This is an internal function.
+**/
+STATIC
+EFI_STATUS
+_XmlWriteString (
+  IN OUT       XML_WRITER  *Writer,
+  IN     CONST CHAR8       *String
+  )
+{
+  return _XmlWrite (Writer, String, AsciiStrLen (String));
+}
 
-  // Loop attributes
-  for (Link = Node->AttributesListHead.ForwardLink; Link != &(Node->AttributesListHead); Link = Link->ForwardLink) {
-    Att   = (XmlAttribute *)Link;
-    *Size = (*Size) + AsciiStrLen (Att->Name) + 4; // '=', ' ','"','"'
-    if (Escaped) {
-      *Size = (*Size) + _GetXmlEscapedLength (Att->Value, XML_MAX_ATTRIBUTE_VALUE_LENGTH);
-    } else {
-      *Size = (*Size) + AsciiStrLen (Att->Value);
-    }
-  }
+/**
+Get the escape sequence for a character.
 
-  // handle children and ending
-  if ((Node->Value == NULL) && (Node->NumChildren == 0)) {
-    // Special short cut on the node  - Use empty node notation  />
-    *Size = (*Size) + 3; // ' ', '/', '>'
-  } else {
-    // longer notation
-    *Size = (*Size) + 1; // '>'
+This is an internal function.
 
-    // Show Value if value
-    if (Node->Value != NULL) {
-      if (Escaped) {
-        *Size = (*Size) + _GetXmlEscapedLength (Node->Value, XML_MAX_ELEMENT_VALUE_LENGTH);
-      } else {
-        *Size = (*Size) + AsciiStrLen (Node->Value);
-      }
-    }
+@param Char - Character to escape
 
-    // Process all children
-    if (Node->NumChildren > 0) {
-      UINTN  child = 0; // use for debugging only
-      // loop children
-      for (Link = Node->ChildrenListHead.ForwardLink; Link != &(Node->ChildrenListHead); Link = Link->ForwardLink, child++) {
-        Status = _CaclSizeRecursively ((CONST XmlNode *)Link, Escaped, Size, Level+1);
-        if (EFI_ERROR (Status)) {
-          DEBUG ((DEBUG_ERROR, "%a - Error Status from child index %d of element: %a\n", __FUNCTION__, child, Node->Name));
-          return Status;
-        }
-      }
-    } // end children loop
+@return Escape sequence, or NULL if the character does not need to be escaped.
+**/
+STATIC
+CONST CHAR8 *
+_GetXmlEscapeSequence (
+  IN CHAR8  Char
+  )
+{
+  switch (Char) {
+    case '<':
+      return "&lt;";
 
-    *Size = (*Size) + NameSize + 3; // '<', '/', '>/
-  } // end of node
+    case '>':
+      return "&gt;";
 
-  return EFI_SUCCESS;
+    case '\"':
+      return "&quot;";
+
+    case '\'':
+      return "&apos;";
+
+    case '&':
+      return "&amp;";
+
+    default:
+      return NULL;
+  }
 }
 
 /**
-Function to calculate the size of the Ascii string needed
-to print this XmlNode and its children.  Generally assumed it will
-be the root node.
+Append a string to the output of a writer, escaping the XML invalid chars.  Runs of
+chars that don't need escaping are copied at once.
 
-This uses a shortened XML format and uses minimal whitespace.
+This is an internal function.
 
-@param Node - The root node of the xml tree to start printing from
-@param Size - the number of Ascii characters in the string.  This does not include the NULL terminator
+@param Writer          - Writer to append to
+@param String          - Ascii string to escape
+@param MaxStringLength - Max length of the Ascii string "String"
 
+@return EFI_SUCCESS, EFI_INVALID_PARAMETER if String is too long, or EFI_OUT_OF_RESOURCES
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-CalculateXmlDocSize (
-  IN  CONST XmlNode  *Node,
-  IN        BOOLEAN  Escaped,
-  OUT       UINTN    *Size
+_XmlWriteEscaped (
+  IN OUT       XML_WRITER  *Writer,
+  IN     CONST CHAR8       *String,
+  IN           UINTN       MaxStringLength
   )
 {
-  if ((Node == NULL) || (Size == NULL)) {
+  CONST CHAR8  *Escape;
+  EFI_STATUS   Status;
+  UINTN        Length;
+  UINTN        Start;
+  UINTN        i;
+
+  Length = AsciiStrnLenS (String, MaxStringLength + 1);
+  if (Length > MaxStringLength) {
+    DEBUG ((DEBUG_ERROR, "%a String is too big or not NULL terminated\n", __FUNCTION__));
     return EFI_INVALID_PARAMETER;
   }
 
-  if (Node->ParentNode != NULL) {
-    DEBUG ((DEBUG_WARN, "%a - Called with node other than root node.  Siblings will not be traversed.\n", __FUNCTION__));
-  }
+  Start = 0;
+  for (i = 0; i < Length; i++) {
+    Escape = _GetXmlEscapeSequence (String[i]);
+    if (Escape == NULL) {
+      continue;
+    }
+
+    Status = _XmlWrite (Writer, String + Start, i - Start);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
 
-  *Size = 0;
+    Status = _XmlWriteString (Writer, Escape);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Start = i + 1;
+  }
 
-  return _CaclSizeRecursively (Node, Escaped, Size, 0);
+  return _XmlWrite (Writer, String + Start, Length - Start);
 }
 
 /**
-Internal function to convert an Xml Node and its children into an Ascii string
-using shortened Xml Notation and no whitespace.
+Internal function to write an Xml Node and its children through a writer
+using shortened Xml Notation and no whitespace.  The same pass is used to
+calculate the size of the string and to write it.
 
-Public function is XmlTreeToString
+Public functions are CalculateXmlDocSize and XmlTreeToString
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-_ToStringRecursively (
-  IN  CONST XmlNode  *Node,
-  IN        UINTN    BufferSize,
-  IN OUT    CHAR8    *String,
-  IN        UINTN    Level,
-  IN        BOOLEAN  Escaped
+_WriteNodeRecursively (
+  IN  CONST XmlNode     *Node,
+  IN OUT    XML_WRITER  *Writer,
+  IN        UINTN       Level,
+  IN        BOOLEAN     Escaped
   )
 {
   XmlAttribute  *Att   = NULL;
   LIST_ENTRY    *Link  = NULL;
   EFI_STATUS    Status = EFI_SUCCESS;
 
-  if ((Node == NULL) || (String == NULL)) {
+  if (Node == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
@@ -591,19 +1101,19 @@ _ToStringRecursively (
       DEBUG ((DEBUG_ERROR, "!!!ERROR: BAD XML.  Should not have XmlDeclaration for a non-root node\n"));
     }
 
-    Status = AsciiStrCatS (String, BufferSize, Node->XmlDeclaration.Declaration);
+    Status = _XmlWriteString (Writer, Node->XmlDeclaration.Declaration);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
   }
 
   /* Handle start tag*/
-  Status = AsciiStrCatS (String, BufferSize, "<");
+  Status = _XmlWrite (Writer, "<", 1);
   if (EFI_ERROR (Status)) {
     goto EXIT;
   }
 
-  Status = AsciiStrCatS (String, BufferSize, Node->Name);
+  Status = _XmlWriteString (Writer, Node->Name);
   if (EFI_ERROR (Status)) {
     goto EXIT;
   }
@@ -611,39 +1121,32 @@ _ToStringRecursively (
   // Loop attributes
   for (Link = Node->AttributesListHead.ForwardLink; Link != &(Node->AttributesListHead); Link = Link->ForwardLink) {
     Att    = (XmlAttribute *)Link;
-    Status = AsciiStrCatS (String, BufferSize, " ");
+    Status = _XmlWrite (Writer, " ", 1);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
 
-    Status = AsciiStrCatS (String, BufferSize, Att->Name);
+    Status = _XmlWriteString (Writer, Att->Name);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
 
-    Status = AsciiStrCatS (String, BufferSize, "=\"");
+    Status = _XmlWrite (Writer, "=\"", 2);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
 
     if (Escaped) {
-      CHAR8  *EscapedString = NULL;
-      Status = XmlEscape (Att->Value, XML_MAX_ATTRIBUTE_VALUE_LENGTH, &EscapedString);
-      if (EFI_ERROR (Status)) {
-        goto EXIT;
-      }
-
-      Status = AsciiStrCatS (String, BufferSize, EscapedString);
-      SafeFreeBuffer (&EscapedString);
+      Status = _XmlWriteEscaped (Writer, Att->Value, XML_MAX_ATTRIBUTE_VALUE_LENGTH);
     } else {
-      Status = AsciiStrCatS (String, BufferSize, Att->Value);
+      Status = _XmlWriteString (Writer, Att->Value);
     }
 
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
 
-    Status = AsciiStrCatS (String, BufferSize, "\"");
+    Status = _XmlWrite (Writer, "\"", 1);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
@@ -652,13 +1155,13 @@ _ToStringRecursively (
   // handle children and ending
   if ((Node->Value == NULL) && (Node->NumChildren == 0)) {
     // Special short cut on the node  - Use empty node notation  />
-    Status = AsciiStrCatS (String, BufferSize, " />");
+    Status = _XmlWrite (Writer, " />", 3);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
   } else {
     // longer notation
-    Status = AsciiStrCatS (String, BufferSize, ">");
+    Status = _XmlWrite (Writer, ">", 1);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
@@ -666,16 +1169,9 @@ _ToStringRecursively (
     // Show Value if value
     if (Node->Value != NULL) {
       if (Escaped) {
-        CHAR8  *EscapedString = NULL;
-        Status = XmlEscape (Node->Value, XML_MAX_ELEMENT_VALUE_LENGTH, &EscapedString);
-        if (EFI_ERROR (Status)) {
-          goto EXIT;
-        }
-
-        Status = AsciiStrCatS (String, BufferSize, EscapedString);
-        SafeFreeBuffer (&EscapedString);
+        Status = _XmlWriteEscaped (Writer, Node->Value, XML_MAX_ELEMENT_VALUE_LENGTH);
       } else {
-        Status = AsciiStrCatS (String, BufferSize, Node->Value);
+        Status = _XmlWriteString (Writer, Node->Value);
       }
 
       if (EFI_ERROR (Status)) {
@@ -688,7 +1184,7 @@ _ToStringRecursively (
       UINTN  child = 0; // use for debugging only
       // loop children
       for (Link = Node->ChildrenListHead.ForwardLink; Link != &(Node->ChildrenListHead); Link = Link->ForwardLink, child++) {
-        Status = _ToStringRecursively ((CONST XmlNode *)Link, BufferSize, String, Level+1, Escaped);
+        Status = _WriteNodeRecursively ((CONST XmlNode *)Link, Writer, Level+1, Escaped);
         if (EFI_ERROR (Status)) {
           DEBUG ((DEBUG_ERROR, "%a - Error Status from child index %d of element: %a\n", __FUNCTION__, child, Node->Name));
           goto EXIT;
@@ -696,17 +1192,17 @@ _ToStringRecursively (
       }
     } // end children loop
 
-    Status = AsciiStrCatS (String, BufferSize, "</");
+    Status = _XmlWrite (Writer, "</", 2);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
 
-    Status = AsciiStrCatS (String, BufferSize, Node->Name);
+    Status = _XmlWriteString (Writer, Node->Name);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
 
-    Status = AsciiStrCatS (String, BufferSize, ">");
+    Status = _XmlWrite (Writer, ">", 1);
     if (EFI_ERROR (Status)) {
       goto EXIT;
     }
@@ -716,10 +1212,50 @@ EXIT:
   return Status;
 }
 
+/**
+Function to calculate the size of the Ascii string needed
+to print this XmlNode and its children.  Generally assumed it will
+be the root node.
+
+This uses a shortened XML format and uses minimal whitespace.
+
+@param Node - The root node of the xml tree to start printing from
+@param Size - the number of Ascii characters in the string.  This does not include the NULL terminator
+
+**/
+EFI_STATUS
+EFIAPI
+CalculateXmlDocSize (
+  IN  CONST XmlNode  *Node,
+  IN        BOOLEAN  Escaped,
+  OUT       UINTN    *Size
+  )
+{
+  XML_WRITER  Writer;
+  EFI_STATUS  Status;
+
+  if ((Node == NULL) || (Size == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (Node->ParentNode != NULL) {
+    DEBUG ((DEBUG_WARN, "%a - Called with node other than root node.  Siblings will not be traversed.\n", __FUNCTION__));
+  }
+
+  ZeroMem (&Writer, sizeof (Writer));
+  Writer.Count = TRUE;
+
+  Status = _WriteNodeRecursively (Node, &Writer, 0, Escaped);
+  *Size  = Writer.Length;
+  return Status;
+}
+
 /**
 Public function to create an ascii string from an xml node tree.
 This will use shortened XML notation and no whitespace.  (ideal for data transfer)
 
+The string is written in one pass, into a buffer that is grown as needed.
+
 @param[in]  Node - Root node or first node to start printing.
 @param      Escaped - Should the Xml be escaped.  Generally this should be true
 @param[out] BufferSize - Number of bytes that the string needed. Includes Null terminator
@@ -735,8 +1271,7 @@ XmlTreeToString (
   )
 {
   EFI_STATUS  Status;
-  UINTN       Size       = 0;
-  CHAR8       *XmlString = NULL;
+  XML_WRITER  Writer;
 
   if ((Node == NULL) || (BufferSize == NULL) || (String == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -746,32 +1281,26 @@ XmlTreeToString (
     DEBUG ((DEBUG_WARN, "%a - Called with node other than root node.  Siblings will not be traversed.\n", __FUNCTION__));
   }
 
-  Status = CalculateXmlDocSize (Node, Escaped, &Size);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a - Error in CalculateXmlDocSize %r\n", __FUNCTION__, Status));
-    return Status;
-  }
-
-  Size++;  // for the NULL char
-  DEBUG ((DEBUG_INFO, "%a - Pre Calculated Size of string is 0x%X\n", __FUNCTION__, Size));
-
-  XmlString = (CHAR8 *)AllocatePool (Size);
-  if (XmlString == NULL) {
+  ZeroMem (&Writer, sizeof (Writer));
+  Writer.BufferSize = XML_WRITER_INITIAL_SIZE;
+  Writer.Buffer     = (CHAR8 *)AllocatePool (Writer.BufferSize);
+  if (Writer.Buffer == NULL) {
     DEBUG ((DEBUG_ERROR, "Failed to allocate string for XML"));
     return EFI_OUT_OF_RESOURCES;
   }
 
-  *XmlString = '\0';  // set to null for ascii str cat
-  Status     = _ToStringRecursively (Node, Size, XmlString, 0, Escaped);
+  Status = _WriteNodeRecursively (Node, &Writer, 0, Escaped);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a - Failed to convert xml node tree into string. %r\n", __FUNCTION__, Status));
+    FreePool (Writer.Buffer);
     return Status;
   }
 
-  DEBUG ((DEBUG_INFO, "%a - Pre Calculated Length of string is 0x%X. AsciiStrLen is 0x%X\n", __FUNCTION__, (Size - 1), AsciiStrLen (XmlString)));
+  Writer.Buffer[Writer.Length] = '\0';
+  DEBUG ((DEBUG_INFO, "%a - Length of string is 0x%X\n", __FUNCTION__, Writer.Length));
 
-  *String     = XmlString;
-  *BufferSize = Size;
+  *String     = Writer.Buffer;
+  *BufferSize = Writer.Length + 1;
   return EFI_SUCCESS;
 }
 
@@ -782,6 +1311,8 @@ Engine parsing code which will build a XmlNode for the XmlTree
 
 @param[in] XmlDocument      -- XML document.
 @param[in] XmlDocumentSize  -- Size of the XML document.
+@param[in] Arena            -- Optional arena to carve the tree from.  It is owned by the tree
+                               once the root node is created.
 @param[in out] Root         -- Pointer to receive the node list.
 
 Return Value:
@@ -792,9 +1323,10 @@ EFI_SUCCESS or underlying failure code.
 EFI_STATUS
 EFIAPI
 BuildNodeList (
-  IN CONST CHAR8    *XmlDocument,
-  IN       UINTN    XmlDocumentSize,
-  IN OUT   XmlNode  **Root
+  IN CONST CHAR8           *XmlDocument,
+  IN       UINTN           XmlDocumentSize,
+  IN       XML_TREE_ARENA  *Arena OPTIONAL,
+  IN OUT   XmlNode         **Root
   )
 {
   EFI_STATUS  Status              = EFI_INVALID_PARAMETER;
@@ -924,7 +1456,7 @@ BuildNodeList (
     //
     if (Next.State == XTSS_XMLDECL_CLOSE) {
       const UINTN  EndlineSize = 2;
-      XmlDeclaration = AllocateZeroPool (State.Location.Column + EndlineSize);
+      XmlDeclaration = _XmlAllocate (Arena, State.Location.Column + EndlineSize);
       if (XmlDeclaration == NULL) {
         Status = EFI_OUT_OF_RESOURCES;
         goto Exit;
@@ -950,11 +1482,15 @@ BuildNodeList (
         //
         // This is the root node.
         //
-        Status = AddNode (NULL, Element, NULL, Root);
+        Status = _AddNode (Arena, NULL, Element, NULL, Root);
         if (EFI_ERROR (Status)) {
           goto Exit;
         }
 
+        if (Arena != NULL) {
+          Arena->Root = *Root;
+        }
+
         //
         // Add the declaration if we had one.
         //
@@ -1027,7 +1563,7 @@ BuildNodeList (
         // Allocate memory for the value.  This will be cleaned up when the
         // node is deleted when FreeXmlTree() is called.
         //
-        CHAR8  *Value = AllocateZeroPool (LocalSize + 1);         // MS_CHANGE
+        CHAR8  *Value = _XmlAllocate (Arena, LocalSize + 1);      // MS_CHANGE
         if (Value == NULL) {
           Status = EFI_OUT_OF_RESOURCES;
           goto Exit;
@@ -1143,6 +1679,8 @@ Exit:
     // no xml tree is to be returned
     if (*Root != NULL) {
       FreeXmlTree (Root);
+    } else if (Arena != NULL) {
+      _XmlArenaFree (Arena);
     }
   }
 
@@ -1167,14 +1705,46 @@ CreateXmlTree (
   OUT       XmlNode  **RootNode
   )
 {
-  EFI_STATUS  Status = EFI_SUCCESS;
+  return CreateXmlTreeEx (XmlDocument, SizeXmlDocument, 0, RootNode);
+}
+
+/**
+This function will create a xml tree given an XML document as a ascii string.
+
+@param   XmlDocument     -- XML document to create the node list for.
+@param   SizeXmlDocument -- Length of the document.
+@param   Options         -- XML_TREE_OPTION_* flags for how the tree is stored.
+@param   RootNode        -- The root node that contains the node list.
+
+@return  EFI_SUCCESS or underlying failure code.
+
+**/
+EFI_STATUS
+EFIAPI
+CreateXmlTreeEx (
+  IN  CONST CHAR8    *XmlDocument,
+  IN        UINTN    SizeXmlDocument,
+  IN        UINT32   Options,
+  OUT       XmlNode  **RootNode
+  )
+{
+  EFI_STATUS      Status = EFI_SUCCESS;
+  XML_TREE_ARENA  *Arena = NULL;
 
-  if ((XmlDocument == NULL) || (SizeXmlDocument == 0) || (RootNode == NULL)) {
+  if ((XmlDocument == NULL) || (SizeXmlDocument == 0) || (RootNode == NULL) || ((Options & ~XML_TREE_OPTION_ARENA) != 0)) {
     Status = EFI_INVALID_PARAMETER;
     goto Exit;
   }
 
-  Status = BuildNodeList (XmlDocument, SizeXmlDocument, RootNode);
+  if ((Options & XML_TREE_OPTION_ARENA) != 0) {
+    Arena = _XmlArenaCreate (SizeXmlDocument);
+    if (Arena == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto Exit;
+    }
+  }
+
+  Status = BuildNodeList (XmlDocument, SizeXmlDocument, Arena, RootNode);
   if (EFI_ERROR (Status)) {
     goto Exit;
   }
@@ -1198,7 +1768,8 @@ FreeXmlTree (
   IN XmlNode  **RootNode
   )
 {
-  EFI_STATUS  Status = EFI_SUCCESS;
+  EFI_STATUS      Status = EFI_SUCCESS;
+  XML_TREE_ARENA  *Arena;
 
   if (RootNode == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -1208,8 +1779,18 @@ FreeXmlTree (
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Everything in a tree built in an arena is released with the arena
+  //
+  Arena = (*RootNode)->Arena;
+  if ((Arena != NULL) && (Arena->Root == *RootNode)) {
+    _XmlArenaFree (Arena);
+    *RootNode = NULL;
+    return EFI_SUCCESS;
+  }
+
   Status = DeleteNode (*RootNode);
-  SafeFreeBuffer ((CHAR8 **)RootNode);
+  _XmlFree (Arena, (CHAR8 **)RootNode);
 
   return Status;
 }// FreeXmlTree()
@@ -1545,6 +2126,21 @@ XmlUnEscape (
   IN UINTN        MaxEscapedStringLength,
   OUT CHAR8       **String
   )
+{
+  return _XmlUnEscape (NULL, EscapedString, MaxEscapedStringLength, String);
+}
+
+/**
+Internal function to remove XML escape sequences, with the string carved from Arena
+when it is not NULL.  Public function is XmlUnEscape.
+**/
+EFI_STATUS
+_XmlUnEscape (
+  IN     XML_TREE_ARENA  *Arena OPTIONAL,
+  IN     CONST CHAR8     *EscapedString,
+  IN     UINTN           MaxEscapedStringLength,
+  OUT    CHAR8           **String
+  )
 {
   UINTN  Length = 0;
   CHAR8  *RawString = NULL; // local copy of the raw string
@@ -1563,7 +2159,7 @@ XmlUnEscape (
     return EFI_INVALID_PARAMETER;
   }
 
-  RawString = AllocateZeroPool (Length + 1); // add one for NULL termination
+  RawString = _XmlAllocate (Arena, Length + 1); // add one for NULL termination
   if (RawString == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -1607,7 +2203,7 @@ XmlUnEscape (
       ASSERT (EscapedString[i] == '\0');
     }
 
-    FreePool (RawString);
+    _XmlFree (Arena, &RawString);
     return EFI_DEVICE_ERROR;
   }
 
@@ -1786,3 +2382,156 @@ XmlTreeMaxAttributes (
 
   return EFI_SUCCESS;
 }
+
+/**
+Find the first child of a node with a name, and optionally with an attribute that has a value.
+
+Nodes with many children and attributes build an index on the first lookup, so later lookups
+do not walk the children.
+
+@param Parent         - Node whose children are searched
+@param Name           - Name of the child
+@param AttributeName  - Optional name of an attribute the child must have
+@param AttributeValue - Value the attribute must have.  Required when AttributeName is not NULL.
+
+@return The first matching child, or NULL if there is none.
+**/
+XmlNode *
+EFIAPI
+XmlTreeFindChild (
+  IN CONST XmlNode  *Parent,
+  IN CONST CHAR8    *Name,
+  IN CONST CHAR8    *AttributeName OPTIONAL,
+  IN CONST CHAR8    *AttributeValue OPTIONAL
+  )
+{
+  XML_NODE_INDEX        *Index;
+  XML_NODE_INDEX_ENTRY  *Entry;
+  LIST_ENTRY            *Link;
+  LIST_ENTRY            *AttributeLink;
+  XmlNode               *Child;
+  UINT32                Hash;
+  UINT32                Next;
+
+  if ((Parent == NULL) || (Name == NULL) || ((AttributeName == NULL) != (AttributeValue == NULL))) {
+    return NULL;
+  }
+
+  //
+  // The index is a cache of the children, so it is built even for a CONST node
+  //
+  Index = _XmlIndexGet ((XmlNode *)Parent);
+  if (Index != NULL) {
+    Hash = _XmlIndexChildHash (Name, AttributeName, AttributeValue);
+    for (Next = Index->Buckets[Hash & Index->BucketMask]; Next != XML_NODE_INDEX_END; Next = Entry->Next) {
+      Entry = &Index->Entries[Next];
+      if ((Entry->Hash != Hash) || (Entry->Node == NULL) || ((Entry->Attribute == NULL) != (AttributeName == NULL))) {
+        continue;
+      }
+
+      if (AsciiStrCmp (Entry->Node->Name, Name) != 0) {
+        continue;
+      }
+
+      if ((AttributeName != NULL) &&
+          ((AsciiStrCmp (Entry->Attribute->Name, AttributeName) != 0) || (AsciiStrCmp (Entry->Attribute->Value, AttributeValue) != 0)))
+      {
+        continue;
+      }
+
+      return Entry->Node;
+    }
+
+    return NULL;
+  }
+
+  for (Link = GetFirstNode (&Parent->ChildrenListHead); !IsNull (&Parent->ChildrenListHead, Link); Link = GetNextNode (&Parent->ChildrenListHead, Link)) {
+    Child = (XmlNode *)Link;
+    if (AsciiStrCmp (Child->Name, Name) != 0) {
+      continue;
+    }
+
+    if (AttributeName == NULL) {
+      return Child;
+    }
+
+    for (AttributeLink = GetFirstNode (&Child->AttributesListHead);
+         !IsNull (&Child->AttributesListHead, AttributeLink);
+         AttributeLink = GetNextNode (&Child->AttributesListHead, AttributeLink))
+    {
+      if ((AsciiStrCmp (((XmlAttribute *)AttributeLink)->Name, AttributeName) == 0) &&
+          (AsciiStrCmp (((XmlAttribute *)AttributeLink)->Value, AttributeValue) == 0))
+      {
+        return Child;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/**
+Find the first attribute of a node with a name, using the index of the node.
+
+@param Node - Node whose attributes are searched
+@param Name - Name of the attribute
+
+@return The first matching attribute, or NULL if there is none.
+**/
+XmlAttribute *
+EFIAPI
+XmlTreeFindAttribute (
+  IN CONST XmlNode  *Node,
+  IN CONST CHAR8    *Name
+  )
+{
+  XML_NODE_INDEX        *Index;
+  XML_NODE_INDEX_ENTRY  *Entry;
+  LIST_ENTRY            *Link;
+  UINT32                Hash;
+  UINT32                Next;
+
+  if ((Node == NULL) || (Name == NULL)) {
+    return NULL;
+  }
+
+  Index = _XmlIndexGet ((XmlNode *)Node);
+  if (Index != NULL) {
+    Hash = _XmlIndexAttributeHash (Name);
+    for (Next = Index->Buckets[Hash & Index->BucketMask]; Next != XML_NODE_INDEX_END; Next = Entry->Next) {
+      Entry = &Index->Entries[Next];
+      if ((Entry->Hash == Hash) && (Entry->Node == NULL) && (AsciiStrCmp (Entry->Attribute->Name, Name) == 0)) {
+        return Entry->Attribute;
+      }
+    }
+
+    return NULL;
+  }
+
+  for (Link = GetFirstNode (&Node->AttributesListHead); !IsNull (&Node->AttributesListHead, Link); Link = GetNextNode (&Node->AttributesListHead, Link)) {
+    if (AsciiStrCmp (((XmlAttribute *)Link)->Name, Name) == 0) {
+      return (XmlAttribute *)Link;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+Drop the lookup indexes that hold a node, after its name, its attributes or its list of
+children were changed directly.  Both the index of the node and the index of its parent
+are dropped.
+
+@param Node - Node that was changed
+**/
+VOID
+EFIAPI
+XmlTreeIndexReset (
+  IN XmlNode  *Node
+  )
+{
+  if (Node != NULL) {
+    _XmlIndexFree (Node);
+    _XmlIndexFree (Node->ParentNode);
+  }
+}
@@ -31,7 +31,8 @@ FindFirstChildNodeByName (
   IN CONST CHAR8    *ElementName
   )
 {
-  LIST_ENTRY  *Link = NULL;
+  LIST_ENTRY  *Link     = NULL;
+  XmlNode     *NodeThis = NULL;
 
   if (ParentNode == NULL) {
     DEBUG ((DEBUG_ERROR, "%a - Parent Node is NULL\n", __FUNCTION__));
@@ -48,11 +49,24 @@ FindFirstChildNodeByName (
   DEBUG ((DEBUG_INFO, "%a - Looking for '%a;\n", __FUNCTION__, ElementName));
   DEBUG ((DEBUG_INFO, "%a - Looking in children of '%a\n", __FUNCTION__, ParentNode->Name));
 
+  //
+  // Names shorter than the max length compare the same in full, so the index of the
+  // parent can be used.  Longer names are only compared up to the max length.
+  //
+  if (AsciiStrnLenS (ElementName, MAX_ELEMENT_NAME_LENGTH) < MAX_ELEMENT_NAME_LENGTH) {
+    NodeThis = XmlTreeFindChild (ParentNode, ElementName, NULL, NULL);
+    if (NodeThis == NULL) {
+      DEBUG ((DEBUG_INFO, "Didn't find element named %a\n", ElementName));
+    }
+
+    return NodeThis;
+  }
+
   for (Link = GetFirstNode (&ParentNode->ChildrenListHead);
        !IsNull (&ParentNode->ChildrenListHead, Link);
        Link = GetNextNode (&ParentNode->ChildrenListHead, Link))
   {
-    XmlNode  *NodeThis = (XmlNode *)Link;
+    NodeThis = (XmlNode *)Link;
     DEBUG ((DEBUG_INFO, "Checking Node: ElementName = '%a'\n", NodeThis->Name));
     if (AsciiStrnCmp (ElementName, NodeThis->Name, MAX_ELEMENT_NAME_LENGTH) == 0) {
       // Found it
@@ -80,7 +94,8 @@ FindFirstAttributeByName (
   IN CONST CHAR8    *AttributeName
   )
 {
-  LIST_ENTRY  *Link = NULL;
+  LIST_ENTRY    *Link     = NULL;
+  XmlAttribute  *AttrThis = NULL;
 
   if (Node == NULL) {
     DEBUG ((DEBUG_ERROR, "%a - Node is NULL\n", __FUNCTION__));
@@ -97,11 +112,20 @@ FindFirstAttributeByName (
   DEBUG ((DEBUG_INFO, "%a - Looking for attribute with name '%a'\n", __FUNCTION__, AttributeName));
   DEBUG ((DEBUG_INFO, "%a - Looking in attributes of node '%a'\n", __FUNCTION__, Node->Name));
 
+  if (AsciiStrnLenS (AttributeName, MAX_ATTRIBUTE_NAME_LENGTH) < MAX_ATTRIBUTE_NAME_LENGTH) {
+    AttrThis = XmlTreeFindAttribute (Node, AttributeName);
+    if (AttrThis == NULL) {
+      DEBUG ((DEBUG_INFO, "Didn't find Attribute named '%a'\n", AttributeName));
+    }
+
+    return AttrThis;
+  }
+
   for (Link = GetFirstNode (&Node->AttributesListHead);
        !IsNull (&Node->AttributesListHead, Link);
        Link = GetNextNode (&Node->AttributesListHead, Link))
   {
-    XmlAttribute  *AttrThis = (XmlAttribute *)Link;
+    AttrThis = (XmlAttribute *)Link;
     DEBUG ((DEBUG_INFO, "Checking Attribute: Name = '%a'\n", AttrThis->Name));
     if (AsciiStrnCmp (AttributeName, AttrThis->Name, MAX_ATTRIBUTE_NAME_LENGTH) == 0) {
       // Found it
@@ -113,3 +137,203 @@ FindFirstAttributeByName (
   DEBUG ((DEBUG_INFO, "Didn't find Attribute named '%a'\n", AttributeName));
   return NULL;
 }
+
+/**
+Copy a token of a path to a NULL terminated buffer.
+
+@param[in]  Token       Start of the token
+@param[in]  Length      Number of characters in the token
+@param[out] Buffer      Buffer for the token
+@param[in]  BufferSize  Number of characters the buffer holds, including the NULL
+
+@retval TRUE if the token is not empty and fits in the buffer
+**/
+STATIC
+BOOLEAN
+CopyPathToken (
+  IN  CONST CHAR8  *Token,
+  IN        UINTN  Length,
+  OUT       CHAR8  *Buffer,
+  IN        UINTN  BufferSize
+  )
+{
+  if ((Length == 0) || (Length >= BufferSize)) {
+    return FALSE;
+  }
+
+  return !EFI_ERROR (AsciiStrnCpyS (Buffer, BufferSize, Token, Length));
+}
+
+/**
+Parse one step of a path, an element name with an optional [AttributeName=Value].
+
+@param[in]  Path            Start of the step
+@param[out] Name            Element name of the step
+@param[out] AttributeName   Attribute name of the step, empty if there is none
+@param[out] AttributeValue  Attribute value of the step
+
+@retval The end of the step, at '/' or the NULL terminator, or NULL if the step is not valid
+**/
+STATIC
+CONST CHAR8 *
+ParsePathStep (
+  IN  CONST CHAR8  *Path,
+  OUT       CHAR8  *Name,
+  OUT       CHAR8  *AttributeName,
+  OUT       CHAR8  *AttributeValue
+  )
+{
+  CONST CHAR8  *Start;
+  CHAR8        Quote;
+
+  Start = Path;
+  while ((*Path != '\0') && (*Path != '/') && (*Path != '[')) {
+    Path++;
+  }
+
+  if (!CopyPathToken (Start, Path - Start, Name, MAX_ELEMENT_NAME_LENGTH + 1)) {
+    return NULL;
+  }
+
+  AttributeName[0] = '\0';
+  if (*Path != '[') {
+    return Path;
+  }
+
+  Start = ++Path;
+  while ((*Path != '\0') && (*Path != '=') && (*Path != ']')) {
+    Path++;
+  }
+
+  if ((*Path != '=') || !CopyPathToken (Start, Path - Start, AttributeName, MAX_ATTRIBUTE_NAME_LENGTH + 1)) {
+    return NULL;
+  }
+
+  //
+  // The value may be quoted, so it can hold '/' and ']'
+  //
+  Path++;
+  Quote = '\0';
+  if ((*Path == '\'') || (*Path == '"')) {
+    Quote = *Path++;
+  }
+
+  Start = Path;
+  while ((*Path != '\0') && (*Path != ((Quote != '\0') ? Quote : ']'))) {
+    Path++;
+  }
+
+  if (!CopyPathToken (Start, Path - Start, AttributeValue, XML_MAX_ATTRIBUTE_VALUE_LENGTH + 1)) {
+    return NULL;
+  }
+
+  if ((Quote != '\0') && (*Path == Quote)) {
+    Path++;
+  }
+
+  if (*Path != ']') {
+    return NULL;
+  }
+
+  Path++;
+  if ((*Path != '\0') && (*Path != '/')) {
+    return NULL;
+  }
+
+  return Path;
+}
+
+/**
+Find a node by a path of element names, such as
+"SettingsPacket/Settings/Setting[Id='Device.Setting.Name']".
+
+Each step of the path is an element name, and can select the child with an attribute value
+with [AttributeName=Value].  The value can be quoted with ' or ".  Each step selects the
+first matching child, using the index of the node.
+
+A path that starts with '/' is absolute, and its first step must match the root of the tree
+that Node is in.  Otherwise the first step is a child of Node.
+
+@param[in]  Node  Node to start from
+@param[in]  Path  Path to the node
+
+@retval XmlNode that matches or NULL if not found or the path is not valid
+**/
+XmlNode *
+EFIAPI
+FindNodeByPath (
+  IN CONST XmlNode  *Node,
+  IN CONST CHAR8    *Path
+  )
+{
+  CONST XmlNode  *Current;
+  XmlAttribute   *Attribute;
+  CHAR8          Name[MAX_ELEMENT_NAME_LENGTH + 1];
+  CHAR8          AttributeName[MAX_ATTRIBUTE_NAME_LENGTH + 1];
+  CHAR8          AttributeValue[XML_MAX_ATTRIBUTE_VALUE_LENGTH + 1];
+
+  if (Node == NULL) {
+    DEBUG ((DEBUG_ERROR, "%a - Node is NULL\n", __FUNCTION__));
+    ASSERT (Node != NULL);
+    return NULL;
+  }
+
+  if (Path == NULL) {
+    DEBUG ((DEBUG_ERROR, "%a - Path is NULL\n", __FUNCTION__));
+    ASSERT (Path != NULL);
+    return NULL;
+  }
+
+  DEBUG ((DEBUG_INFO, "%a - Looking for '%a' from node '%a'\n", __FUNCTION__, Path, Node->Name));
+
+  Current = Node;
+  if (*Path == '/') {
+    while (Current->ParentNode != NULL) {
+      Current = Current->ParentNode;
+    }
+
+    Path = ParsePathStep (Path + 1, Name, AttributeName, AttributeValue);
+    if (Path == NULL) {
+      DEBUG ((DEBUG_ERROR, "%a - Path is not valid\n", __FUNCTION__));
+      return NULL;
+    }
+
+    if (AsciiStrCmp (Current->Name, Name) != 0) {
+      return NULL;
+    }
+
+    if (AttributeName[0] != '\0') {
+      Attribute = XmlTreeFindAttribute (Current, AttributeName);
+      if ((Attribute == NULL) || (AsciiStrCmp (Attribute->Value, AttributeValue) != 0)) {
+        return NULL;
+      }
+    }
+
+    if (*Path == '/') {
+      Path++;
+    } else {
+      return (XmlNode *)Current;
+    }
+  }
+
+  do {
+    Path = ParsePathStep (Path, Name, AttributeName, AttributeValue);
+    if (Path == NULL) {
+      DEBUG ((DEBUG_ERROR, "%a - Path is not valid\n", __FUNCTION__));
+      return NULL;
+    }
+
+    if (AttributeName[0] != '\0') {
+      Current = XmlTreeFindChild (Current, Name, AttributeName, AttributeValue);
+    } else {
+      Current = XmlTreeFindChild (Current, Name, NULL, NULL);
+    }
+
+    if (Current == NULL) {
+      DEBUG ((DEBUG_INFO, "Didn't find element named %a\n", Name));
+      return NULL;
+    }
+  } while (*Path++ == '/');
+
+  return (XmlNode *)Current;
+}
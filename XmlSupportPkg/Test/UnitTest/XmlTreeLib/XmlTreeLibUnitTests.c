@@ -7,6 +7,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
 
+#ifdef XML_TREE_LIB_HOST_BENCHMARK
+  #include <time.h>
+#endif
+
 #include <Uefi.h>
 #include <Library/UefiLib.h>
 #include <Library/PrintLib.h>
@@ -20,6 +24,19 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define UNIT_TEST_APP_NAME     "XML Lib Unit Test Application"
 #define UNIT_TEST_APP_VERSION  "0.3"
 
+//
+// The large tree is a root node with LARGE_TREE_GROUPS groups of LARGE_TREE_SETTINGS
+// settings, over 10k nodes.  Every attribute value needs to be escaped.  The element values
+// are plain text, as the parser does not unescape them when the string is read back.
+//
+#define LARGE_TREE_GROUPS            (100)
+#define LARGE_TREE_SETTINGS          (100)
+#define LARGE_TREE_NODES             (1 + LARGE_TREE_GROUPS + (LARGE_TREE_GROUPS * LARGE_TREE_SETTINGS))
+#define LARGE_TREE_ATTRIBUTES        (LARGE_TREE_GROUPS + (2 * LARGE_TREE_GROUPS * LARGE_TREE_SETTINGS))
+#define LARGE_TREE_BENCHMARK_PASSES  (20)
+
+XmlTestContext  LargeTreeContext = { LARGE_TREE_NODES, LARGE_TREE_ATTRIBUTES, 3, 2, NULL, NULL, NULL };
+
 /**
 Simple clean up method to make sure string parsing tests clean up even if interrupted and fail in the middle.
 **/
@@ -450,6 +467,286 @@ TestAttributeMax (
   return UNIT_TEST_PASSED;
 }
 
+/**
+Build the large tree of settings.
+
+@param[out] Root - Root node of the tree.  Must be freed with FreeXmlTree.
+**/
+EFI_STATUS
+EFIAPI
+BuildLargeXmlTree (
+  OUT XmlNode  **Root
+  )
+{
+  XmlNode     *Group;
+  XmlNode     *Setting;
+  EFI_STATUS  Status;
+  UINTN       GroupIndex;
+  UINTN       SettingIndex;
+  CHAR8       Name[32];
+  CHAR8       Value[64];
+
+  Status = AddNode (NULL, "Settings", NULL, Root);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  for (GroupIndex = 0; GroupIndex < LARGE_TREE_GROUPS; GroupIndex++) {
+    AsciiSPrint (Value, sizeof (Value), "Group <%d> & 'more'", GroupIndex);
+    Status = AddNode (*Root, "Group", NULL, &Group);
+    if (!EFI_ERROR (Status)) {
+      Status = AddAttributeToNode (Group, "Id", Value);
+    }
+
+    for (SettingIndex = 0; (SettingIndex < LARGE_TREE_SETTINGS) && !EFI_ERROR (Status); SettingIndex++) {
+      AsciiSPrint (Name, sizeof (Name), "Setting%d", SettingIndex);
+      AsciiSPrint (Value, sizeof (Value), "Value %d.%d", GroupIndex, SettingIndex);
+      Status = AddNode (Group, "Setting", Value, &Setting);
+      if (!EFI_ERROR (Status)) {
+        Status = AddAttributeToNode (Setting, "Id", Name);
+      }
+
+      if (!EFI_ERROR (Status)) {
+        Status = AddAttributeToNode (Setting, "Type", "\"String\" & 'Text'");
+      }
+    }
+
+    if (EFI_ERROR (Status)) {
+      FreeXmlTree (Root);
+      return Status;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+Write the large tree to a string, and check the string has the size calculated
+for it and parses back to the same tree.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+SerializeLargeTree (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  XmlTestContext  *XmlContext = (XmlTestContext *)Context;
+  CHAR8           *SecondString;
+  EFI_STATUS      Status;
+  UINTN           Size;
+  UINTN           StringSize;
+  UINTN           SecondStringSize;
+  UINTN           Count;
+
+  Status = BuildLargeXmlTree (&XmlContext->Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = CalculateXmlDocSize (XmlContext->Node, TRUE, &Size);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = XmlTreeToString (XmlContext->Node, TRUE, &StringSize, &XmlContext->ToFreeXmlString);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (Size + 1, StringSize);
+  UT_ASSERT_EQUAL (Size, AsciiStrLen (XmlContext->ToFreeXmlString));
+
+  // read the tree back from the string
+  FreeXmlTree (&XmlContext->Node);
+  Status = CreateXmlTree (XmlContext->ToFreeXmlString, Size, &XmlContext->Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Count  = 0;
+  Status = XmlTreeNumberOfNodes (XmlContext->Node, &Count);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (XmlContext->TotalElements, Count);
+
+  Count  = 0;
+  Status = XmlTreeNumberOfAttributes (XmlContext->Node, &Count);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (XmlContext->TotalAttributes, Count);
+
+  Count  = 0;
+  Status = XmlTreeMaxDepth (XmlContext->Node, &Count);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (XmlContext->MaxDepth, Count);
+
+  // and the tree read back writes the same string
+  Status = XmlTreeToString (XmlContext->Node, TRUE, &SecondStringSize, &SecondString);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Count = (SecondStringSize == StringSize) ? AsciiStrCmp (SecondString, XmlContext->ToFreeXmlString) : 1;
+  FreePool (SecondString);
+  UT_ASSERT_EQUAL (0, Count);
+
+  return UNIT_TEST_PASSED;
+}
+
+#ifdef XML_TREE_LIB_HOST_BENCHMARK
+
+/**
+Time writing the large tree to a string.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+BenchmarkLargeTree (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  XmlTestContext  *XmlContext = (XmlTestContext *)Context;
+  EFI_STATUS      Status;
+  UINTN           StringSize;
+  UINTN           Pass;
+  clock_t         Start;
+  UINT64          Microseconds;
+
+  Status = BuildLargeXmlTree (&XmlContext->Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  StringSize = 0;
+  Start      = clock ();
+  for (Pass = 0; Pass < LARGE_TREE_BENCHMARK_PASSES; Pass++) {
+    Status = XmlTreeToString (XmlContext->Node, TRUE, &StringSize, &XmlContext->ToFreeXmlString);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    FreePool (XmlContext->ToFreeXmlString);
+    XmlContext->ToFreeXmlString = NULL;
+  }
+
+  Microseconds = (UINT64)(clock () - Start) * 1000000 / CLOCKS_PER_SEC / LARGE_TREE_BENCHMARK_PASSES;
+  UT_LOG_INFO ("XmlTreeToString of %d nodes, %ld bytes: %ld us\n", LARGE_TREE_NODES, (UINT64)StringSize, Microseconds);
+
+  return UNIT_TEST_PASSED;
+}
+
+#endif
+
+/**
+Parse the large tree into an arena, and check it reads and writes the same as a tree
+in pool, and can still be changed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+ParseLargeTreeInArena (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  XmlTestContext  *XmlContext = (XmlTestContext *)Context;
+  XmlNode         *PoolTree;
+  XmlNode         *Node;
+  CHAR8           *SecondString;
+  EFI_STATUS      Status;
+  UINTN           StringSize;
+  UINTN           SecondStringSize;
+  UINTN           Count;
+
+  Status = BuildLargeXmlTree (&PoolTree);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = XmlTreeToString (PoolTree, TRUE, &StringSize, &XmlContext->ToFreeXmlString);
+  FreeXmlTree (&PoolTree);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = CreateXmlTreeEx (XmlContext->ToFreeXmlString, StringSize - 1, XML_TREE_OPTION_ARENA, &XmlContext->Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_NOT_NULL (XmlContext->Node->Arena);
+
+  Count  = 0;
+  Status = XmlTreeNumberOfNodes (XmlContext->Node, &Count);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (XmlContext->TotalElements, Count);
+
+  Count  = 0;
+  Status = XmlTreeNumberOfAttributes (XmlContext->Node, &Count);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (XmlContext->TotalAttributes, Count);
+
+  // the tree in the arena writes the same string
+  Status = XmlTreeToString (XmlContext->Node, TRUE, &SecondStringSize, &SecondString);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Count = (SecondStringSize == StringSize) ? AsciiStrCmp (SecondString, XmlContext->ToFreeXmlString) : 1;
+  FreePool (SecondString);
+  UT_ASSERT_EQUAL (0, Count);
+
+  // nodes added to the tree are carved from its arena
+  Status = AddNode (XmlContext->Node, "Extra", "Value &amp; more", &Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL ((UINTN)XmlContext->Node->Arena, (UINTN)Node->Arena);
+  UT_ASSERT_MEM_EQUAL (Node->Value, "Value & more", sizeof ("Value & more"));
+
+  Status = AddAttributeToNode (Node, "Id", "Extra");
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = DeleteNode (Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (0, Node->NumAttributes);
+  UT_ASSERT_TRUE (Node->Name == NULL);
+
+  // a tree in pool can't be added to a tree in an arena
+  Status = AddNode (NULL, "Pool", NULL, &PoolTree);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Status = AddChildTree (XmlContext->Node, PoolTree);
+  FreeXmlTree (&PoolTree);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_INVALID_PARAMETER);
+
+  Status = FreeXmlTree (&XmlContext->Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_TRUE (XmlContext->Node == NULL);
+
+  return UNIT_TEST_PASSED;
+}
+
+#ifdef XML_TREE_LIB_HOST_BENCHMARK
+
+/**
+Time parsing the large tree and freeing it, in pool and in an arena.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+BenchmarkLargeTreeArena (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  XmlTestContext  *XmlContext = (XmlTestContext *)Context;
+  EFI_STATUS      Status;
+  UINTN           StringSize;
+  UINTN           Pass;
+  UINT32          Options;
+  clock_t         Start;
+  UINT64          ParseTime;
+  UINT64          FreeTime;
+
+  Status = BuildLargeXmlTree (&XmlContext->Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = XmlTreeToString (XmlContext->Node, TRUE, &StringSize, &XmlContext->ToFreeXmlString);
+  FreeXmlTree (&XmlContext->Node);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  for (Options = 0; Options <= XML_TREE_OPTION_ARENA; Options += XML_TREE_OPTION_ARENA) {
+    ParseTime = 0;
+    FreeTime  = 0;
+    for (Pass = 0; Pass < LARGE_TREE_BENCHMARK_PASSES; Pass++) {
+      Start      = clock ();
+      Status     = CreateXmlTreeEx (XmlContext->ToFreeXmlString, StringSize - 1, Options, &XmlContext->Node);
+      ParseTime += clock () - Start;
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+
+      Start     = clock ();
+      FreeXmlTree (&XmlContext->Node);
+      FreeTime += clock () - Start;
+    }
+
+    UT_LOG_INFO (
+      "CreateXmlTreeEx of %d nodes with options 0x%x: parse %ld us, free %ld us\n",
+      LARGE_TREE_NODES,
+      Options,
+      ParseTime * 1000000 / CLOCKS_PER_SEC / LARGE_TREE_BENCHMARK_PASSES,
+      FreeTime * 1000000 / CLOCKS_PER_SEC / LARGE_TREE_BENCHMARK_PASSES
+      );
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+#endif
+
 /**
 
   Main fuction sets up the unit test environment
@@ -465,6 +762,8 @@ UnitTestingEntry (
   UNIT_TEST_SUITE_HANDLE      InputTestSuite;
   UNIT_TEST_SUITE_HANDLE      ProcessEscapedInputTestSuite;
   UNIT_TEST_SUITE_HANDLE      BasicMetricsTestSuite;
+  UNIT_TEST_SUITE_HANDLE      SerializeTestSuite;
+  UNIT_TEST_SUITE_HANDLE      ArenaTestSuite;
 
   DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
 
@@ -531,6 +830,37 @@ UnitTestingEntry (
   AddTestCase (InputTestSuite, "Fail parsing string missing nested closing element", "InvalidString", ParseInValidXml3, NULL, NULL, NULL);
 
   AddTestCase (InputTestSuite, "Parse Valid XML with a long data element", "LongElement", ParseValidXml, NULL, CleanUpXmlTestContext, &LongElementContext);
+
+  //
+  // Test writing a large tree to a string
+  //
+  Status = CreateUnitTestSuite (&SerializeTestSuite, Fw, "XML Large Tree Serialization", "Common.Xml.Serialize", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for XML Large Tree Serialization Test Suite\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (SerializeTestSuite, "Write a 10k node tree and parse it back", "LargeTree", SerializeLargeTree, NULL, CleanUpXmlTestContext, &LargeTreeContext);
+ #ifdef XML_TREE_LIB_HOST_BENCHMARK
+  AddTestCase (SerializeTestSuite, "Time writing a 10k node tree", "LargeTreeBenchmark", BenchmarkLargeTree, NULL, CleanUpXmlTestContext, &LargeTreeContext);
+ #endif
+
+  //
+  // Test trees carved from an arena
+  //
+  Status = CreateUnitTestSuite (&ArenaTestSuite, Fw, "XML Arena Trees", "Common.Xml.Arena", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for XML Arena Trees Test Suite\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (ArenaTestSuite, "Parse a 10k node tree into an arena", "LargeTreeArena", ParseLargeTreeInArena, NULL, CleanUpXmlTestContext, &LargeTreeContext);
+ #ifdef XML_TREE_LIB_HOST_BENCHMARK
+  AddTestCase (ArenaTestSuite, "Time parsing a 10k node tree in pool and in an arena", "LargeTreeArenaBenchmark", BenchmarkLargeTreeArena, NULL, CleanUpXmlTestContext, &LargeTreeContext);
+ #endif
+
   //
   // Execute the tests.
   //
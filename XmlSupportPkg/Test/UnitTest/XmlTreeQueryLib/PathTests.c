@@ -0,0 +1,255 @@
+/**
+Unit Tests that verify functionality of XmlTreeQueryLib for path queries, and
+the lookups of nodes large enough to be indexed
+
+Copyright (C) Microsoft Corporation.
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include "XmlTreeQueryLibUnitTests.h"
+
+// Number of settings in the large settings tree
+#define LARGE_SETTING_COUNT  (500)
+
+// Large settings tree, freed by the clean up even if the test fails in the middle
+STATIC XmlNode  *mLargeTree = NULL;
+
+UNIT_TEST_STATUS
+EFIAPI
+FindPathFound (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  XmlNode  *Result = NULL;
+
+  Result = FindNodeByPath (mNode, "AnotherGen1Node");
+  UT_ASSERT_NOT_NULL (Result);
+  UT_ASSERT_MEM_EQUAL (Result->Value, "Test Data 123", sizeof ("Test Data 123"));
+
+  Result = FindNodeByPath (mNode, "Gen1Node[attribute1=value1]/Gen2Node");
+  UT_ASSERT_NOT_NULL (Result);
+  UT_ASSERT_MEM_EQUAL (Result->Value, "Gen2Node1 contents", sizeof ("Gen2Node1 contents"));
+
+  Result = FindNodeByPath (mNode, "Gen1Node[attribute2='value2']/Gen2Node");
+  UT_ASSERT_NOT_NULL (Result);
+  UT_ASSERT_MEM_EQUAL (Result->Value, "Gen2Node1 contents", sizeof ("Gen2Node1 contents"));
+
+  // absolute paths start at the root, from any node of the tree
+  Result = FindNodeByPath (mNode, "/RootNode/AnotherGen1Node");
+  UT_ASSERT_NOT_NULL (Result);
+  UT_ASSERT_MEM_EQUAL (Result->Value, "Test Data 123", sizeof ("Test Data 123"));
+
+  Result = FindNodeByPath (Result, "/RootNode");
+  UT_ASSERT_EQUAL ((UINTN)Result, (UINTN)mNode);
+
+  return UNIT_TEST_PASSED;
+}
+
+UNIT_TEST_STATUS
+EFIAPI
+FindPathNotFound (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  XmlNode  *Result = NULL;
+
+  Result = FindNodeByPath (mNode, "Gen1Node[attribute1=value2]");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "Gen2Node");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "/NotTheRoot/Gen1Node");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "AnotherGen1Node/NotGoingToFindMe");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  return UNIT_TEST_PASSED;
+}
+
+UNIT_TEST_STATUS
+EFIAPI
+FindPathInvalid (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  XmlNode  *Result = NULL;
+
+  Result = FindNodeByPath (NULL, "Gen1Node");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, NULL);
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "/");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "AnotherGen1Node/");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "Gen1Node[attribute1]");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "Gen1Node[attribute1='value1]");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  Result = FindNodeByPath (mNode, "Gen1Node[attribute1=value1]Gen2Node");
+  UT_ASSERT_TRUE (Result == NULL);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+Clean up method to free the large settings tree.
+**/
+VOID
+EFIAPI
+CleanUpLargeTree (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  if (mLargeTree != NULL) {
+    FreeXmlTree (&mLargeTree);
+  }
+}
+
+/**
+Build a settings tree with enough settings for the settings node to be indexed, and
+find each setting by path.  Then check the index follows changes to the tree.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+FindPathLargeTree (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  XmlNode       *Settings = NULL;
+  XmlNode       *Setting  = NULL;
+  XmlNode       *Result   = NULL;
+  XmlAttribute  *Attribute;
+  EFI_STATUS    Status;
+  UINTN         Index;
+  CHAR8         Id[32];
+  CHAR8         Path[96];
+
+  Status = AddNode (NULL, "SettingsPacket", NULL, &mLargeTree);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Status = AddNode (mLargeTree, "Settings", NULL, &Settings);
+
+  for (Index = 0; (Index < LARGE_SETTING_COUNT) && !EFI_ERROR (Status); Index++) {
+    AsciiSPrint (Id, sizeof (Id), "Device.Setting.%d", Index);
+    Status = AddNode (Settings, "Setting", Id, &Setting);
+    if (!EFI_ERROR (Status)) {
+      Status = AddAttributeToNode (Setting, "Id", Id);
+    }
+  }
+
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  // find the settings last to first, with the same result as walking the list
+  for (Index = LARGE_SETTING_COUNT; Index > 0; Index--) {
+    AsciiSPrint (Id, sizeof (Id), "Device.Setting.%d", Index - 1);
+    AsciiSPrint (Path, sizeof (Path), "/SettingsPacket/Settings/Setting[Id='%a']", Id);
+    Result = FindNodeByPath (Settings, Path);
+    if ((Result == NULL) || (AsciiStrCmp (Result->Value, Id) != 0)) {
+      break;
+    }
+  }
+
+  UT_ASSERT_EQUAL (0, Index);
+  Result = FindFirstChildNodeByName (Settings, "Setting");
+  UT_ASSERT_EQUAL ((UINTN)Result, (UINTN)GetFirstNode (&Settings->ChildrenListHead));
+
+  // a node added after the index was built is found
+  Status = AddNode (Settings, "Setting", "Added", &Setting);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Status = AddAttributeToNode (Setting, "Id", "Device.Setting.Added");
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Result = FindNodeByPath (mLargeTree, "Settings/Setting[Id=Device.Setting.Added]");
+  UT_ASSERT_EQUAL ((UINTN)Result, (UINTN)Setting);
+
+  // and so is an attribute added to a node that was indexed
+  Result = FindNodeByPath (mLargeTree, "Settings/Setting[Id=Device.Setting.10]");
+  UT_ASSERT_NOT_NULL (Result);
+  Status = AddAttributeToNode (Result, "Alias", "Ten");
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL ((UINTN)FindNodeByPath (mLargeTree, "Settings/Setting[Alias=Ten]"), (UINTN)Result);
+
+  // a changed value is found once the index is reset
+  Attribute = FindFirstAttributeByName (Result, "Alias");
+  UT_ASSERT_NOT_NULL (Attribute);
+  Attribute->Value[0] = 'X';
+  XmlTreeIndexReset (Result);
+  UT_ASSERT_EQUAL ((UINTN)FindNodeByPath (mLargeTree, "Settings/Setting[Alias=Xen]"), (UINTN)Result);
+  UT_ASSERT_TRUE (FindNodeByPath (mLargeTree, "Settings/Setting[Alias=Ten]") == NULL);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+Grow the settings node of an arena tree one setting at a time, finding each new setting
+by path so the index is built again after every change.  The arena does not release the
+old indexes, so check they are reused instead of a new one being carved for each lookup.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+FindPathArenaTree (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CONST CHAR8     *Document  = "<SettingsPacket><Settings></Settings></SettingsPacket>";
+  XmlNode         *Settings  = NULL;
+  XmlNode         *Setting   = NULL;
+  XML_NODE_INDEX  *LastIndex = NULL;
+  EFI_STATUS      Status;
+  UINTN           Index;
+  UINTN           IndexCount = 0;
+  CHAR8           Id[32];
+  CHAR8           Path[96];
+
+  Status = CreateXmlTreeEx (Document, AsciiStrLen (Document), XML_TREE_OPTION_ARENA, &mLargeTree);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  Settings = FindFirstChildNodeByName (mLargeTree, "Settings");
+  UT_ASSERT_NOT_NULL (Settings);
+
+  for (Index = 0; Index < LARGE_SETTING_COUNT; Index++) {
+    AsciiSPrint (Id, sizeof (Id), "Device.Setting.%d", Index);
+    Status = AddNode (Settings, "Setting", Id, &Setting);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    Status = AddAttributeToNode (Setting, "Id", Id);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+
+    AsciiSPrint (Path, sizeof (Path), "Settings/Setting[Id='%a']", Id);
+    UT_ASSERT_EQUAL ((UINTN)FindNodeByPath (mLargeTree, Path), (UINTN)Setting);
+
+    if (Settings->Index != LastIndex) {
+      LastIndex = Settings->Index;
+      IndexCount++;
+    }
+  }
+
+  // each new index is at least twice the size of the last one
+  UT_ASSERT_NOT_NULL (LastIndex);
+  UT_ASSERT_TRUE (IndexCount < 16);
+
+  return UNIT_TEST_PASSED;
+}
+
+EFI_STATUS
+EFIAPI
+RegisterPathTests (
+  IN UNIT_TEST_SUITE_HANDLE  TestSuite
+  )
+{
+  AddTestCase (TestSuite, "Find Node By Path Found", "FindByPath.Found", FindPathFound, PreReqNodeTreeIsValid, NULL, NULL);
+  AddTestCase (TestSuite, "Find Node By Path Not Found", "FindByPath.NotFound", FindPathNotFound, PreReqNodeTreeIsValid, NULL, NULL);
+  AddTestCase (TestSuite, "Find Node By Path Invalid Paths", "FindByPath.Invalid", FindPathInvalid, PreReqNodeTreeIsValid, NULL, NULL);
+  AddTestCase (TestSuite, "Find Node By Path In An Indexed Tree", "FindByPath.LargeTree", FindPathLargeTree, NULL, CleanUpLargeTree, NULL);
+  AddTestCase (TestSuite, "Find Node By Path In A Growing Arena Tree", "FindByPath.ArenaTree", FindPathArenaTree, NULL, CleanUpLargeTree, NULL);
+
+  return EFI_SUCCESS;
+}
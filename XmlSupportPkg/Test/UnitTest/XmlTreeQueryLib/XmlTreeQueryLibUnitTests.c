@@ -75,6 +75,7 @@ UnitTestingEntry (
 
   RegisterElementTests (TestSuite);
   RegisterAttributeTests (TestSuite);
+  RegisterPathTests (TestSuite);
 
   // Create the Node Tree for query
   Status = CreateXmlTree (XmlString, AsciiStrLen (XmlString), &mNode);
@@ -47,4 +47,10 @@ RegisterElementTests (
   UNIT_TEST_SUITE_HANDLE  TestSuite
   );
 
+EFI_STATUS
+EFIAPI
+RegisterPathTests (
+  UNIT_TEST_SUITE_HANDLE  TestSuite
+  );
+
 #endif